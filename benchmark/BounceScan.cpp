@@ -0,0 +1,171 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include "../source/BounceScanner.hpp"
+#include "../source/BouncedGifters.hpp"
+
+// Benchmark of the Secret Santa Bounces scan. Writes a synthetic mbox file of a given size, made of
+// delivery status notifications, bounce messages with only an X-Failed-Recipients header field, and
+// ordinary replies, each with a base64 attachment as bounce messages often quote the original
+// message. Then scans it, twice so that the second scan reads from the page cache, and joins the
+// failed recipients against a synthetic roster of a given number of participants.
+//
+// Usage:
+//   secret-santa-bounce-benchmark [--megabytes <integer>] [--participants <integer>]
+//                                 [--mailbox <path>]
+
+namespace {
+
+// Appends a synthetic message of a given index to an mbox file, whose recipient is one of a given
+// number of participants, or an address that belongs to no participant for one message in ten.
+void AppendMessage(std::ofstream& stream, const std::size_t index,
+                   const std::size_t participant_count, const std::string& attachment) {
+  const std::string recipient{
+      index % 10 == 9 ? "stranger." + std::to_string(index) + "@example.org" :
+                        "participant." + std::to_string(index * 7919 % participant_count)
+                            + "@example.com"};
+  stream << "From MAILER-DAEMON Mon Dec  1 09:00:00 2025\n";
+  switch (index % 3) {
+    case 0:
+      stream << "From: Mail Delivery System <MAILER-DAEMON@example.com>\n"
+                "To: secret-santa@example.com\n"
+                "Subject: Undelivered Mail Returned to Sender\n"
+                "Content-Type: multipart/report; report-type=delivery-status; boundary=\"b\"\n"
+                "\n--b\nContent-Type: text/plain\n\nYour message could not be delivered.\n"
+                "\n--b\nContent-Type: message/delivery-status\n\n"
+                "Reporting-MTA: dns; mail.example.com\n\n"
+                "Final-Recipient: rfc822; "
+             << recipient
+             << "\nAction: failed\nStatus: 5.1.1\n"
+                "Diagnostic-Code: smtp; 550 5.1.1 User unknown\n";
+      break;
+    case 1:
+      stream << "From: Mail Delivery System <Mailer-Daemon@example.net>\n"
+                "To: secret-santa@example.com\n"
+                "X-Failed-Recipients: "
+             << recipient
+             << "\nSubject: Mail delivery failed: returning message to sender\n"
+                "Content-Type: multipart/mixed; boundary=\"b\"\n"
+                "\n--b\nContent-Type: text/plain\n\nA message could not be delivered.\n";
+      break;
+    default:
+      stream << "From: " << recipient
+             << "\nTo: secret-santa@example.com\n"
+                "Subject: Re: Secret Santa\n"
+                "Content-Type: multipart/mixed; boundary=\"b\"\n"
+                "\n--b\nContent-Type: text/plain\n\nThank you, I will get a present!\n";
+      break;
+  }
+  stream << "\n--b\nContent-Type: message/rfc822\nContent-Transfer-Encoding: base64\n\n"
+         << attachment << "--b--\n\n";
+}
+
+// Number of milliseconds elapsed since a given time.
+double MillisecondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t megabytes = 1024;
+  std::size_t participant_count = 100000;
+  std::filesystem::path mailbox{"bounce_benchmark.mbox"};
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--megabytes") {
+      megabytes = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--participants") {
+      participant_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--mailbox") {
+      mailbox = argv[index + 1];
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (participant_count == 0 || participant_count % 7919 == 0) {
+    std::cout << "The number of participants must be at least 1 and not a multiple of 7919."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Lines of base64 of 76 characters, as in a quoted original message of about 3 KiB.
+  std::string attachment;
+  for (int line = 0; line < 40; ++line) {
+    attachment.append("U2VjcmV0IFNhbnRhOiB5b3VyIGdpZnRlZSBpcyBhIHN1cnByaXNl");
+    attachment.append("IHRoaXMgeWVhciEgSG8gaG8g\n");
+  }
+
+  std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  {
+    std::ofstream stream{mailbox, std::ios::binary};
+    for (std::size_t index = 0; static_cast<std::size_t>(stream.tellp()) < megabytes << 20;
+         ++index) {
+      AppendMessage(stream, index, participant_count, attachment);
+    }
+  }
+  std::cout << std::fixed << std::setprecision(1) << "Wrote a mailbox of "
+            << std::filesystem::file_size(mailbox) / (1024 * 1024) << " MiB in "
+            << MillisecondsSince(start) << " ms." << std::endl;
+
+  std::set<SecretSanta::Participant> participants;
+  for (std::size_t index = 0; index < participant_count; ++index) {
+    const std::string number{std::to_string(index)};
+    participants.emplace("Participant " + number, "Participant." + number + "@Example.com", "", "");
+  }
+
+  for (const char* const pass : {"cold", "warm"}) {
+    start = std::chrono::steady_clock::now();
+    SecretSanta::BounceScanner scanner;
+    if (!scanner.ScanPath(mailbox)) {
+      return EXIT_FAILURE;
+    }
+    const double scan_milliseconds{MillisecondsSince(start)};
+
+    start = std::chrono::steady_clock::now();
+    const SecretSanta::BouncedGifters bounced_gifters{participants, scanner.Bounces()};
+    const double join_milliseconds{MillisecondsSince(start)};
+
+    const double mebibytes{static_cast<double>(scanner.ByteCount()) / (1024.0 * 1024.0)};
+    std::cout << std::setw(4) << pass << "  scan " << std::setw(8) << scan_milliseconds << " ms ("
+              << std::setw(7) << mebibytes / (scan_milliseconds / 1000.0) << " MiB/s)  messages "
+              << scanner.MessageCount() << "  bounces " << scanner.Bounces().size() << "  join "
+              << std::setw(6) << join_milliseconds << " ms  gifters "
+              << bounced_gifters.Entries().size() << "  unknown "
+              << bounced_gifters.UnknownRecipients().size() << std::endl;
+  }
+
+  std::filesystem::remove(mailbox);
+
+  return EXIT_SUCCESS;
+}
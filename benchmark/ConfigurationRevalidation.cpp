@@ -0,0 +1,138 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "../source/IncrementalConfiguration.hpp"
+
+// Benchmark of the incremental revalidation of a configuration file. Generates the text of a
+// configuration file with a given number of participants, and compares the time taken to parse it
+// in full, as the Secret Santa Randomizer does, with the time taken to revalidate it incrementally
+// after editing a single participant entry, as the Secret Santa Randomizer does with --watch.
+//
+// Usage:
+//   secret-santa-watch-benchmark [--participants <integer>] [--edits <integer>]
+
+namespace {
+
+// Generates the participant entry of the participant with a given index and a given revision of
+// their email address.
+std::string GenerateEntry(const std::size_t index, const std::size_t revision) {
+  return "  - Participant " + std::to_string(index) + ":\n      email: participant."
+         + std::to_string(index) + "." + std::to_string(revision) + "@example.com\n      address: "
+         + std::to_string(index) + " Main St, Springfield, IL 62701 USA\n";
+}
+
+// Generates the text of a configuration file from its participant entries.
+std::string GenerateText(const std::vector<std::string>& entries) {
+  std::string text{"message:\n  subject: Secret Santa\n  body: Welcome!\nevent:\n  start: "
+                   "2023-12-23 14:00\nparticipants:\n"};
+  for (const std::string& entry : entries) {
+    text.append(entry);
+  }
+  return text;
+}
+
+// Number of milliseconds elapsed since a given time.
+double MillisecondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t participant_count = 100000;
+  std::size_t edit_count = 20;
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--participants") {
+      participant_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--edits") {
+      edit_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (participant_count == 0) {
+    std::cout << "The number of participants must be at least 1." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> entries;
+  entries.reserve(participant_count);
+  for (std::size_t index = 0; index < participant_count; ++index) {
+    entries.push_back(GenerateEntry(index, 0));
+  }
+  const std::string text{GenerateText(entries)};
+  std::cout << "Configuration file of " << participant_count << " participants and "
+            << text.size() / 1024 << " KiB." << std::endl;
+
+  std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  const YAML::Node root{YAML::Load(text)};
+  std::set<SecretSanta::Participant> participants;
+  for (const YAML::iterator::value_type& participant_node : root["participants"]) {
+    participants.emplace(participant_node);
+  }
+  const double full_milliseconds{MillisecondsSince(start)};
+
+  SecretSanta::IncrementalConfiguration configuration;
+  start = std::chrono::steady_clock::now();
+  static_cast<void>(configuration.Update(text));
+  const double first_milliseconds{MillisecondsSince(start)};
+
+  double edit_milliseconds{0.0};
+  std::size_t parsed_entry_count{0};
+  for (std::size_t edit = 1; edit <= edit_count; ++edit) {
+    const std::size_t index{edit * 7919 % participant_count};
+    entries[index] = GenerateEntry(index, edit);
+    const std::string edited_text{GenerateText(entries)};
+
+    start = std::chrono::steady_clock::now();
+    const SecretSanta::ConfigurationChanges changes{configuration.Update(edited_text)};
+    edit_milliseconds += MillisecondsSince(start);
+    parsed_entry_count += changes.parsed_entry_count;
+  }
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Full parse:                       " << std::setw(10) << full_milliseconds << " ms ("
+            << participants.size() << " participants)" << std::endl;
+  std::cout << "First incremental revalidation:   " << std::setw(10) << first_milliseconds
+            << " ms (" << configuration.Participants().size() << " participants, "
+            << configuration.Problems().size() << " problems)" << std::endl;
+  if (edit_count > 0) {
+    std::cout << "Revalidation after one edit:      " << std::setw(10)
+              << edit_milliseconds / static_cast<double>(edit_count) << " ms on average ("
+              << static_cast<double>(parsed_entry_count) / static_cast<double>(edit_count)
+              << " entries parsed per edit)" << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "../source/DaemonClient.hpp"
+#include "../source/DaemonServer.hpp"
+
+// Benchmark of the Secret Santa Daemon. Writes a configuration file for an event with a given
+// number of participants, starts the daemon on a Unix domain socket, and has a given number of
+// clients randomize, verify, and render matchings in turn for a given duration, each waiting for
+// one response before sending the next request. Reports the latency quantiles of each operation
+// and the number of requests answered per second.
+//
+// Usage:
+//   secret-santa-daemon-benchmark [--participants <integer>] [--clients <integer>]
+//                                 [--threads <integer>] [--seconds <integer>]
+
+namespace {
+
+// Operations that each client requests in turn, along with their names.
+constexpr std::array<std::pair<SecretSanta::DaemonOperation, const char*>, 3> Operations{{
+  {SecretSanta::DaemonOperation::Randomize, "randomize"},
+  {SecretSanta::DaemonOperation::Verify,    "verify"   },
+  {SecretSanta::DaemonOperation::Render,    "render"   },
+}};
+
+// Writes a configuration file with a given number of participants, each with an email address
+// and a mailing address.
+void WriteConfiguration(const std::filesystem::path& path, const std::size_t count) {
+  YAML::Node root;
+  root["message"]["subject"] = "Secret Santa";
+  root["message"]["body"] = "You are receiving this message because you opted to participate in a "
+                            "Secret Santa gift exchange!";
+  for (std::size_t index = 0; index < count; ++index) {
+    const std::string name{"Participant " + std::to_string(index)};
+    YAML::Node node;
+    node[name]["email"] = "participant." + std::to_string(index) + "@example.com";
+    node[name]["address"] = std::to_string(index) + " Main St, Springfield, IL 62701 USA";
+    root["participants"].push_back(node);
+  }
+  std::ofstream stream{path};
+  stream << root;
+}
+
+// Requests the operations in turn over one connection until a given deadline, and records the
+// latency in microseconds of each request per operation. Returns whether every request succeeded.
+bool RunClient(const std::filesystem::path& socket, const std::string& configuration,
+               const std::string& matchings, const std::size_t participant_count,
+               const std::chrono::steady_clock::time_point deadline, const uint64_t seed,
+               std::array<std::vector<double>, Operations.size()>& latencies) {
+  SecretSanta::DaemonClient client{socket};
+  if (!client.IsConnected()) {
+    return false;
+  }
+
+  std::mt19937_64 generator{seed};
+  std::uniform_int_distribution<std::size_t> pick{0, participant_count - 1};
+  for (std::size_t request = 0; std::chrono::steady_clock::now() < deadline; ++request) {
+    const std::size_t operation = request % Operations.size();
+    const std::string gifter{"Participant " + std::to_string(pick(generator))};
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::optional<SecretSanta::DaemonResponse> response;
+    switch (Operations[operation].first) {
+      case SecretSanta::DaemonOperation::Randomize:
+        response = client.Call(Operations[operation].first, {configuration, ""});
+        break;
+      case SecretSanta::DaemonOperation::Verify:
+        response = client.Call(Operations[operation].first, {configuration, matchings});
+        break;
+      case SecretSanta::DaemonOperation::Render:
+        response = client.Call(Operations[operation].first, {configuration, matchings, gifter});
+        break;
+    }
+    latencies[operation].push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+            .count());
+    if (!response.has_value() || response->status != SecretSanta::DaemonStatus::Ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the latency at a given quantile of latencies sorted in ascending order.
+[[nodiscard]] double Quantile(const std::vector<double>& latencies, const double quantile) {
+  if (latencies.empty()) {
+    return 0.0;
+  }
+  const std::size_t index =
+      std::min(latencies.size() - 1,
+               static_cast<std::size_t>(quantile * static_cast<double>(latencies.size())));
+  return latencies[index];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t participant_count = 20;
+  std::size_t client_count = 4;
+  std::size_t thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  std::size_t seconds = 3;
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    const std::size_t value = std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+    if (key == "--participants") {
+      participant_count = std::max<std::size_t>(value, 2);
+    } else if (key == "--clients") {
+      client_count = value;
+    } else if (key == "--threads") {
+      thread_count = value;
+    } else if (key == "--seconds") {
+      seconds = value;
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path()
+      / ("secret-santa-daemon-benchmark-" + std::to_string(::getpid()));
+  std::filesystem::create_directories(directory);
+  const std::string configuration{(directory / "configuration.yaml").string()};
+  const std::string matchings{(directory / "matchings.yaml").string()};
+  const std::filesystem::path socket = directory / "daemon.sock";
+  WriteConfiguration(configuration, participant_count);
+
+  SecretSanta::DaemonService service;
+  std::vector<std::array<std::vector<double>, Operations.size()>> latencies(client_count);
+  std::vector<char> succeeded(client_count, 0);
+  double elapsed = 0.0;
+  {
+    // Mute the messages that reading the files and drawing the matchings print for every request.
+    std::streambuf* const console = std::cout.rdbuf(nullptr);
+    SecretSanta::DaemonServer server{service, socket, thread_count, client_count + 1};
+    if (server.IsListening()) {
+      // Write the matchings file once, such that the clients can verify and render them.
+      SecretSanta::DaemonClient setup{socket};
+      static_cast<void>(
+          setup.Call(SecretSanta::DaemonOperation::Randomize, {configuration, matchings}));
+
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      const std::chrono::steady_clock::time_point deadline =
+          start + std::chrono::seconds{static_cast<int64_t>(seconds)};
+      std::vector<std::thread> clients;
+      for (std::size_t client = 0; client < client_count; ++client) {
+        clients.emplace_back([&, client]() {
+          succeeded[client] = RunClient(socket, configuration, matchings, participant_count,
+                                        deadline, 2023 + client, latencies[client]) ?
+                                  1 :
+                                  0;
+        });
+      }
+      for (std::thread& client : clients) {
+        client.join();
+      }
+      elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    server.Stop();
+    std::cout.rdbuf(console);
+    if (!server.IsListening()) {
+      std::cout << "Cannot listen on the Unix domain socket at " << socket << "." << std::endl;
+      std::filesystem::remove_all(directory);
+      return EXIT_FAILURE;
+    }
+    server.PrintStatistics();
+  }
+  std::filesystem::remove_all(directory);
+
+  if (std::count(succeeded.begin(), succeeded.end(), 1)
+      != static_cast<std::ptrdiff_t>(client_count)) {
+    std::cout << "Some requests failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::size_t request_count = 0;
+  std::cout << std::fixed << std::setprecision(1);
+  for (std::size_t operation = 0; operation < Operations.size(); ++operation) {
+    std::vector<double> merged;
+    for (const std::array<std::vector<double>, Operations.size()>& client : latencies) {
+      merged.insert(merged.end(), client[operation].begin(), client[operation].end());
+    }
+    std::sort(merged.begin(), merged.end());
+    request_count += merged.size();
+    std::cout << std::setw(9) << Operations[operation].second << ": p50 " << Quantile(merged, 0.5)
+              << " us, p99 " << Quantile(merged, 0.99) << " us, p99.9 "
+              << Quantile(merged, 0.999) << " us over " << merged.size() << " requests."
+              << std::endl;
+  }
+  std::cout << std::setprecision(0) << "Answered " << request_count << " requests for an event of "
+            << participant_count << " participants from " << client_count << " clients with "
+            << thread_count << " worker threads: "
+            << static_cast<double>(request_count) / elapsed << " requests per second." << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../source/DistanceMatching.hpp"
+
+// Benchmark of the distance matching. Places a given number of participants around a few dozen
+// cities across the contiguous United States, matches them so as to minimize the total and then
+// the maximum shipping distance, and reports the time taken and the resulting distances, compared
+// with a random matching.
+//
+// Usage:
+//   secret-santa-distance-benchmark [--participants <integer>] [--threads <integer>]
+
+namespace {
+
+// Generates the locations of a given number of participants, most of them within a few dozen
+// kilometers of one of 40 random cities, and the rest anywhere in the contiguous United States.
+std::vector<std::optional<SecretSanta::Coordinates>> GenerateLocations(const std::size_t count) {
+  std::mt19937_64 generator{2023};
+  std::uniform_real_distribution<double> latitude{25.0, 49.0};
+  std::uniform_real_distribution<double> longitude{-124.0, -67.0};
+  std::normal_distribution<double> spread{0.0, 0.3};
+  std::uniform_int_distribution<int> roll{0, 9};
+
+  std::vector<SecretSanta::Coordinates> cities;
+  for (int index = 0; index < 40; ++index) {
+    cities.push_back({latitude(generator), longitude(generator)});
+  }
+  std::uniform_int_distribution<std::size_t> city{0, cities.size() - 1};
+
+  std::vector<std::optional<SecretSanta::Coordinates>> locations;
+  locations.reserve(count);
+  for (std::size_t index = 0; index < count; ++index) {
+    if (roll(generator) == 0) {
+      locations.push_back(SecretSanta::Coordinates{latitude(generator), longitude(generator)});
+    } else {
+      const SecretSanta::Coordinates& center = cities[city(generator)];
+      locations.push_back(SecretSanta::Coordinates{
+          std::clamp(center.latitude + spread(generator), -90.0, 90.0),
+          std::clamp(center.longitude + spread(generator), -180.0, 180.0)});
+    }
+  }
+  return locations;
+}
+
+// Runs the distance matching with a given objective and prints one line of results.
+void Run(const std::vector<std::optional<SecretSanta::Coordinates>>& locations,
+         const SecretSanta::DistanceObjective objective, const std::size_t thread_count) {
+  SecretSanta::DistanceMatchingOptions options;
+  options.objective = objective;
+  options.thread_count = thread_count;
+  std::mt19937_64 generator{42};
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const SecretSanta::DistanceMatchingResult result{
+      SecretSanta::MatchByDistance(locations, options, generator)};
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << std::fixed << std::setprecision(2) << "Minimized the " << std::setw(7)
+            << SecretSanta::DistanceObjectiveName(objective) << " distance in " << std::setw(6)
+            << seconds << " s: " << std::setw(8) << result.total_kilometers / locations.size()
+            << " km on average, " << std::setw(8) << result.maximum_kilometers << " km at most."
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t participant_count = 100'000;
+  std::size_t thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--participants") {
+      participant_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--threads") {
+      thread_count = std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::vector<std::optional<SecretSanta::Coordinates>> locations{
+      GenerateLocations(participant_count)};
+
+  // A random cycle, as the default matching would produce, for comparison.
+  std::vector<std::size_t> order(locations.size());
+  for (std::size_t index = 0; index < order.size(); ++index) {
+    order[index] = index;
+  }
+  std::mt19937_64 generator{7};
+  std::shuffle(order.begin(), order.end(), generator);
+  double random_total = 0.0;
+  for (std::size_t index = 0; index < order.size(); ++index) {
+    random_total += SecretSanta::GreatCircleDistance(
+        locations[order[index]].value(), locations[order[(index + 1) % order.size()]].value());
+  }
+  std::cout << std::fixed << std::setprecision(2) << "Random matching of " << locations.size()
+            << " participants: " << random_total / locations.size() << " km on average."
+            << std::endl;
+
+  Run(locations, SecretSanta::DistanceObjective::Total, thread_count);
+  Run(locations, SecretSanta::DistanceObjective::Maximum, thread_count);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,539 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "../source/CycleLengths.hpp"
+#include "../source/RandomRounds.hpp"
+#include "../source/Statistics.hpp"
+
+// Statistical audit of the fairness of the random draw of the matchings. Draws the matchings of a
+// given number of participants many times for a few configurations, on all cores, and tests the
+// outcomes against the distribution that a fair draw follows:
+// - Each gifter gifts to each other participant equally often, and each giftee receives from each
+//   other participant equally often. Each gifter's counts are tested with a chi-squared test over
+//   the whole run and within each batch of draws, and the p-values of the batches are tested for
+//   uniformity with a Kolmogorov-Smirnov test.
+// - The number of cycles of each round follows the distribution of the cycle length partition.
+// - Each participant belongs to a cycle of each length as often as the cycle length partition
+//   implies, so that no participant is systematically placed in shorter or longer cycles.
+// Prints a report and optionally writes it with the pair frequency matrices to a YAML file. Exits
+// with a failure status if any test fails. Each batch of draws has its own seed, so the report
+// only depends on the seed and not on the number of threads.
+//
+// Usage:
+//   secret-santa-fairness-audit [--participants <integer>] [--draws <integer>]
+//                               [--threads <integer>] [--seed <integer>] [--report <path>]
+
+namespace {
+
+// Smallest p-value, after adjusting for the number of tests, at which a test passes.
+constexpr double Significance{0.001};
+
+// Largest number of batches of draws.
+constexpr std::size_t MaximumBatchCount{1024};
+
+// Configuration of the draw to audit.
+struct AuditConfiguration {
+  // Name of the configuration in the report.
+  std::string name;
+
+  // Optional bounds on the number of participants in each cycle.
+  std::optional<SecretSanta::CycleLengths> cycle_lengths;
+
+  // Number of gifts that each participant gives and receives.
+  std::size_t gift_count{1};
+};
+
+// Counts accumulated over a number of draws.
+struct Tally {
+  // Constructor. Constructs empty counts for a given number of participants.
+  explicit Tally(const std::size_t participant_count)
+    : pair_counts(participant_count * participant_count, 0),
+      cycle_count_counts(participant_count + 1, 0),
+      membership_counts(participant_count * (participant_count + 1), 0),
+      length_counts(participant_count + 1, 0) {}
+
+  // Adds the counts of another tally to these counts.
+  void Add(const Tally& other) {
+    for (std::size_t index = 0; index < pair_counts.size(); ++index) {
+      pair_counts[index] += other.pair_counts[index];
+    }
+    for (std::size_t index = 0; index < cycle_count_counts.size(); ++index) {
+      cycle_count_counts[index] += other.cycle_count_counts[index];
+      length_counts[index] += other.length_counts[index];
+    }
+    for (std::size_t index = 0; index < membership_counts.size(); ++index) {
+      membership_counts[index] += other.membership_counts[index];
+    }
+    draw_count += other.draw_count;
+    self_gift_count += other.self_gift_count;
+    offset_count += other.offset_count;
+  }
+
+  // Resets all counts to zero.
+  void Clear() {
+    std::fill(pair_counts.begin(), pair_counts.end(), 0);
+    std::fill(cycle_count_counts.begin(), cycle_count_counts.end(), 0);
+    std::fill(membership_counts.begin(), membership_counts.end(), 0);
+    std::fill(length_counts.begin(), length_counts.end(), 0);
+    draw_count = 0;
+    self_gift_count = 0;
+    offset_count = 0;
+  }
+
+  // Number of gifts from each gifter to each giftee, indexed by the gifter times the number of
+  // participants plus the giftee.
+  std::vector<uint64_t> pair_counts;
+
+  // Number of rounds with each number of cycles.
+  std::vector<uint64_t> cycle_count_counts;
+
+  // Number of rounds in which each participant belongs to a cycle of each length, indexed by the
+  // participant times the number of participants plus one, plus the length.
+  std::vector<uint64_t> membership_counts;
+
+  // Number of cycles of each length.
+  std::vector<uint64_t> length_counts;
+
+  // Number of draws.
+  uint64_t draw_count{0};
+
+  // Number of gifters who gift to themselves.
+  uint64_t self_gift_count{0};
+
+  // Number of draws that fell back on offsetting one shuffled order.
+  uint64_t offset_count{0};
+};
+
+// Outcome of a test: the smallest p-value of its parts, adjusted for their number.
+struct TestResult {
+  // Name of the test in the report.
+  std::string name;
+
+  // Smallest p-value of the parts of the test.
+  double minimum_p_value{1.0};
+
+  // Smallest p-value multiplied by the number of parts, capped at one.
+  double adjusted_p_value{1.0};
+};
+
+// Outcome of the audit of one configuration.
+struct AuditResult {
+  // Configuration that was audited.
+  AuditConfiguration configuration;
+
+  // Number of rounds of gifts per draw, which may be fewer than the number of gifts.
+  std::size_t round_count{1};
+
+  // Counts accumulated over all draws.
+  Tally total;
+
+  // Time taken to draw and count, in seconds.
+  double seconds{0.0};
+
+  // Results of the tests.
+  std::vector<TestResult> tests;
+
+  // Largest relative deviation of the number of gifts between two participants from its
+  // expectation.
+  double largest_pair_deviation{0.0};
+
+  // Whether every test passed and no participant gifted to themselves.
+  bool passed{true};
+};
+
+// Adds the outcome of the last draw of given rounds of gifts to a given tally. The visited flags
+// and members are scratch space.
+void Record(const SecretSanta::RandomRounds& rounds, Tally& tally, std::vector<uint8_t>& visited,
+            std::vector<std::size_t>& members) {
+  const std::size_t participant_count = rounds.ParticipantCount();
+  for (std::size_t round = 0; round < rounds.RoundCount(); ++round) {
+    const std::vector<std::size_t>& giftees = rounds.Giftees(round);
+    for (std::size_t gifter = 0; gifter < participant_count; ++gifter) {
+      ++tally.pair_counts[gifter * participant_count + giftees[gifter]];
+      tally.self_gift_count += giftees[gifter] == gifter ? 1 : 0;
+    }
+
+    std::fill(visited.begin(), visited.end(), 0);
+    std::size_t cycle_count = 0;
+    for (std::size_t start = 0; start < participant_count; ++start) {
+      members.clear();
+      for (std::size_t index = start; visited[index] == 0; index = giftees[index]) {
+        visited[index] = 1;
+        members.push_back(index);
+      }
+      if (members.empty()) {
+        continue;
+      }
+      ++cycle_count;
+      ++tally.length_counts[members.size()];
+      for (const std::size_t member : members) {
+        ++tally.membership_counts[member * (participant_count + 1) + members.size()];
+      }
+    }
+    ++tally.cycle_count_counts[cycle_count];
+  }
+  ++tally.draw_count;
+  tally.offset_count += rounds.Offset() ? 1 : 0;
+}
+
+// P-value of the chi-squared test that a given participant gifts to, or receives from, each other
+// participant equally often, given the counts, the number of rounds, and whether to test the
+// participant as a giftee rather than as a gifter. Each draw gives each participant as many
+// distinct partners as there are rounds, which shrinks the statistic by a known factor compared
+// with independent gifts.
+double PairPValue(const Tally& tally, const std::size_t participant, const std::size_t round_count,
+                  const bool as_giftee) {
+  const std::size_t participant_count = tally.cycle_count_counts.size() - 1;
+  const std::size_t partner_count = participant_count - 1;
+  std::vector<uint64_t> observed(participant_count);
+  std::vector<double> expected(participant_count,
+                               static_cast<double>(tally.draw_count * round_count)
+                                   / static_cast<double>(partner_count));
+  for (std::size_t partner = 0; partner < participant_count; ++partner) {
+    observed[partner] = as_giftee ? tally.pair_counts[partner * participant_count + participant] :
+                                    tally.pair_counts[participant * participant_count + partner];
+  }
+  expected[participant] = 0.0;
+  const std::optional<double> statistic = SecretSanta::ChiSquaredStatistic(observed, expected);
+  if (!statistic.has_value()) {
+    return 0.0;
+  }
+  if (partner_count <= round_count) {
+    return statistic.value() > 0.0 ? 0.0 : 1.0;
+  }
+  return SecretSanta::ChiSquaredSurvival(
+      statistic.value() * static_cast<double>(partner_count - 1)
+          / static_cast<double>(partner_count - round_count),
+      static_cast<double>(partner_count - 1));
+}
+
+// P-value of the chi-squared test of given counts against given probabilities over a given number
+// of trials.
+double GoodnessOfFitPValue(const std::vector<uint64_t>& observed,
+                           const std::vector<double>& probabilities, const uint64_t trial_count) {
+  std::vector<double> expected(observed.size(), 0.0);
+  std::size_t category_count = 0;
+  for (std::size_t index = 0; index < observed.size() && index < probabilities.size(); ++index) {
+    expected[index] = probabilities[index] * static_cast<double>(trial_count);
+    category_count += probabilities[index] > 0.0 ? 1 : 0;
+  }
+  return SecretSanta::ChiSquaredPValue(
+      observed, expected, static_cast<double>(category_count) - 1.0);
+}
+
+// Adjusts the smallest of given p-values for their number.
+TestResult Adjust(const std::string& name, const std::vector<double>& p_values) {
+  TestResult result;
+  result.name = name;
+  if (!p_values.empty()) {
+    result.minimum_p_value = *std::min_element(p_values.cbegin(), p_values.cend());
+    result.adjusted_p_value =
+        std::min(1.0, result.minimum_p_value * static_cast<double>(p_values.size()));
+  }
+  return result;
+}
+
+// Draws the matchings of a given configuration a given number of times on a given number of
+// threads, and tests the outcomes.
+AuditResult Audit(const AuditConfiguration& configuration, const std::size_t configuration_index,
+                  const std::size_t participant_count, const uint64_t draw_count,
+                  const std::size_t thread_count, const uint64_t seed) {
+  const std::size_t round_count =
+      SecretSanta::RandomRounds{participant_count, configuration.gift_count,
+                                configuration.cycle_lengths}
+          .RoundCount();
+
+  // Each batch holds enough draws for about a hundred gifts between each two participants, so that
+  // the chi-squared test of each batch is accurate.
+  const uint64_t batch_count = std::clamp<uint64_t>(
+      draw_count * round_count / (100 * (participant_count - 1)), 1, MaximumBatchCount);
+
+  AuditResult result{configuration, round_count, Tally{participant_count}, 0.0, {}, 0.0, true};
+  std::vector<double> batch_p_values;
+  std::mutex mutex;
+  std::atomic<uint64_t> next_batch{0};
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t thread = 0; thread < thread_count; ++thread) {
+    threads.emplace_back([&]() {
+      SecretSanta::RandomRounds rounds{
+        participant_count, configuration.gift_count, configuration.cycle_lengths};
+      Tally tally{participant_count};
+      std::vector<uint8_t> visited(participant_count);
+      std::vector<std::size_t> members;
+      std::vector<double> p_values(2 * participant_count);
+      for (uint64_t batch = next_batch++; batch < batch_count; batch = next_batch++) {
+        std::seed_seq sequence{seed, static_cast<uint64_t>(configuration_index), batch};
+        std::mt19937_64 random_generator{sequence};
+        const uint64_t batch_draw_count =
+            draw_count / batch_count + (batch < draw_count % batch_count ? 1 : 0);
+
+        tally.Clear();
+        for (uint64_t draw = 0; draw < batch_draw_count; ++draw) {
+          rounds.Draw(random_generator);
+          Record(rounds, tally, visited, members);
+        }
+        for (std::size_t participant = 0; participant < participant_count; ++participant) {
+          p_values[2 * participant] = PairPValue(tally, participant, round_count, false);
+          p_values[2 * participant + 1] = PairPValue(tally, participant, round_count, true);
+        }
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        result.total.Add(tally);
+        batch_p_values.insert(batch_p_values.end(), p_values.cbegin(), p_values.cend());
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const Tally& total = result.total;
+
+  // Pair frequencies over the whole run.
+  std::vector<double> gifter_p_values;
+  std::vector<double> giftee_p_values;
+  const double expected_pair_count = static_cast<double>(total.draw_count * round_count)
+                                     / static_cast<double>(participant_count - 1);
+  for (std::size_t participant = 0; participant < participant_count; ++participant) {
+    gifter_p_values.push_back(PairPValue(total, participant, round_count, false));
+    giftee_p_values.push_back(PairPValue(total, participant, round_count, true));
+    for (std::size_t partner = 0; partner < participant_count; ++partner) {
+      if (partner != participant) {
+        const double count =
+            static_cast<double>(total.pair_counts[participant * participant_count + partner]);
+        result.largest_pair_deviation =
+            std::max(result.largest_pair_deviation,
+                     std::abs(count - expected_pair_count) / expected_pair_count);
+      }
+    }
+  }
+  result.tests.push_back(Adjust("Giftees of each gifter are uniform", gifter_p_values));
+  result.tests.push_back(Adjust("Gifters of each giftee are uniform", giftee_p_values));
+
+  // Uniformity of the p-values of the batches.
+  TestResult batches;
+  batches.name = "P-values of the batches are uniform (Kolmogorov-Smirnov)";
+  batches.minimum_p_value = SecretSanta::KolmogorovSmirnovSurvival(
+      SecretSanta::KolmogorovSmirnovStatistic(batch_p_values), batch_p_values.size());
+  batches.adjusted_p_value = batches.minimum_p_value;
+  result.tests.push_back(batches);
+
+  // Cycle structure. Without cycle length bounds, or if they cannot be met, each round is one
+  // cycle of all participants.
+  std::optional<std::vector<double>> cycle_count_probabilities;
+  std::optional<std::vector<double>> membership_probabilities;
+  if (configuration.cycle_lengths.has_value()) {
+    cycle_count_probabilities =
+        configuration.cycle_lengths->CycleCountProbabilities(participant_count);
+    membership_probabilities =
+        configuration.cycle_lengths->MembershipProbabilities(participant_count);
+  }
+  if (!cycle_count_probabilities.has_value() || !membership_probabilities.has_value()) {
+    cycle_count_probabilities = std::vector<double>(participant_count + 1, 0.0);
+    cycle_count_probabilities.value()[1] = 1.0;
+    membership_probabilities = std::vector<double>(participant_count + 1, 0.0);
+    membership_probabilities.value()[participant_count] = 1.0;
+  }
+  const uint64_t round_total = total.draw_count * round_count;
+  result.tests.push_back(Adjust(
+      "Number of cycles follows the partition",
+      {GoodnessOfFitPValue(total.cycle_count_counts, cycle_count_probabilities.value(),
+                           round_total)}));
+
+  std::vector<double> membership_p_values;
+  for (std::size_t participant = 0; participant < participant_count; ++participant) {
+    const std::vector<uint64_t> observed(
+        total.membership_counts.cbegin() + participant * (participant_count + 1),
+        total.membership_counts.cbegin() + (participant + 1) * (participant_count + 1));
+    membership_p_values.push_back(
+        GoodnessOfFitPValue(observed, membership_probabilities.value(), round_total));
+  }
+  result.tests.push_back(
+      Adjust("Cycle length of each participant follows the partition", membership_p_values));
+
+  result.passed = total.self_gift_count == 0;
+  for (const TestResult& test : result.tests) {
+    result.passed = result.passed && test.adjusted_p_value >= Significance;
+  }
+  return result;
+}
+
+// Prints the report of the audit of one configuration to the console.
+void Print(const AuditResult& result, const std::size_t participant_count,
+           const std::size_t thread_count) {
+  const Tally& total = result.total;
+  std::cout << "Configuration: " << result.configuration.name << " (" << participant_count
+            << " participants, " << result.round_count << " rounds per draw)" << std::endl;
+  std::cout << std::fixed << std::setprecision(1) << "  Drew " << total.draw_count
+            << " matchings in " << result.seconds << " s ("
+            << static_cast<double>(total.draw_count) / std::max(result.seconds, 1.0e-9) / 1.0e6
+            << " million per second on " << thread_count << " threads)." << std::endl;
+  std::cout << "  Self-gifts: " << total.self_gift_count
+            << "; draws offsetting one shuffled order: " << total.offset_count << "." << std::endl;
+  std::cout << std::setprecision(3) << "  Largest deviation of a pair frequency: "
+            << result.largest_pair_deviation * 100.0 << "%." << std::endl;
+  for (const TestResult& test : result.tests) {
+    std::cout << std::scientific << std::setprecision(3) << "  " << test.name
+              << ": smallest p-value " << test.minimum_p_value << ", adjusted "
+              << test.adjusted_p_value << (test.adjusted_p_value >= Significance ? "." : " FAIL.")
+              << std::endl;
+  }
+  std::cout << std::fixed << std::setprecision(2) << "  Cycle lengths:";
+  uint64_t cycle_total = 0;
+  for (const uint64_t count : total.length_counts) {
+    cycle_total += count;
+  }
+  for (std::size_t length = 0; length < total.length_counts.size(); ++length) {
+    if (total.length_counts[length] > 0) {
+      std::cout << " " << length << ": "
+                << 100.0 * static_cast<double>(total.length_counts[length])
+                       / static_cast<double>(cycle_total)
+                << "%";
+    }
+  }
+  std::cout << "." << std::endl;
+  std::cout << "  " << (result.passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+// Writes the reports of the audits with their pair frequency matrices to a given YAML file.
+void WriteReport(const std::filesystem::path& path, const std::vector<AuditResult>& results,
+                 const std::size_t participant_count, const uint64_t seed) {
+  YAML::Emitter emitter;
+  emitter << YAML::BeginMap;
+  emitter << YAML::Key << "participants" << YAML::Value << participant_count;
+  emitter << YAML::Key << "seed" << YAML::Value << seed;
+  emitter << YAML::Key << "significance" << YAML::Value << Significance;
+  emitter << YAML::Key << "configurations" << YAML::Value << YAML::BeginSeq;
+  for (const AuditResult& result : results) {
+    const Tally& total = result.total;
+    emitter << YAML::BeginMap;
+    emitter << YAML::Key << "name" << YAML::Value << result.configuration.name;
+    emitter << YAML::Key << "rounds" << YAML::Value << result.round_count;
+    emitter << YAML::Key << "draws" << YAML::Value << total.draw_count;
+    emitter << YAML::Key << "seconds" << YAML::Value << result.seconds;
+    emitter << YAML::Key << "self_gifts" << YAML::Value << total.self_gift_count;
+    emitter << YAML::Key << "offset_draws" << YAML::Value << total.offset_count;
+    emitter << YAML::Key << "largest_pair_deviation" << YAML::Value
+            << result.largest_pair_deviation;
+    emitter << YAML::Key << "tests" << YAML::Value << YAML::BeginSeq;
+    for (const TestResult& test : result.tests) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "name" << YAML::Value << test.name;
+      emitter << YAML::Key << "minimum_p_value" << YAML::Value << test.minimum_p_value;
+      emitter << YAML::Key << "adjusted_p_value" << YAML::Value << test.adjusted_p_value;
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq;
+    emitter << YAML::Key << "cycle_count_histogram" << YAML::Value << YAML::Flow
+            << total.cycle_count_counts;
+    emitter << YAML::Key << "cycle_length_histogram" << YAML::Value << YAML::Flow
+            << total.length_counts;
+    emitter << YAML::Key << "pair_counts" << YAML::Value << YAML::BeginSeq;
+    for (std::size_t gifter = 0; gifter < participant_count; ++gifter) {
+      emitter << YAML::Flow
+              << std::vector<uint64_t>(
+                     total.pair_counts.cbegin() + gifter * participant_count,
+                     total.pair_counts.cbegin() + (gifter + 1) * participant_count);
+    }
+    emitter << YAML::EndSeq;
+    emitter << YAML::Key << "passed" << YAML::Value << result.passed;
+    emitter << YAML::EndMap;
+  }
+  emitter << YAML::EndSeq << YAML::EndMap;
+
+  std::ofstream stream{path};
+  stream << emitter.c_str() << std::endl;
+  std::cout << "Wrote the report to: " << path << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t participant_count = 50;
+  uint64_t draw_count = 1'000'000;
+  std::size_t thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  uint64_t seed = 2023;
+  std::filesystem::path report;
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--participants") {
+      participant_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--draws") {
+      draw_count = std::max<uint64_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+    } else if (key == "--threads") {
+      thread_count = std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+    } else if (key == "--seed") {
+      seed = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--report") {
+      report = argv[index + 1];
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (participant_count < 3) {
+    std::cout << "The audit needs at least 3 participants." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<AuditConfiguration> configurations{
+    {"one cycle", std::nullopt, 1},
+    {"cycles of 2 to 5 participants", SecretSanta::CycleLengths{2, 5}, 1},
+    {"3 gifts", std::nullopt, 3},
+  };
+
+  std::vector<AuditResult> results;
+  bool passed = true;
+  for (std::size_t index = 0; index < configurations.size(); ++index) {
+    results.push_back(
+        Audit(configurations[index], index, participant_count, draw_count, thread_count, seed));
+    Print(results.back(), participant_count, thread_count);
+    passed = passed && results.back().passed;
+  }
+
+  if (!report.empty()) {
+    WriteReport(report, results, participant_count, seed);
+  }
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
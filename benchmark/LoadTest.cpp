@@ -0,0 +1,439 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "../source/Certificates.hpp"
+#include "../source/Configuration.hpp"
+#include "../source/Emailer.hpp"
+#include "../source/EventLoopSmtpTransport.hpp"
+#include "../source/Matchings.hpp"
+#include "../source/Participant.hpp"
+#include "../source/SmtpSink.hpp"
+#include "../source/SmtpTransport.hpp"
+#include "../source/Tls.hpp"
+
+// Load test of the Secret Santa Messenger. Sends email messages to synthetic participants through
+// the SMTP transport to a local SMTP sink running in the same process, and reports the throughput
+// and the latency of each email message from the moment it is handed to the transport until its
+// delivery completes.
+//
+// Usage:
+//   secret-santa-load-test [--recipients <integer>]... [--connections <integer>]
+//                          [--event-loops <integer>] [--latency <integer>]
+//                          [--rejection-rate <number>] [--deferral-rate <number>]
+//                          [--sink <host:port>] [--tls <resume|full>] [--ca-file <path>]
+//                          [--messages-per-connection <integer>]
+
+namespace {
+
+// Transport that forwards email messages to another transport and records the latency of each
+// delivery.
+class TimingTransport : public SecretSanta::Transport {
+public:
+  // Constructor. Constructs a transport that forwards email messages to a given transport.
+  explicit TimingTransport(SecretSanta::Transport& transport) : transport_(transport) {}
+
+  [[nodiscard]] std::string Name() const override {
+    return transport_.Name();
+  }
+
+  void Send(SecretSanta::EmailMessage message, Completion completion) override {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    transport_.Send(std::move(message),
+                    [this, start, completion = std::move(completion)](
+                        const SecretSanta::EmailMessage& sent_message,
+                        const SecretSanta::Delivery& delivery) {
+                      const double microseconds =
+                          std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+                      {
+                        const std::lock_guard<std::mutex> lock{mutex_};
+                        latencies_.push_back(microseconds);
+                      }
+                      completion(sent_message, delivery);
+                    });
+  }
+
+  void Flush() override {
+    transport_.Flush();
+  }
+
+  // Latencies in microseconds of the deliveries that completed so far, in ascending order.
+  [[nodiscard]] std::vector<double> SortedLatencies() {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    std::vector<double> latencies{latencies_};
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+  }
+
+private:
+  // Transport to which email messages are forwarded.
+  SecretSanta::Transport& transport_;
+
+  // Protects the latencies.
+  std::mutex mutex_;
+
+  // Latencies in microseconds of the deliveries that completed so far.
+  std::vector<double> latencies_;
+};
+
+// Stream buffer that discards everything written to it except its last few lines. Keeps the
+// console quiet while the Messenger prints one line per email message, while still keeping its
+// final report.
+class TailBuffer : public std::streambuf {
+public:
+  // Constructor. Constructs a stream buffer that keeps a given number of lines.
+  explicit TailBuffer(const std::size_t line_count) : line_count_(line_count) {}
+
+  // Lines kept so far.
+  [[nodiscard]] const std::deque<std::string>& Lines() const noexcept {
+    return lines_;
+  }
+
+protected:
+  int_type overflow(const int_type character) override {
+    if (character == traits_type::eof()) {
+      return traits_type::not_eof(character);
+    }
+    if (character == '\n') {
+      lines_.push_back(std::move(line_));
+      line_.clear();
+      if (lines_.size() > line_count_) {
+        lines_.pop_front();
+      }
+    } else {
+      line_.push_back(static_cast<char>(character));
+    }
+    return character;
+  }
+
+private:
+  // Number of lines kept.
+  std::size_t line_count_;
+
+  // Last complete lines.
+  std::deque<std::string> lines_;
+
+  // Line currently being written.
+  std::string line_;
+};
+
+// Creates a given number of synthetic participants.
+[[nodiscard]] std::set<SecretSanta::Participant> CreateParticipants(const std::size_t count) {
+  std::set<SecretSanta::Participant> participants;
+  for (std::size_t index = 0; index < count; ++index) {
+    YAML::Node details;
+    details["email"] = "participant." + std::to_string(index) + "@example.com";
+    details["address"] = std::to_string(index) + " Main St, Townsville, CA 90210 USA";
+    details["instructions"] = "Leave the package at the front door.";
+    YAML::Node node;
+    node["Participant " + std::to_string(index)] = details;
+    participants.emplace(node);
+  }
+  return participants;
+}
+
+// Returns the latency at a given quantile of latencies sorted in ascending order.
+[[nodiscard]] double Quantile(const std::vector<double>& latencies, const double quantile) {
+  if (latencies.empty()) {
+    return 0.0;
+  }
+  const std::size_t index =
+      std::min(latencies.size() - 1,
+               static_cast<std::size_t>(quantile * static_cast<double>(latencies.size())));
+  return latencies[index];
+}
+
+// Options of the load test.
+struct Options {
+  // Number of connections to the mail server.
+  std::size_t connection_count{8};
+
+  // Number of event loop threads that multiplex the connections, or none if each connection is
+  // served by its own thread.
+  std::optional<std::size_t> event_loop_count;
+
+  // Latency after which the in-process sink answers each command.
+  std::chrono::microseconds latency{0};
+
+  // Fraction of the recipients that the in-process sink rejects.
+  double rejection_rate{0.0};
+
+  // Fraction of the messages that the in-process sink defers.
+  double deferral_rate{0.0};
+
+  // Host and port of a sink running in another process, if any. Running the sink in another
+  // process keeps its threads and memory out of the measurements.
+  std::optional<std::pair<std::string, uint16_t>> sink;
+
+  // Whether the connections are encrypted with TLS.
+  bool tls{false};
+
+  // Whether TLS sessions are resumed rather than each connection performing a full handshake.
+  bool resume{true};
+
+  // Path to the certificate authority of a sink running in another process. The in-process sink
+  // uses certificates created for the load test.
+  std::filesystem::path ca_file;
+
+  // Number of messages after which each connection is replaced, or 0 if connections are kept open.
+  std::size_t messages_per_connection{0};
+};
+
+// Samples the resident memory and thread count of this process in the background and keeps their
+// largest values.
+class ResourceSampler {
+public:
+  // Constructor. Starts sampling.
+  ResourceSampler() {
+    thread_ = std::thread{[this]() {
+      while (!stopping_.load()) {
+        Sample();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }};
+  }
+
+  // Destructor. Stops sampling.
+  ~ResourceSampler() noexcept {
+    stopping_.store(true);
+    thread_.join();
+  }
+
+  // Largest resident memory in kibibytes observed so far.
+  [[nodiscard]] std::size_t PeakResidentKibibytes() const noexcept {
+    return peak_resident_kibibytes_.load();
+  }
+
+  // Largest number of threads observed so far.
+  [[nodiscard]] std::size_t PeakThreadCount() const noexcept {
+    return peak_thread_count_.load();
+  }
+
+private:
+  // Reads the resident memory and thread count of this process once.
+  void Sample() {
+    std::ifstream status{"/proc/self/status"};
+    std::string line;
+    while (std::getline(status, line)) {
+      if (line.rfind("VmRSS:", 0) == 0) {
+        const std::size_t value = std::strtoull(line.c_str() + 6, nullptr, 10);
+        peak_resident_kibibytes_.store(std::max(peak_resident_kibibytes_.load(), value));
+      } else if (line.rfind("Threads:", 0) == 0) {
+        const std::size_t value = std::strtoull(line.c_str() + 8, nullptr, 10);
+        peak_thread_count_.store(std::max(peak_thread_count_.load(), value));
+      }
+    }
+  }
+
+  // Whether to stop sampling.
+  std::atomic<bool> stopping_{false};
+
+  // Largest resident memory in kibibytes observed so far.
+  std::atomic<std::size_t> peak_resident_kibibytes_{0};
+
+  // Largest number of threads observed so far.
+  std::atomic<std::size_t> peak_thread_count_{0};
+
+  // Thread that samples.
+  std::thread thread_;
+};
+
+// Runs the load test with a given number of recipients and prints its results.
+void Run(const std::size_t recipient_count, const Options& options) {
+  std::cout << "Sending " << recipient_count << " email messages over "
+            << options.connection_count << " connections "
+            << (options.event_loop_count.has_value() ?
+                    "on " + std::to_string(options.event_loop_count.value()) + " event loops" :
+                    "with one thread each")
+            << (options.tls ? (options.resume ? " over TLS with session resumption" :
+                                                " over TLS with full handshakes") :
+                              "")
+            << "..." << std::endl;
+
+  std::filesystem::path ca_file{options.ca_file};
+  std::optional<SecretSanta::TlsServerContext> tls_server;
+  if (options.tls && !options.sink.has_value()) {
+    const std::filesystem::path directory{"load_test_certificates"};
+    if (!SecretSanta::CreateCertificates(directory)) {
+      exit(EXIT_FAILURE);
+    }
+    tls_server.emplace(directory / SecretSanta::CertificateFile::Certificate,
+                       directory / SecretSanta::CertificateFile::PrivateKey);
+    ca_file = directory / SecretSanta::CertificateFile::Authority;
+  }
+  std::optional<SecretSanta::TlsClientContext> tls_client;
+  if (options.tls) {
+    tls_client.emplace(ca_file, options.resume);
+    if (!tls_client->IsValid()) {
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  std::optional<SecretSanta::SmtpSink> sink;
+  std::string host{"127.0.0.1"};
+  uint16_t port{0};
+  if (options.sink.has_value()) {
+    host = options.sink->first;
+    port = options.sink->second;
+  } else {
+    sink.emplace(0, options.latency, options.rejection_rate, options.deferral_rate,
+                 std::max<std::size_t>(options.connection_count, 1024), 0,
+                 tls_server.has_value() ? &tls_server.value() : nullptr);
+    if (!sink->IsListening()) {
+      exit(EXIT_FAILURE);
+    }
+    port = sink->Port();
+  }
+
+  TailBuffer tail{8};
+  std::streambuf* const console = std::cout.rdbuf(&tail);
+
+  const SecretSanta::Configuration configuration{CreateParticipants(recipient_count)};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 0};
+
+  std::unique_ptr<SecretSanta::Transport> smtp_transport;
+  if (options.event_loop_count.has_value()) {
+    smtp_transport = std::make_unique<SecretSanta::EventLoopSmtpTransport>(
+        host, port, "secret-santa@localhost", options.connection_count,
+        options.event_loop_count.value());
+  } else {
+    smtp_transport = std::make_unique<SecretSanta::SmtpTransport>(
+        host, port, "secret-santa@localhost", options.connection_count,
+        tls_client.has_value() ? &tls_client.value() : nullptr, options.messages_per_connection);
+  }
+  TimingTransport transport{*smtp_transport};
+
+  std::chrono::steady_clock::time_point start;
+  double elapsed_seconds{0.0};
+  std::size_t peak_resident_kibibytes{0};
+  std::size_t peak_thread_count{0};
+  {
+    const ResourceSampler sampler;
+    start = std::chrono::steady_clock::now();
+    SecretSanta::ComposeAndSendEmailMessages(configuration, matchings, transport);
+    elapsed_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    peak_resident_kibibytes = sampler.PeakResidentKibibytes();
+    peak_thread_count = sampler.PeakThreadCount();
+  }
+
+  std::cout.rdbuf(console);
+
+  for (const std::string& line : tail.Lines()) {
+    if (line.rfind("- ", 0) == 0
+        || (line.rfind("Sent ", 0) == 0 && line.rfind("Sent an email message", 0) != 0)) {
+      std::cout << line << std::endl;
+    }
+  }
+
+  const std::vector<double> latencies{transport.SortedLatencies()};
+  std::cout << "Throughput: " << static_cast<double>(latencies.size()) / elapsed_seconds
+            << " messages per second." << std::endl;
+  std::cout << "Latency in microseconds: median " << Quantile(latencies, 0.5) << ", 90th "
+            << Quantile(latencies, 0.9) << ", 99th " << Quantile(latencies, 0.99) << ", 99.9th "
+            << Quantile(latencies, 0.999) << ", maximum "
+            << (latencies.empty() ? 0.0 : latencies.back()) << "." << std::endl;
+  std::cout << "Peak resident memory: " << peak_resident_kibibytes / 1024 << " MiB; peak threads: "
+            << peak_thread_count << "." << std::endl;
+  if (tls_client.has_value()) {
+    tls_client->PrintStatistics();
+  }
+  if (sink.has_value()) {
+    sink->PrintStatistics();
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::vector<std::size_t> recipient_counts;
+  Options options;
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--recipients") {
+      recipient_counts.push_back(std::strtoull(argv[index + 1], nullptr, 10));
+    } else if (key == "--connections") {
+      options.connection_count =
+          std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+    } else if (key == "--event-loops") {
+      options.event_loop_count =
+          std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+    } else if (key == "--latency") {
+      options.latency = std::chrono::microseconds{std::strtoll(argv[index + 1], nullptr, 10)};
+    } else if (key == "--rejection-rate") {
+      options.rejection_rate = std::strtod(argv[index + 1], nullptr);
+    } else if (key == "--deferral-rate") {
+      options.deferral_rate = std::strtod(argv[index + 1], nullptr);
+    } else if (key == "--sink") {
+      options.sink = SecretSanta::ParseHostAndPort(argv[index + 1]);
+      if (!options.sink.has_value()) {
+        std::cout << "Invalid sink: " << argv[index + 1] << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (key == "--tls") {
+      options.tls = true;
+      options.resume = std::string{argv[index + 1]} != "full";
+    } else if (key == "--ca-file") {
+      options.ca_file = argv[index + 1];
+    } else if (key == "--messages-per-connection") {
+      options.messages_per_connection = std::strtoull(argv[index + 1], nullptr, 10);
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (options.tls && options.event_loop_count.has_value()) {
+    std::cout << "TLS connections are not supported with event loops." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (recipient_counts.empty()) {
+    recipient_counts = {1000, 10000, 100000, 1000000};
+  }
+
+  for (const std::size_t recipient_count : recipient_counts) {
+    Run(recipient_count, options);
+  }
+
+  return EXIT_SUCCESS;
+}
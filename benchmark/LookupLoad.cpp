@@ -0,0 +1,176 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "../source/LookupServer.hpp"
+
+// Benchmark of the Secret Santa Lookup server. Builds the lookup index of a given number of
+// participants, starts the server, and has a given number of clients look up random giftees over
+// keep-alive connections on the loopback interface for a given duration, optionally pipelining
+// several requests at a time. Reports the number of requests answered per second.
+//
+// Usage:
+//   secret-santa-lookup-benchmark [--participants <integer>] [--connections <integer>]
+//                                 [--threads <integer>] [--pipeline <integer>]
+//                                 [--seconds <integer>]
+
+namespace {
+
+// Creates a given number of participants with an email address and a mailing address each.
+std::set<SecretSanta::Participant> CreateParticipants(const std::size_t count) {
+  std::set<SecretSanta::Participant> participants;
+  for (std::size_t index = 0; index < count; ++index) {
+    const std::string name{"Participant " + std::to_string(index)};
+    YAML::Node node;
+    node[name]["email"] = "participant." + std::to_string(index) + "@example.com";
+    node[name]["address"] = std::to_string(index) + " Main St, Springfield, IL 62701 USA";
+    participants.emplace(node);
+  }
+  return participants;
+}
+
+// Looks up random giftees over one connection until a given deadline, sending a given number of
+// requests at a time. Returns the number of responses received, or 0 if the connection failed.
+uint64_t RunClient(const uint16_t port, const std::vector<std::string>& requests,
+                   const std::vector<std::size_t>& response_sizes, const std::size_t pipeline,
+                   const std::chrono::steady_clock::time_point deadline, const uint64_t seed) {
+  SecretSanta::Socket socket{SecretSanta::ConnectTo("127.0.0.1", port)};
+  if (!socket.IsOpen()) {
+    return 0;
+  }
+
+  std::mt19937_64 generator{seed};
+  std::uniform_int_distribution<std::size_t> pick{0, requests.size() - 1};
+  std::string batch;
+  std::array<char, 65536> buffer{};
+  uint64_t response_count = 0;
+  while (std::chrono::steady_clock::now() < deadline) {
+    batch.clear();
+    std::size_t expected = 0;
+    for (std::size_t index = 0; index < pipeline; ++index) {
+      const std::size_t participant = pick(generator);
+      batch.append(requests[participant]);
+      expected += response_sizes[participant];
+    }
+    if (!socket.WriteAll(batch)) {
+      return response_count;
+    }
+    while (expected > 0) {
+      const ssize_t count =
+          ::recv(socket.Descriptor(), buffer.data(), std::min(buffer.size(), expected), 0);
+      if (count <= 0) {
+        return response_count;
+      }
+      expected -= static_cast<std::size_t>(count);
+    }
+    response_count += pipeline;
+  }
+  return response_count;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t participant_count = 10'000;
+  std::size_t connection_count = 8;
+  std::size_t thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  std::size_t pipeline = 1;
+  std::size_t seconds = 3;
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    const std::size_t value = std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+    if (key == "--participants") {
+      participant_count = std::max<std::size_t>(value, 2);
+    } else if (key == "--connections") {
+      connection_count = value;
+    } else if (key == "--threads") {
+      thread_count = value;
+    } else if (key == "--pipeline") {
+      pipeline = value;
+    } else if (key == "--seconds") {
+      seconds = value;
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const SecretSanta::Configuration configuration{CreateParticipants(participant_count)};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(configuration.Participants()));
+  const SecretSanta::LookupIndex index{configuration, matchings, tokens};
+
+  std::vector<std::string> requests;
+  std::vector<std::size_t> response_sizes;
+  for (const std::pair<const std::string, std::string>& participant_and_token :
+       tokens.ParticipantsToTokens()) {
+    requests.push_back("GET /giftee?token=" + participant_and_token.second
+                       + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    response_sizes.push_back(index.Respond(requests.back()).text.size());
+  }
+
+  const SecretSanta::LookupServer server{index, 0, thread_count, connection_count};
+  if (!server.IsListening()) {
+    return EXIT_FAILURE;
+  }
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const std::chrono::steady_clock::time_point deadline =
+      start + std::chrono::seconds{static_cast<int64_t>(seconds)};
+  std::atomic<uint64_t> response_count{0};
+  std::vector<std::thread> clients;
+  for (std::size_t client = 0; client < connection_count; ++client) {
+    clients.emplace_back([&, client]() {
+      response_count.fetch_add(RunClient(
+          server.Port(), requests, response_sizes, pipeline, deadline, 2023 + client));
+    });
+  }
+  for (std::thread& client : clients) {
+    client.join();
+  }
+  const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << std::fixed << std::setprecision(0) << "Answered " << response_count.load()
+            << " lookups among " << participant_count << " participants over "
+            << connection_count << " connections with " << thread_count << " server threads and "
+            << pipeline << " requests in flight per connection: "
+            << static_cast<double>(response_count.load()) / elapsed << " requests per second."
+            << std::endl;
+  server.PrintStatistics();
+
+  return EXIT_SUCCESS;
+}
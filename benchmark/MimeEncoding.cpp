@@ -0,0 +1,145 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../source/MimeEncoding.hpp"
+
+// Benchmark of the MIME encoders. Encodes synthetic message bodies of a given size with the scalar
+// and the vectorized base64 and quoted-printable encoders, and reports the throughput of each in
+// megabytes of input per second.
+//
+// Usage:
+//   secret-santa-mime-benchmark [--size <integer>]... [--repetitions <integer>]
+
+namespace {
+
+// Generates a given number of bytes of text that resembles a Secret Santa message in a language
+// with some non-ASCII characters: mostly lowercase letters and spaces, with a line break every 60
+// characters or so and an accented letter every 40 characters or so.
+std::string GenerateText(const std::size_t size) {
+  std::mt19937_64 generator{2023};
+  std::uniform_int_distribution<int> distribution{0, 59};
+  std::string text;
+  text.reserve(size + 2);
+  while (text.size() < size) {
+    const int roll = distribution(generator);
+    if (roll == 0) {
+      text.push_back('\n');
+    } else if (roll < 10) {
+      text.push_back(' ');
+    } else if (roll == 10) {
+      text.append("é");
+    } else {
+      text.push_back(static_cast<char>('a' + roll % 26));
+    }
+  }
+  text.resize(size);
+  return text;
+}
+
+// Measures the throughput in megabytes per second of a given encoder on a given text, repeated a
+// given number of times. Adds the size of each encoding to a given checksum so that the encoding is
+// not optimized away.
+template <typename Encoder>
+double MeasureThroughput(
+    const std::string& text, const std::size_t repetitions, Encoder encoder,
+    std::size_t& checksum) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (std::size_t repetition = 0; repetition < repetitions; ++repetition) {
+    checksum += encoder(text).size();
+  }
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<double>(text.size() * repetitions) / 1.0e6 / seconds;
+}
+
+// Runs the benchmark on texts of a given size and prints one line of results.
+void Run(const std::size_t size, const std::size_t repetitions) {
+  const std::string text{GenerateText(size)};
+  std::size_t checksum = 0;
+
+  const double base64_scalar = MeasureThroughput(
+      text, repetitions,
+      [](const std::string& input) {
+        return SecretSanta::Base64EncodeLines(input, SecretSanta::MimeLineLength, false);
+      },
+      checksum);
+  const double base64_vectorized = MeasureThroughput(
+      text, repetitions,
+      [](const std::string& input) {
+        return SecretSanta::Base64EncodeLines(input, SecretSanta::MimeLineLength, true);
+      },
+      checksum);
+  const double quoted_printable_scalar = MeasureThroughput(
+      text, repetitions,
+      [](const std::string& input) { return SecretSanta::QuotedPrintableEncode(input, false); },
+      checksum);
+  const double quoted_printable_vectorized = MeasureThroughput(
+      text, repetitions,
+      [](const std::string& input) { return SecretSanta::QuotedPrintableEncode(input, true); },
+      checksum);
+
+  std::cout << std::fixed << std::setprecision(1) << std::setw(10) << size << " B  base64 "
+            << std::setw(8) << base64_scalar << " -> " << std::setw(8) << base64_vectorized
+            << " MB/s  quoted-printable " << std::setw(8) << quoted_printable_scalar << " -> "
+            << std::setw(8) << quoted_printable_vectorized << " MB/s  (checksum " << checksum
+            << ")" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::vector<std::size_t> sizes;
+  std::size_t repetitions = 0;
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--size") {
+      sizes.push_back(std::strtoull(argv[index + 1], nullptr, 10));
+    } else if (key == "--repetitions") {
+      repetitions = std::strtoull(argv[index + 1], nullptr, 10);
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (sizes.empty()) {
+    sizes = {256, 4096, 65536, 1048576};
+  }
+
+  std::cout << "Throughput of the scalar and vectorized encoders, in megabytes of input per second."
+            << std::endl;
+  for (const std::size_t size : sizes) {
+    // By default, each size encodes about 64 megabytes in total.
+    Run(size, repetitions > 0 ? repetitions : std::max<std::size_t>((64U << 20U) / size, 1));
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#include "../source/Configuration.hpp"
+#include "../source/ParticipantTable.hpp"
+
+// Benchmark of the storage of participants. Writes a YAML configuration file with a synthetic
+// roster of a given number of participants, then loads it both through a configuration, which is
+// how the main executables load their participants into a set of participants that own their
+// fields, and into a participant table whose fields live in one arena. Compares the time taken to
+// load them, their resident memory, the time taken to scan all of their fields and to look up
+// participants by name, and the time taken to destroy them. Each layout runs in a process of its
+// own so that its resident memory is measured on its own.
+//
+// Usage:
+//   secret-santa-participant-storage-benchmark [--participants <integer>] [--lookups <integer>]
+//                                              [--configuration <path>]
+
+namespace {
+
+// Fields of a synthetic participant. Reused from one participant to the next, so that generating
+// the fields makes no allocations of its own.
+struct SyntheticFields {
+  // Generates the fields of the participant of a given index.
+  void Generate(const std::size_t index) {
+    const std::string number{std::to_string(index)};
+    values[0].assign("Participant ").append(number);
+    values[1].assign("participant.").append(number).append("@example.com");
+    values[2].assign(number).append(" Main St, Apt 4, Springfield, IL 62701 USA");
+    values[3].assign("Leave the package with the doorman in the lobby of building ").append(number);
+    values[4].assign("Team ").append(std::to_string(index % 100));
+    values[5].assign("America/Chicago");
+    values[6].assign("39.7817, -89.6501");
+  }
+
+  // Values of the fields, in the order of the fields of a participant.
+  std::array<std::string, SecretSanta::ParticipantFieldCount> values;
+};
+
+// Index of the participant generated at a given position of a roster of a given size. The
+// participants are generated out of alphabetical order, as in a roster that was not sorted.
+std::size_t Scramble(const std::size_t position, const std::size_t count) {
+  return position * 7919 % count;
+}
+
+// Writes a YAML configuration file with a synthetic roster of a given number of participants.
+void WriteConfiguration(const std::filesystem::path& path, const std::size_t participant_count) {
+  SyntheticFields fields;
+  std::ofstream stream{path};
+  stream << "participants:\n";
+  for (std::size_t position = 0; position < participant_count; ++position) {
+    fields.Generate(Scramble(position, participant_count));
+    stream << "  - " << fields.values[0] << ":\n"
+           << "      email: " << fields.values[1] << "\n"
+           << "      address: " << fields.values[2] << "\n"
+           << "      instructions: " << fields.values[3] << "\n"
+           << "      group: " << fields.values[4] << "\n"
+           << "      timezone: " << fields.values[5] << "\n"
+           << "      location: " << fields.values[6] << "\n";
+  }
+}
+
+// Resident memory of this process in kibibytes. Returns the memory freed after loading, such as
+// that of the YAML nodes of the configuration file, to the system first, so that only the memory
+// of the participants is counted.
+std::size_t ResidentKibibytes() {
+  malloc_trim(0);
+
+  std::ifstream status{"/proc/self/status"};
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmRSS:", 0) == 0) {
+      return std::strtoull(line.c_str() + 6, nullptr, 10);
+    }
+  }
+  return 0;
+}
+
+// Number of milliseconds elapsed since a given time.
+double MillisecondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Prints one line of results.
+void PrintResults(const std::string& layout, const double load_milliseconds,
+                  const std::size_t resident_kibibytes, const double scan_milliseconds,
+                  const double lookup_milliseconds, const double teardown_milliseconds,
+                  const std::size_t checksum) {
+  std::cout << std::fixed << std::setprecision(1) << std::setw(8) << layout << "  load "
+            << std::setw(9) << load_milliseconds << " ms  memory " << std::setw(9)
+            << static_cast<double>(resident_kibibytes) / 1024.0 << " MiB  scan " << std::setw(7)
+            << scan_milliseconds << " ms  lookups " << std::setw(7) << lookup_milliseconds
+            << " ms  teardown " << std::setw(7) << teardown_milliseconds << " ms  (checksum "
+            << checksum << ")" << std::endl;
+}
+
+// Runs the benchmark on the set of participants of a configuration loaded from a given YAML
+// configuration file. The messages of the configuration are discarded.
+void RunStrings(const std::filesystem::path& path, const std::size_t participant_count,
+                const std::size_t lookup_count) {
+  SyntheticFields fields;
+  const std::size_t resident_before{ResidentKibibytes()};
+
+  std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  std::streambuf* const console{std::cout.rdbuf(nullptr)};
+  std::unique_ptr<const SecretSanta::Configuration> configuration{
+      std::make_unique<const SecretSanta::Configuration>(path)};
+  std::cout.rdbuf(console);
+  std::cout.clear();
+  const std::set<SecretSanta::Participant>* const participants{&configuration->Participants()};
+  const double load_milliseconds{MillisecondsSince(start)};
+  const std::size_t resident_kibibytes{ResidentKibibytes() - resident_before};
+
+  std::size_t checksum{0};
+  start = std::chrono::steady_clock::now();
+  for (const SecretSanta::Participant& participant : *participants) {
+    checksum += participant.Address().size() + participant.Instructions().size();
+  }
+  const double scan_milliseconds{MillisecondsSince(start)};
+
+  start = std::chrono::steady_clock::now();
+  for (std::size_t lookup = 0; lookup < lookup_count; ++lookup) {
+    fields.Generate(Scramble(lookup, participant_count));
+    checksum += participants->find(SecretSanta::Participant{fields.values[0]})->Email().size();
+  }
+  const double lookup_milliseconds{MillisecondsSince(start)};
+
+  start = std::chrono::steady_clock::now();
+  configuration.reset();
+  const double teardown_milliseconds{MillisecondsSince(start)};
+
+  PrintResults("strings", load_milliseconds, resident_kibibytes, scan_milliseconds,
+               lookup_milliseconds, teardown_milliseconds, checksum);
+}
+
+// Runs the benchmark on a participant table loaded from a given YAML configuration file.
+void RunArena(const std::filesystem::path& path, const std::size_t participant_count,
+              const std::size_t lookup_count) {
+  SyntheticFields fields;
+  const std::size_t resident_before{ResidentKibibytes()};
+
+  std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  std::unique_ptr<SecretSanta::ParticipantTable> table{
+      std::make_unique<SecretSanta::ParticipantTable>(
+          YAML::LoadFile(path.string())["participants"])};
+  const double load_milliseconds{MillisecondsSince(start)};
+  const std::size_t resident_kibibytes{ResidentKibibytes() - resident_before};
+
+  std::size_t checksum{0};
+  start = std::chrono::steady_clock::now();
+  for (std::size_t index = 0; index < table->Size(); ++index) {
+    const SecretSanta::ParticipantView participant{(*table)[index]};
+    checksum += participant.Address().size() + participant.Instructions().size();
+  }
+  const double scan_milliseconds{MillisecondsSince(start)};
+
+  start = std::chrono::steady_clock::now();
+  for (std::size_t lookup = 0; lookup < lookup_count; ++lookup) {
+    fields.Generate(Scramble(lookup, participant_count));
+    checksum += table->Find(fields.values[0])->Email().size();
+  }
+  const double lookup_milliseconds{MillisecondsSince(start)};
+
+  start = std::chrono::steady_clock::now();
+  table.reset();
+  const double teardown_milliseconds{MillisecondsSince(start)};
+
+  PrintResults("arena", load_milliseconds, resident_kibibytes, scan_milliseconds,
+               lookup_milliseconds, teardown_milliseconds, checksum);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t participant_count = 100000;
+  std::size_t lookup_count = 100000;
+  std::filesystem::path configuration{"participant_storage_benchmark.yaml"};
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--participants") {
+      participant_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--lookups") {
+      lookup_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--configuration") {
+      configuration = argv[index + 1];
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (participant_count == 0 || participant_count % 7919 == 0) {
+    std::cout << "The number of participants must be at least 1 and not a multiple of 7919."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  WriteConfiguration(configuration, participant_count);
+  std::cout << "Storage of " << participant_count << " participants with " << lookup_count
+            << " lookups by name." << std::endl;
+  for (const bool arena : {false, true}) {
+    const pid_t child{fork()};
+    if (child == 0) {
+      if (arena) {
+        RunArena(configuration, participant_count, lookup_count);
+      } else {
+        RunStrings(configuration, participant_count, lookup_count);
+      }
+      std::exit(EXIT_SUCCESS);
+    }
+    int status{0};
+    waitpid(child, &status, 0);
+  }
+  std::filesystem::remove(configuration);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../source/Matchings.hpp"
+#include "../source/Participant.hpp"
+#include "../source/StringIndex.hpp"
+#include "../source/Verification.hpp"
+
+// Benchmark of the verification of matchings. Generates a given number of participants who gift to
+// each other in one random cycle and writes their matchings to a YAML matchings file in the form
+// written by the Secret Santa Randomizer, then times mapping the participant names to identifiers
+// and the verification of the file. Then randomizes matchings for a given number of participants in
+// memory and times their verification.
+//
+// Usage:
+//   secret-santa-verification-benchmark [--pairs <integer>] [--memory-pairs <integer>]
+//                                       [--matchings <path>]
+
+namespace {
+
+// Number of milliseconds elapsed since a given time.
+double MillisecondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Name of the participant of a given index, padded with zeros to a given number of digits so that
+// the participants are in the same order by index and by name.
+std::string ParticipantName(const std::size_t index, const std::size_t digit_count) {
+  const std::string number{std::to_string(index)};
+  std::string name{"Participant "};
+  name.append(digit_count - number.size(), '0').append(number);
+  return name;
+}
+
+// Number of pairs verified per second, in millions, given a number of pairs and a duration.
+double MillionPairsPerSecond(const std::size_t pair_count, const double milliseconds) {
+  return static_cast<double>(pair_count) / milliseconds / 1000.0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t pair_count = 10000000;
+  std::size_t memory_pair_count = 1000000;
+  std::filesystem::path path{"verification_benchmark_matchings.yaml"};
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    const std::string key{argv[index]};
+    if (key == "--pairs") {
+      pair_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--memory-pairs") {
+      memory_pair_count = std::strtoull(argv[index + 1], nullptr, 10);
+    } else if (key == "--matchings") {
+      path = argv[index + 1];
+    } else {
+      std::cout << "Unrecognized argument: " << key << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (pair_count < 2 || memory_pair_count < 2) {
+    std::cout << "The numbers of pairs must be at least 2." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::fixed << std::setprecision(1);
+
+  std::size_t digit_count = std::to_string(pair_count - 1).size();
+  std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  {
+    // The participants gift to each other in one cycle in a random order, and the entries are
+    // written in the order of the gifters, as the Secret Santa Randomizer does.
+    std::vector<uint32_t> cycle(pair_count);
+    std::iota(cycle.begin(), cycle.end(), 0);
+    std::shuffle(cycle.begin(), cycle.end(), std::mt19937_64{42});
+    std::vector<uint32_t> giftees(pair_count);
+    for (std::size_t position = 0; position < pair_count; ++position) {
+      giftees[cycle[position]] = cycle[(position + 1) % pair_count];
+    }
+
+    std::ofstream stream{path};
+    stream << "gifters_to_giftees:\n";
+    for (std::size_t index = 0; index < pair_count; ++index) {
+      stream << "  - " << ParticipantName(index, digit_count) << ": "
+             << ParticipantName(giftees[index], digit_count) << "\n";
+    }
+  }
+  std::cout << "Wrote a matchings file of " << pair_count << " pairs and "
+            << static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0)
+            << " MiB in " << MillisecondsSince(start) << " ms." << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  SecretSanta::StringIndex participant_names{pair_count};
+  for (std::size_t index = 0; index < pair_count; ++index) {
+    participant_names.Insert(ParticipantName(index, digit_count));
+  }
+  const double index_milliseconds{MillisecondsSince(start)};
+
+  start = std::chrono::steady_clock::now();
+  bool valid{false};
+  {
+    const SecretSanta::Verification verification{std::move(participant_names), path};
+    valid = verification.IsValid();
+  }
+  const double file_milliseconds{MillisecondsSince(start)};
+  std::filesystem::remove(path);
+
+  std::cout << "Mapped the participant names to identifiers in " << index_milliseconds
+            << " ms, then verified the matchings file in " << file_milliseconds << " ms ("
+            << (valid ? "valid" : "invalid") << "), which is "
+            << MillionPairsPerSecond(pair_count, file_milliseconds)
+            << " million pairs per second." << std::endl;
+
+  digit_count = std::to_string(memory_pair_count - 1).size();
+  std::set<SecretSanta::Participant> participants;
+  for (std::size_t index = 0; index < memory_pair_count; ++index) {
+    participants.emplace(ParticipantName(index, digit_count));
+  }
+  const SecretSanta::Matchings matchings{participants, 42};
+
+  start = std::chrono::steady_clock::now();
+  {
+    const SecretSanta::Verification verification{participants, matchings};
+    valid = valid && verification.IsValid();
+  }
+  const double memory_milliseconds{MillisecondsSince(start)};
+  std::cout << "Verified randomized matchings of " << memory_pair_count << " pairs in memory in "
+            << memory_milliseconds << " ms, including mapping the participant names to "
+            << "identifiers, which is "
+            << MillionPairsPerSecond(memory_pair_count, memory_milliseconds)
+            << " million pairs per second." << std::endl;
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,335 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_ASSIGNMENT_SOLVER_HPP
+#define SECRET_SANTA_ASSIGNMENT_SOLVER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace SecretSanta {
+
+// Sentinel index that means "none", such as a row that is not yet assigned to any column.
+constexpr uint32_t NoIndex{std::numeric_limits<uint32_t>::max()};
+
+// Sparse square assignment problem: each row may only be assigned to some candidate columns, each
+// at a given cost. The candidates of all rows are stored one after the other, row by row.
+struct AssignmentCandidates {
+  // Index of the first candidate of each row, followed by the total number of candidates, such
+  // that the candidates of row i are at indices offsets[i] to offsets[i + 1] - 1.
+  std::vector<std::size_t> offsets{0};
+
+  // Column of each candidate.
+  std::vector<uint32_t> columns;
+
+  // Cost of each candidate.
+  std::vector<int64_t> costs;
+
+  // Number of rows, which is also the number of columns.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return offsets.size() - 1;
+  }
+
+  // Adds a candidate column at a given cost to the last row.
+  void Add(const uint32_t column, const int64_t cost) {
+    columns.push_back(column);
+    costs.push_back(cost);
+  }
+
+  // Ends the last row, such that the next candidates are added to a new row.
+  void EndRow() {
+    offsets.push_back(columns.size());
+  }
+};
+
+// Finds an assignment of each row to a distinct column using only the candidates that cost at most
+// a given cost, or returns no value if there is none. Returns the column of each row. Uses the
+// Hopcroft-Karp algorithm, which runs in O(E sqrt(V)) time for E candidates and V rows.
+[[nodiscard]] std::optional<std::vector<uint32_t>> FindPerfectAssignment(
+    const AssignmentCandidates& candidates,
+    const int64_t maximum_cost = std::numeric_limits<int64_t>::max()) {
+  const std::size_t size = candidates.Size();
+  constexpr uint32_t unreached{NoIndex};
+  std::vector<uint32_t> rows_to_columns(size, NoIndex);
+  std::vector<uint32_t> columns_to_rows(size, NoIndex);
+  std::vector<uint32_t> layers(size, unreached);
+  std::vector<std::size_t> next_candidates(size, 0);
+  std::vector<uint32_t> queue;
+  std::vector<uint32_t> stack;
+  queue.reserve(size);
+
+  std::size_t matched = 0;
+  for (;;) {
+    // Breadth-first search from the unassigned rows, layering the rows by their distance along
+    // alternating paths, until some path reaches an unassigned column.
+    queue.clear();
+    for (std::size_t row = 0; row < size; ++row) {
+      if (rows_to_columns[row] == NoIndex) {
+        layers[row] = 0;
+        queue.push_back(static_cast<uint32_t>(row));
+      } else {
+        layers[row] = unreached;
+      }
+    }
+    bool found = false;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const uint32_t row = queue[head];
+      for (std::size_t index = candidates.offsets[row]; index < candidates.offsets[row + 1];
+           ++index) {
+        if (candidates.costs[index] > maximum_cost) {
+          continue;
+        }
+        const uint32_t owner = columns_to_rows[candidates.columns[index]];
+        if (owner == NoIndex) {
+          found = true;
+        } else if (layers[owner] == unreached) {
+          layers[owner] = layers[row] + 1;
+          queue.push_back(owner);
+        }
+      }
+    }
+    if (!found) {
+      break;
+    }
+
+    // Depth-first search along the layers from each unassigned row for vertex-disjoint shortest
+    // augmenting paths. The search keeps an explicit stack, since a path may be very long.
+    for (std::size_t row = 0; row < size; ++row) {
+      next_candidates[row] = candidates.offsets[row];
+    }
+    for (std::size_t start = 0; start < size; ++start) {
+      if (rows_to_columns[start] != NoIndex) {
+        continue;
+      }
+      stack.assign(1, static_cast<uint32_t>(start));
+      while (!stack.empty()) {
+        const uint32_t row = stack.back();
+        std::size_t& index = next_candidates[row];
+        if (index == candidates.offsets[row + 1]) {
+          // Dead end: no later search can use this row in this phase.
+          layers[row] = unreached;
+          stack.pop_back();
+          if (!stack.empty()) {
+            ++next_candidates[stack.back()];
+          }
+          continue;
+        }
+        if (candidates.costs[index] > maximum_cost) {
+          ++index;
+          continue;
+        }
+        const uint32_t owner = columns_to_rows[candidates.columns[index]];
+        if (owner == NoIndex) {
+          // Augment along the path: each row of the stack takes the column of its current
+          // candidate.
+          for (const uint32_t path_row : stack) {
+            const uint32_t column = candidates.columns[next_candidates[path_row]];
+            rows_to_columns[path_row] = column;
+            columns_to_rows[column] = path_row;
+            layers[path_row] = unreached;
+          }
+          ++matched;
+          break;
+        }
+        if (layers[owner] != unreached && layers[owner] == layers[row] + 1) {
+          stack.push_back(owner);
+        } else {
+          ++index;
+        }
+      }
+    }
+  }
+
+  if (matched < size) {
+    return std::nullopt;
+  }
+  return rows_to_columns;
+}
+
+// Finds the smallest cost such that the rows can be assigned to distinct columns using only the
+// candidates that cost at most that much, or returns no value if the rows cannot be assigned at
+// all. Searches the distinct costs of the candidates by bisection.
+[[nodiscard]] std::optional<int64_t> FindBottleneckCost(const AssignmentCandidates& candidates) {
+  std::vector<int64_t> costs{candidates.costs};
+  std::sort(costs.begin(), costs.end());
+  costs.erase(std::unique(costs.begin(), costs.end()), costs.end());
+  if (costs.empty() || !FindPerfectAssignment(candidates, costs.back()).has_value()) {
+    return candidates.Size() == 0 ? std::optional<int64_t>{0} : std::nullopt;
+  }
+  std::size_t low = 0;
+  std::size_t high = costs.size() - 1;
+  while (low < high) {
+    const std::size_t middle = low + (high - low) / 2;
+    if (FindPerfectAssignment(candidates, costs[middle]).has_value()) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return costs[low];
+}
+
+// Finds an assignment of each row to a distinct column that minimizes the total cost, using only
+// the candidates that cost at most a given cost. Returns the column of each row. Such an assignment
+// must exist, which can be checked beforehand with FindPerfectAssignment.
+//
+// Uses the auction algorithm with epsilon scaling. Each unassigned row bids for its best candidate
+// column at its current price, raising the price by the margin over its second-best candidate plus
+// epsilon, and takes the column from its previous row, which must bid again. Costs are multiplied
+// by the number of rows plus one, so that the last round, with an epsilon of one, ends with an
+// optimal assignment; earlier rounds with larger epsilons quickly bring the prices close to their
+// final values. The bids of each round are computed in parallel on a given number of threads, and
+// the conflicts between bids for the same column are then settled in favor of the highest bid.
+[[nodiscard]] std::vector<uint32_t> SolveAssignment(
+    const AssignmentCandidates& candidates, const std::size_t thread_count = 1,
+    const int64_t maximum_cost = std::numeric_limits<int64_t>::max()) {
+  const std::size_t size = candidates.Size();
+  const int64_t scale = static_cast<int64_t>(size) + 1;
+
+  int64_t largest_cost = 1;
+  for (const int64_t cost : candidates.costs) {
+    if (cost <= maximum_cost) {
+      largest_cost = std::max(largest_cost, cost);
+    }
+  }
+  // Largest difference between the benefits of two candidates of a row, which is also the margin
+  // bid by a row that has a single candidate.
+  const int64_t range = largest_cost * scale;
+
+  std::vector<int64_t> prices(size, 0);
+  std::vector<uint32_t> rows_to_columns(size, NoIndex);
+  std::vector<uint32_t> columns_to_rows(size, NoIndex);
+  std::vector<uint32_t> bidders;
+  std::vector<uint32_t> bid_columns(size, NoIndex);
+  std::vector<int64_t> bid_prices(size, 0);
+  std::vector<uint32_t> winners(size, NoIndex);
+  std::vector<uint32_t> contested;
+
+  // Computes the bid of each bidder of one share of the bidders for a given epsilon.
+  const std::function<void(std::size_t, std::size_t, int64_t)> bid =
+      [&](const std::size_t share, const std::size_t share_count, const int64_t epsilon) {
+        for (std::size_t position = share; position < bidders.size(); position += share_count) {
+          const uint32_t row = bidders[position];
+          int64_t best_value = std::numeric_limits<int64_t>::min();
+          int64_t second_value = std::numeric_limits<int64_t>::min();
+          uint32_t best_column = NoIndex;
+          for (std::size_t index = candidates.offsets[row]; index < candidates.offsets[row + 1];
+               ++index) {
+            if (candidates.costs[index] > maximum_cost) {
+              continue;
+            }
+            const uint32_t column = candidates.columns[index];
+            const int64_t value = -candidates.costs[index] * scale - prices[column];
+            if (value > best_value) {
+              second_value = best_value;
+              best_value = value;
+              best_column = column;
+            } else if (value > second_value) {
+              second_value = value;
+            }
+          }
+          bid_columns[row] = best_column;
+          if (best_column != NoIndex) {
+            const int64_t margin = second_value == std::numeric_limits<int64_t>::min() ?
+                                       range :
+                                       best_value - second_value;
+            bid_prices[row] = prices[best_column] + margin + epsilon;
+          }
+        }
+      };
+
+  // Bids are only computed in parallel when there are enough of them to outweigh the cost of
+  // starting threads.
+  constexpr std::size_t parallel_bidder_count{4096};
+
+  int64_t epsilon = std::max<int64_t>(range / 4, 1);
+  for (;;) {
+    std::fill(rows_to_columns.begin(), rows_to_columns.end(), NoIndex);
+    std::fill(columns_to_rows.begin(), columns_to_rows.end(), NoIndex);
+    bidders.resize(size);
+    for (std::size_t row = 0; row < size; ++row) {
+      bidders[row] = static_cast<uint32_t>(row);
+    }
+
+    while (!bidders.empty()) {
+      const std::size_t share_count =
+          bidders.size() >= parallel_bidder_count ? std::max<std::size_t>(thread_count, 1) : 1;
+      std::vector<std::thread> threads;
+      for (std::size_t share = 1; share < share_count; ++share) {
+        threads.emplace_back(bid, share, share_count, epsilon);
+      }
+      bid(0, share_count, epsilon);
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+
+      // Settle the bids: each contested column goes to its highest bidder.
+      contested.clear();
+      for (const uint32_t row : bidders) {
+        const uint32_t column = bid_columns[row];
+        if (column == NoIndex) {
+          continue;
+        }
+        if (winners[column] == NoIndex) {
+          winners[column] = row;
+          contested.push_back(column);
+        } else if (bid_prices[row] > bid_prices[winners[column]]) {
+          winners[column] = row;
+        }
+      }
+
+      std::vector<uint32_t> next_bidders;
+      for (const uint32_t row : bidders) {
+        if (bid_columns[row] != NoIndex && winners[bid_columns[row]] != row) {
+          next_bidders.push_back(row);
+        }
+      }
+      for (const uint32_t column : contested) {
+        const uint32_t winner = winners[column];
+        const uint32_t previous = columns_to_rows[column];
+        if (previous != NoIndex) {
+          rows_to_columns[previous] = NoIndex;
+          next_bidders.push_back(previous);
+        }
+        columns_to_rows[column] = winner;
+        rows_to_columns[winner] = column;
+        prices[column] = bid_prices[winner];
+        winners[column] = NoIndex;
+      }
+      bidders.swap(next_bidders);
+    }
+
+    if (epsilon == 1) {
+      break;
+    }
+    epsilon = std::max<int64_t>(epsilon / 5, 1);
+  }
+
+  return rows_to_columns;
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_ASSIGNMENT_SOLVER_HPP
@@ -0,0 +1,277 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_ASYNC_EMAILER_HPP
+#define SECRET_SANTA_ASYNC_EMAILER_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Configuration.hpp"
+#include "EmailMessage.hpp"
+#include "Emailer.hpp"
+#include "Executor.hpp"
+#include "Matchings.hpp"
+#include "Participant.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Result of sending one email message: the email message itself and the outcome of its delivery.
+class SendResult {
+public:
+  // Default constructor. Constructs the result of sending an empty email message successfully.
+  SendResult() = default;
+
+  // Constructor. Constructs the result of sending a given email message with a given outcome.
+  SendResult(EmailMessage message, Delivery delivery)
+    : message_(std::move(message)), delivery_(std::move(delivery)) {}
+
+  // Destructor. Destroys this result.
+  ~SendResult() noexcept = default;
+
+  // Copy constructor. Constructs a result by copying another one.
+  SendResult(const SendResult& other) = default;
+
+  // Move constructor. Constructs a result by moving another one.
+  SendResult(SendResult&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this result by copying another one.
+  SendResult& operator=(const SendResult& other) = default;
+
+  // Move assignment operator. Assigns this result by moving another one.
+  SendResult& operator=(SendResult&& other) noexcept = default;
+
+  // Email message that was sent.
+  [[nodiscard]] const EmailMessage& Message() const noexcept {
+    return message_;
+  }
+
+  // Outcome of the delivery of the email message.
+  [[nodiscard]] const Delivery& Outcome() const noexcept {
+    return delivery_;
+  }
+
+  // Whether the email message was accepted for delivery.
+  [[nodiscard]] bool Succeeded() const noexcept {
+    return delivery_.Succeeded();
+  }
+
+private:
+  // Email message that was sent.
+  EmailMessage message_;
+
+  // Outcome of the delivery of the email message.
+  Delivery delivery_;
+};
+
+// Operation that sends one email message through a transport, awaited with co_await. The awaiting
+// coroutine resumes on the given executor once the delivery completes, and receives the result.
+class SendOperation {
+public:
+  // Constructor. Constructs an operation that sends a given email message through a given transport
+  // and resumes the awaiting coroutine on a given executor.
+  SendOperation(Transport& transport, Executor& executor, EmailMessage message)
+    : transport_(transport), executor_(executor), message_(std::move(message)) {}
+
+  // Destructor. Destroys this operation.
+  ~SendOperation() noexcept = default;
+
+  // Deleted copy constructor.
+  SendOperation(const SendOperation& other) = delete;
+
+  // Deleted move constructor.
+  SendOperation(SendOperation&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  SendOperation& operator=(const SendOperation& other) = delete;
+
+  // Deleted move assignment operator.
+  SendOperation& operator=(SendOperation&& other) noexcept = delete;
+
+  // Whether the awaiting coroutine can skip suspending. Never, because nothing is sent yet.
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  // Hands the email message to the transport. Returns whether the awaiting coroutine stays
+  // suspended, which it does not if the delivery already completed within the transport.
+  bool await_suspend(const std::coroutine_handle<> awaiting) {
+    awaiting_ = awaiting;
+    transport_.Send(message_, [this](const EmailMessage& message, const Delivery& delivery) {
+      result_.emplace(message, delivery);
+      if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        executor_.Post([awaiting = awaiting_]() { awaiting.resume(); });
+      }
+    });
+    return remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+  }
+
+  // Result of sending the email message.
+  SendResult await_resume() {
+    return std::move(result_.value());
+  }
+
+private:
+  // Transport through which the email message is sent.
+  Transport& transport_;
+
+  // Executor on which the awaiting coroutine resumes.
+  Executor& executor_;
+
+  // Email message to be sent.
+  EmailMessage message_;
+
+  // Awaiting coroutine.
+  std::coroutine_handle<> awaiting_;
+
+  // Result of sending the email message, once the delivery completes.
+  std::optional<SendResult> result_;
+
+  // Number of events left before the awaiting coroutine resumes: the completion of the delivery
+  // and the end of the suspension. Whichever happens last resumes the awaiting coroutine, so that
+  // it never resumes before it is fully suspended.
+  std::atomic<int> remaining_{2};
+};
+
+// Operation that sends several email messages at once through a transport, awaited with co_await.
+// All of the email messages are handed to the transport without waiting for any delivery, so a
+// transport that holds many deliveries in flight sends them concurrently. The awaiting coroutine
+// resumes on the given executor once every delivery completes, and receives the results in the
+// order of the email messages.
+class SendAllOperation {
+public:
+  // Constructor. Constructs an operation that sends given email messages through a given transport
+  // and resumes the awaiting coroutine on a given executor.
+  SendAllOperation(Transport& transport, Executor& executor, std::vector<EmailMessage> messages)
+    : transport_(transport), executor_(executor), messages_(std::move(messages)),
+      results_(messages_.size()), remaining_(messages_.size() + 1) {}
+
+  // Destructor. Destroys this operation.
+  ~SendAllOperation() noexcept = default;
+
+  // Deleted copy constructor.
+  SendAllOperation(const SendAllOperation& other) = delete;
+
+  // Deleted move constructor.
+  SendAllOperation(SendAllOperation&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  SendAllOperation& operator=(const SendAllOperation& other) = delete;
+
+  // Deleted move assignment operator.
+  SendAllOperation& operator=(SendAllOperation&& other) noexcept = delete;
+
+  // Whether the awaiting coroutine can skip suspending, which it does if there is nothing to send.
+  bool await_ready() const noexcept {
+    return messages_.empty();
+  }
+
+  // Hands every email message to the transport. Returns whether the awaiting coroutine stays
+  // suspended, which it does not if every delivery already completed within the transport.
+  bool await_suspend(const std::coroutine_handle<> awaiting) {
+    awaiting_ = awaiting;
+    for (std::size_t index = 0; index < messages_.size(); ++index) {
+      transport_.Send(std::move(messages_[index]),
+                      [this, index](const EmailMessage& message, const Delivery& delivery) {
+                        results_[index] = SendResult{message, delivery};
+                        Arrive();
+                      });
+    }
+    return remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+  }
+
+  // Results of sending the email messages, in the order of the email messages.
+  std::vector<SendResult> await_resume() {
+    return std::move(results_);
+  }
+
+private:
+  // Counts one completed delivery, and resumes the awaiting coroutine if it was the last event.
+  void Arrive() {
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      executor_.Post([awaiting = awaiting_]() { awaiting.resume(); });
+    }
+  }
+
+  // Transport through which the email messages are sent.
+  Transport& transport_;
+
+  // Executor on which the awaiting coroutine resumes.
+  Executor& executor_;
+
+  // Email messages to be sent.
+  std::vector<EmailMessage> messages_;
+
+  // Awaiting coroutine.
+  std::coroutine_handle<> awaiting_;
+
+  // Results of sending the email messages, filled in as the deliveries complete.
+  std::vector<SendResult> results_;
+
+  // Number of events left before the awaiting coroutine resumes: the completion of each delivery
+  // and the end of the suspension.
+  std::atomic<std::size_t> remaining_;
+};
+
+// Composes and sends an email message to a given gifter through a given transport. Awaited with
+// co_await from a coroutine, which resumes on the given executor with the result once the delivery
+// completes. Prints nothing to the console.
+[[nodiscard]] SendOperation SendMessage(
+    Transport& transport, Executor& executor, const Participant& gifter, const Participant& giftee,
+    const std::string& message_subject, const std::string& main_message_body) {
+  return {transport, executor,
+          ComposeEmailMessage(gifter, giftee, message_subject, main_message_body)};
+}
+
+// Composes and sends email messages to all gifters through a given transport, or only to the given
+// gifters if any are given. Awaited with co_await from a coroutine, which resumes on the given
+// executor with the result of each email message once every delivery completes. Gifters without a
+// giftee among the participants are skipped. Prints nothing to the console.
+[[nodiscard]] SendAllOperation SendMessages(
+    Transport& transport, Executor& executor, const Configuration& configuration,
+    const Matchings& matchings,
+    const std::optional<std::set<std::string>>& gifter_names = std::nullopt) {
+  const std::shared_ptr<const EmailAttachment> invite{ComposeInvite(configuration)};
+  std::vector<EmailMessage> messages;
+  for (const Participant& gifter : configuration.Participants()) {
+    if (gifter_names.has_value() && gifter_names->count(gifter.Name()) == 0) {
+      continue;
+    }
+
+    const std::vector<const Participant*> giftees = FindGiftees(configuration, matchings, gifter);
+
+    if (!giftees.empty()) {
+      messages.push_back(ComposeEmailMessage(gifter, giftees, configuration.MessageSubject(),
+                                             configuration.MessageBody(), invite));
+    }
+  }
+  return {transport, executor, std::move(messages)};
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_ASYNC_EMAILER_HPP
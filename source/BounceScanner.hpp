@@ -0,0 +1,421 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_BOUNCE_SCANNER_HPP
+#define SECRET_SANTA_BOUNCE_SCANNER_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+namespace SecretSanta {
+
+// Normalizes an email address for comparison: removes surrounding whitespace and angle brackets,
+// and converts ASCII letters to lowercase.
+[[nodiscard]] std::string NormalizeAddress(std::string_view address) {
+  const std::size_t first = address.find_first_not_of(" \t<");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  address.remove_prefix(first);
+  address.remove_suffix(address.size() - 1 - address.find_last_not_of(" \t>"));
+  std::string normalized{address};
+  for (char& character : normalized) {
+    if (character >= 'A' && character <= 'Z') {
+      character = static_cast<char>(character - 'A' + 'a');
+    }
+  }
+  return normalized;
+}
+
+// Recipient whose email message bounced, as reported by a bounce message.
+struct Bounce {
+  // Normalized email address of the recipient.
+  std::string recipient;
+
+  // Enhanced status code of the failure, such as "5.1.1", or empty if the bounce message gave none.
+  std::string status;
+
+  // Diagnostic of the failure, such as the reply of the receiving mail server, or empty if the
+  // bounce message gave none.
+  std::string diagnostic;
+};
+
+// Scans a mailbox of bounce messages for the recipients whose email messages could not be
+// delivered. Reads delivery status notifications as specified by RFC 3464, whose per-recipient
+// fields name each recipient with a Final-Recipient or Original-Recipient field and report an
+// Action field of "failed" for each recipient that was given up on, along with a Status field and
+// an optional Diagnostic-Code field. Also reads the X-Failed-Recipients header field that some mail
+// servers add instead. Recipients whose delivery was only delayed are not reported. The mailbox is
+// either an mbox file, whose messages each start with a "From " line, or a Maildir directory, whose
+// messages are each a file of its "new" or "cur" subdirectory. Each file is memory-mapped and
+// scanned in a single pass, line by line, looking only at lines that may start a field of interest,
+// so that the scan is limited by the speed at which the file is read.
+class BounceScanner {
+public:
+  // Default constructor. Constructs a scanner that has not scanned any message yet.
+  BounceScanner() = default;
+
+  // Destructor. Destroys this scanner.
+  ~BounceScanner() noexcept = default;
+
+  // Deleted copy constructor.
+  BounceScanner(const BounceScanner& other) = delete;
+
+  // Deleted move constructor.
+  BounceScanner(BounceScanner&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  BounceScanner& operator=(const BounceScanner& other) = delete;
+
+  // Deleted move assignment operator.
+  BounceScanner& operator=(BounceScanner&& other) noexcept = delete;
+
+  // Scans the mailbox at a given path, which is either an mbox file or a Maildir directory. Returns
+  // whether the mailbox could be read.
+  bool ScanPath(const std::filesystem::path& path) {
+    std::error_code error;
+    if (std::filesystem::is_directory(path, error)) {
+      return ScanMaildir(path);
+    }
+    const MappedFile file{path};
+    if (!file.IsValid()) {
+      std::cout << "Cannot read the mailbox at " << path << "; please check the file path."
+                << std::endl;
+      return false;
+    }
+    ScanMbox(file.Text());
+    byte_count_ += file.Size();
+    return true;
+  }
+
+  // Scans the text of an mbox file, whose messages each start with a line beginning with "From ".
+  void ScanMbox(const std::string_view text) {
+    Scan(text, true);
+  }
+
+  // Scans the text of one message.
+  void ScanMessage(const std::string_view text) {
+    Scan(text, false);
+  }
+
+  // Recipients whose email messages bounced, once per bounce message that reports them, in the
+  // order in which they were found.
+  [[nodiscard]] const std::vector<Bounce>& Bounces() const noexcept {
+    return bounces_;
+  }
+
+  // Number of messages scanned so far.
+  [[nodiscard]] constexpr std::size_t MessageCount() const noexcept {
+    return message_count_;
+  }
+
+  // Number of bytes of the mailbox files scanned so far.
+  [[nodiscard]] constexpr std::size_t ByteCount() const noexcept {
+    return byte_count_;
+  }
+
+private:
+  // Field whose value may continue on the following lines.
+  enum class FoldedField : int8_t {
+    // No field, or a field whose continuation lines are ignored.
+    None,
+
+    // Diagnostic-Code field of a group of per-recipient fields.
+    Diagnostic,
+  };
+
+  // Per-recipient fields of a delivery status notification, gathered until the blank line that
+  // ends them.
+  struct Block {
+    // Recipient named by the Final-Recipient field.
+    std::string final_recipient;
+
+    // Recipient named by the Original-Recipient field.
+    std::string original_recipient;
+
+    // Whether the Action field is "failed".
+    bool failed{false};
+
+    // Value of the Status field.
+    std::string status;
+
+    // Value of the Diagnostic-Code field, including its continuation lines.
+    std::string diagnostic;
+  };
+
+  // Scans the messages of the "new" and "cur" subdirectories of a Maildir directory, or the files
+  // of the directory itself if it has neither subdirectory. Returns whether the directory could be
+  // read.
+  bool ScanMaildir(const std::filesystem::path& directory) {
+    std::vector<std::filesystem::path> subdirectories;
+    for (const char* const name : {"new", "cur"}) {
+      if (std::filesystem::is_directory(directory / name)) {
+        subdirectories.push_back(directory / name);
+      }
+    }
+    if (subdirectories.empty()) {
+      subdirectories.push_back(directory);
+    }
+
+    for (const std::filesystem::path& subdirectory : subdirectories) {
+      std::error_code error;
+      for (const std::filesystem::directory_entry& entry :
+           std::filesystem::directory_iterator{subdirectory, error}) {
+        if (!entry.is_regular_file()) {
+          continue;
+        }
+        const MappedFile file{entry.path()};
+        if (!file.IsValid()) {
+          std::cout << "Skipping the unreadable message file: " << entry.path() << std::endl;
+          continue;
+        }
+        ScanMessage(file.Text());
+        byte_count_ += file.Size();
+      }
+      if (error) {
+        std::cout << "Cannot read the Maildir directory " << subdirectory << ": "
+                  << error.message() << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Scans text line by line. If the text is an mbox file, each line starting with "From " starts
+  // a new message; otherwise, the text is one message.
+  void Scan(std::string_view text, const bool mbox) {
+    if (text.empty()) {
+      return;
+    }
+    BeginMessage();
+    bool first_line = true;
+    while (!text.empty()) {
+      const char* const end =
+          static_cast<const char*>(std::memchr(text.data(), '\n', text.size()));
+      const std::size_t length = end != nullptr ? static_cast<std::size_t>(end - text.data()) :
+                                                  text.size();
+      std::string_view line{text.data(), length};
+      text.remove_prefix(std::min(length + 1, text.size()));
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+
+      if (mbox && line.starts_with("From ")) {
+        // The "From " line that starts the first message does not end a previous message.
+        if (!first_line) {
+          EndMessage();
+          BeginMessage();
+        }
+      } else {
+        ScanLine(line);
+      }
+      first_line = false;
+    }
+    EndMessage();
+  }
+
+  // Starts a new message.
+  void BeginMessage() {
+    ++message_count_;
+    block_ = Block{};
+    folded_ = FoldedField::None;
+    message_bounces_.clear();
+  }
+
+  // Ends the current message and keeps its bounces.
+  void EndMessage() {
+    EndBlock();
+    bounces_.insert(bounces_.end(), std::make_move_iterator(message_bounces_.begin()),
+                    std::make_move_iterator(message_bounces_.end()));
+    message_bounces_.clear();
+  }
+
+  // Scans one line of a message, without its line ending.
+  void ScanLine(const std::string_view line) {
+    if (line.empty()) {
+      EndBlock();
+      folded_ = FoldedField::None;
+      return;
+    }
+
+    if (line.front() == ' ' || line.front() == '\t') {
+      if (folded_ == FoldedField::Diagnostic) {
+        block_.diagnostic.append(" ").append(Trim(line));
+      }
+      return;
+    }
+
+    folded_ = FoldedField::None;
+    std::string_view value;
+    switch (line.front() | 0x20) {
+      case 'f':
+        if (FieldValue(line, "final-recipient", value)) {
+          // A new Final-Recipient field without a blank line in between starts a new group.
+          if (!block_.final_recipient.empty()) {
+            EndBlock();
+          }
+          block_.final_recipient = NormalizeAddress(AddressOfType(value));
+        }
+        break;
+      case 'o':
+        if (FieldValue(line, "original-recipient", value)) {
+          block_.original_recipient = NormalizeAddress(AddressOfType(value));
+        }
+        break;
+      case 'a':
+        if (FieldValue(line, "action", value)) {
+          block_.failed = EqualsIgnoringCase(Trim(value), "failed");
+        }
+        break;
+      case 's':
+        if (FieldValue(line, "status", value)) {
+          block_.status = Trim(value);
+        }
+        break;
+      case 'd':
+        if (FieldValue(line, "diagnostic-code", value)) {
+          block_.diagnostic = Trim(value);
+          folded_ = FoldedField::Diagnostic;
+        }
+        break;
+      case 'x':
+        if (FieldValue(line, "x-failed-recipients", value)) {
+          while (!value.empty()) {
+            const std::size_t comma = value.find(',');
+            const std::string recipient{NormalizeAddress(value.substr(0, comma))};
+            if (!recipient.empty()) {
+              AddBounce(Bounce{recipient, {}, {}});
+            }
+            value.remove_prefix(comma != std::string_view::npos ? comma + 1 : value.size());
+          }
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Ends the current group of per-recipient fields and records its recipient if it failed.
+  void EndBlock() {
+    if (block_.failed) {
+      std::string& recipient = !block_.final_recipient.empty() ? block_.final_recipient :
+                                                                 block_.original_recipient;
+      if (!recipient.empty()) {
+        AddBounce(Bounce{std::move(recipient), std::move(block_.status),
+                         std::move(block_.diagnostic)});
+      }
+    }
+    block_ = Block{};
+  }
+
+  // Records a bounce of the current message. A recipient reported twice by the same message, such
+  // as by both the X-Failed-Recipients header field and a delivery status notification, is only
+  // recorded once, with the details of whichever report has them.
+  void AddBounce(Bounce bounce) {
+    for (Bounce& existing : message_bounces_) {
+      if (existing.recipient == bounce.recipient) {
+        if (existing.status.empty()) {
+          existing.status = std::move(bounce.status);
+        }
+        if (existing.diagnostic.empty()) {
+          existing.diagnostic = std::move(bounce.diagnostic);
+        }
+        return;
+      }
+    }
+    message_bounces_.push_back(std::move(bounce));
+  }
+
+  // Whether a line is a given field, whose name is given in lowercase. If so, sets the value to
+  // the rest of the line after the colon.
+  [[nodiscard]] static bool FieldValue(
+      const std::string_view line, const std::string_view name, std::string_view& value) noexcept {
+    if (line.size() <= name.size() || line[name.size()] != ':'
+        || !EqualsIgnoringCase(line.substr(0, name.size()), name)) {
+      return false;
+    }
+    value = line.substr(name.size() + 1);
+    return true;
+  }
+
+  // Returns the address of a field value that starts with an address type, such as
+  // "rfc822; alice@example.com". Values without an address type are returned as they are.
+  [[nodiscard]] static std::string_view AddressOfType(const std::string_view value) noexcept {
+    const std::size_t semicolon = value.find(';');
+    return semicolon != std::string_view::npos ? value.substr(semicolon + 1) : value;
+  }
+
+  // Whether two strings are equal when ASCII letters are compared without regard to case. The
+  // second string must be in lowercase.
+  [[nodiscard]] static bool EqualsIgnoringCase(
+      const std::string_view text, const std::string_view lowercase) noexcept {
+    if (text.size() != lowercase.size()) {
+      return false;
+    }
+    for (std::size_t index = 0; index < text.size(); ++index) {
+      const char character = text[index];
+      if ((character >= 'A' && character <= 'Z' ? character - 'A' + 'a' : character)
+          != lowercase[index]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns a string without its leading and trailing whitespace.
+  [[nodiscard]] static std::string Trim(const std::string_view text) {
+    const std::size_t first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+      return {};
+    }
+    return std::string{text.substr(first, text.find_last_not_of(" \t") - first + 1)};
+  }
+
+  // Recipients whose email messages bounced, in the order in which they were found.
+  std::vector<Bounce> bounces_;
+
+  // Recipients whose email messages bounced according to the current message.
+  std::vector<Bounce> message_bounces_;
+
+  // Group of per-recipient fields being read.
+  Block block_;
+
+  // Field whose value may continue on the following line.
+  FoldedField folded_{FoldedField::None};
+
+  // Number of messages scanned so far.
+  std::size_t message_count_{0};
+
+  // Number of bytes of the mailbox files scanned so far.
+  std::size_t byte_count_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_BOUNCE_SCANNER_HPP
@@ -0,0 +1,221 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_BOUNCED_GIFTERS_HPP
+#define SECRET_SANTA_BOUNCED_GIFTERS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "BounceScanner.hpp"
+#include "Participant.hpp"
+#include "StringIndex.hpp"
+
+namespace SecretSanta {
+
+// Gifter whose email messages bounced.
+struct BouncedGifter {
+  // Name of the gifter.
+  std::string name;
+
+  // Email address of the gifter, as given in the configuration.
+  std::string email;
+
+  // Number of bounce messages that report the email address of the gifter.
+  std::size_t bounces{0};
+
+  // Enhanced status code of the last reported failure, or empty if no bounce message gave one.
+  std::string status;
+
+  // Diagnostic of the last reported failure, or empty if no bounce message gave one.
+  std::string diagnostic;
+};
+
+// Gifters whose email messages bounced, found by joining the recipients of bounce messages against
+// the email addresses of the participants. The normalized email addresses of the participants are
+// kept in a hash index, so that each bounce is joined in constant time. Several participants may
+// share an email address, such as the members of a household, in which case a bounce to that
+// address affects all of them. Can be written to a YAML file that lists the affected gifters, so
+// that their email addresses can be corrected and their email messages sent again.
+class BouncedGifters {
+public:
+  // Default constructor. Constructs an empty list of bounced gifters.
+  BouncedGifters() = default;
+
+  // Constructor. Constructs the list of gifters whose email messages bounced, given the
+  // participants and the bounces.
+  BouncedGifters(const std::set<Participant>& participants, const std::vector<Bounce>& bounces) {
+    StringIndex index{participants.size()};
+    std::vector<std::vector<const Participant*>> participants_by_address;
+    participants_by_address.reserve(participants.size());
+    for (const Participant& participant : participants) {
+      if (participant.Email().empty()) {
+        continue;
+      }
+      const uint32_t identifier = index.Insert(NormalizeAddress(participant.Email()));
+      if (identifier == participants_by_address.size()) {
+        participants_by_address.emplace_back();
+      }
+      participants_by_address[identifier].push_back(&participant);
+    }
+
+    // Each participant gets at most one entry, at the position of its first bounce.
+    std::vector<uint32_t> entry_by_address(participants_by_address.size(), StringIndex::NotFound);
+    std::set<std::string> unknown_recipients;
+    for (const Bounce& bounce : bounces) {
+      const uint32_t identifier = index.Find(bounce.recipient);
+      if (identifier == StringIndex::NotFound) {
+        unknown_recipients.insert(bounce.recipient);
+        continue;
+      }
+      if (entry_by_address[identifier] == StringIndex::NotFound) {
+        entry_by_address[identifier] = static_cast<uint32_t>(entries_.size());
+        for (const Participant* const participant : participants_by_address[identifier]) {
+          entries_.push_back(BouncedGifter{participant->Name(), participant->Email(), 0, {}, {}});
+        }
+      }
+      for (std::size_t position = entry_by_address[identifier];
+           position < entry_by_address[identifier] + participants_by_address[identifier].size();
+           ++position) {
+        BouncedGifter& entry = entries_[position];
+        ++entry.bounces;
+        if (!bounce.status.empty()) {
+          entry.status = bounce.status;
+        }
+        if (!bounce.diagnostic.empty()) {
+          entry.diagnostic = bounce.diagnostic;
+        }
+      }
+    }
+
+    std::sort(entries_.begin(), entries_.end(),
+              [](const BouncedGifter& first, const BouncedGifter& second) {
+                return first.name < second.name;
+              });
+    unknown_recipients_.assign(unknown_recipients.cbegin(), unknown_recipients.cend());
+  }
+
+  // Destructor. Destroys this list of bounced gifters.
+  ~BouncedGifters() noexcept = default;
+
+  // Copy constructor. Constructs a list of bounced gifters by copying another one.
+  BouncedGifters(const BouncedGifters& other) = default;
+
+  // Move constructor. Constructs a list of bounced gifters by moving another one.
+  BouncedGifters(BouncedGifters&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this list of bounced gifters by copying another one.
+  BouncedGifters& operator=(const BouncedGifters& other) = default;
+
+  // Move assignment operator. Assigns this list of bounced gifters by moving another one.
+  BouncedGifters& operator=(BouncedGifters&& other) noexcept = default;
+
+  // Gifters whose email messages bounced, sorted by name.
+  [[nodiscard]] const std::vector<BouncedGifter>& Entries() const noexcept {
+    return entries_;
+  }
+
+  // Bounced email addresses that belong to no participant, sorted and without duplicates.
+  [[nodiscard]] const std::vector<std::string>& UnknownRecipients() const noexcept {
+    return unknown_recipients_;
+  }
+
+  // Prints these bounced gifters to the console.
+  void Print() const {
+    std::cout << "A total of " << entries_.size() << " gifters have email messages that bounced";
+    if (entries_.empty()) {
+      std::cout << "." << std::endl;
+    } else {
+      std::cout << ":" << std::endl;
+    }
+    for (const BouncedGifter& entry : entries_) {
+      std::cout << "- " << entry.name << " <" << entry.email << ">: " << entry.bounces
+                << " bounces" << (entry.status.empty() ? "" : ", status " + entry.status)
+                << (entry.diagnostic.empty() ? "" : ", " + entry.diagnostic) << std::endl;
+    }
+    if (!unknown_recipients_.empty()) {
+      std::cout << "A total of " << unknown_recipients_.size()
+                << " bounced email addresses belong to no participant, such as: "
+                << unknown_recipients_.front() << std::endl;
+    }
+  }
+
+  // Writes these bounced gifters to a given YAML file.
+  void Write(const std::filesystem::path& path) const {
+    if (path.empty()) {
+      return;
+    }
+
+    if (!path.parent_path().empty()) {
+      std::filesystem::create_directories(path.parent_path());
+    }
+
+    std::ofstream stream{path.string()};
+    if (!stream.is_open()) {
+      std::cout << "Could not open the YAML bounces file for writing at: " << path.string()
+                << std::endl;
+      return;
+    }
+
+    YAML::Emitter emitter;
+    emitter << YAML::BeginMap;
+    emitter << YAML::Key << "gifters" << YAML::Value << YAML::BeginSeq;
+    for (const BouncedGifter& entry : entries_) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "name" << YAML::Value << entry.name;
+      emitter << YAML::Key << "email" << YAML::Value << entry.email;
+      emitter << YAML::Key << "bounces" << YAML::Value << entry.bounces;
+      if (!entry.status.empty()) {
+        emitter << YAML::Key << "status" << YAML::Value << entry.status;
+      }
+      if (!entry.diagnostic.empty()) {
+        emitter << YAML::Key << "diagnostic" << YAML::Value << entry.diagnostic;
+      }
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq;
+    emitter << YAML::Key << "unknown_recipients" << YAML::Value << unknown_recipients_;
+    emitter << YAML::EndMap;
+
+    stream << emitter.c_str() << std::endl;
+    stream.close();
+
+    std::cout << "Wrote " << entries_.size() << " bounced gifters to the YAML bounces file: "
+              << path << std::endl;
+  }
+
+private:
+  // Gifters whose email messages bounced, sorted by name.
+  std::vector<BouncedGifter> entries_;
+
+  // Bounced email addresses that belong to no participant, sorted and without duplicates.
+  std::vector<std::string> unknown_recipients_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_BOUNCED_GIFTERS_HPP
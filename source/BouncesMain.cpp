@@ -0,0 +1,62 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+
+#include "BounceScanner.hpp"
+#include "BouncedGifters.hpp"
+#include "BouncesSettings.hpp"
+#include "Configuration.hpp"
+
+int main(int argc, char* argv[]) {
+  const SecretSanta::Bounces::Settings settings{argc, argv};
+
+  const SecretSanta::Configuration configuration{settings.ConfigurationFile()};
+
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+
+  SecretSanta::BounceScanner scanner;
+  for (const std::filesystem::path& mailbox : settings.Mailboxes()) {
+    if (!scanner.ScanPath(mailbox)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  const int64_t milliseconds{std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count()};
+  std::cout << "Scanned " << scanner.MessageCount() << " messages ("
+            << scanner.ByteCount() / (1024 * 1024) << " MiB) in " << milliseconds
+            << " ms and found " << scanner.Bounces().size() << " failed recipients." << std::endl;
+
+  const SecretSanta::BouncedGifters bounced_gifters{
+      configuration.Participants(), scanner.Bounces()};
+
+  bounced_gifters.Print();
+
+  bounced_gifters.Write(settings.OutputFile());
+
+  std::cout << "End of " << SecretSanta::Bounces::Program::Title << "." << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,341 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_BOUNDED_QUEUE_HPP
+#define SECRET_SANTA_BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace SecretSanta {
+
+// Bounded lock-free multi-producer multi-consumer queue that connects the stages of a pipeline.
+// Uses a ring of cells, each of which carries a sequence number that tells producers and consumers
+// whether the cell is free or full, so that pushing and popping only take one atomic
+// compare-and-swap on the fast path. A full queue makes producers wait, which applies backpressure
+// to the upstream stage. A waiting thread spins briefly and then parks on an atomic wait, which is
+// a futex on Linux, so that an idle stage takes no processor time. The queue also records how full
+// it is and how long producers and consumers waited, which tells which stage of the pipeline is
+// the bottleneck.
+template <typename Value>
+class BoundedQueue {
+public:
+  // Constructor. Constructs an empty queue that holds at least a given number of values. The
+  // capacity is rounded up to a power of two, and is at least two, since a ring of one cell cannot
+  // tell a full cell from a free one by its sequence number.
+  explicit BoundedQueue(const std::size_t minimum_capacity) {
+    while (capacity_ < minimum_capacity) {
+      capacity_ *= 2;
+    }
+    cells_ = std::make_unique<Cell[]>(capacity_);
+    for (std::size_t index = 0; index < capacity_; ++index) {
+      cells_[index].sequence.store(index, std::memory_order_relaxed);
+    }
+  }
+
+  // Destructor. Destroys this queue.
+  ~BoundedQueue() noexcept = default;
+
+  // Deleted copy constructor.
+  BoundedQueue(const BoundedQueue& other) = delete;
+
+  // Deleted move constructor.
+  BoundedQueue(BoundedQueue&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  BoundedQueue& operator=(const BoundedQueue& other) = delete;
+
+  // Deleted move assignment operator.
+  BoundedQueue& operator=(BoundedQueue&& other) noexcept = delete;
+
+  // Maximum number of values this queue holds.
+  [[nodiscard]] std::size_t Capacity() const noexcept {
+    return capacity_;
+  }
+
+  // Approximate number of values currently in this queue.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    const std::size_t enqueue = enqueue_position_.load(std::memory_order_relaxed);
+    const std::size_t dequeue = dequeue_position_.load(std::memory_order_relaxed);
+    return enqueue > dequeue ? std::min(enqueue - dequeue, capacity_) : 0;
+  }
+
+  // Attempts to push a value without waiting. Returns whether the value was pushed, in which case
+  // it was moved from. Fails if the queue is full.
+  bool TryPush(Value& value) {
+    std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[position & (capacity_ - 1)];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const std::intptr_t difference =
+          static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+      if (difference == 0) {
+        if (enqueue_position_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(position + 1, std::memory_order_release);
+          RecordOccupancy();
+          Wake(empty_waiter_count_, push_epoch_);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Attempts to pop a value without waiting. Returns the value, or no value if the queue is empty.
+  std::optional<Value> TryPop() {
+    std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[position & (capacity_ - 1)];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const std::intptr_t difference =
+          static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+      if (difference == 0) {
+        if (dequeue_position_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          std::optional<Value> value{std::move(cell.value)};
+          cell.sequence.store(position + capacity_, std::memory_order_release);
+          Wake(full_waiter_count_, pop_epoch_);
+          return value;
+        }
+      } else if (difference < 0) {
+        return std::nullopt;
+      } else {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Pushes a value, waiting while the queue is full.
+  void Push(Value value) {
+    if (TryPush(value)) {
+      return;
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::size_t attempt = 0;; ++attempt) {
+      if (attempt < SpinAttemptCount) {
+        if (TryPush(value)) {
+          break;
+        }
+        Spin(attempt);
+        continue;
+      }
+
+      // Register as a waiter before the last attempt, so that a consumer who frees a cell after
+      // this attempt either sees the registration and wakes this thread or changes the epoch first.
+      full_waiter_count_.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const uint32_t epoch = pop_epoch_.load(std::memory_order_relaxed);
+      const bool pushed = TryPush(value);
+      if (!pushed) {
+        pop_epoch_.wait(epoch, std::memory_order_relaxed);
+      }
+      full_waiter_count_.fetch_sub(1, std::memory_order_relaxed);
+      if (pushed) {
+        break;
+      }
+    }
+    full_wait_nanoseconds_.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+  }
+
+  // Pops a value, waiting while the queue is empty. Returns no value once the queue is closed and
+  // empty.
+  std::optional<Value> Pop() {
+    std::optional<Value> value = TryPop();
+    if (value.has_value()) {
+      return value;
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::size_t attempt = 0;; ++attempt) {
+      if (attempt < SpinAttemptCount) {
+        // Check whether the queue is closed before trying to pop, so that a value pushed just
+        // before the queue was closed is never missed.
+        const bool closed = closed_.load(std::memory_order_acquire);
+        value = TryPop();
+        if (value.has_value() || closed) {
+          break;
+        }
+        Spin(attempt);
+        continue;
+      }
+
+      // Register as a waiter before the last attempt, as in Push.
+      empty_waiter_count_.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const uint32_t epoch = push_epoch_.load(std::memory_order_relaxed);
+      const bool closed = closed_.load(std::memory_order_acquire);
+      value = TryPop();
+      if (!value.has_value() && !closed) {
+        push_epoch_.wait(epoch, std::memory_order_relaxed);
+      }
+      empty_waiter_count_.fetch_sub(1, std::memory_order_relaxed);
+      if (value.has_value() || closed) {
+        break;
+      }
+    }
+    empty_wait_nanoseconds_.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+    return value;
+  }
+
+  // Closes this queue: no more values will be pushed. Consumers drain the remaining values and then
+  // stop waiting.
+  void Close() noexcept {
+    closed_.store(true, std::memory_order_seq_cst);
+    push_epoch_.fetch_add(1, std::memory_order_seq_cst);
+    push_epoch_.notify_all();
+  }
+
+  // Whether this queue is closed.
+  [[nodiscard]] bool IsClosed() const noexcept {
+    return closed_.load(std::memory_order_acquire);
+  }
+
+  // Average number of values in this queue right after each push.
+  [[nodiscard]] double AverageOccupancy() const noexcept {
+    const uint64_t pushes = push_count_.load(std::memory_order_relaxed);
+    return pushes == 0 ? 0.0 :
+                         static_cast<double>(occupancy_sum_.load(std::memory_order_relaxed))
+                             / static_cast<double>(pushes);
+  }
+
+  // Largest number of values observed in this queue right after a push.
+  [[nodiscard]] std::size_t MaximumOccupancy() const noexcept {
+    return maximum_occupancy_.load(std::memory_order_relaxed);
+  }
+
+  // Total time in seconds that producers waited because this queue was full.
+  [[nodiscard]] double FullWaitSeconds() const noexcept {
+    return static_cast<double>(full_wait_nanoseconds_.load(std::memory_order_relaxed)) * 1.0e-9;
+  }
+
+  // Total time in seconds that consumers waited because this queue was empty.
+  [[nodiscard]] double EmptyWaitSeconds() const noexcept {
+    return static_cast<double>(empty_wait_nanoseconds_.load(std::memory_order_relaxed)) * 1.0e-9;
+  }
+
+private:
+  // Cell of the ring. Its sequence number equals its position when it is free for the producer at
+  // that position, and equals its position plus one when it is full for the consumer at that
+  // position.
+  struct Cell {
+    std::atomic<std::size_t> sequence{0};
+    Value value{};
+  };
+
+  // Number of attempts that a waiting thread makes before it parks: it spins during the first half
+  // and yields during the second half.
+  static constexpr std::size_t SpinAttemptCount{128};
+
+  // Waits a little before another attempt while spinning: does nothing at first, then yields.
+  static void Spin(const std::size_t attempt) {
+    if (attempt >= SpinAttemptCount / 2) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Wakes the threads parked on a given epoch, if a given count of them is nonzero, after a value
+  // was pushed or popped. The fence orders the change of the cell before the check of the count,
+  // so that a thread that registers as a waiter afterwards sees the change of the cell instead.
+  static void Wake(std::atomic<uint32_t>& waiter_count, std::atomic<uint32_t>& epoch) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiter_count.load(std::memory_order_relaxed) > 0) {
+      epoch.fetch_add(1, std::memory_order_relaxed);
+      epoch.notify_all();
+    }
+  }
+
+  // Nanoseconds elapsed since a given time point.
+  [[nodiscard]] static uint64_t ElapsedNanoseconds(
+      const std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+  }
+
+  // Records the number of values in this queue right after a push.
+  void RecordOccupancy() noexcept {
+    const std::size_t occupancy = Size();
+    push_count_.fetch_add(1, std::memory_order_relaxed);
+    occupancy_sum_.fetch_add(occupancy, std::memory_order_relaxed);
+    std::size_t maximum = maximum_occupancy_.load(std::memory_order_relaxed);
+    while (occupancy > maximum
+           && !maximum_occupancy_.compare_exchange_weak(
+               maximum, occupancy, std::memory_order_relaxed)) {}
+  }
+
+  // Number of cells in the ring. Always a power of two, and at least two.
+  std::size_t capacity_{2};
+
+  // Ring of cells.
+  std::unique_ptr<Cell[]> cells_;
+
+  // Position at which the next value is pushed. Kept on its own cache line to avoid false sharing
+  // between producers and consumers.
+  alignas(64) std::atomic<std::size_t> enqueue_position_{0};
+
+  // Position from which the next value is popped.
+  alignas(64) std::atomic<std::size_t> dequeue_position_{0};
+
+  // Whether this queue is closed.
+  alignas(64) std::atomic<bool> closed_{false};
+
+  // Epoch on which consumers park while this queue is empty. Changes when a value is pushed while
+  // consumers are parked, and when this queue is closed.
+  alignas(64) std::atomic<uint32_t> push_epoch_{0};
+
+  // Number of consumers parked or about to park while this queue is empty.
+  std::atomic<uint32_t> empty_waiter_count_{0};
+
+  // Epoch on which producers park while this queue is full. Changes when a value is popped while
+  // producers are parked.
+  alignas(64) std::atomic<uint32_t> pop_epoch_{0};
+
+  // Number of producers parked or about to park while this queue is full.
+  std::atomic<uint32_t> full_waiter_count_{0};
+
+  // Number of values pushed.
+  std::atomic<uint64_t> push_count_{0};
+
+  // Sum of the number of values in this queue right after each push.
+  std::atomic<uint64_t> occupancy_sum_{0};
+
+  // Largest number of values observed in this queue right after a push.
+  std::atomic<std::size_t> maximum_occupancy_{0};
+
+  // Total nanoseconds that producers waited because this queue was full.
+  std::atomic<uint64_t> full_wait_nanoseconds_{0};
+
+  // Total nanoseconds that consumers waited because this queue was empty.
+  std::atomic<uint64_t> empty_wait_nanoseconds_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_BOUNDED_QUEUE_HPP
@@ -0,0 +1,283 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_CALENDAR_EVENT_HPP
+#define SECRET_SANTA_CALENDAR_EVENT_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace SecretSanta {
+
+// Date and time of day of a calendar event, optionally with an offset from UTC. A time without an
+// offset is a floating time, which calendar applications show as is in any time zone.
+struct CalendarTime {
+  // Year, such as 2023.
+  int year{0};
+
+  // Month, from 1 to 12.
+  int month{0};
+
+  // Day of the month, from 1 to 31.
+  int day{0};
+
+  // Hour, from 0 to 23.
+  int hour{0};
+
+  // Minute, from 0 to 59.
+  int minute{0};
+
+  // Second, from 0 to 59.
+  int second{0};
+
+  // Offset from UTC in minutes, such as -480 for "-08:00", or no value for a floating time.
+  std::optional<int> utc_offset_minutes;
+};
+
+// Parses a date and time of day such as "2023-12-23 14:00", "2023-12-23T14:00:30", or
+// "2023-12-23 14:00-08:00". The time may end with "Z" for UTC or with an offset from UTC. Returns
+// no value if the text is not a valid date and time of day.
+[[nodiscard]] std::optional<CalendarTime> ParseCalendarTime(const std::string_view text) {
+  const std::string copy{text};
+  CalendarTime time;
+  int length = 0;
+  char separator = '\0';
+  if (std::sscanf(copy.c_str(), "%4d-%2d-%2d%c%2d:%2d%n", &time.year, &time.month, &time.day,
+                  &separator, &time.hour, &time.minute, &length)
+          != 6
+      || (separator != ' ' && separator != 'T')) {
+    return std::nullopt;
+  }
+  std::string_view rest{text.substr(static_cast<std::size_t>(length))};
+  if (rest.size() >= 3 && rest[0] == ':' && rest[1] >= '0' && rest[1] <= '9' && rest[2] >= '0'
+      && rest[2] <= '9') {
+    time.second = (rest[1] - '0') * 10 + (rest[2] - '0');
+    rest.remove_prefix(3);
+  }
+  if (rest == "Z") {
+    time.utc_offset_minutes = 0;
+  } else if (!rest.empty()) {
+    int hours = 0;
+    int minutes = 0;
+    const std::string offset{rest};
+    if ((rest.front() != '+' && rest.front() != '-')
+        || (std::sscanf(offset.c_str() + 1, "%2d:%2d%n", &hours, &minutes, &length) != 2
+            && std::sscanf(offset.c_str() + 1, "%2d%2d%n", &hours, &minutes, &length) != 2)
+        || static_cast<std::size_t>(length) + 1 != offset.size() || hours > 14 || minutes > 59) {
+      return std::nullopt;
+    }
+    time.utc_offset_minutes = (rest.front() == '-' ? -1 : 1) * (hours * 60 + minutes);
+  }
+
+  static constexpr int days_in_month[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if (time.month < 1 || time.month > 12 || time.day < 1
+      || time.day > days_in_month[time.month - 1] || time.hour > 23 || time.minute > 59
+      || time.second > 59 || time.year < 1970) {
+    return std::nullopt;
+  }
+  if (time.month == 2 && time.day == 29
+      && !(time.year % 4 == 0 && (time.year % 100 != 0 || time.year % 400 == 0))) {
+    return std::nullopt;
+  }
+  return time;
+}
+
+// Number of seconds since the epoch of a given time, read as if it were in UTC, ignoring its
+// offset.
+[[nodiscard]] std::time_t CalendarTimeSeconds(const CalendarTime& time) {
+  std::tm fields{};
+  fields.tm_year = time.year - 1900;
+  fields.tm_mon = time.month - 1;
+  fields.tm_mday = time.day;
+  fields.tm_hour = time.hour;
+  fields.tm_min = time.minute;
+  fields.tm_sec = time.second;
+  return ::timegm(&fields);
+}
+
+// Calendar time a given number of seconds since the epoch, in UTC, with a given offset.
+[[nodiscard]] CalendarTime MakeCalendarTime(
+    const std::time_t seconds, const std::optional<int> utc_offset_minutes) {
+  std::tm fields{};
+  ::gmtime_r(&seconds, &fields);
+  return CalendarTime{fields.tm_year + 1900, fields.tm_mon + 1, fields.tm_mday,
+                      fields.tm_hour,        fields.tm_min,     fields.tm_sec,
+                      utc_offset_minutes};
+}
+
+// Returns a given time moved by a given number of seconds, keeping its offset.
+[[nodiscard]] CalendarTime AddSeconds(const CalendarTime& time, const std::time_t seconds) {
+  return MakeCalendarTime(CalendarTimeSeconds(time) + seconds, time.utc_offset_minutes);
+}
+
+// Formats a given time as an iCalendar date-time: in UTC with a "Z" suffix if it has an offset, or
+// as a floating time otherwise, such as "20231223T220000Z" or "20231223T140000".
+[[nodiscard]] std::string FormatICalendarTime(const CalendarTime& time) {
+  const CalendarTime utc{
+      time.utc_offset_minutes.has_value() ?
+          AddSeconds(time, -static_cast<std::time_t>(time.utc_offset_minutes.value()) * 60) :
+          time};
+  char text[32];
+  std::snprintf(text, sizeof(text), "%04d%02d%02dT%02d%02d%02d%s", utc.year, utc.month, utc.day,
+                utc.hour, utc.minute, utc.second, time.utc_offset_minutes.has_value() ? "Z" : "");
+  return text;
+}
+
+// Date, time, and location of the Secret Santa event, read from the configuration file.
+class CalendarEvent {
+public:
+  // Default duration of an event whose end is not given, in seconds.
+  static constexpr std::time_t DefaultDuration{2 * 60 * 60};
+
+  // Constructor. Constructs an event from its start, end, and location.
+  CalendarEvent(CalendarTime start, CalendarTime end, std::string location)
+    : start_(std::move(start)), end_(std::move(end)), location_(std::move(location)) {}
+
+  // Destructor. Destroys this event.
+  ~CalendarEvent() noexcept = default;
+
+  // Copy constructor. Constructs an event by copying another one.
+  CalendarEvent(const CalendarEvent& other) = default;
+
+  // Move constructor. Constructs an event by moving another one.
+  CalendarEvent(CalendarEvent&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this event by copying another one.
+  CalendarEvent& operator=(const CalendarEvent& other) = default;
+
+  // Move assignment operator. Assigns this event by moving another one.
+  CalendarEvent& operator=(CalendarEvent&& other) noexcept = default;
+
+  // Date and time at which this event starts.
+  [[nodiscard]] const CalendarTime& Start() const noexcept {
+    return start_;
+  }
+
+  // Date and time at which this event ends.
+  [[nodiscard]] const CalendarTime& End() const noexcept {
+    return end_;
+  }
+
+  // Location of this event, such as an address or a meeting link, or an empty string if none.
+  [[nodiscard]] const std::string& Location() const noexcept {
+    return location_;
+  }
+
+private:
+  // Date and time at which this event starts.
+  CalendarTime start_;
+
+  // Date and time at which this event ends.
+  CalendarTime end_;
+
+  // Location of this event, such as an address or a meeting link, or an empty string if none.
+  std::string location_;
+};
+
+// Escapes a given text as an iCalendar text value: backslashes, semicolons, and commas get a
+// backslash, and line breaks become "\n".
+[[nodiscard]] std::string EscapeICalendarText(const std::string_view text) {
+  std::string escaped;
+  escaped.reserve(text.size() + 8);
+  for (std::size_t index = 0; index < text.size(); ++index) {
+    const char character = text[index];
+    if (character == '\\' || character == ';' || character == ',') {
+      escaped.push_back('\\');
+      escaped.push_back(character);
+    } else if (character == '\n') {
+      escaped.append("\\n");
+    } else if (character != '\r') {
+      escaped.push_back(character);
+    }
+  }
+  return escaped;
+}
+
+// Appends a given iCalendar content line to given contents, folded into lines of at most 75 octets
+// that do not split a UTF-8 character, each terminated by a carriage return and line feed.
+void AppendICalendarLine(std::string& contents, const std::string_view line) {
+  constexpr std::size_t maximum_length{75};
+  std::size_t index = 0;
+  // Continuation lines start with a space, which counts towards their length.
+  std::size_t available = maximum_length;
+  while (line.size() - index > available) {
+    std::size_t end = index + available;
+    while (end > index + 1 && (static_cast<unsigned char>(line[end]) & 0xC0U) == 0x80U) {
+      --end;
+    }
+    contents.append(line.substr(index, end - index));
+    contents.append("\r\n ");
+    index = end;
+    available = maximum_length - 1;
+  }
+  contents.append(line.substr(index));
+  contents.append("\r\n");
+}
+
+// Composes an iCalendar file that publishes a given event with a given summary to the calendars of
+// its recipients, stamped with a given time. The identifier of the event is derived from its
+// details, so that sending the invitation again updates the same calendar entry rather than adding
+// another one.
+[[nodiscard]] std::string ComposeICalendarInvite(
+    const CalendarEvent& event, const std::string& summary, const std::time_t stamp) {
+  const std::string start{FormatICalendarTime(event.Start())};
+  const std::string end{FormatICalendarTime(event.End())};
+
+  // 64-bit FNV-1a hash of the details of the event.
+  uint64_t hash = 14695981039346656037ULL;
+  for (const std::string& part : {start, end, event.Location(), summary}) {
+    for (const char character : part) {
+      hash = (hash ^ static_cast<unsigned char>(character)) * 1099511628211ULL;
+    }
+    hash = (hash ^ 0xFFU) * 1099511628211ULL;
+  }
+  char identifier[32];
+  std::snprintf(identifier, sizeof(identifier), "%016llx",
+                static_cast<unsigned long long>(hash));
+
+  std::string contents;
+  AppendICalendarLine(contents, "BEGIN:VCALENDAR");
+  AppendICalendarLine(contents, "VERSION:2.0");
+  AppendICalendarLine(contents, "PRODID:-//acodcha//Secret Santa//EN");
+  AppendICalendarLine(contents, "CALSCALE:GREGORIAN");
+  AppendICalendarLine(contents, "METHOD:PUBLISH");
+  AppendICalendarLine(contents, "BEGIN:VEVENT");
+  AppendICalendarLine(contents, "UID:" + std::string{identifier} + "@secret-santa");
+  AppendICalendarLine(
+      contents, "DTSTAMP:" + FormatICalendarTime(MakeCalendarTime(stamp, 0)));
+  AppendICalendarLine(contents, "DTSTART:" + start);
+  AppendICalendarLine(contents, "DTEND:" + end);
+  AppendICalendarLine(contents, "SUMMARY:" + EscapeICalendarText(summary));
+  if (!event.Location().empty()) {
+    AppendICalendarLine(contents, "LOCATION:" + EscapeICalendarText(event.Location()));
+  }
+  AppendICalendarLine(contents, "END:VEVENT");
+  AppendICalendarLine(contents, "END:VCALENDAR");
+  return contents;
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_CALENDAR_EVENT_HPP
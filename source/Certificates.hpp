@@ -0,0 +1,157 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_CERTIFICATES_HPP
+#define SECRET_SANTA_CERTIFICATES_HPP
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+#include <string>
+
+namespace SecretSanta {
+
+// Names of the PEM files written by CreateCertificates.
+namespace CertificateFile {
+
+// Certificate of the certificate authority, which clients trust.
+static const std::string Authority{"ca.pem"};
+
+// Certificate of the server, signed by the certificate authority.
+static const std::string Certificate{"certificate.pem"};
+
+// Private key of the server.
+static const std::string PrivateKey{"key.pem"};
+
+}  // namespace CertificateFile
+
+// Adds an X.509 version 3 extension, given in the OpenSSL configuration syntax, to a certificate
+// issued by a given issuer. Returns whether the extension was added.
+bool AddCertificateExtension(
+    X509* const certificate, X509* const issuer, const int identifier, const std::string& value) {
+  X509V3_CTX context;
+  X509V3_set_ctx_nodb(&context);
+  X509V3_set_ctx(&context, issuer, certificate, nullptr, nullptr, 0);
+  const std::unique_ptr<X509_EXTENSION, decltype(&X509_EXTENSION_free)> extension{
+      X509V3_EXT_conf_nid(nullptr, &context, identifier, value.c_str()), &X509_EXTENSION_free};
+  return extension != nullptr && X509_add_ext(certificate, extension.get(), -1) == 1;
+}
+
+// Creates a certificate with a given serial number and common name for a given public key, valid
+// from an hour ago for a year. The certificate is not yet signed and has no issuer.
+[[nodiscard]] std::unique_ptr<X509, decltype(&X509_free)> CreateCertificate(
+    const long serial_number, const std::string& common_name, EVP_PKEY* const key) {
+  std::unique_ptr<X509, decltype(&X509_free)> certificate{X509_new(), &X509_free};
+  X509_set_version(certificate.get(), 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(certificate.get()), serial_number);
+  X509_gmtime_adj(X509_getm_notBefore(certificate.get()), -3600);
+  X509_gmtime_adj(X509_getm_notAfter(certificate.get()), 365L * 24 * 3600);
+  X509_set_pubkey(certificate.get(), key);
+  X509_NAME_add_entry_by_txt(X509_get_subject_name(certificate.get()), "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>(common_name.c_str()), -1, -1,
+                               0);
+  return certificate;
+}
+
+// Writes a certificate or private key to a PEM file using a given OpenSSL writer function. Returns
+// whether the file was written.
+template <typename Object, typename Writer>
+bool WritePem(const std::filesystem::path& path, Object* const object, const Writer& writer) {
+  std::FILE* const file = std::fopen(path.string().c_str(), "w");
+  if (file == nullptr) {
+    return false;
+  }
+  const bool written = writer(file, object) == 1;
+  return std::fclose(file) == 0 && written;
+}
+
+// Creates a certificate authority and a certificate signed by it for a server on the loopback
+// interface, valid for the host name "localhost" and the address 127.0.0.1, and writes them along
+// with the private key of the server to PEM files in a given directory. These certificates let the
+// local stand-in for a mail server accept TLS connections from clients that verify certificates,
+// without touching the system's certificate authorities. Returns whether the files were written.
+bool CreateCertificates(const std::filesystem::path& directory) {
+  const std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> authority_key{
+      EVP_EC_gen("P-256"), &EVP_PKEY_free};
+  const std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> server_key{
+      EVP_EC_gen("P-256"), &EVP_PKEY_free};
+  if (authority_key == nullptr || server_key == nullptr) {
+    std::cout << "Cannot generate the keys of the TLS certificates." << std::endl;
+    return false;
+  }
+
+  const std::unique_ptr<X509, decltype(&X509_free)> authority{
+      CreateCertificate(1, "Secret Santa Certificate Authority", authority_key.get())};
+  X509_set_issuer_name(authority.get(), X509_get_subject_name(authority.get()));
+
+  const std::unique_ptr<X509, decltype(&X509_free)> server{
+      CreateCertificate(2, "localhost", server_key.get())};
+  X509_set_issuer_name(server.get(), X509_get_subject_name(authority.get()));
+
+  const bool signed_certificates =
+      AddCertificateExtension(
+          authority.get(), authority.get(), NID_basic_constraints, "critical,CA:TRUE")
+      && AddCertificateExtension(
+          authority.get(), authority.get(), NID_key_usage, "critical,keyCertSign,cRLSign")
+      && AddCertificateExtension(
+          authority.get(), authority.get(), NID_subject_key_identifier, "hash")
+      && X509_sign(authority.get(), authority_key.get(), EVP_sha256()) > 0
+      && AddCertificateExtension(
+          server.get(), authority.get(), NID_basic_constraints, "critical,CA:FALSE")
+      && AddCertificateExtension(
+          server.get(), authority.get(), NID_ext_key_usage, "serverAuth")
+      && AddCertificateExtension(
+          server.get(), authority.get(), NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1")
+      && AddCertificateExtension(
+          server.get(), authority.get(), NID_authority_key_identifier, "keyid")
+      && X509_sign(server.get(), authority_key.get(), EVP_sha256()) > 0;
+  if (!signed_certificates) {
+    std::cout << "Cannot sign the TLS certificates." << std::endl;
+    return false;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  const bool written =
+      WritePem(directory / CertificateFile::Authority, authority.get(), &PEM_write_X509)
+      && WritePem(directory / CertificateFile::Certificate, server.get(), &PEM_write_X509)
+      && WritePem(directory / CertificateFile::PrivateKey, server_key.get(),
+                  [](std::FILE* const file, EVP_PKEY* const key) {
+                    return PEM_write_PrivateKey(file, key, nullptr, nullptr, 0, nullptr, nullptr);
+                  });
+  if (!written) {
+    std::cout << "Cannot write the TLS certificates to " << directory
+              << "; please check that the directory is writable." << std::endl;
+    return false;
+  }
+  std::filesystem::permissions(
+      directory / CertificateFile::PrivateKey,
+      std::filesystem::perms::owner_read | std::filesystem::perms::owner_write, error);
+  return true;
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_CERTIFICATES_HPP
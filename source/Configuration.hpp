@@ -22,13 +22,47 @@
 #define SECRET_SANTA_CONFIGURATION_HPP
 
 #include <filesystem>
+#include <optional>
 #include <set>
+#include <string>
+#include <utility>
 #include <yaml-cpp/yaml.h>
 
+#include "CalendarEvent.hpp"
 #include "Participant.hpp"
 
 namespace SecretSanta {
 
+// Parses the event from its node of a YAML configuration file. Its start is required; its end
+// defaults to two hours after its start, and its location is optional. If the event is invalid,
+// returns no event and sets the problem to a message describing why.
+[[nodiscard]] std::optional<CalendarEvent> ParseEvent(
+    const YAML::Node& event, std::string& problem) {
+  const std::optional<CalendarTime> start{
+      event["start"] ? ParseCalendarTime(event["start"].as<std::string>()) : std::nullopt};
+  if (!start.has_value()) {
+    problem = "The event in the YAML configuration file has no valid start, such as \"2023-12-23 "
+              "14:00\"; no calendar invitation will be attached.";
+    return std::nullopt;
+  }
+
+  std::optional<CalendarTime> end{
+      event["end"] ? ParseCalendarTime(event["end"].as<std::string>()) :
+                     AddSeconds(start.value(), CalendarEvent::DefaultDuration)};
+  if (!end.has_value()
+      || end->utc_offset_minutes.has_value() != start->utc_offset_minutes.has_value()
+      || CalendarTimeSeconds(end.value()) - 60 * end->utc_offset_minutes.value_or(0)
+             < CalendarTimeSeconds(start.value()) - 60 * start->utc_offset_minutes.value_or(0)) {
+    problem = "The event in the YAML configuration file has an invalid end, which must not be "
+              "before its start and must have a UTC offset if and only if its start has one; no "
+              "calendar invitation will be attached.";
+    return std::nullopt;
+  }
+
+  return CalendarEvent{start.value(), end.value(),
+                       event["location"] ? event["location"].as<std::string>() : std::string{}};
+}
+
 // Configuration details read from a YAML configuration file.
 class Configuration {
 public:
@@ -75,6 +109,11 @@ public:
                 << std::endl;
     }
 
+    YAML::Node event = root["event"];
+    if (event) {
+      ReadEvent(event);
+    }
+
     YAML::Node participants = root["participants"];
     if (participants) {
       for (const YAML::iterator::value_type& participant_node : participants) {
@@ -94,6 +133,11 @@ public:
     }
   }
 
+  // Constructor. Constructs configuration details with a default message from a given set of
+  // participants.
+  explicit Configuration(std::set<Participant> participants)
+    : participants_(std::move(participants)) {}
+
   // Destructor. Destroys this configuration object.
   ~Configuration() noexcept = default;
 
@@ -128,7 +172,28 @@ public:
     return participants_;
   }
 
+  // Date, time, and location of the Secret Santa event, if defined in the YAML configuration file,
+  // in which case a calendar invitation to it is attached to each email message.
+  [[nodiscard]] const std::optional<CalendarEvent>& Event() const noexcept {
+    return event_;
+  }
+
 private:
+  // Reads the event from its node of the YAML configuration file. Prints a message and leaves the
+  // event undefined if it is invalid.
+  void ReadEvent(const YAML::Node& event) {
+    std::string problem;
+    event_ = ParseEvent(event, problem);
+    if (!event_.has_value()) {
+      std::cout << problem << std::endl;
+      return;
+    }
+
+    std::cout << "The event was read from the YAML configuration file. A calendar invitation to "
+                 "it will be attached to each email message."
+              << std::endl;
+  }
+
   // Subject of the email message that will be sent to each participant. A default value is used if
   // no message subject is defined in the YAML configuration file.
   std::string message_subject_{"Secret Santa Gift Exchange"};
@@ -144,6 +209,9 @@ private:
 
   // Set of participants.
   std::set<Participant> participants_;
+
+  // Date, time, and location of the Secret Santa event, if defined in the YAML configuration file.
+  std::optional<CalendarEvent> event_;
 };
 
 }  // namespace SecretSanta
@@ -0,0 +1,234 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_CYCLE_LENGTHS_HPP
+#define SECRET_SANTA_CYCLE_LENGTHS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace SecretSanta {
+
+// Bounds on the number of participants in each gift exchange cycle. A cycle is a closed chain of
+// gifters and giftees, such as Alice->Bob->Claire->Alice. Splitting the participants into several
+// shorter cycles allows the in-person reveal chain to be split into rooms or subgroups.
+class CycleLengths {
+public:
+  // Default constructor. Constructs cycle length bounds of at least two participants per cycle and
+  // no maximum.
+  CycleLengths() = default;
+
+  // Constructor. Constructs cycle length bounds from a given minimum and maximum number of
+  // participants per cycle. The minimum is raised to two if needed, since a cycle of one
+  // participant would be a gifter who is their own giftee.
+  CycleLengths(const std::size_t minimum, const std::size_t maximum)
+    : minimum_(std::max(minimum, MinimumAllowed)), maximum_(maximum) {}
+
+  // Destructor. Destroys this cycle lengths object.
+  ~CycleLengths() noexcept = default;
+
+  // Copy constructor. Constructs cycle length bounds by copying another one.
+  CycleLengths(const CycleLengths& other) = default;
+
+  // Move constructor. Constructs cycle length bounds by moving another one.
+  CycleLengths(CycleLengths&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns these cycle length bounds by copying another one.
+  CycleLengths& operator=(const CycleLengths& other) = default;
+
+  // Move assignment operator. Assigns these cycle length bounds by moving another one.
+  CycleLengths& operator=(CycleLengths&& other) noexcept = default;
+
+  // Minimum number of participants in each cycle. Always at least two.
+  [[nodiscard]] std::size_t Minimum() const noexcept {
+    return minimum_;
+  }
+
+  // Maximum number of participants in each cycle.
+  [[nodiscard]] std::size_t Maximum() const noexcept {
+    return maximum_;
+  }
+
+  // Randomly partitions a given number of participants into cycle lengths that respect these
+  // bounds and that sum to the number of participants. Returns no value if no such partition
+  // exists. First draws the number of cycles uniformly among all feasible numbers of cycles, then
+  // hands out the participants in excess of the minimum lengths one cycle at a time without ever
+  // exceeding what the remaining cycles can absorb, and finally shuffles the lengths. This takes
+  // time linear in the number of cycles and never retries, regardless of how tight the bounds are.
+  [[nodiscard]] std::optional<std::vector<std::size_t>> Partition(
+      const std::size_t participant_count, std::mt19937_64& random_generator) const {
+    if (participant_count == 0) {
+      return std::vector<std::size_t>{};
+    }
+
+    if (maximum_ < minimum_) {
+      return std::nullopt;
+    }
+
+    // The fewest cycles is the number of cycles of maximum length needed to hold everyone, and the
+    // most cycles is the number of cycles of minimum length that can be formed.
+    const std::size_t fewest_cycles = 1 + (participant_count - 1) / maximum_;
+    const std::size_t most_cycles = participant_count / minimum_;
+    if (fewest_cycles > most_cycles) {
+      return std::nullopt;
+    }
+
+    const std::size_t cycle_count =
+        std::uniform_int_distribution<std::size_t>(fewest_cycles, most_cycles)(random_generator);
+
+    std::vector<std::size_t> lengths(cycle_count, minimum_);
+    std::size_t excess = participant_count - cycle_count * minimum_;
+    const std::size_t capacity = maximum_ - minimum_;
+
+    for (std::size_t index = 0; index < cycle_count && excess > 0; ++index) {
+      const std::pair<std::size_t, std::size_t> bounds =
+          ExtraBounds(excess, cycle_count - index - 1, capacity);
+
+      const std::size_t extra = std::uniform_int_distribution<std::size_t>(
+          bounds.first, bounds.second)(random_generator);
+      lengths[index] += extra;
+      excess -= extra;
+    }
+
+    std::shuffle(lengths.begin(), lengths.end(), random_generator);
+    return lengths;
+  }
+
+  // Probability that Partition splits a given number of participants into each number of cycles,
+  // indexed by the number of cycles. Returns no value if no partition exists. The number of cycles
+  // is uniform among all feasible numbers of cycles.
+  [[nodiscard]] std::optional<std::vector<double>> CycleCountProbabilities(
+      const std::size_t participant_count) const {
+    if (participant_count == 0) {
+      return std::vector<double>{1.0};
+    }
+
+    if (maximum_ < minimum_) {
+      return std::nullopt;
+    }
+
+    const std::size_t fewest_cycles = 1 + (participant_count - 1) / maximum_;
+    const std::size_t most_cycles = participant_count / minimum_;
+    if (fewest_cycles > most_cycles) {
+      return std::nullopt;
+    }
+
+    std::vector<double> probabilities(most_cycles + 1, 0.0);
+    for (std::size_t cycle_count = fewest_cycles; cycle_count <= most_cycles; ++cycle_count) {
+      probabilities[cycle_count] = 1.0 / static_cast<double>(most_cycles - fewest_cycles + 1);
+    }
+    return probabilities;
+  }
+
+  // Probability that a given participant belongs to a cycle of each length after Partition splits
+  // a given number of participants into cycles and the participants are shuffled into them, indexed
+  // by the cycle length. Returns no value if no partition exists. Follows the distribution of
+  // Partition exactly by tracking the probability of each excess left to hand out before each
+  // cycle. This takes time cubic in the number of participants at worst, which is meant for audits
+  // of the fairness of the draw rather than for the draw itself.
+  [[nodiscard]] std::optional<std::vector<double>> MembershipProbabilities(
+      const std::size_t participant_count) const {
+    const std::optional<std::vector<double>> cycle_counts =
+        CycleCountProbabilities(participant_count);
+    if (!cycle_counts.has_value()) {
+      return std::nullopt;
+    }
+
+    const std::size_t capacity = maximum_ - minimum_;
+    std::vector<double> probabilities(participant_count + 1, 0.0);
+    for (std::size_t cycle_count = 1; cycle_count < cycle_counts->size(); ++cycle_count) {
+      const double cycle_count_probability = cycle_counts.value()[cycle_count];
+      if (cycle_count_probability == 0.0) {
+        continue;
+      }
+
+      // Probability of each excess left to hand out before the current cycle.
+      std::vector<double> excesses(participant_count - cycle_count * minimum_ + 1, 0.0);
+      excesses.back() = 1.0;
+
+      for (std::size_t index = 0; index < cycle_count; ++index) {
+        std::vector<double> next_excesses(excesses.size(), 0.0);
+        for (std::size_t excess = 0; excess < excesses.size(); ++excess) {
+          if (excesses[excess] == 0.0) {
+            continue;
+          }
+          const std::pair<std::size_t, std::size_t> bounds =
+              ExtraBounds(excess, cycle_count - index - 1, capacity);
+          const double probability =
+              excesses[excess] / static_cast<double>(bounds.second - bounds.first + 1);
+          for (std::size_t extra = bounds.first; extra <= bounds.second; ++extra) {
+            // A cycle of a given length holds that many of the participants.
+            const std::size_t length = minimum_ + extra;
+            probabilities[length] += cycle_count_probability * probability
+                                     * static_cast<double>(length)
+                                     / static_cast<double>(participant_count);
+            next_excesses[excess - extra] += probability;
+          }
+        }
+        excesses.swap(next_excesses);
+      }
+    }
+    return probabilities;
+  }
+
+  inline bool operator==(const CycleLengths& other) const noexcept {
+    return minimum_ == other.minimum_ && maximum_ == other.maximum_;
+  }
+
+  inline bool operator!=(const CycleLengths& other) const noexcept {
+    return minimum_ != other.minimum_ || maximum_ != other.maximum_;
+  }
+
+private:
+  // Bounds on the number of participants in excess of the minimum length that the next cycle takes,
+  // given the excess left to hand out, the number of cycles after the next one, and the capacity of
+  // each cycle beyond the minimum length. The remaining cycles can absorb at most their capacity
+  // each, so the next cycle must take at least whatever they cannot absorb.
+  [[nodiscard]] static std::pair<std::size_t, std::size_t> ExtraBounds(
+      const std::size_t excess, const std::size_t remaining_cycles, const std::size_t capacity) {
+    std::size_t lower = 0;
+    if (remaining_cycles == 0) {
+      lower = excess;
+    } else if (capacity < excess / remaining_cycles) {
+      lower = excess - capacity * remaining_cycles;
+    } else if (capacity == excess / remaining_cycles) {
+      lower = excess % remaining_cycles;
+    }
+    return {lower, std::min(capacity, excess)};
+  }
+
+  // Smallest allowed minimum number of participants in each cycle.
+  static constexpr std::size_t MinimumAllowed{2};
+
+  // Minimum number of participants in each cycle. Always at least two.
+  std::size_t minimum_{MinimumAllowed};
+
+  // Maximum number of participants in each cycle.
+  std::size_t maximum_{std::numeric_limits<std::size_t>::max()};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_CYCLE_LENGTHS_HPP
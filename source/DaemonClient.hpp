@@ -0,0 +1,132 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DAEMON_CLIENT_HPP
+#define SECRET_SANTA_DAEMON_CLIENT_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+
+#include "DaemonProtocol.hpp"
+#include "Socket.hpp"
+
+namespace SecretSanta {
+
+// Client of the Secret Santa Daemon over its Unix domain socket. Sends requests and waits for their
+// responses over one connection. Requests can also be pipelined by sending several before receiving
+// their responses, which come back in the same order. Not safe to use from several threads at once.
+class DaemonClient {
+public:
+  // Constructor. Connects to the Secret Santa Daemon listening on a Unix domain socket at a given
+  // path.
+  explicit DaemonClient(const std::filesystem::path& path) : socket_(ConnectToUnixSocket(path)) {}
+
+  // Destructor. Closes the connection.
+  ~DaemonClient() noexcept = default;
+
+  // Deleted copy constructor.
+  DaemonClient(const DaemonClient& other) = delete;
+
+  // Deleted move constructor.
+  DaemonClient(DaemonClient&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  DaemonClient& operator=(const DaemonClient& other) = delete;
+
+  // Deleted move assignment operator.
+  DaemonClient& operator=(DaemonClient&& other) noexcept = delete;
+
+  // Whether this client is connected to the Secret Santa Daemon.
+  [[nodiscard]] bool IsConnected() const noexcept {
+    return socket_.IsOpen();
+  }
+
+  // Sends a request with a given operation and given fields and waits for its response. Returns
+  // nothing if the connection fails. The text of the response is valid until the next response is
+  // received.
+  std::optional<DaemonResponse> Call(
+      const DaemonOperation operation, const std::initializer_list<std::string_view> fields) {
+    if (!Send(operation, fields)) {
+      return std::nullopt;
+    }
+    return Receive();
+  }
+
+  // Sends a request with a given operation and given fields without waiting for its response.
+  // Returns whether the request was sent.
+  bool Send(const DaemonOperation operation, const std::initializer_list<std::string_view> fields) {
+    request_.clear();
+    AppendDaemonRequest(request_, operation, fields);
+    return socket_.WriteAll(request_);
+  }
+
+  // Waits for the response to the oldest request that was sent and not yet answered. Returns
+  // nothing if the connection fails. The text of the response is valid until the next response is
+  // received.
+  std::optional<DaemonResponse> Receive() {
+    if (!ReadExactly(DaemonFrameHeaderLength)) {
+      return std::nullopt;
+    }
+    const std::size_t payload_length = ReadBigEndian(response_);
+    if (payload_length > DaemonMaximumPayloadLength || !ReadExactly(payload_length)) {
+      return std::nullopt;
+    }
+    return ParseDaemonResponse(response_);
+  }
+
+private:
+  // Reads exactly a given number of bytes into the response buffer, replacing its contents.
+  // Returns whether all of them were read before the connection closed or failed.
+  bool ReadExactly(const std::size_t length) {
+    response_.resize(length);
+    std::size_t position = 0;
+    while (position < length) {
+      const ssize_t count =
+          ::recv(socket_.Descriptor(), response_.data() + position, length - position, 0);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return false;
+      }
+      position += static_cast<std::size_t>(count);
+    }
+    return true;
+  }
+
+  // Connection to the Secret Santa Daemon.
+  Socket socket_;
+
+  // Buffer in which each request frame is encoded before it is sent.
+  std::string request_;
+
+  // Buffer into which each part of a response frame is read.
+  std::string response_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_DAEMON_CLIENT_HPP
@@ -0,0 +1,75 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <csignal>
+#include <iostream>
+
+#include "DaemonServer.hpp"
+#include "DaemonService.hpp"
+#include "DaemonSettings.hpp"
+
+int main(int argc, char* argv[]) {
+  const SecretSanta::Daemon::Settings settings{argc, argv};
+
+  // Block the interrupt and termination signals before any thread starts, such that they are only
+  // received below.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  SecretSanta::DaemonService service{settings.CacheCapacity()};
+
+  // Reading a file or drawing matchings prints the same messages as the Secret Santa Randomizer
+  // does, which would flood the console and make the worker threads wait on it. The console is
+  // muted before the worker threads start and until they stop; errors are reported to the clients
+  // in the responses instead, and this program prints through its own stream meanwhile.
+  std::streambuf* const console = std::cout.rdbuf(nullptr);
+  std::ostream log{console};
+
+  SecretSanta::DaemonServer server{
+      service, settings.SocketFile(), settings.Threads(), settings.MaximumConnections()};
+
+  if (!server.IsListening()) {
+    std::cout.rdbuf(console);
+    std::cout << "Cannot listen on the Unix domain socket at " << settings.SocketFile()
+              << "; please check that its directory exists and that the path is not already in "
+                 "use."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  log << "Listening on the Unix domain socket at " << server.Path() << ". Press Ctrl+C to stop."
+      << std::endl;
+
+  int signal = 0;
+  sigwait(&signals, &signal);
+
+  // Stop the worker threads before restoring the console, such that none of them prints meanwhile.
+  server.Stop();
+  std::cout.rdbuf(console);
+
+  server.PrintStatistics();
+
+  std::cout << "End of " << SecretSanta::Daemon::Program::Title << "." << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DAEMON_PROTOCOL_HPP
+#define SECRET_SANTA_DAEMON_PROTOCOL_HPP
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SecretSanta {
+
+// Framed binary protocol spoken over the Unix domain socket of the Secret Santa Daemon. Every
+// message is a frame: a 4-byte big-endian payload length followed by the payload. A request payload
+// is a 1-byte operation followed by its fields, each of which is a 4-byte big-endian length
+// followed by that many bytes. A response payload is a 1-byte status followed by its text, which
+// takes up the rest of the payload. A client may send several requests without waiting for their
+// responses, which come back in the same order.
+
+// Operation of a request to the Secret Santa Daemon.
+enum class DaemonOperation : uint8_t {
+  // Randomizes matchings for the participants of a YAML configuration file. Fields: the path to
+  // the configuration file, the path to the matchings file to be written or an empty field to write
+  // none, and optionally a random seed as a decimal integer. Responds with the matchings in the
+  // format of a YAML matchings file.
+  Randomize = 1,
+
+  // Verifies the matchings of a YAML matchings file against the participants of a YAML
+  // configuration file. Fields: the path to the configuration file and the path to the matchings
+  // file. Responds with the outcome of the verification.
+  Verify = 2,
+
+  // Renders the body of the email message of one gifter. Fields: the path to the configuration
+  // file, the path to the matchings file, and the name of the gifter. Responds with the body.
+  Render = 3,
+};
+
+// Status of a response of the Secret Santa Daemon.
+enum class DaemonStatus : uint8_t {
+  // The request succeeded.
+  Ok = 0,
+
+  // The matchings that were verified are invalid. The text describes the problems.
+  Invalid = 1,
+
+  // The gifter whose message was to be rendered is not in the configuration or has no giftee.
+  NotFound = 2,
+
+  // The request failed, for instance because it is malformed or a file cannot be read. The text
+  // describes the error.
+  Error = 3,
+};
+
+// Length in bytes of the header of a frame, which holds the length of its payload.
+static constexpr std::size_t DaemonFrameHeaderLength{4};
+
+// Maximum length in bytes of the payload of a frame.
+static constexpr std::size_t DaemonMaximumPayloadLength{16 * 1024 * 1024};
+
+// Maximum number of fields of a request.
+static constexpr std::size_t DaemonMaximumFieldCount{4};
+
+// Request to the Secret Santa Daemon, whose fields view the payload from which it was parsed.
+struct DaemonRequest {
+  // Operation requested.
+  DaemonOperation operation{DaemonOperation::Randomize};
+
+  // Fields of the request, of which only the first field_count are set.
+  std::array<std::string_view, DaemonMaximumFieldCount> fields{};
+
+  // Number of fields of the request.
+  std::size_t field_count{0};
+};
+
+// Response of the Secret Santa Daemon, whose text views the payload from which it was parsed.
+struct DaemonResponse {
+  // Status of the response.
+  DaemonStatus status{DaemonStatus::Ok};
+
+  // Text of the response.
+  std::string_view text;
+};
+
+// Appends a 32-bit big-endian integer to a given buffer.
+void AppendBigEndian(std::string& buffer, const uint32_t value) {
+  buffer.push_back(static_cast<char>((value >> 24) & 0xFF));
+  buffer.push_back(static_cast<char>((value >> 16) & 0xFF));
+  buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+  buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+// Reads a 32-bit big-endian integer from the first 4 bytes of a given text.
+[[nodiscard]] uint32_t ReadBigEndian(const std::string_view text) noexcept {
+  return (static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 24)
+         | (static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 16)
+         | (static_cast<uint32_t>(static_cast<unsigned char>(text[2])) << 8)
+         | static_cast<uint32_t>(static_cast<unsigned char>(text[3]));
+}
+
+// Length of the payload of the frame at the start of a given text, or nothing if the text does not
+// yet hold the whole header of the frame.
+[[nodiscard]] std::optional<std::size_t> DaemonPayloadLength(const std::string_view text) noexcept {
+  if (text.size() < DaemonFrameHeaderLength) {
+    return std::nullopt;
+  }
+  return ReadBigEndian(text);
+}
+
+// Appends a request frame with a given operation and given fields to a given buffer.
+void AppendDaemonRequest(std::string& buffer, const DaemonOperation operation,
+                         const std::initializer_list<std::string_view> fields) {
+  std::size_t payload_length = 1;
+  for (const std::string_view field : fields) {
+    payload_length += DaemonFrameHeaderLength + field.size();
+  }
+  AppendBigEndian(buffer, static_cast<uint32_t>(payload_length));
+  buffer.push_back(static_cast<char>(operation));
+  for (const std::string_view field : fields) {
+    AppendBigEndian(buffer, static_cast<uint32_t>(field.size()));
+    buffer.append(field);
+  }
+}
+
+// Parses the payload of a request frame. Returns nothing if the payload is malformed: if it is
+// empty, has an unknown operation, has too many fields, or ends in the middle of a field.
+[[nodiscard]] std::optional<DaemonRequest> ParseDaemonRequest(std::string_view payload) noexcept {
+  if (payload.empty()) {
+    return std::nullopt;
+  }
+  DaemonRequest request;
+  const uint8_t operation = static_cast<uint8_t>(payload.front());
+  if (operation < static_cast<uint8_t>(DaemonOperation::Randomize)
+      || operation > static_cast<uint8_t>(DaemonOperation::Render)) {
+    return std::nullopt;
+  }
+  request.operation = static_cast<DaemonOperation>(operation);
+  payload.remove_prefix(1);
+
+  while (!payload.empty()) {
+    if (request.field_count == request.fields.size()
+        || payload.size() < DaemonFrameHeaderLength) {
+      return std::nullopt;
+    }
+    const std::size_t length = ReadBigEndian(payload);
+    payload.remove_prefix(DaemonFrameHeaderLength);
+    if (length > payload.size()) {
+      return std::nullopt;
+    }
+    request.fields[request.field_count++] = payload.substr(0, length);
+    payload.remove_prefix(length);
+  }
+  return request;
+}
+
+// Appends a response frame with a given status and given text to a given buffer.
+void AppendDaemonResponse(
+    std::string& buffer, const DaemonStatus status, const std::string_view text) {
+  AppendBigEndian(buffer, static_cast<uint32_t>(1 + text.size()));
+  buffer.push_back(static_cast<char>(status));
+  buffer.append(text);
+}
+
+// Parses the payload of a response frame. Returns nothing if the payload is empty.
+[[nodiscard]] std::optional<DaemonResponse> ParseDaemonResponse(
+    const std::string_view payload) noexcept {
+  if (payload.empty()) {
+    return std::nullopt;
+  }
+  return DaemonResponse{static_cast<DaemonStatus>(payload.front()), payload.substr(1)};
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_DAEMON_PROTOCOL_HPP
@@ -0,0 +1,462 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DAEMON_SERVER_HPP
+#define SECRET_SANTA_DAEMON_SERVER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "DaemonProtocol.hpp"
+#include "DaemonService.hpp"
+#include "Socket.hpp"
+
+namespace SecretSanta {
+
+// Server of the Secret Santa Daemon. Listens on a Unix domain socket that only its owner can
+// connect to, and answers the framed requests of the Secret Santa Daemon protocol with a service.
+// Serves all connections on a pool of worker threads, each of which runs an event loop that waits
+// on its connections with epoll, shares the listening socket with the others, and answers the
+// requests of its connections as they arrive. The buffers of each connection are kept when it
+// closes and reused by the next connection, so that a warm server answers small requests without
+// growing them.
+class DaemonServer {
+public:
+  // Number of bytes that each connection reads from its socket at a time.
+  static constexpr std::size_t ReadSize{16384};
+
+  // Constructor. Starts listening on a Unix domain socket at a given path and serves the
+  // connections on a given number of worker threads. Connections past the given maximum number of
+  // concurrent connections are closed at once. The given service must outlive this server.
+  DaemonServer(DaemonService& service, const std::filesystem::path& path,
+               const std::size_t thread_count = 1,
+               const std::size_t maximum_connection_count = 1024)
+    : service_(service), listener_(ListenOnUnixSocket(path)) {
+    if (!listener_.IsOpen()) {
+      std::cout << "Cannot listen on the Unix domain socket at " << path
+                << "; please check that its directory exists and that the path is not already in "
+                   "use."
+                << std::endl;
+      return;
+    }
+    ::fcntl(listener_.Descriptor(), F_SETFL,
+            ::fcntl(listener_.Descriptor(), F_GETFL, 0) | O_NONBLOCK);
+    path_ = path;
+
+    const std::size_t loop_count = std::max<std::size_t>(thread_count, 1);
+    const std::size_t connections_per_loop =
+        std::max<std::size_t>((maximum_connection_count + loop_count - 1) / loop_count, 1);
+    for (std::size_t index = 0; index < loop_count; ++index) {
+      loops_.push_back(std::make_unique<Loop>(connections_per_loop));
+
+      // Every event loop waits on the listening socket, but only one of them is woken up for each
+      // new connection.
+      epoll_event event{};
+      event.events = EPOLLIN | EPOLLEXCLUSIVE;
+      event.data.ptr = &listener_;
+      ::epoll_ctl(loops_.back()->epoll.Descriptor(), EPOLL_CTL_ADD, listener_.Descriptor(), &event);
+    }
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      loop->thread = std::thread{[this, &event_loop = *loop]() { Run(event_loop); }};
+    }
+  }
+
+  // Destructor. Stops the event loops, closes all connections, and removes the socket file.
+  ~DaemonServer() noexcept {
+    Stop();
+    if (!path_.empty()) {
+      std::error_code error;
+      std::filesystem::remove(path_, error);
+    }
+  }
+
+  // Deleted copy constructor.
+  DaemonServer(const DaemonServer& other) = delete;
+
+  // Deleted move constructor.
+  DaemonServer(DaemonServer&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  DaemonServer& operator=(const DaemonServer& other) = delete;
+
+  // Deleted move assignment operator.
+  DaemonServer& operator=(DaemonServer&& other) noexcept = delete;
+
+  // Stops the event loops and waits for their worker threads to finish, after which no request is
+  // answered anymore. The statistics of this server remain available. Does nothing if this server
+  // is already stopped.
+  void Stop() noexcept {
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      const uint64_t one = 1;
+      static_cast<void>(::write(loop->wake.Descriptor(), &one, sizeof(one)));
+    }
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      if (loop->thread.joinable()) {
+        loop->thread.join();
+      }
+    }
+  }
+
+  // Whether this server is listening for connections.
+  [[nodiscard]] bool IsListening() const noexcept {
+    return !path_.empty();
+  }
+
+  // Path of the Unix domain socket on which this server listens, or an empty path if it is not
+  // listening.
+  [[nodiscard]] const std::filesystem::path& Path() const noexcept {
+    return path_;
+  }
+
+  // Number of requests answered so far.
+  [[nodiscard]] uint64_t RequestCount() const noexcept {
+    return Sum(&Loop::request_count);
+  }
+
+  // Number of requests answered so far with an error.
+  [[nodiscard]] uint64_t ErrorCount() const noexcept {
+    return Sum(&Loop::error_count);
+  }
+
+  // Number of connections accepted so far.
+  [[nodiscard]] uint64_t ConnectionCount() const noexcept {
+    return Sum(&Loop::connection_count);
+  }
+
+  // Number of connections refused so far because too many connections were open at once.
+  [[nodiscard]] uint64_t RefusedConnectionCount() const noexcept {
+    return Sum(&Loop::refused_connection_count);
+  }
+
+  // Prints a summary of the activity of this server to the console.
+  void PrintStatistics() const {
+    std::cout << "Answered " << RequestCount() << " requests, of which " << ErrorCount()
+              << " failed, over " << ConnectionCount() << " connections ("
+              << RefusedConnectionCount() << " refused). Read " << service_.FileReadCount()
+              << " files and reused " << service_.CacheHitCount() << " files already read."
+              << std::endl;
+  }
+
+private:
+  // Connection to one client, along with its buffers.
+  struct Connection {
+    // Non-blocking socket of this connection, or a closed socket if this connection is free.
+    Socket socket;
+
+    // Data received but not yet parsed into requests. Only the first input_size bytes are set.
+    std::vector<char> input;
+
+    // Number of bytes in the input buffer.
+    std::size_t input_size{0};
+
+    // Response frames waiting to be written, in order.
+    std::string output;
+
+    // Number of bytes of the responses waiting to be written that were already written.
+    std::size_t output_offset{0};
+
+    // Whether the connection is closed once the responses waiting to be written are written.
+    bool closing{false};
+
+    // Whether the event loop waits for this connection to become writable rather than readable.
+    bool writing{false};
+  };
+
+  // Event loop of one worker thread along with its pool of connections.
+  struct Loop {
+    // Constructor. Constructs an event loop with a pool of a given number of connections.
+    explicit Loop(const std::size_t connection_count)
+      : epoll(::epoll_create1(EPOLL_CLOEXEC)), wake(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+      epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.ptr = nullptr;
+      ::epoll_ctl(epoll.Descriptor(), EPOLL_CTL_ADD, wake.Descriptor(), &event);
+
+      connections.reserve(connection_count);
+      free_connections.reserve(connection_count);
+      for (std::size_t index = 0; index < connection_count; ++index) {
+        connections.push_back(std::make_unique<Connection>());
+        free_connections.push_back(connections.back().get());
+      }
+    }
+
+    // File descriptor of the epoll instance on which this event loop waits.
+    Socket epoll;
+
+    // File descriptor of the event that wakes up this event loop when the server stops.
+    Socket wake;
+
+    // Pool of connections of this event loop.
+    std::vector<std::unique_ptr<Connection>> connections;
+
+    // Connections of the pool that are not in use.
+    std::vector<Connection*> free_connections;
+
+    // Worker thread that runs this event loop.
+    std::thread thread;
+
+    // Number of requests answered by this event loop so far.
+    std::atomic<uint64_t> request_count{0};
+
+    // Number of requests answered by this event loop so far with an error.
+    std::atomic<uint64_t> error_count{0};
+
+    // Number of connections accepted by this event loop so far.
+    std::atomic<uint64_t> connection_count{0};
+
+    // Number of connections refused by this event loop so far.
+    std::atomic<uint64_t> refused_connection_count{0};
+  };
+
+  // Outcome of writing the responses of a connection.
+  enum class Written : int8_t {
+    // All of the responses were written.
+    All,
+
+    // Some of the responses remain because the socket buffer is full.
+    Blocked,
+
+    // The connection failed.
+    Failed,
+  };
+
+  // Sums a given counter over all event loops.
+  [[nodiscard]] uint64_t Sum(std::atomic<uint64_t> Loop::*counter) const noexcept {
+    uint64_t sum = 0;
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      sum += ((*loop).*counter).load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  // Runs an event loop until the server stops.
+  void Run(Loop& loop) {
+    std::array<epoll_event, 256> events{};
+    while (true) {
+      const int count = ::epoll_wait(
+          loop.epoll.Descriptor(), events.data(), static_cast<int>(events.size()), -1);
+      for (int index = 0; index < count; ++index) {
+        if (events[index].data.ptr == nullptr) {
+          return;
+        }
+        if (events[index].data.ptr == &listener_) {
+          AcceptConnections(loop);
+          continue;
+        }
+        // A connection that was closed while handling an earlier event of this batch is skipped.
+        Connection& connection = *static_cast<Connection*>(events[index].data.ptr);
+        if (connection.socket.IsOpen()) {
+          Advance(loop, connection);
+        }
+      }
+    }
+  }
+
+  // Accepts the pending connections into the pool of an event loop, closing those for which the
+  // pool has no room.
+  void AcceptConnections(Loop& loop) {
+    while (true) {
+      const int descriptor =
+          ::accept4(listener_.Descriptor(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (descriptor < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) {
+          continue;
+        }
+        return;
+      }
+
+      if (loop.free_connections.empty()) {
+        ::close(descriptor);
+        loop.refused_connection_count.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      Connection& connection = *loop.free_connections.back();
+      loop.free_connections.pop_back();
+      connection.socket = Socket{descriptor};
+      connection.input_size = 0;
+      connection.output.clear();
+      connection.output_offset = 0;
+      connection.closing = false;
+      connection.writing = false;
+
+      epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.ptr = &connection;
+      ::epoll_ctl(loop.epoll.Descriptor(), EPOLL_CTL_ADD, descriptor, &event);
+      loop.connection_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Advances a connection as far as it can go without blocking: answers the complete requests in
+  // its input, writes the responses, and reads more requests. Closes the connection once its peer
+  // closes it or once a response that ends it is written.
+  void Advance(Loop& loop, Connection& connection) {
+    while (true) {
+      Answer(loop, connection);
+
+      if (connection.output_offset < connection.output.size()) {
+        const Written written = Write(connection);
+        if (written == Written::Failed) {
+          Close(loop, connection);
+          return;
+        }
+        if (written == Written::Blocked) {
+          Watch(loop, connection, true);
+          return;
+        }
+      }
+
+      if (connection.closing) {
+        Close(loop, connection);
+        return;
+      }
+
+      if (connection.input.size() - connection.input_size < ReadSize) {
+        connection.input.resize(connection.input_size + ReadSize);
+      }
+      const ssize_t count =
+          ::recv(connection.socket.Descriptor(), connection.input.data() + connection.input_size,
+                 connection.input.size() - connection.input_size, 0);
+      if (count > 0) {
+        connection.input_size += static_cast<std::size_t>(count);
+        continue;
+      }
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        Watch(loop, connection, false);
+        return;
+      }
+      Close(loop, connection);
+      return;
+    }
+  }
+
+  // Answers the complete requests at the start of the input of a connection, appends their
+  // responses to its output, and removes them from the input. A request whose frame is too large
+  // is answered with an error, after which the connection is closed.
+  void Answer(Loop& loop, Connection& connection) {
+    std::size_t position = 0;
+    while (!connection.closing) {
+      const std::string_view remaining{
+          connection.input.data() + position, connection.input_size - position};
+      const std::optional<std::size_t> payload_length = DaemonPayloadLength(remaining);
+      if (!payload_length.has_value()) {
+        break;
+      }
+      if (payload_length.value() > DaemonMaximumPayloadLength) {
+        AppendDaemonResponse(connection.output, DaemonStatus::Error, "The request is too large.");
+        connection.closing = true;
+        loop.request_count.fetch_add(1, std::memory_order_relaxed);
+        loop.error_count.fetch_add(1, std::memory_order_relaxed);
+        break;
+      }
+      if (remaining.size() < DaemonFrameHeaderLength + payload_length.value()) {
+        break;
+      }
+      const DaemonStatus status = service_.Respond(
+          remaining.substr(DaemonFrameHeaderLength, payload_length.value()), connection.output);
+      position += DaemonFrameHeaderLength + payload_length.value();
+      loop.request_count.fetch_add(1, std::memory_order_relaxed);
+      if (status == DaemonStatus::Error) {
+        loop.error_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (position > 0) {
+      std::memmove(connection.input.data(), connection.input.data() + position,
+                   connection.input_size - position);
+      connection.input_size -= position;
+    }
+  }
+
+  // Writes as much of the responses waiting on a connection as its socket accepts.
+  [[nodiscard]] static Written Write(Connection& connection) {
+    while (connection.output_offset < connection.output.size()) {
+      const ssize_t count = ::send(connection.socket.Descriptor(),
+                                   connection.output.data() + connection.output_offset,
+                                   connection.output.size() - connection.output_offset,
+                                   MSG_NOSIGNAL);
+      if (count < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno == EAGAIN || errno == EWOULDBLOCK ? Written::Blocked : Written::Failed;
+      }
+      connection.output_offset += static_cast<std::size_t>(count);
+    }
+    connection.output.clear();
+    connection.output_offset = 0;
+    return Written::All;
+  }
+
+  // Makes an event loop wait for a connection to become writable, or readable otherwise.
+  static void Watch(Loop& loop, Connection& connection, const bool writing) {
+    if (connection.writing == writing) {
+      return;
+    }
+    connection.writing = writing;
+    epoll_event event{};
+    event.events = writing ? EPOLLOUT : EPOLLIN;
+    event.data.ptr = &connection;
+    ::epoll_ctl(loop.epoll.Descriptor(), EPOLL_CTL_MOD, connection.socket.Descriptor(), &event);
+  }
+
+  // Closes a connection and returns it to the pool of its event loop.
+  static void Close(Loop& loop, Connection& connection) {
+    connection.socket.Close();
+    loop.free_connections.push_back(&connection);
+  }
+
+  // Service that answers the requests.
+  DaemonService& service_;
+
+  // Non-blocking socket on which this server listens for connections.
+  Socket listener_;
+
+  // Path of the Unix domain socket on which this server listens, or an empty path if it is not
+  // listening.
+  std::filesystem::path path_;
+
+  // Event loops of the worker threads that serve the connections.
+  std::vector<std::unique_ptr<Loop>> loops_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_DAEMON_SERVER_HPP
@@ -0,0 +1,273 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DAEMON_SERVICE_HPP
+#define SECRET_SANTA_DAEMON_SERVICE_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Configuration.hpp"
+#include "DaemonProtocol.hpp"
+#include "Emailer.hpp"
+#include "FileCache.hpp"
+#include "Matchings.hpp"
+#include "Participant.hpp"
+#include "Verification.hpp"
+
+namespace SecretSanta {
+
+// Answers the requests of the Secret Santa Daemon. Keeps the configuration and matchings files that
+// it reads parsed in memory, and reads a file again only once it changes, so that answering a
+// request for a small event takes microseconds instead of the milliseconds of starting a process,
+// parsing its files, and opening the random device. Safe to use from several threads at once.
+class DaemonService {
+public:
+  // Constructor. Constructs a service whose caches hold at most a given number of configuration
+  // files and of matchings files.
+  explicit DaemonService(const std::size_t cache_capacity = 1024)
+    : configurations_(cache_capacity), matchings_(cache_capacity) {}
+
+  // Destructor. Destroys this service and its caches.
+  ~DaemonService() noexcept = default;
+
+  // Deleted copy constructor.
+  DaemonService(const DaemonService& other) = delete;
+
+  // Deleted move constructor.
+  DaemonService(DaemonService&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  DaemonService& operator=(const DaemonService& other) = delete;
+
+  // Deleted move assignment operator.
+  DaemonService& operator=(DaemonService&& other) noexcept = delete;
+
+  // Answers the request held in a given frame payload and appends the response frame to a given
+  // buffer. Returns the status of the response. A request that fails, even because a file cannot be
+  // parsed, is answered with an error rather than stopping the service.
+  DaemonStatus Respond(const std::string_view payload, std::string& output) {
+    const std::optional<DaemonRequest> request = ParseDaemonRequest(payload);
+    std::string text;
+    DaemonStatus status{DaemonStatus::Error};
+    if (!request.has_value()) {
+      text = "Malformed request.";
+    } else {
+      try {
+        switch (request->operation) {
+          case DaemonOperation::Randomize:
+            status = Randomize(request.value(), text);
+            break;
+          case DaemonOperation::Verify:
+            status = Verify(request.value(), text);
+            break;
+          case DaemonOperation::Render:
+            status = Render(request.value(), text);
+            break;
+        }
+      } catch (const std::exception& exception) {
+        status = DaemonStatus::Error;
+        text = std::string{"The request failed: "} + exception.what();
+      }
+    }
+    AppendDaemonResponse(output, status, text);
+    return status;
+  }
+
+  // Number of files read so far, which is the number of lookups that missed the caches.
+  [[nodiscard]] uint64_t FileReadCount() const noexcept {
+    return configurations_.MissCount() + matchings_.MissCount();
+  }
+
+  // Number of lookups so far that found an up-to-date file in the caches.
+  [[nodiscard]] uint64_t CacheHitCount() const noexcept {
+    return configurations_.HitCount() + matchings_.HitCount();
+  }
+
+private:
+  // Randomizes matchings for the participants of a configuration file, writes them to a matchings
+  // file unless its path is empty, and sets the text of the response to them.
+  DaemonStatus Randomize(const DaemonRequest& request, std::string& text) {
+    if (request.field_count < 2 || request.field_count > 3) {
+      text = "A randomize request has the path to a configuration file, the path to a matchings "
+             "file, and optionally a random seed.";
+      return DaemonStatus::Error;
+    }
+
+    const std::shared_ptr<const Configuration> configuration =
+        ReadConfiguration(request.fields[0], text);
+    if (configuration == nullptr) {
+      return DaemonStatus::Error;
+    }
+
+    std::optional<int64_t> random_seed;
+    if (request.field_count == 3) {
+      random_seed = ParseRandomSeed(request.fields[2]);
+      if (!random_seed.has_value()) {
+        text = "Invalid random seed: " + std::string{request.fields[2]};
+        return DaemonStatus::Error;
+      }
+    } else {
+      random_seed = DrawRandomSeed();
+    }
+
+    const std::optional<std::string> unmatchable_reason{
+        UnmatchableReason(configuration->Participants())};
+    if (unmatchable_reason.has_value()) {
+      text = unmatchable_reason.value();
+      return DaemonStatus::Error;
+    }
+
+    const std::shared_ptr<const Matchings> matchings =
+        std::make_shared<const Matchings>(configuration->Participants(), random_seed);
+
+    const std::filesystem::path matchings_file{request.fields[1]};
+    if (!matchings_file.empty()) {
+      matchings->Write(matchings_file);
+      matchings_.Put(matchings_file, matchings);
+    }
+
+    text = matchings->Yaml();
+    return DaemonStatus::Ok;
+  }
+
+  // Verifies the matchings of a matchings file against the participants of a configuration file,
+  // and sets the text of the response to the outcome.
+  DaemonStatus Verify(const DaemonRequest& request, std::string& text) {
+    if (request.field_count != 2) {
+      text = "A verify request has the path to a configuration file and the path to a matchings "
+             "file.";
+      return DaemonStatus::Error;
+    }
+
+    const std::shared_ptr<const Configuration> configuration =
+        ReadConfiguration(request.fields[0], text);
+    const std::shared_ptr<const Matchings> matchings =
+        configuration == nullptr ? nullptr : ReadMatchings(request.fields[1], text);
+    if (matchings == nullptr) {
+      return DaemonStatus::Error;
+    }
+
+    const Verification verification{configuration->Participants(), *matchings};
+    std::ostringstream stream;
+    verification.Print(stream);
+    text = stream.str();
+    return verification.IsValid() ? DaemonStatus::Ok : DaemonStatus::Invalid;
+  }
+
+  // Renders the body of the email message of a gifter given the participants and message of a
+  // configuration file and the matchings of a matchings file, and sets the text of the response to
+  // it.
+  DaemonStatus Render(const DaemonRequest& request, std::string& text) {
+    if (request.field_count != 3) {
+      text = "A render request has the path to a configuration file, the path to a matchings file, "
+             "and the name of a gifter.";
+      return DaemonStatus::Error;
+    }
+
+    const std::shared_ptr<const Configuration> configuration =
+        ReadConfiguration(request.fields[0], text);
+    const std::shared_ptr<const Matchings> matchings =
+        configuration == nullptr ? nullptr : ReadMatchings(request.fields[1], text);
+    if (matchings == nullptr) {
+      return DaemonStatus::Error;
+    }
+
+    const std::set<Participant>::const_iterator gifter =
+        configuration->Participants().find(Participant{std::string{request.fields[2]}});
+    const std::vector<const Participant*> giftees =
+        gifter == configuration->Participants().end() ?
+            std::vector<const Participant*>{} :
+            FindGiftees(*configuration, *matchings, *gifter);
+    if (giftees.empty()) {
+      text = "No giftee is found for the gifter " + std::string{request.fields[2]} + ".";
+      return DaemonStatus::NotFound;
+    }
+
+    text = ComposeFullMessageBody(*gifter, giftees, configuration->MessageBody());
+    return DaemonStatus::Ok;
+  }
+
+  // Returns the configuration of a given configuration file, from the cache if the file did not
+  // change. Returns null and sets the text of the response if the file does not exist or defines
+  // no participants.
+  [[nodiscard]] std::shared_ptr<const Configuration> ReadConfiguration(
+      const std::string_view path, std::string& text) {
+    std::shared_ptr<const Configuration> configuration =
+        configurations_.Get(std::filesystem::path{path});
+    if (configuration == nullptr) {
+      text = "Cannot find the YAML configuration file at \"" + std::string{path} + "\".";
+    } else if (configuration->Participants().empty()) {
+      text = "No participants are defined in the YAML configuration file at \"" + std::string{path}
+             + "\".";
+      configuration.reset();
+    }
+    return configuration;
+  }
+
+  // Returns the matchings of a given matchings file, from the cache if the file did not change.
+  // Returns null and sets the text of the response if the file does not exist.
+  [[nodiscard]] std::shared_ptr<const Matchings> ReadMatchings(
+      const std::string_view path, std::string& text) {
+    std::shared_ptr<const Matchings> matchings = matchings_.Get(std::filesystem::path{path});
+    if (matchings == nullptr) {
+      text = "Cannot find the YAML matchings file at \"" + std::string{path} + "\".";
+    }
+    return matchings;
+  }
+
+  // Draws a random seed for one randomization from a random generator of the calling thread. Each
+  // thread opens the random device only once, to seed its generator, rather than once per request.
+  [[nodiscard]] static int64_t DrawRandomSeed() {
+    thread_local std::mt19937_64 random_generator{std::random_device{}()};
+    return static_cast<int64_t>(random_generator());
+  }
+
+  // Parses a random seed given as a decimal integer. Returns nothing if the text is not one.
+  [[nodiscard]] static std::optional<int64_t> ParseRandomSeed(const std::string_view text) {
+    int64_t random_seed{0};
+    const std::from_chars_result result =
+        std::from_chars(text.data(), text.data() + text.size(), random_seed);
+    if (text.empty() || result.ec != std::errc{} || result.ptr != text.data() + text.size()) {
+      return std::nullopt;
+    }
+    return random_seed;
+  }
+
+  // Parsed configuration files, keyed by path.
+  FileCache<Configuration> configurations_;
+
+  // Parsed matchings files, keyed by path.
+  FileCache<Matchings> matchings_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_DAEMON_SERVICE_HPP
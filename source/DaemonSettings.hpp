@@ -0,0 +1,243 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DAEMON_SETTINGS_HPP
+#define SECRET_SANTA_DAEMON_SETTINGS_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "DaemonArgument.hpp"
+#include "DaemonProgram.hpp"
+#include "String.hpp"
+
+namespace SecretSanta::Daemon {
+
+// Settings of the Secret Santa Daemon program.
+class Settings {
+public:
+  // Default constructor. Constructs settings with default parameters.
+  Settings() = default;
+
+  // Constructor. Constructs settings from command-line arguments.
+  Settings(const int argc, char* argv[]) noexcept {
+    ParseArguments(argc, argv);
+    PrintHeader();
+    PrintCommand();
+    PrintSettings();
+  }
+
+  // Destructor. Destroys this settings object.
+  ~Settings() noexcept = default;
+
+  // Deleted copy constructor.
+  Settings(const Settings& other) = delete;
+
+  // Deleted move constructor.
+  Settings(Settings&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  Settings& operator=(const Settings& other) = delete;
+
+  // Deleted move assignment operator.
+  Settings& operator=(Settings&& other) noexcept = delete;
+
+  // Path to the Unix domain socket on which to listen.
+  [[nodiscard]] const std::filesystem::path& SocketFile() const noexcept {
+    return socket_file_;
+  }
+
+  // Number of worker threads that serve the connections.
+  [[nodiscard]] constexpr std::size_t Threads() const noexcept {
+    return threads_;
+  }
+
+  // Maximum number of connections open at once.
+  [[nodiscard]] constexpr std::size_t MaximumConnections() const noexcept {
+    return maximum_connections_;
+  }
+
+  // Maximum number of configuration files and of matchings files kept in memory.
+  [[nodiscard]] constexpr std::size_t CacheCapacity() const noexcept {
+    return cache_capacity_;
+  }
+
+private:
+  // Prints the program's header information to the console.
+  void PrintHeader() const {
+    std::cout << Program::Title << std::endl;
+    std::cout << Program::Description << std::endl;
+    std::cout << "Version: " << Program::CompilationDateAndTime << std::endl;
+  }
+
+  // Prints the program's usage information to the console.
+  void PrintUsage() const {
+    const std::string indent{"  "};
+
+    std::cout << "Usage:" << std::endl;
+
+    std::cout << indent << executable_name_ << " " << Argument::Socket() << " ["
+              << Argument::Threads() << "] [" << Argument::MaximumConnections() << "] ["
+              << Argument::CacheCapacity() << "]" << std::endl;
+
+    // Compute the padding length of the argument patterns.
+    const std::size_t length = std::max({
+      Argument::Help().length(),
+      Argument::Socket().length(),
+      Argument::Threads().length(),
+      Argument::MaximumConnections().length(),
+      Argument::CacheCapacity().length(),
+    });
+
+    std::cout << "Arguments:" << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Help(), length) << indent
+              << "Displays this information and exits." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Socket(), length) << indent
+              << "Path to the Unix domain socket on which to listen. Required." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Threads(), length) << indent
+              << "Number of worker threads that serve the connections. Optional; defaults to the "
+                 "number of processor cores."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::MaximumConnections(), length) << indent
+              << "Maximum number of connections open at once. Optional; defaults to 1024."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::CacheCapacity(), length) << indent
+              << "Maximum number of configuration files and of matchings files kept in memory. "
+                 "Optional; defaults to 1024."
+              << std::endl;
+  }
+
+  // Parses the program's command-line arguments.
+  void ParseArguments(const int argc, char* argv[]) {
+    if (argc <= 1) {
+      PrintHeader();
+      PrintUsage();
+      exit(EXIT_SUCCESS);
+    }
+
+    if (argc >= 1) {
+      executable_name_ = argv[0];
+    }
+
+    for (int index = 1; index < argc;) {
+      if (argv[index] == Argument::Key::Help) {
+        PrintHeader();
+        PrintUsage();
+        exit(EXIT_SUCCESS);
+      } else if (argv[index] == Argument::Key::Socket && AtLeastOneMore(index, argc)) {
+        socket_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Threads && AtLeastOneMore(index, argc)) {
+        threads_ = std::strtoull(argv[index + 1], nullptr, 10);
+        if (threads_ == 0) {
+          PrintHeader();
+          std::cout << "Invalid number of threads: " << argv[index + 1]
+                    << "; please specify an integer of at least 1." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else if (argv[index] == Argument::Key::MaximumConnections && AtLeastOneMore(index, argc)) {
+        maximum_connections_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::CacheCapacity && AtLeastOneMore(index, argc)) {
+        cache_capacity_ = std::strtoull(argv[index + 1], nullptr, 10);
+        if (cache_capacity_ == 0) {
+          PrintHeader();
+          std::cout << "Invalid cache capacity: " << argv[index + 1]
+                    << "; please specify an integer of at least 1." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else {
+        PrintHeader();
+        std::cout << "Unrecognized argument: " << argv[index] << std::endl;
+        PrintUsage();
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    if (socket_file_.empty()) {
+      PrintHeader();
+      std::cout << "The Unix domain socket is required; please specify " << Argument::Key::Socket
+                << "." << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // Returns whether there is at least one more element after the given element index.
+  [[nodiscard]] bool AtLeastOneMore(const int index, const int count) const noexcept {
+    return index + 1 < count;
+  }
+
+  // Prints the command to the console.
+  void PrintCommand() const {
+    std::cout << "Command: " << executable_name_ << " " << Argument::Key::Socket << " "
+              << socket_file_.string() << " " << Argument::Key::Threads << " " << threads_ << " "
+              << Argument::Key::MaximumConnections << " " << maximum_connections_ << " "
+              << Argument::Key::CacheCapacity << " " << cache_capacity_ << std::endl;
+  }
+
+  // Prints the settings to the console.
+  void PrintSettings() const {
+    std::cout << "- The daemon will listen on the Unix domain socket at: " << socket_file_
+              << std::endl;
+
+    std::cout << "- The connections will be served by " << threads_ << " worker threads."
+              << std::endl;
+
+    std::cout << "- At most " << maximum_connections_ << " connections will be open at once."
+              << std::endl;
+
+    std::cout << "- At most " << cache_capacity_
+              << " configuration files and as many matchings files will be kept in memory."
+              << std::endl;
+  }
+
+  // Name of the Secret Santa Daemon executable.
+  std::string executable_name_;
+
+  // Path to the Unix domain socket on which to listen.
+  std::filesystem::path socket_file_;
+
+  // Number of worker threads that serve the connections.
+  std::size_t threads_{std::max<std::size_t>(std::thread::hardware_concurrency(), 1)};
+
+  // Maximum number of connections open at once.
+  std::size_t maximum_connections_{1024};
+
+  // Maximum number of configuration files and of matchings files kept in memory.
+  std::size_t cache_capacity_{1024};
+};
+
+}  // namespace SecretSanta::Daemon
+
+#endif  // SECRET_SANTA_DAEMON_SETTINGS_HPP
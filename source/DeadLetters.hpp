@@ -0,0 +1,238 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DEAD_LETTERS_HPP
+#define SECRET_SANTA_DEAD_LETTERS_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "EmailMessage.hpp"
+#include "MimeEncoding.hpp"
+#include "MimeMessage.hpp"
+
+namespace SecretSanta {
+
+// Email message that could not be delivered, along with the number of attempts made and the details
+// of the last failure.
+struct DeadLetter {
+  // Email message that could not be delivered.
+  EmailMessage message;
+
+  // Number of attempts made to deliver the email message.
+  std::size_t attempts{0};
+
+  // Details of the last failure, such as the response of the mail server.
+  std::string details;
+};
+
+// Email messages that could not be delivered, either because they failed permanently or because
+// they still failed after the maximum number of attempts. Can be written to a YAML dead-letter file
+// and read back later, so that these email messages can be sent again once the cause of the failure
+// is fixed.
+class DeadLetters {
+public:
+  // Default constructor. Constructs an empty set of dead letters.
+  DeadLetters() = default;
+
+  // Constructor. Constructs dead letters by reading them from a given YAML dead-letter file.
+  explicit DeadLetters(const std::filesystem::path& path) {
+    if (!std::filesystem::exists(path)) {
+      std::cout << "Cannot find the YAML dead-letter file at " << path
+                << "; please check the file path." << std::endl;
+      return;
+    }
+
+    const YAML::Node root = YAML::LoadFile(path.string());
+    if (!root || !root["dead_letters"] || !root["dead_letters"].IsSequence()) {
+      std::cout << "Cannot parse the YAML dead-letter file at " << path
+                << "; please check that it is a valid dead-letter file." << std::endl;
+      return;
+    }
+
+    std::size_t index = 0;
+    for (const YAML::Node& node : root["dead_letters"]) {
+      ++index;
+      if (!node.IsMap() || !node["gifter"] || !node["recipient"] || !node["subject"]
+          || !node["body"]) {
+        std::cout << "Skipping the malformed entry #" << index
+                  << " of the YAML dead-letter file at: " << path << std::endl;
+        continue;
+      }
+      EmailMessage message{node["gifter"].as<std::string>(), node["recipient"].as<std::string>(),
+                           node["subject"].as<std::string>(), node["body"].as<std::string>()};
+      if (node["html"]) {
+        message.SetHtml(node["html"].as<std::string>());
+      }
+      if (node["attachments"] && node["attachments"].IsSequence()) {
+        for (const YAML::Node& attachment : node["attachments"]) {
+          const std::optional<std::string> data{
+              attachment["data"] ? Base64Decode(attachment["data"].as<std::string>()) :
+                                   std::nullopt};
+          if (!attachment["file_name"] || !attachment["content_type"] || !data.has_value()) {
+            std::cout << "Skipping a malformed attachment of the entry #" << index
+                      << " of the YAML dead-letter file at: " << path << std::endl;
+            continue;
+          }
+          message.Attach(EncodeAttachment(attachment["file_name"].as<std::string>(),
+                                          attachment["content_type"].as<std::string>(),
+                                          data.value()));
+        }
+      }
+      entries_.push_back(DeadLetter{
+          std::move(message), node["attempts"] ? node["attempts"].as<std::size_t>() : 0,
+          node["error"] ? node["error"].as<std::string>() : std::string{}});
+    }
+
+    std::cout << "Read " << entries_.size()
+              << " undelivered email messages from the YAML dead-letter file at: " << path
+              << std::endl;
+  }
+
+  // Destructor. Destroys this set of dead letters.
+  ~DeadLetters() noexcept = default;
+
+  // Copy constructor. Constructs a set of dead letters by copying another one.
+  DeadLetters(const DeadLetters& other) = default;
+
+  // Move constructor. Constructs a set of dead letters by moving another one.
+  DeadLetters(DeadLetters&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this set of dead letters by copying another one.
+  DeadLetters& operator=(const DeadLetters& other) = default;
+
+  // Move assignment operator. Assigns this set of dead letters by moving another one.
+  DeadLetters& operator=(DeadLetters&& other) noexcept = default;
+
+  // Dead letters, in the order in which they were added.
+  [[nodiscard]] const std::vector<DeadLetter>& Entries() const noexcept {
+    return entries_;
+  }
+
+  // Whether there are no dead letters.
+  [[nodiscard]] bool Empty() const noexcept {
+    return entries_.empty();
+  }
+
+  // Number of dead letters.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return entries_.size();
+  }
+
+  // Email messages of the dead letters, in the order in which they were added.
+  [[nodiscard]] std::vector<EmailMessage> Messages() const {
+    std::vector<EmailMessage> messages;
+    messages.reserve(entries_.size());
+    for (const DeadLetter& entry : entries_) {
+      messages.push_back(entry.message);
+    }
+    return messages;
+  }
+
+  // Adds a dead letter.
+  void Add(DeadLetter dead_letter) {
+    entries_.push_back(std::move(dead_letter));
+  }
+
+  // Writes these dead letters to a given YAML file. The email messages reveal the giftees, so only
+  // the owner of the file may read it.
+  void Write(const std::filesystem::path& path) const {
+    if (path.empty()) {
+      return;
+    }
+
+    if (!path.parent_path().empty()) {
+      std::filesystem::create_directories(path.parent_path());
+    }
+
+    std::ofstream stream{path.string()};
+    if (!stream.is_open()) {
+      std::cout << "Could not open the YAML dead-letter file for writing at: " << path.string()
+                << std::endl;
+      return;
+    }
+
+    YAML::Emitter emitter;
+    emitter << YAML::BeginMap;
+    emitter << YAML::Key << "dead_letters";
+    emitter << YAML::Value << YAML::BeginSeq;
+    for (const DeadLetter& entry : entries_) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "gifter" << YAML::Value << entry.message.GifterName();
+      emitter << YAML::Key << "recipient" << YAML::Value << entry.message.Recipient();
+      emitter << YAML::Key << "subject" << YAML::Value << entry.message.Subject();
+      // A literal block keeps exactly one trailing newline when read back and cannot start with
+      // whitespace, so only bodies that fit are written as literal blocks. Other bodies are quoted.
+      const std::string& body = entry.message.Body();
+      const bool literal = body.ends_with('\n') && !body.ends_with("\n\n")
+                           && body.find_first_of(" \t\n") != 0;
+      emitter << YAML::Key << "body" << YAML::Value;
+      if (literal) {
+        emitter << YAML::Literal;
+      }
+      emitter << body;
+      if (!entry.message.Html().empty()) {
+        emitter << YAML::Key << "html" << YAML::Value << entry.message.Html();
+      }
+      // Attachments may hold any bytes, so their contents are written in base64.
+      if (!entry.message.Attachments().empty()) {
+        emitter << YAML::Key << "attachments" << YAML::Value << YAML::BeginSeq;
+        for (const std::shared_ptr<const EmailAttachment>& attachment :
+             entry.message.Attachments()) {
+          emitter << YAML::BeginMap;
+          emitter << YAML::Key << "file_name" << YAML::Value << attachment->file_name;
+          emitter << YAML::Key << "content_type" << YAML::Value << attachment->content_type;
+          emitter << YAML::Key << "data" << YAML::Value << Base64Encode(attachment->data);
+          emitter << YAML::EndMap;
+        }
+        emitter << YAML::EndSeq;
+      }
+      emitter << YAML::Key << "attempts" << YAML::Value << entry.attempts;
+      emitter << YAML::Key << "error" << YAML::Value << entry.details;
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq << YAML::EndMap;
+
+    stream << emitter.c_str() << std::endl;
+    stream.close();
+
+    std::filesystem::permissions(
+        path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+
+    std::cout << "Wrote " << entries_.size()
+              << " undelivered email messages to the YAML dead-letter file: " << path << std::endl;
+  }
+
+private:
+  // Dead letters, in the order in which they were added.
+  std::vector<DeadLetter> entries_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_DEAD_LETTERS_HPP
@@ -0,0 +1,241 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DELIVERY_OUTCOMES_HPP
+#define SECRET_SANTA_DELIVERY_OUTCOMES_HPP
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "Shard.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Prints a delivery status as a word, such as "delivered".
+[[nodiscard]] std::string PrintDeliveryStatus(const DeliveryStatus status) {
+  switch (status) {
+    case DeliveryStatus::Delivered:
+      return "delivered";
+    case DeliveryStatus::TransientFailure:
+      return "transient_failure";
+    case DeliveryStatus::PermanentFailure:
+      return "permanent_failure";
+  }
+  return "unknown";
+}
+
+// Parses a delivery status printed by PrintDeliveryStatus. Returns no value if the text is not a
+// delivery status.
+[[nodiscard]] std::optional<DeliveryStatus> ParseDeliveryStatus(const std::string_view text) {
+  for (const DeliveryStatus status : {DeliveryStatus::Delivered, DeliveryStatus::TransientFailure,
+                                      DeliveryStatus::PermanentFailure}) {
+    if (PrintDeliveryStatus(status) == text) {
+      return status;
+    }
+  }
+  return std::nullopt;
+}
+
+// Final outcome of the delivery of the email message to one gifter. It names the gifter and the
+// recipient but not the giftee, so that it can be shared freely.
+struct DeliveryOutcome {
+  // Name of the gifter to whom the email message was sent.
+  std::string gifter;
+
+  // Email address to which the email message was sent.
+  std::string recipient;
+
+  // Status of the last attempt to deliver the email message.
+  DeliveryStatus status{DeliveryStatus::Delivered};
+
+  // Number of attempts made to deliver the email message.
+  std::size_t attempts{0};
+
+  // Details of the last attempt, such as the response of the mail server.
+  std::string details;
+};
+
+// Final outcomes of the deliveries of one run of the Secret Santa Messenger, along with the shard
+// of the gifters that the run covered and the host on which it ran. Can be written to a YAML
+// outcome file and read back, so that the outcome files of several hosts can be merged into one
+// run report.
+class DeliveryOutcomes {
+public:
+  // Default constructor. Constructs an empty set of outcomes of no particular shard or host.
+  DeliveryOutcomes() = default;
+
+  // Constructor. Constructs outcomes by reading them from a given YAML outcome file.
+  explicit DeliveryOutcomes(const std::filesystem::path& path) {
+    if (!std::filesystem::exists(path)) {
+      std::cout << "Cannot find the YAML outcome file at " << path
+                << "; please check the file path." << std::endl;
+      return;
+    }
+
+    const YAML::Node root = YAML::LoadFile(path.string());
+    if (!root || !root["outcomes"] || !root["outcomes"].IsSequence()) {
+      std::cout << "Cannot parse the YAML outcome file at " << path
+                << "; please check that it is a valid outcome file." << std::endl;
+      return;
+    }
+
+    if (root["shard"]) {
+      shard_ = ParseShard(root["shard"].as<std::string>());
+      if (!shard_.has_value()) {
+        std::cout << "Ignoring the invalid shard " << root["shard"].as<std::string>()
+                  << " of the YAML outcome file at: " << path << std::endl;
+      }
+    }
+    if (root["host"]) {
+      host_ = root["host"].as<std::string>();
+    }
+
+    std::size_t index = 0;
+    for (const YAML::Node& node : root["outcomes"]) {
+      ++index;
+      const std::optional<DeliveryStatus> status{
+          node.IsMap() && node["status"] ? ParseDeliveryStatus(node["status"].as<std::string>()) :
+                                           std::nullopt};
+      if (!node.IsMap() || !node["gifter"] || !node["recipient"] || !status.has_value()) {
+        std::cout << "Skipping the malformed entry #" << index
+                  << " of the YAML outcome file at: " << path << std::endl;
+        continue;
+      }
+      entries_.push_back(DeliveryOutcome{
+          node["gifter"].as<std::string>(), node["recipient"].as<std::string>(), status.value(),
+          node["attempts"] ? node["attempts"].as<std::size_t>() : 0,
+          node["details"] ? node["details"].as<std::string>() : std::string{}});
+    }
+  }
+
+  // Destructor. Destroys this set of outcomes.
+  ~DeliveryOutcomes() noexcept = default;
+
+  // Copy constructor. Constructs a set of outcomes by copying another one.
+  DeliveryOutcomes(const DeliveryOutcomes& other) = default;
+
+  // Move constructor. Constructs a set of outcomes by moving another one.
+  DeliveryOutcomes(DeliveryOutcomes&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this set of outcomes by copying another one.
+  DeliveryOutcomes& operator=(const DeliveryOutcomes& other) = default;
+
+  // Move assignment operator. Assigns this set of outcomes by moving another one.
+  DeliveryOutcomes& operator=(DeliveryOutcomes&& other) noexcept = default;
+
+  // Outcomes, in the order in which the deliveries completed.
+  [[nodiscard]] const std::vector<DeliveryOutcome>& Entries() const noexcept {
+    return entries_;
+  }
+
+  // Number of outcomes.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return entries_.size();
+  }
+
+  // Optional shard of the gifters that the run covered. If no value is specified, the run covered
+  // every gifter.
+  [[nodiscard]] const std::optional<Shard>& HostShard() const noexcept {
+    return shard_;
+  }
+
+  // Name of the host on which the run took place.
+  [[nodiscard]] const std::string& Host() const noexcept {
+    return host_;
+  }
+
+  // Sets the shard of the gifters that the run covered and the host on which it took place.
+  void SetOrigin(const std::optional<Shard>& shard, std::string host) {
+    shard_ = shard;
+    host_ = std::move(host);
+  }
+
+  // Adds an outcome.
+  void Add(DeliveryOutcome outcome) {
+    entries_.push_back(std::move(outcome));
+  }
+
+  // Writes these outcomes to a given YAML file.
+  void Write(const std::filesystem::path& path) const {
+    if (path.empty()) {
+      return;
+    }
+
+    if (!path.parent_path().empty()) {
+      std::filesystem::create_directories(path.parent_path());
+    }
+
+    std::ofstream stream{path.string()};
+    if (!stream.is_open()) {
+      std::cout << "Could not open the YAML outcome file for writing at: " << path.string()
+                << std::endl;
+      return;
+    }
+
+    YAML::Emitter emitter;
+    emitter << YAML::BeginMap;
+    if (shard_.has_value()) {
+      emitter << YAML::Key << "shard" << YAML::Value << shard_->Print();
+    }
+    emitter << YAML::Key << "host" << YAML::Value << host_;
+    emitter << YAML::Key << "outcomes" << YAML::Value << YAML::BeginSeq;
+    for (const DeliveryOutcome& entry : entries_) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "gifter" << YAML::Value << entry.gifter;
+      emitter << YAML::Key << "recipient" << YAML::Value << entry.recipient;
+      emitter << YAML::Key << "status" << YAML::Value
+              << PrintDeliveryStatus(entry.status);
+      emitter << YAML::Key << "attempts" << YAML::Value << entry.attempts;
+      if (!entry.details.empty()) {
+        emitter << YAML::Key << "details" << YAML::Value << entry.details;
+      }
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq << YAML::EndMap;
+
+    stream << emitter.c_str() << std::endl;
+    stream.close();
+
+    std::cout << "Wrote the outcomes of " << entries_.size()
+              << " email messages to the YAML outcome file: " << path << std::endl;
+  }
+
+private:
+  // Optional shard of the gifters that the run covered.
+  std::optional<Shard> shard_;
+
+  // Name of the host on which the run took place.
+  std::string host_;
+
+  // Outcomes, in the order in which the deliveries completed.
+  std::vector<DeliveryOutcome> entries_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_DELIVERY_OUTCOMES_HPP
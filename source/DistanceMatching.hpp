@@ -0,0 +1,208 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_DISTANCE_MATCHING_HPP
+#define SECRET_SANTA_DISTANCE_MATCHING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "AssignmentSolver.hpp"
+#include "Geography.hpp"
+
+namespace SecretSanta {
+
+// Shipping distance that a distance matching minimizes.
+enum class DistanceObjective : int8_t {
+  // Total shipping distance of all gifts.
+  Total,
+
+  // Longest shipping distance of any gift. Among the matchings that achieve it, the total shipping
+  // distance is then minimized.
+  Maximum,
+};
+
+// Parses the name of a distance objective, such as "total" or "maximum". Returns no value if the
+// name is not a distance objective.
+[[nodiscard]] std::optional<DistanceObjective> ParseDistanceObjective(const std::string_view name) {
+  if (name == "total") {
+    return DistanceObjective::Total;
+  }
+  if (name == "maximum") {
+    return DistanceObjective::Maximum;
+  }
+  return std::nullopt;
+}
+
+// Name of a given distance objective, such as "total" or "maximum".
+[[nodiscard]] std::string_view DistanceObjectiveName(const DistanceObjective objective) {
+  return objective == DistanceObjective::Maximum ? "maximum" : "total";
+}
+
+// Options of a distance matching.
+struct DistanceMatchingOptions {
+  // Shipping distance to minimize.
+  DistanceObjective objective{DistanceObjective::Total};
+
+  // Amount of randomness mixed into the distances, from 0 for none. Each distance is multiplied by
+  // a random factor between 1 and 1 plus this amount, so that nearly equivalent matchings are
+  // chosen at random rather than always the same one.
+  double randomness{0.0};
+
+  // Number of nearest other participants considered as giftees of each participant.
+  std::size_t candidate_count{8};
+
+  // Number of threads used to find the nearest participants and to solve the assignment.
+  std::size_t thread_count{std::max<std::size_t>(std::thread::hardware_concurrency(), 1)};
+};
+
+// Result of a distance matching.
+struct DistanceMatchingResult {
+  // Index of the giftee of each participant.
+  std::vector<uint32_t> giftees;
+
+  // Total shipping distance in kilometers between the gifters and giftees whose locations are
+  // known.
+  double total_kilometers{0.0};
+
+  // Longest shipping distance in kilometers between a gifter and a giftee whose locations are
+  // known.
+  double maximum_kilometers{0.0};
+};
+
+// Matches each of a given list of participants, given by their locations, with a distinct giftee
+// other than themselves, such that the shipping distance between gifters and giftees is minimized.
+// Each participant only considers their nearest other participants as giftees and as gifters,
+// which keeps the problem sparse, plus their successor in a random cycle of all the participants,
+// which guarantees that a matching exists. Participants whose location is unknown have only that
+// successor as candidate giftee and only their predecessor as candidate gifter. The sparse
+// assignment problem is then solved with a parallel auction algorithm, so that a hundred thousand
+// participants are matched in seconds. Fewer than two participants cannot be matched with giftees
+// other than themselves, so they give empty matchings.
+[[nodiscard]] DistanceMatchingResult MatchByDistance(
+    const std::vector<std::optional<Coordinates>>& locations,
+    const DistanceMatchingOptions& options, std::mt19937_64& random_generator) {
+  const std::size_t size = locations.size();
+  DistanceMatchingResult result;
+  if (size <= 1) {
+    return result;
+  }
+  result.giftees.resize(size);
+  for (std::size_t index = 0; index < size; ++index) {
+    result.giftees[index] = static_cast<uint32_t>(index);
+  }
+
+  // Random cycle of all the participants.
+  std::vector<uint32_t> order{result.giftees};
+  std::shuffle(order.begin(), order.end(), random_generator);
+  std::vector<uint32_t> successors(size);
+  for (std::size_t index = 0; index < size; ++index) {
+    successors[order[index]] = order[(index + 1) % size];
+  }
+
+  // Positions of the participants whose location is known, and their nearest neighbors.
+  std::vector<uint32_t> located;
+  std::vector<std::array<double, 3>> positions(size);
+  std::vector<std::array<double, 3>> located_positions;
+  for (std::size_t index = 0; index < size; ++index) {
+    if (locations[index].has_value()) {
+      positions[index] = UnitSpherePosition(locations[index].value());
+      located.push_back(static_cast<uint32_t>(index));
+      located_positions.push_back(positions[index]);
+    }
+  }
+  const std::size_t candidate_count = std::min(options.candidate_count, located.size());
+  const std::vector<uint32_t> neighbors{
+      FindNearestNeighbors(located_positions, candidate_count, options.thread_count)};
+
+  // Cost of shipping from one participant to another in meters, with the random factor applied,
+  // or zero if either location is unknown.
+  std::uniform_real_distribution<double> noise{0.0, 1.0};
+  const std::function<int64_t(uint32_t, uint32_t)> cost = [&](const uint32_t gifter,
+                                                               const uint32_t giftee) -> int64_t {
+    if (!locations[gifter].has_value() || !locations[giftee].has_value()) {
+      return 0;
+    }
+    const double factor =
+        options.randomness > 0.0 ? 1.0 + options.randomness * noise(random_generator) : 1.0;
+    return static_cast<int64_t>(
+        std::llround(GreatCircleDistance(positions[gifter], positions[giftee]) * 1000.0 * factor));
+  };
+
+  // Each gifter considers their nearest participants as giftees, and each giftee their nearest
+  // participants as gifters, so that a participant far from everyone else still has nearby
+  // candidates both ways.
+  std::vector<std::pair<uint32_t, uint32_t>> pairs;
+  pairs.reserve(size * (2 * candidate_count + 1));
+  for (std::size_t rank = 0; rank < located.size(); ++rank) {
+    for (std::size_t index = 0; index < candidate_count; ++index) {
+      const uint32_t neighbor = located[neighbors[rank * candidate_count + index]];
+      if (neighbor != located[rank]) {
+        pairs.emplace_back(located[rank], neighbor);
+        pairs.emplace_back(neighbor, located[rank]);
+      }
+    }
+  }
+  for (std::size_t gifter = 0; gifter < size; ++gifter) {
+    pairs.emplace_back(static_cast<uint32_t>(gifter), successors[gifter]);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+  AssignmentCandidates candidates;
+  candidates.columns.reserve(pairs.size());
+  candidates.costs.reserve(pairs.size());
+  std::size_t position = 0;
+  for (std::size_t gifter = 0; gifter < size; ++gifter) {
+    for (; position < pairs.size() && pairs[position].first == gifter; ++position) {
+      candidates.Add(pairs[position].second, cost(pairs[position].first, pairs[position].second));
+    }
+    candidates.EndRow();
+  }
+
+  int64_t maximum_cost = std::numeric_limits<int64_t>::max();
+  if (options.objective == DistanceObjective::Maximum) {
+    maximum_cost = FindBottleneckCost(candidates).value_or(maximum_cost);
+  }
+  result.giftees = SolveAssignment(candidates, options.thread_count, maximum_cost);
+
+  for (std::size_t gifter = 0; gifter < size; ++gifter) {
+    const uint32_t giftee = result.giftees[gifter];
+    if (locations[gifter].has_value() && locations[giftee].has_value()) {
+      const double kilometers = GreatCircleDistance(positions[gifter], positions[giftee]);
+      result.total_kilometers += kilometers;
+      result.maximum_kilometers = std::max(result.maximum_kilometers, kilometers);
+    }
+  }
+  return result;
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_DISTANCE_MATCHING_HPP
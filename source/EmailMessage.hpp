@@ -0,0 +1,140 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_EMAIL_MESSAGE_HPP
+#define SECRET_SANTA_EMAIL_MESSAGE_HPP
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SecretSanta {
+
+// File attached to an email message.
+struct EmailAttachment {
+  // Name of the file, as shown to the recipient.
+  std::string file_name;
+
+  // MIME content type of the file, such as "text/calendar".
+  std::string content_type;
+
+  // Contents of the file.
+  std::string data;
+
+  // Encoded MIME part of the file, with its header fields, or an empty string if it is encoded each
+  // time an email message is composed. A file attached to many email messages is encoded once.
+  std::string encoded_part;
+};
+
+// Fully composed email message addressed to one gifter, ready to be handed to a transport.
+class EmailMessage {
+public:
+  // Default constructor. Constructs an empty email message.
+  EmailMessage() = default;
+
+  // Constructor. Constructs an email message to a given gifter from its recipient email address,
+  // subject, and body.
+  EmailMessage(std::string gifter_name, std::string recipient, std::string subject,
+               std::string body)
+    : gifter_name_(std::move(gifter_name)), recipient_(std::move(recipient)),
+      subject_(std::move(subject)), body_(std::move(body)) {}
+
+  // Destructor. Destroys this email message.
+  ~EmailMessage() noexcept = default;
+
+  // Copy constructor. Constructs an email message by copying another one.
+  EmailMessage(const EmailMessage& other) = default;
+
+  // Move constructor. Constructs an email message by moving another one.
+  EmailMessage(EmailMessage&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this email message by copying another one.
+  EmailMessage& operator=(const EmailMessage& other) = default;
+
+  // Move assignment operator. Assigns this email message by moving another one.
+  EmailMessage& operator=(EmailMessage&& other) noexcept = default;
+
+  // Name of the gifter to whom this email message is addressed.
+  [[nodiscard]] const std::string& GifterName() const noexcept {
+    return gifter_name_;
+  }
+
+  // Email address of the recipient of this email message.
+  [[nodiscard]] const std::string& Recipient() const noexcept {
+    return recipient_;
+  }
+
+  // Subject of this email message.
+  [[nodiscard]] const std::string& Subject() const noexcept {
+    return subject_;
+  }
+
+  // Body of this email message, as plain text.
+  [[nodiscard]] const std::string& Body() const noexcept {
+    return body_;
+  }
+
+  // Alternative body of this email message, as HTML, or an empty string if there is none.
+  [[nodiscard]] const std::string& Html() const noexcept {
+    return html_;
+  }
+
+  // Files attached to this email message. A file attached to several email messages is shared
+  // among them rather than copied.
+  [[nodiscard]] const std::vector<std::shared_ptr<const EmailAttachment>>&
+  Attachments() const noexcept {
+    return attachments_;
+  }
+
+  // Sets the alternative body of this email message, as HTML.
+  void SetHtml(std::string html) {
+    html_ = std::move(html);
+  }
+
+  // Attaches a file to this email message.
+  void Attach(std::shared_ptr<const EmailAttachment> attachment) {
+    attachments_.push_back(std::move(attachment));
+  }
+
+private:
+  // Name of the gifter to whom this email message is addressed.
+  std::string gifter_name_;
+
+  // Email address of the recipient of this email message.
+  std::string recipient_;
+
+  // Subject of this email message.
+  std::string subject_;
+
+  // Body of this email message, as plain text.
+  std::string body_;
+
+  // Alternative body of this email message, as HTML, or an empty string if there is none.
+  std::string html_;
+
+  // Files attached to this email message. A file attached to several email messages is shared
+  // among them rather than copied.
+  std::vector<std::shared_ptr<const EmailAttachment>> attachments_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_EMAIL_MESSAGE_HPP
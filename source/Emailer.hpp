@@ -21,71 +21,129 @@
 #ifndef SECRET_SANTA_MESSENGER_EMAILER_HPP
 #define SECRET_SANTA_MESSENGER_EMAILER_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BoundedQueue.hpp"
 #include "Configuration.hpp"
+#include "EmailMessage.hpp"
 #include "Matchings.hpp"
+#include "SNailTransport.hpp"
+#include "Spool.hpp"
+#include "Transport.hpp"
 
 namespace SecretSanta {
 
 // Composes the full email message body for a given gifter. Prefixes a brief greeting to the given
-// main message body and appends the giftee information.
+// main message body and appends the information of each giftee, such that a gifter with several
+// giftees receives one message that lists all of them.
 [[nodiscard]] std::string ComposeFullMessageBody(
-    const Participant& gifter, const Participant& giftee, const std::string& main_message_body) {
+    const Participant& gifter, const std::vector<const Participant*>& giftees,
+    const std::string& main_message_body) {
   std::string text;
 
   text.append("Hello " + gifter.Name() + ",\n\n");
 
   text.append(main_message_body + "\n\n");
 
-  text.append("Your giftee is: " + giftee.Name() + "\n\n");
-
-  text.append("Mail to:\n\n");
-  text.append(giftee.Name() + " SECRET SANTA\n");
-  if (!giftee.Address().empty()) {
-    text.append(giftee.Address() + "\n");
+  if (giftees.size() == 1) {
+    text.append("Your giftee is: " + giftees.front()->Name() + "\n\n");
+  } else {
+    text.append("Your " + std::to_string(giftees.size()) + " giftees are: ");
+    for (std::size_t index = 0; index < giftees.size(); ++index) {
+      if (index > 0) {
+        text.append(index + 1 < giftees.size() ? ", " : " and ");
+      }
+      text.append(giftees[index]->Name());
+    }
+    text.append("\n\n");
   }
-  if (!giftee.Instructions().empty()) {
-    text.append("Special Instructions: " + giftee.Instructions() + "\n");
+
+  for (std::size_t index = 0; index < giftees.size(); ++index) {
+    const Participant& giftee = *giftees[index];
+    if (index > 0) {
+      text.append("\n");
+    }
+    text.append("Mail to:\n\n");
+    text.append(giftee.Name() + " SECRET SANTA\n");
+    if (!giftee.Address().empty()) {
+      text.append(giftee.Address() + "\n");
+    }
+    if (!giftee.Instructions().empty()) {
+      text.append("Special Instructions: " + giftee.Instructions() + "\n");
+    }
   }
 
   text.append("\nThank you!");
   return text;
 }
 
-// Composes the command used to invoke the S-nail utility for a given gifter.
-[[nodiscard]] std::string ComposeCommand(
-    const Participant& gifter, const std::string& message_subject,
-    const std::string& message_body) {
-  return "echo \"" + message_body + "\" | s-nail --subject \"" + message_subject + "\" "
-         + gifter.Email();
+// Composes the full email message body for a given gifter who has one giftee.
+[[nodiscard]] std::string ComposeFullMessageBody(
+    const Participant& gifter, const Participant& giftee, const std::string& main_message_body) {
+  return ComposeFullMessageBody(
+      gifter, std::vector<const Participant*>{&giftee}, main_message_body);
 }
 
-// Composes and sends an email message to a given gifter. Creates the full body of the message and
-// sends it using the S-nail utility.
-void ComposeAndSendEmailMessage(
-    const Participant& gifter, const Participant& giftee, const std::string& message_subject,
-    const std::string& main_message_body) {
-  const std::string full_message_body = ComposeFullMessageBody(gifter, giftee, main_message_body);
-
-  const std::string command{ComposeCommand(gifter, message_subject, full_message_body)};
+// Composes the full email message for a given gifter and their giftees, addressed to the gifter's
+// email address.
+[[nodiscard]] EmailMessage ComposeEmailMessage(
+    const Participant& gifter, const std::vector<const Participant*>& giftees,
+    const std::string& message_subject, const std::string& main_message_body,
+    const std::shared_ptr<const EmailAttachment>& invite = nullptr) {
+  EmailMessage message{gifter.Name(), gifter.Email(), message_subject,
+                       ComposeFullMessageBody(gifter, giftees, main_message_body)};
+  if (invite != nullptr) {
+    message.Attach(invite);
+  }
+  return message;
+}
 
-  const int outcome{std::system(command.c_str())};
+// Composes the full email message for a given gifter who has one giftee, addressed to the gifter's
+// email address.
+[[nodiscard]] EmailMessage ComposeEmailMessage(
+    const Participant& gifter, const Participant& giftee, const std::string& message_subject,
+    const std::string& main_message_body,
+    const std::shared_ptr<const EmailAttachment>& invite = nullptr) {
+  return ComposeEmailMessage(gifter, std::vector<const Participant*>{&giftee}, message_subject,
+                             main_message_body, invite);
+}
 
-  if (outcome == 0) {
-    std::cout << "Sent an email message to " << gifter.Name() << " (" << gifter.Email() << ")."
-              << std::endl;
-  } else {
-    std::cout << "Could not run the command: " << command << std::endl;
+// Composes the calendar invitation to the event of a given configuration, encoded once so that it
+// is shared by every email message. Returns a null pointer if the configuration has no event.
+[[nodiscard]] std::shared_ptr<const EmailAttachment> ComposeInvite(
+    const Configuration& configuration) {
+  if (!configuration.Event().has_value()) {
+    return nullptr;
   }
+  return EncodeAttachment(
+      "invite.ics", "text/calendar",
+      ComposeICalendarInvite(configuration.Event().value(), configuration.MessageSubject(),
+                             std::time(nullptr)));
 }
 
-// Composes and sends email messages to all gifters.
-void ComposeAndSendEmailMessages(const Configuration& configuration, const Matchings& matchings) {
-  for (const Participant& gifter : configuration.Participants()) {
+// Finds the participants to whom a given gifter gifts according to given matchings, one per round
+// of gifts. Giftees who are not participants are left out. Returns an empty list if the gifter has
+// no giftee.
+[[nodiscard]] std::vector<const Participant*> FindGiftees(
+    const Configuration& configuration, const Matchings& matchings, const Participant& gifter) {
+  std::vector<const Participant*> giftees;
+  for (const std::map<std::string, std::string>& round : matchings.Rounds()) {
     // Obtain the gifter and giftee names.
     const std::map<std::string, std::string>::const_iterator gifter_name_and_giftee_name =
-        matchings.GiftersToGiftees().find(gifter.Name());
+        round.find(gifter.Name());
 
-    if (gifter_name_and_giftee_name == matchings.GiftersToGiftees().cend()) {
+    if (gifter_name_and_giftee_name == round.cend()) {
       continue;
     }
 
@@ -93,14 +151,251 @@ void ComposeAndSendEmailMessages(const Configuration& configuration, const Match
     const std::set<Participant>::const_iterator giftee =
         configuration.Participants().find(Participant{gifter_name_and_giftee_name->second});
 
-    if (giftee == configuration.Participants().cend()) {
+    if (giftee != configuration.Participants().cend()) {
+      giftees.push_back(&*giftee);
+    }
+  }
+  return giftees;
+}
+
+// Prints the outcome of the delivery of an email message to the console. Does not flush the
+// console, so that printing the outcomes of many deliveries does not cost one write each; the
+// summary printed after the deliveries flushes it.
+void PrintDelivery(const EmailMessage& message, const Delivery& delivery) {
+  if (delivery.Succeeded()) {
+    std::cout << "Sent an email message to " << message.GifterName() << " ("
+              << message.Recipient() << ").\n";
+  } else {
+    std::cout << "Could not send an email message to " << message.GifterName() << " ("
+              << message.Recipient() << "). " << delivery.Details() << "\n";
+  }
+}
+
+// Composes and sends an email message to a given gifter. Creates the full body of the message and
+// sends it using the S-nail utility.
+void ComposeAndSendEmailMessage(
+    const Participant& gifter, const Participant& giftee, const std::string& message_subject,
+    const std::string& main_message_body) {
+  SNailTransport transport;
+  transport.Send(ComposeEmailMessage(gifter, giftee, message_subject, main_message_body),
+                 PrintDelivery);
+}
+
+// Composes and sends email messages to all gifters through a given transport, or only to the given
+// gifters if any are given. Runs as a pipeline of three stages connected by bounded lock-free
+// queues, such that composing messages overlaps with waiting on the transport:
+// - Lookup: one thread joins each gifter with their giftees.
+// - Render: several threads compose the full email messages.
+// - Transport: the calling thread hands the email messages to the transport.
+// A full queue makes the upstream stage wait, so a slow transport throttles rendering rather than
+// letting composed messages pile up in memory. Prints a report of the occupancy of each stage and
+// queue at the end of the run, which tells which stage is the bottleneck.
+void ComposeAndSendEmailMessages(
+    const Configuration& configuration, const Matchings& matchings, Transport& transport,
+    const std::optional<std::set<std::string>>& gifter_names = std::nullopt) {
+  // Capacity of each queue between two stages.
+  constexpr std::size_t queue_capacity{256};
+
+  // Number of threads of the render stage.
+  const std::size_t render_thread_count{std::clamp<std::size_t>(
+      std::thread::hardware_concurrency() > 2 ? std::thread::hardware_concurrency() - 2 : 1, 1,
+      4)};
+
+  BoundedQueue<std::pair<const Participant*, std::vector<const Participant*>>> gifters_and_giftees{
+      queue_capacity};
+  BoundedQueue<EmailMessage> messages{queue_capacity};
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  // The calendar invitation is the same for every gifter, so it is encoded once and shared.
+  const std::shared_ptr<const EmailAttachment> invite{ComposeInvite(configuration)};
+
+  // Lookup stage: joins each gifter with their giftees.
+  std::thread lookup_thread{[&]() {
+    for (const Participant& gifter : configuration.Participants()) {
+      if (gifter_names.has_value() && gifter_names->count(gifter.Name()) == 0) {
+        continue;
+      }
+
+      std::vector<const Participant*> giftees = FindGiftees(configuration, matchings, gifter);
+
+      if (giftees.empty()) {
+        continue;
+      }
+
+      gifters_and_giftees.Push({&gifter, std::move(giftees)});
+    }
+    gifters_and_giftees.Close();
+  }};
+
+  // Render stage: composes the full email messages. The last render thread to finish closes the
+  // queue of email messages.
+  std::atomic<std::size_t> running_render_thread_count{render_thread_count};
+  std::vector<std::thread> render_threads;
+  for (std::size_t index = 0; index < render_thread_count; ++index) {
+    render_threads.emplace_back([&]() {
+      while (std::optional<std::pair<const Participant*, std::vector<const Participant*>>>
+                 gifter_and_giftees = gifters_and_giftees.Pop()) {
+        messages.Push(ComposeEmailMessage(*gifter_and_giftees->first, gifter_and_giftees->second,
+                                          configuration.MessageSubject(),
+                                          configuration.MessageBody(), invite));
+      }
+      if (running_render_thread_count.fetch_sub(1) == 1) {
+        messages.Close();
+      }
+    });
+  }
+
+  // Transport stage: hands the email messages to the transport. Completions may arrive from other
+  // threads, so printing is serialized.
+  std::mutex console_mutex;
+  std::atomic<std::size_t> delivered_count{0};
+  std::atomic<std::size_t> failed_count{0};
+  while (std::optional<EmailMessage> message = messages.Pop()) {
+    transport.Send(std::move(message.value()),
+                   [&](const EmailMessage& sent_message, const Delivery& delivery) {
+                     (delivery.Succeeded() ? delivered_count : failed_count).fetch_add(1);
+                     const std::lock_guard<std::mutex> lock{console_mutex};
+                     PrintDelivery(sent_message, delivery);
+                   });
+  }
+  transport.Flush();
+
+  lookup_thread.join();
+  for (std::thread& render_thread : render_threads) {
+    render_thread.join();
+  }
+
+  const double elapsed_seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const std::size_t message_count = delivered_count.load() + failed_count.load();
+
+  // Prints the fraction of the time that a stage spent working rather than waiting on a queue.
+  const std::function<void(const std::string&, std::size_t, double)> print_stage =
+      [&](const std::string& name, const std::size_t thread_count, const double wait_seconds) {
+        const double total_seconds = elapsed_seconds * static_cast<double>(thread_count);
+        const double busy_fraction =
+            total_seconds > 0.0 ? std::max(0.0, 1.0 - wait_seconds / total_seconds) : 0.0;
+        std::cout << "- " << name << " stage: " << thread_count << " threads, busy "
+                  << static_cast<int>(100.0 * busy_fraction + 0.5) << "% of the time."
+                  << std::endl;
+      };
+
+  // Prints the occupancy of a queue.
+  const std::function<void(const std::string&, std::size_t, double, std::size_t)> print_queue =
+      [&](const std::string& name, const std::size_t capacity, const double average_occupancy,
+          const std::size_t maximum_occupancy) {
+        std::cout << "- " << name << " queue: capacity " << capacity << ", average occupancy "
+                  << average_occupancy << ", maximum occupancy " << maximum_occupancy << "."
+                  << std::endl;
+      };
+
+  std::cout << "Sent " << delivered_count.load() << " of " << message_count
+            << " email messages through " << transport.Name() << " in " << elapsed_seconds
+            << " seconds (" << (elapsed_seconds > 0.0 ? message_count / elapsed_seconds : 0.0)
+            << " messages per second). Pipeline occupancy:" << std::endl;
+  print_stage("Lookup", 1, gifters_and_giftees.FullWaitSeconds());
+  print_stage("Render", render_thread_count,
+              gifters_and_giftees.EmptyWaitSeconds() + messages.FullWaitSeconds());
+  print_stage("Transport", 1, messages.EmptyWaitSeconds());
+  print_queue("Render", gifters_and_giftees.Capacity(), gifters_and_giftees.AverageOccupancy(),
+              gifters_and_giftees.MaximumOccupancy());
+  print_queue("Transport", messages.Capacity(), messages.AverageOccupancy(),
+              messages.MaximumOccupancy());
+}
+
+// Sends already composed email messages through a given transport, such as the email messages of a
+// dead-letter file that are sent again. Prints the outcome of each delivery and a summary.
+void SendEmailMessages(const std::vector<EmailMessage>& messages, Transport& transport) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  std::mutex console_mutex;
+  std::atomic<std::size_t> delivered_count{0};
+  for (const EmailMessage& message : messages) {
+    transport.Send(message, [&](const EmailMessage& sent_message, const Delivery& delivery) {
+      if (delivery.Succeeded()) {
+        delivered_count.fetch_add(1);
+      }
+      const std::lock_guard<std::mutex> lock{console_mutex};
+      PrintDelivery(sent_message, delivery);
+    });
+  }
+  transport.Flush();
+
+  const double elapsed_seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "Sent " << delivered_count.load() << " of " << messages.size()
+            << " email messages through " << transport.Name() << " in " << elapsed_seconds
+            << " seconds." << std::endl;
+}
+
+// Sends the email messages of a spool that were not yet sent through a given transport. Reads each
+// file only when its email message is about to be sent, so that a large spool is never held in
+// memory at once, and moves the file of each email message that is delivered out of the files
+// waiting to be sent. Prints the outcome of each delivery and a summary. Returns the number of
+// email messages that are still waiting to be sent.
+std::size_t SendSpooledEmailMessages(const Spool& spool, Transport& transport) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  const std::vector<std::filesystem::path> files{spool.Pending()};
+
+  std::mutex console_mutex;
+  std::atomic<std::size_t> delivered_count{0};
+  std::size_t unreadable_count = 0;
+  for (const std::filesystem::path& file : files) {
+    std::optional<EmailMessage> message{Spool::Read(file)};
+    if (!message.has_value()) {
+      ++unreadable_count;
+      const std::lock_guard<std::mutex> lock{console_mutex};
+      std::cout << "Could not read an email message from the spool file " << file << std::endl;
       continue;
     }
+    transport.Send(std::move(message.value()),
+                   [&, file](const EmailMessage& sent_message, const Delivery& delivery) {
+                     if (delivery.Succeeded() && spool.MarkSent(file)) {
+                       delivered_count.fetch_add(1);
+                     }
+                     const std::lock_guard<std::mutex> lock{console_mutex};
+                     PrintDelivery(sent_message, delivery);
+                   });
+  }
+  transport.Flush();
 
-    // Compose and send the email message to this gifter.
-    ComposeAndSendEmailMessage(
-        gifter, *giftee, configuration.MessageSubject(), configuration.MessageBody());
+  const double elapsed_seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "Sent " << delivered_count.load() << " of " << files.size()
+            << " spooled email messages through " << transport.Name() << " in "
+            << elapsed_seconds << " seconds." << std::endl;
+  if (unreadable_count > 0) {
+    std::cout << unreadable_count << " spool files could not be read." << std::endl;
   }
+  return files.size() - delivered_count.load();
+}
+
+// Writes given matchings to a given YAML file, and then composes and sends email messages to all
+// gifters through a given transport, or only to the given gifters if any are given. Sends nothing
+// if the matchings file cannot be written, so that no gifter is told of a giftee that is not on
+// record. Returns whether the matchings file was written.
+bool WriteMatchingsAndSendEmailMessages(
+    const Configuration& configuration, const Matchings& matchings,
+    const std::filesystem::path& matchings_path, Transport& transport,
+    const std::optional<std::set<std::string>>& gifter_names = std::nullopt) {
+  if (!matchings.Write(matchings_path)) {
+    std::cout << "Did not send any email message, since the matchings could not be written."
+              << std::endl;
+    return false;
+  }
+  ComposeAndSendEmailMessages(configuration, matchings, transport, gifter_names);
+  return true;
+}
+
+// Composes and sends email messages to all gifters using the S-nail utility, or only to the given
+// gifters if any are given.
+void ComposeAndSendEmailMessages(
+    const Configuration& configuration, const Matchings& matchings,
+    const std::optional<std::set<std::string>>& gifter_names = std::nullopt) {
+  SNailTransport transport;
+  ComposeAndSendEmailMessages(configuration, matchings, transport, gifter_names);
 }
 
 }  // namespace SecretSanta
@@ -0,0 +1,611 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_EVENT_LOOP_SMTP_TRANSPORT_HPP
+#define SECRET_SANTA_EVENT_LOOP_SMTP_TRANSPORT_HPP
+
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <netdb.h>
+#include <optional>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BoundedQueue.hpp"
+#include "Socket.hpp"
+#include "SmtpTransport.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Transport that delivers email messages directly to a mail server over SMTP, like the SMTP
+// transport, but multiplexes all of its connections on a few event loop threads instead of
+// dedicating one thread to each connection. Each event loop waits on its connections with epoll and
+// advances each connection through the SMTP conversation as its replies arrive, so that thousands
+// of connections cost little more than their socket buffers. Email messages are spread round-robin
+// among the event loops through bounded queues.
+class EventLoopSmtpTransport : public Transport {
+public:
+  // Constructor. Constructs a transport that delivers email messages from a given sender address to
+  // the mail server at a given host and port over a given number of connections, which are spread
+  // among a given number of event loop threads.
+  EventLoopSmtpTransport(std::string host, const uint16_t port, std::string sender,
+                         const std::size_t connection_count = 1, const std::size_t loop_count = 1)
+    : host_(std::move(host)), port_(port), sender_(std::move(sender)),
+      connection_count_(std::max<std::size_t>(connection_count, 1)) {
+    ResolveAddress();
+
+    const std::size_t count = std::min(std::max<std::size_t>(loop_count, 1), connection_count_);
+    for (std::size_t index = 0; index < count; ++index) {
+      loops_.push_back(std::make_unique<Loop>(2 * connection_count_ / count + 2));
+    }
+    for (std::size_t index = 0; index < connection_count_; ++index) {
+      loops_[index % count]->connections.push_back(std::make_unique<Connection>());
+    }
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      loop->thread = std::thread{[this, &event_loop = *loop]() { Run(event_loop); }};
+    }
+  }
+
+  // Destructor. Waits for all email messages to be delivered and closes all connections.
+  ~EventLoopSmtpTransport() noexcept override {
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      loop->jobs.Close();
+      Wake(*loop);
+    }
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      loop->thread.join();
+    }
+  }
+
+  // Deleted copy constructor.
+  EventLoopSmtpTransport(const EventLoopSmtpTransport& other) = delete;
+
+  // Deleted move constructor.
+  EventLoopSmtpTransport(EventLoopSmtpTransport&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  EventLoopSmtpTransport& operator=(const EventLoopSmtpTransport& other) = delete;
+
+  // Deleted move assignment operator.
+  EventLoopSmtpTransport& operator=(EventLoopSmtpTransport&& other) noexcept = delete;
+
+  [[nodiscard]] std::string Name() const override {
+    return "SMTP (" + host_ + ":" + std::to_string(port_) + ", "
+           + std::to_string(connection_count_) + " connections on "
+           + std::to_string(loops_.size()) + " event loops)";
+  }
+
+  void Send(EmailMessage message, Completion completion) override {
+    {
+      const std::lock_guard<std::mutex> lock{pending_mutex_};
+      ++pending_count_;
+    }
+    Loop& loop = *loops_[next_loop_++ % loops_.size()];
+    loop.jobs.Push({std::move(message), std::move(completion)});
+    Wake(loop);
+  }
+
+  void Flush() override {
+    std::unique_lock<std::mutex> lock{pending_mutex_};
+    pending_condition_.wait(lock, [this]() { return pending_count_ == 0; });
+  }
+
+private:
+  // Email message waiting to be delivered, along with its completion function.
+  using Job = std::pair<EmailMessage, Completion>;
+
+  // Stage of the SMTP conversation of a connection.
+  enum class Stage : int8_t {
+    // The connection is closed and is opened again when it is given an email message.
+    Disconnected,
+
+    // The connection is being established.
+    Connecting,
+
+    // Waiting for the greeting of the mail server.
+    Greeting,
+
+    // Waiting for the reply to the EHLO command.
+    Hello,
+
+    // Ready for an email message.
+    Idle,
+
+    // Waiting for the replies to the MAIL, RCPT, and DATA commands.
+    Envelope,
+
+    // Waiting for the reply to the contents of the email message.
+    Contents,
+
+    // Waiting for the reply to the RSET command that follows a failed envelope.
+    Reset,
+  };
+
+  // Connection to the mail server, along with the state of its SMTP conversation.
+  struct Connection {
+    // Non-blocking socket of this connection.
+    Socket socket;
+
+    // Stage of the SMTP conversation.
+    Stage stage{Stage::Disconnected};
+
+    // Whether the mail server supports pipelining.
+    bool pipelining{false};
+
+    // Whether the event loop waits for this connection to become writable.
+    bool watching_writes{false};
+
+    // Data received but not yet parsed into replies.
+    std::string input;
+
+    // Data waiting to be written.
+    std::string output;
+
+    // Position in the output at which the data not yet written starts.
+    std::size_t output_position{0};
+
+    // Text of each line of the reply being received, without its code.
+    std::vector<std::string> reply_lines;
+
+    // Email message being delivered, if any.
+    std::optional<Job> job;
+
+    // MAIL, RCPT, and DATA commands of the email message being delivered.
+    std::array<std::string, 3> envelope;
+
+    // Number of commands of the envelope sent so far.
+    std::size_t sent_envelope_count{0};
+
+    // Replies to the commands of the envelope received so far.
+    std::vector<SmtpReply> envelope_replies;
+  };
+
+  // Event loop thread along with the connections it serves and the email messages waiting for
+  // them.
+  struct Loop {
+    // Constructor. Constructs an event loop whose queue holds at least a given number of email
+    // messages.
+    explicit Loop(const std::size_t queue_capacity)
+      : epoll(::epoll_create1(EPOLL_CLOEXEC)), wake(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+        jobs(queue_capacity) {
+      epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.ptr = nullptr;
+      ::epoll_ctl(epoll.Descriptor(), EPOLL_CTL_ADD, wake.Descriptor(), &event);
+    }
+
+    // File descriptor of the epoll instance on which this event loop waits.
+    Socket epoll;
+
+    // File descriptor of the event that wakes up this event loop when it is given email messages.
+    Socket wake;
+
+    // Email messages waiting for a connection of this event loop.
+    BoundedQueue<Job> jobs;
+
+    // Connections served by this event loop.
+    std::vector<std::unique_ptr<Connection>> connections;
+
+    // Thread that runs this event loop.
+    std::thread thread;
+  };
+
+  // Resolves the address of the mail server once, so that reconnecting does not block the event
+  // loop on name resolution.
+  void ResolveAddress() {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (::getaddrinfo(host_.c_str(), std::to_string(port_).c_str(), &hints, &addresses) != 0
+        || addresses == nullptr) {
+      return;
+    }
+    std::memcpy(&address_, addresses->ai_addr, addresses->ai_addrlen);
+    address_length_ = addresses->ai_addrlen;
+    address_family_ = addresses->ai_family;
+    ::freeaddrinfo(addresses);
+  }
+
+  // Wakes up an event loop so that it picks up new email messages.
+  static void Wake(const Loop& loop) {
+    const uint64_t one = 1;
+    static_cast<void>(::write(loop.wake.Descriptor(), &one, sizeof(one)));
+  }
+
+  // Runs an event loop until its queue is closed and all of its email messages are delivered.
+  void Run(Loop& loop) {
+    std::array<epoll_event, 256> events{};
+    while (true) {
+      bool busy = false;
+      for (const std::unique_ptr<Connection>& connection : loop.connections) {
+        if (!connection->job.has_value() && connection->stage != Stage::Reset) {
+          std::optional<Job> job{loop.jobs.TryPop()};
+          if (job.has_value()) {
+            Start(loop, *connection, std::move(job.value()));
+          }
+        }
+        busy = busy || connection->job.has_value() || connection->stage == Stage::Reset;
+      }
+
+      if (!busy && loop.jobs.IsClosed() && loop.jobs.Size() == 0) {
+        break;
+      }
+
+      const int count = ::epoll_wait(
+          loop.epoll.Descriptor(), events.data(), static_cast<int>(events.size()), -1);
+      for (int index = 0; index < count; ++index) {
+        if (events[index].data.ptr == nullptr) {
+          uint64_t value = 0;
+          static_cast<void>(::read(loop.wake.Descriptor(), &value, sizeof(value)));
+          continue;
+        }
+        Connection& connection = *static_cast<Connection*>(events[index].data.ptr);
+        if (connection.stage == Stage::Connecting) {
+          FinishConnecting(loop, connection);
+          continue;
+        }
+        if ((events[index].events & EPOLLOUT) != 0U) {
+          Write(loop, connection);
+        }
+        if ((events[index].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0U
+            && connection.socket.IsOpen()) {
+          Read(loop, connection);
+        }
+      }
+    }
+
+    for (const std::unique_ptr<Connection>& connection : loop.connections) {
+      if (connection->stage == Stage::Idle) {
+        static_cast<void>(::send(
+            connection->socket.Descriptor(), "QUIT\r\n", 6, MSG_NOSIGNAL | MSG_DONTWAIT));
+      }
+    }
+  }
+
+  // Starts delivering an email message over a connection that has none, opening the connection
+  // first if needed.
+  void Start(Loop& loop, Connection& connection, Job job) {
+    connection.job = std::move(job);
+    connection.envelope = {"MAIL FROM:<" + sender_ + ">\r\n",
+                           "RCPT TO:<" + connection.job->first.Recipient() + ">\r\n", "DATA\r\n"};
+    connection.sent_envelope_count = 0;
+    connection.envelope_replies.clear();
+    if (connection.stage == Stage::Idle) {
+      SendEnvelope(loop, connection);
+    } else if (connection.stage == Stage::Disconnected) {
+      Connect(loop, connection);
+    }
+  }
+
+  // Starts opening a connection without waiting for it to be established.
+  void Connect(Loop& loop, Connection& connection) {
+    if (address_length_ == 0) {
+      Fail(loop, connection, "Could not resolve " + host_ + ".");
+      return;
+    }
+    connection.socket =
+        Socket{::socket(address_family_, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)};
+    if (!connection.socket.IsOpen()) {
+      Fail(loop, connection, "Could not create a socket.");
+      return;
+    }
+    const int enabled = 1;
+    ::setsockopt(
+        connection.socket.Descriptor(), IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+
+    const int outcome = ::connect(connection.socket.Descriptor(),
+                                  reinterpret_cast<const sockaddr*>(&address_), address_length_);
+    if (outcome != 0 && errno != EINPROGRESS) {
+      Fail(loop, connection,
+           "Could not connect to " + host_ + ":" + std::to_string(port_) + ".");
+      return;
+    }
+
+    connection.stage = Stage::Connecting;
+    connection.watching_writes = true;
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT;
+    event.data.ptr = &connection;
+    ::epoll_ctl(loop.epoll.Descriptor(), EPOLL_CTL_ADD, connection.socket.Descriptor(), &event);
+  }
+
+  // Checks whether a connection that was being established succeeded.
+  void FinishConnecting(Loop& loop, Connection& connection) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    ::getsockopt(connection.socket.Descriptor(), SOL_SOCKET, SO_ERROR, &error, &length);
+    if (error != 0) {
+      Fail(loop, connection,
+           "Could not connect to " + host_ + ":" + std::to_string(port_) + ".");
+      return;
+    }
+    connection.stage = Stage::Greeting;
+    WatchWrites(loop, connection, false);
+  }
+
+  // Starts or stops waiting for a connection to become writable.
+  static void WatchWrites(const Loop& loop, Connection& connection, const bool watch) {
+    if (connection.watching_writes == watch) {
+      return;
+    }
+    connection.watching_writes = watch;
+    epoll_event event{};
+    event.events = EPOLLIN | (watch ? EPOLLOUT : 0U);
+    event.data.ptr = &connection;
+    ::epoll_ctl(loop.epoll.Descriptor(), EPOLL_CTL_MOD, connection.socket.Descriptor(), &event);
+  }
+
+  // Queues text to be written to a connection and writes as much of it as possible.
+  void Queue(Loop& loop, Connection& connection, const std::string& text) {
+    connection.output.append(text);
+    Write(loop, connection);
+  }
+
+  // Writes as much of the queued output of a connection as possible without waiting, and waits
+  // for the connection to become writable if some output remains.
+  void Write(Loop& loop, Connection& connection) {
+    while (connection.output_position < connection.output.size()) {
+      const ssize_t written =
+          ::send(connection.socket.Descriptor(),
+                 connection.output.data() + connection.output_position,
+                 connection.output.size() - connection.output_position, MSG_NOSIGNAL);
+      if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        WatchWrites(loop, connection, true);
+        return;
+      }
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      if (written <= 0) {
+        Fail(loop, connection, "Lost the connection to the mail server.");
+        return;
+      }
+      connection.output_position += static_cast<std::size_t>(written);
+    }
+    connection.output.clear();
+    connection.output_position = 0;
+    WatchWrites(loop, connection, false);
+  }
+
+  // Reads everything available on a connection without waiting and handles each complete reply.
+  void Read(Loop& loop, Connection& connection) {
+    char chunk[16384];
+    while (true) {
+      const ssize_t count = ::recv(connection.socket.Descriptor(), chunk, sizeof(chunk), 0);
+      if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        break;
+      }
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        Fail(loop, connection, "Lost the connection to the mail server.");
+        return;
+      }
+      connection.input.append(chunk, static_cast<std::size_t>(count));
+    }
+
+    std::size_t position = 0;
+    while (connection.socket.IsOpen()) {
+      const std::size_t line_feed = connection.input.find('\n', position);
+      if (line_feed == std::string::npos) {
+        break;
+      }
+      std::size_t end = line_feed;
+      if (end > position && connection.input[end - 1] == '\r') {
+        --end;
+      }
+      const std::string line{connection.input, position, end - position};
+      position = line_feed + 1;
+
+      if (line.size() < 3 || line.find_first_not_of("0123456789") < 3) {
+        Fail(loop, connection, "The mail server sent a malformed reply: " + line);
+        return;
+      }
+      connection.reply_lines.push_back(line.size() > 4 ? line.substr(4) : std::string{});
+      if (line.size() == 3 || line[3] != '-') {
+        Handle(loop, connection, SmtpReply{std::stoi(line.substr(0, 3)), line});
+        connection.reply_lines.clear();
+      }
+    }
+    if (connection.socket.IsOpen()) {
+      connection.input.erase(0, position);
+    }
+  }
+
+  // Advances the SMTP conversation of a connection after one reply.
+  void Handle(Loop& loop, Connection& connection, const SmtpReply& reply) {
+    switch (connection.stage) {
+      case Stage::Greeting:
+        if (reply.Code() != 220) {
+          Fail(loop, connection, "The mail server refused the connection: " + reply.Text());
+          return;
+        }
+        connection.stage = Stage::Hello;
+        Queue(loop, connection, "EHLO localhost\r\n");
+        return;
+      case Stage::Hello:
+        if (reply.Code() != 250) {
+          Fail(loop, connection, "The mail server did not accept the greeting: " + reply.Text());
+          return;
+        }
+        connection.pipelining = false;
+        for (const std::string& extension : connection.reply_lines) {
+          connection.pipelining = connection.pipelining || extension == "PIPELINING";
+        }
+        connection.stage = Stage::Idle;
+        if (connection.job.has_value()) {
+          SendEnvelope(loop, connection);
+        }
+        return;
+      case Stage::Envelope:
+        connection.envelope_replies.push_back(reply);
+        if (!connection.pipelining && reply.Succeeded()
+            && connection.sent_envelope_count < connection.envelope.size()) {
+          Queue(loop, connection, connection.envelope[connection.sent_envelope_count++]);
+          return;
+        }
+        if (connection.envelope_replies.size() == connection.sent_envelope_count) {
+          FinishEnvelope(loop, connection);
+        }
+        return;
+      case Stage::Contents:
+        connection.stage = Stage::Idle;
+        Complete(connection, reply.Succeeded() ?
+                                 Delivery{DeliveryStatus::Delivered, reply.Text()} :
+                                 Delivery{reply.FailureStatus(), reply.Text()});
+        return;
+      case Stage::Reset:
+        if (reply.Code() == 250) {
+          connection.stage = Stage::Idle;
+        } else {
+          Disconnect(loop, connection);
+        }
+        return;
+      default:
+        return;
+    }
+  }
+
+  // Sends the envelope of the email message of a connection: all three commands at once if the
+  // mail server supports pipelining, or only the first one otherwise.
+  void SendEnvelope(Loop& loop, Connection& connection) {
+    connection.stage = Stage::Envelope;
+    if (connection.pipelining) {
+      connection.sent_envelope_count = connection.envelope.size();
+      Queue(loop, connection,
+            connection.envelope[0] + connection.envelope[1] + connection.envelope[2]);
+    } else {
+      connection.sent_envelope_count = 1;
+      Queue(loop, connection, connection.envelope[0]);
+    }
+  }
+
+  // Sends the contents of the email message of a connection if its envelope was accepted, or
+  // completes its delivery with the first failure and resets the transaction otherwise.
+  void FinishEnvelope(Loop& loop, Connection& connection) {
+    if (connection.envelope_replies.size() == connection.envelope.size()
+        && connection.envelope_replies.back().Code() == 354) {
+      connection.stage = Stage::Contents;
+      Queue(loop, connection, ComposeSmtpContents(sender_, connection.job->first));
+      return;
+    }
+
+    SmtpReply failure{connection.envelope_replies.back()};
+    for (const SmtpReply& reply : connection.envelope_replies) {
+      if (!reply.Succeeded()) {
+        failure = reply;
+        break;
+      }
+    }
+    connection.stage = Stage::Reset;
+    Complete(connection, Delivery{failure.FailureStatus(), failure.Text()});
+    Queue(loop, connection, "RSET\r\n");
+  }
+
+  // Completes the delivery of the email message of a connection with a given outcome.
+  void Complete(Connection& connection, const Delivery& delivery) {
+    const Job job{std::move(connection.job.value())};
+    connection.job.reset();
+    job.second(job.first, delivery);
+
+    const std::lock_guard<std::mutex> lock{pending_mutex_};
+    if (--pending_count_ == 0) {
+      pending_condition_.notify_all();
+    }
+  }
+
+  // Closes a connection that failed and completes the delivery of its email message, if any, with a
+  // transient failure.
+  void Fail(Loop& loop, Connection& connection, const std::string& details) {
+    Disconnect(loop, connection);
+    if (connection.job.has_value()) {
+      Complete(connection, Delivery{DeliveryStatus::TransientFailure, details});
+    }
+  }
+
+  // Closes a connection and forgets the state of its SMTP conversation.
+  static void Disconnect(const Loop& loop, Connection& connection) {
+    if (connection.socket.IsOpen()) {
+      ::epoll_ctl(
+          loop.epoll.Descriptor(), EPOLL_CTL_DEL, connection.socket.Descriptor(), nullptr);
+      connection.socket.Close();
+    }
+    connection.stage = Stage::Disconnected;
+    connection.watching_writes = false;
+    connection.input.clear();
+    connection.output.clear();
+    connection.output_position = 0;
+    connection.reply_lines.clear();
+  }
+
+  // Host name or address of the mail server.
+  std::string host_;
+
+  // Port of the mail server.
+  uint16_t port_;
+
+  // Email address from which email messages are sent.
+  std::string sender_;
+
+  // Number of connections to the mail server.
+  std::size_t connection_count_;
+
+  // Resolved address of the mail server.
+  sockaddr_storage address_{};
+
+  // Length of the resolved address of the mail server, or 0 if it could not be resolved.
+  socklen_t address_length_{0};
+
+  // Address family of the resolved address of the mail server.
+  int address_family_{AF_INET};
+
+  // Event loops, each of which serves some of the connections.
+  std::vector<std::unique_ptr<Loop>> loops_;
+
+  // Index of the event loop to which the next email message is given.
+  std::size_t next_loop_{0};
+
+  // Protects the number of email messages whose delivery has not yet completed.
+  std::mutex pending_mutex_;
+
+  // Notified when all deliveries have completed.
+  std::condition_variable pending_condition_;
+
+  // Number of email messages whose delivery has not yet completed.
+  std::size_t pending_count_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_EVENT_LOOP_SMTP_TRANSPORT_HPP
@@ -0,0 +1,130 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_EXECUTOR_HPP
+#define SECRET_SANTA_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace SecretSanta {
+
+// Runs pieces of work, such as resuming a coroutine once the operation it awaits completes. Lets
+// the caller decide on which thread coroutines resume: an application with its own event loop can
+// implement this interface on top of that event loop.
+class Executor {
+public:
+  // Default constructor. Constructs an executor.
+  Executor() = default;
+
+  // Destructor. Destroys this executor.
+  virtual ~Executor() noexcept = default;
+
+  // Deleted copy constructor.
+  Executor(const Executor& other) = delete;
+
+  // Deleted move constructor.
+  Executor(Executor&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  Executor& operator=(const Executor& other) = delete;
+
+  // Deleted move assignment operator.
+  Executor& operator=(Executor&& other) noexcept = delete;
+
+  // Schedules a piece of work to be run. May be called from any thread.
+  virtual void Post(std::function<void()> work) = 0;
+};
+
+// Executor that runs each piece of work immediately on the thread that posts it. Coroutines then
+// resume on whichever thread completes the operation they await, such as a transport's thread.
+class InlineExecutor : public Executor {
+public:
+  // Default constructor. Constructs an inline executor.
+  InlineExecutor() = default;
+
+  // Destructor. Destroys this inline executor.
+  ~InlineExecutor() noexcept override = default;
+
+  void Post(std::function<void()> work) override {
+    work();
+  }
+};
+
+// Executor that queues each piece of work until the thread that owns it runs the queue. Coroutines
+// then always resume on that one thread, so they need no synchronization among themselves.
+class QueueExecutor : public Executor {
+public:
+  // Default constructor. Constructs a queue executor with an empty queue.
+  QueueExecutor() = default;
+
+  // Destructor. Destroys this queue executor and any work still in its queue.
+  ~QueueExecutor() noexcept override = default;
+
+  void Post(std::function<void()> work) override {
+    // Notify while holding the lock, so that the owning thread cannot run the work and destroy
+    // this executor before the notification is done.
+    const std::lock_guard<std::mutex> lock{mutex_};
+    queue_.push_back(std::move(work));
+    condition_.notify_one();
+  }
+
+  // Waits until at least one piece of work is queued and runs the first one.
+  void RunOne() {
+    std::function<void()> work;
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      condition_.wait(lock, [this]() { return !queue_.empty(); });
+      work = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    work();
+  }
+
+  // Runs the work already queued without waiting for more. Returns the number of pieces of work
+  // that were run.
+  std::size_t RunPending() {
+    std::deque<std::function<void()>> pending;
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      pending.swap(queue_);
+    }
+    for (std::function<void()>& work : pending) {
+      work();
+    }
+    return pending.size();
+  }
+
+private:
+  // Protects the queue.
+  std::mutex mutex_;
+
+  // Notified when work is queued.
+  std::condition_variable condition_;
+
+  // Work waiting to be run.
+  std::deque<std::function<void()>> queue_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_EXECUTOR_HPP
@@ -0,0 +1,186 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_FILE_CACHE_HPP
+#define SECRET_SANTA_FILE_CACHE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <sys/stat.h>
+#include <unordered_map>
+
+namespace SecretSanta {
+
+// Cache of objects read from files, such as parsed YAML configuration files, keyed by file path.
+// Each object is constructed from the path of its file, and is read again only once the file's
+// modification time, size, or inode changes, so that a long-running process picks up edits without
+// parsing unchanged files over and over. Objects are immutable and shared, so that a caller keeps
+// using an object even if it is replaced in the meantime. Safe to use from several threads at once.
+template <typename Value>
+class FileCache {
+public:
+  // Constructor. Constructs an empty cache that holds the objects of at most a given number of
+  // files.
+  explicit FileCache(const std::size_t capacity = 1024)
+    : capacity_(std::max<std::size_t>(capacity, 1)) {}
+
+  // Destructor. Destroys this cache and releases its objects.
+  ~FileCache() noexcept = default;
+
+  // Deleted copy constructor.
+  FileCache(const FileCache& other) = delete;
+
+  // Deleted move constructor.
+  FileCache(FileCache&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  FileCache& operator=(const FileCache& other) = delete;
+
+  // Deleted move assignment operator.
+  FileCache& operator=(FileCache&& other) noexcept = delete;
+
+  // Returns the object read from a given file, reading the file if it is not cached or if it
+  // changed since it was read. Returns null if the file does not exist. Any exception thrown while
+  // reading the file is passed on to the caller, and nothing is cached.
+  [[nodiscard]] std::shared_ptr<const Value> Get(const std::filesystem::path& path) {
+    const std::optional<Stamp> stamp = ReadStamp(path);
+    if (!stamp.has_value()) {
+      return nullptr;
+    }
+
+    {
+      const std::shared_lock<std::shared_mutex> lock{mutex_};
+      const typename std::unordered_map<std::string, Entry>::const_iterator found =
+          entries_.find(path.string());
+      if (found != entries_.end() && found->second.stamp == stamp.value()) {
+        hit_count_.fetch_add(1, std::memory_order_relaxed);
+        return found->second.value;
+      }
+    }
+
+    // Read the file without holding the lock, so that other files can be looked up meanwhile. Two
+    // threads that miss the same file at once both read it, which is harmless.
+    miss_count_.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<const Value> value = std::make_shared<const Value>(path);
+    Store(path, stamp.value(), value);
+    return value;
+  }
+
+  // Stores an object that was just written to a given file, such that it is not read back from the
+  // file the next time it is needed. Does nothing if the file does not exist.
+  void Put(const std::filesystem::path& path, std::shared_ptr<const Value> value) {
+    const std::optional<Stamp> stamp = ReadStamp(path);
+    if (stamp.has_value()) {
+      Store(path, stamp.value(), std::move(value));
+    }
+  }
+
+  // Number of files whose objects are cached.
+  [[nodiscard]] std::size_t Size() const {
+    const std::shared_lock<std::shared_mutex> lock{mutex_};
+    return entries_.size();
+  }
+
+  // Number of lookups so far that found an up-to-date object in this cache.
+  [[nodiscard]] uint64_t HitCount() const noexcept {
+    return hit_count_.load(std::memory_order_relaxed);
+  }
+
+  // Number of lookups so far that had to read a file.
+  [[nodiscard]] uint64_t MissCount() const noexcept {
+    return miss_count_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Identifies one version of a file.
+  struct Stamp {
+    // Inode number of the file, which changes when the file is replaced by renaming another one.
+    uint64_t inode{0};
+
+    // Size of the file in bytes.
+    int64_t size{0};
+
+    // Modification time of the file in nanoseconds since the epoch.
+    int64_t modified{0};
+
+    inline bool operator==(const Stamp& other) const noexcept {
+      return inode == other.inode && size == other.size && modified == other.modified;
+    }
+  };
+
+  // Cached object of one file, along with the version of the file from which it was read.
+  struct Entry {
+    // Version of the file from which the object was read.
+    Stamp stamp;
+
+    // Object read from the file.
+    std::shared_ptr<const Value> value;
+  };
+
+  // Reads the version of a given file with one system call. Returns nothing if the file does not
+  // exist.
+  [[nodiscard]] static std::optional<Stamp> ReadStamp(const std::filesystem::path& path) {
+    struct stat status {};
+    if (::stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode)) {
+      return std::nullopt;
+    }
+    return Stamp{static_cast<uint64_t>(status.st_ino), static_cast<int64_t>(status.st_size),
+                 static_cast<int64_t>(status.st_mtim.tv_sec) * 1'000'000'000
+                     + static_cast<int64_t>(status.st_mtim.tv_nsec)};
+  }
+
+  // Stores the object of a given version of a given file, evicting another file if this cache is
+  // full.
+  void Store(const std::filesystem::path& path, const Stamp& stamp,
+             std::shared_ptr<const Value> value) {
+    const std::unique_lock<std::shared_mutex> lock{mutex_};
+    std::string key = path.string();
+    if (entries_.size() >= capacity_ && entries_.count(key) == 0) {
+      entries_.erase(entries_.begin());
+    }
+    entries_.insert_or_assign(std::move(key), Entry{stamp, std::move(value)});
+  }
+
+  // Maximum number of files whose objects are cached.
+  std::size_t capacity_;
+
+  // Protects the entries.
+  mutable std::shared_mutex mutex_;
+
+  // Cached objects, keyed by the paths of their files.
+  std::unordered_map<std::string, Entry> entries_;
+
+  // Number of lookups so far that found an up-to-date object.
+  std::atomic<uint64_t> hit_count_{0};
+
+  // Number of lookups so far that had to read a file.
+  std::atomic<uint64_t> miss_count_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_FILE_CACHE_HPP
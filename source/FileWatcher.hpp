@@ -0,0 +1,157 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_FILE_WATCHER_HPP
+#define SECRET_SANTA_FILE_WATCHER_HPP
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <poll.h>
+#include <string>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace SecretSanta {
+
+// Watches a file for changes with inotify. The directory of the file is watched rather than the
+// file itself, since many editors save a file by writing a new file and renaming it over the old
+// one, which replaces the inode that a watch on the file itself would follow.
+class FileWatcher {
+public:
+  // Constructor. Starts watching a given file. The file need not exist yet, but its directory must.
+  explicit FileWatcher(const std::filesystem::path& path)
+    : name_(path.filename().string()), descriptor_(inotify_init1(IN_CLOEXEC | IN_NONBLOCK)) {
+    if (descriptor_ < 0) {
+      return;
+    }
+
+    const std::filesystem::path directory{
+        path.has_parent_path() ? path.parent_path() : std::filesystem::path{"."}};
+    if (inotify_add_watch(descriptor_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+      close(descriptor_);
+      descriptor_ = -1;
+    }
+  }
+
+  // Destructor. Stops watching the file.
+  ~FileWatcher() noexcept {
+    if (descriptor_ >= 0) {
+      close(descriptor_);
+    }
+  }
+
+  // Deleted copy constructor.
+  FileWatcher(const FileWatcher& other) = delete;
+
+  // Deleted move constructor.
+  FileWatcher(FileWatcher&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  FileWatcher& operator=(const FileWatcher& other) = delete;
+
+  // Deleted move assignment operator.
+  FileWatcher& operator=(FileWatcher&& other) noexcept = delete;
+
+  // Whether the file is being watched. False if inotify is unavailable or if the directory of the
+  // file cannot be watched, such as when it does not exist.
+  [[nodiscard]] bool IsValid() const noexcept {
+    return descriptor_ >= 0;
+  }
+
+  // Waits until the file is written or replaced, or until a given timeout elapses, whichever comes
+  // first. Returns whether the file changed. Changes in quick succession, such as an editor saving
+  // a file in several steps, are reported once: after a change, further changes are collected
+  // until none occurs for a given settling time.
+  bool Wait(const std::chrono::milliseconds timeout,
+            const std::chrono::milliseconds settling = std::chrono::milliseconds{20}) {
+    if (descriptor_ < 0) {
+      return false;
+    }
+
+    const std::chrono::steady_clock::time_point deadline{
+        std::chrono::steady_clock::now() + timeout};
+    bool changed{false};
+    while (!changed) {
+      const std::chrono::milliseconds remaining{
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              deadline - std::chrono::steady_clock::now())};
+      if (remaining.count() < 0 || !Poll(remaining)) {
+        return false;
+      }
+      changed = ReadEvents();
+    }
+
+    while (Poll(settling)) {
+      static_cast<void>(ReadEvents());
+    }
+    return true;
+  }
+
+private:
+  // Waits until events are ready to be read or until a given timeout elapses. Returns whether
+  // events are ready.
+  [[nodiscard]] bool Poll(const std::chrono::milliseconds timeout) const {
+    pollfd descriptor{descriptor_, POLLIN, 0};
+    int result;
+    do {
+      result = poll(&descriptor, 1, static_cast<int>(timeout.count()));
+    } while (result < 0 && errno == EINTR);
+    return result > 0;
+  }
+
+  // Reads all pending events. Returns whether any of them concerns the watched file rather than
+  // another file of its directory.
+  bool ReadEvents() {
+    bool concerned{false};
+    while (true) {
+      const ssize_t length{read(descriptor_, buffer_.data(), buffer_.size())};
+      if (length <= 0) {
+        return concerned;
+      }
+
+      for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);) {
+        inotify_event event;
+        std::memcpy(&event, buffer_.data() + offset, sizeof(inotify_event));
+        if (event.len > 0 && name_ == buffer_.data() + offset + sizeof(inotify_event)) {
+          concerned = true;
+        }
+        offset += sizeof(inotify_event) + event.len;
+      }
+    }
+  }
+
+  // Name of the watched file within its directory.
+  std::string name_;
+
+  // File descriptor of the inotify instance, or -1 if the file is not being watched.
+  int descriptor_{-1};
+
+  // Buffer into which events are read. Each event holds the name of a file, which is at most
+  // NAME_MAX characters long and null-terminated.
+  std::array<char, 64 * (sizeof(inotify_event) + 256)> buffer_{};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_FILE_WATCHER_HPP
@@ -0,0 +1,332 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_GEOGRAPHY_HPP
+#define SECRET_SANTA_GEOGRAPHY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SecretSanta {
+
+// Mean radius of the Earth in kilometers.
+constexpr double EarthRadiusKilometers{6371.0};
+
+// Geographic coordinates of a point on the Earth, in degrees.
+struct Coordinates {
+  // Latitude in degrees, from -90 at the South Pole to 90 at the North Pole.
+  double latitude{0.0};
+
+  // Longitude in degrees, from -180 to 180, positive east of the prime meridian.
+  double longitude{0.0};
+};
+
+// Parses geographic coordinates written as a latitude and a longitude in degrees separated by a
+// comma, such as "37.7749, -122.4194". Returns no value if the text is not such coordinates or if
+// they are out of range.
+[[nodiscard]] std::optional<Coordinates> ParseCoordinates(const std::string_view text) {
+  const std::string copy{text};
+  const std::size_t comma = copy.find(',');
+  if (comma == std::string::npos) {
+    return std::nullopt;
+  }
+
+  // Parses a number that spans a whole given part of the text, save for surrounding spaces.
+  const std::function<std::optional<double>(const std::string&)> parse =
+      [](const std::string& part) -> std::optional<double> {
+    const char* const begin = part.c_str();
+    char* end = nullptr;
+    const double value = std::strtod(begin, &end);
+    if (end == begin || part.find_first_not_of(' ', static_cast<std::size_t>(end - begin))
+                            != std::string::npos) {
+      return std::nullopt;
+    }
+    return value;
+  };
+
+  const std::optional<double> latitude = parse(copy.substr(0, comma));
+  const std::optional<double> longitude = parse(copy.substr(comma + 1));
+  if (!latitude.has_value() || !longitude.has_value() || !std::isfinite(latitude.value())
+      || !std::isfinite(longitude.value()) || std::abs(latitude.value()) > 90.0
+      || std::abs(longitude.value()) > 180.0) {
+    return std::nullopt;
+  }
+  return Coordinates{latitude.value(), longitude.value()};
+}
+
+// Position of given coordinates on the unit sphere, in Cartesian coordinates. The straight-line
+// distance between two such positions grows with the great-circle distance between their
+// coordinates, so nearest neighbors can be found with straight-line distances.
+[[nodiscard]] std::array<double, 3> UnitSpherePosition(const Coordinates& coordinates) {
+  constexpr double radians_per_degree{M_PI / 180.0};
+  const double latitude = coordinates.latitude * radians_per_degree;
+  const double longitude = coordinates.longitude * radians_per_degree;
+  return {std::cos(latitude) * std::cos(longitude), std::cos(latitude) * std::sin(longitude),
+          std::sin(latitude)};
+}
+
+// Great-circle distance in kilometers between two positions on the unit sphere.
+[[nodiscard]] double GreatCircleDistance(
+    const std::array<double, 3>& first, const std::array<double, 3>& second) {
+  const double dx = first[0] - second[0];
+  const double dy = first[1] - second[1];
+  const double dz = first[2] - second[2];
+  const double chord = std::sqrt(dx * dx + dy * dy + dz * dz);
+  return 2.0 * EarthRadiusKilometers * std::asin(std::min(chord / 2.0, 1.0));
+}
+
+// Great-circle distance in kilometers between two points given by their coordinates.
+[[nodiscard]] double GreatCircleDistance(const Coordinates& first, const Coordinates& second) {
+  return GreatCircleDistance(UnitSpherePosition(first), UnitSpherePosition(second));
+}
+
+// Table of the coordinates of postal codes, read from a CSV file with one postal code per line
+// followed by its latitude and longitude in degrees, such as "91234,34.0522,-118.2437". Lines that
+// do not end with valid coordinates, such as a header line, are skipped. Postal codes are matched
+// exactly, save for surrounding spaces.
+class PostalCodeTable {
+public:
+  // Default constructor. Constructs an empty postal code table.
+  PostalCodeTable() = default;
+
+  // Constructor. Constructs a postal code table by reading a given CSV file. Constructs an empty
+  // postal code table if the path is empty.
+  explicit PostalCodeTable(const std::filesystem::path& path) {
+    if (path.empty()) {
+      return;
+    }
+
+    std::ifstream stream{path};
+    if (!stream.is_open()) {
+      std::cout << "Cannot open the postal code file at: " << path << std::endl;
+      return;
+    }
+
+    std::string line;
+    while (std::getline(stream, line)) {
+      if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+      }
+      const std::size_t comma = line.find(',');
+      if (comma == std::string::npos) {
+        continue;
+      }
+      const std::optional<Coordinates> coordinates = ParseCoordinates(line.substr(comma + 1));
+      const std::string postal_code{Trim(line.substr(0, comma))};
+      if (coordinates.has_value() && !postal_code.empty()) {
+        postal_codes_to_coordinates_.emplace(postal_code, coordinates.value());
+      }
+    }
+
+    std::cout << "Read the coordinates of " << postal_codes_to_coordinates_.size()
+              << " postal codes from the file at: " << path << std::endl;
+  }
+
+  // Destructor. Destroys this postal code table.
+  ~PostalCodeTable() noexcept = default;
+
+  // Deleted copy constructor.
+  PostalCodeTable(const PostalCodeTable& other) = delete;
+
+  // Default move constructor.
+  PostalCodeTable(PostalCodeTable&& other) noexcept = default;
+
+  // Deleted copy assignment operator.
+  PostalCodeTable& operator=(const PostalCodeTable& other) = delete;
+
+  // Default move assignment operator.
+  PostalCodeTable& operator=(PostalCodeTable&& other) noexcept = default;
+
+  // Number of postal codes in this table.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return postal_codes_to_coordinates_.size();
+  }
+
+  // Coordinates of a given postal code, or no value if this table does not have it.
+  [[nodiscard]] std::optional<Coordinates> Find(const std::string_view postal_code) const {
+    const std::unordered_map<std::string, Coordinates>::const_iterator found =
+        postal_codes_to_coordinates_.find(Trim(postal_code));
+    if (found == postal_codes_to_coordinates_.cend()) {
+      return std::nullopt;
+    }
+    return found->second;
+  }
+
+private:
+  // Removes the spaces at the start and end of a given text.
+  [[nodiscard]] static std::string Trim(const std::string_view text) {
+    const std::size_t begin = text.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+      return {};
+    }
+    return std::string{text.substr(begin, text.find_last_not_of(' ') - begin + 1)};
+  }
+
+  // Coordinates of each postal code.
+  std::unordered_map<std::string, Coordinates> postal_codes_to_coordinates_;
+};
+
+// Coordinates of a given location, which is either coordinates such as "37.7749, -122.4194" or a
+// postal code of a given postal code table. Returns no value if the location is neither.
+[[nodiscard]] std::optional<Coordinates> ResolveLocation(
+    const std::string_view location, const PostalCodeTable& postal_codes) {
+  const std::optional<Coordinates> coordinates = ParseCoordinates(location);
+  if (coordinates.has_value()) {
+    return coordinates;
+  }
+  return postal_codes.Find(location);
+}
+
+// Finds the given number of nearest other points of each of a given set of positions on the unit
+// sphere. Returns a flat list of the indices of the neighbors of each point, nearest first: the
+// neighbors of point i are at indices i * count to (i + 1) * count - 1. If there are fewer other
+// points than the count, the missing neighbors are the point itself. Builds a k-d tree in
+// O(n log n) time and queries it from several threads, so that finding the neighbors of a hundred
+// thousand points takes a fraction of a second.
+[[nodiscard]] std::vector<uint32_t> FindNearestNeighbors(
+    const std::vector<std::array<double, 3>>& positions, const std::size_t count,
+    const std::size_t thread_count) {
+  const std::size_t size = positions.size();
+  std::vector<uint32_t> neighbors(size * count);
+  if (size == 0 || count == 0) {
+    return neighbors;
+  }
+
+  // The k-d tree is stored implicitly in a permutation of the point indices: the median of each
+  // range splits it along the axis of its largest extent, and the two halves of the range hold the
+  // two subtrees.
+  std::vector<uint32_t> tree(size);
+  for (std::size_t index = 0; index < size; ++index) {
+    tree[index] = static_cast<uint32_t>(index);
+  }
+  std::vector<uint8_t> axes(size, 0);
+  const std::function<void(std::size_t, std::size_t)> build = [&](const std::size_t begin,
+                                                                   const std::size_t end) {
+    if (end - begin <= 1) {
+      return;
+    }
+    std::array<double, 3> minimum{positions[tree[begin]]};
+    std::array<double, 3> maximum{positions[tree[begin]]};
+    for (std::size_t index = begin + 1; index < end; ++index) {
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        minimum[axis] = std::min(minimum[axis], positions[tree[index]][axis]);
+        maximum[axis] = std::max(maximum[axis], positions[tree[index]][axis]);
+      }
+    }
+    uint8_t axis = 0;
+    for (uint8_t candidate = 1; candidate < 3; ++candidate) {
+      if (maximum[candidate] - minimum[candidate] > maximum[axis] - minimum[axis]) {
+        axis = candidate;
+      }
+    }
+    const std::size_t middle = begin + (end - begin) / 2;
+    std::nth_element(tree.begin() + static_cast<std::ptrdiff_t>(begin),
+                     tree.begin() + static_cast<std::ptrdiff_t>(middle),
+                     tree.begin() + static_cast<std::ptrdiff_t>(end),
+                     [&](const uint32_t first, const uint32_t second) {
+                       return positions[first][axis] < positions[second][axis];
+                     });
+    axes[middle] = axis;
+    build(begin, middle);
+    build(middle + 1, end);
+  };
+  build(0, size);
+
+  // Finds the neighbors of the points of one share of the indices. Each query keeps the nearest
+  // points found so far in a max-heap and skips the subtrees that cannot hold nearer points.
+  const std::size_t share_count = std::max<std::size_t>(thread_count, 1);
+  const std::function<void(std::size_t)> query_share = [&](const std::size_t share) {
+    std::vector<std::pair<double, uint32_t>> heap;
+    heap.reserve(count + 1);
+    std::size_t point = 0;
+    const std::function<void(std::size_t, std::size_t)> search = [&](const std::size_t begin,
+                                                                      const std::size_t end) {
+      if (begin >= end) {
+        return;
+      }
+      const std::size_t middle = begin + (end - begin) / 2;
+      const uint32_t candidate = tree[middle];
+      if (candidate != point) {
+        const double dx = positions[candidate][0] - positions[point][0];
+        const double dy = positions[candidate][1] - positions[point][1];
+        const double dz = positions[candidate][2] - positions[point][2];
+        const double distance = dx * dx + dy * dy + dz * dz;
+        if (heap.size() < count || distance < heap.front().first) {
+          heap.emplace_back(distance, candidate);
+          std::push_heap(heap.begin(), heap.end());
+          if (heap.size() > count) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+          }
+        }
+      }
+      if (end - begin == 1) {
+        return;
+      }
+      const uint8_t axis = axes[middle];
+      const double offset = positions[point][axis] - positions[candidate][axis];
+      const bool left_first = offset < 0.0;
+      search(left_first ? begin : middle + 1, left_first ? middle : end);
+      if (heap.size() < count || offset * offset < heap.front().first) {
+        search(left_first ? middle + 1 : begin, left_first ? end : middle);
+      }
+    };
+    for (point = share; point < size; point += share_count) {
+      heap.clear();
+      search(0, size);
+
+      std::sort_heap(heap.begin(), heap.end());
+      for (std::size_t index = 0; index < count; ++index) {
+        neighbors[point * count + index] =
+            index < heap.size() ? heap[index].second : static_cast<uint32_t>(point);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t share = 1; share < share_count; ++share) {
+    threads.emplace_back(query_share, share);
+  }
+  query_share(0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  return neighbors;
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_GEOGRAPHY_HPP
@@ -0,0 +1,617 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_INCREMENTAL_CONFIGURATION_HPP
+#define SECRET_SANTA_INCREMENTAL_CONFIGURATION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "CalendarEvent.hpp"
+#include "Configuration.hpp"
+#include "Participant.hpp"
+#include "TimeZone.hpp"
+
+namespace SecretSanta {
+
+// Changes to the participants of a YAML configuration file from one revision to the next.
+struct ConfigurationChanges {
+  // Names of the participants who were added, in alphabetical order.
+  std::vector<std::string> added;
+
+  // Names of the participants who were removed, in alphabetical order.
+  std::vector<std::string> removed;
+
+  // Names of the participants whose details changed, in alphabetical order.
+  std::vector<std::string> changed;
+
+  // Whether anything other than the participants changed, such as the message or the event.
+  bool header_changed{false};
+
+  // Number of participant entries in the revision.
+  std::size_t entry_count{0};
+
+  // Number of participant entries that were parsed. The other entries are unchanged since the
+  // previous revision and are not parsed again.
+  std::size_t parsed_entry_count{0};
+};
+
+// Configuration details of a YAML configuration file that is revalidated incrementally as the file
+// is edited. Each revision of the file is split into its participant entries by their indentation,
+// and only the entries whose text changed since the previous revision are parsed again, while the
+// message and the event are parsed again only if their text changed. The participants and the
+// problems found in the file are kept up to date with each revision. If the participants are not
+// listed one entry per line in block style, such as in a flow sequence, they are parsed together as
+// a single entry.
+class IncrementalConfiguration {
+public:
+  // Default constructor. Constructs an empty configuration.
+  IncrementalConfiguration() = default;
+
+  // Destructor. Destroys this configuration.
+  ~IncrementalConfiguration() noexcept = default;
+
+  // Deleted copy constructor.
+  IncrementalConfiguration(const IncrementalConfiguration& other) = delete;
+
+  // Deleted move constructor.
+  IncrementalConfiguration(IncrementalConfiguration&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  IncrementalConfiguration& operator=(const IncrementalConfiguration& other) = delete;
+
+  // Deleted move assignment operator.
+  IncrementalConfiguration& operator=(IncrementalConfiguration&& other) noexcept = delete;
+
+  // Updates this configuration to a given revision of the text of a YAML configuration file.
+  // Returns the changes to the participants since the previous revision.
+  ConfigurationChanges Update(const std::string_view text) {
+    ConfigurationChanges changes;
+
+    std::string header;
+    std::vector<std::size_t> header_lines;
+    std::vector<Span> spans;
+    Split(text, header, header_lines, spans);
+    changes.entry_count = spans.size();
+
+    if (header != header_) {
+      header_ = std::move(header);
+      ParseHeader(header_lines);
+      changes.header_changed = true;
+    }
+
+    // Edits are local, so most of the text is unchanged before the first difference and after the
+    // last difference from the previous revision. The entries that lie entirely in the unchanged
+    // text are matched with the entries of the previous revision at the same place without being
+    // looked up, and only the other entries are looked up by their text and parsed if they are new.
+    const std::size_t prefix{CommonPrefixLength(text_, text)};
+    const std::size_t suffix{CommonSuffixLength(text_, text, prefix)};
+    ++revision_;
+    std::vector<Entry*> touched;
+    std::size_t previous_index{0};
+    for (Span& span : spans) {
+      const bool in_prefix{span.offset + span.length <= prefix};
+      const bool in_suffix{span.offset >= text.size() - suffix};
+      if (in_prefix || in_suffix) {
+        const std::size_t previous_offset{
+            in_prefix ? span.offset : span.offset + text_.size() - text.size()};
+        while (previous_index < spans_.size() && spans_[previous_index].offset < previous_offset) {
+          ++previous_index;
+        }
+        if (previous_index < spans_.size() && spans_[previous_index].offset == previous_offset
+            && spans_[previous_index].length == span.length) {
+          span.entry = std::exchange(spans_[previous_index].entry, nullptr);
+          span.problematic = spans_[previous_index].problematic;
+          continue;
+        }
+      }
+
+      const std::string_view entry_text{text.substr(span.offset, span.length)};
+      Entries::iterator found{entries_.find(entry_text)};
+      if (found == entries_.end()) {
+        found = entries_.emplace(std::string{entry_text}, Parse(entry_text)).first;
+        found->second.text = &found->first;
+        ++changes.parsed_entry_count;
+      }
+      span.entry = &found->second;
+      span.problematic = !span.entry->problems.empty();
+      ++span.entry->count;
+      Touch(*span.entry, touched);
+    }
+
+    // The entries of the previous revision that were not matched are no longer at their place.
+    for (const Span& previous : spans_) {
+      if (previous.entry != nullptr) {
+        --previous.entry->count;
+        Touch(*previous.entry, touched);
+      }
+    }
+    spans_ = std::move(spans);
+    text_.assign(text);
+
+    // Tally the changes in the number of entries of each participant name, and remove the entries
+    // that no longer appear.
+    std::map<std::string, std::size_t> previous_counts;
+    std::map<std::string, const Participant*> latest;
+    for (Entry* const entry : touched) {
+      if (entry->count != entry->previous_count) {
+        Tally(*entry,
+              static_cast<std::ptrdiff_t>(entry->count)
+                  - static_cast<std::ptrdiff_t>(entry->previous_count),
+              previous_counts, latest);
+        entry->previous_count = entry->count;
+      }
+    }
+    for (Entry* const entry : touched) {
+      if (entry->count == 0) {
+        entries_.erase(*entry->text);
+      }
+    }
+
+    for (const std::pair<const std::string, std::size_t>& element : previous_counts) {
+      const std::string& name{element.first};
+      const std::unordered_map<std::string, std::size_t>::iterator count{name_counts_.find(name)};
+      const std::size_t current_count{count != name_counts_.end() ? count->second : 0};
+      if (current_count == 0) {
+        if (count != name_counts_.end()) {
+          name_counts_.erase(count);
+        }
+        participants_.erase(name);
+        changes.removed.push_back(name);
+      } else if (element.second == 0) {
+        participants_.emplace(name, *latest.at(name));
+        changes.added.push_back(name);
+      } else {
+        // Either an entry of this name was added or edited, or one of several entries of this name
+        // was removed, in which case one of the remaining entries is kept.
+        const Participant& participant{
+            latest.count(name) > 0 ? *latest.at(name) : FindParticipant(name)};
+        if (participant.Print() != participants_.at(name).Print()) {
+          participants_.at(name) = participant;
+          changes.changed.push_back(name);
+        }
+      }
+
+      if (current_count > 1) {
+        duplicates_.insert(name);
+      } else {
+        duplicates_.erase(name);
+      }
+    }
+
+    CollectProblems();
+    return changes;
+  }
+
+  // Participants of the current revision, keyed by their names. When several entries have the same
+  // name, only one of them is kept.
+  [[nodiscard]] const std::map<std::string, Participant>& Participants() const noexcept {
+    return participants_;
+  }
+
+  // Problems found in the current revision, each prefixed with the line of the YAML configuration
+  // file at which it was found, if any. Empty if no problems were found.
+  [[nodiscard]] const std::vector<std::string>& Problems() const noexcept {
+    return problems_;
+  }
+
+  // Event of the current revision, if it is defined and valid.
+  [[nodiscard]] const std::optional<CalendarEvent>& Event() const noexcept {
+    return event_;
+  }
+
+private:
+  // Participant entry parsed from its text.
+  struct Entry {
+    // Participants defined by this entry: one for an entry in block style, or any number for a
+    // flow sequence of participants.
+    std::vector<Participant> participants;
+
+    // Problems found in this entry, each with its line relative to the start of the entry.
+    std::vector<std::pair<std::size_t, std::string>> problems;
+
+    // Number of times this entry appears in the current revision.
+    std::size_t count{0};
+
+    // Number of times this entry appeared in the previous revision.
+    std::size_t previous_count{0};
+
+    // Latest revision in which the number of times this entry appears changed.
+    std::size_t revision{0};
+
+    // Text of this entry, which is its key among the participant entries.
+    const std::string* text{nullptr};
+  };
+
+  // Place of a participant entry in a revision of the YAML configuration file.
+  struct Span {
+    // Offset of the entry in the text of the revision.
+    std::size_t offset{0};
+
+    // Length of the text of the entry, including its sequence indicator and its indentation.
+    std::size_t length{0};
+
+    // Line of the YAML configuration file at which the entry starts, counting from 1.
+    std::size_t line{0};
+
+    // Entry at this place, once it is matched or looked up.
+    Entry* entry{nullptr};
+
+    // Whether problems were found in the entry at this place.
+    bool problematic{false};
+  };
+
+  // Hash function of texts that looks up texts by their views without copying them.
+  struct TextHash {
+    // Marks this hash function as transparent.
+    using is_transparent = void;
+
+    // Hashes a given text.
+    [[nodiscard]] std::size_t operator()(const std::string_view text) const noexcept {
+      return std::hash<std::string_view>{}(text);
+    }
+  };
+
+  // Participant entries keyed by their texts.
+  using Entries = std::unordered_map<std::string, Entry, TextHash, std::equal_to<>>;
+
+  // Splits a revision of the text of a YAML configuration file into its participant entries and its
+  // header, which holds all of its other lines, along with the line of the file of each line of the
+  // header.
+  static void Split(const std::string_view text, std::string& header,
+                    std::vector<std::size_t>& header_lines, std::vector<Span>& spans) {
+    // Section of the file in which the current line is.
+    enum class Section : int8_t {
+      Header,
+      BlockParticipants,
+      FlowParticipants,
+    };
+
+    Section section{Section::Header};
+    std::size_t item_indentation{std::string_view::npos};
+    std::size_t section_start{0};
+    std::size_t section_line{0};
+    std::size_t first_section_span{0};
+    std::size_t entry_start{std::string_view::npos};
+    std::size_t entry_line{0};
+
+    std::size_t line_number{0};
+    for (std::size_t start = 0; start < text.size();) {
+      const std::size_t newline{text.find('\n', start)};
+      const std::size_t end{newline == std::string_view::npos ? text.size() : newline + 1};
+      const std::string_view line{text.substr(start, end - start)};
+      ++line_number;
+
+      const std::size_t indentation{std::min(line.find_first_not_of(' '), line.size())};
+      const bool blank{indentation == line.size() || line[indentation] == '\n'
+                       || line[indentation] == '\r' || line[indentation] == '#'};
+      const bool item{!blank && line[indentation] == '-'
+                      && (indentation + 1 == line.size() || line[indentation + 1] == ' '
+                          || line[indentation + 1] == '\n' || line[indentation + 1] == '\r')};
+
+      if (!blank && indentation == 0 && !item) {
+        CloseEntry(start, entry_start, entry_line, spans);
+        if (section == Section::FlowParticipants) {
+          spans.push_back({section_start, start - section_start, section_line});
+        }
+        section = Section::Header;
+
+        if (IsParticipantsKey(line)) {
+          section = IsBlockParticipantsKey(line) ? Section::BlockParticipants :
+                                                   Section::FlowParticipants;
+          item_indentation = std::string_view::npos;
+          section_start = start;
+          section_line = line_number;
+          first_section_span = spans.size();
+          start = end;
+          continue;
+        }
+      }
+
+      if (section == Section::Header) {
+        header.append(line);
+        header_lines.push_back(line_number);
+      } else if (section == Section::BlockParticipants && !blank) {
+        if (item_indentation == std::string_view::npos && item) {
+          item_indentation = indentation;
+        }
+        if (item && indentation == item_indentation) {
+          CloseEntry(start, entry_start, entry_line, spans);
+          entry_start = start;
+          entry_line = line_number;
+        } else if (item_indentation == std::string_view::npos || indentation <= item_indentation) {
+          // The participants are not listed one entry per line in block style, so they are parsed
+          // together as a single entry.
+          entry_start = std::string_view::npos;
+          spans.resize(first_section_span);
+          section = Section::FlowParticipants;
+        }
+      }
+
+      start = end;
+    }
+
+    CloseEntry(text.size(), entry_start, entry_line, spans);
+    if (section == Section::FlowParticipants) {
+      spans.push_back({section_start, text.size() - section_start, section_line});
+    }
+  }
+
+  // Adds the participant entry that starts at a given position and ends at another one, if any, to
+  // the participant entries, and marks that no entry is open.
+  static void CloseEntry(const std::size_t end, std::size_t& entry_start,
+                         const std::size_t entry_line, std::vector<Span>& spans) {
+    if (entry_start != std::string_view::npos) {
+      spans.push_back({entry_start, end - entry_start, entry_line});
+      entry_start = std::string_view::npos;
+    }
+  }
+
+  // Whether a given top-level line of a YAML configuration file is the key of its participants.
+  [[nodiscard]] static bool IsParticipantsKey(const std::string_view line) noexcept {
+    constexpr std::string_view key{"participants:"};
+    return line.substr(0, key.size()) == key
+           && (line.size() == key.size() || line[key.size()] == ' ' || line[key.size()] == '\n'
+               || line[key.size()] == '\r');
+  }
+
+  // Whether a given key line of the participants is followed by a block sequence, that is, whether
+  // nothing but a comment follows the key on its line.
+  [[nodiscard]] static bool IsBlockParticipantsKey(const std::string_view line) noexcept {
+    constexpr std::string_view key{"participants:"};
+    const std::size_t value{line.find_first_not_of(" \r\n", key.size())};
+    return value == std::string_view::npos || line[value] == '#';
+  }
+
+  // Removes the indentation of the first line of a given participant entry from each of its lines,
+  // such that the entry can be parsed on its own.
+  [[nodiscard]] static std::string Dedent(const std::string_view text) {
+    const std::size_t indentation{std::min(text.find_first_not_of(' '), text.size())};
+    std::string result;
+    result.reserve(text.size());
+    for (std::size_t start = 0; start < text.size();) {
+      const std::size_t newline{text.find('\n', start)};
+      const std::size_t end{newline == std::string_view::npos ? text.size() : newline + 1};
+      const std::string_view line{text.substr(start, end - start)};
+      result.append(
+          line.substr(std::min(indentation, std::min(line.find_first_not_of(' '), line.size()))));
+      start = end;
+    }
+    return result;
+  }
+
+  // Parses a participant entry from its text. Malformed YAML is reported as a problem of the entry
+  // rather than thrown, so that a typo in one entry does not hide the rest of the file.
+  [[nodiscard]] static Entry Parse(const std::string_view text) {
+    Entry entry;
+    YAML::Node node;
+    try {
+      node = YAML::Load(Dedent(text));
+    } catch (const YAML::Exception& exception) {
+      entry.problems.emplace_back(
+          exception.mark.is_null() ? 0 : static_cast<std::size_t>(exception.mark.line),
+          "The participant entry cannot be parsed: " + exception.msg + ".");
+      return entry;
+    }
+
+    const YAML::Node participants{
+        node.IsMap() && node["participants"] ? node["participants"] : node};
+    if (participants.IsNull()) {
+      return entry;
+    }
+    if (!participants.IsSequence()) {
+      entry.problems.emplace_back(0, "The participants are not a list of participant entries.");
+      return entry;
+    }
+
+    for (const YAML::iterator::value_type& element : participants) {
+      const std::size_t line{element.Mark().is_null() ?
+                                 0 :
+                                 static_cast<std::size_t>(element.Mark().line)};
+      try {
+        Participant participant{element};
+        if (participant.Name().empty()) {
+          entry.problems.emplace_back(
+              line, "The participant entry is not of the form \"Alice Smith: {email: "
+                    "alice.smith@gmail.com}\" and is ignored.");
+          continue;
+        }
+        if (participant.Email().empty()) {
+          entry.problems.emplace_back(line, "Participant " + participant.Name()
+                                                + " has no email address and cannot be notified.");
+        }
+        if (!participant.TimeZone().empty() && !IsKnownTimeZone(participant.TimeZone())) {
+          entry.problems.emplace_back(line, "Participant " + participant.Name()
+                                                + " has an unknown time zone: "
+                                                + participant.TimeZone() + ".");
+        }
+        entry.participants.push_back(std::move(participant));
+      } catch (const YAML::Exception& exception) {
+        entry.problems.emplace_back(
+            line, "The participant entry cannot be read: " + exception.msg + ".");
+      }
+    }
+    return entry;
+  }
+
+  // Parses the message and the event from the header of the YAML configuration file, given the
+  // line of the file of each line of the header.
+  void ParseHeader(const std::vector<std::size_t>& header_lines) {
+    header_problems_.clear();
+    event_.reset();
+
+    try {
+      const YAML::Node root{YAML::Load(header_)};
+      if (!root["message"] || !root["message"]["subject"]) {
+        header_problems_.emplace_back(
+            "No email message subject is defined; the default email message subject is used.");
+      }
+      if (!root["message"] || !root["message"]["body"]) {
+        header_problems_.emplace_back(
+            "No email message body is defined; the default email message body is used.");
+      }
+      if (root["event"]) {
+        std::string problem;
+        event_ = ParseEvent(root["event"], problem);
+        if (!event_.has_value()) {
+          header_problems_.push_back(std::move(problem));
+        }
+      }
+    } catch (const YAML::Exception& exception) {
+      const std::size_t line{exception.mark.is_null() ?
+                                 0 :
+                                 static_cast<std::size_t>(exception.mark.line)};
+      header_problems_.push_back(
+          (line < header_lines.size() ? "Line " + std::to_string(header_lines[line]) + ": " : "")
+          + "The YAML configuration file cannot be parsed: " + exception.msg + ".");
+    }
+  }
+
+  // Adds a given number of entries, which may be negative, to the number of entries of each
+  // participant name of a given entry. Keeps the number of entries of each name before the first
+  // change, and the latest participant of each name that gained entries.
+  void Tally(const Entry& entry, const std::ptrdiff_t difference,
+             std::map<std::string, std::size_t>& previous_counts,
+             std::map<std::string, const Participant*>& latest) {
+    for (const Participant& participant : entry.participants) {
+      std::size_t& count{name_counts_[participant.Name()]};
+      previous_counts.emplace(participant.Name(), count);
+      count = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(count) + difference);
+      if (difference > 0) {
+        latest[participant.Name()] = &participant;
+      }
+    }
+  }
+
+  // Length of the common prefix of two given texts.
+  [[nodiscard]] static std::size_t CommonPrefixLength(
+      const std::string_view first, const std::string_view second) noexcept {
+    return static_cast<std::size_t>(
+        std::mismatch(first.begin(), first.begin() + std::min(first.size(), second.size()),
+                      second.begin())
+            .first
+        - first.begin());
+  }
+
+  // Length of the common suffix of two given texts that does not overlap a common prefix of a given
+  // length.
+  [[nodiscard]] static std::size_t CommonSuffixLength(
+      const std::string_view first, const std::string_view second,
+      const std::size_t prefix) noexcept {
+    const std::size_t maximum{std::min(first.size(), second.size()) - prefix};
+    return static_cast<std::size_t>(
+        std::mismatch(first.rbegin(), first.rbegin() + maximum, second.rbegin()).first
+        - first.rbegin());
+  }
+
+  // Marks that the number of times a given entry appears changed in the current revision, and adds
+  // it to the given touched entries unless it is already among them.
+  void Touch(Entry& entry, std::vector<Entry*>& touched) const {
+    if (entry.revision != revision_) {
+      entry.revision = revision_;
+      touched.push_back(&entry);
+    }
+  }
+
+  // One of the participants of a given name among the participant entries of the current revision.
+  // Only used when one of several entries of this name is removed, since it scans all entries.
+  [[nodiscard]] const Participant& FindParticipant(const std::string& name) const {
+    for (const std::pair<const std::string, Entry>& element : entries_) {
+      for (const Participant& participant : element.second.participants) {
+        if (participant.Name() == name) {
+          return participant;
+        }
+      }
+    }
+    return participants_.at(name);
+  }
+
+  // Collects the problems of the header, of each participant entry, and of the participants as a
+  // whole.
+  void CollectProblems() {
+    problems_ = header_problems_;
+    for (const Span& span : spans_) {
+      if (span.problematic) {
+        for (const std::pair<std::size_t, std::string>& problem : span.entry->problems) {
+          problems_.push_back(
+              "Line " + std::to_string(span.line + problem.first) + ": " + problem.second);
+        }
+      }
+    }
+    for (const std::string& name : duplicates_) {
+      problems_.push_back("Participant " + name + " is defined "
+                          + std::to_string(name_counts_.at(name))
+                          + " times; each participant must have a unique name.");
+    }
+    if (participants_.empty()) {
+      problems_.emplace_back("No participants are defined.");
+    } else if (participants_.size() == 1) {
+      problems_.emplace_back("Only one participant is defined; at least two are needed.");
+    }
+  }
+
+  // Header of the current revision, which holds all of its lines other than the participants.
+  std::string header_;
+
+  // Problems found in the header of the current revision.
+  std::vector<std::string> header_problems_;
+
+  // Participant entries of the current revision, keyed by their texts.
+  Entries entries_;
+
+  // Number of revisions so far.
+  std::size_t revision_{0};
+
+  // Text of the current revision.
+  std::string text_;
+
+  // Places of the participant entries of the current revision, in the order of the file.
+  std::vector<Span> spans_;
+
+  // Number of entries of each participant name of the current revision.
+  std::unordered_map<std::string, std::size_t> name_counts_;
+
+  // Names of the participants that have several entries in the current revision.
+  std::set<std::string> duplicates_;
+
+  // Participants of the current revision, keyed by their names.
+  std::map<std::string, Participant> participants_;
+
+  // Problems found in the current revision.
+  std::vector<std::string> problems_;
+
+  // Event of the current revision, if it is defined and valid.
+  std::optional<CalendarEvent> event_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_INCREMENTAL_CONFIGURATION_HPP
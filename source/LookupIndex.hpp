@@ -0,0 +1,342 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_LOOKUP_INDEX_HPP
+#define SECRET_SANTA_LOOKUP_INDEX_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Configuration.hpp"
+#include "Emailer.hpp"
+#include "Matchings.hpp"
+#include "StringIndex.hpp"
+#include "Tokens.hpp"
+
+namespace SecretSanta {
+
+// Response of the Secret Santa Lookup server to one HTTP request.
+struct LookupResponse {
+  // Complete HTTP response, including its status line and header fields.
+  std::string_view text;
+
+  // HTTP status code of the response.
+  uint16_t status{200};
+
+  // Whether the connection must be closed once the response is written.
+  bool close{false};
+};
+
+// Immutable index from which the Secret Santa Lookup server answers HTTP requests. A participant
+// looks up their giftees with "GET /giftee?token=<token>" or with their token in an
+// "Authorization: Bearer <token>" header field, and receives the same text as the email message
+// that the Secret Santa Messenger sends them. Every response is rendered in full once, when the
+// index is built, and the tokens are kept in a string index, so that answering a request only
+// parses the request and looks up its token, without allocating any memory. Responses to HEAD
+// requests are the header part of the corresponding GET responses.
+class LookupIndex {
+public:
+  // Default constructor. Constructs an index in which no token is known.
+  LookupIndex() {
+    RenderFixedResponses();
+  }
+
+  // Constructor. Constructs an index from the participants and email message of a given
+  // configuration, given matchings, and given tokens. Participants who have no token or no giftee
+  // cannot look up anything.
+  LookupIndex(const Configuration& configuration, const Matchings& matchings,
+              const Tokens& tokens) {
+    RenderFixedResponses();
+
+    std::size_t missing_count = 0;
+    for (const Participant& gifter : configuration.Participants()) {
+      const std::string token = tokens.Token(gifter.Name());
+      const std::vector<const Participant*> giftees =
+          FindGiftees(configuration, matchings, gifter);
+      if (token.empty() || giftees.empty()) {
+        ++missing_count;
+        continue;
+      }
+      const uint32_t identifier = tokens_.Insert(token);
+      if (identifier < giftee_responses_.size()) {
+        continue;
+      }
+      giftee_responses_.push_back(
+          Render("200 OK", "text/plain; charset=utf-8",
+                 ComposeFullMessageBody(gifter, giftees, configuration.MessageBody()), false));
+    }
+
+    std::cout << "Indexed the giftees of " << giftee_responses_.size() << " participants";
+    if (missing_count > 0) {
+      std::cout << "; " << missing_count
+                << " participants have no token or no giftee and cannot look up anything";
+    }
+    std::cout << "." << std::endl;
+  }
+
+  // Destructor. Destroys this index.
+  ~LookupIndex() noexcept = default;
+
+  // Deleted copy constructor.
+  LookupIndex(const LookupIndex& other) = delete;
+
+  // Deleted move constructor.
+  LookupIndex(LookupIndex&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  LookupIndex& operator=(const LookupIndex& other) = delete;
+
+  // Deleted move assignment operator.
+  LookupIndex& operator=(LookupIndex&& other) noexcept = delete;
+
+  // Number of participants who can look up their giftees.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return giftee_responses_.size();
+  }
+
+  // Answers a given HTTP request, which consists of its request line and header fields up to and
+  // including the empty line that ends them. Requests with a body are not supported, so requests
+  // whose method is neither GET nor HEAD are refused and their connection is closed.
+  [[nodiscard]] LookupResponse Respond(const std::string_view request) const noexcept {
+    const std::size_t line_end = request.find('\n');
+    const std::string_view request_line = TrimCarriageReturn(request.substr(0, line_end));
+    const std::size_t first_space = request_line.find(' ');
+    const std::size_t second_space = request_line.find(' ', first_space + 1);
+    if (line_end == std::string_view::npos || first_space == std::string_view::npos
+        || second_space == std::string_view::npos
+        || request_line.find(' ', second_space + 1) != std::string_view::npos) {
+      return Full(bad_request_, 400);
+    }
+
+    const std::string_view method = request_line.substr(0, first_space);
+    const std::string_view target =
+        request_line.substr(first_space + 1, second_space - first_space - 1);
+    const std::string_view version = request_line.substr(second_space + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+      return Full(bad_request_, 400);
+    }
+    const bool head = method == "HEAD";
+    if (!head && method != "GET") {
+      return Full(method_not_allowed_, 405);
+    }
+
+    // Read the header fields that matter: whether to keep the connection open, and the token.
+    bool close = version == "HTTP/1.0";
+    std::string_view token;
+    for (std::size_t start = line_end + 1; start < request.size();) {
+      const std::size_t end = request.find('\n', start);
+      const std::string_view field =
+          TrimCarriageReturn(request.substr(start, end == std::string_view::npos ?
+                                                       std::string_view::npos :
+                                                       end - start));
+      const std::size_t colon = field.find(':');
+      if (colon != std::string_view::npos) {
+        const std::string_view name = field.substr(0, colon);
+        const std::string_view value = TrimSpaces(field.substr(colon + 1));
+        if (EqualsIgnoringCase(name, "Connection")) {
+          if (ContainsIgnoringCase(value, "close")) {
+            close = true;
+          } else if (ContainsIgnoringCase(value, "keep-alive")) {
+            close = false;
+          }
+        } else if (EqualsIgnoringCase(name, "Authorization") && value.size() > 7
+                   && EqualsIgnoringCase(value.substr(0, 7), "Bearer ")) {
+          token = TrimSpaces(value.substr(7));
+        }
+      }
+      if (end == std::string_view::npos) {
+        break;
+      }
+      start = end + 1;
+    }
+
+    const std::size_t question_mark = target.find('?');
+    const std::string_view path = target.substr(0, question_mark);
+    if (path == "/") {
+      return Part(form_, 200, head, close);
+    }
+    if (path != "/giftee") {
+      return Part(not_found_, 404, head, close);
+    }
+
+    if (question_mark != std::string_view::npos) {
+      const std::string_view query = target.substr(question_mark + 1);
+      for (std::size_t start = 0; start <= query.size();) {
+        const std::size_t end = std::min(query.find('&', start), query.size());
+        const std::string_view parameter = query.substr(start, end - start);
+        if (parameter.substr(0, 6) == "token=") {
+          token = parameter.substr(6);
+        }
+        start = end + 1;
+      }
+    }
+
+    const uint32_t identifier = tokens_.Find(token);
+    if (token.empty() || identifier == StringIndex::NotFound) {
+      return Part(forbidden_, 403, head, close);
+    }
+    return Part(giftee_responses_[identifier], 200, head, close);
+  }
+
+  // Response to a request whose header is too large, after which the connection is closed.
+  [[nodiscard]] LookupResponse RequestTooLarge() const noexcept {
+    return Full(request_too_large_, 431);
+  }
+
+private:
+  // Rendered HTTP response, along with the length of its header part.
+  struct Rendered {
+    // Complete HTTP response.
+    std::string text;
+
+    // Length of the status line and header fields, including the empty line that ends them.
+    std::size_t head_length{0};
+  };
+
+  // Renders an HTTP response with a given status, content type, and body. Responses that are
+  // followed by the closing of the connection say so. Responses are never cached, since they may
+  // reveal a giftee.
+  [[nodiscard]] static Rendered Render(const std::string& status, const std::string& content_type,
+                                       const std::string& body, const bool close) {
+    Rendered rendered;
+    rendered.text = "HTTP/1.1 " + status + "\r\nContent-Type: " + content_type
+                    + "\r\nContent-Length: " + std::to_string(body.size())
+                    + "\r\nCache-Control: no-store\r\nX-Content-Type-Options: nosniff\r\n"
+                    + (close ? "Connection: close\r\n" : "") + "\r\n";
+    rendered.head_length = rendered.text.size();
+    rendered.text.append(body);
+    return rendered;
+  }
+
+  // Renders the responses that do not depend on the participants.
+  void RenderFixedResponses() {
+    form_ = Render("200 OK", "text/html; charset=utf-8",
+                   "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\">"
+                   "<title>Secret Santa</title></head><body><h1>Secret Santa</h1>"
+                   "<form action=\"/giftee\" method=\"get\"><label>Token: "
+                   "<input name=\"token\" size=\"32\" autofocus></label> "
+                   "<button>Look up my giftee</button></form></body></html>\n",
+                   false);
+    bad_request_ = Render("400 Bad Request", "text/plain; charset=utf-8",
+                          "Malformed request.\n", true);
+    forbidden_ =
+        Render("403 Forbidden", "text/plain; charset=utf-8",
+               "Unknown token; please check the token that the organizer gave you.\n", false);
+    not_found_ = Render("404 Not Found", "text/plain; charset=utf-8",
+                        "Look up your giftee at /giftee?token=<token>.\n", false);
+    method_not_allowed_ = Render("405 Method Not Allowed", "text/plain; charset=utf-8",
+                                 "Only GET and HEAD requests are supported.\n", true);
+    request_too_large_ = Render("431 Request Header Fields Too Large", "text/plain; charset=utf-8",
+                                "The request header is too large.\n", true);
+  }
+
+  // Complete response for a given rendered response that closes the connection.
+  [[nodiscard]] static LookupResponse Full(
+      const Rendered& rendered, const uint16_t status) noexcept {
+    return {rendered.text, status, true};
+  }
+
+  // Complete response for a given rendered response, or only its header part for a HEAD request.
+  [[nodiscard]] static LookupResponse Part(const Rendered& rendered, const uint16_t status,
+                                           const bool head, const bool close) noexcept {
+    return {head ? std::string_view{rendered.text}.substr(0, rendered.head_length) :
+                   std::string_view{rendered.text},
+            status, close};
+  }
+
+  // Removes a trailing carriage return from a given line.
+  [[nodiscard]] static std::string_view TrimCarriageReturn(std::string_view line) noexcept {
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    return line;
+  }
+
+  // Removes leading and trailing spaces and tabs from a given text.
+  [[nodiscard]] static std::string_view TrimSpaces(std::string_view text) noexcept {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+      text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+      text.remove_suffix(1);
+    }
+    return text;
+  }
+
+  // Whether two texts are equal regardless of the case of their ASCII letters.
+  [[nodiscard]] static bool EqualsIgnoringCase(
+      const std::string_view first, const std::string_view second) noexcept {
+    if (first.size() != second.size()) {
+      return false;
+    }
+    for (std::size_t index = 0; index < first.size(); ++index) {
+      if (std::tolower(static_cast<unsigned char>(first[index]))
+          != std::tolower(static_cast<unsigned char>(second[index]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Whether a given text contains a given word regardless of the case of their ASCII letters.
+  [[nodiscard]] static bool ContainsIgnoringCase(
+      const std::string_view text, const std::string_view word) noexcept {
+    for (std::size_t start = 0; start + word.size() <= text.size(); ++start) {
+      if (EqualsIgnoringCase(text.substr(start, word.size()), word)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Tokens of the participants who can look up their giftees. The identifier of each token indexes
+  // the responses.
+  StringIndex tokens_;
+
+  // Response that lists the giftees of each participant, by the identifier of their token.
+  std::vector<Rendered> giftee_responses_;
+
+  // Response with a form in which a participant enters their token.
+  Rendered form_;
+
+  // Response to a malformed request.
+  Rendered bad_request_;
+
+  // Response to a lookup with an unknown token.
+  Rendered forbidden_;
+
+  // Response to a request for an unknown path.
+  Rendered not_found_;
+
+  // Response to a request with a method other than GET or HEAD.
+  Rendered method_not_allowed_;
+
+  // Response to a request whose header is too large.
+  Rendered request_too_large_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_LOOKUP_INDEX_HPP
@@ -0,0 +1,75 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <csignal>
+#include <iostream>
+
+#include "Configuration.hpp"
+#include "LookupIndex.hpp"
+#include "LookupServer.hpp"
+#include "LookupSettings.hpp"
+#include "Matchings.hpp"
+#include "Tokens.hpp"
+
+int main(int argc, char* argv[]) {
+  const SecretSanta::Lookup::Settings settings{argc, argv};
+
+  // Block the interrupt and termination signals before any thread starts, such that they are only
+  // received below.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  const SecretSanta::Configuration configuration{settings.ConfigurationFile()};
+
+  const SecretSanta::Matchings matchings{settings.MatchingsFile()};
+
+  const SecretSanta::Tokens tokens{settings.TokensFile()};
+
+  const SecretSanta::LookupIndex index{configuration, matchings, tokens};
+
+  if (index.Size() == 0) {
+    std::cout << "No participant can look up their giftees; please check the matchings and tokens "
+              << "files." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const SecretSanta::LookupServer server{
+      index, settings.Port(), settings.Threads(), settings.MaximumConnections()};
+
+  if (!server.IsListening()) {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Listening on port " << server.Port()
+            << " of the loopback interface; participants look up their giftees at "
+            << "/giftee?token=<token>. Press Ctrl+C to stop." << std::endl;
+
+  int signal = 0;
+  sigwait(&signals, &signal);
+
+  server.PrintStatistics();
+
+  std::cout << "End of " << SecretSanta::Lookup::Program::Title << "." << std::endl;
+
+  return EXIT_SUCCESS;
+}
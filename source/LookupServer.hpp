@@ -0,0 +1,486 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_LOOKUP_SERVER_HPP
+#define SECRET_SANTA_LOOKUP_SERVER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <thread>
+#include <vector>
+
+#include "LookupIndex.hpp"
+#include "Socket.hpp"
+
+namespace SecretSanta {
+
+// Small HTTP server with which participants look up their giftees by themselves, for instance when
+// their email message was lost. Listens on the loopback interface and answers each request from an
+// immutable lookup index; it is meant to be exposed to the participants through a reverse proxy
+// that adds TLS. Serves all connections on a few event loop threads that wait on them with epoll
+// and share the listening socket. Each connection has a fixed input buffer and a fixed queue of
+// responses, which point into the index, all allocated when the server starts, so that serving a
+// request allocates no memory. Supports keep-alive connections and pipelined requests.
+class LookupServer {
+public:
+  // Size of the input buffer of each connection, which bounds the size of a request header.
+  static constexpr std::size_t InputCapacity{8192};
+
+  // Number of responses that each connection can queue while its peer does not read them.
+  static constexpr std::size_t OutputCapacity{32};
+
+  // Constructor. Starts listening on the loopback interface at a given port, or at a port chosen by
+  // the operating system if the given port is 0, and serves the connections on a given number of
+  // event loop threads. Connections past the given maximum number of concurrent connections are
+  // closed at once. The given index must outlive this server.
+  explicit LookupServer(const LookupIndex& index, const uint16_t port = 0,
+                        const std::size_t thread_count = 1,
+                        const std::size_t maximum_connection_count = 1024)
+    : index_(index), listener_(ListenOnLoopback(port)) {
+    if (!listener_.IsOpen()) {
+      std::cout << "Cannot listen on port " << port
+                << " of the loopback interface; please check that the port is not already in use."
+                << std::endl;
+      return;
+    }
+    ::fcntl(listener_.Descriptor(), F_SETFL,
+            ::fcntl(listener_.Descriptor(), F_GETFL, 0) | O_NONBLOCK);
+    port_ = listener_.LocalPort();
+
+    const std::size_t loop_count = std::max<std::size_t>(thread_count, 1);
+    const std::size_t connections_per_loop =
+        std::max<std::size_t>((maximum_connection_count + loop_count - 1) / loop_count, 1);
+    for (std::size_t index = 0; index < loop_count; ++index) {
+      loops_.push_back(std::make_unique<Loop>(connections_per_loop));
+
+      // Every event loop waits on the listening socket, but only one of them is woken up for each
+      // new connection.
+      epoll_event event{};
+      event.events = EPOLLIN | EPOLLEXCLUSIVE;
+      event.data.ptr = &listener_;
+      ::epoll_ctl(loops_.back()->epoll.Descriptor(), EPOLL_CTL_ADD, listener_.Descriptor(), &event);
+    }
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      loop->thread = std::thread{[this, &event_loop = *loop]() { Run(event_loop); }};
+    }
+  }
+
+  // Destructor. Stops the event loops and closes all connections.
+  ~LookupServer() noexcept {
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      const uint64_t one = 1;
+      static_cast<void>(::write(loop->wake.Descriptor(), &one, sizeof(one)));
+    }
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      loop->thread.join();
+    }
+  }
+
+  // Deleted copy constructor.
+  LookupServer(const LookupServer& other) = delete;
+
+  // Deleted move constructor.
+  LookupServer(LookupServer&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  LookupServer& operator=(const LookupServer& other) = delete;
+
+  // Deleted move assignment operator.
+  LookupServer& operator=(LookupServer&& other) noexcept = delete;
+
+  // Whether this server is listening for connections.
+  [[nodiscard]] bool IsListening() const noexcept {
+    return port_ != 0;
+  }
+
+  // Port on which this server listens, or 0 if it is not listening.
+  [[nodiscard]] uint16_t Port() const noexcept {
+    return port_;
+  }
+
+  // Number of requests answered so far.
+  [[nodiscard]] uint64_t RequestCount() const noexcept {
+    return Sum(&Loop::request_count);
+  }
+
+  // Number of lookups refused so far because of a missing or unknown token.
+  [[nodiscard]] uint64_t ForbiddenCount() const noexcept {
+    return Sum(&Loop::forbidden_count);
+  }
+
+  // Number of connections accepted so far.
+  [[nodiscard]] uint64_t ConnectionCount() const noexcept {
+    return Sum(&Loop::connection_count);
+  }
+
+  // Number of connections refused so far because too many connections were open at once.
+  [[nodiscard]] uint64_t RefusedConnectionCount() const noexcept {
+    return Sum(&Loop::refused_connection_count);
+  }
+
+  // Prints a summary of the activity of this server to the console.
+  void PrintStatistics() const {
+    std::cout << "Answered " << RequestCount() << " requests, of which " << ForbiddenCount()
+              << " had a missing or unknown token, over " << ConnectionCount()
+              << " connections (" << RefusedConnectionCount() << " refused)." << std::endl;
+  }
+
+private:
+  // Connection to one client, along with its buffers.
+  struct Connection {
+    // Non-blocking socket of this connection, or a closed socket if this connection is free.
+    Socket socket;
+
+    // Data received but not yet parsed into requests.
+    std::array<char, InputCapacity> input{};
+
+    // Number of bytes in the input buffer.
+    std::size_t input_size{0};
+
+    // Responses waiting to be written, in order.
+    std::array<std::string_view, OutputCapacity> output{};
+
+    // Number of responses waiting to be written.
+    std::size_t output_count{0};
+
+    // Number of bytes of the first response waiting to be written that were already written.
+    std::size_t output_offset{0};
+
+    // Whether the connection is closed once the responses waiting to be written are written.
+    bool closing{false};
+
+    // Whether the event loop waits for this connection to become writable rather than readable.
+    bool writing{false};
+  };
+
+  // Event loop thread along with its pool of connections.
+  struct Loop {
+    // Constructor. Constructs an event loop with a pool of a given number of connections.
+    explicit Loop(const std::size_t connection_count)
+      : epoll(::epoll_create1(EPOLL_CLOEXEC)), wake(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+      epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.ptr = nullptr;
+      ::epoll_ctl(epoll.Descriptor(), EPOLL_CTL_ADD, wake.Descriptor(), &event);
+
+      connections.reserve(connection_count);
+      free_connections.reserve(connection_count);
+      for (std::size_t index = 0; index < connection_count; ++index) {
+        connections.push_back(std::make_unique<Connection>());
+        free_connections.push_back(connections.back().get());
+      }
+    }
+
+    // File descriptor of the epoll instance on which this event loop waits.
+    Socket epoll;
+
+    // File descriptor of the event that wakes up this event loop when the server stops.
+    Socket wake;
+
+    // Pool of connections of this event loop.
+    std::vector<std::unique_ptr<Connection>> connections;
+
+    // Connections of the pool that are not in use.
+    std::vector<Connection*> free_connections;
+
+    // Thread that runs this event loop.
+    std::thread thread;
+
+    // Number of requests answered by this event loop so far.
+    std::atomic<uint64_t> request_count{0};
+
+    // Number of lookups refused by this event loop so far because of a missing or unknown token.
+    std::atomic<uint64_t> forbidden_count{0};
+
+    // Number of connections accepted by this event loop so far.
+    std::atomic<uint64_t> connection_count{0};
+
+    // Number of connections refused by this event loop so far.
+    std::atomic<uint64_t> refused_connection_count{0};
+  };
+
+  // Outcome of writing the responses of a connection.
+  enum class Written : int8_t {
+    // All of the responses were written.
+    All,
+
+    // Some of the responses remain because the socket buffer is full.
+    Blocked,
+
+    // The connection failed.
+    Failed,
+  };
+
+  // Sums a given counter over all event loops.
+  [[nodiscard]] uint64_t Sum(std::atomic<uint64_t> Loop::*counter) const noexcept {
+    uint64_t sum = 0;
+    for (const std::unique_ptr<Loop>& loop : loops_) {
+      sum += ((*loop).*counter).load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  // Runs an event loop until the server stops.
+  void Run(Loop& loop) {
+    std::array<epoll_event, 256> events{};
+    while (true) {
+      const int count = ::epoll_wait(
+          loop.epoll.Descriptor(), events.data(), static_cast<int>(events.size()), -1);
+      for (int index = 0; index < count; ++index) {
+        if (events[index].data.ptr == nullptr) {
+          return;
+        }
+        if (events[index].data.ptr == &listener_) {
+          AcceptConnections(loop);
+          continue;
+        }
+        // A connection that was closed while handling an earlier event of this batch is skipped.
+        Connection& connection = *static_cast<Connection*>(events[index].data.ptr);
+        if (connection.socket.IsOpen()) {
+          Advance(loop, connection);
+        }
+      }
+    }
+  }
+
+  // Accepts the pending connections into the pool of an event loop, closing those for which the
+  // pool has no room.
+  void AcceptConnections(Loop& loop) {
+    while (true) {
+      const int descriptor =
+          ::accept4(listener_.Descriptor(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (descriptor < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) {
+          continue;
+        }
+        return;
+      }
+
+      if (loop.free_connections.empty()) {
+        ::close(descriptor);
+        loop.refused_connection_count.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      // Responses are small and are often the last data sent for a while, so do not delay them.
+      const int enabled = 1;
+      ::setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+
+      Connection& connection = *loop.free_connections.back();
+      loop.free_connections.pop_back();
+      connection.socket = Socket{descriptor};
+      connection.input_size = 0;
+      connection.output_count = 0;
+      connection.output_offset = 0;
+      connection.closing = false;
+      connection.writing = false;
+
+      epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.ptr = &connection;
+      ::epoll_ctl(loop.epoll.Descriptor(), EPOLL_CTL_ADD, descriptor, &event);
+      loop.connection_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Advances a connection as far as it can go without blocking: answers the complete requests in
+  // its input, writes the responses, and reads more requests. Closes the connection once its peer
+  // closes it or once a response that ends it is written.
+  void Advance(Loop& loop, Connection& connection) {
+    while (true) {
+      Answer(loop, connection);
+
+      if (connection.output_count > 0) {
+        const Written written = Write(connection);
+        if (written == Written::Failed) {
+          Close(loop, connection);
+          return;
+        }
+        if (written == Written::Blocked) {
+          Watch(loop, connection, true);
+          return;
+        }
+      }
+
+      if (connection.closing) {
+        Close(loop, connection);
+        return;
+      }
+
+      // A request header that fills the whole input buffer is too large to be answered.
+      if (connection.input_size == connection.input.size()) {
+        const LookupResponse response = index_.RequestTooLarge();
+        connection.output[connection.output_count++] = response.text;
+        connection.closing = true;
+        continue;
+      }
+
+      const ssize_t count = ::recv(connection.socket.Descriptor(),
+                                   connection.input.data() + connection.input_size,
+                                   connection.input.size() - connection.input_size, 0);
+      if (count > 0) {
+        connection.input_size += static_cast<std::size_t>(count);
+        continue;
+      }
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        Watch(loop, connection, false);
+        return;
+      }
+      Close(loop, connection);
+      return;
+    }
+  }
+
+  // Answers the complete requests at the start of the input of a connection, as long as there is
+  // room for their responses, and removes them from the input.
+  void Answer(Loop& loop, Connection& connection) {
+    std::size_t position = 0;
+    while (connection.output_count < connection.output.size() && !connection.closing) {
+      const std::string_view remaining{
+          connection.input.data() + position, connection.input_size - position};
+      const std::size_t length = HeaderLength(remaining);
+      if (length == 0) {
+        break;
+      }
+      const LookupResponse response = index_.Respond(remaining.substr(0, length));
+      connection.output[connection.output_count++] = response.text;
+      connection.closing = response.close;
+      position += length;
+      loop.request_count.fetch_add(1, std::memory_order_relaxed);
+      if (response.status == 403) {
+        loop.forbidden_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (position > 0) {
+      std::memmove(connection.input.data(), connection.input.data() + position,
+                   connection.input_size - position);
+      connection.input_size -= position;
+    }
+  }
+
+  // Writes as many of the responses waiting on a connection as its socket accepts, with one system
+  // call for all of them.
+  [[nodiscard]] static Written Write(Connection& connection) {
+    while (connection.output_count > 0) {
+      std::array<iovec, OutputCapacity> vectors{};
+      for (std::size_t index = 0; index < connection.output_count; ++index) {
+        const std::string_view text =
+            index == 0 ? connection.output[0].substr(connection.output_offset) :
+                         connection.output[index];
+        vectors[index].iov_base = const_cast<char*>(text.data());
+        vectors[index].iov_len = text.size();
+      }
+      msghdr message{};
+      message.msg_iov = vectors.data();
+      message.msg_iovlen = connection.output_count;
+
+      ssize_t count = ::sendmsg(connection.socket.Descriptor(), &message, MSG_NOSIGNAL);
+      if (count < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno == EAGAIN || errno == EWOULDBLOCK ? Written::Blocked : Written::Failed;
+      }
+
+      // Drop the responses that were written in full.
+      std::size_t done = 0;
+      while (done < connection.output_count
+             && static_cast<std::size_t>(count)
+                    >= connection.output[done].size() - connection.output_offset) {
+        count -= static_cast<ssize_t>(connection.output[done].size() - connection.output_offset);
+        connection.output_offset = 0;
+        ++done;
+      }
+      connection.output_offset += static_cast<std::size_t>(count);
+      std::copy(connection.output.begin() + static_cast<std::ptrdiff_t>(done),
+                connection.output.begin() + static_cast<std::ptrdiff_t>(connection.output_count),
+                connection.output.begin());
+      connection.output_count -= done;
+    }
+    return Written::All;
+  }
+
+  // Makes an event loop wait for a connection to become writable, or readable otherwise.
+  static void Watch(Loop& loop, Connection& connection, const bool writing) {
+    if (connection.writing == writing) {
+      return;
+    }
+    connection.writing = writing;
+    epoll_event event{};
+    event.events = writing ? EPOLLOUT : EPOLLIN;
+    event.data.ptr = &connection;
+    ::epoll_ctl(loop.epoll.Descriptor(), EPOLL_CTL_MOD, connection.socket.Descriptor(), &event);
+  }
+
+  // Closes a connection and returns it to the pool of its event loop.
+  static void Close(Loop& loop, Connection& connection) {
+    connection.socket.Close();
+    loop.free_connections.push_back(&connection);
+  }
+
+  // Length of the request header at the start of a given text, up to and including the empty line
+  // that ends it, or 0 if the text does not yet hold a complete request header.
+  [[nodiscard]] static std::size_t HeaderLength(const std::string_view text) noexcept {
+    for (std::size_t line_feed = text.find('\n'); line_feed != std::string_view::npos;
+         line_feed = text.find('\n', line_feed + 1)) {
+      if (line_feed + 1 < text.size() && text[line_feed + 1] == '\n') {
+        return line_feed + 2;
+      }
+      if (line_feed + 2 < text.size() && text[line_feed + 1] == '\r'
+          && text[line_feed + 2] == '\n') {
+        return line_feed + 3;
+      }
+    }
+    return 0;
+  }
+
+  // Index from which requests are answered.
+  const LookupIndex& index_;
+
+  // Non-blocking socket on which this server listens for connections.
+  Socket listener_;
+
+  // Port on which this server listens, or 0 if it is not listening.
+  uint16_t port_{0};
+
+  // Event loops that serve the connections.
+  std::vector<std::unique_ptr<Loop>> loops_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_LOOKUP_SERVER_HPP
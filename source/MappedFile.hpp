@@ -0,0 +1,117 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_MAPPED_FILE_HPP
+#define SECRET_SANTA_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <fcntl.h>
+#include <filesystem>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SecretSanta {
+
+// Read-only memory mapping of a whole file. The pages of the file are read by the kernel as they
+// are first touched, and the kernel is told that they will be read in order so that it reads ahead
+// aggressively. This reads a large file in one pass without copying it into a buffer first.
+class MappedFile {
+public:
+  // Constructor. Maps a given file into memory. The mapping is invalid if the file cannot be
+  // opened or mapped. An empty file yields a valid mapping of no bytes.
+  explicit MappedFile(const std::filesystem::path& path) {
+    const int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+      return;
+    }
+
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+      close(descriptor);
+      return;
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ > 0) {
+      void* const address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (address == MAP_FAILED) {
+        size_ = 0;
+        close(descriptor);
+        return;
+      }
+      madvise(address, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(address);
+    }
+
+    // The mapping stays valid once the file descriptor is closed.
+    close(descriptor);
+    valid_ = true;
+  }
+
+  // Destructor. Unmaps the file.
+  ~MappedFile() noexcept {
+    if (data_ != nullptr) {
+      munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  // Deleted copy constructor.
+  MappedFile(const MappedFile& other) = delete;
+
+  // Deleted move constructor.
+  MappedFile(MappedFile&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  // Deleted move assignment operator.
+  MappedFile& operator=(MappedFile&& other) noexcept = delete;
+
+  // Whether the file was mapped.
+  [[nodiscard]] constexpr bool IsValid() const noexcept {
+    return valid_;
+  }
+
+  // Contents of the file.
+  [[nodiscard]] std::string_view Text() const noexcept {
+    return data_ != nullptr ? std::string_view{data_, size_} : std::string_view{};
+  }
+
+  // Size of the file in bytes.
+  [[nodiscard]] constexpr std::size_t Size() const noexcept {
+    return size_;
+  }
+
+private:
+  // Address of the first byte of the mapping, or null if nothing is mapped.
+  const char* data_{nullptr};
+
+  // Size of the file in bytes.
+  std::size_t size_{0};
+
+  // Whether the file was mapped.
+  bool valid_{false};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_MAPPED_FILE_HPP
@@ -18,70 +18,230 @@
 //     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
 //     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+
 #ifndef SECRET_SANTA_MATCHINGS_HPP
 #define SECRET_SANTA_MATCHINGS_HPP
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <optional>
 #include <random>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <yaml-cpp/yaml.h>
 
+#include "CycleLengths.hpp"
+#include "DistanceMatching.hpp"
+#include "Geography.hpp"
 #include "Participant.hpp"
+#include "RandomRounds.hpp"
+#include "Shard.hpp"
 
 namespace SecretSanta {
 
-// Matchings between gifters and giftees.
+// Reason why given participants cannot be matched, or no value if they can. Every gifter needs a
+// giftee other than themselves, so a lone participant cannot be matched, and neither can a group
+// with a single member if the matchings are aligned to groups.
+[[nodiscard]] std::optional<std::string> UnmatchableReason(
+    const std::set<Participant>& participants, const bool align_to_groups = false) {
+  if (participants.size() == 1) {
+    return "Cannot match the only participant, " + participants.cbegin()->Name()
+           + ", since they would gift to themselves; at least two participants are needed.";
+  }
+  if (!align_to_groups) {
+    return std::nullopt;
+  }
+
+  std::map<std::string, std::vector<std::string>> groups_to_names;
+  for (const Participant& participant : participants) {
+    groups_to_names[participant.Group()].push_back(participant.Name());
+  }
+  std::string lone_participants;
+  for (const std::pair<const std::string, std::vector<std::string>>& group_and_names :
+       groups_to_names) {
+    if (group_and_names.second.size() == 1) {
+      lone_participants.append(lone_participants.empty() ? "" : ", ");
+      lone_participants.append(group_and_names.second.front() + " (group \""
+                               + group_and_names.first + "\")");
+    }
+  }
+  if (lone_participants.empty()) {
+    return std::nullopt;
+  }
+  return "Cannot align the matchings to groups, since the following participants are alone in "
+         "their group and would gift to themselves: "
+         + lone_participants + ". Please move them to another group or do not align to groups.";
+}
+
+// Matchings between gifters and giftees. Each gifter gives one gift per round, and each round is a
+// set of matchings in which every participant gifts once and receives once. With several rounds,
+// no gifter gifts to the same giftee twice.
 class Matchings {
 public:
   // Default constructor. Constructs an empty set of matchings.
   Matchings() = default;
 
-  // Constructor. Constructs matchings given a set of participants and an optional random seed.
-  // Ensures that the matchings are valid.
+  // Constructor. Constructs matchings given a set of participants, an optional random seed,
+  // optional cycle length bounds, whether to align the cycles to the participants' groups, and the
+  // number of gifts that each participant gives and receives. Ensures that the matchings are
+  // valid. If no cycle length bounds are given, the participants form one large cycle, or one
+  // cycle per group if the cycles are aligned to groups. If cycle length bounds are given, the
+  // participants are split into several cycles whose lengths respect the bounds. If the
+  // participants of a group cannot be split within the bounds, they instead form one cycle. Each
+  // round of gifts is randomized in the same way, and then participants are moved between the
+  // positions of the cycles until no pair repeats a pair of an earlier round. Runs in expected time
+  // linear in the number of participants times the number of gifts. If the participants cannot be
+  // matched, as given by UnmatchableReason, prints the reason and constructs empty matchings.
   Matchings(const std::set<Participant>& participants,
-            const std::optional<int64_t>& random_seed = std::nullopt) {
+            const std::optional<int64_t>& random_seed = std::nullopt,
+            const std::optional<CycleLengths>& cycle_lengths = std::nullopt,
+            const bool align_to_groups = false, const std::size_t gift_count = 1)
+    : rounds_(std::max<std::size_t>(gift_count, 1)) {
+    const std::optional<std::string> unmatchable_reason{
+        UnmatchableReason(participants, align_to_groups)};
+    if (unmatchable_reason.has_value()) {
+      std::cout << unmatchable_reason.value() << std::endl;
+      return;
+    }
+
     // Initialize the random generator.
-    std::random_device random_device;
-    std::mt19937_64 random_generator(random_device());
-    if (random_seed.has_value()) {
-      random_generator.seed(random_seed.value());
+    std::mt19937_64 random_generator{CreateRandomGenerator(random_seed)};
+
+    // Obtain the participant names, sorted by group if the cycles are aligned to groups.
+    std::map<std::string, std::vector<std::string>> groups_to_participant_names;
+    for (const Participant& participant : participants) {
+      groups_to_participant_names[align_to_groups ? participant.Group() : std::string{}]
+          .emplace_back(participant.Name());
     }
 
-    // Obtain the participant names.
-    std::vector<std::string> participant_names(participants.size());
-    {
-      std::size_t index = 0;
-      for (const Participant& participant : participants) {
-        participant_names[index] = participant.Name();
-        ++index;
+    std::size_t cycle_count = 0;
+
+    for (const std::pair<const std::string, std::vector<std::string>>&
+             group_and_participant_names : groups_to_participant_names) {
+      const std::vector<std::string>& participant_names = group_and_participant_names.second;
+
+      RandomRounds group_rounds{participant_names.size(), rounds_.size(), cycle_lengths};
+      group_rounds.Draw(random_generator);
+
+      if (group_rounds.RoundCount() < rounds_.size()) {
+        std::cout << "Cannot have the " << participant_names.size() << " participants";
+        if (align_to_groups) {
+          std::cout << " of the group \"" << group_and_participant_names.first << "\"";
+        }
+        std::cout << " each give " << rounds_.size() << " gifts without repeating a giftee; they"
+                  << " each give " << group_rounds.RoundCount() << " gifts instead." << std::endl;
+      }
+      if (!group_rounds.Partitioned()) {
+        std::cout << "Cannot split the " << participant_names.size() << " participants";
+        if (align_to_groups) {
+          std::cout << " of the group \"" << group_and_participant_names.first << "\"";
+        }
+        std::cout << " into cycles of " << cycle_lengths->Minimum() << " to "
+                  << cycle_lengths->Maximum() << " participants; using one cycle instead."
+                  << std::endl;
       }
+      if (group_rounds.Offset()) {
+        std::cout << "Cannot randomize the " << group_rounds.RoundCount()
+                  << " rounds of gifts of the " << participant_names.size() << " participants";
+        if (align_to_groups) {
+          std::cout << " of the group \"" << group_and_participant_names.first << "\"";
+        }
+        std::cout << " independently; offsetting one shuffled order instead." << std::endl;
+      }
+
+      for (std::size_t round = 0; round < group_rounds.RoundCount(); ++round) {
+        const std::vector<std::size_t>& giftees = group_rounds.Giftees(round);
+        for (std::size_t index = 0; index < participant_names.size(); ++index) {
+          rounds_[round].emplace(participant_names[index], participant_names[giftees[index]]);
+        }
+      }
+
+      cycle_count += group_rounds.CycleCount();
+    }
+
+    if (rounds_.size() > 1) {
+      std::cout << "Randomized " << rounds_.size()
+                << " rounds of matchings between gifters and giftees, such that each gifter gives "
+                << rounds_.size() << " gifts." << std::endl;
+    } else if (cycle_lengths.has_value() || align_to_groups) {
+      std::cout << "Randomized the matchings between gifters and giftees into " << cycle_count
+                << " cycles." << std::endl;
+    } else {
+      std::cout << "Randomized the matchings between gifters and giftees." << std::endl;
+    }
+  }
+
+  // Constructor. Constructs matchings that minimize the shipping distance between gifters and
+  // giftees, given a set of participants, a table of the coordinates of postal codes, the options
+  // of the distance matching, an optional random seed, and whether to align the matchings to the
+  // participants' groups. Each participant's location is either coordinates or a postal code of
+  // the table. The cycles are whatever the shortest shipping distances lead to, which are often
+  // pairs of nearby participants who gift to each other. Participants whose location is unknown
+  // are matched at random. If the participants cannot be matched, as given by UnmatchableReason,
+  // prints the reason and constructs empty matchings.
+  Matchings(const std::set<Participant>& participants, const PostalCodeTable& postal_codes,
+            const DistanceMatchingOptions& options,
+            const std::optional<int64_t>& random_seed = std::nullopt,
+            const bool align_to_groups = false) {
+    const std::optional<std::string> unmatchable_reason{
+        UnmatchableReason(participants, align_to_groups)};
+    if (unmatchable_reason.has_value()) {
+      std::cout << unmatchable_reason.value() << std::endl;
+      return;
     }
 
-    // Shuffle the participant names.
-    std::shuffle(participant_names.begin(), participant_names.end(), random_generator);
+    std::mt19937_64 random_generator{CreateRandomGenerator(random_seed)};
+
+    std::map<std::string, std::vector<const Participant*>> groups_to_participants;
+    for (const Participant& participant : participants) {
+      groups_to_participants[align_to_groups ? participant.Group() : std::string{}].push_back(
+          &participant);
+    }
 
-    // Create the matchings between gifters and giftees. Each participant in the shuffled sequence
-    // is a gifter, and their giftee is the next participant in the shuffled sequence. This results
-    // in one large cyclic list rather than a graph and guarantees that gifters cannot be their own
-    // giftees. For example, consider the sequence [Alice, Bob, Claire, David]. After shuffling,
-    // suppose this sequence is [Claire, Bob, David, Alice]. The matchings are thus: Claire->Bob,
-    // Bob->David, David->Alice, and Alice->Claire.
-    for (std::size_t gifter_index = 0; gifter_index < participant_names.size(); ++gifter_index) {
-      const std::size_t giftee_index =
-          gifter_index + 1 < participant_names.size() ? gifter_index + 1 : 0;
+    std::size_t unknown_count = 0;
+    double total_kilometers = 0.0;
+    double maximum_kilometers = 0.0;
+    for (const std::pair<const std::string, std::vector<const Participant*>>&
+             group_and_participants : groups_to_participants) {
+      const std::vector<const Participant*>& group = group_and_participants.second;
+
+      std::vector<std::optional<Coordinates>> locations;
+      locations.reserve(group.size());
+      for (const Participant* participant : group) {
+        locations.push_back(ResolveLocation(participant->Location(), postal_codes));
+        if (!locations.back().has_value()) {
+          ++unknown_count;
+        }
+      }
 
-      gifters_to_giftees_.emplace(participant_names[gifter_index], participant_names[giftee_index]);
+      const DistanceMatchingResult result{MatchByDistance(locations, options, random_generator)};
+      for (std::size_t index = 0; index < group.size(); ++index) {
+        rounds_.front().emplace(group[index]->Name(), group[result.giftees[index]]->Name());
+      }
+      total_kilometers += result.total_kilometers;
+      maximum_kilometers = std::max(maximum_kilometers, result.maximum_kilometers);
     }
 
-    std::cout << "Randomized the matchings between gifters and giftees." << std::endl;
+    if (unknown_count > 0) {
+      std::cout << "The location of " << unknown_count
+                << " participants is unknown, so they were matched at random." << std::endl;
+    }
+    std::cout << "Matched gifters with giftees so as to minimize the "
+              << DistanceObjectiveName(options.objective) << " shipping distance: "
+              << static_cast<int64_t>(std::llround(total_kilometers)) << " km in total and "
+              << static_cast<int64_t>(std::llround(maximum_kilometers)) << " km at most."
+              << std::endl;
   }
 
-  // Constructor. Constructs matchings by reading them from a given YAML file.
+  // Constructor. Constructs matchings by reading them from a given YAML file. Each entry maps a
+  // gifter either to one giftee or to a sequence of giftees, one per round of gifts.
   explicit Matchings(const std::filesystem::path& path) {
     if (!std::filesystem::exists(path)) {
       std::cout << "Cannot find the YAML matchings file at " << path
@@ -99,17 +259,36 @@ public:
     YAML::Node gifters_to_giftees = root["gifters_to_giftees"];
 
     if (gifters_to_giftees && gifters_to_giftees.IsSequence()) {
+      std::size_t entry = 0;
       for (YAML::iterator gifter_to_giftee = gifters_to_giftees.begin();
            gifter_to_giftee != gifters_to_giftees.end(); ++gifter_to_giftee) {
-        if (gifter_to_giftee->size() == 1 && gifter_to_giftee->IsMap()) {
-          gifters_to_giftees_.emplace(gifter_to_giftee->begin()->first.as<std::string>(),
-                                      gifter_to_giftee->begin()->second.as<std::string>());
+        ++entry;
+        const std::optional<std::vector<std::string>> giftees =
+            gifter_to_giftee->size() == 1 && gifter_to_giftee->IsMap() ?
+                ReadGiftees(gifter_to_giftee->begin()->second) :
+                std::nullopt;
+        if (!giftees.has_value()) {
+          std::cout << "Skipped the malformed entry " << entry
+                    << " of the YAML matchings file at: " << path << std::endl;
+          continue;
+        }
+        const std::string gifter = gifter_to_giftee->begin()->first.as<std::string>();
+        if (rounds_.front().count(gifter) > 0) {
+          std::cout << "Skipped the duplicate entry " << entry << " for the gifter " << gifter
+                    << " of the YAML matchings file at: " << path << std::endl;
+          continue;
+        }
+        if (rounds_.size() < giftees->size()) {
+          rounds_.resize(giftees->size());
+        }
+        for (std::size_t round = 0; round < giftees->size(); ++round) {
+          rounds_[round].emplace(gifter, giftees.value()[round]);
         }
       }
     }
 
     std::cout
-        << "Read " << gifters_to_giftees_.size()
+        << "Read " << rounds_.front().size()
         << " matchings between gifters and giftees from the YAML file at: " << path << std::endl;
   }
 
@@ -128,21 +307,188 @@ public:
   // Deleted move assignment operator.
   Matchings& operator=(Matchings&& other) noexcept = delete;
 
-  // Map of gifter participant names to giftee participant names. For example, the map element
-  // {Alice, Bob} means that Alice is the gifter and Bob is the giftee, such that Alice is Bob's
-  // Secret Santa.
+  // Map of gifter participant names to giftee participant names in the first round of gifts. For
+  // example, the map element {Alice, Bob} means that Alice is the gifter and Bob is the giftee,
+  // such that Alice is Bob's Secret Santa.
   [[nodiscard]] const std::map<std::string, std::string>& GiftersToGiftees() const noexcept {
-    return gifters_to_giftees_;
+    return rounds_.front();
   }
 
-  // Write these matchings to a given YAML file.
-  void Write(const std::filesystem::path& path) const {
+  // Maps of gifter participant names to giftee participant names, one per round of gifts. Always
+  // contains at least one round.
+  [[nodiscard]] const std::vector<std::map<std::string, std::string>>& Rounds() const noexcept {
+    return rounds_;
+  }
+
+  // Number of gifts that each participant gives and receives, which is the number of rounds.
+  [[nodiscard]] std::size_t GiftCount() const noexcept {
+    return rounds_.size();
+  }
+
+  // Returns the names of the giftees of a given gifter, one per round of gifts in which the gifter
+  // appears. Returns an empty list if the gifter does not appear in the matchings.
+  [[nodiscard]] std::vector<std::string> Giftees(const std::string& gifter) const {
+    std::vector<std::string> giftees;
+    for (const std::map<std::string, std::string>& round : rounds_) {
+      const std::map<std::string, std::string>::const_iterator gifter_and_giftee =
+          round.find(gifter);
+      if (gifter_and_giftee != round.cend()) {
+        giftees.push_back(gifter_and_giftee->second);
+      }
+    }
+    return giftees;
+  }
+
+  // Returns the names of the gifters whose giftees differ from a given previous set of matchings,
+  // including gifters who did not appear in the previous matchings. These are the only gifters who
+  // need to be notified again after the matchings are updated. Runs in one merge pass over the
+  // sorted gifter names of both matchings per round of gifts.
+  [[nodiscard]] std::set<std::string> ChangedGifters(const Matchings& previous) const {
+    const std::map<std::string, std::string> no_matchings;
+    std::set<std::string> changed_gifters;
+    for (std::size_t round = 0; round < rounds_.size(); ++round) {
+      const std::map<std::string, std::string>& previous_round =
+          round < previous.rounds_.size() ? previous.rounds_[round] : no_matchings;
+      std::map<std::string, std::string>::const_iterator previous_gifter_and_giftee =
+          previous_round.cbegin();
+      for (const std::pair<const std::string, std::string>& gifter_and_giftee : rounds_[round]) {
+        while (previous_gifter_and_giftee != previous_round.cend()
+               && previous_gifter_and_giftee->first < gifter_and_giftee.first) {
+          ++previous_gifter_and_giftee;
+        }
+        if (previous_gifter_and_giftee == previous_round.cend()
+            || previous_gifter_and_giftee->first != gifter_and_giftee.first
+            || previous_gifter_and_giftee->second != gifter_and_giftee.second) {
+          changed_gifters.insert(gifter_and_giftee.first);
+        }
+      }
+    }
+    return changed_gifters;
+  }
+
+  // Returns the names of the gifters of any round of gifts who belong to a given shard. Hosts that
+  // read the same matchings and are given different shards of the same number of shards get
+  // disjoint sets of gifters that together cover every gifter.
+  [[nodiscard]] std::set<std::string> ShardGifters(const Shard& shard) const {
+    std::set<std::string> gifters;
+    for (const std::map<std::string, std::string>& round : rounds_) {
+      for (const std::pair<const std::string, std::string>& gifter_and_giftee : round) {
+        if (shard.Contains(gifter_and_giftee.first)) {
+          gifters.insert(gifter_and_giftee.first);
+        }
+      }
+    }
+    return gifters;
+  }
+
+  // Updates these matchings to a new set of participants with as few changes as possible, such as
+  // when participants join or drop out after the matchings were already sent. Each round of gifts
+  // is updated in turn. Each participant who dropped out is spliced out of their cycle, such that
+  // their gifter now gifts to their giftee. If this leaves a gifter alone in their cycle, that
+  // gifter is reinserted like a newcomer. Each newcomer is inserted into a random existing cycle
+  // after a random gifter, who now gifts to the newcomer, who in turn gifts to that gifter's
+  // previous giftee. If the cycles are aligned to groups, newcomers are only inserted into cycles
+  // of their own group. If cycle length bounds are given, newcomers are only inserted into cycles
+  // shorter than the maximum length; when every cycle of their group is full, they start a new
+  // cycle together, which may be shorter than the minimum length, and a newcomer who would be
+  // alone in it joins a full cycle instead. With several rounds, a splice or insertion that would
+  // repeat a pair of another round is avoided by trying other gifters or by swapping giftees with
+  // another gifter. All other matchings are left untouched. Returns the names of the gifters whose
+  // giftees changed, which are the only gifters who need to be notified again. Apart from one pass
+  // over the matchings and the participants, which finds who joined and who dropped out, lists the
+  // gifters of each group, and indexes the gifter of each giftee on the first update, the work is
+  // proportional to the number of changes times the maximum cycle length.
+  std::set<std::string> Update(const std::set<Participant>& participants,
+                               const std::optional<int64_t>& random_seed = std::nullopt,
+                               const std::optional<CycleLengths>& cycle_lengths = std::nullopt,
+                               const bool align_to_groups = false) {
+    if (giftees_to_gifters_.size() != rounds_.size()) {
+      IndexGifters();
+    }
+
+    // Find the participants who dropped out and the newcomers in one merge pass over the sorted
+    // names of the gifters and of the participants. The gifters who remain are listed by group.
+    std::vector<std::string> removed_names;
+    std::vector<std::string> added_names;
+    std::map<std::string, std::vector<const std::string*>> groups_to_gifter_names;
+    {
+      std::map<std::string, std::string>::const_iterator gifter_and_giftee =
+          rounds_.front().cbegin();
+      std::set<Participant>::const_iterator participant = participants.cbegin();
+      while (gifter_and_giftee != rounds_.front().cend() || participant != participants.cend()) {
+        if (participant == participants.cend()
+            || (gifter_and_giftee != rounds_.front().cend()
+                && gifter_and_giftee->first < participant->Name())) {
+          removed_names.push_back(gifter_and_giftee->first);
+          ++gifter_and_giftee;
+        } else if (gifter_and_giftee == rounds_.front().cend()
+                   || participant->Name() < gifter_and_giftee->first) {
+          added_names.push_back(participant->Name());
+          ++participant;
+        } else {
+          groups_to_gifter_names[align_to_groups ? participant->Group() : std::string{}].push_back(
+              &participant->Name());
+          ++gifter_and_giftee;
+          ++participant;
+        }
+      }
+    }
+
+    std::set<std::string> changed_gifters;
+
+    if (removed_names.empty() && added_names.empty()) {
+      std::cout << "The matchings between gifters and giftees are already up to date." << std::endl;
+      return changed_gifters;
+    }
+
+    std::mt19937_64 random_generator{CreateRandomGenerator(random_seed)};
+
+    const std::function<std::string(const std::string&)> group_of =
+        [&](const std::string& name) -> std::string {
+      if (!align_to_groups) {
+        return {};
+      }
+      const std::set<Participant>::const_iterator participant =
+          participants.find(Participant{name});
+      return participant != participants.cend() ? participant->Group() : std::string{};
+    };
+
+    for (std::size_t round = 0; round < rounds_.size(); ++round) {
+      const std::set<std::string> round_changed_gifters{
+          UpdateRound(round, removed_names, added_names, group_of, groups_to_gifter_names,
+                      cycle_lengths, random_generator)};
+      changed_gifters.insert(round_changed_gifters.cbegin(), round_changed_gifters.cend());
+    }
+
+    for (const std::string& changed_gifter : changed_gifters) {
+      for (const std::string& giftee : Giftees(changed_gifter)) {
+        if (giftee == changed_gifter) {
+          std::cout << "Cannot find another participant to match with " << changed_gifter
+                    << "; this participant is their own giftee." << std::endl;
+          break;
+        }
+      }
+    }
+
+    std::cout << "Updated the matchings between gifters and giftees: " << removed_names.size()
+              << " participants dropped out, " << added_names.size()
+              << " participants joined, and " << changed_gifters.size()
+              << " gifters have a new giftee." << std::endl;
+
+    return changed_gifters;
+  }
+
+  // Write these matchings to a given YAML file. Each gifter with one giftee is written as
+  // "<gifter>: <giftee>", and each gifter with several giftees as "<gifter>: [<giftee>, ...]".
+  // Returns whether the file was written, or true if the path is empty.
+  bool Write(const std::filesystem::path& path) const {
     if (path.empty()) {
-      return;
+      return true;
     }
 
     if (!path.parent_path().empty()) {
-      std::filesystem::create_directories(path.parent_path());
+      std::error_code error;
+      std::filesystem::create_directories(path.parent_path(), error);
     }
 
     std::ofstream stream;
@@ -152,25 +498,17 @@ public:
       if (!stream.is_open()) {
         std::cout << "Could not open the YAML matchings file for writing at: " << path.string()
                   << std::endl;
-        return;
+        return false;
       }
     }
 
-    YAML::Emitter emitter;
-    emitter << YAML::BeginMap;
-    emitter << YAML::Key << "gifters_to_giftees";
-    emitter << YAML::Value << YAML::BeginSeq;
-
-    for (const std::pair<const std::string, std::string>& gifter_and_giftee : gifters_to_giftees_) {
-      YAML::Node node;
-      node[gifter_and_giftee.first] = gifter_and_giftee.second;
-      emitter << node;
+    stream << Yaml();
+    stream.flush();
+    if (!stream.good()) {
+      std::cout << "Could not write the YAML matchings file at: " << path.string() << std::endl;
+      return false;
     }
 
-    emitter << YAML::EndSeq << YAML::EndMap;
-
-    stream << emitter.c_str();
-
     if (std::filesystem::exists(path)) {
       std::filesystem::permissions(
           path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write
@@ -183,37 +521,376 @@ public:
 
     std::cout << "Wrote the matchings between gifters and giftees to the YAML file: " << path
               << std::endl;
+    return true;
+  }
+
+  // Text of these matchings in the format of a YAML matchings file, as written by Write. The
+  // entries are emitted directly rather than built as YAML nodes first, which costs several times
+  // less.
+  [[nodiscard]] std::string Yaml() const {
+    YAML::Emitter emitter;
+    emitter << YAML::BeginMap;
+    emitter << YAML::Key << "gifters_to_giftees";
+    emitter << YAML::Value << YAML::BeginSeq;
+
+    for (const std::pair<const std::string, std::string>& gifter_and_giftee : rounds_.front()) {
+      emitter << YAML::BeginMap << YAML::Key << gifter_and_giftee.first << YAML::Value;
+      if (rounds_.size() == 1) {
+        emitter << gifter_and_giftee.second;
+      } else {
+        emitter << YAML::Flow << Giftees(gifter_and_giftee.first);
+      }
+      emitter << YAML::EndMap;
+    }
+
+    emitter << YAML::EndSeq << YAML::EndMap;
+
+    return emitter.c_str();
   }
 
   inline bool operator==(const Matchings& other) const noexcept {
-    return gifters_to_giftees_ == other.gifters_to_giftees_;
+    return rounds_ == other.rounds_;
   }
 
   inline bool operator!=(const Matchings& other) const noexcept {
-    return gifters_to_giftees_ != other.gifters_to_giftees_;
+    return rounds_ != other.rounds_;
   }
 
   inline bool operator<(const Matchings& other) const noexcept {
-    return gifters_to_giftees_ < other.gifters_to_giftees_;
+    return rounds_ < other.rounds_;
   }
 
   inline bool operator>(const Matchings& other) const noexcept {
-    return gifters_to_giftees_ > other.gifters_to_giftees_;
+    return rounds_ > other.rounds_;
   }
 
   inline bool operator<=(const Matchings& other) const noexcept {
-    return gifters_to_giftees_ <= other.gifters_to_giftees_;
+    return rounds_ <= other.rounds_;
   }
 
   inline bool operator>=(const Matchings& other) const noexcept {
-    return gifters_to_giftees_ >= other.gifters_to_giftees_;
+    return rounds_ >= other.rounds_;
   }
 
 private:
-  // Map of gifter participant names to giftee participant names. For example, the map element
-  // {Alice, Bob} means that Alice is the gifter and Bob is the giftee, such that Alice is Bob's
-  // Secret Santa.
-  std::map<std::string, std::string> gifters_to_giftees_;
+  // Maximum number of random gifters tried when inserting a newcomer or swapping a giftee without
+  // repeating a pair of another round of gifts.
+  static constexpr std::size_t MaximumAttemptCount{32};
+
+  // Creates a random generator seeded with a given seed value, or with a random seed value if no
+  // seed value is given. The random device is only opened when it is needed, since opening it costs
+  // more than drawing small matchings.
+  [[nodiscard]] static std::mt19937_64 CreateRandomGenerator(
+      const std::optional<int64_t>& random_seed) {
+    if (random_seed.has_value()) {
+      return std::mt19937_64(random_seed.value());
+    }
+    std::random_device random_device;
+    return std::mt19937_64(random_device());
+  }
+
+  // Reads the giftees of one entry of a YAML matchings file, which is either one giftee or a
+  // non-empty sequence of giftees. Returns nothing if the entry is malformed.
+  [[nodiscard]] static std::optional<std::vector<std::string>> ReadGiftees(
+      const YAML::Node& node) {
+    if (node.IsScalar()) {
+      return std::vector<std::string>{node.Scalar()};
+    }
+    if (!node.IsSequence() || node.size() == 0) {
+      return std::nullopt;
+    }
+    std::vector<std::string> giftees;
+    for (const YAML::Node& giftee : node) {
+      if (!giftee.IsScalar()) {
+        return std::nullopt;
+      }
+      giftees.push_back(giftee.Scalar());
+    }
+    return giftees;
+  }
+
+  // Whether a given gifter gifts to a given giftee in any round of gifts other than a given one.
+  [[nodiscard]] bool IsRepeated(
+      const std::size_t round, const std::string& gifter, const std::string& giftee) const {
+    for (std::size_t other_round = 0; other_round < rounds_.size(); ++other_round) {
+      if (other_round == round) {
+        continue;
+      }
+      const std::map<std::string, std::string>::const_iterator gifter_and_giftee =
+          rounds_[other_round].find(gifter);
+      if (gifter_and_giftee != rounds_[other_round].cend() && gifter_and_giftee->second == giftee) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Indexes the gifter of each giftee of each round.
+  void IndexGifters() {
+    giftees_to_gifters_.assign(rounds_.size(), {});
+    for (std::size_t round = 0; round < rounds_.size(); ++round) {
+      giftees_to_gifters_[round].reserve(rounds_[round].size());
+      for (const std::pair<const std::string, std::string>& gifter_and_giftee : rounds_[round]) {
+        giftees_to_gifters_[round][gifter_and_giftee.second] = gifter_and_giftee.first;
+      }
+    }
+  }
+
+  // Matches a given gifter with a given giftee in a given round, and indexes the gifter of the
+  // giftee.
+  void Link(const std::size_t round, const std::string& gifter, const std::string& giftee) {
+    rounds_[round][gifter] = giftee;
+    giftees_to_gifters_[round][giftee] = gifter;
+  }
+
+  // Whether the cycle of a given gifter in a given round has fewer than a given number of
+  // participants. Walks at most that many steps along the cycle.
+  [[nodiscard]] bool IsCycleShorterThan(
+      const std::size_t round, const std::string& gifter, const std::size_t length) const {
+    const std::string* current = &gifter;
+    for (std::size_t step = 1; step < length; ++step) {
+      const std::map<std::string, std::string>::const_iterator gifter_and_giftee =
+          rounds_[round].find(*current);
+      if (gifter_and_giftee == rounds_[round].cend()) {
+        return false;
+      }
+      current = &gifter_and_giftee->second;
+      if (*current == gifter) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Updates one round of gifts given the names of the participants who dropped out and of the
+  // newcomers, the group of each participant, the gifters who remain in each group, the cycle
+  // length bounds, and a random generator. Returns the names of the gifters whose giftee changed
+  // in this round.
+  std::set<std::string> UpdateRound(
+      const std::size_t round, const std::vector<std::string>& removed_names,
+      std::vector<std::string> added_names,
+      const std::function<std::string(const std::string&)>& group_of,
+      const std::map<std::string, std::vector<const std::string*>>& groups_to_gifter_names,
+      const std::optional<CycleLengths>& cycle_lengths, std::mt19937_64& random_generator) {
+    std::map<std::string, std::string>& gifters_to_giftees = rounds_[round];
+    std::unordered_map<std::string, std::string>& giftees_to_gifters = giftees_to_gifters_[round];
+    std::set<std::string> changed_gifters;
+
+    // Maximum number of participants of a cycle that a newcomer may join. The largest value of a
+    // size means that the length of a cycle is not bounded.
+    const std::size_t maximum_length{cycle_lengths.has_value() ?
+                                         cycle_lengths->Maximum() :
+                                         std::numeric_limits<std::size_t>::max()};
+    const bool bounded{maximum_length < std::numeric_limits<std::size_t>::max()};
+
+    // Splice each participant who dropped out out of their cycle.
+    for (const std::string& removed_name : removed_names) {
+      const std::map<std::string, std::string>::iterator removed_and_giftee =
+          gifters_to_giftees.find(removed_name);
+      if (removed_and_giftee == gifters_to_giftees.end()) {
+        continue;
+      }
+      const std::string giftee_name = removed_and_giftee->second;
+      gifters_to_giftees.erase(removed_and_giftee);
+
+      const std::unordered_map<std::string, std::string>::iterator removed_and_gifter =
+          giftees_to_gifters.find(removed_name);
+      if (removed_and_gifter == giftees_to_gifters.end()) {
+        const std::unordered_map<std::string, std::string>::iterator giftee_and_gifter =
+            giftees_to_gifters.find(giftee_name);
+        if (giftee_and_gifter != giftees_to_gifters.end()
+            && giftee_and_gifter->second == removed_name) {
+          giftees_to_gifters.erase(giftee_and_gifter);
+        }
+        continue;
+      }
+      const std::string gifter_name = removed_and_gifter->second;
+      giftees_to_gifters.erase(removed_and_gifter);
+
+      if (gifter_name == removed_name) {
+        continue;
+      }
+
+      Link(round, gifter_name, giftee_name);
+      changed_gifters.insert(gifter_name);
+    }
+
+    // Gifters who dropped out after their giftee changed need not be notified, and gifters who are
+    // now alone in their cycle must be reinserted like newcomers. They stay matched with themselves
+    // until then, so that a newcomer may also join them.
+    for (std::set<std::string>::iterator changed_gifter = changed_gifters.begin();
+         changed_gifter != changed_gifters.end();) {
+      const std::map<std::string, std::string>::iterator gifter_and_giftee =
+          gifters_to_giftees.find(*changed_gifter);
+      if (gifter_and_giftee == gifters_to_giftees.end()) {
+        changed_gifter = changed_gifters.erase(changed_gifter);
+        continue;
+      }
+      if (gifter_and_giftee->second == gifter_and_giftee->first) {
+        added_names.push_back(*changed_gifter);
+      }
+      ++changed_gifter;
+    }
+
+    // Newcomers of this round by group, who are gifters that the lists of remaining gifters do not
+    // have, and the newcomer of each group whose new cycle still has room, if any.
+    std::map<std::string, std::vector<const std::string*>> groups_to_added_names;
+    std::map<std::string, const std::string*> groups_to_open_gifter_names;
+    const std::vector<const std::string*> no_gifter_names;
+
+    // Returns a random gifter of a given group, or nullptr if the group has no gifter.
+    const std::function<const std::string*(const std::string&)> random_gifter_name =
+        [&](const std::string& group) -> const std::string* {
+      const std::map<std::string, std::vector<const std::string*>>::const_iterator remaining =
+          groups_to_gifter_names.find(group);
+      const std::vector<const std::string*>& remaining_names =
+          remaining != groups_to_gifter_names.cend() ? remaining->second : no_gifter_names;
+      const std::vector<const std::string*>& added_gifter_names = groups_to_added_names[group];
+      const std::size_t count = remaining_names.size() + added_gifter_names.size();
+      if (count == 0) {
+        return nullptr;
+      }
+      const std::size_t index =
+          std::uniform_int_distribution<std::size_t>(0, count - 1)(random_generator);
+      return index < remaining_names.size() ? remaining_names[index] :
+                                              added_gifter_names[index - remaining_names.size()];
+    };
+
+    // Inserts a given newcomer after a given gifter.
+    const std::function<void(const std::string&, const std::string&)> insert =
+        [&](const std::string& gifter_name, const std::string& added_name) {
+      const std::string previous_giftee_name = gifters_to_giftees.at(gifter_name);
+      Link(round, gifter_name, added_name);
+      Link(round, added_name, previous_giftee_name);
+      changed_gifters.insert(gifter_name);
+      changed_gifters.insert(added_name);
+    };
+
+    // Insert each newcomer into a random cycle after a random gifter, or start a new cycle if there
+    // is no suitable cycle. Later newcomers may be inserted after earlier ones.
+    std::shuffle(added_names.begin(), added_names.end(), random_generator);
+    std::vector<const std::string*> lone_names;
+    for (const std::string& added_name : added_names) {
+      // A gifter alone in their cycle may have been joined by an earlier newcomer already.
+      const std::map<std::string, std::string>::const_iterator lone_and_giftee =
+          gifters_to_giftees.find(added_name);
+      const bool lone = lone_and_giftee != gifters_to_giftees.cend();
+      if (lone && lone_and_giftee->second != added_name) {
+        continue;
+      }
+      const std::string group{group_of(added_name)};
+
+      const std::string* gifter_name = nullptr;
+      const std::string* fallback_name = nullptr;
+      for (std::size_t attempt = 0; attempt < MaximumAttemptCount; ++attempt) {
+        const std::string* candidate_name = random_gifter_name(group);
+        if (candidate_name == nullptr) {
+          break;
+        }
+        if (*candidate_name == added_name) {
+          continue;
+        }
+        if (IsRepeated(round, *candidate_name, added_name)
+            || IsRepeated(round, added_name, gifters_to_giftees.at(*candidate_name))) {
+          fallback_name = candidate_name;
+          continue;
+        }
+        if (bounded && !IsCycleShorterThan(round, *candidate_name, maximum_length)) {
+          continue;
+        }
+        gifter_name = candidate_name;
+        break;
+      }
+
+      if (gifter_name == nullptr && bounded) {
+        // Every cycle that was tried is full, so join or start the new cycle of this group.
+        const std::map<std::string, const std::string*>::const_iterator open =
+            groups_to_open_gifter_names.find(group);
+        if (open != groups_to_open_gifter_names.cend()
+            && IsCycleShorterThan(round, *open->second, maximum_length)) {
+          gifter_name = open->second;
+        }
+      } else if (gifter_name == nullptr) {
+        gifter_name = fallback_name;
+      }
+
+      if (gifter_name != nullptr) {
+        insert(*gifter_name, added_name);
+      } else {
+        if (!lone) {
+          Link(round, added_name, added_name);
+          changed_gifters.insert(added_name);
+        }
+        groups_to_open_gifter_names[group] = &added_name;
+        lone_names.push_back(&added_name);
+      }
+      if (!lone) {
+        groups_to_added_names[group].push_back(&added_name);
+      }
+    }
+
+    // A newcomer who is still alone in their new cycle joins a full cycle rather than gift to
+    // themselves.
+    for (const std::string* lone_name : lone_names) {
+      if (gifters_to_giftees.at(*lone_name) != *lone_name) {
+        continue;
+      }
+      const std::string group{group_of(*lone_name)};
+      for (std::size_t attempt = 0; attempt < MaximumAttemptCount; ++attempt) {
+        const std::string* candidate_name = random_gifter_name(group);
+        if (candidate_name == nullptr) {
+          break;
+        }
+        if (*candidate_name != *lone_name) {
+          insert(*candidate_name, *lone_name);
+          break;
+        }
+      }
+    }
+
+    // Swap the giftee of each changed gifter who now repeats a pair of another round with the
+    // giftee of a random gifter of the same group.
+    if (rounds_.size() > 1) {
+      const std::vector<std::string> gifters_to_check{changed_gifters.cbegin(),
+                                                      changed_gifters.cend()};
+      for (const std::string& gifter_name : gifters_to_check) {
+        std::string& giftee_name = gifters_to_giftees.at(gifter_name);
+        if (!IsRepeated(round, gifter_name, giftee_name)) {
+          continue;
+        }
+        for (std::size_t attempt = 0; attempt < MaximumAttemptCount; ++attempt) {
+          const std::string* other_gifter_name = random_gifter_name(group_of(gifter_name));
+          if (other_gifter_name == nullptr) {
+            break;
+          }
+          std::string& other_giftee_name = gifters_to_giftees.at(*other_gifter_name);
+          if (*other_gifter_name != gifter_name && other_giftee_name != gifter_name
+              && giftee_name != *other_gifter_name
+              && !IsRepeated(round, gifter_name, other_giftee_name)
+              && !IsRepeated(round, *other_gifter_name, giftee_name)) {
+            std::swap(giftee_name, other_giftee_name);
+            giftees_to_gifters[giftee_name] = gifter_name;
+            giftees_to_gifters[other_giftee_name] = *other_gifter_name;
+            changed_gifters.insert(*other_gifter_name);
+            break;
+          }
+        }
+      }
+    }
+
+    return changed_gifters;
+  }
+
+  // Maps of gifter participant names to giftee participant names, one per round of gifts. For
+  // example, the map element {Alice, Bob} means that Alice is the gifter and Bob is the giftee in
+  // that round, such that Alice is one of Bob's Secret Santas.
+  std::vector<std::map<std::string, std::string>> rounds_ =
+      std::vector<std::map<std::string, std::string>>(1);
+
+  // Maps of giftee participant names to gifter participant names, one per round of gifts. Built by
+  // the first update of these matchings and kept up to date by later ones, so that the gifter of a
+  // participant who dropped out is found without scanning every gifter.
+  std::vector<std::unordered_map<std::string, std::string>> giftees_to_gifters_;
 };
 
 }  // namespace SecretSanta
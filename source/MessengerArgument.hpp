@@ -37,13 +37,99 @@ static const std::string Configuration{"--configuration"};
 // Path to the YAML matchings file to be read. Required.
 static const std::string Matchings{"--matchings"};
 
+// Path to a previous YAML matchings file. Only gifters whose giftee changed are sent a message.
+// Optional.
+static const std::string PreviousMatchings{"--previous-matchings"};
+
+// Verifies the matchings against the configuration and exits without sending any messages.
+// Optional.
+static const std::string Verify{"--verify"};
+
+// Host and port of a mail server to which the email messages are sent directly over SMTP rather
+// than through the S-nail utility. Optional.
+static const std::string Smtp{"--smtp"};
+
+// Email address from which the email messages are sent over SMTP. Optional.
+static const std::string From{"--from"};
+
+// Number of connections to the mail server over which the email messages are sent. Optional.
+static const std::string Connections{"--connections"};
+
+// Number of event loop threads that multiplex the connections to the mail server. Optional.
+static const std::string EventLoops{"--event-loops"};
+
+// Encrypts every connection to the mail server with TLS from its start. Optional.
+static const std::string Tls{"--tls"};
+
+// Path to a PEM file of the certificate authorities trusted to sign the certificate of the mail
+// server, instead of the system's certificate authorities. Optional.
+static const std::string CaFile{"--ca-file"};
+
+// Maximum number of attempts to send each email message whose delivery fails transiently.
+// Optional.
+static const std::string Attempts{"--attempts"};
+
+// Path to the YAML dead-letter file to which the email messages that could not be sent are written.
+// Optional.
+static const std::string DeadLetters{"--dead-letters"};
+
+// Path to a YAML dead-letter file whose email messages are sent again instead of composing email
+// messages from the configuration and matchings. Optional.
+static const std::string Replay{"--replay"};
+
+// Path to a spool directory into which the email messages are written as files instead of being
+// sent. Optional.
+static const std::string Spool{"--spool"};
+
+// Path to a spool directory whose email messages are sent instead of composing email messages from
+// the configuration and matchings. Optional.
+static const std::string SendSpool{"--send-spool"};
+
+// Local time of day at which each gifter's email message is sent, in the gifter's time zone.
+// Optional.
+static const std::string SendAt{"--send-at"};
+
+// Path to the YAML schedule file in which the email messages waiting for their time of day are
+// kept. Optional.
+static const std::string Schedule{"--schedule"};
+
+// Index and number of the shard of the gifters whose email messages are sent, so that several hosts
+// can each send the email messages of one shard. Optional.
+static const std::string Shard{"--shard"};
+
+// Path to the YAML outcome file to which the final outcome of every email message is written.
+// Optional.
+static const std::string Outcomes{"--outcomes"};
+
+// Path to a YAML outcome file to be merged into a run report instead of sending email messages.
+// Can be specified several times. Optional.
+static const std::string Merge{"--merge"};
+
+// Path to the YAML run report file to which the merged outcome files are written. Optional.
+static const std::string Report{"--report"};
+
 }  // namespace Key
 
 namespace Value {
 
+// Host name or address and port, separated by a colon.
+static const std::string HostAndPort{"<host:port>"};
+
+// Email address.
+static const std::string Address{"<address>"};
+
+// Integer number.
+static const std::string Integer{"<integer>"};
+
 // Filesystem path.
 static const std::string Path{"<path>"};
 
+// Time of day in hours and minutes, separated by a colon.
+static const std::string TimeOfDay{"<hh:mm>"};
+
+// Index and number of a shard, separated by a slash.
+static const std::string Shard{"<i/N>"};
+
 }  // namespace Value
 
 // Prints usage instructions and exits. Optional.
@@ -61,6 +147,115 @@ static const std::string Path{"<path>"};
   return Key::Matchings + " " + Value::Path;
 }
 
+// Path to a previous YAML matchings file. Only gifters whose giftee changed are sent a message.
+// Optional.
+[[nodiscard]] std::string PreviousMatchings() {
+  return Key::PreviousMatchings + " " + Value::Path;
+}
+
+// Verifies the matchings against the configuration and exits without sending any messages.
+// Optional.
+[[nodiscard]] std::string_view Verify() {
+  return Key::Verify;
+}
+
+// Host and port of a mail server to which the email messages are sent directly over SMTP rather
+// than through the S-nail utility. Optional.
+[[nodiscard]] std::string Smtp() {
+  return Key::Smtp + " " + Value::HostAndPort;
+}
+
+// Email address from which the email messages are sent over SMTP. Optional.
+[[nodiscard]] std::string From() {
+  return Key::From + " " + Value::Address;
+}
+
+// Number of connections to the mail server over which the email messages are sent. Optional.
+[[nodiscard]] std::string Connections() {
+  return Key::Connections + " " + Value::Integer;
+}
+
+// Number of event loop threads that multiplex the connections to the mail server. Optional.
+[[nodiscard]] std::string EventLoops() {
+  return Key::EventLoops + " " + Value::Integer;
+}
+
+// Encrypts every connection to the mail server with TLS from its start. Optional.
+[[nodiscard]] std::string_view Tls() {
+  return Key::Tls;
+}
+
+// Path to a PEM file of the certificate authorities trusted to sign the certificate of the mail
+// server, instead of the system's certificate authorities. Optional.
+[[nodiscard]] std::string CaFile() {
+  return Key::CaFile + " " + Value::Path;
+}
+
+// Maximum number of attempts to send each email message whose delivery fails transiently.
+// Optional.
+[[nodiscard]] std::string Attempts() {
+  return Key::Attempts + " " + Value::Integer;
+}
+
+// Path to the YAML dead-letter file to which the email messages that could not be sent are written.
+// Optional.
+[[nodiscard]] std::string DeadLetters() {
+  return Key::DeadLetters + " " + Value::Path;
+}
+
+// Path to a YAML dead-letter file whose email messages are sent again instead of composing email
+// messages from the configuration and matchings. Optional.
+[[nodiscard]] std::string Replay() {
+  return Key::Replay + " " + Value::Path;
+}
+
+// Path to a spool directory into which the email messages are written as files instead of being
+// sent. Optional.
+[[nodiscard]] std::string Spool() {
+  return Key::Spool + " " + Value::Path;
+}
+
+// Path to a spool directory whose email messages are sent instead of composing email messages from
+// the configuration and matchings. Optional.
+[[nodiscard]] std::string SendSpool() {
+  return Key::SendSpool + " " + Value::Path;
+}
+
+// Local time of day at which each gifter's email message is sent, in the gifter's time zone.
+// Optional.
+[[nodiscard]] std::string SendAt() {
+  return Key::SendAt + " " + Value::TimeOfDay;
+}
+
+// Path to the YAML schedule file in which the email messages waiting for their time of day are
+// kept. Optional.
+[[nodiscard]] std::string Schedule() {
+  return Key::Schedule + " " + Value::Path;
+}
+
+// Index and number of the shard of the gifters whose email messages are sent, so that several hosts
+// can each send the email messages of one shard. Optional.
+[[nodiscard]] std::string Shard() {
+  return Key::Shard + " " + Value::Shard;
+}
+
+// Path to the YAML outcome file to which the final outcome of every email message is written.
+// Optional.
+[[nodiscard]] std::string Outcomes() {
+  return Key::Outcomes + " " + Value::Path;
+}
+
+// Path to a YAML outcome file to be merged into a run report instead of sending email messages.
+// Can be specified several times. Optional.
+[[nodiscard]] std::string Merge() {
+  return Key::Merge + " " + Value::Path;
+}
+
+// Path to the YAML run report file to which the merged outcome files are written. Optional.
+[[nodiscard]] std::string Report() {
+  return Key::Report + " " + Value::Path;
+}
+
 }  // namespace SecretSanta::Messenger::Argument
 
 #endif  // SECRET_SANTA_MESSENGER_ARGUMENT_HPP
@@ -18,23 +18,205 @@
 //     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
 //     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+#include <unistd.h>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 #include "Configuration.hpp"
+#include "DeadLetters.hpp"
+#include "DeliveryOutcomes.hpp"
 #include "Emailer.hpp"
 #include "Matchings.hpp"
 #include "MessengerSettings.hpp"
+#include "RunReport.hpp"
+#include "SendScheduler.hpp"
+#include "Spool.hpp"
+#include "TransportStack.hpp"
+#include "Verification.hpp"
+
+namespace {
+
+// Returns the names of the gifters to be sent a message: those whose giftee differs from the
+// previous matchings if a previous matchings file is given, among those of the shard if a shard is
+// given. Returns no value if every gifter is to be sent a message.
+std::optional<std::set<std::string>> SelectGifters(
+    const SecretSanta::Messenger::Settings& settings, const SecretSanta::Matchings& matchings) {
+  std::optional<std::set<std::string>> gifter_names;
+  if (!settings.PreviousMatchingsFile().empty()) {
+    const SecretSanta::Matchings previous_matchings{settings.PreviousMatchingsFile()};
+    gifter_names = matchings.ChangedGifters(previous_matchings);
+    std::cout << "A total of " << gifter_names->size()
+              << " gifters have a new giftee since the previous matchings." << std::endl;
+  }
+  if (settings.GifterShard().has_value()) {
+    const SecretSanta::Shard& shard = settings.GifterShard().value();
+    gifter_names = gifter_names.has_value() ? shard.Select(gifter_names.value()) :
+                                              matchings.ShardGifters(shard);
+    std::cout << "A total of " << gifter_names->size() << " gifters to be sent a message belong "
+              << "to shard " << shard.Print() << "." << std::endl;
+  }
+  return gifter_names;
+}
+
+// Returns the options that determine how the email messages are sent, as given by the settings.
+SecretSanta::TransportOptions SelectTransport(const SecretSanta::Messenger::Settings& settings) {
+  SecretSanta::TransportOptions options;
+  options.relays = settings.Relays();
+  options.from = settings.From();
+  options.connections = settings.Connections();
+  options.event_loops = settings.EventLoops();
+  options.tls = settings.Tls();
+  options.ca_file = settings.CaFile();
+  options.spool_directory = settings.SpoolDirectory();
+  options.attempts = settings.Attempts();
+  return options;
+}
+
+// Returns the name of this host, or an empty string if it cannot be determined.
+std::string HostName() {
+  std::vector<char> name(256, '\0');
+  if (gethostname(name.data(), name.size() - 1) != 0) {
+    return {};
+  }
+  return name.data();
+}
+
+}  // namespace
 
 int main(int argc, char* argv[]) {
   const SecretSanta::Messenger::Settings settings{argc, argv};
 
-  const SecretSanta::Configuration configuration{settings.ConfigurationFile()};
+  if (!settings.MergeFiles().empty()) {
+    std::vector<SecretSanta::DeliveryOutcomes> outcomes;
+    for (const std::filesystem::path& merge_file : settings.MergeFiles()) {
+      outcomes.emplace_back(merge_file);
+    }
+
+    const SecretSanta::RunReport report{outcomes};
+
+    report.Print();
+
+    report.Write(settings.ReportFile());
+
+    std::cout << "End of " << SecretSanta::Messenger::Program::Title << "." << std::endl;
+
+    return report.Succeeded() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (settings.VerifyOnly()) {
+    const SecretSanta::Configuration configuration{settings.ConfigurationFile()};
+
+    const SecretSanta::Verification verification{
+        configuration.Participants(), settings.MatchingsFile()};
+
+    verification.Print();
+
+    std::cout << "End of " << SecretSanta::Messenger::Program::Title << "." << std::endl;
+
+    return verification.IsValid() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  SecretSanta::TransportStack transport_stack{SelectTransport(settings)};
+  if (!transport_stack.IsValid()) {
+    return EXIT_FAILURE;
+  }
+  SecretSanta::RetryingTransport& retrying_transport = transport_stack.Transport();
+
+  if (!settings.ReplayFile().empty()) {
+    const SecretSanta::DeadLetters dead_letters{settings.ReplayFile()};
+
+    SecretSanta::SendEmailMessages(dead_letters.Messages(), retrying_transport);
+  } else if (!settings.SendSpoolDirectory().empty()) {
+    const SecretSanta::Spool spool{settings.SendSpoolDirectory()};
+
+    const std::size_t unsent_count{
+        SecretSanta::SendSpooledEmailMessages(spool, retrying_transport)};
+
+    if (unsent_count > 0) {
+      std::cout << unsent_count << " email messages remain in the spool directory "
+                << spool.Directory() << "; send them again with the "
+                << SecretSanta::Messenger::Argument::Key::SendSpool << " argument." << std::endl;
+    }
+  } else if (settings.SendAt().has_value()) {
+    const SecretSanta::Configuration configuration{settings.ConfigurationFile()};
+
+    const SecretSanta::Matchings matchings{settings.MatchingsFile()};
+
+    // A schedule file left by an earlier run holds the email messages that were not yet released,
+    // so it is resumed rather than planned again, so that no email message is sent twice.
+    SecretSanta::SendSchedule schedule{settings.ScheduleFile()};
+    if (schedule.Load()) {
+      std::cout << "Resuming the schedule file " << schedule.Path() << " with "
+                << schedule.Entries().size() << " email messages that were not yet sent."
+                << std::endl;
+      // The email messages being sent when the previous run stopped may or may not have been sent,
+      // so they are not sent again, but their gifters are listed so that they can be checked.
+      if (!schedule.InFlight().empty()) {
+        const std::set<std::string> in_flight{schedule.InFlight()};
+        std::cout << "The email messages of the following " << in_flight.size()
+                  << " gifters were being sent when the previous run stopped and are not sent "
+                  << "again; check whether they were received:" << std::endl;
+        for (const std::string& gifter_name : in_flight) {
+          std::cout << "- " << gifter_name << std::endl;
+        }
+        schedule.Remove(in_flight);
+        schedule.Save();
+      }
+    } else {
+      SecretSanta::PlanSendSchedule(configuration, matchings, settings.SendAt().value(),
+                                    std::time(nullptr), schedule,
+                                    SelectGifters(settings, matchings));
+      schedule.Save();
+      std::cout << "Scheduled " << schedule.Entries().size() << " email messages in the schedule "
+                << "file " << schedule.Path() << "." << std::endl;
+    }
+
+    SecretSanta::RunSendSchedule(schedule, [&](const std::set<std::string>& gifter_names) {
+      SecretSanta::ComposeAndSendEmailMessages(
+          configuration, matchings, retrying_transport, gifter_names);
+    });
+  } else {
+    const SecretSanta::Configuration configuration{settings.ConfigurationFile()};
+
+    const SecretSanta::Matchings matchings{settings.MatchingsFile()};
+
+    SecretSanta::ComposeAndSendEmailMessages(
+        configuration, matchings, retrying_transport, SelectGifters(settings, matchings));
+  }
+
+  std::cout << "Retried " << retrying_transport.RetryCount()
+            << " deliveries that failed transiently." << std::endl;
+
+  // The email messages of a spool that could not be sent stay in the spool rather than being
+  // written to the dead-letter file, so that they are not sent twice.
+  const SecretSanta::DeadLetters undelivered{retrying_transport.Undelivered()};
+  if (!undelivered.Empty() && settings.SendSpoolDirectory().empty()) {
+    undelivered.Write(settings.DeadLettersFile());
+    std::cout << "Send these email messages again once the cause of the failures is fixed with "
+              << "the " << SecretSanta::Messenger::Argument::Key::Replay << " argument."
+              << std::endl;
+  } else if (undelivered.Empty() && !settings.ReplayFile().empty()
+             && settings.ReplayFile() == settings.DeadLettersFile()) {
+    std::filesystem::remove(settings.ReplayFile());
+    std::cout << "All email messages of the dead-letter file were sent, so it was removed."
+              << std::endl;
+  }
 
-  const SecretSanta::Matchings matchings{settings.MatchingsFile()};
+  // Each host of a sharded run writes its own outcome file, and the outcome files of all hosts are
+  // then merged into one run report with the --merge argument.
+  if (!settings.OutcomesFile().empty()) {
+    SecretSanta::DeliveryOutcomes outcomes{retrying_transport.Outcomes()};
+    outcomes.SetOrigin(settings.GifterShard(), HostName());
+    outcomes.Write(settings.OutcomesFile());
+  }
 
-  SecretSanta::ComposeAndSendEmailMessages(configuration, matchings);
+  transport_stack.PrintStatistics();
 
   std::cout << "End of " << SecretSanta::Messenger::Program::Title << "." << std::endl;
 
-  return EXIT_SUCCESS;
+  return undelivered.Empty() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -21,15 +21,21 @@
 #ifndef SECRET_SANTA_MESSENGER_SETTINGS_HPP
 #define SECRET_SANTA_MESSENGER_SETTINGS_HPP
 
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "MessengerArgument.hpp"
 #include "MessengerProgram.hpp"
+#include "Shard.hpp"
+#include "Socket.hpp"
 #include "String.hpp"
+#include "TimeZone.hpp"
 
 namespace SecretSanta::Messenger {
 
@@ -72,6 +78,121 @@ public:
     return matchings_file_;
   }
 
+  // Path to a previous YAML matchings file. If not empty, only gifters whose giftee differs from
+  // the previous matchings are sent a message.
+  [[nodiscard]] const std::filesystem::path& PreviousMatchingsFile() const noexcept {
+    return previous_matchings_file_;
+  }
+
+  // Whether to only verify the matchings against the configuration without sending any messages.
+  [[nodiscard]] constexpr bool VerifyOnly() const noexcept {
+    return verify_only_;
+  }
+
+  // Optional host and port of a mail server to which the email messages are sent directly over
+  // SMTP. If no value is specified, the email messages are sent through the S-nail utility.
+  [[nodiscard]] const std::optional<std::pair<std::string, uint16_t>>& Smtp() const noexcept {
+    return smtp_;
+  }
+
+  // Hosts and ports of all mail servers to which the email messages are sent directly over SMTP,
+  // in the order in which they were specified. The first one is the same as the one given by
+  // Smtp(). If several are specified, the email messages are spread among them as relays.
+  [[nodiscard]] const std::vector<std::pair<std::string, uint16_t>>& Relays() const noexcept {
+    return relays_;
+  }
+
+  // Email address from which the email messages are sent over SMTP.
+  [[nodiscard]] const std::string& From() const noexcept {
+    return from_;
+  }
+
+  // Number of connections to the mail server over which the email messages are sent over SMTP.
+  [[nodiscard]] constexpr std::size_t Connections() const noexcept {
+    return connections_;
+  }
+
+  // Optional number of event loop threads that multiplex the connections to the mail server. If no
+  // value is specified, each connection is served by its own thread.
+  [[nodiscard]] constexpr const std::optional<std::size_t>& EventLoops() const noexcept {
+    return event_loops_;
+  }
+
+  // Whether every connection to the mail server is encrypted with TLS from its start.
+  [[nodiscard]] constexpr bool Tls() const noexcept {
+    return tls_;
+  }
+
+  // Path to a PEM file of the certificate authorities trusted to sign the certificate of the mail
+  // server. If empty, the system's certificate authorities are trusted.
+  [[nodiscard]] const std::filesystem::path& CaFile() const noexcept {
+    return ca_file_;
+  }
+
+  // Maximum number of attempts to send each email message whose delivery fails transiently.
+  [[nodiscard]] constexpr std::size_t Attempts() const noexcept {
+    return attempts_;
+  }
+
+  // Path to the YAML dead-letter file to which the email messages that could not be sent are
+  // written.
+  [[nodiscard]] const std::filesystem::path& DeadLettersFile() const noexcept {
+    return dead_letters_file_;
+  }
+
+  // Path to a YAML dead-letter file whose email messages are sent again. If empty, email messages
+  // are composed from the configuration and matchings.
+  [[nodiscard]] const std::filesystem::path& ReplayFile() const noexcept {
+    return replay_file_;
+  }
+
+  // Path to a spool directory into which the email messages are written as files instead of being
+  // sent. If empty, the email messages are sent.
+  [[nodiscard]] const std::filesystem::path& SpoolDirectory() const noexcept {
+    return spool_directory_;
+  }
+
+  // Path to a spool directory whose email messages are sent. If empty, email messages are composed
+  // from the configuration and matchings.
+  [[nodiscard]] const std::filesystem::path& SendSpoolDirectory() const noexcept {
+    return send_spool_directory_;
+  }
+
+  // Optional local time of day, in minutes since midnight, at which each gifter's email message is
+  // sent in the gifter's time zone. If no value is specified, the email messages are sent at once.
+  [[nodiscard]] constexpr const std::optional<int>& SendAt() const noexcept {
+    return send_at_;
+  }
+
+  // Path to the YAML schedule file in which the email messages waiting for their time of day are
+  // kept.
+  [[nodiscard]] const std::filesystem::path& ScheduleFile() const noexcept {
+    return schedule_file_;
+  }
+
+  // Optional shard of the gifters whose email messages are sent. If no value is specified, the
+  // email messages of every gifter are sent.
+  [[nodiscard]] const std::optional<Shard>& GifterShard() const noexcept {
+    return shard_;
+  }
+
+  // Path to the YAML outcome file to which the final outcome of every email message is written. If
+  // empty, no outcome file is written.
+  [[nodiscard]] const std::filesystem::path& OutcomesFile() const noexcept {
+    return outcomes_file_;
+  }
+
+  // Paths to the YAML outcome files to be merged into a run report, in the order in which they
+  // were specified. If not empty, the outcome files are merged instead of sending email messages.
+  [[nodiscard]] const std::vector<std::filesystem::path>& MergeFiles() const noexcept {
+    return merge_files_;
+  }
+
+  // Path to the YAML run report file to which the merged outcome files are written.
+  [[nodiscard]] const std::filesystem::path& ReportFile() const noexcept {
+    return report_file_;
+  }
+
 private:
   // Prints the program's header information to the console.
   void PrintHeader() const {
@@ -87,13 +208,43 @@ private:
     std::cout << "Usage:" << std::endl;
 
     std::cout << indent << executable_name_ << " " << Argument::Configuration() << " "
-              << Argument::Matchings() << std::endl;
+              << Argument::Matchings() << " [" << Argument::PreviousMatchings() << "] ["
+              << Argument::Verify() << "] [" << Argument::Smtp() << "] [" << Argument::From()
+              << "] [" << Argument::Connections() << "] [" << Argument::EventLoops() << "] ["
+              << Argument::Tls() << "] [" << Argument::CaFile() << "] [" << Argument::Attempts()
+              << "] [" << Argument::DeadLetters() << "] [" << Argument::Spool() << "] ["
+              << Argument::SendAt() << "] [" << Argument::Schedule() << "] [" << Argument::Shard()
+              << "] [" << Argument::Outcomes() << "]" << std::endl;
+    std::cout << indent << executable_name_ << " " << Argument::Replay() << " [...]" << std::endl;
+    std::cout << indent << executable_name_ << " " << Argument::SendSpool() << " [...]"
+              << std::endl;
+    std::cout << indent << executable_name_ << " " << Argument::Merge() << " ["
+              << Argument::Merge() << " ...] [" << Argument::Report() << "]" << std::endl;
 
     // Compute the padding length of the argument patterns.
     const std::size_t length = std::max({
       Argument::Help().length(),
       Argument::Configuration().length(),
       Argument::Matchings().length(),
+      Argument::PreviousMatchings().length(),
+      Argument::Verify().length(),
+      Argument::Smtp().length(),
+      Argument::From().length(),
+      Argument::Connections().length(),
+      Argument::EventLoops().length(),
+      Argument::Tls().length(),
+      Argument::CaFile().length(),
+      Argument::Attempts().length(),
+      Argument::DeadLetters().length(),
+      Argument::Replay().length(),
+      Argument::Spool().length(),
+      Argument::SendSpool().length(),
+      Argument::SendAt().length(),
+      Argument::Schedule().length(),
+      Argument::Shard().length(),
+      Argument::Outcomes().length(),
+      Argument::Merge().length(),
+      Argument::Report().length(),
     });
 
     std::cout << "Arguments:" << std::endl;
@@ -106,6 +257,94 @@ private:
 
     std::cout << indent << PadToLength(Argument::Matchings(), length) << indent
               << "Path to the YAML matchings file to be written. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::PreviousMatchings(), length) << indent
+              << "Path to a previous YAML matchings file. Only gifters whose giftee changed are "
+                 "sent a message. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Verify(), length) << indent
+              << "Verifies the matchings against the configuration and exits without sending any "
+                 "messages. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Smtp(), length) << indent
+              << "Mail server to which the messages are sent directly over SMTP. Optional. Specify "
+                 "it several times to spread the messages among several mail servers."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::From(), length) << indent
+              << "Email address from which the messages are sent over SMTP. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Connections(), length) << indent
+              << "Number of connections to the mail server. Optional; defaults to 1." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::EventLoops(), length) << indent
+              << "Number of event loop threads that multiplex the connections. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Tls(), length) << indent
+              << "Encrypts every connection to the mail server with TLS. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::CaFile(), length) << indent
+              << "Path to a PEM file of the certificate authorities trusted to sign the "
+                 "certificate of the mail server. Optional; defaults to those of the system."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Attempts(), length) << indent
+              << "Maximum number of attempts to send each message whose delivery fails "
+                 "transiently. Optional; defaults to 4."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::DeadLetters(), length) << indent
+              << "Path to the YAML dead-letter file to which the messages that could not be sent "
+                 "are written. Optional; defaults to dead_letters.yaml."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Replay(), length) << indent
+              << "Path to a YAML dead-letter file whose messages are sent again instead of "
+                 "composing messages from the configuration and matchings. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Spool(), length) << indent
+              << "Path to a spool directory into which the messages are written as files instead "
+                 "of being sent. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::SendSpool(), length) << indent
+              << "Path to a spool directory whose messages are sent instead of composing messages "
+                 "from the configuration and matchings. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::SendAt(), length) << indent
+              << "Local time of day at which each message is sent in the time zone of its "
+                 "gifter. Optional; by default, the messages are sent at once."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Schedule(), length) << indent
+              << "Path to the YAML schedule file in which the messages waiting for their time of "
+                 "day are kept. Optional; defaults to schedule.yaml."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Shard(), length) << indent
+              << "Index and number of the shard of the gifters whose messages are sent, such as "
+                 "2/3, so that several hosts can each send one shard. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Outcomes(), length) << indent
+              << "Path to the YAML outcome file to which the outcome of every message is written. "
+                 "Optional; defaults to outcomes.yaml when sending one shard."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Merge(), length) << indent
+              << "Path to a YAML outcome file to be merged into a run report instead of sending "
+                 "messages. Optional. Specify it once per host."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Report(), length) << indent
+              << "Path to the YAML run report file to which the merged outcome files are "
+                 "written. Optional; defaults to report.yaml."
+              << std::endl;
   }
 
   // Parses the program's command-line arguments.
@@ -131,6 +370,90 @@ private:
       } else if (argv[index] == Argument::Key::Matchings && AtLeastOneMore(index, argc)) {
         matchings_file_ = argv[index + 1];
         index += 2;
+      } else if (argv[index] == Argument::Key::PreviousMatchings && AtLeastOneMore(index, argc)) {
+        previous_matchings_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Verify) {
+        verify_only_ = true;
+        ++index;
+      } else if (argv[index] == Argument::Key::Smtp && AtLeastOneMore(index, argc)) {
+        const std::optional<std::pair<std::string, uint16_t>> relay{
+            ParseHostAndPort(argv[index + 1])};
+        if (!relay.has_value()) {
+          PrintHeader();
+          std::cout << "Invalid mail server: " << argv[index + 1]
+                    << "; please specify it as host:port." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        if (!smtp_.has_value()) {
+          smtp_ = relay;
+        }
+        relays_.push_back(relay.value());
+        index += 2;
+      } else if (argv[index] == Argument::Key::From && AtLeastOneMore(index, argc)) {
+        from_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Connections && AtLeastOneMore(index, argc)) {
+        connections_ = std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+        index += 2;
+      } else if (argv[index] == Argument::Key::EventLoops && AtLeastOneMore(index, argc)) {
+        event_loops_ = std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+        index += 2;
+      } else if (argv[index] == Argument::Key::Tls) {
+        tls_ = true;
+        ++index;
+      } else if (argv[index] == Argument::Key::CaFile && AtLeastOneMore(index, argc)) {
+        ca_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Attempts && AtLeastOneMore(index, argc)) {
+        attempts_ = std::max<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10), 1);
+        index += 2;
+      } else if (argv[index] == Argument::Key::DeadLetters && AtLeastOneMore(index, argc)) {
+        dead_letters_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Replay && AtLeastOneMore(index, argc)) {
+        replay_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Spool && AtLeastOneMore(index, argc)) {
+        spool_directory_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::SendSpool && AtLeastOneMore(index, argc)) {
+        send_spool_directory_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::SendAt && AtLeastOneMore(index, argc)) {
+        send_at_ = ParseTimeOfDay(argv[index + 1]);
+        if (!send_at_.has_value()) {
+          PrintHeader();
+          std::cout << "Invalid time of day: " << argv[index + 1]
+                    << "; please specify it as hh:mm, such as 09:00." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else if (argv[index] == Argument::Key::Schedule && AtLeastOneMore(index, argc)) {
+        schedule_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Shard && AtLeastOneMore(index, argc)) {
+        shard_ = ParseShard(argv[index + 1]);
+        if (!shard_.has_value()) {
+          PrintHeader();
+          std::cout << "Invalid shard: " << argv[index + 1]
+                    << "; please specify it as i/N, such as 2/3, where i is between 1 and N."
+                    << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else if (argv[index] == Argument::Key::Outcomes && AtLeastOneMore(index, argc)) {
+        outcomes_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Merge && AtLeastOneMore(index, argc)) {
+        merge_files_.emplace_back(argv[index + 1]);
+        index += 2;
+      } else if (argv[index] == Argument::Key::Report && AtLeastOneMore(index, argc)) {
+        report_file_ = argv[index + 1];
+        index += 2;
       } else {
         PrintHeader();
         std::cout << "Unrecognized argument: " << argv[index] << std::endl;
@@ -138,6 +461,56 @@ private:
         exit(EXIT_FAILURE);
       }
     }
+
+    if (tls_ && event_loops_.has_value()) {
+      PrintHeader();
+      std::cout << "TLS connections are not supported with event loop threads; please specify "
+                << "either " << Argument::Key::Tls << " or " << Argument::Key::EventLoops << "."
+                << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+
+    if (!spool_directory_.empty() && (smtp_.has_value() || !send_spool_directory_.empty())) {
+      PrintHeader();
+      std::cout << "The messages cannot be both written to a spool directory and sent; please "
+                << "specify " << Argument::Key::Spool << " without " << Argument::Key::Smtp
+                << " or " << Argument::Key::SendSpool << "." << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+
+    if (send_at_.has_value()
+        && (verify_only_ || !spool_directory_.empty() || !replay_file_.empty()
+            || !send_spool_directory_.empty())) {
+      PrintHeader();
+      std::cout << "Only messages composed from the configuration and matchings and sent can be "
+                << "scheduled; please specify " << Argument::Key::SendAt << " without "
+                << Argument::Key::Verify << ", " << Argument::Key::Spool << ", "
+                << Argument::Key::Replay << ", or " << Argument::Key::SendSpool << "."
+                << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+
+    // The email messages of a dead-letter file or spool directory were already confined to one
+    // shard when they were first composed, so only freshly composed email messages are sharded.
+    if (shard_.has_value()
+        && (verify_only_ || !replay_file_.empty() || !send_spool_directory_.empty()
+            || !merge_files_.empty())) {
+      PrintHeader();
+      std::cout << "Only messages composed from the configuration and matchings can be sharded; "
+                << "please specify " << Argument::Key::Shard << " without "
+                << Argument::Key::Verify << ", " << Argument::Key::Replay << ", "
+                << Argument::Key::SendSpool << ", or " << Argument::Key::Merge << "."
+                << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+
+    if (shard_.has_value() && outcomes_file_.empty()) {
+      outcomes_file_ = "outcomes.yaml";
+    }
   }
 
   // Returns whether there is at least one more element after the given element index.
@@ -147,16 +520,170 @@ private:
 
   // Prints the command to the console.
   void PrintCommand() const {
+    if (!merge_files_.empty()) {
+      std::cout << "Command: " << executable_name_ << MergeCommand() << std::endl;
+      return;
+    }
+
     std::cout << "Command: " << executable_name_ << " " << Argument::Key::Configuration << " "
               << configuration_file_ << " "
-              << Argument::Key::Matchings + " " + matchings_file_.string() << std::endl;
+              << Argument::Key::Matchings + " " + matchings_file_.string()
+              << (!previous_matchings_file_.empty() ? " " + Argument::Key::PreviousMatchings + " "
+                                                          + previous_matchings_file_.string() :
+                                                      "")
+              << (verify_only_ ? " " + Argument::Key::Verify : "")
+              << RelaysCommand()
+              << (smtp_.has_value() ? " " + Argument::Key::From + " " + from_ + " "
+                                          + Argument::Key::Connections + " "
+                                          + std::to_string(connections_) :
+                                      "")
+              << (smtp_.has_value() && event_loops_.has_value() ?
+                      " " + Argument::Key::EventLoops + " " + std::to_string(event_loops_.value()) :
+                      "")
+              << (smtp_.has_value() && tls_ ? " " + Argument::Key::Tls : "")
+              << (smtp_.has_value() && !ca_file_.empty() ?
+                      " " + Argument::Key::CaFile + " " + ca_file_.string() :
+                      "")
+              << " " << Argument::Key::Attempts << " " << attempts_ << " "
+              << Argument::Key::DeadLetters << " " << dead_letters_file_.string()
+              << (!replay_file_.empty() ?
+                      " " + Argument::Key::Replay + " " + replay_file_.string() :
+                      "")
+              << (!spool_directory_.empty() ?
+                      " " + Argument::Key::Spool + " " + spool_directory_.string() :
+                      "")
+              << (!send_spool_directory_.empty() ?
+                      " " + Argument::Key::SendSpool + " " + send_spool_directory_.string() :
+                      "")
+              << (send_at_.has_value() ? " " + Argument::Key::SendAt + " "
+                                             + FormatTimeOfDay(send_at_.value()) + " "
+                                             + Argument::Key::Schedule + " "
+                                             + schedule_file_.string() :
+                                         "")
+              << (shard_.has_value() ? " " + Argument::Key::Shard + " " + shard_->Print() : "")
+              << (!outcomes_file_.empty() ?
+                      " " + Argument::Key::Outcomes + " " + outcomes_file_.string() :
+                      "")
+              << std::endl;
+  }
+
+  // Returns the part of the command that specifies the outcome files to be merged and the run
+  // report file.
+  [[nodiscard]] std::string MergeCommand() const {
+    std::string command;
+    for (const std::filesystem::path& merge_file : merge_files_) {
+      command.append(" " + Argument::Key::Merge + " " + merge_file.string());
+    }
+    return command + " " + Argument::Key::Report + " " + report_file_.string();
+  }
+
+  // Returns the part of the command that specifies the mail servers.
+  [[nodiscard]] std::string RelaysCommand() const {
+    std::string command;
+    for (const std::pair<std::string, uint16_t>& relay : relays_) {
+      command.append(" " + Argument::Key::Smtp + " " + relay.first + ":"
+                     + std::to_string(relay.second));
+    }
+    return command;
   }
 
   // Prints the settings to the console.
   void PrintSettings() const {
-    std::cout << "- The configuration will be read from: " << configuration_file_ << std::endl;
+    if (!merge_files_.empty()) {
+      std::cout << "- The " << merge_files_.size()
+                << " outcome files will be merged into a run report, which will be written to: "
+                << report_file_ << std::endl;
+      return;
+    }
+
+    if (!replay_file_.empty()) {
+      std::cout << "- The messages will be read from the dead-letter file: " << replay_file_
+                << std::endl;
+    } else if (!send_spool_directory_.empty()) {
+      std::cout << "- The messages that were not yet sent will be read from the spool directory: "
+                << send_spool_directory_ << std::endl;
+    } else {
+      std::cout << "- The configuration will be read from: " << configuration_file_ << std::endl;
+
+      std::cout << "- The matchings will be read from: " << matchings_file_ << std::endl;
+    }
+
+    if (!previous_matchings_file_.empty()) {
+      std::cout << "- Only gifters whose giftee differs from the previous matchings read from "
+                << previous_matchings_file_ << " will be sent a message." << std::endl;
+    }
+
+    if (verify_only_) {
+      std::cout << "- The matchings will be verified against the configuration, and no messages "
+                   "will be sent."
+                << std::endl;
+    }
+
+    if (relays_.size() > 1) {
+      std::cout << "- The messages will be sent from " << from_ << " to " << relays_.size()
+                << " mail servers, each over " << connections_ << " connections. The messages "
+                << "to each recipient domain will go to the same mail server unless it is busier "
+                << "than the others or unreachable." << std::endl;
+    } else if (smtp_.has_value()) {
+      std::cout << "- The messages will be sent from " << from_ << " to the mail server at "
+                << smtp_->first << ":" << smtp_->second << " over " << connections_
+                << " connections." << std::endl;
+    }
+    if (smtp_.has_value()) {
+      if (event_loops_.has_value()) {
+        std::cout << "- The connections will be multiplexed on " << event_loops_.value()
+                  << " event loop threads." << std::endl;
+      } else {
+        std::cout << "- Each connection will be served by its own thread." << std::endl;
+      }
+      if (tls_) {
+        std::cout << "- Each connection will be encrypted with TLS, and TLS sessions will be "
+                     "resumed across connections."
+                  << std::endl;
+        if (!ca_file_.empty()) {
+          std::cout << "- The certificate of the mail server will be verified against the "
+                       "certificate authorities read from "
+                    << ca_file_ << "." << std::endl;
+        }
+      }
+    } else if (!spool_directory_.empty()) {
+      std::cout << "- The messages will be written as files into the spool directory "
+                << spool_directory_ << " instead of being sent." << std::endl;
+    } else {
+      std::cout << "- The messages will be sent through the S-nail utility." << std::endl;
+    }
+
+    if (!verify_only_ && !send_spool_directory_.empty()) {
+      std::cout << "- Each message will be attempted up to " << attempts_
+                << " times if its delivery fails transiently, and the messages that cannot be "
+                   "sent will stay in the spool directory."
+                << std::endl;
+    } else if (!verify_only_) {
+      std::cout << "- Each message will be attempted up to " << attempts_
+                << " times if its delivery fails transiently, and the messages that cannot be "
+                   "sent will be written to the dead-letter file: "
+                << dead_letters_file_ << std::endl;
+    }
+
+    if (send_at_.has_value()) {
+      std::cout << "- Each message will be sent at " << FormatTimeOfDay(send_at_.value())
+                << " in the time zone of its gifter. The messages waiting for their time will be "
+                   "kept in the schedule file: "
+                << schedule_file_ << std::endl;
+    }
 
-    std::cout << "- The matchings will be read from: " << matchings_file_ << std::endl;
+    if (shard_.has_value()) {
+      std::cout << "- Only the gifters of shard " << shard_->Print()
+                << " will be sent a message. The gifters are partitioned by a stable hash of "
+                   "their name, so hosts given the same inputs and different shards send disjoint "
+                   "sets of messages."
+                << std::endl;
+    }
+
+    if (!outcomes_file_.empty()) {
+      std::cout << "- The outcome of every message will be written to the outcome file: "
+                << outcomes_file_ << std::endl;
+    }
   }
 
   // Name of the Secret Santa Messenger executable.
@@ -167,6 +694,78 @@ private:
 
   // Path to the YAML matchings file to be read.
   std::filesystem::path matchings_file_;
+
+  // Path to a previous YAML matchings file. If not empty, only gifters whose giftee differs from
+  // the previous matchings are sent a message.
+  std::filesystem::path previous_matchings_file_;
+
+  // Whether to only verify the matchings against the configuration without sending any messages.
+  bool verify_only_{false};
+
+  // Optional host and port of a mail server to which the email messages are sent directly over
+  // SMTP. If no value is specified, the email messages are sent through the S-nail utility.
+  std::optional<std::pair<std::string, uint16_t>> smtp_;
+
+  // Hosts and ports of all mail servers to which the email messages are sent directly over SMTP.
+  std::vector<std::pair<std::string, uint16_t>> relays_;
+
+  // Email address from which the email messages are sent over SMTP.
+  std::string from_{"secret-santa@localhost"};
+
+  // Number of connections to the mail server over which the email messages are sent over SMTP.
+  std::size_t connections_{1};
+
+  // Optional number of event loop threads that multiplex the connections to the mail server. If no
+  // value is specified, each connection is served by its own thread.
+  std::optional<std::size_t> event_loops_;
+
+  // Whether every connection to the mail server is encrypted with TLS from its start.
+  bool tls_{false};
+
+  // Path to a PEM file of the certificate authorities trusted to sign the certificate of the mail
+  // server. If empty, the system's certificate authorities are trusted.
+  std::filesystem::path ca_file_;
+
+  // Maximum number of attempts to send each email message whose delivery fails transiently.
+  std::size_t attempts_{4};
+
+  // Path to the YAML dead-letter file to which the email messages that could not be sent are
+  // written.
+  std::filesystem::path dead_letters_file_{"dead_letters.yaml"};
+
+  // Path to a YAML dead-letter file whose email messages are sent again. If empty, email messages
+  // are composed from the configuration and matchings.
+  std::filesystem::path replay_file_;
+
+  // Path to a spool directory into which the email messages are written as files instead of being
+  // sent. If empty, the email messages are sent.
+  std::filesystem::path spool_directory_;
+
+  // Path to a spool directory whose email messages are sent. If empty, email messages are composed
+  // from the configuration and matchings.
+  std::filesystem::path send_spool_directory_;
+
+  // Optional local time of day, in minutes since midnight, at which each gifter's email message is
+  // sent in the gifter's time zone. If no value is specified, the email messages are sent at once.
+  std::optional<int> send_at_;
+
+  // Path to the YAML schedule file in which the email messages waiting for their time of day are
+  // kept.
+  std::filesystem::path schedule_file_{"schedule.yaml"};
+
+  // Optional shard of the gifters whose email messages are sent. If no value is specified, the
+  // email messages of every gifter are sent.
+  std::optional<Shard> shard_;
+
+  // Path to the YAML outcome file to which the final outcome of every email message is written. If
+  // empty, no outcome file is written.
+  std::filesystem::path outcomes_file_;
+
+  // Paths to the YAML outcome files to be merged into a run report.
+  std::vector<std::filesystem::path> merge_files_;
+
+  // Path to the YAML run report file to which the merged outcome files are written.
+  std::filesystem::path report_file_{"report.yaml"};
 };
 
 }  // namespace SecretSanta::Messenger
@@ -0,0 +1,441 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_MIME_ENCODING_HPP
+#define SECRET_SANTA_MIME_ENCODING_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// The base64 encoder has a vectorized path that uses SSSE3 instructions when the processor
+// supports them, detected at run time, so that the executables need not be compiled for a specific
+// processor. The quoted-printable encoder has a vectorized path that uses SSE2 instructions, which
+// every x86-64 processor supports.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SECRET_SANTA_MIME_SSSE3
+#endif
+
+#if defined(__SSE2__)
+#define SECRET_SANTA_MIME_SSE2
+#endif
+
+namespace SecretSanta {
+
+// Maximum number of characters of a line of an encoded email message, excluding the carriage return
+// and line feed that end it.
+static constexpr std::size_t MimeLineLength{76};
+
+// Characters of the base64 alphabet, indexed by their 6-bit value.
+static constexpr char Base64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Number of characters of the base64 encoding of a given number of bytes, including padding.
+[[nodiscard]] constexpr std::size_t Base64EncodedLength(const std::size_t length) noexcept {
+  return (length + 2) / 3 * 4;
+}
+
+// Encodes a given number of bytes in base64 one group of three bytes at a time, pads the last
+// group, and writes the characters to a given output. Returns the number of characters written.
+std::size_t EncodeBase64Scalar(
+    const unsigned char* const input, const std::size_t length, char* const output) noexcept {
+  std::size_t written = 0;
+  std::size_t index = 0;
+  for (; index + 3 <= length; index += 3) {
+    const uint32_t group = (static_cast<uint32_t>(input[index]) << 16U)
+                           | (static_cast<uint32_t>(input[index + 1]) << 8U)
+                           | static_cast<uint32_t>(input[index + 2]);
+    output[written++] = Base64Alphabet[(group >> 18U) & 0x3FU];
+    output[written++] = Base64Alphabet[(group >> 12U) & 0x3FU];
+    output[written++] = Base64Alphabet[(group >> 6U) & 0x3FU];
+    output[written++] = Base64Alphabet[group & 0x3FU];
+  }
+  if (index < length) {
+    const uint32_t group =
+        (static_cast<uint32_t>(input[index]) << 16U)
+        | (index + 1 < length ? static_cast<uint32_t>(input[index + 1]) << 8U : 0U);
+    output[written++] = Base64Alphabet[(group >> 18U) & 0x3FU];
+    output[written++] = Base64Alphabet[(group >> 12U) & 0x3FU];
+    output[written++] = index + 1 < length ? Base64Alphabet[(group >> 6U) & 0x3FU] : '=';
+    output[written++] = '=';
+  }
+  return written;
+}
+
+#ifdef SECRET_SANTA_MIME_SSSE3
+// Encodes a given number of bytes in base64 twelve bytes at a time with SSSE3 instructions, and the
+// remaining bytes one group at a time. Each step loads sixteen bytes, of which it encodes twelve,
+// so steps only run while sixteen bytes remain. A shuffle gathers the three bytes of each group
+// into a 32-bit lane, two multiplications move the four 6-bit values of each lane into separate
+// bytes, and a lookup by range turns each value into its character.
+__attribute__((target("ssse3"))) std::size_t EncodeBase64Ssse3(
+    const unsigned char* const input, const std::size_t length, char* const output) noexcept {
+  const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+  std::size_t written = 0;
+  std::size_t index = 0;
+  for (; index + 16 <= length; index += 12) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + index));
+    bytes = _mm_shuffle_epi8(bytes, shuffle);
+
+    const __m128i high = _mm_mulhi_epu16(
+        _mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    const __m128i low = _mm_mullo_epi16(
+        _mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    const __m128i values = _mm_or_si128(high, low);
+
+    // Values 0 to 51 map to 0, and 52 to 63 map to 1 to 12; then values 0 to 25 map to 13.
+    __m128i ranges = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    ranges = _mm_or_si128(
+        ranges, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+    const __m128i characters = _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), values);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written), characters);
+    written += 16;
+  }
+  return written + EncodeBase64Scalar(input + index, length - index, output + written);
+}
+
+// Whether the processor supports SSSE3 instructions.
+[[nodiscard]] bool ProcessorSupportsSsse3() noexcept {
+  static const bool supported = __builtin_cpu_supports("ssse3") != 0;
+  return supported;
+}
+#endif
+
+// Encodes a given number of bytes in base64 and writes the characters to a given output, with the
+// vectorized encoder if it is requested and the processor supports it. Returns the number of
+// characters written.
+std::size_t EncodeBase64(const unsigned char* const input, const std::size_t length,
+                         char* const output, const bool vectorized = true) noexcept {
+#ifdef SECRET_SANTA_MIME_SSSE3
+  if (vectorized && ProcessorSupportsSsse3()) {
+    return EncodeBase64Ssse3(input, length, output);
+  }
+#endif
+  static_cast<void>(vectorized);
+  return EncodeBase64Scalar(input, length, output);
+}
+
+// Encodes a given text in base64 on a single line.
+[[nodiscard]] std::string Base64Encode(const std::string_view text, const bool vectorized = true) {
+  std::string encoded(Base64EncodedLength(text.size()), '\0');
+  EncodeBase64(reinterpret_cast<const unsigned char*>(text.data()), text.size(), encoded.data(),
+               vectorized);
+  return encoded;
+}
+
+// Encodes given data in base64 as the body of a MIME part: lines of 76 characters, each ending with
+// a carriage return and line feed.
+[[nodiscard]] std::string Base64EncodeLines(
+    const std::string_view data, const std::size_t line_length = MimeLineLength,
+    const bool vectorized = true) {
+  // Each line encodes a whole number of groups of three bytes.
+  const std::size_t bytes_per_line = std::max<std::size_t>(line_length / 4, 1) * 3;
+  const std::size_t line_count = (data.size() + bytes_per_line - 1) / bytes_per_line;
+  std::string encoded(Base64EncodedLength(data.size()) + 2 * line_count, '\0');
+
+  const unsigned char* const input = reinterpret_cast<const unsigned char*>(data.data());
+  std::size_t written = 0;
+  for (std::size_t index = 0; index < data.size(); index += bytes_per_line) {
+    written += EncodeBase64(input + index, std::min(bytes_per_line, data.size() - index),
+                            encoded.data() + written, vectorized);
+    encoded[written++] = '\r';
+    encoded[written++] = '\n';
+  }
+  return encoded;
+}
+
+// Decodes a given base64 text. Ignores whitespace and stops at the first padding character.
+// Returns no value if the text contains a character outside of the base64 alphabet.
+[[nodiscard]] std::optional<std::string> Base64Decode(const std::string_view text) {
+  std::string decoded;
+  decoded.reserve(text.size() / 4 * 3);
+  uint32_t group = 0;
+  std::size_t group_length = 0;
+  for (const char character : text) {
+    uint32_t value = 0;
+    if (character >= 'A' && character <= 'Z') {
+      value = static_cast<uint32_t>(character - 'A');
+    } else if (character >= 'a' && character <= 'z') {
+      value = static_cast<uint32_t>(character - 'a' + 26);
+    } else if (character >= '0' && character <= '9') {
+      value = static_cast<uint32_t>(character - '0' + 52);
+    } else if (character == '+') {
+      value = 62;
+    } else if (character == '/') {
+      value = 63;
+    } else if (character == '=') {
+      break;
+    } else if (character == ' ' || character == '\t' || character == '\r' || character == '\n') {
+      continue;
+    } else {
+      return std::nullopt;
+    }
+    group = (group << 6U) | value;
+    if (++group_length == 4) {
+      decoded.push_back(static_cast<char>((group >> 16U) & 0xFFU));
+      decoded.push_back(static_cast<char>((group >> 8U) & 0xFFU));
+      decoded.push_back(static_cast<char>(group & 0xFFU));
+      group = 0;
+      group_length = 0;
+    }
+  }
+  if (group_length == 2) {
+    decoded.push_back(static_cast<char>((group >> 4U) & 0xFFU));
+  } else if (group_length == 3) {
+    decoded.push_back(static_cast<char>((group >> 10U) & 0xFFU));
+    decoded.push_back(static_cast<char>((group >> 2U) & 0xFFU));
+  }
+  return decoded;
+}
+
+// Whether a given byte may appear as itself in quoted-printable text, apart from its position on
+// the line. Spaces and tabs may, except at the end of a line.
+[[nodiscard]] constexpr bool IsQuotedPrintableLiteral(const unsigned char byte) noexcept {
+  return (byte >= 33 && byte <= 126 && byte != '=') || byte == ' ' || byte == '\t';
+}
+
+#ifdef SECRET_SANTA_MIME_SSE2
+// Whether the sixteen bytes at a given position may all appear as themselves in quoted-printable
+// text, which is the common case for text in Latin script.
+[[nodiscard]] bool AreQuotedPrintableLiterals(const char* const bytes) noexcept {
+  const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+  // Bytes from 128 to 255 are negative as signed bytes, so they compare below 32.
+  const __m128i control = _mm_andnot_si128(
+      _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')), _mm_cmplt_epi8(chunk, _mm_set1_epi8(32)));
+  const __m128i other = _mm_or_si128(
+      _mm_cmpeq_epi8(chunk, _mm_set1_epi8(127)), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('=')));
+  return _mm_movemask_epi8(_mm_or_si128(control, other)) == 0;
+}
+#endif
+
+// Encodes a given text as quoted-printable. Each line feed, optionally preceded by a carriage
+// return, becomes a line break of the encoded text. Bytes that may not appear as themselves, such
+// as the bytes of non-ASCII UTF-8 characters, equal signs, and spaces at the end of a line, are
+// written as an equal sign followed by two hexadecimal digits. Lines longer than 76 characters are
+// broken with soft line breaks. The vectorized encoder copies runs of sixteen bytes that need no
+// encoding at once.
+[[nodiscard]] std::string QuotedPrintableEncode(
+    const std::string_view text, const bool vectorized = true) {
+  static constexpr char hexadecimal[] = "0123456789ABCDEF";
+  // A line holds at most this many characters before its soft line break.
+  constexpr std::size_t maximum_column{MimeLineLength - 1};
+
+  std::string encoded;
+  encoded.reserve(text.size() + text.size() / 8 + 16);
+  std::size_t column = 0;
+  std::size_t index = 0;
+  while (index < text.size()) {
+    const unsigned char byte = static_cast<unsigned char>(text[index]);
+
+    if (byte == '\n' || (byte == '\r' && index + 1 < text.size() && text[index + 1] == '\n')) {
+      encoded.append("\r\n");
+      column = 0;
+      index += byte == '\r' ? 2 : 1;
+      continue;
+    }
+
+#ifdef SECRET_SANTA_MIME_SSE2
+    // The run must not end the line, so that a space at its end is never at the end of a line.
+    if (vectorized && index + 16 < text.size() && column + 16 <= maximum_column
+        && text[index + 16] != '\n' && text[index + 16] != '\r'
+        && AreQuotedPrintableLiterals(text.data() + index)) {
+      encoded.append(text.data() + index, 16);
+      column += 16;
+      index += 16;
+      continue;
+    }
+#endif
+    static_cast<void>(vectorized);
+
+    const bool end_of_line = index + 1 >= text.size() || text[index + 1] == '\n'
+                             || (text[index + 1] == '\r' && index + 2 < text.size()
+                                 && text[index + 2] == '\n');
+    const bool literal =
+        IsQuotedPrintableLiteral(byte) && !((byte == ' ' || byte == '\t') && end_of_line);
+    const std::size_t width = literal ? 1 : 3;
+
+    // The last character of a line may use the column otherwise taken by the soft line break.
+    if (column + width > maximum_column && !(end_of_line && column + width <= MimeLineLength)) {
+      encoded.append("=\r\n");
+      column = 0;
+    }
+    if (literal) {
+      encoded.push_back(static_cast<char>(byte));
+    } else {
+      encoded.push_back('=');
+      encoded.push_back(hexadecimal[byte >> 4U]);
+      encoded.push_back(hexadecimal[byte & 0x0FU]);
+    }
+    column += width;
+    ++index;
+  }
+  return encoded;
+}
+
+// Value of a given hexadecimal digit, or no value if it is not one.
+[[nodiscard]] constexpr std::optional<unsigned char> HexadecimalValue(const char digit) noexcept {
+  if (digit >= '0' && digit <= '9') {
+    return static_cast<unsigned char>(digit - '0');
+  }
+  if (digit >= 'A' && digit <= 'F') {
+    return static_cast<unsigned char>(digit - 'A' + 10);
+  }
+  if (digit >= 'a' && digit <= 'f') {
+    return static_cast<unsigned char>(digit - 'a' + 10);
+  }
+  return std::nullopt;
+}
+
+// Decodes a given quoted-printable text. Line breaks become line feeds, soft line breaks are
+// removed, and encoded bytes are decoded. An equal sign that does not start a valid encoding is
+// kept as is.
+[[nodiscard]] std::string QuotedPrintableDecode(const std::string_view text) {
+  std::string decoded;
+  decoded.reserve(text.size());
+  std::size_t index = 0;
+  while (index < text.size()) {
+    const char character = text[index];
+    if (character == '\r' && index + 1 < text.size() && text[index + 1] == '\n') {
+      decoded.push_back('\n');
+      index += 2;
+    } else if (character != '=') {
+      decoded.push_back(character);
+      ++index;
+    } else if (index + 2 < text.size() && text[index + 1] == '\r' && text[index + 2] == '\n') {
+      index += 3;
+    } else if (index + 1 < text.size() && text[index + 1] == '\n') {
+      index += 2;
+    } else if (index + 2 < text.size() && HexadecimalValue(text[index + 1]).has_value()
+               && HexadecimalValue(text[index + 2]).has_value()) {
+      decoded.push_back(static_cast<char>((HexadecimalValue(text[index + 1]).value() << 4U)
+                                          | HexadecimalValue(text[index + 2]).value()));
+      index += 3;
+    } else {
+      decoded.push_back(character);
+      ++index;
+    }
+  }
+  return decoded;
+}
+
+// Whether a given header field value can be written as is: it only contains printable ASCII
+// characters and does not look like an encoded word.
+[[nodiscard]] bool IsPlainHeaderValue(const std::string_view value) noexcept {
+  return std::all_of(value.cbegin(), value.cend(),
+                     [](const char character) { return character >= 32 && character <= 126; })
+         && value.find("=?") == std::string_view::npos;
+}
+
+// Encodes a given UTF-8 header field value as RFC 2047 encoded words if it is not plain ASCII. Each
+// encoded word holds the base64 encoding of whole UTF-8 characters and fits on a line of 76
+// characters, the first of which also holds the header field name of a given length followed by a
+// colon and a space. The encoded words are separated by folding line breaks.
+[[nodiscard]] std::string EncodeHeaderValue(
+    const std::string_view value, const std::size_t name_length = 0) {
+  if (IsPlainHeaderValue(value)) {
+    return std::string{value};
+  }
+
+  static const std::string prefix{"=?UTF-8?B?"};
+  static const std::string suffix{"?="};
+
+  std::string encoded;
+  // The first line holds the header field name, a colon, and a space; the next lines hold a space.
+  std::size_t available = MimeLineLength - std::min(name_length + 2, MimeLineLength / 2);
+  std::size_t index = 0;
+  while (index < value.size()) {
+    const std::size_t maximum_bytes =
+        std::max<std::size_t>((available - prefix.size() - suffix.size()) / 4 * 3, 6);
+    std::size_t end = std::min(index + maximum_bytes, value.size());
+    // Do not split a UTF-8 character: back off while the next byte continues a character.
+    while (end < value.size() && end > index + 1
+           && (static_cast<unsigned char>(value[end]) & 0xC0U) == 0x80U) {
+      --end;
+    }
+    if (!encoded.empty()) {
+      encoded.append("\r\n ");
+    }
+    encoded.append(prefix + Base64Encode(value.substr(index, end - index)) + suffix);
+    index = end;
+    available = MimeLineLength - 1;
+  }
+  return encoded;
+}
+
+// Decodes the RFC 2047 encoded words of a given header field value in either the base64 or the
+// quoted-printable encoding, assuming they are in UTF-8 or a subset of it. Whitespace between two
+// adjacent encoded words is removed. Text that is not an encoded word is kept as is.
+[[nodiscard]] std::string DecodeHeaderValue(const std::string_view value) {
+  std::string decoded;
+  std::size_t index = 0;
+  bool after_encoded_word = false;
+  while (index < value.size()) {
+    const std::size_t start = value.find("=?", index);
+    if (start == std::string_view::npos) {
+      decoded.append(value.substr(index));
+      break;
+    }
+    // Parse the charset, the encoding, and the encoded text.
+    const std::size_t charset_end = value.find('?', start + 2);
+    const std::size_t encoding_end =
+        charset_end == std::string_view::npos ? charset_end : value.find('?', charset_end + 1);
+    const std::size_t text_end =
+        encoding_end == std::string_view::npos ? encoding_end : value.find("?=", encoding_end + 1);
+    if (text_end == std::string_view::npos || encoding_end != charset_end + 2) {
+      decoded.append(value.substr(index));
+      break;
+    }
+
+    const std::string_view between{value.substr(index, start - index)};
+    if (!(after_encoded_word
+          && between.find_first_not_of(" \t\r\n") == std::string_view::npos)) {
+      decoded.append(between);
+    }
+
+    const char encoding = value[charset_end + 1];
+    const std::string_view text{value.substr(encoding_end + 1, text_end - encoding_end - 1)};
+    if (encoding == 'B' || encoding == 'b') {
+      const std::optional<std::string> bytes{Base64Decode(text)};
+      decoded.append(bytes.has_value() ? bytes.value() : std::string{text});
+    } else {
+      std::string quoted{text};
+      std::replace(quoted.begin(), quoted.end(), '_', ' ');
+      decoded.append(QuotedPrintableDecode(quoted));
+    }
+    index = text_end + 2;
+    after_encoded_word = true;
+  }
+  return decoded;
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_MIME_ENCODING_HPP
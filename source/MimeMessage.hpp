@@ -0,0 +1,496 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_MIME_MESSAGE_HPP
+#define SECRET_SANTA_MIME_MESSAGE_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "EmailMessage.hpp"
+#include "MimeEncoding.hpp"
+
+namespace SecretSanta {
+
+// Boundary of the parts of a multipart/mixed MIME message. It starts with "=_", which neither the
+// quoted-printable nor the base64 encoding can produce, so it never appears in an encoded part.
+static const std::string MimeMixedBoundary{"=_SecretSanta_Mixed"};
+
+// Boundary of the parts of a multipart/alternative MIME message. Like the multipart/mixed boundary,
+// it never appears in an encoded part.
+static const std::string MimeAlternativeBoundary{"=_SecretSanta_Alternative"};
+
+// Header field of a MIME message or part.
+struct MimeHeaderField {
+  // Name of the header field, such as "Subject".
+  std::string name;
+
+  // Value of the header field, as UTF-8 text before encoding.
+  std::string value;
+};
+
+// Returns a copy of a given text in lowercase, for comparing header field names and content types.
+[[nodiscard]] std::string LowercaseAscii(const std::string_view text) {
+  std::string lowercase{text};
+  std::transform(lowercase.begin(), lowercase.end(), lowercase.begin(),
+                 [](const unsigned char character) {
+                   return static_cast<char>(std::tolower(character));
+                 });
+  return lowercase;
+}
+
+// Value of a given parameter of a given header field value such as
+// "text/plain; charset=utf-8", or an empty string if there is none. Supports quoted values and RFC
+// 2231 extended values in UTF-8, such as "filename*=utf-8''%C3%A9t%C3%A9.ics".
+[[nodiscard]] std::string MimeHeaderParameter(
+    const std::string_view value, const std::string& parameter) {
+  std::size_t position = value.find(';');
+  while (position != std::string_view::npos) {
+    ++position;
+    while (position < value.size() && std::isspace(static_cast<unsigned char>(value[position]))) {
+      ++position;
+    }
+    const std::size_t equals = value.find('=', position);
+    if (equals == std::string_view::npos) {
+      break;
+    }
+    const std::string name{LowercaseAscii(value.substr(position, equals - position))};
+    std::string text;
+    std::size_t end = equals + 1;
+    if (end < value.size() && value[end] == '"') {
+      for (++end; end < value.size() && value[end] != '"'; ++end) {
+        if (value[end] == '\\' && end + 1 < value.size()) {
+          ++end;
+        }
+        text.push_back(value[end]);
+      }
+      end = value.find(';', end);
+    } else {
+      const std::size_t semicolon = value.find(';', end);
+      text = value.substr(end, semicolon == std::string_view::npos ? semicolon : semicolon - end);
+      while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.pop_back();
+      }
+      end = semicolon;
+    }
+
+    if (name == parameter) {
+      return text;
+    }
+    if (name == parameter + "*") {
+      // Skips the charset and language, and decodes the percent-encoded bytes.
+      const std::size_t quote = text.find('\'', text.find('\'') + 1);
+      std::string decoded;
+      for (std::size_t index = quote == std::string::npos ? 0 : quote + 1; index < text.size();
+           ++index) {
+        if (text[index] == '%' && index + 2 < text.size()
+            && HexadecimalValue(text[index + 1]).has_value()
+            && HexadecimalValue(text[index + 2]).has_value()) {
+          decoded.push_back(static_cast<char>((HexadecimalValue(text[index + 1]).value() << 4U)
+                                              | HexadecimalValue(text[index + 2]).value()));
+          index += 2;
+        } else {
+          decoded.push_back(text[index]);
+        }
+      }
+      return decoded;
+    }
+    position = end;
+  }
+  return {};
+}
+
+// Formats the file name parameter of an attachment: a quoted string if the file name is plain
+// ASCII, or an RFC 2231 extended value in UTF-8 otherwise.
+[[nodiscard]] std::string FormatFileNameParameter(
+    const std::string& parameter, const std::string& file_name) {
+  if (IsPlainHeaderValue(file_name)) {
+    std::string quoted{parameter + "=\""};
+    for (const char character : file_name) {
+      if (character == '"' || character == '\\') {
+        quoted.push_back('\\');
+      }
+      quoted.push_back(character);
+    }
+    return quoted + "\"";
+  }
+  static constexpr char hexadecimal[] = "0123456789ABCDEF";
+  std::string extended{parameter + "*=utf-8''"};
+  for (const char character : file_name) {
+    const unsigned char byte = static_cast<unsigned char>(character);
+    if (std::isalnum(byte) != 0 || character == '.' || character == '-' || character == '_') {
+      extended.push_back(character);
+    } else {
+      extended.push_back('%');
+      extended.push_back(hexadecimal[byte >> 4U]);
+      extended.push_back(hexadecimal[byte & 0x0FU]);
+    }
+  }
+  return extended;
+}
+
+// Parses the header section of a MIME message or part that starts at a given position of a given
+// text, up to and including the blank line that ends it, and advances the position past it.
+// Folded header fields are unfolded. Header field values are left encoded.
+[[nodiscard]] std::vector<MimeHeaderField> ParseMimeHeaderSection(
+    const std::string_view text, std::size_t& position) {
+  std::vector<MimeHeaderField> fields;
+  while (position < text.size()) {
+    std::size_t end = text.find('\n', position);
+    if (end == std::string_view::npos) {
+      end = text.size();
+    }
+    std::string_view line{text.substr(position, end - position)};
+    position = end + 1;
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (line.empty()) {
+      break;
+    }
+    if (line.front() == ' ' || line.front() == '\t') {
+      if (!fields.empty()) {
+        fields.back().value.append(line);
+      }
+      continue;
+    }
+    const std::size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+      continue;
+    }
+    std::size_t start = colon + 1;
+    while (start < line.size() && (line[start] == ' ' || line[start] == '\t')) {
+      ++start;
+    }
+    fields.push_back(MimeHeaderField{std::string{line.substr(0, colon)},
+                                     std::string{line.substr(start)}});
+  }
+  position = std::min(position, text.size());
+  return fields;
+}
+
+// Value of the header field of a given name among given header fields, matched regardless of case,
+// or an empty string if there is none.
+[[nodiscard]] std::string FindMimeHeaderField(
+    const std::vector<MimeHeaderField>& fields, const std::string& name) {
+  const std::string lowercase_name{LowercaseAscii(name)};
+  for (const MimeHeaderField& field : fields) {
+    if (LowercaseAscii(field.name) == lowercase_name) {
+      return field.value;
+    }
+  }
+  return {};
+}
+
+// Decodes the body of a MIME part according to its content transfer encoding. Line breaks of
+// unencoded bodies become line feeds.
+[[nodiscard]] std::string DecodeMimeBody(
+    const std::string_view body, const std::string& transfer_encoding) {
+  const std::string encoding{LowercaseAscii(transfer_encoding)};
+  if (encoding == "quoted-printable") {
+    return QuotedPrintableDecode(body);
+  }
+  if (encoding == "base64") {
+    const std::optional<std::string> decoded{Base64Decode(body)};
+    if (decoded.has_value()) {
+      return decoded.value();
+    }
+  }
+  std::string decoded;
+  decoded.reserve(body.size());
+  for (std::size_t index = 0; index < body.size(); ++index) {
+    if (body[index] != '\r' || index + 1 >= body.size() || body[index + 1] != '\n') {
+      decoded.push_back(body[index]);
+    }
+  }
+  return decoded;
+}
+
+// Encodes a given attachment as a MIME part: its header fields, a blank line, and its base64 body.
+[[nodiscard]] std::string EncodeAttachmentPart(
+    const EmailAttachment& attachment, const bool vectorized = true) {
+  return "Content-Type: " + attachment.content_type + "; "
+         + FormatFileNameParameter("name", attachment.file_name) + "\r\n"
+         + "Content-Transfer-Encoding: base64\r\n" + "Content-Disposition: attachment; "
+         + FormatFileNameParameter("filename", attachment.file_name) + "\r\n" + "\r\n"
+         + Base64EncodeLines(attachment.data, MimeLineLength, vectorized);
+}
+
+// Creates an attachment of a given file name, content type, and contents, and encodes its MIME
+// part once, so that attaching it to many email messages does not encode it again for each one.
+[[nodiscard]] std::shared_ptr<const EmailAttachment> EncodeAttachment(
+    std::string file_name, std::string content_type, std::string data) {
+  EmailAttachment attachment{std::move(file_name), std::move(content_type), std::move(data), {}};
+  attachment.encoded_part = EncodeAttachmentPart(attachment);
+  return std::make_shared<const EmailAttachment>(std::move(attachment));
+}
+
+// MIME message with UTF-8 header fields, a plain text body, an optional HTML alternative body, and
+// optional attachments. Composes it as an RFC 2045 message whose header fields that are not plain
+// ASCII are RFC 2047 encoded words, whose bodies are quoted-printable, and whose attachments are
+// base64, so that every line is 7-bit ASCII of at most 76 characters and passes through any mail
+// server unchanged. Also parses such a message back.
+class MimeMessage {
+public:
+  // Default constructor. Constructs an empty MIME message.
+  MimeMessage() = default;
+
+  // Constructor. Constructs a MIME message from its header fields, other than the MIME header
+  // fields, and its plain text body.
+  MimeMessage(std::vector<MimeHeaderField> header_fields, std::string text)
+    : header_fields_(std::move(header_fields)), text_(std::move(text)) {}
+
+  // Constructor. Constructs a MIME message from its header fields, other than the MIME header
+  // fields, and the bodies and attachments of a given email message.
+  MimeMessage(std::vector<MimeHeaderField> header_fields, const EmailMessage& message)
+    : header_fields_(std::move(header_fields)), text_(message.Body()), html_(message.Html()),
+      attachments_(message.Attachments()) {}
+
+  // Destructor. Destroys this MIME message.
+  ~MimeMessage() noexcept = default;
+
+  // Copy constructor. Constructs a MIME message by copying another one.
+  MimeMessage(const MimeMessage& other) = default;
+
+  // Move constructor. Constructs a MIME message by moving another one.
+  MimeMessage(MimeMessage&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this MIME message by copying another one.
+  MimeMessage& operator=(const MimeMessage& other) = default;
+
+  // Move assignment operator. Assigns this MIME message by moving another one.
+  MimeMessage& operator=(MimeMessage&& other) noexcept = default;
+
+  // Header fields of this MIME message, other than the MIME header fields, with decoded values.
+  [[nodiscard]] const std::vector<MimeHeaderField>& HeaderFields() const noexcept {
+    return header_fields_;
+  }
+
+  // Value of the header field of a given name, matched regardless of case, or an empty string if
+  // there is none.
+  [[nodiscard]] std::string HeaderField(const std::string& name) const {
+    return FindMimeHeaderField(header_fields_, name);
+  }
+
+  // Plain text body of this MIME message.
+  [[nodiscard]] const std::string& Text() const noexcept {
+    return text_;
+  }
+
+  // HTML alternative body of this MIME message, or an empty string if there is none.
+  [[nodiscard]] const std::string& Html() const noexcept {
+    return html_;
+  }
+
+  // Files attached to this MIME message.
+  [[nodiscard]] const std::vector<std::shared_ptr<const EmailAttachment>>&
+  Attachments() const noexcept {
+    return attachments_;
+  }
+
+  // Adds a header field to this MIME message.
+  void AddHeaderField(std::string name, std::string value) {
+    header_fields_.push_back(MimeHeaderField{std::move(name), std::move(value)});
+  }
+
+  // Sets the HTML alternative body of this MIME message.
+  void SetHtml(std::string html) {
+    html_ = std::move(html);
+  }
+
+  // Attaches a file to this MIME message.
+  void Attach(std::shared_ptr<const EmailAttachment> attachment) {
+    attachments_.push_back(std::move(attachment));
+  }
+
+  // Composes this MIME message, with every line terminated by a carriage return and line feed. The
+  // encoders are vectorized unless requested otherwise.
+  [[nodiscard]] std::string Compose(const bool vectorized = true) const {
+    std::string contents;
+    std::size_t size = text_.size() + text_.size() / 8 + 2 * html_.size() + 512;
+    for (const std::shared_ptr<const EmailAttachment>& attachment : attachments_) {
+      size += attachment->encoded_part.empty() ?
+                  Base64EncodedLength(attachment->data.size()) * 78 / 76 + 256 :
+                  attachment->encoded_part.size();
+    }
+    contents.reserve(size);
+
+    for (const MimeHeaderField& field : header_fields_) {
+      contents.append(field.name + ": " + EncodeHeaderValue(field.value, field.name.size())
+                      + "\r\n");
+    }
+    contents.append("MIME-Version: 1.0\r\n");
+
+    if (attachments_.empty()) {
+      AppendContent(contents, vectorized);
+      return contents;
+    }
+
+    contents.append("Content-Type: multipart/mixed; boundary=\"" + MimeMixedBoundary + "\"\r\n");
+    contents.append("\r\n");
+    contents.append("--" + MimeMixedBoundary + "\r\n");
+    AppendContent(contents, vectorized);
+    for (const std::shared_ptr<const EmailAttachment>& attachment : attachments_) {
+      contents.append("\r\n--" + MimeMixedBoundary + "\r\n");
+      if (attachment->encoded_part.empty()) {
+        contents.append(EncodeAttachmentPart(*attachment, vectorized));
+      } else {
+        contents.append(attachment->encoded_part);
+      }
+    }
+    contents.append("\r\n--" + MimeMixedBoundary + "--\r\n");
+    return contents;
+  }
+
+  // Parses a MIME message from its contents. Decodes its header fields and bodies, and collects its
+  // plain text body, HTML body, and attachments from its parts, however they are nested. Also
+  // parses messages that are not MIME messages, whose body is plain text. Returns no value if the
+  // contents have no header fields.
+  [[nodiscard]] static std::optional<MimeMessage> Parse(const std::string_view contents) {
+    std::size_t position = 0;
+    std::vector<MimeHeaderField> fields{ParseMimeHeaderSection(contents, position)};
+    if (fields.empty()) {
+      return std::nullopt;
+    }
+
+    MimeMessage message;
+    message.ParsePart(fields, contents.substr(position));
+    for (MimeHeaderField& field : fields) {
+      const std::string name{LowercaseAscii(field.name)};
+      if (name != "mime-version" && name != "content-type" && name != "content-transfer-encoding"
+          && name != "content-disposition") {
+        message.header_fields_.push_back(
+            MimeHeaderField{std::move(field.name), DecodeHeaderValue(field.value)});
+      }
+    }
+    return message;
+  }
+
+private:
+  // Appends the content of this MIME message, apart from its attachments, to given contents: its
+  // content header fields, a blank line, and its plain text body, or both of its bodies as a
+  // multipart/alternative part if it has an HTML body.
+  void AppendContent(std::string& contents, const bool vectorized) const {
+    if (html_.empty()) {
+      AppendTextPart(contents, "text/plain", text_, vectorized);
+      return;
+    }
+    contents.append(
+        "Content-Type: multipart/alternative; boundary=\"" + MimeAlternativeBoundary + "\"\r\n");
+    contents.append("\r\n");
+    contents.append("--" + MimeAlternativeBoundary + "\r\n");
+    AppendTextPart(contents, "text/plain", text_, vectorized);
+    contents.append("\r\n--" + MimeAlternativeBoundary + "\r\n");
+    AppendTextPart(contents, "text/html", html_, vectorized);
+    contents.append("\r\n--" + MimeAlternativeBoundary + "--\r\n");
+  }
+
+  // Appends a text part of a given content type and text to given contents: its content header
+  // fields, a blank line, and its quoted-printable body.
+  static void AppendTextPart(std::string& contents, const std::string& content_type,
+                             const std::string& text, const bool vectorized) {
+    contents.append("Content-Type: " + content_type + "; charset=utf-8\r\n");
+    contents.append("Content-Transfer-Encoding: quoted-printable\r\n");
+    contents.append("\r\n");
+    contents.append(QuotedPrintableEncode(text, vectorized));
+  }
+
+  // Collects the plain text body, HTML body, or attachments of a part with given header fields and
+  // a given body. Parses the parts of a multipart part recursively.
+  void ParsePart(const std::vector<MimeHeaderField>& fields, const std::string_view body) {
+    const std::string content_type{FindMimeHeaderField(fields, "Content-Type")};
+    const std::string media_type{LowercaseAscii(content_type.substr(0, content_type.find(';')))};
+    const std::string boundary{MimeHeaderParameter(content_type, "boundary")};
+
+    if (media_type.rfind("multipart/", 0) == 0 && !boundary.empty()) {
+      const std::string delimiter{"--" + boundary};
+      std::size_t position = body.find(delimiter);
+      while (position != std::string_view::npos) {
+        position += delimiter.size();
+        if (body.substr(position, 2) == "--") {
+          break;
+        }
+        // Skips the rest of the delimiter line.
+        position = body.find('\n', position);
+        if (position == std::string_view::npos) {
+          break;
+        }
+        ++position;
+        // The line break before the next delimiter belongs to the delimiter.
+        std::size_t next = body.find("\n" + delimiter, position);
+        std::size_t end = next;
+        if (next == std::string_view::npos) {
+          end = body.size();
+        } else if (next > position && body[next - 1] == '\r') {
+          end = next - 1;
+        }
+        if (next != std::string_view::npos) {
+          ++next;
+        }
+        const std::string_view part{body.substr(position, end - position)};
+        std::size_t part_position = 0;
+        const std::vector<MimeHeaderField> part_fields{
+            ParseMimeHeaderSection(part, part_position)};
+        ParsePart(part_fields, part.substr(part_position));
+        position = next;
+      }
+      return;
+    }
+
+    const std::string transfer_encoding{FindMimeHeaderField(fields, "Content-Transfer-Encoding")};
+    const std::string disposition{FindMimeHeaderField(fields, "Content-Disposition")};
+    std::string file_name{MimeHeaderParameter(disposition, "filename")};
+    if (file_name.empty()) {
+      file_name = MimeHeaderParameter(content_type, "name");
+    }
+
+    if (LowercaseAscii(disposition).rfind("attachment", 0) == 0 || !file_name.empty()) {
+      attachments_.push_back(std::make_shared<const EmailAttachment>(EmailAttachment{
+          file_name, media_type.empty() ? "application/octet-stream" : media_type,
+          DecodeMimeBody(body, transfer_encoding), {}}));
+    } else if (media_type == "text/html") {
+      html_ = DecodeMimeBody(body, transfer_encoding);
+    } else if ((media_type.empty() || media_type == "text/plain") && text_.empty()) {
+      text_ = DecodeMimeBody(body, transfer_encoding);
+    }
+  }
+
+  // Header fields of this MIME message, other than the MIME header fields, with decoded values.
+  std::vector<MimeHeaderField> header_fields_;
+
+  // Plain text body of this MIME message.
+  std::string text_;
+
+  // HTML alternative body of this MIME message, or an empty string if there is none.
+  std::string html_;
+
+  // Files attached to this MIME message.
+  std::vector<std::shared_ptr<const EmailAttachment>> attachments_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_MIME_MESSAGE_HPP
@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <string>
+#include <utility>
 #include <yaml-cpp/yaml.h>
 
 namespace SecretSanta {
@@ -38,11 +39,23 @@ public:
   // instructions are empty. Only used for searching through a set of participants.
   explicit Participant(const std::string& name) : name_(name) {}
 
+  // Constructor. Creates a participant from its name, email address, street address, and
+  // instructions, and optionally its group, time zone, and location.
+  Participant(std::string name, std::string email, std::string address, std::string instructions,
+              std::string group = {}, std::string time_zone = {}, std::string location = {})
+    : name_(std::move(name)), email_(std::move(email)), address_(std::move(address)),
+      instructions_(std::move(instructions)), group_(std::move(group)),
+      time_zone_(std::move(time_zone)), location_(std::move(location)) {}
+
   // Constructor. Creates a participant from a YAML node of the form:
   //   Alice Smith:
   //     email: alice.smith@gmail.com
   //     address: 123 First Ave, Apt 1, Townsville, CA, 91234 USA
   //     instructions: Leave the package with the doorman in the lobby.
+  //     group: Marketing
+  //     timezone: America/Los_Angeles
+  //     location: 34.0522, -118.2437
+  // The group, time zone, and location are optional.
   explicit Participant(const YAML::Node& node) {
     if (!node.IsMap()) {
       return;
@@ -70,6 +83,18 @@ public:
       if (element.second["instructions"]) {
         instructions_ = element.second["instructions"].as<std::string>();
       }
+
+      if (element.second["group"]) {
+        group_ = element.second["group"].as<std::string>();
+      }
+
+      if (element.second["timezone"]) {
+        time_zone_ = element.second["timezone"].as<std::string>();
+      }
+
+      if (element.second["location"]) {
+        location_ = element.second["location"].as<std::string>();
+      }
     }
   }
 
@@ -108,6 +133,27 @@ public:
     return instructions_;
   }
 
+  // Group of this participant, such as a team, a room, or a household. Empty if this participant
+  // does not belong to any group. When the matchings are aligned to groups, each group forms its
+  // own self-contained gift exchange cycles.
+  [[nodiscard]] const std::string& Group() const noexcept {
+    return group_;
+  }
+
+  // Time zone of this participant in the IANA time zone database, such as "America/Los_Angeles".
+  // Empty if unknown, in which case the local time zone of the sender is assumed. Used to send
+  // this participant's email message at a given local time of day.
+  [[nodiscard]] const std::string& TimeZone() const noexcept {
+    return time_zone_;
+  }
+
+  // Location of this participant, either as a latitude and longitude in degrees, such as
+  // "34.0522, -118.2437", or as a postal code. Empty if unknown. Used to match gifters with nearby
+  // giftees so as to shorten the shipping distances of the gifts.
+  [[nodiscard]] const std::string& Location() const noexcept {
+    return location_;
+  }
+
   // Prints this participant as a string.
   [[nodiscard]] std::string Print() const noexcept {
     std::string details;
@@ -130,6 +176,27 @@ public:
       details.append("instructions: " + instructions_);
     }
 
+    if (!group_.empty()) {
+      if (!details.empty()) {
+        details.append("; ");
+      }
+      details.append("group: " + group_);
+    }
+
+    if (!time_zone_.empty()) {
+      if (!details.empty()) {
+        details.append("; ");
+      }
+      details.append("timezone: " + time_zone_);
+    }
+
+    if (!location_.empty()) {
+      if (!details.empty()) {
+        details.append("; ");
+      }
+      details.append("location: " + location_);
+    }
+
     if (details.empty()) {
       return name_;
     } else {
@@ -143,11 +210,24 @@ public:
   //     email: alice.smith@gmail.com
   //     address: 123 First Ave, Apt 1, Townsville, CA, 91234 USA
   //     instructions: Leave the package with the doorman in the lobby.
+  //     group: Marketing
+  //     timezone: America/Los_Angeles
+  //     location: 34.0522, -118.2437
+  // The group, time zone, and location are omitted if they are empty.
   [[nodiscard]] YAML::Node YAML() const {
     YAML::Node node;
     node[name_]["email"] = email_;
     node[name_]["address"] = address_;
     node[name_]["instructions"] = instructions_;
+    if (!group_.empty()) {
+      node[name_]["group"] = group_;
+    }
+    if (!time_zone_.empty()) {
+      node[name_]["timezone"] = time_zone_;
+    }
+    if (!location_.empty()) {
+      node[name_]["location"] = location_;
+    }
     return node;
   }
 
@@ -187,6 +267,18 @@ private:
 
   // Additional instructions for mailing packages to this participant.
   std::string instructions_;
+
+  // Group of this participant, such as a team, a room, or a household. Empty if this participant
+  // does not belong to any group.
+  std::string group_;
+
+  // Time zone of this participant in the IANA time zone database, such as "America/Los_Angeles".
+  // Empty if unknown.
+  std::string time_zone_;
+
+  // Location of this participant, either as a latitude and longitude in degrees or as a postal
+  // code. Empty if unknown.
+  std::string location_;
 };
 
 inline std::ostream& operator<<(std::ostream& stream, const Participant& participant) {
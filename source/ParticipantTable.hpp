@@ -0,0 +1,272 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_PARTICIPANT_TABLE_HPP
+#define SECRET_SANTA_PARTICIPANT_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "Participant.hpp"
+
+namespace SecretSanta {
+
+// Number of fields of a participant: name, email address, street address, instructions, group,
+// time zone, and location, in this order.
+static constexpr std::size_t ParticipantFieldCount{7};
+
+// Participant whose fields are stored in a participant table. Holds views of the table's storage,
+// so it is only valid while the table exists and no participants are added to it.
+class ParticipantView {
+public:
+  // Constructor. Constructs a participant from views of its fields, in the order of the fields of a
+  // participant.
+  explicit ParticipantView(const std::array<std::string_view, ParticipantFieldCount>& fields)
+    : fields_(fields) {}
+
+  // Name of this participant.
+  [[nodiscard]] std::string_view Name() const noexcept {
+    return fields_[0];
+  }
+
+  // Email address of this participant.
+  [[nodiscard]] std::string_view Email() const noexcept {
+    return fields_[1];
+  }
+
+  // Street address of this participant.
+  [[nodiscard]] std::string_view Address() const noexcept {
+    return fields_[2];
+  }
+
+  // Additional instructions for mailing packages to this participant.
+  [[nodiscard]] std::string_view Instructions() const noexcept {
+    return fields_[3];
+  }
+
+  // Group of this participant. Empty if this participant does not belong to any group.
+  [[nodiscard]] std::string_view Group() const noexcept {
+    return fields_[4];
+  }
+
+  // Time zone of this participant in the IANA time zone database. Empty if unknown.
+  [[nodiscard]] std::string_view TimeZone() const noexcept {
+    return fields_[5];
+  }
+
+  // Location of this participant, either as a latitude and longitude in degrees or as a postal
+  // code. Empty if unknown.
+  [[nodiscard]] std::string_view Location() const noexcept {
+    return fields_[6];
+  }
+
+  // Creates a participant that owns a copy of the fields of this participant.
+  [[nodiscard]] Participant ToParticipant() const {
+    return Participant{std::string{fields_[0]}, std::string{fields_[1]}, std::string{fields_[2]},
+                       std::string{fields_[3]}, std::string{fields_[4]}, std::string{fields_[5]},
+                       std::string{fields_[6]}};
+  }
+
+private:
+  // Views of the fields of this participant, in the order of the fields of a participant.
+  std::array<std::string_view, ParticipantFieldCount> fields_;
+};
+
+// Table of participants whose fields are stored contiguously in one arena rather than in strings of
+// their own. A participant costs one compact record plus the bytes of its fields, instead of one
+// heap allocation per field that does not fit in a short string, so that loading a large roster
+// makes few allocations, its fields are read sequentially from memory, and destroying it frees a
+// few blocks rather than millions. Participants are looked up by name, and can be copied into
+// participants that own their fields when needed.
+class ParticipantTable {
+public:
+  // Default constructor. Constructs an empty table.
+  ParticipantTable() = default;
+
+  // Constructor. Constructs a table from the participants node of a YAML configuration file, which
+  // is a list of nodes of the form read by the constructor of a participant. Entries without a
+  // name are skipped, and only the first entry of each name is kept.
+  explicit ParticipantTable(const YAML::Node& participants) {
+    if (participants.IsSequence()) {
+      records_.reserve(participants.size());
+    }
+
+    for (const YAML::iterator::value_type& node : participants) {
+      if (!node.IsMap() || node.size() != 1) {
+        continue;
+      }
+
+      for (const YAML::detail::iterator_value& element : node) {
+        Add({element.first.Scalar(), Scalar(element.second, "email"),
+             Scalar(element.second, "address"), Scalar(element.second, "instructions"),
+             Scalar(element.second, "group"), Scalar(element.second, "timezone"),
+             Scalar(element.second, "location")});
+      }
+    }
+
+    Sort();
+  }
+
+  // Destructor. Destroys this table.
+  ~ParticipantTable() noexcept = default;
+
+  // Deleted copy constructor.
+  ParticipantTable(const ParticipantTable& other) = delete;
+
+  // Move constructor. Constructs a table by moving another one. The views of the participants of
+  // the other table remain valid.
+  ParticipantTable(ParticipantTable&& other) noexcept = default;
+
+  // Deleted copy assignment operator.
+  ParticipantTable& operator=(const ParticipantTable& other) = delete;
+
+  // Move assignment operator. Assigns this table by moving another one. The views of the
+  // participants of the other table remain valid.
+  ParticipantTable& operator=(ParticipantTable&& other) noexcept = default;
+
+  // Reserves storage for a given number of participants whose fields hold a given total number of
+  // bytes, such that adding them makes no further allocations.
+  void Reserve(const std::size_t participant_count, const std::size_t byte_count) {
+    records_.reserve(participant_count);
+    bytes_.reserve(byte_count);
+  }
+
+  // Adds a participant from its fields, in the order of the fields of a participant. Returns
+  // whether the participant was added, which is not the case if its name is empty. The table must
+  // be sorted once all participants are added and before any participant is looked up by name.
+  bool Add(const std::array<std::string_view, ParticipantFieldCount>& fields) {
+    if (fields[0].empty()) {
+      return false;
+    }
+
+    Record record;
+    record.offset = bytes_.size();
+    uint32_t end{0};
+    for (std::size_t field = 0; field < ParticipantFieldCount; ++field) {
+      bytes_.insert(bytes_.end(), fields[field].begin(), fields[field].end());
+      end += static_cast<uint32_t>(fields[field].size());
+      record.ends[field] = end;
+    }
+    records_.push_back(record);
+    return true;
+  }
+
+  // Sorts the participants by name and removes all but the first participant of each name. The
+  // fields of the removed participants stay in the arena until the table is destroyed.
+  void Sort() {
+    std::stable_sort(records_.begin(), records_.end(),
+                     [this](const Record& first, const Record& second) {
+                       return Name(first) < Name(second);
+                     });
+    records_.erase(std::unique(records_.begin(), records_.end(),
+                               [this](const Record& first, const Record& second) {
+                                 return Name(first) == Name(second);
+                               }),
+                   records_.end());
+  }
+
+  // Number of participants in this table.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return records_.size();
+  }
+
+  // Number of bytes of the arena that holds the fields of the participants.
+  [[nodiscard]] std::size_t ByteCount() const noexcept {
+    return bytes_.size();
+  }
+
+  // Participant at a given index. Once the table is sorted, the participants are in alphabetical
+  // order of their names.
+  [[nodiscard]] ParticipantView operator[](const std::size_t index) const {
+    const Record& record{records_[index]};
+    std::array<std::string_view, ParticipantFieldCount> fields;
+    uint32_t start{0};
+    for (std::size_t field = 0; field < ParticipantFieldCount; ++field) {
+      fields[field] = std::string_view{bytes_.data() + record.offset + start,
+                                       static_cast<std::size_t>(record.ends[field] - start)};
+      start = record.ends[field];
+    }
+    return ParticipantView{fields};
+  }
+
+  // Participant of a given name, if any. The table must be sorted.
+  [[nodiscard]] std::optional<ParticipantView> Find(const std::string_view name) const {
+    const std::vector<Record>::const_iterator found{std::lower_bound(
+        records_.begin(), records_.end(), name,
+        [this](const Record& record, const std::string_view value) {
+          return Name(record) < value;
+        })};
+    if (found == records_.end() || Name(*found) != name) {
+      return std::nullopt;
+    }
+    return (*this)[static_cast<std::size_t>(found - records_.begin())];
+  }
+
+  // Creates the set of participants that own a copy of the fields of the participants of this
+  // table, as read by a configuration.
+  [[nodiscard]] std::set<Participant> ToParticipants() const {
+    std::set<Participant> participants;
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+      participants.insert(participants.end(), (*this)[index].ToParticipant());
+    }
+    return participants;
+  }
+
+private:
+  // Record of a participant: where its fields start in the arena and where each field ends,
+  // relative to the start of its first field.
+  struct Record {
+    // Offset of the first field of the participant in the arena.
+    std::size_t offset{0};
+
+    // End of each field of the participant relative to the start of its first field.
+    std::array<uint32_t, ParticipantFieldCount> ends{};
+  };
+
+  // Name of the participant of a given record.
+  [[nodiscard]] std::string_view Name(const Record& record) const noexcept {
+    return std::string_view{bytes_.data() + record.offset, record.ends[0]};
+  }
+
+  // Scalar value of a given key of a given YAML node, or an empty value if the key is absent or its
+  // value is not a scalar.
+  [[nodiscard]] static std::string_view Scalar(const YAML::Node& node, const char* const key) {
+    const YAML::Node value{node[key]};
+    return value && value.IsScalar() ? std::string_view{value.Scalar()} : std::string_view{};
+  }
+
+  // Arena that holds the fields of all participants, one after the other.
+  std::vector<char> bytes_;
+
+  // Records of the participants.
+  std::vector<Record> records_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_PARTICIPANT_TABLE_HPP
@@ -0,0 +1,260 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_RANDOM_ROUNDS_HPP
+#define SECRET_SANTA_RANDOM_ROUNDS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "CycleLengths.hpp"
+
+namespace SecretSanta {
+
+// Random rounds of gifts among one group of participants, who are identified by their indices
+// starting at zero. In each round, every participant gifts once and receives once: the participants
+// are shuffled and split into consecutive runs whose lengths respect optional cycle length bounds,
+// and each participant gifts to the next participant of their run. No pair of a gifter and a giftee
+// appears in two rounds, and no participant gifts to themselves unless they are alone in the group.
+// This is the draw behind randomized matchings; it is kept apart from participant names so that
+// the fairness of the draw can be audited over many draws. The buffers are reused from one draw to
+// the next.
+class RandomRounds {
+public:
+  // Constructor. Constructs the rounds of gifts of a given number of participants, given the number
+  // of rounds and optional cycle length bounds. A group of N participants has at most N - 1
+  // rounds, or one round if N is one, so fewer rounds are drawn if more are requested. Nothing is
+  // drawn until Draw is called.
+  RandomRounds(const std::size_t participant_count, const std::size_t round_count,
+               const std::optional<CycleLengths>& cycle_lengths = std::nullopt)
+    : cycle_lengths_(cycle_lengths),
+      giftees_(std::min(std::max<std::size_t>(round_count, 1),
+                        std::max<std::size_t>(participant_count, 2) - 1),
+               std::vector<std::size_t>(participant_count)),
+      order_(participant_count), next_(participant_count), previous_(participant_count) {}
+
+  // Destructor. Destroys this random rounds object.
+  ~RandomRounds() noexcept = default;
+
+  // Deleted copy constructor.
+  RandomRounds(const RandomRounds& other) = delete;
+
+  // Deleted move constructor.
+  RandomRounds(RandomRounds&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  RandomRounds& operator=(const RandomRounds& other) = delete;
+
+  // Deleted move assignment operator.
+  RandomRounds& operator=(RandomRounds&& other) noexcept = delete;
+
+  // Number of participants.
+  [[nodiscard]] std::size_t ParticipantCount() const noexcept {
+    return order_.size();
+  }
+
+  // Number of rounds of gifts, which may be fewer than requested in a small group.
+  [[nodiscard]] std::size_t RoundCount() const noexcept {
+    return giftees_.size();
+  }
+
+  // Giftee of each participant in a given round of the last draw, by participant index.
+  [[nodiscard]] const std::vector<std::size_t>& Giftees(const std::size_t round) const noexcept {
+    return giftees_[round];
+  }
+
+  // Number of cycles of the first round of the last draw.
+  [[nodiscard]] std::size_t CycleCount() const noexcept {
+    return cycle_count_;
+  }
+
+  // Whether the participants could be split into cycles within the cycle length bounds in the last
+  // draw. If not, each round is one cycle instead.
+  [[nodiscard]] bool Partitioned() const noexcept {
+    return partitioned_;
+  }
+
+  // Whether the last draw fell back on offsetting one shuffled order because the participants
+  // could not be moved around enough to keep the rounds from repeating a pair.
+  [[nodiscard]] bool Offset() const noexcept {
+    return offset_;
+  }
+
+  // Draws new rounds of gifts with a given random generator. Each round is randomized in the same
+  // way, and then participants are moved between the positions of the cycles until no pair repeats
+  // a pair of an earlier round. If this fails, which only happens in small groups, each participant
+  // instead gifts to the participant one position further along one shuffled order in the first
+  // round, two positions further along in the second round, and so on. Runs in expected time
+  // linear in the number of participants times the number of rounds.
+  void Draw(std::mt19937_64& random_generator) {
+    const std::size_t participant_count = order_.size();
+    cycle_count_ = 0;
+    partitioned_ = true;
+    offset_ = false;
+    used_pairs_.clear();
+    if (participant_count == 0) {
+      return;
+    }
+
+    for (std::size_t round = 0; round < giftees_.size(); ++round) {
+      // Shuffle the participants.
+      std::iota(order_.begin(), order_.end(), 0);
+      std::shuffle(order_.begin(), order_.end(), random_generator);
+
+      // Split the shuffled participants into consecutive runs, one per cycle.
+      std::vector<std::size_t> lengths{participant_count};
+      if (cycle_lengths_.has_value()) {
+        const std::optional<std::vector<std::size_t>> partition =
+            cycle_lengths_->Partition(participant_count, random_generator);
+
+        if (partition.has_value()) {
+          lengths = partition.value();
+        } else {
+          partitioned_ = false;
+        }
+      }
+
+      // Within each run, each participant in the shuffled sequence is a gifter, and their giftee is
+      // the next participant in the run. The last participant of the run gifts to the first one.
+      // This results in one cyclic list per run rather than a graph and guarantees that gifters
+      // cannot be their own giftees unless a run contains a single participant. For example,
+      // consider the sequence [Alice, Bob, Claire, David]. After shuffling, suppose this sequence
+      // is [Claire, Bob, David, Alice]. With one run, the matchings are: Claire->Bob, Bob->David,
+      // David->Alice, and Alice->Claire. With two runs of two participants, the matchings are:
+      // Claire->Bob, Bob->Claire, David->Alice, and Alice->David.
+      std::size_t offset = 0;
+      for (const std::size_t length : lengths) {
+        for (std::size_t index = 0; index < length; ++index) {
+          next_[offset + index] = offset + (index + 1) % length;
+          previous_[offset + (index + 1) % length] = offset + index;
+        }
+        offset += length;
+      }
+
+      if (round == 0) {
+        cycle_count_ = lengths.size();
+      } else if (!Untangle(random_generator)) {
+        offset_ = true;
+        break;
+      }
+
+      for (std::size_t position = 0; position < participant_count; ++position) {
+        giftees_[round][order_[position]] = order_[next_[position]];
+      }
+      if (round + 1 < giftees_.size()) {
+        for (std::size_t position = 0; position < participant_count; ++position) {
+          used_pairs_.insert(static_cast<uint64_t>(order_[position]) * participant_count
+                             + order_[next_[position]]);
+        }
+      }
+    }
+
+    // No two rounds share a pair since the offsets differ.
+    if (offset_) {
+      std::iota(order_.begin(), order_.end(), 0);
+      std::shuffle(order_.begin(), order_.end(), random_generator);
+      for (std::size_t round = 0; round < giftees_.size(); ++round) {
+        for (std::size_t position = 0; position < participant_count; ++position) {
+          giftees_[round][order_[position]] =
+              order_[(position + round + 1) % participant_count];
+        }
+      }
+    }
+  }
+
+private:
+  // Moves participants between the positions of the shuffled order until no participant gifts to
+  // the next participant of their cycle in an earlier round. Each repair swaps the giftee of a
+  // repeated pair with the participant at a random position, which keeps the lengths of the
+  // cycles, and then rechecks the four pairs that the swap affects. A repeated pair is rare when
+  // there are few rounds compared with the number of participants, so this takes expected linear
+  // time. Returns false if it gives up, which happens in small groups.
+  [[nodiscard]] bool Untangle(std::mt19937_64& random_generator) {
+    const std::size_t count = order_.size();
+    const std::function<bool(std::size_t)> is_repeated = [&](const std::size_t position) -> bool {
+      const uint64_t pair =
+          static_cast<uint64_t>(order_[position]) * count + order_[next_[position]];
+      return used_pairs_.count(pair) > 0;
+    };
+
+    std::uniform_int_distribution<std::size_t> position_distribution(0, count - 1);
+    std::size_t remaining_swap_count = 16 * count + 64;
+    pending_.resize(count);
+    std::iota(pending_.begin(), pending_.end(), 0);
+    while (!pending_.empty()) {
+      const std::size_t position = pending_.back();
+      pending_.pop_back();
+      if (!is_repeated(position)) {
+        continue;
+      }
+      if (remaining_swap_count == 0) {
+        return false;
+      }
+      --remaining_swap_count;
+      const std::size_t giftee_position = next_[position];
+      const std::size_t other_position = position_distribution(random_generator);
+      std::swap(order_[giftee_position], order_[other_position]);
+      pending_.insert(pending_.end(), {previous_[giftee_position], giftee_position,
+                                       previous_[other_position], other_position});
+    }
+    return true;
+  }
+
+  // Optional bounds on the number of participants in each cycle.
+  std::optional<CycleLengths> cycle_lengths_;
+
+  // Giftee of each participant in each round, by participant index.
+  std::vector<std::vector<std::size_t>> giftees_;
+
+  // Order of the participant indices after shuffling.
+  std::vector<std::size_t> order_;
+
+  // Position of the next participant in the same cycle, by position.
+  std::vector<std::size_t> next_;
+
+  // Position of the previous participant in the same cycle, by position.
+  std::vector<std::size_t> previous_;
+
+  // Positions whose pair remains to be checked while untangling a round.
+  std::vector<std::size_t> pending_;
+
+  // Pairs of a gifter and a giftee of the earlier rounds, each stored as the gifter index times the
+  // number of participants plus the giftee index.
+  std::unordered_set<uint64_t> used_pairs_;
+
+  // Number of cycles of the first round.
+  std::size_t cycle_count_{0};
+
+  // Whether the participants could be split into cycles within the cycle length bounds.
+  bool partitioned_{true};
+
+  // Whether the draw fell back on offsetting one shuffled order.
+  bool offset_{false};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_RANDOM_ROUNDS_HPP
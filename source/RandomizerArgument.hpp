@@ -37,9 +37,45 @@ static const std::string Configuration{"--configuration"};
 // Path to the YAML matchings file to be written. Optional.
 static const std::string Matchings{"--matchings"};
 
+// Path to a previous YAML matchings file to be updated rather than randomized anew. Optional.
+static const std::string PreviousMatchings{"--previous-matchings"};
+
 // Seed value for pseudo-random number generation. Optional.
 static const std::string Seed{"--seed"};
 
+// Minimum number of participants in each gift exchange cycle. Optional.
+static const std::string MinimumCycleLength{"--minimum-cycle-length"};
+
+// Maximum number of participants in each gift exchange cycle. Optional.
+static const std::string MaximumCycleLength{"--maximum-cycle-length"};
+
+// Aligns the gift exchange cycles to the participants' groups. Optional.
+static const std::string Groups{"--groups"};
+
+// Sends the email messages to the gifters directly from the randomized matchings. Optional.
+static const std::string Send{"--send"};
+
+// Matches gifters with giftees so as to minimize the total or maximum shipping distance between
+// them. Optional.
+static const std::string MinimizeDistance{"--minimize-distance"};
+
+// Amount of randomness mixed into the shipping distances when minimizing them. Optional.
+static const std::string DistanceRandomness{"--distance-randomness"};
+
+// Path to a CSV file of the coordinates of postal codes. Optional.
+static const std::string PostalCodes{"--postal-codes"};
+
+// Number of gifts that each participant gives and receives. Optional.
+static const std::string Gifts{"--gifts"};
+
+// Path to the YAML tokens file with which participants look up their giftees, to be written or
+// updated. Optional.
+static const std::string Tokens{"--tokens"};
+
+// Watches the configuration file and revalidates it whenever it changes instead of randomizing the
+// matchings. Optional.
+static const std::string Watch{"--watch"};
+
 }  // namespace Key
 
 namespace Value {
@@ -47,9 +83,15 @@ namespace Value {
 // Integer number.
 static const std::string Integer{"<integer>"};
 
+// Real number.
+static const std::string Number{"<number>"};
+
 // Filesystem path.
 static const std::string Path{"<path>"};
 
+// Shipping distance to minimize.
+static const std::string DistanceObjective{"<total|maximum>"};
+
 }  // namespace Value
 
 // Prints usage instructions and exits. Optional.
@@ -67,11 +109,69 @@ static const std::string Path{"<path>"};
   return Key::Matchings + " " + Value::Path;
 }
 
+// Path to a previous YAML matchings file to be updated rather than randomized anew. Optional.
+[[nodiscard]] std::string PreviousMatchings() {
+  return Key::PreviousMatchings + " " + Value::Path;
+}
+
 // Seed value for pseudo-random number generation. Optional.
 [[nodiscard]] std::string Seed() {
   return Key::Seed + " " + Value::Integer;
 }
 
+// Minimum number of participants in each gift exchange cycle. Optional.
+[[nodiscard]] std::string MinimumCycleLength() {
+  return Key::MinimumCycleLength + " " + Value::Integer;
+}
+
+// Maximum number of participants in each gift exchange cycle. Optional.
+[[nodiscard]] std::string MaximumCycleLength() {
+  return Key::MaximumCycleLength + " " + Value::Integer;
+}
+
+// Aligns the gift exchange cycles to the participants' groups. Optional.
+[[nodiscard]] std::string_view Groups() {
+  return Key::Groups;
+}
+
+// Sends the email messages to the gifters directly from the randomized matchings. Optional.
+[[nodiscard]] std::string_view Send() {
+  return Key::Send;
+}
+
+// Matches gifters with giftees so as to minimize the total or maximum shipping distance between
+// them. Optional.
+[[nodiscard]] std::string MinimizeDistance() {
+  return Key::MinimizeDistance + " " + Value::DistanceObjective;
+}
+
+// Amount of randomness mixed into the shipping distances when minimizing them. Optional.
+[[nodiscard]] std::string DistanceRandomness() {
+  return Key::DistanceRandomness + " " + Value::Number;
+}
+
+// Path to a CSV file of the coordinates of postal codes. Optional.
+[[nodiscard]] std::string PostalCodes() {
+  return Key::PostalCodes + " " + Value::Path;
+}
+
+// Number of gifts that each participant gives and receives. Optional.
+[[nodiscard]] std::string Gifts() {
+  return Key::Gifts + " " + Value::Integer;
+}
+
+// Path to the YAML tokens file with which participants look up their giftees, to be written or
+// updated. Optional.
+[[nodiscard]] std::string Tokens() {
+  return Key::Tokens + " " + Value::Path;
+}
+
+// Watches the configuration file and revalidates it whenever it changes instead of randomizing the
+// matchings. Optional.
+[[nodiscard]] std::string_view Watch() {
+  return Key::Watch;
+}
+
 }  // namespace SecretSanta::Randomizer::Argument
 
 #endif  // SECRET_SANTA_RANDOMIZER_ARGUMENT_HPP
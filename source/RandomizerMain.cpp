@@ -18,20 +18,232 @@
 //     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
 //     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
 #include <yaml-cpp/yaml.h>
 
 #include "Configuration.hpp"
+#include "DeadLetters.hpp"
+#include "Emailer.hpp"
+#include "FileWatcher.hpp"
+#include "IncrementalConfiguration.hpp"
 #include "Matchings.hpp"
 #include "RandomizerSettings.hpp"
+#include "Tokens.hpp"
+#include "TransportStack.hpp"
+
+namespace {
+
+// Prints the participants of a given configuration whose names are given.
+void PrintParticipants(const std::string& title, const std::vector<std::string>& names,
+                       const SecretSanta::IncrementalConfiguration& configuration) {
+  if (names.empty()) {
+    return;
+  }
+
+  std::cout << title << std::endl;
+  for (const std::string& name : names) {
+    const std::map<std::string, SecretSanta::Participant>::const_iterator participant{
+        configuration.Participants().find(name)};
+    std::cout << "- "
+              << (participant != configuration.Participants().end() ?
+                      participant->second.Print() :
+                      name)
+              << std::endl;
+  }
+}
+
+// Watches the configuration file and revalidates it whenever it changes, until the program is
+// interrupted. Only the participant entries that changed are parsed again, so each revision is
+// revalidated in milliseconds even for large configuration files. Prints the participants that
+// were added, removed, or changed, and the problems found.
+void Watch(const std::filesystem::path& path) {
+  SecretSanta::FileWatcher watcher{path};
+  if (!watcher.IsValid()) {
+    std::cout << "Cannot watch the YAML configuration file at " << path
+              << "; please check the file path." << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  SecretSanta::IncrementalConfiguration configuration;
+  bool first{true};
+  while (true) {
+    const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+
+    std::ifstream stream{path, std::ios::binary};
+    if (!stream) {
+      std::cout << "Cannot find the YAML configuration file at " << path
+                << "; waiting for it to be written." << std::endl;
+    } else {
+      const std::string text{
+          std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+      const SecretSanta::ConfigurationChanges changes{configuration.Update(text)};
+      const std::chrono::duration<double, std::milli> elapsed{
+          std::chrono::steady_clock::now() - start};
+
+      if (first) {
+        std::vector<std::string> names;
+        for (const std::pair<const std::string, SecretSanta::Participant>& element :
+             configuration.Participants()) {
+          names.push_back(element.first);
+        }
+        PrintParticipants("The participants are:", names, configuration);
+        first = false;
+      } else {
+        PrintParticipants("Added participants:", changes.added, configuration);
+        PrintParticipants("Removed participants:", changes.removed, configuration);
+        PrintParticipants("Changed participants:", changes.changed, configuration);
+        if (changes.header_changed) {
+          std::cout << "The message or the event changed." << std::endl;
+        }
+      }
+
+      if (configuration.Problems().empty()) {
+        std::cout << "No problems were found." << std::endl;
+      } else {
+        std::cout << configuration.Problems().size() << " problems were found:" << std::endl;
+        for (const std::string& problem : configuration.Problems()) {
+          std::cout << "- " << problem << std::endl;
+        }
+      }
+
+      std::cout << "A total of " << configuration.Participants().size()
+                << " participants were revalidated in " << elapsed.count() << " ms; "
+                << changes.parsed_entry_count << " of " << changes.entry_count
+                << " participant entries were parsed." << std::endl;
+    }
+
+    std::cout << "Watching " << path << " for changes; press Ctrl+C to stop." << std::endl;
+    while (!watcher.Wait(std::chrono::hours{1})) {}
+  }
+}
+
+// Gives each participant who has none a token with which to look up their giftees on the Secret
+// Santa Lookup server, and writes the tokens file. The tokens already in the file are kept, so
+// that the tokens handed out before the matchings were updated stay valid. Returns whether the
+// tokens file was written.
+bool WriteTokens(const std::filesystem::path& path,
+                 const SecretSanta::Configuration& configuration) {
+  std::optional<SecretSanta::Tokens> tokens;
+  if (std::filesystem::exists(path)) {
+    tokens.emplace(path);
+  } else {
+    tokens.emplace();
+  }
+
+  const std::size_t created_count{tokens->Update(configuration.Participants())};
+  std::cout << "Created " << created_count << " new tokens with which participants look up their "
+            << "giftees." << std::endl;
+
+  return tokens->Write(path);
+}
+
+// Writes the matchings to the matchings file and, if requested, sends the email messages to the
+// given gifters, or to all gifters if none are given. The participants and matchings stay in
+// memory, so the messages are composed directly from them and nothing is serialized and parsed
+// again. The matchings file is written before any message is sent, and no message is sent if it
+// cannot be written. The messages are sent through the same transports as the Secret Santa
+// Messenger with its default options: through the S-nail utility, with retries of the deliveries
+// that fail transiently, and with the messages that could not be sent written to the dead-letter
+// file, from which the Secret Santa Messenger sends them again. Returns whether the matchings file
+// and tokens file were written and every message was sent.
+bool WriteAndSend(const SecretSanta::Randomizer::Settings& settings,
+                  const SecretSanta::Configuration& configuration,
+                  const SecretSanta::Matchings& matchings,
+                  const std::optional<std::set<std::string>>& gifter_names = std::nullopt) {
+  bool succeeded{true};
+  if (settings.Send()) {
+    SecretSanta::TransportStack transport_stack{SecretSanta::TransportOptions{}};
+    if (!transport_stack.IsValid()) {
+      return false;
+    }
+    if (!SecretSanta::WriteMatchingsAndSendEmailMessages(configuration, matchings,
+                                                         settings.MatchingsFile(),
+                                                         transport_stack.Transport(),
+                                                         gifter_names)) {
+      return false;
+    }
+
+    const SecretSanta::DeadLetters undelivered{transport_stack.Transport().Undelivered()};
+    if (!undelivered.Empty()) {
+      const std::filesystem::path dead_letters_file{"dead_letters.yaml"};
+      undelivered.Write(dead_letters_file);
+      std::cout << "Send these email messages again once the cause of the failures is fixed with "
+                << "the Secret Santa Messenger and its --replay " << dead_letters_file.string()
+                << " argument." << std::endl;
+      succeeded = false;
+    }
+  } else if (!matchings.Write(settings.MatchingsFile())) {
+    return false;
+  }
+
+  if (!settings.TokensFile().empty() && !WriteTokens(settings.TokensFile(), configuration)) {
+    return false;
+  }
+  return succeeded;
+}
+
+}  // namespace
 
 int main(int argc, char* argv[]) {
   const SecretSanta::Randomizer::Settings settings{argc, argv};
 
+  if (settings.Watch()) {
+    Watch(settings.ConfigurationFile());
+  }
+
   const SecretSanta::Configuration configuration{settings.ConfigurationFile()};
 
-  const SecretSanta::Matchings matchings{configuration.Participants(), settings.RandomSeed()};
+  const std::optional<std::string> unmatchable_reason{
+      SecretSanta::UnmatchableReason(configuration.Participants(), settings.AlignToGroups())};
+  if (unmatchable_reason.has_value()) {
+    std::cout << unmatchable_reason.value() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (settings.MinimizeDistance().has_value()) {
+    const SecretSanta::PostalCodeTable postal_codes{settings.PostalCodesFile()};
+
+    SecretSanta::DistanceMatchingOptions options;
+    options.objective = settings.MinimizeDistance().value();
+    options.randomness = settings.DistanceRandomness();
+
+    const SecretSanta::Matchings matchings{configuration.Participants(), postal_codes, options,
+                                           settings.RandomSeed(), settings.AlignToGroups()};
+
+    if (!WriteAndSend(settings, configuration, matchings)) {
+      return EXIT_FAILURE;
+    }
+  } else if (settings.PreviousMatchingsFile().empty()) {
+    const SecretSanta::Matchings matchings{configuration.Participants(), settings.RandomSeed(),
+                                           settings.CycleLengthBounds(), settings.AlignToGroups(),
+                                           settings.GiftCount()};
+
+    if (!WriteAndSend(settings, configuration, matchings)) {
+      return EXIT_FAILURE;
+    }
+  } else {
+    SecretSanta::Matchings matchings{settings.PreviousMatchingsFile()};
+
+    const std::set<std::string> changed_gifters{
+        matchings.Update(configuration.Participants(), settings.RandomSeed(),
+                         settings.CycleLengthBounds(), settings.AlignToGroups())};
+
+    if (!changed_gifters.empty()) {
+      std::cout << "The following gifters have a new giftee and must be notified again:"
+                << std::endl;
+      for (const std::string& changed_gifter : changed_gifters) {
+        std::cout << "- " << changed_gifter << std::endl;
+      }
+    }
 
-  matchings.Write(settings.MatchingsFile());
+    if (!WriteAndSend(settings, configuration, matchings, changed_gifters)) {
+      return EXIT_FAILURE;
+    }
+  }
 
   std::cout << "End of " << SecretSanta::Randomizer::Program::Title << "." << std::endl;
 
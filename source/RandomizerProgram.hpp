@@ -37,7 +37,9 @@ static const std::string Description{
     "  Organizes a Secret Santa gift exchange event! Reads a YAML\n"
     "  configuration file containing a list of participants,\n"
     "  randomly generates Secret Santa matchings among the\n"
-    "  participants, and outputs the matchings to a YAML file."};
+    "  participants, and outputs the matchings to a YAML file.\n"
+    "  Optionally sends email messages to each participant\n"
+    "  informing them of their assigned giftee in the same run."};
 
 }  // namespace SecretSanta::Randomizer::Program
 
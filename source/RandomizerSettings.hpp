@@ -27,6 +27,8 @@
 #include <optional>
 #include <string>
 
+#include "CycleLengths.hpp"
+#include "DistanceMatching.hpp"
 #include "RandomizerArgument.hpp"
 #include "RandomizerProgram.hpp"
 #include "String.hpp"
@@ -72,12 +74,78 @@ public:
     return matchings_file_;
   }
 
+  // Path to a previous YAML matchings file to be updated to the current participants rather than
+  // randomized anew. If empty, the matchings are randomized anew.
+  [[nodiscard]] const std::filesystem::path& PreviousMatchingsFile() const noexcept {
+    return previous_matchings_file_;
+  }
+
   // Optional seed value for pseudo-random number generation. If no value is specified, the seed
   // value is randomized.
   [[nodiscard]] constexpr const std::optional<int64_t>& RandomSeed() const noexcept {
     return random_seed_;
   }
 
+  // Optional bounds on the number of participants in each gift exchange cycle. If no value is
+  // specified, the participants form one large cycle, or one cycle per group if the cycles are
+  // aligned to groups.
+  [[nodiscard]] std::optional<CycleLengths> CycleLengthBounds() const noexcept {
+    if (!minimum_cycle_length_.has_value() && !maximum_cycle_length_.has_value()) {
+      return std::nullopt;
+    }
+    const CycleLengths defaults;
+    return CycleLengths{minimum_cycle_length_.value_or(defaults.Minimum()),
+                        maximum_cycle_length_.value_or(defaults.Maximum())};
+  }
+
+  // Whether the gift exchange cycles are aligned to the participants' groups, such that each group
+  // forms its own self-contained cycles.
+  [[nodiscard]] constexpr bool AlignToGroups() const noexcept {
+    return align_to_groups_;
+  }
+
+  // Whether to send the email messages to the gifters directly from the randomized matchings in the
+  // same process rather than leaving this to the Secret Santa Messenger.
+  [[nodiscard]] constexpr bool Send() const noexcept {
+    return send_;
+  }
+
+  // Optional shipping distance between gifters and giftees to minimize. If no value is specified,
+  // the matchings are randomized without regard to distance.
+  [[nodiscard]] constexpr const std::optional<DistanceObjective>& MinimizeDistance()
+      const noexcept {
+    return minimize_distance_;
+  }
+
+  // Amount of randomness mixed into the shipping distances when minimizing them, from 0 for none.
+  [[nodiscard]] constexpr double DistanceRandomness() const noexcept {
+    return distance_randomness_;
+  }
+
+  // Path to a CSV file of the coordinates of postal codes, used for the participants whose
+  // location is a postal code. If empty, only locations given as coordinates are known.
+  [[nodiscard]] const std::filesystem::path& PostalCodesFile() const noexcept {
+    return postal_codes_file_;
+  }
+
+  // Number of gifts that each participant gives and receives, each to and from a different
+  // participant.
+  [[nodiscard]] constexpr std::size_t GiftCount() const noexcept {
+    return gift_count_;
+  }
+
+  // Path to the YAML tokens file with which participants look up their giftees on the Secret Santa
+  // Lookup server. The tokens already in the file are kept. If empty, no tokens file is written.
+  [[nodiscard]] const std::filesystem::path& TokensFile() const noexcept {
+    return tokens_file_;
+  }
+
+  // Whether to watch the configuration file and revalidate it whenever it changes instead of
+  // randomizing the matchings.
+  [[nodiscard]] constexpr bool Watch() const noexcept {
+    return watch_;
+  }
+
 private:
   // Prints the program's header information to the console.
   void PrintHeader() const {
@@ -93,14 +161,31 @@ private:
     std::cout << "Usage:" << std::endl;
 
     std::cout << indent << executable_name_ << " " << Argument::Configuration() << " ["
-              << Argument::Matchings() << "] " << " [" << Argument::Seed() << "]" << std::endl;
+              << Argument::Matchings() << "] [" << Argument::PreviousMatchings() << "] ["
+              << Argument::Seed() << "] ["
+              << Argument::MinimumCycleLength() << "] [" << Argument::MaximumCycleLength()
+              << "] [" << Argument::Groups() << "] [" << Argument::Send() << "] ["
+              << Argument::MinimizeDistance() << "] [" << Argument::DistanceRandomness() << "] ["
+              << Argument::PostalCodes() << "] [" << Argument::Gifts() << "] ["
+              << Argument::Tokens() << "] [" << Argument::Watch() << "]" << std::endl;
 
     // Compute the padding length of the argument patterns.
     const std::size_t length = std::max({
       Argument::Help().length(),
       Argument::Configuration().length(),
       Argument::Matchings().length(),
+      Argument::PreviousMatchings().length(),
       Argument::Seed().length(),
+      Argument::MinimumCycleLength().length(),
+      Argument::MaximumCycleLength().length(),
+      Argument::Groups().length(),
+      Argument::Send().length(),
+      Argument::MinimizeDistance().length(),
+      Argument::DistanceRandomness().length(),
+      Argument::PostalCodes().length(),
+      Argument::Gifts().length(),
+      Argument::Tokens().length(),
+      Argument::Watch().length(),
     });
 
     std::cout << "Arguments:" << std::endl;
@@ -114,8 +199,46 @@ private:
     std::cout << indent << PadToLength(Argument::Matchings(), length) << indent
               << "Path to the YAML matchings file to be written. Optional." << std::endl;
 
+    std::cout << indent << PadToLength(Argument::PreviousMatchings(), length) << indent
+              << "Path to a previous YAML matchings file to be updated. Optional." << std::endl;
+
     std::cout << indent << PadToLength(Argument::Seed(), length) << indent
               << "Seed value for pseudo-random number generation. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::MinimumCycleLength(), length) << indent
+              << "Minimum number of participants in each gift exchange cycle. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::MaximumCycleLength(), length) << indent
+              << "Maximum number of participants in each gift exchange cycle. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Groups(), length) << indent
+              << "Aligns the gift exchange cycles to the participants' groups. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Send(), length) << indent
+              << "Sends the email messages to the gifters directly. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::MinimizeDistance(), length) << indent
+              << "Minimizes the total or maximum shipping distance. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::DistanceRandomness(), length) << indent
+              << "Randomness mixed into the shipping distances. Optional; defaults to 0."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::PostalCodes(), length) << indent
+              << "Path to a CSV file of the coordinates of postal codes. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Gifts(), length) << indent
+              << "Number of gifts that each participant gives. Optional; defaults to 1."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Tokens(), length) << indent
+              << "Path to the YAML tokens file to be written or updated. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Watch(), length) << indent
+              << "Revalidates the configuration file whenever it changes. Optional." << std::endl;
   }
 
   // Parses the program's command-line arguments.
@@ -141,9 +264,63 @@ private:
       } else if (argv[index] == Argument::Key::Matchings && AtLeastOneMore(index, argc)) {
         matchings_file_ = argv[index + 1];
         index += 2;
+      } else if (argv[index] == Argument::Key::PreviousMatchings && AtLeastOneMore(index, argc)) {
+        previous_matchings_file_ = argv[index + 1];
+        index += 2;
       } else if (argv[index] == Argument::Key::Seed && AtLeastOneMore(index, argc)) {
         random_seed_ = std::strtoll(argv[index + 1], nullptr, 10);
         index += 2;
+      } else if (argv[index] == Argument::Key::MinimumCycleLength && AtLeastOneMore(index, argc)) {
+        minimum_cycle_length_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::MaximumCycleLength && AtLeastOneMore(index, argc)) {
+        maximum_cycle_length_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::Groups) {
+        align_to_groups_ = true;
+        ++index;
+      } else if (argv[index] == Argument::Key::Send) {
+        send_ = true;
+        ++index;
+      } else if (argv[index] == Argument::Key::MinimizeDistance && AtLeastOneMore(index, argc)) {
+        minimize_distance_ = ParseDistanceObjective(argv[index + 1]);
+        if (!minimize_distance_.has_value()) {
+          PrintHeader();
+          std::cout << "Invalid shipping distance to minimize: " << argv[index + 1]
+                    << "; please specify either total or maximum." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else if (argv[index] == Argument::Key::DistanceRandomness && AtLeastOneMore(index, argc)) {
+        distance_randomness_ = std::strtod(argv[index + 1], nullptr);
+        if (!(distance_randomness_ >= 0.0)) {
+          PrintHeader();
+          std::cout << "Invalid distance randomness: " << argv[index + 1]
+                    << "; please specify a number of at least 0." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else if (argv[index] == Argument::Key::PostalCodes && AtLeastOneMore(index, argc)) {
+        postal_codes_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Tokens && AtLeastOneMore(index, argc)) {
+        tokens_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Watch) {
+        watch_ = true;
+        ++index;
+      } else if (argv[index] == Argument::Key::Gifts && AtLeastOneMore(index, argc)) {
+        gift_count_ = std::strtoull(argv[index + 1], nullptr, 10);
+        if (gift_count_ == 0) {
+          PrintHeader();
+          std::cout << "Invalid number of gifts: " << argv[index + 1]
+                    << "; please specify an integer of at least 1." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
       } else {
         PrintHeader();
         std::cout << "Unrecognized argument: " << argv[index] << std::endl;
@@ -151,6 +328,30 @@ private:
         exit(EXIT_FAILURE);
       }
     }
+
+    if (minimize_distance_.has_value()
+        && (!previous_matchings_file_.empty() || minimum_cycle_length_.has_value()
+            || maximum_cycle_length_.has_value())) {
+      PrintHeader();
+      std::cout << "The shipping distance cannot be minimized when updating previous matchings or "
+                << "bounding the cycle lengths; please specify " << Argument::Key::MinimizeDistance
+                << " without " << Argument::Key::PreviousMatchings << ", "
+                << Argument::Key::MinimumCycleLength << ", or "
+                << Argument::Key::MaximumCycleLength << "." << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+
+    if (gift_count_ > 1 && (!previous_matchings_file_.empty() || minimize_distance_.has_value())) {
+      PrintHeader();
+      std::cout << "The number of gifts cannot be chosen when updating previous matchings, which "
+                << "keep their own number of gifts, or when minimizing the shipping distance; "
+                << "please specify " << Argument::Key::Gifts << " without "
+                << Argument::Key::PreviousMatchings << " or " << Argument::Key::MinimizeDistance
+                << "." << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
   }
 
   // Returns whether there is at least one more element after the given element index.
@@ -166,28 +367,111 @@ private:
         << (!matchings_file_.empty() ?
                 " " + Argument::Key::Matchings + " " + matchings_file_.string() :
                 "")
+        << (!previous_matchings_file_.empty() ? " " + Argument::Key::PreviousMatchings + " "
+                                                    + previous_matchings_file_.string() :
+                                                "")
         << (random_seed_.has_value() ?
                 " " + Argument::Key::Seed + " " + std::to_string(random_seed_.value()) :
                 "")
-        << std::endl;
+        << (minimum_cycle_length_.has_value() ?
+                " " + Argument::Key::MinimumCycleLength + " "
+                    + std::to_string(minimum_cycle_length_.value()) :
+                "")
+        << (maximum_cycle_length_.has_value() ?
+                " " + Argument::Key::MaximumCycleLength + " "
+                    + std::to_string(maximum_cycle_length_.value()) :
+                "")
+        << (align_to_groups_ ? " " + Argument::Key::Groups : "")
+        << (send_ ? " " + Argument::Key::Send : "")
+        << (minimize_distance_.has_value() ?
+                " " + Argument::Key::MinimizeDistance + " "
+                    + std::string{DistanceObjectiveName(minimize_distance_.value())} :
+                "")
+        << (distance_randomness_ > 0.0 ? " " + Argument::Key::DistanceRandomness + " "
+                                             + std::to_string(distance_randomness_) :
+                                         "")
+        << (!postal_codes_file_.empty() ?
+                " " + Argument::Key::PostalCodes + " " + postal_codes_file_.string() :
+                "")
+        << (gift_count_ > 1 ? " " + Argument::Key::Gifts + " " + std::to_string(gift_count_) : "")
+        << (!tokens_file_.empty() ?
+                " " + Argument::Key::Tokens + " " + tokens_file_.string() :
+                "")
+        << (watch_ ? " " + Argument::Key::Watch : "") << std::endl;
   }
 
   // Prints the settings to the console.
   void PrintSettings() const {
     std::cout << "- The configuration will be read from: " << configuration_file_ << std::endl;
 
+    if (watch_) {
+      std::cout << "- The configuration will be watched and revalidated whenever it changes; no "
+                   "matchings will be randomized."
+                << std::endl;
+      return;
+    }
+
     if (matchings_file_.empty()) {
       std::cout << "- The matchings will not be written to a file." << std::endl;
     } else {
       std::cout << "- The matchings will be written to: " << matchings_file_ << std::endl;
     }
 
+    if (!previous_matchings_file_.empty()) {
+      std::cout << "- The previous matchings will be read from and updated: "
+                << previous_matchings_file_ << std::endl;
+    }
+
     if (random_seed_.has_value()) {
       std::cout << "- The seed value for pseudo-random number generation is : "
                 << random_seed_.value() << std::endl;
     } else {
       std::cout << "- The seed value for random number generation will be randomized." << std::endl;
     }
+
+    const std::optional<CycleLengths> cycle_lengths = CycleLengthBounds();
+    if (cycle_lengths.has_value()) {
+      std::cout << "- Each gift exchange cycle will contain at least " << cycle_lengths->Minimum()
+                << " participants";
+      if (maximum_cycle_length_.has_value()) {
+        std::cout << " and at most " << cycle_lengths->Maximum() << " participants";
+      }
+      std::cout << "." << std::endl;
+    }
+
+    if (align_to_groups_) {
+      std::cout << "- The gift exchange cycles will be aligned to the participants' groups."
+                << std::endl;
+    }
+
+    if (gift_count_ > 1) {
+      std::cout << "- Each participant will give " << gift_count_ << " gifts and receive "
+                << gift_count_ << " gifts, each to and from a different participant." << std::endl;
+    }
+
+    if (send_) {
+      std::cout << "- The email messages will be sent to the gifters directly." << std::endl;
+    }
+
+    if (!tokens_file_.empty()) {
+      std::cout << "- The tokens with which participants look up their giftees will be written to: "
+                << tokens_file_ << std::endl;
+    }
+
+    if (minimize_distance_.has_value()) {
+      std::cout << "- The matchings will minimize the "
+                << DistanceObjectiveName(minimize_distance_.value())
+                << " shipping distance between gifters and giftees";
+      if (distance_randomness_ > 0.0) {
+        std::cout << ", with distances randomized by up to " << distance_randomness_ * 100.0
+                  << "%";
+      }
+      std::cout << "." << std::endl;
+      if (!postal_codes_file_.empty()) {
+        std::cout << "- The coordinates of postal codes will be read from: " << postal_codes_file_
+                  << std::endl;
+      }
+    }
   }
 
   // Name of the Secret Santa Randomizer executable.
@@ -199,9 +483,43 @@ private:
   // Path to the YAML matchings file to be written. If empty, no matchings file is written.
   std::filesystem::path matchings_file_;
 
+  // Path to a previous YAML matchings file to be updated to the current participants rather than
+  // randomized anew. If empty, the matchings are randomized anew.
+  std::filesystem::path previous_matchings_file_;
+
   // Optional seed value for pseudo-random number generation. If no value is specified, the seed
   // value is randomized.
   std::optional<int64_t> random_seed_;
+
+  // Optional minimum number of participants in each gift exchange cycle.
+  std::optional<std::size_t> minimum_cycle_length_;
+
+  // Optional maximum number of participants in each gift exchange cycle.
+  std::optional<std::size_t> maximum_cycle_length_;
+
+  // Whether the gift exchange cycles are aligned to the participants' groups.
+  bool align_to_groups_{false};
+
+  // Whether to send the email messages to the gifters directly from the randomized matchings.
+  bool send_{false};
+
+  // Optional shipping distance between gifters and giftees to minimize.
+  std::optional<DistanceObjective> minimize_distance_;
+
+  // Amount of randomness mixed into the shipping distances when minimizing them.
+  double distance_randomness_{0.0};
+
+  // Path to a CSV file of the coordinates of postal codes. If empty, no postal codes are known.
+  std::filesystem::path postal_codes_file_;
+
+  // Number of gifts that each participant gives and receives.
+  std::size_t gift_count_{1};
+
+  // Path to the YAML tokens file to be written or updated. If empty, no tokens file is written.
+  std::filesystem::path tokens_file_;
+
+  // Whether to watch the configuration file and revalidate it whenever it changes.
+  bool watch_{false};
 };
 
 }  // namespace SecretSanta::Randomizer
@@ -0,0 +1,288 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_RETRYING_TRANSPORT_HPP
+#define SECRET_SANTA_RETRYING_TRANSPORT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DeadLetters.hpp"
+#include "DeliveryOutcomes.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// How often and how soon a transient failure is retried. The delay before each retry doubles from
+// the initial delay up to the maximum delay, and the actual delay is drawn uniformly between zero
+// and that bound, so that email messages that failed together do not all retry at the same time.
+struct RetryPolicy {
+  // Maximum number of attempts to deliver each email message, including the first one.
+  std::size_t maximum_attempts{4};
+
+  // Upper bound of the delay before the first retry.
+  std::chrono::milliseconds initial_delay{1000};
+
+  // Upper bound of the delay before any retry.
+  std::chrono::milliseconds maximum_delay{60000};
+};
+
+// Transport that forwards email messages to another transport and retries those whose delivery
+// fails transiently, with exponential backoff and jitter. Retries wait in a timer heap ordered by
+// their due time, and a dedicated thread hands each one back to the other transport once it is due,
+// so that waiting retries never hold up fresh email messages. Email messages that fail permanently,
+// such as those rejected with a reply in the 500s, are not retried. Email messages that fail
+// permanently or still fail after the maximum number of attempts are collected as dead letters,
+// and the final outcome of every email message is recorded.
+// Each completion function is invoked once, with the outcome of the last attempt.
+class RetryingTransport : public Transport {
+public:
+  // Constructor. Constructs a transport that forwards email messages to a given transport, which
+  // must outlive this one, and retries them according to a given policy. The given random seed
+  // makes the jitter reproducible.
+  explicit RetryingTransport(
+      Transport& transport, const RetryPolicy& policy = {},
+      const uint64_t random_seed = std::random_device{}())
+    : transport_(transport), policy_(policy), random_generator_(random_seed),
+      scheduler_([this]() { Schedule(); }) {}
+
+  // Destructor. Waits for all email messages, including those waiting to be retried, and stops the
+  // thread that hands retries back to the other transport.
+  ~RetryingTransport() noexcept override {
+    Flush();
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      stopping_ = true;
+    }
+    condition_.notify_all();
+    scheduler_.join();
+  }
+
+  // Deleted copy constructor.
+  RetryingTransport(const RetryingTransport& other) = delete;
+
+  // Deleted move constructor.
+  RetryingTransport(RetryingTransport&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  RetryingTransport& operator=(const RetryingTransport& other) = delete;
+
+  // Deleted move assignment operator.
+  RetryingTransport& operator=(RetryingTransport&& other) noexcept = delete;
+
+  [[nodiscard]] std::string Name() const override {
+    return transport_.Name() + " with up to " + std::to_string(policy_.maximum_attempts)
+           + " attempts";
+  }
+
+  void Send(EmailMessage message, Completion completion) override {
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      ++pending_count_;
+    }
+    Attempt(Job{std::chrono::steady_clock::time_point{}, 0, std::move(message),
+                std::move(completion), 1});
+  }
+
+  void Flush() override {
+    std::unique_lock<std::mutex> lock{mutex_};
+    pending_condition_.wait(lock, [this]() { return pending_count_ == 0; });
+  }
+
+  // Number of retries made so far.
+  [[nodiscard]] std::size_t RetryCount() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return retry_count_;
+  }
+
+  // Email messages that failed permanently or still failed after the maximum number of attempts.
+  [[nodiscard]] DeadLetters Undelivered() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return dead_letters_;
+  }
+
+  // Final outcomes of the email messages whose delivery has completed for good, in the order in
+  // which they completed.
+  [[nodiscard]] DeliveryOutcomes Outcomes() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return outcomes_;
+  }
+
+  // Delay before the retry that follows a given number of failed attempts, drawn uniformly between
+  // zero and the exponentially growing bound of the given policy.
+  [[nodiscard]] static std::chrono::milliseconds Backoff(
+      const RetryPolicy& policy, const std::size_t failed_attempts,
+      std::mt19937_64& random_generator) {
+    int64_t bound = std::max<int64_t>(policy.initial_delay.count(), 0);
+    for (std::size_t attempt = 1; attempt < failed_attempts && bound < policy.maximum_delay.count();
+         ++attempt) {
+      bound *= 2;
+    }
+    bound = std::min<int64_t>(bound, policy.maximum_delay.count());
+    std::uniform_int_distribution<int64_t> distribution{0, std::max<int64_t>(bound, 0)};
+    return std::chrono::milliseconds{distribution(random_generator)};
+  }
+
+private:
+  // Email message waiting to be attempted, along with its completion function.
+  struct Job {
+    // Time at which the email message is due to be attempted.
+    std::chrono::steady_clock::time_point due;
+
+    // Order in which the job was scheduled, which breaks ties between jobs due at the same time.
+    uint64_t sequence{0};
+
+    // Email message to be delivered.
+    EmailMessage message;
+
+    // Function invoked once the delivery of the email message completes for good.
+    Completion completion;
+
+    // Number of the attempt, starting from 1.
+    std::size_t attempt{1};
+  };
+
+  // Orders jobs in the timer heap such that the job due first is at the top.
+  [[nodiscard]] static bool IsDueLater(const Job& first, const Job& second) noexcept {
+    return first.due != second.due ? first.due > second.due : first.sequence > second.sequence;
+  }
+
+  // Hands a job to the other transport, and then either completes it or schedules its retry once
+  // the attempt completes.
+  void Attempt(Job job) {
+    const std::size_t attempt = job.attempt;
+    Completion completion{std::move(job.completion)};
+    transport_.Send(
+        std::move(job.message),
+        [this, attempt, completion = std::move(completion)](
+            const EmailMessage& message, const Delivery& delivery) mutable {
+          if (delivery.Status() == DeliveryStatus::TransientFailure
+              && attempt < policy_.maximum_attempts) {
+            {
+              const std::lock_guard<std::mutex> lock{mutex_};
+              ++retry_count_;
+              timers_.push_back(
+                  Job{std::chrono::steady_clock::now()
+                          + Backoff(policy_, attempt, random_generator_),
+                      next_sequence_++, message, std::move(completion), attempt + 1});
+              std::push_heap(timers_.begin(), timers_.end(), &RetryingTransport::IsDueLater);
+            }
+            condition_.notify_all();
+            return;
+          }
+
+          {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            outcomes_.Add(DeliveryOutcome{message.GifterName(), message.Recipient(),
+                                          delivery.Status(), attempt, delivery.Details()});
+            if (!delivery.Succeeded()) {
+              dead_letters_.Add(DeadLetter{message, attempt, delivery.Details()});
+            }
+          }
+          completion(message, delivery);
+
+          const std::lock_guard<std::mutex> lock{mutex_};
+          if (--pending_count_ == 0) {
+            pending_condition_.notify_all();
+          }
+        });
+  }
+
+  // Waits for each retry to fall due and hands it back to the other transport, until stopped.
+  void Schedule() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (true) {
+      if (stopping_) {
+        return;
+      }
+      if (timers_.empty()) {
+        condition_.wait(lock);
+        continue;
+      }
+      if (std::chrono::steady_clock::now() < timers_.front().due) {
+        condition_.wait_until(lock, timers_.front().due);
+        continue;
+      }
+      std::pop_heap(timers_.begin(), timers_.end(), &RetryingTransport::IsDueLater);
+      Job job{std::move(timers_.back())};
+      timers_.pop_back();
+
+      // The other transport may block or complete the attempt right away, so it must not be called
+      // while holding the lock.
+      lock.unlock();
+      Attempt(std::move(job));
+      lock.lock();
+    }
+  }
+
+  // Transport to which the email messages are forwarded.
+  Transport& transport_;
+
+  // How often and how soon a transient failure is retried.
+  RetryPolicy policy_;
+
+  // Protects the timer heap, the random generator, the dead letters, the outcomes, and the counts.
+  mutable std::mutex mutex_;
+
+  // Notified when a retry is scheduled or this transport is stopping.
+  std::condition_variable condition_;
+
+  // Notified when all deliveries have completed.
+  std::condition_variable pending_condition_;
+
+  // Retries waiting to fall due, as a binary heap whose top is the retry due first.
+  std::vector<Job> timers_;
+
+  // Order of the next scheduled retry.
+  uint64_t next_sequence_{0};
+
+  // Random generator of the jitter of the delays before retries.
+  std::mt19937_64 random_generator_;
+
+  // Email messages that failed permanently or still failed after the maximum number of attempts.
+  DeadLetters dead_letters_;
+
+  // Final outcomes of the email messages whose delivery has completed for good.
+  DeliveryOutcomes outcomes_;
+
+  // Number of email messages whose delivery has not yet completed for good.
+  std::size_t pending_count_{0};
+
+  // Number of retries made so far.
+  std::size_t retry_count_{0};
+
+  // Whether this transport is stopping.
+  bool stopping_{false};
+
+  // Thread that hands retries back to the other transport once they are due.
+  std::thread scheduler_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_RETRYING_TRANSPORT_HPP
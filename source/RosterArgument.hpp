@@ -0,0 +1,112 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_ROSTER_ARGUMENT_HPP
+#define SECRET_SANTA_ROSTER_ARGUMENT_HPP
+
+#include <string>
+#include <string_view>
+
+namespace SecretSanta::Roster::Argument {
+
+namespace Key {
+
+// Prints usage instructions and exits. Optional.
+static const std::string Help{"--help"};
+
+// Number of participants of the roster to be generated. Required.
+static const std::string Participants{"--participants"};
+
+// Path to the roster file to be written. Optional.
+static const std::string Output{"--output"};
+
+// Format of the roster file to be written, either YAML or CSV. Optional.
+static const std::string Format{"--format"};
+
+// Seed value from which the roster is derived. Optional.
+static const std::string Seed{"--seed"};
+
+// Number of participants of each household. Optional.
+static const std::string HouseholdSize{"--household-size"};
+
+// Number of past years whose matchings are written alongside the roster. Optional.
+static const std::string History{"--history"};
+
+// Number of threads that generate the roster. Optional.
+static const std::string Threads{"--threads"};
+
+}  // namespace Key
+
+namespace Value {
+
+// Filesystem path.
+static const std::string Path{"<path>"};
+
+// Integer number.
+static const std::string Integer{"<integer>"};
+
+// Format of a roster file.
+static const std::string Format{"<yaml|csv>"};
+
+}  // namespace Value
+
+// Prints usage instructions and exits. Optional.
+[[nodiscard]] std::string_view Help() {
+  return Key::Help;
+}
+
+// Number of participants of the roster to be generated. Required.
+[[nodiscard]] std::string Participants() {
+  return Key::Participants + " " + Value::Integer;
+}
+
+// Path to the roster file to be written. Optional.
+[[nodiscard]] std::string Output() {
+  return Key::Output + " " + Value::Path;
+}
+
+// Format of the roster file to be written, either YAML or CSV. Optional.
+[[nodiscard]] std::string Format() {
+  return Key::Format + " " + Value::Format;
+}
+
+// Seed value from which the roster is derived. Optional.
+[[nodiscard]] std::string Seed() {
+  return Key::Seed + " " + Value::Integer;
+}
+
+// Number of participants of each household. Optional.
+[[nodiscard]] std::string HouseholdSize() {
+  return Key::HouseholdSize + " " + Value::Integer;
+}
+
+// Number of past years whose matchings are written alongside the roster. Optional.
+[[nodiscard]] std::string History() {
+  return Key::History + " " + Value::Integer;
+}
+
+// Number of threads that generate the roster. Optional.
+[[nodiscard]] std::string Threads() {
+  return Key::Threads + " " + Value::Integer;
+}
+
+}  // namespace SecretSanta::Roster::Argument
+
+#endif  // SECRET_SANTA_ROSTER_ARGUMENT_HPP
@@ -0,0 +1,778 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_ROSTER_GENERATOR_HPP
+#define SECRET_SANTA_ROSTER_GENERATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Participant.hpp"
+
+namespace SecretSanta {
+
+// Format of a synthetic roster file.
+enum class RosterFormat : int8_t {
+  // YAML configuration file, in the format read by the Secret Santa programs.
+  Yaml,
+
+  // CSV file with a header line followed by one line per participant.
+  Csv,
+};
+
+// Prints a roster format as a word, such as "yaml".
+[[nodiscard]] std::string PrintRosterFormat(const RosterFormat format) {
+  switch (format) {
+    case RosterFormat::Yaml:
+      return "yaml";
+    case RosterFormat::Csv:
+      return "csv";
+  }
+  return "unknown";
+}
+
+// Parses a roster format printed by PrintRosterFormat. Returns no value if the text is not a roster
+// format.
+[[nodiscard]] std::optional<RosterFormat> ParseRosterFormat(const std::string_view text) {
+  for (const RosterFormat format : {RosterFormat::Yaml, RosterFormat::Csv}) {
+    if (PrintRosterFormat(format) == text) {
+      return format;
+    }
+  }
+  return std::nullopt;
+}
+
+// Name of a synthetic participant's table of first or last names.
+struct RosterName {
+  // Name as written, in UTF-8, such as "Chloé".
+  std::string_view text;
+
+  // Name in lowercase ASCII letters, used in email addresses, such as "chloe".
+  std::string_view ascii;
+};
+
+// City of a synthetic participant's table of cities.
+struct RosterCity {
+  // Name of the city as written in addresses, in UTF-8, along with its region where addresses
+  // include one, such as "San Francisco, CA".
+  std::string_view name;
+
+  // Country as written in addresses, in UTF-8.
+  std::string_view country;
+
+  // Time zone of the city, as a name of the time zone database.
+  std::string_view time_zone;
+
+  // Latitude of the city center in degrees.
+  double latitude{0.0};
+
+  // Longitude of the city center in degrees.
+  double longitude{0.0};
+
+  // Leading characters of the postal codes of the city.
+  std::string_view postal_code_prefix;
+
+  // Number of digits that follow the leading characters of a postal code.
+  std::size_t postal_code_digits{0};
+
+  // Whether the postal code precedes the city in addresses, as in "75004 Paris", rather than
+  // following it, as in "San Francisco, CA 94103".
+  bool postal_code_first{false};
+
+  // Whether the house number precedes the street in addresses, as in "742 Market Street", rather
+  // than following it, as in "Königstraße 8".
+  bool number_first{false};
+
+  // Streets of the city, in UTF-8.
+  std::array<std::string_view, 4> streets;
+};
+
+// First names of synthetic participants. The ASCII forms are unique.
+constexpr std::array RosterFirstNames{
+    RosterName{"Alice", "alice"},       RosterName{"Amélie", "amelie"},
+    RosterName{"Ana", "ana"},           RosterName{"Bartosz", "bartosz"},
+    RosterName{"Björn", "bjorn"},       RosterName{"Bob", "bob"},
+    RosterName{"Cécile", "cecile"},     RosterName{"Chen", "chen"},
+    RosterName{"Chloé", "chloe"},       RosterName{"David", "david"},
+    RosterName{"Dmitri", "dmitri"},     RosterName{"Émilie", "emilie"},
+    RosterName{"Farah", "farah"},       RosterName{"François", "francois"},
+    RosterName{"Gabriel", "gabriel"},   RosterName{"Giulia", "giulia"},
+    RosterName{"Hélène", "helene"},     RosterName{"Hiroshi", "hiroshi"},
+    RosterName{"Inès", "ines"},         RosterName{"Ingrid", "ingrid"},
+    RosterName{"José", "jose"},         RosterName{"Jürgen", "jurgen"},
+    RosterName{"Katarzyna", "katarzyna"}, RosterName{"Kwame", "kwame"},
+    RosterName{"Leila", "leila"},       RosterName{"Łukasz", "lukasz"},
+    RosterName{"María", "maria"},       RosterName{"Mateo", "mateo"},
+    RosterName{"Noémie", "noemie"},     RosterName{"Núria", "nuria"},
+    RosterName{"Oğuz", "oguz"},         RosterName{"Olivia", "olivia"},
+    RosterName{"Pedro", "pedro"},       RosterName{"Priya", "priya"},
+    RosterName{"Quentin", "quentin"},   RosterName{"Rafael", "rafael"},
+    RosterName{"Renée", "renee"},       RosterName{"Sakura", "sakura"},
+    RosterName{"Søren", "soren"},       RosterName{"Thérèse", "therese"},
+    RosterName{"Tomás", "tomas"},       RosterName{"Umar", "umar"},
+    RosterName{"Valentina", "valentina"}, RosterName{"Wei", "wei"},
+    RosterName{"Ximena", "ximena"},     RosterName{"Yusuf", "yusuf"},
+    RosterName{"Zainab", "zainab"},     RosterName{"Zoë", "zoe"},
+};
+
+// Last names of synthetic participants. The ASCII forms are unique.
+constexpr std::array RosterLastNames{
+    RosterName{"Åberg", "aberg"},         RosterName{"Andersson", "andersson"},
+    RosterName{"Brown", "brown"},         RosterName{"Castillo", "castillo"},
+    RosterName{"Côté", "cote"},           RosterName{"Dąbrowski", "dabrowski"},
+    RosterName{"Dubois", "dubois"},       RosterName{"Eriksson", "eriksson"},
+    RosterName{"Fernández", "fernandez"}, RosterName{"Fischer", "fischer"},
+    RosterName{"Gagnon", "gagnon"},       RosterName{"García", "garcia"},
+    RosterName{"González", "gonzalez"},   RosterName{"Hernández", "hernandez"},
+    RosterName{"Horváth", "horvath"},     RosterName{"Ivanova", "ivanova"},
+    RosterName{"Jensen", "jensen"},       RosterName{"Johnson", "johnson"},
+    RosterName{"Jović", "jovic"},         RosterName{"Kim", "kim"},
+    RosterName{"Kovačević", "kovacevic"}, RosterName{"Kowalski", "kowalski"},
+    RosterName{"Larsen", "larsen"},       RosterName{"Lefèvre", "lefevre"},
+    RosterName{"Moreau", "moreau"},       RosterName{"Müller", "muller"},
+    RosterName{"Nguyen", "nguyen"},       RosterName{"Novák", "novak"},
+    RosterName{"Nowak", "nowak"},         RosterName{"O'Brien", "obrien"},
+    RosterName{"Patel", "patel"},         RosterName{"Popescu", "popescu"},
+    RosterName{"Quispe", "quispe"},       RosterName{"Ramírez", "ramirez"},
+    RosterName{"Rossi", "rossi"},         RosterName{"Sánchez", "sanchez"},
+    RosterName{"Schröder", "schroder"},   RosterName{"Silva", "silva"},
+    RosterName{"Smith", "smith"},         RosterName{"Tanaka", "tanaka"},
+    RosterName{"Thompson", "thompson"},   RosterName{"Ulrich", "ulrich"},
+    RosterName{"Vargas", "vargas"},       RosterName{"Wójcik", "wojcik"},
+    RosterName{"Xu", "xu"},               RosterName{"Yılmaz", "yilmaz"},
+    RosterName{"Young", "young"},         RosterName{"Zimmermann", "zimmermann"},
+};
+
+// Cities of synthetic participants.
+constexpr std::array RosterCities{
+    RosterCity{"San Francisco, CA", "USA", "America/Los_Angeles", 37.7749, -122.4194, "941", 2,
+               false, true,
+               {"Market Street", "Valencia Street", "Mission Street", "Castro Street"}},
+    RosterCity{"New York, NY", "USA", "America/New_York", 40.7128, -74.0060, "100", 2, false, true,
+               {"Broadway", "Bleecker Street", "Lexington Avenue", "Amsterdam Avenue"}},
+    RosterCity{"Montréal, QC", "Canada", "America/Toronto", 45.5019, -73.5674, "H2X 1Y", 1, false,
+               true,
+               {"rue Saint-Denis", "boulevard Saint-Laurent", "avenue du Mont-Royal",
+                "rue Sainte-Catherine"}},
+    RosterCity{"São Paulo", "Brasil", "America/Sao_Paulo", -23.5505, -46.6333, "01310-", 3, true,
+               false,
+               {"Avenida Paulista", "Rua Augusta", "Rua Oscar Freire", "Avenida São João"}},
+    RosterCity{"Paris", "France", "Europe/Paris", 48.8566, 2.3522, "750", 2, true, true,
+               {"rue de l'Église", "avenue des Champs-Élysées", "boulevard Saint-Germain",
+                "rue de Rivoli"}},
+    RosterCity{"Stuttgart", "Deutschland", "Europe/Berlin", 48.7758, 9.1829, "701", 2, true, false,
+               {"Königstraße", "Schloßstraße", "Rotebühlstraße", "Marienstraße"}},
+    RosterCity{"Madrid", "España", "Europe/Madrid", 40.4168, -3.7038, "280", 2, true, false,
+               {"Calle de Alcalá", "Gran Vía", "Calle de Atocha", "Paseo de la Castellana"}},
+    RosterCity{"Kraków", "Polska", "Europe/Warsaw", 50.0647, 19.9450, "31-0", 2, true, false,
+               {"ulica Floriańska", "ulica Grodzka", "ulica Długa", "ulica Świętego Jana"}},
+    RosterCity{"København", "Danmark", "Europe/Copenhagen", 55.6761, 12.5683, "2", 3, true, false,
+               {"Nørrebrogade", "Østerbrogade", "Vesterbrogade", "Åboulevard"}},
+    RosterCity{"Reykjavík", "Ísland", "Atlantic/Reykjavik", 64.1466, -21.9426, "10", 1, true,
+               false, {"Laugavegur", "Skólavörðustígur", "Hverfisgata", "Bankastræti"}},
+    RosterCity{"İstanbul", "Türkiye", "Europe/Istanbul", 41.0082, 28.9784, "344", 2, true, false,
+               {"İstiklal Caddesi", "Bağdat Caddesi", "Şişli Sokak", "Çırağan Caddesi"}},
+    RosterCity{"Tōkyō", "日本", "Asia/Tokyo", 35.6762, 139.6503, "100-00", 2, true, false,
+               {"Chūō-dōri", "Omotesandō", "Meiji-dōri", "Yasukuni-dōri"}},
+};
+
+// Instructions for mailing packages of synthetic participants, in UTF-8.
+constexpr std::array<std::string_view, 8> RosterInstructions{
+    "Leave the package with the doorman in the lobby.",
+    "Hide the package behind the bushes.",
+    "Ring the bell twice; the buzzer is broken.",
+    "Leave it at the side door, not the garage.",
+    "Laissez le colis à la réception, s'il vous plaît.",
+    "Bitte beim Nachbarn im Erdgeschoss abgeben.",
+    "Deje el paquete en la portería.",
+    "荷物は宅配ボックスに入れてください。",
+};
+
+// Domains of the email addresses of synthetic participants.
+constexpr std::array<std::string_view, 8> RosterEmailDomains{
+    "gmail.com", "outlook.com", "yahoo.com", "proton.me",
+    "gmx.de",    "orange.fr",   "icloud.com", "example.org",
+};
+
+// Deterministic generator of synthetic rosters of participants of any size, for benchmarking the
+// Secret Santa programs at scale. Each participant is derived only from the seed and its own index,
+// so that any range of participants can be generated independently of the others, and the same
+// seed always yields the same roster. The names are unique, and the street addresses, instructions,
+// and locations are drawn from tables of cities around the world with UTF-8 names.
+class RosterGenerator {
+public:
+  // Default constructor. Constructs a generator of an empty roster.
+  RosterGenerator() = default;
+
+  // Constructor. Constructs a generator of a roster of a given number of participants from a given
+  // seed. If the household size is nonzero, each run of that many consecutive participants forms
+  // one household: they share a group, a street address, a time zone, and a location.
+  RosterGenerator(const std::size_t participant_count, const uint64_t seed = 0,
+                  const std::size_t household_size = 0)
+    : participant_count_(participant_count), seed_(seed), household_size_(household_size) {}
+
+  // Destructor. Destroys this generator.
+  ~RosterGenerator() noexcept = default;
+
+  // Copy constructor. Constructs a generator by copying another one.
+  RosterGenerator(const RosterGenerator& other) = default;
+
+  // Move constructor. Constructs a generator by moving another one.
+  RosterGenerator(RosterGenerator&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this generator by copying another one.
+  RosterGenerator& operator=(const RosterGenerator& other) = default;
+
+  // Move assignment operator. Assigns this generator by moving another one.
+  RosterGenerator& operator=(RosterGenerator&& other) noexcept = default;
+
+  // Number of participants of the roster.
+  [[nodiscard]] std::size_t ParticipantCount() const noexcept {
+    return participant_count_;
+  }
+
+  // Seed from which the roster is derived.
+  [[nodiscard]] uint64_t Seed() const noexcept {
+    return seed_;
+  }
+
+  // Number of participants of each household. Zero if the participants do not form households.
+  [[nodiscard]] std::size_t HouseholdSize() const noexcept {
+    return household_size_;
+  }
+
+  // Name of the participant at a given index. The names are unique: the first names, middle
+  // initials, and last names of the tables are combined in an order scrambled by the seed, and once
+  // every combination is used, a number is appended to tell the participants apart.
+  [[nodiscard]] std::string Name(const std::size_t index) const {
+    std::string name;
+    AppendName(Parts(index), name);
+    return name;
+  }
+
+  // Participant at a given index.
+  [[nodiscard]] Participant Generate(const std::size_t index) const {
+    const Fields fields{DrawFields(index)};
+    std::string name;
+    AppendName(fields.name, name);
+    std::string email;
+    AppendEmail(fields, email);
+    std::string address;
+    AppendAddress(fields, address);
+    std::string group;
+    AppendGroup(fields, group);
+    std::string location;
+    AppendLocation(fields, location);
+    return {name, email, address, std::string{fields.instructions}, group,
+            std::string{fields.city->time_zone}, location};
+  }
+
+  // Header of a roster file of a given format, which precedes the participants.
+  [[nodiscard]] std::string Header(const RosterFormat format) const {
+    if (format == RosterFormat::Csv) {
+      return "name,email,address,instructions,group,timezone,location\n";
+    }
+    return "---\nmessage:\n  subject: Secret Santa Gift Exchange\n  body: |\n"
+           "    This is a synthetic roster of "
+           + std::to_string(participant_count_) + " participants generated from the seed "
+           + std::to_string(seed_) + ".\nparticipants:\n";
+  }
+
+  // Appends the participants of a given range of indices to a given text in a given format. Each
+  // field is rendered into one reused buffer before being quoted, so that this allocates nothing
+  // once the buffers have grown.
+  void Append(const RosterFormat format, const std::size_t begin, const std::size_t end,
+              std::string& text) const {
+    std::string field;
+    for (std::size_t index = begin; index < end; ++index) {
+      const Fields fields{DrawFields(index)};
+
+      field.clear();
+      AppendName(fields.name, field);
+      text.append(format == RosterFormat::Csv ? "" : "  - ");
+      AppendValue(format, field, text);
+
+      field.clear();
+      AppendEmail(fields, field);
+      text.append(format == RosterFormat::Csv ? "," : ":\n      email: ");
+      AppendValue(format, field, text);
+
+      field.clear();
+      AppendAddress(fields, field);
+      text.append(format == RosterFormat::Csv ? "," : "\n      address: ");
+      AppendValue(format, field, text);
+
+      if (format == RosterFormat::Csv || !fields.instructions.empty()) {
+        text.append(format == RosterFormat::Csv ? "," : "\n      instructions: ");
+        AppendValue(format, fields.instructions, text);
+      }
+
+      if (format == RosterFormat::Csv || household_size_ > 0) {
+        field.clear();
+        AppendGroup(fields, field);
+        text.append(format == RosterFormat::Csv ? "," : "\n      group: ");
+        AppendValue(format, field, text);
+      }
+
+      text.append(format == RosterFormat::Csv ? "," : "\n      timezone: ");
+      AppendValue(format, fields.city->time_zone, text);
+
+      field.clear();
+      AppendLocation(fields, field);
+      text.append(format == RosterFormat::Csv ? "," : "\n      location: ");
+      AppendValue(format, field, text);
+
+      text.push_back('\n');
+    }
+  }
+
+  // Writes the whole roster in a given format to a given stream. The participants are generated in
+  // chunks by a given number of threads, each chunk into its own buffer, while the calling thread
+  // writes the finished chunks to the stream in order. Returns the number of bytes written.
+  std::size_t Write(std::ostream& stream, const RosterFormat format,
+                    const std::size_t threads = 1) const {
+    return WriteChunks(
+        stream, Header(format), threads,
+        [this, format](const std::size_t begin, const std::size_t end, std::string& text) {
+          Append(format, begin, end, text);
+        });
+  }
+
+  // Strides of the matchings of a given number of past years, the first one being last year's. In
+  // the matchings of a past year, the participant at each index gifts to the participant a stride
+  // further, wrapping around; since each stride is coprime with the number of participants, this
+  // forms one cycle through every participant. The strides differ between years, so that no gifter
+  // gifts to the same giftee twice. Returns fewer strides if the roster is too small for that many
+  // years.
+  [[nodiscard]] std::vector<std::size_t> HistoryStrides(const std::size_t years) const {
+    std::vector<std::size_t> strides;
+    if (participant_count_ < 2) {
+      return strides;
+    }
+    for (std::size_t year = 1; year <= years; ++year) {
+      // Start from a random stride and take the next one that is usable.
+      const std::size_t start{
+          static_cast<std::size_t>(Draw(year, HistoryStream) % (participant_count_ - 1))};
+      std::optional<std::size_t> stride;
+      for (std::size_t offset = 0; offset < participant_count_ - 1 && !stride.has_value();
+           ++offset) {
+        const std::size_t candidate{1 + (start + offset) % (participant_count_ - 1)};
+        if (std::gcd(candidate, participant_count_) == 1
+            && std::find(strides.cbegin(), strides.cend(), candidate) == strides.cend()) {
+          stride = candidate;
+        }
+      }
+      if (!stride.has_value()) {
+        break;
+      }
+      strides.push_back(stride.value());
+    }
+    return strides;
+  }
+
+  // Writes the matchings of a past year of a given stride to a given stream in the format of a YAML
+  // matchings file, generated in chunks by a given number of threads as in Write. Returns the
+  // number of bytes written.
+  std::size_t WriteHistory(
+      std::ostream& stream, const std::size_t stride, const std::size_t threads = 1) const {
+    return WriteChunks(
+        stream, "gifters_to_giftees:\n", threads,
+        [this, stride](const std::size_t begin, const std::size_t end, std::string& text) {
+          std::string name;
+          for (std::size_t index = begin; index < end; ++index) {
+            name.clear();
+            AppendName(Parts(index), name);
+            text.append("  - ");
+            AppendYamlScalar(name, text);
+            name.clear();
+            AppendName(Parts((index + stride) % participant_count_), name);
+            text.append(": ");
+            AppendYamlScalar(name, text);
+            text.push_back('\n');
+          }
+        });
+  }
+
+private:
+  // Indices of the parts of the name of a participant in the tables of names.
+  struct NameParts {
+    // Index of the first name in the table of first names.
+    std::size_t first{0};
+
+    // Index of the middle initial in the alphabet.
+    std::size_t initial{0};
+
+    // Index of the last name in the table of last names.
+    std::size_t last{0};
+
+    // Number of times that every combination of names was used before this participant's.
+    std::size_t generation{0};
+  };
+
+  // Fields of a participant as drawn from the tables, from which the text of each field is
+  // rendered.
+  struct Fields {
+    // Parts of the name.
+    NameParts name;
+
+    // Domain of the email address.
+    std::string_view domain;
+
+    // Instructions. Empty if the participant has none.
+    std::string_view instructions;
+
+    // Number of the household, counting from one. Zero if the participants do not form
+    // households.
+    std::size_t household{0};
+
+    // City of the street address, which also gives the time zone.
+    const RosterCity* city{nullptr};
+
+    // Street of the street address.
+    std::string_view street;
+
+    // House number of the street address.
+    std::size_t number{0};
+
+    // Pseudo-random value from which the digits of the postal code are taken.
+    uint64_t postal_code{0};
+
+    // Latitude of the location in degrees.
+    double latitude{0.0};
+
+    // Longitude of the location in degrees.
+    double longitude{0.0};
+  };
+
+  // Number of participants of each chunk generated by one thread at a time.
+  static constexpr std::size_t ChunkSize{16384};
+
+  // Number of distinct combinations of a first name, a middle initial, and a last name.
+  static constexpr std::size_t NameCombinationCount{
+      RosterFirstNames.size() * 26 * RosterLastNames.size()};
+
+  // Multiplier that scrambles the order of the combinations of names. Being coprime with the
+  // number of combinations, it maps each index to a distinct combination.
+  static constexpr std::size_t NameScrambler{7919};
+
+  static_assert(std::gcd(NameScrambler, NameCombinationCount) == 1);
+
+  // Stream of pseudo-random values of the domains of email addresses. Each field draws from its
+  // own stream, so that the fields are independent of each other.
+  static constexpr uint64_t DomainStream{1};
+
+  // Stream of pseudo-random values of the instructions.
+  static constexpr uint64_t InstructionsStream{2};
+
+  // Stream of pseudo-random values of the cities.
+  static constexpr uint64_t CityStream{3};
+
+  // Stream of pseudo-random values of the streets, house numbers, and postal codes.
+  static constexpr uint64_t AddressStream{4};
+
+  // Stream of pseudo-random values of the locations around the city centers.
+  static constexpr uint64_t LocationStream{5};
+
+  // Stream of pseudo-random values of the strides of the matchings of past years.
+  static constexpr uint64_t HistoryStream{6};
+
+  // Mixes the bits of a value, as in the finalizer of the SplitMix64 generator.
+  [[nodiscard]] static constexpr uint64_t Mix(uint64_t value) noexcept {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+  }
+
+  // Pseudo-random value of a given stream for a given key, such as the index of a participant.
+  [[nodiscard]] uint64_t Draw(const uint64_t key, const uint64_t stream) const noexcept {
+    return Mix(Mix(seed_ + 0x9E3779B97F4A7C15ULL * (stream + 1)) ^ key);
+  }
+
+  // Indices of the parts of the name of the participant at a given index.
+  [[nodiscard]] NameParts Parts(const std::size_t index) const noexcept {
+    const std::size_t combination{
+        ((index % NameCombinationCount) * NameScrambler + seed_ % NameCombinationCount)
+        % NameCombinationCount};
+    return {combination % RosterFirstNames.size(), (combination / RosterFirstNames.size()) % 26,
+            combination / (RosterFirstNames.size() * 26), index / NameCombinationCount};
+  }
+
+  // Fields of the participant at a given index.
+  [[nodiscard]] Fields DrawFields(const std::size_t index) const noexcept {
+    Fields fields;
+    fields.name = Parts(index);
+    fields.domain = RosterEmailDomains[Draw(index, DomainStream) % RosterEmailDomains.size()];
+
+    const uint64_t instructions_draw{Draw(index, InstructionsStream)};
+    if (instructions_draw % 4 == 0) {
+      fields.instructions =
+          RosterInstructions[(instructions_draw / 4) % RosterInstructions.size()];
+    }
+
+    // The members of a household share everything that depends on where they live.
+    const std::size_t household{household_size_ > 0 ? index / household_size_ : index};
+    fields.household = household_size_ > 0 ? household + 1 : 0;
+    fields.city = &RosterCities[Draw(household, CityStream) % RosterCities.size()];
+
+    const uint64_t address_draw{Draw(household, AddressStream)};
+    fields.street = fields.city->streets[address_draw % fields.city->streets.size()];
+    fields.number = 1 + (address_draw / fields.city->streets.size()) % 999;
+    fields.postal_code = address_draw / (fields.city->streets.size() * 999);
+
+    // Scatter the locations over about ten kilometers around the city center.
+    const uint64_t location_draw{Draw(household, LocationStream)};
+    fields.latitude =
+        fields.city->latitude + static_cast<double>(location_draw % 1001) / 10000.0 - 0.05;
+    fields.longitude = fields.city->longitude
+                       + static_cast<double>((location_draw / 1001) % 1001) / 10000.0 - 0.05;
+
+    return fields;
+  }
+
+  // Appends a name given by its parts to a given text.
+  static void AppendName(const NameParts& parts, std::string& text) {
+    text.append(RosterFirstNames[parts.first].text);
+    text.push_back(' ');
+    text.push_back(static_cast<char>('A' + parts.initial));
+    text.append(". ");
+    text.append(RosterLastNames[parts.last].text);
+    if (parts.generation > 0) {
+      text.push_back(' ');
+      text.append(std::to_string(parts.generation + 1));
+    }
+  }
+
+  // Appends the email address of a participant to a given text. The email addresses are unique
+  // since the names are unique and the ASCII forms of the names of each table are unique.
+  static void AppendEmail(const Fields& fields, std::string& text) {
+    text.append(RosterFirstNames[fields.name.first].ascii);
+    text.push_back('.');
+    text.push_back(static_cast<char>('a' + fields.name.initial));
+    text.push_back('.');
+    text.append(RosterLastNames[fields.name.last].ascii);
+    if (fields.name.generation > 0) {
+      text.append(std::to_string(fields.name.generation + 1));
+    }
+    text.push_back('@');
+    text.append(fields.domain);
+  }
+
+  // Appends the street address of a participant to a given text, in the format of its city.
+  static void AppendAddress(const Fields& fields, std::string& text) {
+    const RosterCity& city{*fields.city};
+    if (city.number_first) {
+      text.append(std::to_string(fields.number)).append(" ").append(fields.street);
+    } else {
+      text.append(fields.street).append(" ").append(std::to_string(fields.number));
+    }
+    text.append(", ");
+    if (!city.postal_code_first) {
+      text.append(city.name).append(" ");
+    }
+    text.append(city.postal_code_prefix);
+    uint64_t postal_code{fields.postal_code};
+    for (std::size_t digit = 0; digit < city.postal_code_digits; ++digit) {
+      text.push_back(static_cast<char>('0' + postal_code % 10));
+      postal_code /= 10;
+    }
+    if (city.postal_code_first) {
+      text.append(" ").append(city.name);
+    }
+    text.append(", ").append(city.country);
+  }
+
+  // Appends the group of a participant to a given text, which is its household if any.
+  static void AppendGroup(const Fields& fields, std::string& text) {
+    if (fields.household > 0) {
+      text.append("Household ").append(std::to_string(fields.household));
+    }
+  }
+
+  // Appends the location of a participant to a given text as coordinates in degrees with four
+  // decimals, such as "37.7749, -122.4194".
+  static void AppendLocation(const Fields& fields, std::string& text) {
+    AppendDegrees(fields.latitude, text);
+    text.append(", ");
+    AppendDegrees(fields.longitude, text);
+  }
+
+  // Appends an angle in degrees to a given text with four decimals, without the cost of formatted
+  // output.
+  static void AppendDegrees(const double degrees, std::string& text) {
+    const int64_t units{std::llround(degrees * 10000.0)};
+    const uint64_t magnitude{static_cast<uint64_t>(units < 0 ? -units : units)};
+    if (units < 0) {
+      text.push_back('-');
+    }
+    text.append(std::to_string(magnitude / 10000));
+    text.push_back('.');
+    const uint64_t decimals{magnitude % 10000};
+    text.push_back(static_cast<char>('0' + decimals / 1000));
+    text.push_back(static_cast<char>('0' + (decimals / 100) % 10));
+    text.push_back(static_cast<char>('0' + (decimals / 10) % 10));
+    text.push_back(static_cast<char>('0' + decimals % 10));
+  }
+
+  // Appends a value to a given text as a field of a given format.
+  static void AppendValue(const RosterFormat format, const std::string_view value,
+                          std::string& text) {
+    if (format == RosterFormat::Csv) {
+      AppendCsvField(value, text);
+    } else {
+      AppendYamlScalar(value, text);
+    }
+  }
+
+  // Appends a value to a given text as a double-quoted YAML scalar.
+  static void AppendYamlScalar(const std::string_view value, std::string& text) {
+    text.push_back('"');
+    for (const char character : value) {
+      if (character == '"' || character == '\\') {
+        text.push_back('\\');
+      }
+      text.push_back(character);
+    }
+    text.push_back('"');
+  }
+
+  // Appends a value to a given text as a CSV field, quoted only if it contains a comma, a quote,
+  // or a line break.
+  static void AppendCsvField(const std::string_view value, std::string& text) {
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+      text.append(value);
+      return;
+    }
+    text.push_back('"');
+    for (const char character : value) {
+      if (character == '"') {
+        text.push_back('"');
+      }
+      text.push_back(character);
+    }
+    text.push_back('"');
+  }
+
+  // Writes a given header and then the text rendered for every participant to a given stream. The
+  // participants are split into chunks that a given number of threads render concurrently. Each
+  // chunk is rendered into the slot of its index modulo a window, and the threads stay at most one
+  // window ahead of the chunks written, which bounds the memory in use while keeping the stream
+  // busy. Returns the number of bytes written.
+  std::size_t WriteChunks(
+      std::ostream& stream, const std::string& header, const std::size_t threads,
+      const std::function<void(std::size_t, std::size_t, std::string&)>& render) const {
+    stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+    std::size_t bytes{header.size()};
+
+    const std::size_t chunk_count{(participant_count_ + ChunkSize - 1) / ChunkSize};
+    if (chunk_count == 0) {
+      return bytes;
+    }
+
+    const std::size_t worker_count{std::clamp<std::size_t>(threads, 1, chunk_count)};
+    const std::size_t window{2 * worker_count};
+    std::vector<std::string> slots(window);
+    std::vector<bool> ready(window, false);
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::size_t next_chunk{0};
+    std::size_t written_chunk_count{0};
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (std::size_t worker = 0; worker < worker_count; ++worker) {
+      workers.emplace_back([&]() {
+        std::string text;
+        while (true) {
+          std::size_t chunk{0};
+          {
+            std::unique_lock<std::mutex> lock{mutex};
+            condition.wait(lock, [&]() {
+              return next_chunk >= chunk_count || next_chunk < written_chunk_count + window;
+            });
+            if (next_chunk >= chunk_count) {
+              return;
+            }
+            chunk = next_chunk++;
+          }
+          text.clear();
+          render(chunk * ChunkSize, std::min(participant_count_, (chunk + 1) * ChunkSize), text);
+          {
+            // Swapping hands the buffer of an already written chunk back to this thread for reuse.
+            const std::lock_guard<std::mutex> lock{mutex};
+            slots[chunk % window].swap(text);
+            ready[chunk % window] = true;
+          }
+          condition.notify_all();
+        }
+      });
+    }
+
+    std::string text;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [&]() { return static_cast<bool>(ready[chunk % window]); });
+        text.swap(slots[chunk % window]);
+        ready[chunk % window] = false;
+      }
+      stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+      bytes += text.size();
+      {
+        const std::lock_guard<std::mutex> lock{mutex};
+        ++written_chunk_count;
+      }
+      condition.notify_all();
+    }
+
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+
+    return bytes;
+  }
+
+  // Number of participants of the roster.
+  std::size_t participant_count_{0};
+
+  // Seed from which the roster is derived.
+  uint64_t seed_{0};
+
+  // Number of participants of each household. Zero if the participants do not form households.
+  std::size_t household_size_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_ROSTER_GENERATOR_HPP
@@ -0,0 +1,115 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "RosterGenerator.hpp"
+#include "RosterSettings.hpp"
+
+namespace {
+
+// Opens a given file for writing, creating its directory if needed. Prints a message and returns a
+// closed stream if the file cannot be opened.
+std::ofstream OpenFile(const std::filesystem::path& path, const std::string& description) {
+  if (!path.parent_path().empty()) {
+    std::filesystem::create_directories(path.parent_path());
+  }
+  std::ofstream stream{path.string(), std::ios::binary};
+  if (!stream.is_open()) {
+    std::cout << "Could not open the " << description << " for writing at: " << path.string()
+              << std::endl;
+  }
+  return stream;
+}
+
+// Prints the number of bytes written to a given file and the rate at which they were written.
+void PrintWritten(const std::filesystem::path& path, const std::size_t bytes,
+                  const std::chrono::steady_clock::time_point start) {
+  const int64_t milliseconds{std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count()};
+  std::cout << "Wrote " << bytes / (1024 * 1024) << " MiB in " << milliseconds << " ms";
+  if (milliseconds > 0) {
+    std::cout << " (" << bytes * 1000 / static_cast<uint64_t>(milliseconds) / (1024 * 1024)
+              << " MiB/s)";
+  }
+  std::cout << " to: " << path << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const SecretSanta::Roster::Settings settings{argc, argv};
+
+  const SecretSanta::RosterGenerator generator{
+      settings.ParticipantCount(), settings.Seed(), settings.HouseholdSize()};
+
+  {
+    const std::string description{
+        settings.Format() == SecretSanta::RosterFormat::Csv ? "CSV roster file" :
+                                                              "YAML configuration file"};
+    std::ofstream stream{OpenFile(settings.OutputFile(), description)};
+    if (!stream.is_open()) {
+      return EXIT_FAILURE;
+    }
+    const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    const std::size_t bytes{generator.Write(stream, settings.Format(), settings.Threads())};
+    stream.close();
+    if (!stream) {
+      std::cout << "Could not write the " << description << " at: " << settings.OutputFile()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    PrintWritten(settings.OutputFile(), bytes, start);
+  }
+
+  const std::vector<std::size_t> strides{generator.HistoryStrides(settings.HistoryYears())};
+  if (strides.size() < settings.HistoryYears()) {
+    std::cout << "The " << settings.ParticipantCount() << " participants can only have "
+              << strides.size() << " past years of matchings without repeating a giftee."
+              << std::endl;
+  }
+
+  for (std::size_t year = 1; year <= strides.size(); ++year) {
+    const std::filesystem::path path{settings.HistoryFile(year)};
+    std::ofstream stream{OpenFile(path, "YAML matchings file")};
+    if (!stream.is_open()) {
+      return EXIT_FAILURE;
+    }
+    const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    const std::size_t bytes{
+        generator.WriteHistory(stream, strides[year - 1], settings.Threads())};
+    stream.close();
+    if (!stream) {
+      std::cout << "Could not write the YAML matchings file at: " << path << std::endl;
+      return EXIT_FAILURE;
+    }
+    PrintWritten(path, bytes, start);
+  }
+
+  std::cout << "End of " << SecretSanta::Roster::Program::Title << "." << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,324 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_ROSTER_SETTINGS_HPP
+#define SECRET_SANTA_ROSTER_SETTINGS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "RosterArgument.hpp"
+#include "RosterGenerator.hpp"
+#include "RosterProgram.hpp"
+#include "String.hpp"
+
+namespace SecretSanta::Roster {
+
+// Settings of the Secret Santa Roster program.
+class Settings {
+public:
+  // Default constructor. Constructs settings with default parameters.
+  Settings() = default;
+
+  // Constructor. Constructs settings from command-line arguments.
+  Settings(const int argc, char* argv[]) noexcept {
+    ParseArguments(argc, argv);
+    PrintHeader();
+    PrintCommand();
+    PrintSettings();
+  }
+
+  // Destructor. Destroys this settings object.
+  ~Settings() noexcept = default;
+
+  // Deleted copy constructor.
+  Settings(const Settings& other) = delete;
+
+  // Deleted move constructor.
+  Settings(Settings&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  Settings& operator=(const Settings& other) = delete;
+
+  // Deleted move assignment operator.
+  Settings& operator=(Settings&& other) noexcept = delete;
+
+  // Number of participants of the roster to be generated.
+  [[nodiscard]] std::size_t ParticipantCount() const noexcept {
+    return participant_count_;
+  }
+
+  // Path to the roster file to be written.
+  [[nodiscard]] const std::filesystem::path& OutputFile() const noexcept {
+    return output_file_;
+  }
+
+  // Format of the roster file to be written.
+  [[nodiscard]] RosterFormat Format() const noexcept {
+    return format_;
+  }
+
+  // Seed value from which the roster is derived.
+  [[nodiscard]] uint64_t Seed() const noexcept {
+    return seed_;
+  }
+
+  // Number of participants of each household. Zero if the participants do not form households.
+  [[nodiscard]] std::size_t HouseholdSize() const noexcept {
+    return household_size_;
+  }
+
+  // Number of past years whose matchings are written alongside the roster.
+  [[nodiscard]] std::size_t HistoryYears() const noexcept {
+    return history_years_;
+  }
+
+  // Number of threads that generate the roster.
+  [[nodiscard]] std::size_t Threads() const noexcept {
+    return threads_;
+  }
+
+  // Path to the YAML matchings file of a given past year, one being last year. It is written next
+  // to the roster file, such as "roster_history_1.yaml" for the roster file "roster.yaml".
+  [[nodiscard]] std::filesystem::path HistoryFile(const std::size_t year) const {
+    return output_file_.parent_path()
+           / (output_file_.stem().string() + "_history_" + std::to_string(year) + ".yaml");
+  }
+
+private:
+  // Prints the program's header information to the console.
+  void PrintHeader() const {
+    std::cout << Program::Title << std::endl;
+    std::cout << Program::Description << std::endl;
+    std::cout << "Version: " << Program::CompilationDateAndTime << std::endl;
+  }
+
+  // Prints the program's usage information to the console.
+  void PrintUsage() const {
+    const std::string indent{"  "};
+
+    std::cout << "Usage:" << std::endl;
+
+    std::cout << indent << executable_name_ << " " << Argument::Participants() << " ["
+              << Argument::Output() << "] [" << Argument::Format() << "] [" << Argument::Seed()
+              << "] [" << Argument::HouseholdSize() << "] [" << Argument::History() << "] ["
+              << Argument::Threads() << "]" << std::endl;
+
+    // Compute the padding length of the argument patterns.
+    const std::size_t length = std::max({
+      Argument::Help().length(),
+      Argument::Participants().length(),
+      Argument::Output().length(),
+      Argument::Format().length(),
+      Argument::Seed().length(),
+      Argument::HouseholdSize().length(),
+      Argument::History().length(),
+      Argument::Threads().length(),
+    });
+
+    std::cout << "Arguments:" << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Help(), length) << indent
+              << "Displays this information and exits." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Participants(), length) << indent
+              << "Number of participants of the roster to be generated. Required." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Output(), length) << indent
+              << "Path to the roster file to be written. Optional; defaults to roster.yaml, or "
+                 "roster.csv for the CSV format."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Format(), length) << indent
+              << "Format of the roster file: a YAML configuration file or a CSV file. Optional; "
+                 "defaults to yaml."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Seed(), length) << indent
+              << "Seed value from which the roster is derived; the same seed always yields the "
+                 "same roster. Optional; defaults to 0."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::HouseholdSize(), length) << indent
+              << "Number of participants of each household, who share a group and an address. "
+                 "Optional; defaults to 0 for no households."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::History(), length) << indent
+              << "Number of past years whose YAML matchings files are written next to the "
+                 "roster file. Optional; defaults to 0."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Threads(), length) << indent
+              << "Number of threads that generate the roster. Optional; defaults to the number "
+                 "of hardware threads."
+              << std::endl;
+  }
+
+  // Parses the program's command-line arguments.
+  void ParseArguments(const int argc, char* argv[]) {
+    if (argc <= 1) {
+      PrintHeader();
+      PrintUsage();
+      exit(EXIT_SUCCESS);
+    }
+
+    if (argc >= 1) {
+      executable_name_ = argv[0];
+    }
+
+    for (int index = 1; index < argc;) {
+      if (argv[index] == Argument::Key::Help) {
+        PrintHeader();
+        PrintUsage();
+        exit(EXIT_SUCCESS);
+      } else if (argv[index] == Argument::Key::Participants && AtLeastOneMore(index, argc)) {
+        participant_count_ = std::strtoull(argv[index + 1], nullptr, 10);
+        if (participant_count_ == 0) {
+          PrintHeader();
+          std::cout << "Invalid number of participants: " << argv[index + 1]
+                    << "; please specify an integer of at least 1." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else if (argv[index] == Argument::Key::Output && AtLeastOneMore(index, argc)) {
+        output_file_ = argv[index + 1];
+        index += 2;
+      } else if (argv[index] == Argument::Key::Format && AtLeastOneMore(index, argc)) {
+        const std::optional<RosterFormat> format = ParseRosterFormat(argv[index + 1]);
+        if (!format.has_value()) {
+          PrintHeader();
+          std::cout << "Invalid roster format: " << argv[index + 1]
+                    << "; please specify yaml or csv." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        format_ = format.value();
+        index += 2;
+      } else if (argv[index] == Argument::Key::Seed && AtLeastOneMore(index, argc)) {
+        seed_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::HouseholdSize && AtLeastOneMore(index, argc)) {
+        household_size_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::History && AtLeastOneMore(index, argc)) {
+        history_years_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::Threads && AtLeastOneMore(index, argc)) {
+        threads_ = std::strtoull(argv[index + 1], nullptr, 10);
+        if (threads_ == 0) {
+          PrintHeader();
+          std::cout << "Invalid number of threads: " << argv[index + 1]
+                    << "; please specify an integer of at least 1." << std::endl;
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        index += 2;
+      } else {
+        PrintHeader();
+        std::cout << "Unrecognized argument: " << argv[index] << std::endl;
+        PrintUsage();
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    if (participant_count_ == 0) {
+      PrintHeader();
+      std::cout << "The number of participants is required; please specify "
+                << Argument::Key::Participants << "." << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+
+    if (output_file_.empty()) {
+      output_file_ = "roster." + PrintRosterFormat(format_);
+    }
+  }
+
+  // Returns whether there is at least one more element after the given element index.
+  [[nodiscard]] bool AtLeastOneMore(const int index, const int count) const noexcept {
+    return index + 1 < count;
+  }
+
+  // Prints the command to the console.
+  void PrintCommand() const {
+    std::cout << "Command: " << executable_name_ << " " << Argument::Key::Participants << " "
+              << participant_count_ << " " << Argument::Key::Output << " "
+              << output_file_.string() << " " << Argument::Key::Format << " "
+              << PrintRosterFormat(format_) << " " << Argument::Key::Seed << " " << seed_ << " "
+              << Argument::Key::HouseholdSize << " " << household_size_ << " "
+              << Argument::Key::History << " " << history_years_ << " " << Argument::Key::Threads
+              << " " << threads_ << std::endl;
+  }
+
+  // Prints the settings to the console.
+  void PrintSettings() const {
+    std::cout << "- A roster of " << participant_count_ << " participants will be generated from "
+              << "the seed " << seed_ << " by " << threads_ << " threads." << std::endl;
+
+    if (household_size_ > 0) {
+      std::cout << "- The participants will form households of " << household_size_
+                << " participants." << std::endl;
+    }
+
+    std::cout << "- The roster will be written in the " << PrintRosterFormat(format_)
+              << " format to: " << output_file_ << std::endl;
+
+    for (std::size_t year = 1; year <= history_years_; ++year) {
+      std::cout << "- The matchings of " << year << (year == 1 ? " year" : " years")
+                << " ago will be written to: " << HistoryFile(year) << std::endl;
+    }
+  }
+
+  // Name of the Secret Santa Roster executable.
+  std::string executable_name_;
+
+  // Number of participants of the roster to be generated.
+  std::size_t participant_count_{0};
+
+  // Path to the roster file to be written. If not specified, it is named after the format.
+  std::filesystem::path output_file_;
+
+  // Format of the roster file to be written.
+  RosterFormat format_{RosterFormat::Yaml};
+
+  // Seed value from which the roster is derived.
+  uint64_t seed_{0};
+
+  // Number of participants of each household. Zero if the participants do not form households.
+  std::size_t household_size_{0};
+
+  // Number of past years whose matchings are written alongside the roster.
+  std::size_t history_years_{0};
+
+  // Number of threads that generate the roster.
+  std::size_t threads_{std::max<std::size_t>(std::thread::hardware_concurrency(), 1)};
+};
+
+}  // namespace SecretSanta::Roster
+
+#endif  // SECRET_SANTA_ROSTER_SETTINGS_HPP
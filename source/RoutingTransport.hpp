@@ -0,0 +1,458 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_ROUTING_TRANSPORT_HPP
+#define SECRET_SANTA_ROUTING_TRANSPORT_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Domain of an email address, in lowercase, or an empty string if the address has no domain.
+[[nodiscard]] std::string RecipientDomain(const std::string& address) {
+  const std::size_t at = address.rfind('@');
+  if (at == std::string::npos) {
+    return {};
+  }
+  std::string domain{address.substr(at + 1)};
+  std::transform(domain.begin(), domain.end(), domain.begin(), [](const unsigned char character) {
+    return static_cast<char>(std::tolower(character));
+  });
+  return domain;
+}
+
+// Relay to which a routing transport can hand email messages, such as one of several mail servers.
+struct Relay {
+  // Short human-readable name of the relay, such as its host and port.
+  std::string name;
+
+  // Transport that delivers email messages through the relay.
+  std::unique_ptr<Transport> transport;
+
+  // Function that checks whether the relay is reachable again after it was taken out of rotation.
+  // If empty, the relay is put back into rotation after one health check interval.
+  std::function<bool()> health_check;
+};
+
+// When a routing transport takes a relay out of rotation and how evenly it spreads the load.
+struct RoutingPolicy {
+  // Number of consecutive transient failures after which a relay is taken out of rotation.
+  std::size_t failure_threshold{3};
+
+  // Interval between health checks of the relays that are out of rotation.
+  std::chrono::milliseconds health_check_interval{5000};
+
+  // Maximum number of email messages in flight on a relay, as a multiple of the average over the
+  // relays in rotation, beyond which the email messages of a domain spill over to another relay.
+  double load_factor{1.25};
+};
+
+// Counts of the email messages that a routing transport handed to one of its relays.
+struct RelayStatistics {
+  // Name of the relay.
+  std::string name;
+
+  // Number of email messages delivered through the relay.
+  std::size_t delivered_count{0};
+
+  // Number of deliveries through the relay that failed transiently.
+  std::size_t transient_failure_count{0};
+
+  // Number of deliveries through the relay that failed permanently.
+  std::size_t permanent_failure_count{0};
+
+  // Number of email messages that failed transiently on the relay and were handed to another one.
+  std::size_t failover_count{0};
+
+  // Number of times the relay was taken out of rotation.
+  std::size_t outage_count{0};
+
+  // Whether the relay is currently in rotation.
+  bool healthy{true};
+};
+
+// Transport that spreads email messages among several relays according to the domain of their
+// recipient. Each domain is consistently routed to the same relay, chosen by rendezvous hashing, so
+// that the email messages to one domain reuse the same connections; but a relay that already holds
+// more than its share of the email messages in flight spills the excess over to the next relay in
+// the ranking of the domain, so that one large domain does not overload a single relay. A relay is
+// taken out of rotation after a number of consecutive transient failures, and the email messages
+// that then fail on it are handed to another relay rather than reported as failures. A dedicated
+// thread checks the health of the relays that are out of rotation and puts them back once they are
+// reachable.
+class RoutingTransport : public Transport {
+public:
+  // Constructor. Constructs a transport that routes email messages among the given relays
+  // according to a given policy. There must be at least one relay.
+  explicit RoutingTransport(std::vector<Relay> relays, const RoutingPolicy& policy = {})
+    : policy_(policy) {
+    for (Relay& relay : relays) {
+      relays_.push_back(RelayState{std::move(relay)});
+    }
+    monitor_ = std::thread{[this]() { Monitor(); }};
+  }
+
+  // Destructor. Waits for all email messages to be delivered, stops the thread that checks the
+  // health of the relays, and then destroys the relays.
+  ~RoutingTransport() noexcept override {
+    Flush();
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      stopping_ = true;
+    }
+    monitor_condition_.notify_all();
+    monitor_.join();
+  }
+
+  // Deleted copy constructor.
+  RoutingTransport(const RoutingTransport& other) = delete;
+
+  // Deleted move constructor.
+  RoutingTransport(RoutingTransport&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  RoutingTransport& operator=(const RoutingTransport& other) = delete;
+
+  // Deleted move assignment operator.
+  RoutingTransport& operator=(RoutingTransport&& other) noexcept = delete;
+
+  [[nodiscard]] std::string Name() const override {
+    std::string name{"Routing among " + std::to_string(relays_.size()) + " relays ("};
+    for (std::size_t index = 0; index < relays_.size(); ++index) {
+      name.append((index > 0 ? ", " : "") + relays_[index].relay.name);
+    }
+    return name + ")";
+  }
+
+  void Send(EmailMessage message, Completion completion) override {
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      if (start_ == std::chrono::steady_clock::time_point{}) {
+        start_ = std::chrono::steady_clock::now();
+      }
+      ++pending_count_;
+    }
+    Dispatch(Job{std::move(message), std::move(completion),
+                 std::vector<bool>(relays_.size(), false)});
+  }
+
+  void Flush() override {
+    std::unique_lock<std::mutex> lock{mutex_};
+    pending_condition_.wait(lock, [this]() { return pending_count_ == 0; });
+  }
+
+  // Index of the relay ranked first for a given domain, to which the email messages to that domain
+  // are routed while it is in rotation and not busier than the others.
+  [[nodiscard]] std::size_t PreferredRelay(const std::string& domain) const {
+    const std::size_t domain_hash = std::hash<std::string>{}(domain);
+    std::size_t preferred = 0;
+    for (std::size_t index = 1; index < relays_.size(); ++index) {
+      if (Score(domain_hash, index) > Score(domain_hash, preferred)) {
+        preferred = index;
+      }
+    }
+    return preferred;
+  }
+
+  // Statistics of each relay, in the order in which the relays were given.
+  [[nodiscard]] std::vector<RelayStatistics> Statistics() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    std::vector<RelayStatistics> statistics;
+    for (const RelayState& state : relays_) {
+      statistics.push_back(state.statistics);
+    }
+    return statistics;
+  }
+
+  // Prints the number of email messages delivered through each relay and its throughput over the
+  // run, along with its failures and outages.
+  void PrintStatistics() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    const double seconds = std::chrono::duration<double>(finish_ - start_).count();
+    for (const RelayState& state : relays_) {
+      const RelayStatistics& statistics = state.statistics;
+      std::cout << "Relay " << statistics.name << ": delivered " << statistics.delivered_count
+                << " email messages ("
+                << (seconds > 0.0 ? static_cast<double>(statistics.delivered_count) / seconds : 0.0)
+                << " per second), " << statistics.transient_failure_count
+                << " transient failures, " << statistics.permanent_failure_count
+                << " permanent failures, " << statistics.failover_count
+                << " failed over to another relay, and taken out of rotation "
+                << statistics.outage_count << " times." << std::endl;
+    }
+  }
+
+private:
+  // Email message being routed, along with its completion function and the relays tried so far.
+  struct Job {
+    // Email message to be delivered.
+    EmailMessage message;
+
+    // Function invoked once the delivery of the email message completes.
+    Completion completion;
+
+    // Whether each relay was already tried for the email message.
+    std::vector<bool> tried;
+  };
+
+  // Relay along with its health and counts.
+  struct RelayState {
+    // Relay to which email messages are handed.
+    Relay relay;
+
+    // Number of consecutive transient failures on the relay.
+    std::size_t consecutive_failure_count{0};
+
+    // Number of email messages handed to the relay whose delivery has not yet completed.
+    std::size_t in_flight_count{0};
+
+    // Time at which the relay was last taken out of rotation.
+    std::chrono::steady_clock::time_point outage_start;
+
+    // Counts of the email messages handed to the relay, and whether it is in rotation.
+    RelayStatistics statistics;
+
+    // Constructor. Constructs the state of a given relay, which starts in rotation.
+    explicit RelayState(Relay&& other) : relay(std::move(other)) {
+      statistics.name = relay.name;
+    }
+  };
+
+  // Score of a given relay for a given domain in rendezvous hashing. Each domain ranks the relays
+  // by their score, so that adding or removing a relay only moves the domains ranked first on it.
+  [[nodiscard]] static uint64_t Score(const std::size_t domain_hash, const std::size_t index) {
+    uint64_t value = static_cast<uint64_t>(domain_hash) ^ ((index + 1) * 0x9E3779B97F4A7C15ULL);
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+  }
+
+  // Chooses the relay for an email message to a given domain among those not yet tried, preferring
+  // relays in rotation. Returns the highest-ranked relay for the domain whose number of email
+  // messages in flight is below the load bound. Must be called with the mutex locked.
+  [[nodiscard]] std::size_t Choose(
+      const std::string& domain, const std::vector<bool>& tried) const {
+    std::vector<std::size_t> candidates;
+    for (const bool require_healthy : {true, false}) {
+      for (std::size_t index = 0; index < relays_.size(); ++index) {
+        if (!tried[index] && (!require_healthy || relays_[index].statistics.healthy)) {
+          candidates.push_back(index);
+        }
+      }
+      if (!candidates.empty()) {
+        break;
+      }
+    }
+    if (candidates.empty()) {
+      for (std::size_t index = 0; index < relays_.size(); ++index) {
+        candidates.push_back(index);
+      }
+    }
+
+    const std::size_t domain_hash = std::hash<std::string>{}(domain);
+    std::sort(candidates.begin(), candidates.end(),
+              [domain_hash](const std::size_t first, const std::size_t second) {
+                return Score(domain_hash, first) > Score(domain_hash, second);
+              });
+
+    // Some candidate is always below the bound, since the bound exceeds the average.
+    std::size_t in_flight_count = 0;
+    for (const std::size_t index : candidates) {
+      in_flight_count += relays_[index].in_flight_count;
+    }
+    const double bound = policy_.load_factor * static_cast<double>(in_flight_count + 1)
+                         / static_cast<double>(candidates.size());
+    for (const std::size_t index : candidates) {
+      if (static_cast<double>(relays_[index].in_flight_count) < bound) {
+        return index;
+      }
+    }
+    return candidates.front();
+  }
+
+  // Hands an email message to the relay chosen for the domain of its recipient.
+  void Dispatch(Job job) {
+    std::size_t index = 0;
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      index = Choose(RecipientDomain(job.message.Recipient()), job.tried);
+      job.tried[index] = true;
+      ++relays_[index].in_flight_count;
+    }
+    relays_[index].relay.transport->Send(
+        std::move(job.message),
+        [this, index, completion = std::move(job.completion), tried = std::move(job.tried)](
+            const EmailMessage& message, const Delivery& delivery) {
+          Complete(index, Job{message, completion, tried}, delivery);
+        });
+  }
+
+  // Records the outcome of the delivery of an email message through a given relay. Hands the email
+  // message to another relay if it failed transiently on a relay that is out of rotation and
+  // another relay in rotation has not yet been tried. Otherwise, invokes its completion function.
+  void Complete(const std::size_t index, Job job, const Delivery& delivery) {
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      RelayState& state = relays_[index];
+      --state.in_flight_count;
+      finish_ = std::chrono::steady_clock::now();
+      if (delivery.Status() == DeliveryStatus::Delivered) {
+        ++state.statistics.delivered_count;
+        state.consecutive_failure_count = 0;
+      } else if (delivery.Status() == DeliveryStatus::PermanentFailure) {
+        ++state.statistics.permanent_failure_count;
+        state.consecutive_failure_count = 0;
+      } else {
+        ++state.statistics.transient_failure_count;
+        if (++state.consecutive_failure_count >= policy_.failure_threshold
+            && state.statistics.healthy) {
+          state.statistics.healthy = false;
+          ++state.statistics.outage_count;
+          state.outage_start = std::chrono::steady_clock::now();
+          check_now_ = true;
+          monitor_condition_.notify_all();
+        }
+        if (!state.statistics.healthy && HasUntriedHealthyRelay(job.tried)) {
+          ++state.statistics.failover_count;
+          failovers_.push_back(std::move(job));
+          monitor_condition_.notify_all();
+          return;
+        }
+      }
+    }
+
+    job.completion(job.message, delivery);
+
+    const std::lock_guard<std::mutex> lock{mutex_};
+    if (--pending_count_ == 0) {
+      pending_condition_.notify_all();
+    }
+  }
+
+  // Whether some relay in rotation was not yet tried. Must be called with the mutex locked.
+  [[nodiscard]] bool HasUntriedHealthyRelay(const std::vector<bool>& tried) const {
+    for (std::size_t index = 0; index < relays_.size(); ++index) {
+      if (!tried[index] && relays_[index].statistics.healthy) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Hands the email messages that failed over to other relays, and checks the health of the relays
+  // that are out of rotation, until this transport is destroyed. Failovers are handed over from
+  // this thread rather than from the thread that reported the failure, so that the threads of one
+  // relay never wait on the capacity of another.
+  void Monitor() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    std::chrono::steady_clock::time_point next_check{
+        std::chrono::steady_clock::now() + policy_.health_check_interval};
+    while (!stopping_) {
+      monitor_condition_.wait_until(lock, next_check, [this]() {
+        return stopping_ || check_now_ || !failovers_.empty();
+      });
+
+      while (!failovers_.empty()) {
+        Job job{std::move(failovers_.front())};
+        failovers_.pop_front();
+        lock.unlock();
+        Dispatch(std::move(job));
+        lock.lock();
+      }
+
+      if (check_now_ || std::chrono::steady_clock::now() >= next_check) {
+        check_now_ = false;
+        next_check = std::chrono::steady_clock::now() + policy_.health_check_interval;
+        for (RelayState& state : relays_) {
+          if (state.statistics.healthy) {
+            continue;
+          }
+          bool healthy = std::chrono::steady_clock::now() - state.outage_start
+                         >= policy_.health_check_interval;
+          if (state.relay.health_check) {
+            const std::function<bool()> health_check{state.relay.health_check};
+            lock.unlock();
+            healthy = health_check();
+            lock.lock();
+          }
+          if (healthy) {
+            state.statistics.healthy = true;
+            state.consecutive_failure_count = 0;
+          }
+        }
+      }
+    }
+  }
+
+  // Policy according to which relays are taken out of rotation and the load is spread.
+  RoutingPolicy policy_;
+
+  // Relays to which email messages are handed, along with their health and counts.
+  std::vector<RelayState> relays_;
+
+  // Protects the state of the relays, the failovers, and the counts of pending email messages.
+  mutable std::mutex mutex_;
+
+  // Notified when all deliveries have completed.
+  std::condition_variable pending_condition_;
+
+  // Number of email messages whose delivery has not yet completed.
+  std::size_t pending_count_{0};
+
+  // Time at which the first email message was sent.
+  std::chrono::steady_clock::time_point start_;
+
+  // Time at which the last delivery completed.
+  std::chrono::steady_clock::time_point finish_;
+
+  // Email messages that failed on a relay out of rotation, waiting to be handed to another relay.
+  std::deque<Job> failovers_;
+
+  // Whether a relay was just taken out of rotation, so that its health is checked right away.
+  bool check_now_{false};
+
+  // Whether this transport is being destroyed.
+  bool stopping_{false};
+
+  // Notified when there are failovers to hand over or relays to check, or when stopping.
+  std::condition_variable monitor_condition_;
+
+  // Thread that hands over failovers and checks the health of the relays out of rotation.
+  std::thread monitor_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_ROUTING_TRANSPORT_HPP
@@ -0,0 +1,330 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_RUN_REPORT_HPP
+#define SECRET_SANTA_RUN_REPORT_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "DeliveryOutcomes.hpp"
+#include "Shard.hpp"
+
+namespace SecretSanta {
+
+// Summary of the outcome file of one host within a run report.
+struct ShardSummary {
+  // Optional shard of the gifters that the host covered. If no value is specified, the host covered
+  // every gifter.
+  std::optional<Shard> shard;
+
+  // Name of the host.
+  std::string host;
+
+  // Number of email messages that the host attempted to deliver.
+  std::size_t messages{0};
+
+  // Number of email messages that the host delivered.
+  std::size_t delivered{0};
+};
+
+// Report of one run of the Secret Santa Messenger, merged from the outcome files written by the
+// hosts that each sent the email messages of one shard. Besides adding up the deliveries, it checks
+// that the outcome files fit together: that they agree on the number of shards, that every shard is
+// covered exactly once, and that no gifter was sent an email message by more than one host.
+class RunReport {
+public:
+  // Default constructor. Constructs an empty run report.
+  RunReport() = default;
+
+  // Constructor. Constructs a run report by merging the outcomes of several hosts.
+  explicit RunReport(const std::vector<DeliveryOutcomes>& outcomes) {
+    std::optional<std::size_t> shard_count;
+    std::map<std::size_t, std::size_t> shard_occurrences;
+    std::map<std::string, std::size_t> gifter_occurrences;
+    for (const DeliveryOutcomes& host_outcomes : outcomes) {
+      ShardSummary summary{host_outcomes.HostShard(), host_outcomes.Host(), host_outcomes.Size()};
+
+      // Outcome files without a shard cover every gifter, as if they were the only shard of one.
+      const Shard shard{host_outcomes.HostShard().value_or(Shard{})};
+      if (!shard_count.has_value()) {
+        shard_count = shard.Count();
+      } else if (shard_count.value() != shard.Count()) {
+        inconsistent_ = true;
+      }
+      ++shard_occurrences[shard.Index()];
+
+      for (const DeliveryOutcome& outcome : host_outcomes.Entries()) {
+        if (++gifter_occurrences[outcome.gifter] == 2) {
+          overlapping_gifters_.push_back(outcome.gifter);
+        }
+        if (outcome.status == DeliveryStatus::Delivered) {
+          ++summary.delivered;
+        } else {
+          failures_.push_back(outcome);
+        }
+      }
+
+      messages_ += summary.messages;
+      delivered_ += summary.delivered;
+      summaries_.push_back(std::move(summary));
+    }
+
+    shard_count_ = shard_count.value_or(0);
+    for (std::size_t index = 1; index <= shard_count_; ++index) {
+      const std::map<std::size_t, std::size_t>::const_iterator found{
+          shard_occurrences.find(index)};
+      if (found == shard_occurrences.cend()) {
+        missing_shards_.push_back(index);
+      } else if (found->second > 1) {
+        repeated_shards_.push_back(index);
+      }
+    }
+    gifters_ = gifter_occurrences.size();
+  }
+
+  // Destructor. Destroys this run report.
+  ~RunReport() noexcept = default;
+
+  // Copy constructor. Constructs a run report by copying another one.
+  RunReport(const RunReport& other) = default;
+
+  // Move constructor. Constructs a run report by moving another one.
+  RunReport(RunReport&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this run report by copying another one.
+  RunReport& operator=(const RunReport& other) = default;
+
+  // Move assignment operator. Assigns this run report by moving another one.
+  RunReport& operator=(RunReport&& other) noexcept = default;
+
+  // Summaries of the outcome files, in the order in which they were merged.
+  [[nodiscard]] const std::vector<ShardSummary>& Summaries() const noexcept {
+    return summaries_;
+  }
+
+  // Number of shards into which the gifters were partitioned, according to the outcome files.
+  [[nodiscard]] constexpr std::size_t ShardCount() const noexcept {
+    return shard_count_;
+  }
+
+  // Whether the outcome files disagree on the number of shards.
+  [[nodiscard]] constexpr bool Inconsistent() const noexcept {
+    return inconsistent_;
+  }
+
+  // Indices of the shards for which there is no outcome file, in increasing order.
+  [[nodiscard]] const std::vector<std::size_t>& MissingShards() const noexcept {
+    return missing_shards_;
+  }
+
+  // Indices of the shards for which there are several outcome files, in increasing order.
+  [[nodiscard]] const std::vector<std::size_t>& RepeatedShards() const noexcept {
+    return repeated_shards_;
+  }
+
+  // Names of the gifters that appear in more than one outcome file, in the order in which they were
+  // found.
+  [[nodiscard]] const std::vector<std::string>& OverlappingGifters() const noexcept {
+    return overlapping_gifters_;
+  }
+
+  // Outcomes of the email messages that could not be delivered, in the order in which they were
+  // merged.
+  [[nodiscard]] const std::vector<DeliveryOutcome>& Failures() const noexcept {
+    return failures_;
+  }
+
+  // Total number of email messages that the hosts attempted to deliver.
+  [[nodiscard]] constexpr std::size_t Messages() const noexcept {
+    return messages_;
+  }
+
+  // Total number of email messages that the hosts delivered.
+  [[nodiscard]] constexpr std::size_t Delivered() const noexcept {
+    return delivered_;
+  }
+
+  // Number of distinct gifters across the outcome files.
+  [[nodiscard]] constexpr std::size_t Gifters() const noexcept {
+    return gifters_;
+  }
+
+  // Whether the outcome files fit together: they agree on the number of shards, every shard is
+  // covered exactly once, and no gifter appears in more than one outcome file.
+  [[nodiscard]] bool IsComplete() const noexcept {
+    return shard_count_ > 0 && !inconsistent_ && missing_shards_.empty()
+           && repeated_shards_.empty() && overlapping_gifters_.empty();
+  }
+
+  // Whether the run is complete and every email message was delivered.
+  [[nodiscard]] bool Succeeded() const noexcept {
+    return IsComplete() && failures_.empty();
+  }
+
+  // Prints this run report to the console.
+  void Print() const {
+    for (const ShardSummary& summary : summaries_) {
+      std::cout << "- Shard "
+                << (summary.shard.has_value() ? summary.shard->Print() : std::string{"1/1"})
+                << " on host " << (summary.host.empty() ? std::string{"(unknown)"} : summary.host)
+                << ": delivered " << summary.delivered << " of " << summary.messages
+                << " email messages." << std::endl;
+    }
+
+    std::cout << "Delivered " << delivered_ << " of " << messages_ << " email messages to "
+              << gifters_ << " gifters across " << summaries_.size() << " outcome files."
+              << std::endl;
+
+    if (inconsistent_) {
+      std::cout << "The outcome files disagree on the number of shards; please check that every "
+                   "host was given the same number of shards."
+                << std::endl;
+    }
+    if (!missing_shards_.empty()) {
+      std::cout << "No outcome file covers the shards " << PrintIndices(missing_shards_) << " of "
+                << shard_count_ << "; their gifters may not have been sent a message." << std::endl;
+    }
+    if (!repeated_shards_.empty()) {
+      std::cout << "Several outcome files cover the shards " << PrintIndices(repeated_shards_)
+                << " of " << shard_count_ << "." << std::endl;
+    }
+    if (!overlapping_gifters_.empty()) {
+      std::cout << overlapping_gifters_.size()
+                << " gifters appear in more than one outcome file and may have been sent several "
+                   "messages, such as: "
+                << overlapping_gifters_.front() << std::endl;
+    }
+    for (const DeliveryOutcome& failure : failures_) {
+      std::cout << "- Could not deliver the email message of " << failure.gifter << " to "
+                << failure.recipient << " after " << failure.attempts << " attempts: "
+                << failure.details << std::endl;
+    }
+  }
+
+  // Writes this run report to a given YAML file.
+  void Write(const std::filesystem::path& path) const {
+    if (path.empty()) {
+      return;
+    }
+
+    if (!path.parent_path().empty()) {
+      std::filesystem::create_directories(path.parent_path());
+    }
+
+    std::ofstream stream{path.string()};
+    if (!stream.is_open()) {
+      std::cout << "Could not open the YAML run report file for writing at: " << path.string()
+                << std::endl;
+      return;
+    }
+
+    YAML::Emitter emitter;
+    emitter << YAML::BeginMap;
+    emitter << YAML::Key << "complete" << YAML::Value << IsComplete();
+    emitter << YAML::Key << "shards" << YAML::Value << shard_count_;
+    emitter << YAML::Key << "messages" << YAML::Value << messages_;
+    emitter << YAML::Key << "delivered" << YAML::Value << delivered_;
+    emitter << YAML::Key << "failed" << YAML::Value << failures_.size();
+    emitter << YAML::Key << "hosts" << YAML::Value << YAML::BeginSeq;
+    for (const ShardSummary& summary : summaries_) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "shard" << YAML::Value
+              << (summary.shard.has_value() ? summary.shard->Print() : std::string{"1/1"});
+      emitter << YAML::Key << "host" << YAML::Value << summary.host;
+      emitter << YAML::Key << "messages" << YAML::Value << summary.messages;
+      emitter << YAML::Key << "delivered" << YAML::Value << summary.delivered;
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq;
+    emitter << YAML::Key << "missing_shards" << YAML::Value << YAML::Flow << missing_shards_;
+    emitter << YAML::Key << "repeated_shards" << YAML::Value << YAML::Flow << repeated_shards_;
+    emitter << YAML::Key << "overlapping_gifters" << YAML::Value << overlapping_gifters_;
+    emitter << YAML::Key << "failures" << YAML::Value << YAML::BeginSeq;
+    for (const DeliveryOutcome& failure : failures_) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "gifter" << YAML::Value << failure.gifter;
+      emitter << YAML::Key << "recipient" << YAML::Value << failure.recipient;
+      emitter << YAML::Key << "status" << YAML::Value << PrintDeliveryStatus(failure.status);
+      emitter << YAML::Key << "attempts" << YAML::Value << failure.attempts;
+      emitter << YAML::Key << "details" << YAML::Value << failure.details;
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq << YAML::EndMap;
+
+    stream << emitter.c_str() << std::endl;
+    stream.close();
+
+    std::cout << "Wrote the run report to: " << path << std::endl;
+  }
+
+private:
+  // Prints shard indices separated by commas.
+  [[nodiscard]] static std::string PrintIndices(const std::vector<std::size_t>& indices) {
+    std::string text;
+    for (const std::size_t index : indices) {
+      text.append(text.empty() ? "" : ", ").append(std::to_string(index));
+    }
+    return text;
+  }
+
+  // Summaries of the outcome files, in the order in which they were merged.
+  std::vector<ShardSummary> summaries_;
+
+  // Number of shards into which the gifters were partitioned, according to the outcome files.
+  std::size_t shard_count_{0};
+
+  // Whether the outcome files disagree on the number of shards.
+  bool inconsistent_{false};
+
+  // Indices of the shards for which there is no outcome file.
+  std::vector<std::size_t> missing_shards_;
+
+  // Indices of the shards for which there are several outcome files.
+  std::vector<std::size_t> repeated_shards_;
+
+  // Names of the gifters that appear in more than one outcome file.
+  std::vector<std::string> overlapping_gifters_;
+
+  // Outcomes of the email messages that could not be delivered.
+  std::vector<DeliveryOutcome> failures_;
+
+  // Total number of email messages that the hosts attempted to deliver.
+  std::size_t messages_{0};
+
+  // Total number of email messages that the hosts delivered.
+  std::size_t delivered_{0};
+
+  // Number of distinct gifters across the outcome files.
+  std::size_t gifters_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_RUN_REPORT_HPP
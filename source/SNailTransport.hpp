@@ -0,0 +1,187 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SNAIL_TRANSPORT_HPP
+#define SECRET_SANTA_SNAIL_TRANSPORT_HPP
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <sys/wait.h>
+#include <system_error>
+#include <vector>
+
+#include "Participant.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Quotes a given text as a single argument of a shell command: encloses it in single quotes, within
+// which the shell interprets no character, and writes each single quote of the text as a closing
+// quote, an escaped quote, and an opening quote.
+[[nodiscard]] std::string QuoteShellArgument(const std::string& text) {
+  std::string quoted{"'"};
+  for (const char character : text) {
+    if (character == '\'') {
+      quoted.append("'\\''");
+    } else {
+      quoted.push_back(character);
+    }
+  }
+  return quoted + "'";
+}
+
+// Composes the command used to invoke the S-nail utility to send a message with a given subject and
+// body to a given email address, with the files at given paths as attachments. The body is written
+// through printf rather than echo, since echo may interpret backslashes. S-nail is told that the
+// subject and body are UTF-8 so that it encodes any non-ASCII header field as RFC 2047 encoded
+// words and any non-ASCII body as quoted-printable.
+[[nodiscard]] std::string ComposeCommand(
+    const std::string& email, const std::string& message_subject, const std::string& message_body,
+    const std::vector<std::filesystem::path>& attachment_paths = {}) {
+  std::string command{"printf '%s\\n' " + QuoteShellArgument(message_body)
+                      + " | s-nail -S ttycharset=utf-8 -S sendcharsets=utf-8"
+                        " -S mime-encoding=quoted-printable --subject "
+                      + QuoteShellArgument(message_subject)};
+  for (const std::filesystem::path& attachment_path : attachment_paths) {
+    command.append(" -a ").append(QuoteShellArgument(attachment_path.string()));
+  }
+  return command + " " + QuoteShellArgument(email);
+}
+
+// Composes the command used to invoke the S-nail utility for a given gifter.
+[[nodiscard]] std::string ComposeCommand(
+    const Participant& gifter, const std::string& message_subject,
+    const std::string& message_body) {
+  return ComposeCommand(gifter.Email(), message_subject, message_body);
+}
+
+// Transport that delivers each email message by running the S-nail utility, which sends it through
+// whichever mail server S-nail is configured to use. Each delivery blocks until S-nail exits.
+// S-nail composes the email message from its subject and plain text body, so any HTML body is not
+// sent. Attachments, such as the calendar invitation of the event, are written to files of their
+// own name in a temporary directory, which S-nail attaches and which is removed once S-nail exits.
+class SNailTransport : public Transport {
+public:
+  // Default constructor. Constructs an S-nail transport.
+  SNailTransport() = default;
+
+  // Destructor. Destroys this S-nail transport.
+  ~SNailTransport() noexcept override = default;
+
+  // Deleted copy constructor.
+  SNailTransport(const SNailTransport& other) = delete;
+
+  // Deleted move constructor.
+  SNailTransport(SNailTransport&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  SNailTransport& operator=(const SNailTransport& other) = delete;
+
+  // Deleted move assignment operator.
+  SNailTransport& operator=(SNailTransport&& other) noexcept = delete;
+
+  [[nodiscard]] std::string Name() const override {
+    return "S-nail";
+  }
+
+  void Send(EmailMessage message, Completion completion) override {
+    std::optional<std::filesystem::path> directory;
+    std::vector<std::filesystem::path> attachment_paths;
+    if (!message.Attachments().empty()) {
+      directory = WriteAttachments(message, attachment_paths);
+      if (!directory.has_value()) {
+        completion(message, Delivery{DeliveryStatus::TransientFailure,
+                                     "Could not write the attachments of the email message to a "
+                                     "temporary directory."});
+        return;
+      }
+    }
+
+    const std::string command{ComposeCommand(
+        message.Recipient(), message.Subject(), message.Body(), attachment_paths)};
+
+    const int outcome{std::system(command.c_str())};
+
+    if (directory.has_value()) {
+      std::error_code error;
+      std::filesystem::remove_all(directory.value(), error);
+    }
+
+    if (outcome == 0) {
+      completion(message, Delivery{});
+    } else if (WIFEXITED(outcome) && WEXITSTATUS(outcome) == 127) {
+      // The shell could not find S-nail, so a later attempt would fail again.
+      completion(message, Delivery{DeliveryStatus::PermanentFailure,
+                                   "Could not find the S-nail utility to run the command: "
+                                       + command});
+    } else {
+      // S-nail does not otherwise report whether a failure is permanent, so a later attempt is
+      // assumed to possibly succeed.
+      completion(message, Delivery{DeliveryStatus::TransientFailure,
+                                   "Could not run the command: " + command});
+    }
+  }
+
+  void Flush() override {}
+
+private:
+  // Writes the attachments of a given email message to files of their own name in a new temporary
+  // directory and appends the paths of these files to a given list. Returns the directory, or
+  // nothing if it or any of its files could not be written, in which case nothing is left behind.
+  [[nodiscard]] static std::optional<std::filesystem::path> WriteAttachments(
+      const EmailMessage& message, std::vector<std::filesystem::path>& attachment_paths) {
+    std::error_code error;
+    const std::filesystem::path temporary{std::filesystem::temp_directory_path(error)};
+    if (error) {
+      return std::nullopt;
+    }
+    std::string pattern{(temporary / "secret-santa-XXXXXX").string()};
+    if (mkdtemp(pattern.data()) == nullptr) {
+      return std::nullopt;
+    }
+    const std::filesystem::path directory{pattern};
+
+    for (const std::shared_ptr<const EmailAttachment>& attachment : message.Attachments()) {
+      // Only the last component of the file name is kept, so that the file stays in the directory.
+      std::filesystem::path file_name{std::filesystem::path{attachment->file_name}.filename()};
+      if (file_name.empty() || file_name == "." || file_name == "..") {
+        file_name = "attachment";
+      }
+      const std::filesystem::path path{directory / file_name};
+      std::ofstream stream{path, std::ios::binary};
+      stream.write(attachment->data.data(), static_cast<std::streamsize>(attachment->data.size()));
+      stream.close();
+      if (!stream) {
+        std::filesystem::remove_all(directory, error);
+        return std::nullopt;
+      }
+      attachment_paths.push_back(path);
+    }
+    return directory;
+  }
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SNAIL_TRANSPORT_HPP
@@ -0,0 +1,286 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SEND_SCHEDULER_HPP
+#define SECRET_SANTA_SEND_SCHEDULER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "Configuration.hpp"
+#include "Emailer.hpp"
+#include "Matchings.hpp"
+#include "TimeZone.hpp"
+#include "TimerWheel.hpp"
+
+namespace SecretSanta {
+
+// Times at which the email message of each gifter is due to be sent, and the email messages being
+// sent. Can be written to a YAML schedule file and read back, so that a Messenger that is stopped
+// or restarted while it waits resumes the same schedule rather than computing a new one or sending
+// the email messages twice.
+class SendSchedule {
+public:
+  // Constructor. Constructs an empty schedule kept in a given YAML schedule file.
+  explicit SendSchedule(std::filesystem::path path) : path_(std::move(path)) {}
+
+  // Destructor. Destroys this schedule. Leaves its file in place.
+  ~SendSchedule() noexcept = default;
+
+  // Copy constructor. Constructs a schedule by copying another one.
+  SendSchedule(const SendSchedule& other) = default;
+
+  // Move constructor. Constructs a schedule by moving another one.
+  SendSchedule(SendSchedule&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this schedule by copying another one.
+  SendSchedule& operator=(const SendSchedule& other) = default;
+
+  // Move assignment operator. Assigns this schedule by moving another one.
+  SendSchedule& operator=(SendSchedule&& other) noexcept = default;
+
+  // Path to the YAML schedule file of this schedule.
+  [[nodiscard]] const std::filesystem::path& Path() const noexcept {
+    return path_;
+  }
+
+  // Time at which the email message of each gifter is due to be sent, by gifter name, in seconds
+  // since the epoch.
+  [[nodiscard]] const std::map<std::string, std::time_t>& Entries() const noexcept {
+    return entries_;
+  }
+
+  // Names of the gifters whose email messages were released and are being sent. If the Messenger
+  // stops while they are being sent, they may or may not have been sent.
+  [[nodiscard]] const std::set<std::string>& InFlight() const noexcept {
+    return in_flight_;
+  }
+
+  // Whether no email messages are waiting to be sent.
+  [[nodiscard]] bool Empty() const noexcept {
+    return entries_.empty();
+  }
+
+  // Schedules the email message of a given gifter at a given time, replacing any earlier time.
+  void Add(const std::string& gifter_name, const std::time_t time) {
+    entries_[gifter_name] = time;
+  }
+
+  // Marks the email messages of given gifters as being sent, such that they no longer wait.
+  void MarkInFlight(const std::set<std::string>& gifter_names) {
+    for (const std::string& gifter_name : gifter_names) {
+      entries_.erase(gifter_name);
+      in_flight_.insert(gifter_name);
+    }
+  }
+
+  // Removes the email messages of given gifters once they are sent.
+  void Remove(const std::set<std::string>& gifter_names) {
+    for (const std::string& gifter_name : gifter_names) {
+      entries_.erase(gifter_name);
+      in_flight_.erase(gifter_name);
+    }
+  }
+
+  // Reads the schedule from its file, if it exists. Returns whether it was read.
+  bool Load() {
+    if (!std::filesystem::exists(path_)) {
+      return false;
+    }
+    const YAML::Node root = YAML::LoadFile(path_.string());
+    if (!root || !root["send_schedule"] || !root["send_schedule"].IsSequence()) {
+      std::cout << "Cannot parse the YAML schedule file at " << path_
+                << "; a new schedule will be computed." << std::endl;
+      return false;
+    }
+    entries_.clear();
+    for (const YAML::Node& node : root["send_schedule"]) {
+      if (node.IsMap() && node["gifter"] && node["time"]) {
+        entries_[node["gifter"].as<std::string>()] = node["time"].as<std::time_t>();
+      }
+    }
+    in_flight_.clear();
+    if (root["in_flight"] && root["in_flight"].IsSequence()) {
+      for (const YAML::Node& node : root["in_flight"]) {
+        if (node.IsScalar()) {
+          in_flight_.insert(node.Scalar());
+        }
+      }
+    }
+    return true;
+  }
+
+  // Writes the schedule to its file, or removes the file if no email messages are waiting or being
+  // sent. Writes a temporary file first and renames it, so that the file is never left partially
+  // written.
+  void Save() const {
+    std::error_code error;
+    if (entries_.empty() && in_flight_.empty()) {
+      std::filesystem::remove(path_, error);
+      return;
+    }
+
+    YAML::Emitter emitter;
+    emitter << YAML::BeginMap << YAML::Key << "send_schedule" << YAML::Value << YAML::BeginSeq;
+    for (const std::pair<const std::string, std::time_t>& entry : entries_) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "gifter" << YAML::Value << entry.first;
+      emitter << YAML::Key << "time" << YAML::Value << static_cast<int64_t>(entry.second);
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq;
+    if (!in_flight_.empty()) {
+      emitter << YAML::Key << "in_flight" << YAML::Value << YAML::BeginSeq;
+      for (const std::string& gifter_name : in_flight_) {
+        emitter << gifter_name;
+      }
+      emitter << YAML::EndSeq;
+    }
+    emitter << YAML::EndMap;
+
+    if (!path_.parent_path().empty()) {
+      std::filesystem::create_directories(path_.parent_path(), error);
+    }
+    std::filesystem::path temporary{path_};
+    temporary += ".tmp";
+    {
+      std::ofstream stream{temporary};
+      stream << emitter.c_str() << std::endl;
+      if (!stream) {
+        std::cout << "Could not write the YAML schedule file at: " << temporary << std::endl;
+        return;
+      }
+    }
+    std::filesystem::rename(temporary, path_, error);
+    if (error) {
+      std::cout << "Could not write the YAML schedule file at " << path_ << ": "
+                << error.message() << std::endl;
+    }
+  }
+
+private:
+  // Path to the YAML schedule file of this schedule.
+  std::filesystem::path path_;
+
+  // Time at which the email message of each gifter is due to be sent, by gifter name, in seconds
+  // since the epoch.
+  std::map<std::string, std::time_t> entries_;
+
+  // Names of the gifters whose email messages are being sent.
+  std::set<std::string> in_flight_;
+};
+
+// Schedules the email message of each gifter who has a giftee, or only of the given gifters if any
+// are given, at the next time at or after a given time at which the clock of the gifter reads a
+// given time of day. Gifters without a time zone, or with a time zone that is not in the time zone
+// database, get the local time zone of this system.
+void PlanSendSchedule(
+    const Configuration& configuration, const Matchings& matchings, const int minutes,
+    const std::time_t now, SendSchedule& schedule,
+    const std::optional<std::set<std::string>>& gifter_names = std::nullopt) {
+  for (const Participant& gifter : configuration.Participants()) {
+    if ((gifter_names.has_value() && gifter_names->count(gifter.Name()) == 0)
+        || FindGiftees(configuration, matchings, gifter).empty()) {
+      continue;
+    }
+    std::string time_zone{gifter.TimeZone()};
+    if (!time_zone.empty() && !IsKnownTimeZone(time_zone)) {
+      std::cout << "Unknown time zone " << time_zone << " of " << gifter.Name()
+                << "; using the local time zone instead." << std::endl;
+      time_zone.clear();
+    }
+    schedule.Add(gifter.Name(), NextLocalTime(time_zone, minutes, now));
+  }
+}
+
+// Formats a given time in the local time zone of this system, such as "2023-12-18 09:00:00 PST".
+[[nodiscard]] std::string FormatLocalTime(const std::time_t time) {
+  std::tm local{};
+  ::localtime_r(&time, &local);
+  char text[64];
+  const std::size_t length = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S %Z", &local);
+  return std::string{text, length};
+}
+
+// Releases the email messages of a given schedule at their times. Holds them in a timer wheel of
+// one tick per second and sleeps until the next time at which the wheel may release some, so that
+// waiting costs no processor time. Each time the email messages of some gifters are due, marks them
+// as being sent and saves the schedule before calling a given function with their names, and then
+// removes them and saves the schedule again. A restart therefore resumes with the email messages
+// that were not yet released and never sends a released one again. Email messages whose time
+// already passed, such as after a restart, are released at once. Returns once every email message
+// is released. The clock and the sleep can be replaced, such as for testing.
+void RunSendSchedule(
+    SendSchedule& schedule, const std::function<void(const std::set<std::string>&)>& release,
+    const std::function<std::time_t()>& clock = []() { return std::time(nullptr); },
+    const std::function<void(std::time_t)>& sleep_until =
+        [](const std::time_t time) {
+          std::this_thread::sleep_until(std::chrono::system_clock::from_time_t(time));
+        }) {
+  TimerWheel<std::string> wheel{static_cast<uint64_t>(clock())};
+  for (const std::pair<const std::string, std::time_t>& entry : schedule.Entries()) {
+    wheel.Schedule(static_cast<uint64_t>(entry.second), entry.first);
+  }
+
+  while (!wheel.Empty()) {
+    const std::time_t now{clock()};
+    std::vector<std::string> released{wheel.Advance(static_cast<uint64_t>(now))};
+    if (released.empty()) {
+      const std::optional<uint64_t> next{wheel.NextTick()};
+      if (next.has_value() && static_cast<std::time_t>(next.value()) > now) {
+        sleep_until(static_cast<std::time_t>(next.value()));
+      }
+      continue;
+    }
+
+    const std::set<std::string> gifter_names{released.begin(), released.end()};
+    std::cout << "Releasing " << gifter_names.size() << " email messages at "
+              << FormatLocalTime(now) << "." << std::endl;
+    schedule.MarkInFlight(gifter_names);
+    schedule.Save();
+    release(gifter_names);
+    schedule.Remove(gifter_names);
+    schedule.Save();
+
+    const std::optional<uint64_t> next{wheel.NextTick()};
+    if (next.has_value()) {
+      std::cout << schedule.Entries().size() << " email messages remain; the next ones will be "
+                << "released no earlier than "
+                << FormatLocalTime(static_cast<std::time_t>(next.value())) << "." << std::endl;
+    }
+  }
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SEND_SCHEDULER_HPP
@@ -0,0 +1,141 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SHARD_HPP
+#define SECRET_SANTA_SHARD_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace SecretSanta {
+
+// Stable 64-bit hash of a name, computed with the FNV-1a algorithm over its bytes. Unlike
+// std::hash, it is the same on every host, compiler, and run, so that hosts given the same inputs
+// agree on which shard each name belongs to without having to talk to each other.
+[[nodiscard]] constexpr uint64_t StableNameHash(const std::string_view name) noexcept {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char character : name) {
+    hash ^= static_cast<uint8_t>(character);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// One of several disjoint parts into which the gifters are partitioned, so that several hosts can
+// each send the email messages of one part. A gifter belongs to the shard whose index matches the
+// stable hash of the gifter's name modulo the number of shards, so the shards cover every gifter
+// exactly once.
+class Shard {
+public:
+  // Default constructor. Constructs the only shard of a single shard, which holds every gifter.
+  constexpr Shard() noexcept = default;
+
+  // Constructor. Constructs the shard of a given index, starting from 1, out of a given number of
+  // shards. The index must be between 1 and the number of shards.
+  constexpr Shard(const std::size_t index, const std::size_t count) noexcept
+    : index_(index), count_(count) {}
+
+  // Destructor. Destroys this shard.
+  ~Shard() noexcept = default;
+
+  // Copy constructor. Constructs a shard by copying another one.
+  constexpr Shard(const Shard& other) noexcept = default;
+
+  // Move constructor. Constructs a shard by moving another one.
+  constexpr Shard(Shard&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this shard by copying another one.
+  constexpr Shard& operator=(const Shard& other) noexcept = default;
+
+  // Move assignment operator. Assigns this shard by moving another one.
+  constexpr Shard& operator=(Shard&& other) noexcept = default;
+
+  // Index of this shard, starting from 1.
+  [[nodiscard]] constexpr std::size_t Index() const noexcept {
+    return index_;
+  }
+
+  // Number of shards.
+  [[nodiscard]] constexpr std::size_t Count() const noexcept {
+    return count_;
+  }
+
+  // Whether a gifter of a given name belongs to this shard.
+  [[nodiscard]] constexpr bool Contains(const std::string_view name) const noexcept {
+    return count_ <= 1 || StableNameHash(name) % count_ == index_ - 1;
+  }
+
+  // Returns the names among a given set of names that belong to this shard.
+  [[nodiscard]] std::set<std::string> Select(const std::set<std::string>& names) const {
+    std::set<std::string> selected;
+    for (const std::string& name : names) {
+      if (Contains(name)) {
+        selected.insert(selected.cend(), name);
+      }
+    }
+    return selected;
+  }
+
+  // Prints this shard as its index and number of shards separated by a slash, such as "2/3".
+  [[nodiscard]] std::string Print() const {
+    return std::to_string(index_) + "/" + std::to_string(count_);
+  }
+
+  // Whether two shards are the same.
+  [[nodiscard]] constexpr bool operator==(const Shard& other) const noexcept = default;
+
+private:
+  // Index of this shard, starting from 1.
+  std::size_t index_{1};
+
+  // Number of shards.
+  std::size_t count_{1};
+};
+
+// Parses a shard given as its index and number of shards separated by a slash, such as "2/3".
+// Returns no value if the text is not a valid shard, such as when the index is 0 or exceeds the
+// number of shards.
+[[nodiscard]] std::optional<Shard> ParseShard(const std::string_view text) {
+  const std::size_t slash = text.find('/');
+  if (slash == std::string_view::npos) {
+    return std::nullopt;
+  }
+  std::size_t index = 0;
+  std::size_t count = 0;
+  const char* const index_end = text.data() + slash;
+  const char* const count_end = text.data() + text.size();
+  const std::from_chars_result index_result = std::from_chars(text.data(), index_end, index);
+  const std::from_chars_result count_result = std::from_chars(index_end + 1, count_end, count);
+  if (index_result.ec != std::errc{} || index_result.ptr != index_end
+      || count_result.ec != std::errc{} || count_result.ptr != count_end || index == 0
+      || index > count) {
+    return std::nullopt;
+  }
+  return Shard{index, count};
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SHARD_HPP
@@ -0,0 +1,114 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SINK_ARGUMENT_HPP
+#define SECRET_SANTA_SINK_ARGUMENT_HPP
+
+#include <string>
+#include <string_view>
+
+namespace SecretSanta::Sink::Argument {
+
+namespace Key {
+
+// Prints usage instructions and exits. Optional.
+static const std::string Help{"--help"};
+
+// Port on which to listen on the loopback interface. Optional.
+static const std::string Port{"--port"};
+
+// Latency in microseconds after which each command is answered. Optional.
+static const std::string Latency{"--latency"};
+
+// Fraction of the recipients to reject. Optional.
+static const std::string RejectionRate{"--rejection-rate"};
+
+// Fraction of the messages to defer. Optional.
+static const std::string DeferralRate{"--deferral-rate"};
+
+// Maximum number of connections open at once. Optional.
+static const std::string MaximumConnections{"--maximum-connections"};
+
+// Seed value for pseudo-random number generation. Optional.
+static const std::string Seed{"--seed"};
+
+// Directory of the TLS certificate and private key with which every connection is encrypted, which
+// are created along with a certificate authority if they do not exist. Optional.
+static const std::string Tls{"--tls"};
+
+}  // namespace Key
+
+namespace Value {
+
+// Integer number.
+static const std::string Integer{"<integer>"};
+
+// Real number.
+static const std::string Number{"<number>"};
+
+// Filesystem path.
+static const std::string Path{"<path>"};
+
+}  // namespace Value
+
+// Prints usage instructions and exits. Optional.
+[[nodiscard]] std::string_view Help() {
+  return Key::Help;
+}
+
+// Port on which to listen on the loopback interface. Optional.
+[[nodiscard]] std::string Port() {
+  return Key::Port + " " + Value::Integer;
+}
+
+// Latency in microseconds after which each command is answered. Optional.
+[[nodiscard]] std::string Latency() {
+  return Key::Latency + " " + Value::Integer;
+}
+
+// Fraction of the recipients to reject. Optional.
+[[nodiscard]] std::string RejectionRate() {
+  return Key::RejectionRate + " " + Value::Number;
+}
+
+// Fraction of the messages to defer. Optional.
+[[nodiscard]] std::string DeferralRate() {
+  return Key::DeferralRate + " " + Value::Number;
+}
+
+// Maximum number of connections open at once. Optional.
+[[nodiscard]] std::string MaximumConnections() {
+  return Key::MaximumConnections + " " + Value::Integer;
+}
+
+// Seed value for pseudo-random number generation. Optional.
+[[nodiscard]] std::string Seed() {
+  return Key::Seed + " " + Value::Integer;
+}
+
+// Directory of the TLS certificate and private key with which every connection is encrypted, which
+// are created along with a certificate authority if they do not exist. Optional.
+[[nodiscard]] std::string Tls() {
+  return Key::Tls + " " + Value::Path;
+}
+
+}  // namespace SecretSanta::Sink::Argument
+
+#endif  // SECRET_SANTA_SINK_ARGUMENT_HPP
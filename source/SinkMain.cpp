@@ -0,0 +1,85 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include "Certificates.hpp"
+#include "SinkSettings.hpp"
+#include "SmtpSink.hpp"
+#include "Tls.hpp"
+
+int main(int argc, char* argv[]) {
+  const SecretSanta::Sink::Settings settings{argc, argv};
+
+  // Block the interrupt and termination signals before any thread starts, such that they are only
+  // received below.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  std::unique_ptr<SecretSanta::TlsServerContext> tls;
+  if (!settings.TlsDirectory().empty()) {
+    const std::filesystem::path certificate{
+        settings.TlsDirectory() / SecretSanta::CertificateFile::Certificate};
+    const std::filesystem::path private_key{
+        settings.TlsDirectory() / SecretSanta::CertificateFile::PrivateKey};
+    if (!std::filesystem::exists(certificate) || !std::filesystem::exists(private_key)) {
+      if (!SecretSanta::CreateCertificates(settings.TlsDirectory())) {
+        return EXIT_FAILURE;
+      }
+      std::cout << "Created a certificate authority at "
+                << settings.TlsDirectory() / SecretSanta::CertificateFile::Authority
+                << "; mail clients must trust it to connect." << std::endl;
+    }
+    tls = std::make_unique<SecretSanta::TlsServerContext>(certificate, private_key);
+    if (!tls->IsValid()) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  const SecretSanta::SmtpSink sink{settings.Port(),
+                                   settings.Latency(),
+                                   settings.RejectionRate(),
+                                   settings.DeferralRate(),
+                                   settings.MaximumConnections(),
+                                   settings.RandomSeed(),
+                                   tls.get()};
+
+  if (!sink.IsListening()) {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Listening on port " << sink.Port()
+            << " of the loopback interface. Press Ctrl+C to stop." << std::endl;
+
+  int signal = 0;
+  sigwait(&signals, &signal);
+
+  sink.PrintStatistics();
+
+  std::cout << "End of " << SecretSanta::Sink::Program::Title << "." << std::endl;
+
+  return EXIT_SUCCESS;
+}
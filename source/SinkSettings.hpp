@@ -0,0 +1,282 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SINK_SETTINGS_HPP
+#define SECRET_SANTA_SINK_SETTINGS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "SinkArgument.hpp"
+#include "SinkProgram.hpp"
+#include "String.hpp"
+
+namespace SecretSanta::Sink {
+
+// Settings of the Secret Santa Sink program.
+class Settings {
+public:
+  // Default constructor. Constructs settings with default parameters.
+  Settings() = default;
+
+  // Constructor. Constructs settings from command-line arguments.
+  Settings(const int argc, char* argv[]) noexcept {
+    ParseArguments(argc, argv);
+    PrintHeader();
+    PrintCommand();
+    PrintSettings();
+  }
+
+  // Destructor. Destroys this settings object.
+  ~Settings() noexcept = default;
+
+  // Deleted copy constructor.
+  Settings(const Settings& other) = delete;
+
+  // Deleted move constructor.
+  Settings(Settings&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  Settings& operator=(const Settings& other) = delete;
+
+  // Deleted move assignment operator.
+  Settings& operator=(Settings&& other) noexcept = delete;
+
+  // Port on which to listen on the loopback interface.
+  [[nodiscard]] constexpr uint16_t Port() const noexcept {
+    return port_;
+  }
+
+  // Latency after which each command is answered.
+  [[nodiscard]] constexpr std::chrono::microseconds Latency() const noexcept {
+    return latency_;
+  }
+
+  // Fraction of the recipients to reject.
+  [[nodiscard]] constexpr double RejectionRate() const noexcept {
+    return rejection_rate_;
+  }
+
+  // Fraction of the messages to defer.
+  [[nodiscard]] constexpr double DeferralRate() const noexcept {
+    return deferral_rate_;
+  }
+
+  // Maximum number of connections open at once.
+  [[nodiscard]] constexpr std::size_t MaximumConnections() const noexcept {
+    return maximum_connections_;
+  }
+
+  // Seed value for pseudo-random number generation.
+  [[nodiscard]] constexpr uint64_t RandomSeed() const noexcept {
+    return random_seed_;
+  }
+
+  // Directory of the TLS certificate and private key with which every connection is encrypted. If
+  // empty, connections are unencrypted.
+  [[nodiscard]] const std::filesystem::path& TlsDirectory() const noexcept {
+    return tls_directory_;
+  }
+
+private:
+  // Prints the program's header information to the console.
+  void PrintHeader() const {
+    std::cout << Program::Title << std::endl;
+    std::cout << Program::Description << std::endl;
+    std::cout << "Version: " << Program::CompilationDateAndTime << std::endl;
+  }
+
+  // Prints the program's usage information to the console.
+  void PrintUsage() const {
+    const std::string indent{"  "};
+
+    std::cout << "Usage:" << std::endl;
+
+    std::cout << indent << executable_name_ << " [" << Argument::Port() << "] ["
+              << Argument::Latency() << "] [" << Argument::RejectionRate() << "] ["
+              << Argument::DeferralRate() << "] [" << Argument::MaximumConnections() << "] ["
+              << Argument::Seed() << "] [" << Argument::Tls() << "]" << std::endl;
+
+    // Compute the padding length of the argument patterns.
+    const std::size_t length = std::max({
+      Argument::Help().length(),
+      Argument::Port().length(),
+      Argument::Latency().length(),
+      Argument::RejectionRate().length(),
+      Argument::DeferralRate().length(),
+      Argument::MaximumConnections().length(),
+      Argument::Seed().length(),
+      Argument::Tls().length(),
+    });
+
+    std::cout << "Arguments:" << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Help(), length) << indent
+              << "Displays this information and exits." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Port(), length) << indent
+              << "Port on which to listen on the loopback interface. Optional; defaults to 2525."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Latency(), length) << indent
+              << "Latency in microseconds after which each command is answered. Optional."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::RejectionRate(), length) << indent
+              << "Fraction of the recipients to reject, from 0 to 1. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::DeferralRate(), length) << indent
+              << "Fraction of the messages to defer, from 0 to 1. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::MaximumConnections(), length) << indent
+              << "Maximum number of connections open at once. Optional; defaults to 1024."
+              << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Seed(), length) << indent
+              << "Seed value for pseudo-random number generation. Optional." << std::endl;
+
+    std::cout << indent << PadToLength(Argument::Tls(), length) << indent
+              << "Directory of the TLS certificate and key with which every connection is "
+                 "encrypted, which are created if they do not exist. Optional."
+              << std::endl;
+  }
+
+  // Parses the program's command-line arguments.
+  void ParseArguments(const int argc, char* argv[]) {
+    if (argc >= 1) {
+      executable_name_ = argv[0];
+    }
+
+    for (int index = 1; index < argc;) {
+      if (argv[index] == Argument::Key::Help) {
+        PrintHeader();
+        PrintUsage();
+        exit(EXIT_SUCCESS);
+      } else if (argv[index] == Argument::Key::Port && AtLeastOneMore(index, argc)) {
+        port_ = static_cast<uint16_t>(std::strtoul(argv[index + 1], nullptr, 10));
+        index += 2;
+      } else if (argv[index] == Argument::Key::Latency && AtLeastOneMore(index, argc)) {
+        latency_ = std::chrono::microseconds{std::strtoll(argv[index + 1], nullptr, 10)};
+        index += 2;
+      } else if (argv[index] == Argument::Key::RejectionRate && AtLeastOneMore(index, argc)) {
+        rejection_rate_ = std::strtod(argv[index + 1], nullptr);
+        index += 2;
+      } else if (argv[index] == Argument::Key::DeferralRate && AtLeastOneMore(index, argc)) {
+        deferral_rate_ = std::strtod(argv[index + 1], nullptr);
+        index += 2;
+      } else if (argv[index] == Argument::Key::MaximumConnections && AtLeastOneMore(index, argc)) {
+        maximum_connections_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::Seed && AtLeastOneMore(index, argc)) {
+        random_seed_ = std::strtoull(argv[index + 1], nullptr, 10);
+        index += 2;
+      } else if (argv[index] == Argument::Key::Tls && AtLeastOneMore(index, argc)) {
+        tls_directory_ = argv[index + 1];
+        index += 2;
+      } else {
+        PrintHeader();
+        std::cout << "Unrecognized argument: " << argv[index] << std::endl;
+        PrintUsage();
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+  // Returns whether there is at least one more element after the given element index.
+  [[nodiscard]] bool AtLeastOneMore(const int index, const int count) const noexcept {
+    return index + 1 < count;
+  }
+
+  // Prints the command to the console.
+  void PrintCommand() const {
+    std::cout << "Command: " << executable_name_ << " " << Argument::Key::Port << " " << port_
+              << " " << Argument::Key::Latency << " " << latency_.count() << " "
+              << Argument::Key::RejectionRate << " " << rejection_rate_ << " "
+              << Argument::Key::DeferralRate << " " << deferral_rate_ << " "
+              << Argument::Key::MaximumConnections << " " << maximum_connections_ << " "
+              << Argument::Key::Seed << " " << random_seed_
+              << (!tls_directory_.empty() ?
+                      " " + Argument::Key::Tls + " " + tls_directory_.string() :
+                      "")
+              << std::endl;
+  }
+
+  // Prints the settings to the console.
+  void PrintSettings() const {
+    std::cout << "- The sink will listen on port " << port_ << " of the loopback interface."
+              << std::endl;
+
+    if (latency_.count() > 0) {
+      std::cout << "- Each command will be answered after " << latency_.count()
+                << " microseconds." << std::endl;
+    }
+
+    if (rejection_rate_ > 0.0) {
+      std::cout << "- A fraction of " << rejection_rate_ << " of the recipients will be rejected."
+                << std::endl;
+    }
+
+    if (deferral_rate_ > 0.0) {
+      std::cout << "- A fraction of " << deferral_rate_ << " of the messages will be deferred."
+                << std::endl;
+    }
+
+    std::cout << "- At most " << maximum_connections_ << " connections will be open at once."
+              << std::endl;
+
+    if (!tls_directory_.empty()) {
+      std::cout << "- Every connection will be encrypted with TLS using the certificate and key in "
+                << tls_directory_ << "." << std::endl;
+    }
+  }
+
+  // Name of the Secret Santa Sink executable.
+  std::string executable_name_;
+
+  // Port on which to listen on the loopback interface.
+  uint16_t port_{2525};
+
+  // Latency after which each command is answered.
+  std::chrono::microseconds latency_{0};
+
+  // Fraction of the recipients to reject.
+  double rejection_rate_{0.0};
+
+  // Fraction of the messages to defer.
+  double deferral_rate_{0.0};
+
+  // Maximum number of connections open at once.
+  std::size_t maximum_connections_{1024};
+
+  // Seed value for pseudo-random number generation.
+  uint64_t random_seed_{0};
+
+  // Directory of the TLS certificate and private key with which every connection is encrypted. If
+  // empty, connections are unencrypted.
+  std::filesystem::path tls_directory_;
+};
+
+}  // namespace SecretSanta::Sink
+
+#endif  // SECRET_SANTA_SINK_SETTINGS_HPP
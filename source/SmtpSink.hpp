@@ -0,0 +1,394 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SMTP_SINK_HPP
+#define SECRET_SANTA_SMTP_SINK_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "Socket.hpp"
+#include "Tls.hpp"
+
+namespace SecretSanta {
+
+// Local stand-in for a mail server, used for testing and benchmarking the Secret Santa Messenger
+// without sending any real email. Listens on the loopback interface, speaks enough SMTP for a mail
+// client to deliver messages, and discards every message it accepts. Supports command pipelining.
+// Can be configured to answer each command after a fixed latency, to reject a fraction of the
+// recipients or defer a fraction of the messages, and to refuse connections past a limit, which
+// mimics the behavior of a real mail server under load. Optionally encrypts every connection with
+// TLS from its start, as mail servers do on port 465. Serves each connection on its own thread.
+class SmtpSink {
+public:
+  // Constructor. Starts listening on the loopback interface at a given port, or at a port chosen by
+  // the operating system if the given port is 0. Each command is answered after the given latency.
+  // Each recipient is rejected with the given probability, and each message is deferred with the
+  // given probability. Connections past the given maximum number of concurrent connections are
+  // refused. The given random seed makes the injected errors reproducible. If a TLS context is
+  // given, each connection starts with a TLS handshake; the context must outlive this sink.
+  explicit SmtpSink(const uint16_t port = 0,
+                    const std::chrono::microseconds command_latency = std::chrono::microseconds{0},
+                    const double rejection_rate = 0.0, const double deferral_rate = 0.0,
+                    const std::size_t maximum_connection_count = 1024,
+                    const uint64_t random_seed = 0, TlsServerContext* const tls = nullptr)
+    : command_latency_(command_latency), rejection_rate_(std::clamp(rejection_rate, 0.0, 1.0)),
+      deferral_rate_(std::clamp(deferral_rate, 0.0, 1.0)),
+      maximum_connection_count_(maximum_connection_count), random_seed_(random_seed), tls_(tls),
+      listener_(ListenOnLoopback(port)) {
+    if (!listener_.IsOpen()) {
+      std::cout << "Cannot listen on port " << port
+                << " of the loopback interface; please check that the port is not already in use."
+                << std::endl;
+      return;
+    }
+    port_ = listener_.LocalPort();
+    accept_thread_ = std::thread{[this]() { AcceptConnections(); }};
+  }
+
+  // Destructor. Stops listening, closes all connections, and waits for their threads to finish.
+  ~SmtpSink() noexcept {
+    stopping_.store(true);
+    listener_.Shutdown();
+    if (accept_thread_.joinable()) {
+      accept_thread_.join();
+    }
+
+    const std::lock_guard<std::mutex> lock{sessions_mutex_};
+    for (const std::unique_ptr<Session>& session : sessions_) {
+      session->socket.Shutdown();
+    }
+    for (const std::unique_ptr<Session>& session : sessions_) {
+      session->thread.join();
+    }
+  }
+
+  // Deleted copy constructor.
+  SmtpSink(const SmtpSink& other) = delete;
+
+  // Deleted move constructor.
+  SmtpSink(SmtpSink&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  SmtpSink& operator=(const SmtpSink& other) = delete;
+
+  // Deleted move assignment operator.
+  SmtpSink& operator=(SmtpSink&& other) noexcept = delete;
+
+  // Whether this sink is listening for connections.
+  [[nodiscard]] bool IsListening() const noexcept {
+    return port_ != 0;
+  }
+
+  // Port on which this sink listens, or 0 if it is not listening.
+  [[nodiscard]] uint16_t Port() const noexcept {
+    return port_;
+  }
+
+  // Number of messages accepted so far.
+  [[nodiscard]] uint64_t AcceptedMessageCount() const noexcept {
+    return accepted_message_count_.load();
+  }
+
+  // Number of messages deferred so far.
+  [[nodiscard]] uint64_t DeferredMessageCount() const noexcept {
+    return deferred_message_count_.load();
+  }
+
+  // Number of recipients rejected so far.
+  [[nodiscard]] uint64_t RejectedRecipientCount() const noexcept {
+    return rejected_recipient_count_.load();
+  }
+
+  // Number of commands answered so far, not counting the lines of message contents.
+  [[nodiscard]] uint64_t CommandCount() const noexcept {
+    return command_count_.load();
+  }
+
+  // Number of connections accepted so far.
+  [[nodiscard]] uint64_t ConnectionCount() const noexcept {
+    return connection_count_.load();
+  }
+
+  // Number of connections refused so far because too many connections were open at once.
+  [[nodiscard]] uint64_t RefusedConnectionCount() const noexcept {
+    return refused_connection_count_.load();
+  }
+
+  // Largest number of connections that were open at once.
+  [[nodiscard]] std::size_t PeakConnectionCount() const noexcept {
+    return peak_connection_count_.load();
+  }
+
+  // Prints a summary of the activity of this sink to the console.
+  void PrintStatistics() const {
+    std::cout << "Accepted " << AcceptedMessageCount() << " messages, deferred "
+              << DeferredMessageCount() << " messages, and rejected " << RejectedRecipientCount()
+              << " recipients over " << ConnectionCount() << " connections ("
+              << RefusedConnectionCount() << " refused, at most " << PeakConnectionCount()
+              << " open at once) and " << CommandCount() << " commands." << std::endl;
+    if (tls_ != nullptr) {
+      tls_->PrintStatistics();
+    }
+  }
+
+private:
+  // Connection to one mail client, served by its own thread.
+  struct Session {
+    // Socket of the connection.
+    Socket socket;
+
+    // Thread that serves the connection.
+    std::thread thread;
+
+    // Whether the connection has closed and its thread can be joined.
+    std::atomic<bool> finished{false};
+  };
+
+  // Accepts connections until this sink is stopped.
+  void AcceptConnections() {
+    uint64_t session_index = 0;
+    while (!stopping_.load()) {
+      Socket socket{Accept(listener_)};
+      if (!socket.IsOpen()) {
+        break;
+      }
+
+      const std::lock_guard<std::mutex> lock{sessions_mutex_};
+      JoinFinishedSessions();
+
+      if (sessions_.size() >= maximum_connection_count_) {
+        refused_connection_count_.fetch_add(1);
+        // A client that expects a TLS handshake cannot read a reply, so just close the connection.
+        if (tls_ == nullptr) {
+          socket.WriteAll("421 4.7.0 Too many connections, try again later\r\n");
+        }
+        continue;
+      }
+
+      connection_count_.fetch_add(1);
+      std::size_t peak = peak_connection_count_.load();
+      while (sessions_.size() + 1 > peak
+             && !peak_connection_count_.compare_exchange_weak(peak, sessions_.size() + 1)) {}
+
+      sessions_.push_back(std::make_unique<Session>());
+      Session& session = *sessions_.back();
+      session.socket = std::move(socket);
+      session.thread = std::thread{[this, &session, session_index]() {
+        Serve(session.socket, session_index);
+        session.finished.store(true);
+      }};
+      ++session_index;
+    }
+  }
+
+  // Joins and forgets the sessions whose connection has closed. Must be called while holding the
+  // sessions mutex.
+  void JoinFinishedSessions() {
+    for (std::list<std::unique_ptr<Session>>::iterator session = sessions_.begin();
+         session != sessions_.end();) {
+      if ((*session)->finished.load()) {
+        (*session)->thread.join();
+        session = sessions_.erase(session);
+      } else {
+        ++session;
+      }
+    }
+  }
+
+  // Serves one connection until the client quits or the connection closes. Replies are held back
+  // while more pipelined commands are already waiting to be read, and are then written together.
+  void Serve(Socket& socket, const uint64_t session_index) {
+    if (tls_ != nullptr && !tls_->Handshake(socket)) {
+      return;
+    }
+
+    std::mt19937_64 random_generator{random_seed_ + session_index};
+    std::bernoulli_distribution rejection{rejection_rate_};
+    std::bernoulli_distribution deferral{deferral_rate_};
+
+    bool has_sender = false;
+    std::size_t recipient_count = 0;
+    bool reading_contents = false;
+    std::string replies{"220 localhost Secret Santa SMTP sink ready\r\n"};
+
+    while (true) {
+      if (!replies.empty() && !socket.HasBufferedLine()) {
+        if (!socket.WriteAll(replies)) {
+          return;
+        }
+        replies.clear();
+      }
+
+      const std::optional<std::string> line{socket.ReadLine()};
+      if (!line.has_value()) {
+        return;
+      }
+
+      if (reading_contents) {
+        if (*line != ".") {
+          continue;
+        }
+        reading_contents = false;
+        Delay();
+        if (deferral(random_generator)) {
+          deferred_message_count_.fetch_add(1);
+          replies.append("451 4.3.0 Temporarily unable to accept the message\r\n");
+        } else {
+          accepted_message_count_.fetch_add(1);
+          replies.append("250 2.0.0 Message accepted\r\n");
+        }
+        has_sender = false;
+        recipient_count = 0;
+        continue;
+      }
+
+      Delay();
+      const std::string verb{Verb(*line)};
+      if (verb == "EHLO") {
+        replies.append("250-localhost\r\n250-PIPELINING\r\n250-8BITMIME\r\n250 SMTPUTF8\r\n");
+      } else if (verb == "HELO") {
+        replies.append("250 localhost\r\n");
+      } else if (verb == "MAIL") {
+        has_sender = true;
+        recipient_count = 0;
+        replies.append("250 2.1.0 Sender OK\r\n");
+      } else if (verb == "RCPT") {
+        if (!has_sender) {
+          replies.append("503 5.5.1 Sender not yet given\r\n");
+        } else if (rejection(random_generator)) {
+          rejected_recipient_count_.fetch_add(1);
+          replies.append("550 5.1.1 Mailbox unavailable\r\n");
+        } else {
+          ++recipient_count;
+          replies.append("250 2.1.5 Recipient OK\r\n");
+        }
+      } else if (verb == "DATA") {
+        if (recipient_count == 0) {
+          replies.append("554 5.5.1 No valid recipients\r\n");
+        } else {
+          reading_contents = true;
+          replies.append("354 End the message with a line containing only a period\r\n");
+        }
+      } else if (verb == "RSET") {
+        has_sender = false;
+        recipient_count = 0;
+        replies.append("250 2.0.0 OK\r\n");
+      } else if (verb == "NOOP") {
+        replies.append("250 2.0.0 OK\r\n");
+      } else if (verb == "QUIT") {
+        replies.append("221 2.0.0 Bye\r\n");
+        socket.WriteAll(replies);
+        return;
+      } else {
+        replies.append("502 5.5.2 Command not recognized\r\n");
+      }
+    }
+  }
+
+  // Waits for the configured command latency and counts the command.
+  void Delay() {
+    command_count_.fetch_add(1);
+    if (command_latency_.count() > 0) {
+      std::this_thread::sleep_for(command_latency_);
+    }
+  }
+
+  // Returns the verb of a command in upper case, which is its first four characters.
+  [[nodiscard]] static std::string Verb(const std::string& line) {
+    std::string verb{line.substr(0, 4)};
+    for (char& character : verb) {
+      character = static_cast<char>(std::toupper(static_cast<unsigned char>(character)));
+    }
+    return verb;
+  }
+
+  // Latency after which each command is answered.
+  std::chrono::microseconds command_latency_;
+
+  // Probability with which each recipient is rejected.
+  double rejection_rate_;
+
+  // Probability with which each message is deferred.
+  double deferral_rate_;
+
+  // Maximum number of connections open at once.
+  std::size_t maximum_connection_count_;
+
+  // Seed of the random generators that decide which recipients are rejected and which messages are
+  // deferred. Each connection uses this seed plus its index.
+  uint64_t random_seed_;
+
+  // Context from which TLS connections are accepted, or null if connections are unencrypted.
+  TlsServerContext* tls_;
+
+  // Socket on which this sink listens for connections.
+  Socket listener_;
+
+  // Port on which this sink listens, or 0 if it is not listening.
+  uint16_t port_{0};
+
+  // Whether this sink is stopping.
+  std::atomic<bool> stopping_{false};
+
+  // Thread that accepts connections.
+  std::thread accept_thread_;
+
+  // Protects the list of sessions.
+  std::mutex sessions_mutex_;
+
+  // Open connections and connections whose thread has not yet been joined.
+  std::list<std::unique_ptr<Session>> sessions_;
+
+  // Number of messages accepted so far.
+  std::atomic<uint64_t> accepted_message_count_{0};
+
+  // Number of messages deferred so far.
+  std::atomic<uint64_t> deferred_message_count_{0};
+
+  // Number of recipients rejected so far.
+  std::atomic<uint64_t> rejected_recipient_count_{0};
+
+  // Number of commands answered so far.
+  std::atomic<uint64_t> command_count_{0};
+
+  // Number of connections accepted so far.
+  std::atomic<uint64_t> connection_count_{0};
+
+  // Number of connections refused so far.
+  std::atomic<uint64_t> refused_connection_count_{0};
+
+  // Largest number of connections that were open at once.
+  std::atomic<std::size_t> peak_connection_count_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SMTP_SINK_HPP
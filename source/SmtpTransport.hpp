@@ -0,0 +1,429 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SMTP_TRANSPORT_HPP
+#define SECRET_SANTA_SMTP_TRANSPORT_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BoundedQueue.hpp"
+#include "MimeMessage.hpp"
+#include "Socket.hpp"
+#include "Tls.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Reply of a mail server to a command, made of a three-digit code and the text of its last line.
+class SmtpReply {
+public:
+  // Default constructor. Constructs a reply with code 0, which denotes that no reply was received.
+  SmtpReply() = default;
+
+  // Constructor. Constructs a reply from a given code and text.
+  SmtpReply(const int code, std::string text) : code_(code), text_(std::move(text)) {}
+
+  // Destructor. Destroys this reply.
+  ~SmtpReply() noexcept = default;
+
+  // Copy constructor. Constructs a reply by copying another one.
+  SmtpReply(const SmtpReply& other) = default;
+
+  // Move constructor. Constructs a reply by moving another one.
+  SmtpReply(SmtpReply&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this reply by copying another one.
+  SmtpReply& operator=(const SmtpReply& other) = default;
+
+  // Move assignment operator. Assigns this reply by moving another one.
+  SmtpReply& operator=(SmtpReply&& other) noexcept = default;
+
+  // Three-digit code of this reply, or 0 if no reply was received.
+  [[nodiscard]] int Code() const noexcept {
+    return code_;
+  }
+
+  // Text of the last line of this reply, including its code.
+  [[nodiscard]] const std::string& Text() const noexcept {
+    return text_;
+  }
+
+  // Whether this reply denotes success, which includes the request to send the message contents.
+  [[nodiscard]] bool Succeeded() const noexcept {
+    return code_ >= 200 && code_ < 400;
+  }
+
+  // Status of a delivery that fails with this reply. Replies in the 500s are permanent failures,
+  // and all other failures may succeed if attempted again later.
+  [[nodiscard]] DeliveryStatus FailureStatus() const noexcept {
+    return code_ >= 500 && code_ < 600 ? DeliveryStatus::PermanentFailure :
+                                         DeliveryStatus::TransientFailure;
+  }
+
+private:
+  // Three-digit code of this reply, or 0 if no reply was received.
+  int code_{0};
+
+  // Text of the last line of this reply.
+  std::string text_;
+};
+
+// Reads one reply from a mail server. A reply spans several lines when all but its last line have a
+// hyphen after the code. Returns a reply with code 0 if the connection closes or the reply is
+// malformed. Optionally collects the text of every line, which lists the extensions supported by
+// the server in the reply to the EHLO command.
+[[nodiscard]] SmtpReply ReadSmtpReply(
+    Socket& socket, std::vector<std::string>* const lines = nullptr) {
+  while (true) {
+    const std::optional<std::string> line{socket.ReadLine()};
+    if (!line.has_value() || line->size() < 3) {
+      return {};
+    }
+    int code = 0;
+    for (std::size_t index = 0; index < 3; ++index) {
+      if ((*line)[index] < '0' || (*line)[index] > '9') {
+        return {};
+      }
+      code = code * 10 + ((*line)[index] - '0');
+    }
+    if (lines != nullptr) {
+      lines->push_back(line->size() > 4 ? line->substr(4) : std::string{});
+    }
+    if (line->size() == 3 || (*line)[3] != '-') {
+      return {code, *line};
+    }
+  }
+}
+
+// Composes the contents of an email message as sent after the DATA command: a MIME message whose
+// header fields and body are encoded as 7-bit ASCII with every line terminated by a carriage return
+// and line feed. Lines that start with a period get a second period, so that no line of the body
+// ends the contents early. Ends with the line containing only a period that terminates the
+// contents.
+[[nodiscard]] std::string ComposeSmtpContents(
+    const std::string& sender, const EmailMessage& message) {
+  const std::string composed{
+      MimeMessage{{{"From", sender}, {"To", message.Recipient()}, {"Subject", message.Subject()}},
+                  message}
+          .Compose()};
+
+  std::string contents;
+  contents.reserve(composed.size() + composed.size() / 64 + 8);
+  bool start_of_line = true;
+  for (const char character : composed) {
+    if (start_of_line && character == '.') {
+      contents.push_back('.');
+    }
+    contents.push_back(character);
+    start_of_line = character == '\n';
+  }
+  if (!start_of_line) {
+    contents.append("\r\n");
+  }
+
+  contents.append(".\r\n");
+  return contents;
+}
+
+// Checks whether the mail server at a given host and port is reachable: connects to it, performs a
+// TLS handshake if a TLS context is given, waits for its greeting, and ends the session.
+[[nodiscard]] bool ProbeSmtpServer(
+    const std::string& host, const uint16_t port, TlsClientContext* const tls = nullptr) {
+  Socket socket{ConnectTo(host, port)};
+  if (!socket.IsOpen() || (tls != nullptr && !tls->Handshake(socket, host))) {
+    return false;
+  }
+  const bool greeted = ReadSmtpReply(socket).Code() == 220;
+  if (greeted && socket.WriteAll("QUIT\r\n")) {
+    static_cast<void>(ReadSmtpReply(socket));
+  }
+  return greeted;
+}
+
+// Transport that delivers email messages directly to a mail server over SMTP. Keeps a fixed number
+// of connections open, each served by its own thread, and spreads the email messages among them
+// through a bounded queue. When the server supports pipelining, each message takes two round trips:
+// one for the envelope and one for the contents. Optionally encrypts every connection with TLS from
+// its start, as mail servers do on port 465, and optionally replaces each connection after a number
+// of messages, as mail servers that limit the number of messages per connection require.
+class SmtpTransport : public Transport {
+public:
+  // Constructor. Constructs a transport that delivers email messages from a given sender address to
+  // the mail server at a given host and port over a given number of connections. If a TLS context
+  // is given, each connection starts with a TLS handshake; the context must outlive this transport
+  // and may be shared with other transports to the same mail server, so that they resume each
+  // other's sessions. If a number of messages per connection is given, each connection is closed
+  // and replaced once it has delivered that many messages.
+  SmtpTransport(std::string host, const uint16_t port, std::string sender,
+                const std::size_t connection_count = 1, TlsClientContext* const tls = nullptr,
+                const std::size_t messages_per_connection = 0)
+    : host_(std::move(host)), port_(port), sender_(std::move(sender)), tls_(tls),
+      messages_per_connection_(messages_per_connection),
+      jobs_(2 * std::max<std::size_t>(connection_count, 1)) {
+    for (std::size_t index = 0; index < std::max<std::size_t>(connection_count, 1); ++index) {
+      workers_.emplace_back([this]() { Work(); });
+    }
+  }
+
+  // Destructor. Waits for all email messages to be delivered and closes all connections.
+  ~SmtpTransport() noexcept override {
+    jobs_.Close();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  // Deleted copy constructor.
+  SmtpTransport(const SmtpTransport& other) = delete;
+
+  // Deleted move constructor.
+  SmtpTransport(SmtpTransport&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  SmtpTransport& operator=(const SmtpTransport& other) = delete;
+
+  // Deleted move assignment operator.
+  SmtpTransport& operator=(SmtpTransport&& other) noexcept = delete;
+
+  [[nodiscard]] std::string Name() const override {
+    return std::string{tls_ != nullptr ? "SMTPS" : "SMTP"} + " (" + host_ + ":"
+           + std::to_string(port_) + ", " + std::to_string(workers_.size()) + " connections)";
+  }
+
+  void Send(EmailMessage message, Completion completion) override {
+    {
+      const std::lock_guard<std::mutex> lock{pending_mutex_};
+      ++pending_count_;
+    }
+    jobs_.Push({std::move(message), std::move(completion)});
+  }
+
+  void Flush() override {
+    std::unique_lock<std::mutex> lock{pending_mutex_};
+    pending_condition_.wait(lock, [this]() { return pending_count_ == 0; });
+  }
+
+private:
+  // Connection to the mail server, along with whether the server supports pipelining.
+  struct Connection {
+    // Socket of the connection, which is closed until the connection is first needed.
+    Socket socket;
+
+    // Whether the mail server supports pipelining.
+    bool pipelining{false};
+
+    // Number of messages delivered over the connection since it was opened.
+    std::size_t message_count{0};
+  };
+
+  // Delivers email messages over one connection until the queue of jobs is closed.
+  void Work() {
+    Connection connection;
+    while (std::optional<std::pair<EmailMessage, Completion>> job = jobs_.Pop()) {
+      const Delivery delivery{Deliver(connection, job->first)};
+      job->second(job->first, delivery);
+
+      if (messages_per_connection_ > 0 && connection.socket.IsOpen()
+          && ++connection.message_count >= messages_per_connection_) {
+        Quit(connection);
+      }
+
+      const std::lock_guard<std::mutex> lock{pending_mutex_};
+      if (--pending_count_ == 0) {
+        pending_condition_.notify_all();
+      }
+    }
+    if (connection.socket.IsOpen()) {
+      Quit(connection);
+    }
+  }
+
+  // Ends the session with the mail server and closes the connection.
+  static void Quit(Connection& connection) {
+    connection.socket.WriteAll("QUIT\r\n");
+    static_cast<void>(ReadSmtpReply(connection.socket));
+    connection.socket.Close();
+  }
+
+  // Opens a connection to the mail server and greets it. Returns an unsuccessful delivery if this
+  // fails, or no value if the connection is ready.
+  [[nodiscard]] std::optional<Delivery> Connect(Connection& connection) const {
+    connection.socket = ConnectTo(host_, port_);
+    connection.message_count = 0;
+    if (!connection.socket.IsOpen()) {
+      return Delivery{DeliveryStatus::TransientFailure,
+                      "Could not connect to " + host_ + ":" + std::to_string(port_) + "."};
+    }
+
+    if (tls_ != nullptr && !tls_->Handshake(connection.socket, host_)) {
+      connection.socket.Close();
+      return Delivery{DeliveryStatus::TransientFailure,
+                      "Could not establish a TLS connection with " + host_ + ":"
+                          + std::to_string(port_) + "."};
+    }
+
+    const SmtpReply greeting{ReadSmtpReply(connection.socket)};
+    if (greeting.Code() != 220) {
+      connection.socket.Close();
+      return Delivery{DeliveryStatus::TransientFailure,
+                      "The mail server refused the connection: " + greeting.Text()};
+    }
+
+    std::vector<std::string> extensions;
+    if (!connection.socket.WriteAll("EHLO localhost\r\n")) {
+      connection.socket.Close();
+      return Delivery{DeliveryStatus::TransientFailure, "Lost the connection to the mail server."};
+    }
+    const SmtpReply hello{ReadSmtpReply(connection.socket, &extensions)};
+    if (hello.Code() != 250) {
+      connection.socket.Close();
+      return Delivery{DeliveryStatus::TransientFailure,
+                      "The mail server did not accept the greeting: " + hello.Text()};
+    }
+
+    connection.pipelining = false;
+    for (const std::string& extension : extensions) {
+      if (extension == "PIPELINING") {
+        connection.pipelining = true;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Delivers one email message over a connection, opening the connection first if needed. Closes
+  // the connection if it is lost, so that the next email message opens a new one.
+  [[nodiscard]] Delivery Deliver(Connection& connection, const EmailMessage& message) const {
+    if (!connection.socket.IsOpen()) {
+      const std::optional<Delivery> failure{Connect(connection)};
+      if (failure.has_value()) {
+        return failure.value();
+      }
+    }
+
+    const std::string mail{"MAIL FROM:<" + sender_ + ">\r\n"};
+    const std::string recipient{"RCPT TO:<" + message.Recipient() + ">\r\n"};
+    const std::string data{"DATA\r\n"};
+
+    SmtpReply mail_reply;
+    SmtpReply recipient_reply;
+    SmtpReply data_reply;
+    if (connection.pipelining) {
+      // Send the whole envelope at once and then read the three replies.
+      if (!connection.socket.WriteAll(mail + recipient + data)) {
+        return LoseConnection(connection);
+      }
+      mail_reply = ReadSmtpReply(connection.socket);
+      recipient_reply = ReadSmtpReply(connection.socket);
+      data_reply = ReadSmtpReply(connection.socket);
+      if (mail_reply.Code() == 0 || recipient_reply.Code() == 0 || data_reply.Code() == 0) {
+        return LoseConnection(connection);
+      }
+    } else {
+      // Send each command of the envelope only once the previous one succeeded.
+      for (const std::pair<const std::string*, SmtpReply*>& command_and_reply :
+           {std::pair<const std::string*, SmtpReply*>{&mail, &mail_reply},
+            std::pair<const std::string*, SmtpReply*>{&recipient, &recipient_reply},
+            std::pair<const std::string*, SmtpReply*>{&data, &data_reply}}) {
+        if (!connection.socket.WriteAll(*command_and_reply.first)) {
+          return LoseConnection(connection);
+        }
+        *command_and_reply.second = ReadSmtpReply(connection.socket);
+        if (command_and_reply.second->Code() == 0) {
+          return LoseConnection(connection);
+        }
+        if (!command_and_reply.second->Succeeded()) {
+          break;
+        }
+      }
+    }
+
+    if (data_reply.Code() == 354) {
+      if (!connection.socket.WriteAll(ComposeSmtpContents(sender_, message))) {
+        return LoseConnection(connection);
+      }
+      const SmtpReply contents_reply{ReadSmtpReply(connection.socket)};
+      if (contents_reply.Code() == 0) {
+        return LoseConnection(connection);
+      }
+      if (contents_reply.Succeeded()) {
+        return Delivery{DeliveryStatus::Delivered, contents_reply.Text()};
+      }
+      return Delivery{contents_reply.FailureStatus(), contents_reply.Text()};
+    }
+
+    // The envelope failed, so reset the transaction before the next email message and report the
+    // first failure.
+    const SmtpReply& failure =
+        !mail_reply.Succeeded() ? mail_reply :
+                                  (!recipient_reply.Succeeded() ? recipient_reply : data_reply);
+    if (!connection.socket.WriteAll("RSET\r\n")
+        || ReadSmtpReply(connection.socket).Code() == 0) {
+      connection.socket.Close();
+    }
+    return Delivery{failure.FailureStatus(), failure.Text()};
+  }
+
+  // Closes a lost connection and returns the corresponding unsuccessful delivery.
+  [[nodiscard]] static Delivery LoseConnection(Connection& connection) {
+    connection.socket.Close();
+    return Delivery{DeliveryStatus::TransientFailure, "Lost the connection to the mail server."};
+  }
+
+  // Host name or address of the mail server.
+  std::string host_;
+
+  // Port of the mail server.
+  uint16_t port_;
+
+  // Email address from which email messages are sent.
+  std::string sender_;
+
+  // Context from which TLS connections are established, or null if connections are unencrypted.
+  TlsClientContext* tls_;
+
+  // Number of messages after which each connection is replaced, or 0 if connections are kept open.
+  std::size_t messages_per_connection_;
+
+  // Email messages waiting to be delivered, along with their completion functions.
+  BoundedQueue<std::pair<EmailMessage, Completion>> jobs_;
+
+  // Threads that each deliver email messages over one connection.
+  std::vector<std::thread> workers_;
+
+  // Protects the number of email messages whose delivery has not yet completed.
+  std::mutex pending_mutex_;
+
+  // Notified when all deliveries have completed.
+  std::condition_variable pending_condition_;
+
+  // Number of email messages whose delivery has not yet completed.
+  std::size_t pending_count_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SMTP_TRANSPORT_HPP
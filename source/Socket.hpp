@@ -0,0 +1,412 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SOCKET_HPP
+#define SECRET_SANTA_SOCKET_HPP
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/ssl.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+namespace SecretSanta {
+
+// Connected or listening TCP or Unix domain socket. Owns its file descriptor and closes it when
+// destroyed. Reads are buffered so that text lines can be read one at a time, which is how mail
+// servers and clients talk to each other. Once a TLS connection is attached, all reads and writes
+// go through it.
+class Socket {
+public:
+  // Default constructor. Constructs a closed socket.
+  Socket() = default;
+
+  // Constructor. Constructs a socket that takes ownership of a given file descriptor.
+  explicit Socket(const int descriptor) noexcept : descriptor_(descriptor) {}
+
+  // Destructor. Closes this socket.
+  ~Socket() noexcept {
+    Close();
+  }
+
+  // Deleted copy constructor.
+  Socket(const Socket& other) = delete;
+
+  // Move constructor. Constructs a socket by taking ownership of another one's file descriptor.
+  Socket(Socket&& other) noexcept
+    : descriptor_(std::exchange(other.descriptor_, -1)), tls_(std::exchange(other.tls_, nullptr)),
+      tls_failed_(std::exchange(other.tls_failed_, false)), buffer_(std::move(other.buffer_)),
+      buffer_position_(std::exchange(other.buffer_position_, 0)) {}
+
+  // Deleted copy assignment operator.
+  Socket& operator=(const Socket& other) = delete;
+
+  // Move assignment operator. Closes this socket and takes ownership of another one's file
+  // descriptor.
+  Socket& operator=(Socket&& other) noexcept {
+    if (this != &other) {
+      Close();
+      descriptor_ = std::exchange(other.descriptor_, -1);
+      tls_ = std::exchange(other.tls_, nullptr);
+      tls_failed_ = std::exchange(other.tls_failed_, false);
+      buffer_ = std::move(other.buffer_);
+      buffer_position_ = std::exchange(other.buffer_position_, 0);
+    }
+    return *this;
+  }
+
+  // File descriptor of this socket, or -1 if this socket is closed.
+  [[nodiscard]] int Descriptor() const noexcept {
+    return descriptor_;
+  }
+
+  // Whether this socket is open.
+  [[nodiscard]] bool IsOpen() const noexcept {
+    return descriptor_ >= 0;
+  }
+
+  // Whether a TLS connection is attached to this socket.
+  [[nodiscard]] bool IsTls() const noexcept {
+    return tls_ != nullptr;
+  }
+
+  // Takes ownership of a TLS connection whose handshake completed over this socket. All subsequent
+  // reads and writes are encrypted.
+  void AttachTls(SSL* const tls) noexcept {
+    tls_ = tls;
+    tls_failed_ = false;
+  }
+
+  // Closes this socket, first notifying the peer that the TLS connection is closing if one is
+  // attached. Does nothing if this socket is already closed.
+  void Close() noexcept {
+    if (tls_ != nullptr) {
+      // A TLS connection that is not closed cleanly cannot be resumed with TLS 1.2, but one that
+      // failed must not be closed cleanly.
+      if (!tls_failed_) {
+        SSL_shutdown(tls_);
+      }
+      SSL_free(tls_);
+      tls_ = nullptr;
+      tls_failed_ = false;
+    }
+    if (descriptor_ >= 0) {
+      ::close(descriptor_);
+      descriptor_ = -1;
+    }
+    buffer_.clear();
+    buffer_position_ = 0;
+  }
+
+  // Shuts down both directions of this socket without closing it, which wakes up any thread that is
+  // blocked reading from or accepting on this socket.
+  void Shutdown() const noexcept {
+    if (descriptor_ >= 0) {
+      ::shutdown(descriptor_, SHUT_RDWR);
+    }
+  }
+
+  // Local port to which this socket is bound, or 0 if it is not bound.
+  [[nodiscard]] uint16_t LocalPort() const noexcept {
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    if (::getsockname(descriptor_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+      return 0;
+    }
+    return ntohs(address.sin_port);
+  }
+
+  // Writes all of the given data, retrying partial writes. Returns whether all of the data was
+  // written.
+  bool WriteAll(std::string_view data) const noexcept {
+    if (tls_ != nullptr) {
+      while (!data.empty()) {
+        const int written = SSL_write(tls_, data.data(), static_cast<int>(data.size()));
+        if (written <= 0) {
+          tls_failed_ = true;
+          return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+      }
+      return true;
+    }
+    while (!data.empty()) {
+      const ssize_t written = ::send(descriptor_, data.data(), data.size(), MSG_NOSIGNAL);
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      if (written <= 0) {
+        return false;
+      }
+      data.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+  }
+
+  // Reads one line terminated by a line feed and returns it without its line terminator, which may
+  // be either a carriage return and line feed or a lone line feed. Returns no value once the peer
+  // closes the connection or an error occurs.
+  std::optional<std::string> ReadLine() {
+    while (true) {
+      const std::size_t line_feed = buffer_.find('\n', buffer_position_);
+      if (line_feed != std::string::npos) {
+        std::size_t end = line_feed;
+        if (end > buffer_position_ && buffer_[end - 1] == '\r') {
+          --end;
+        }
+        std::string line{buffer_, buffer_position_, end - buffer_position_};
+        buffer_position_ = line_feed + 1;
+        return line;
+      }
+      if (!Fill()) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  // Whether a complete line has already been received and can be read without waiting. A peer that
+  // pipelines its commands sends several lines at once.
+  [[nodiscard]] bool HasBufferedLine() const noexcept {
+    return buffer_.find('\n', buffer_position_) != std::string::npos;
+  }
+
+private:
+  // Reads more data from this socket into the read buffer. Returns whether any data was read.
+  bool Fill() {
+    if (buffer_position_ > 0) {
+      buffer_.erase(0, buffer_position_);
+      buffer_position_ = 0;
+    }
+    char chunk[16384];
+    if (tls_ != nullptr) {
+      const int count = SSL_read(tls_, chunk, sizeof(chunk));
+      if (count <= 0) {
+        tls_failed_ = SSL_get_error(tls_, count) != SSL_ERROR_ZERO_RETURN;
+        return false;
+      }
+      buffer_.append(chunk, static_cast<std::size_t>(count));
+      return true;
+    }
+    while (true) {
+      const ssize_t count = ::recv(descriptor_, chunk, sizeof(chunk), 0);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return false;
+      }
+      buffer_.append(chunk, static_cast<std::size_t>(count));
+      return true;
+    }
+  }
+
+  // File descriptor of this socket, or -1 if this socket is closed.
+  int descriptor_{-1};
+
+  // TLS connection attached to this socket, or null if data is sent and received unencrypted.
+  SSL* tls_{nullptr};
+
+  // Whether the attached TLS connection failed, in which case it must not be closed cleanly.
+  mutable bool tls_failed_{false};
+
+  // Data received but not yet read.
+  std::string buffer_;
+
+  // Position in the read buffer at which the unread data starts.
+  std::size_t buffer_position_{0};
+};
+
+// Parses a host and port of the form "host:port". Returns no value if the text is not of this form
+// or the port is not a valid port number.
+[[nodiscard]] std::optional<std::pair<std::string, uint16_t>> ParseHostAndPort(
+    const std::string& text) {
+  const std::size_t colon = text.rfind(':');
+  if (colon == std::string::npos || colon == 0 || colon + 1 == text.size()) {
+    return std::nullopt;
+  }
+
+  uint32_t port = 0;
+  for (std::size_t index = colon + 1; index < text.size(); ++index) {
+    if (text[index] < '0' || text[index] > '9') {
+      return std::nullopt;
+    }
+    port = port * 10 + static_cast<uint32_t>(text[index] - '0');
+    if (port > 65535) {
+      return std::nullopt;
+    }
+  }
+
+  if (port == 0) {
+    return std::nullopt;
+  }
+
+  return std::pair<std::string, uint16_t>{text.substr(0, colon), static_cast<uint16_t>(port)};
+}
+
+// Connects to a given host and port over TCP. Returns a closed socket if the connection fails.
+[[nodiscard]] Socket ConnectTo(const std::string& host, const uint16_t port) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  addrinfo* addresses = nullptr;
+  if (::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+    return Socket{};
+  }
+
+  Socket socket;
+  for (const addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+    socket = Socket{::socket(address->ai_family, address->ai_socktype, address->ai_protocol)};
+    if (!socket.IsOpen()) {
+      continue;
+    }
+    if (::connect(socket.Descriptor(), address->ai_addr, address->ai_addrlen) == 0) {
+      // Commands are small and are sent in bursts, so do not delay them.
+      const int enabled = 1;
+      ::setsockopt(socket.Descriptor(), IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+      break;
+    }
+    socket.Close();
+  }
+
+  ::freeaddrinfo(addresses);
+  return socket;
+}
+
+// Listens for TCP connections on the loopback interface at a given port, or at a port chosen by the
+// operating system if the given port is 0. Returns a closed socket if the port cannot be bound.
+[[nodiscard]] Socket ListenOnLoopback(const uint16_t port, const int backlog = 1024) {
+  Socket socket{::socket(AF_INET, SOCK_STREAM, 0)};
+  if (!socket.IsOpen()) {
+    return socket;
+  }
+
+  const int enabled = 1;
+  ::setsockopt(socket.Descriptor(), SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+
+  if (::bind(socket.Descriptor(), reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+          != 0
+      || ::listen(socket.Descriptor(), backlog) != 0) {
+    socket.Close();
+  }
+
+  return socket;
+}
+
+// Fills the address of a Unix domain socket at a given filesystem path. Returns whether the path
+// fits in the address.
+[[nodiscard]] bool MakeUnixAddress(const std::filesystem::path& path, sockaddr_un& address) {
+  const std::string text = path.string();
+  if (text.empty() || text.size() >= sizeof(address.sun_path)) {
+    return false;
+  }
+  address = sockaddr_un{};
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, text.data(), text.size());
+  return true;
+}
+
+// Connects to a Unix domain socket at a given filesystem path. Returns a closed socket if the
+// connection fails.
+[[nodiscard]] Socket ConnectToUnixSocket(const std::filesystem::path& path) {
+  sockaddr_un address{};
+  if (!MakeUnixAddress(path, address)) {
+    return Socket{};
+  }
+
+  Socket socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  if (socket.IsOpen()
+      && ::connect(socket.Descriptor(), reinterpret_cast<const sockaddr*>(&address),
+                   sizeof(address))
+             != 0) {
+    socket.Close();
+  }
+  return socket;
+}
+
+// Listens for connections on a Unix domain socket at a given filesystem path. A socket file left at
+// that path by an earlier process is replaced, but any other kind of file is left alone. Only the
+// owner of the socket file can connect to it. Returns a closed socket if the path is too long or
+// cannot be bound.
+[[nodiscard]] Socket ListenOnUnixSocket(
+    const std::filesystem::path& path, const int backlog = 1024) {
+  sockaddr_un address{};
+  if (!MakeUnixAddress(path, address)) {
+    return Socket{};
+  }
+
+  Socket socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  if (!socket.IsOpen()) {
+    return socket;
+  }
+
+  if (std::filesystem::is_socket(path)) {
+    std::filesystem::remove(path);
+  }
+
+  // No client can connect until the socket listens, so restricting the permissions of the socket
+  // file in between leaves no window in which another user could connect.
+  if (::bind(socket.Descriptor(), reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+          != 0
+      || ::chmod(address.sun_path, S_IRUSR | S_IWUSR) != 0
+      || ::listen(socket.Descriptor(), backlog) != 0) {
+    socket.Close();
+  }
+
+  return socket;
+}
+
+// Accepts a connection on a listening socket. Returns a closed socket once the listening socket is
+// shut down or an error occurs.
+[[nodiscard]] Socket Accept(const Socket& listener) {
+  while (true) {
+    const int descriptor = ::accept(listener.Descriptor(), nullptr, nullptr);
+    if (descriptor < 0 && (errno == EINTR || errno == ECONNABORTED)) {
+      continue;
+    }
+    if (descriptor >= 0) {
+      const int enabled = 1;
+      ::setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+    }
+    return Socket{descriptor};
+  }
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SOCKET_HPP
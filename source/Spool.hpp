@@ -0,0 +1,255 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SPOOL_HPP
+#define SECRET_SANTA_SPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "EmailMessage.hpp"
+#include "MimeMessage.hpp"
+
+namespace SecretSanta {
+
+// Name of the header field of a spooled email message that holds the name of its gifter.
+static const std::string GifterHeaderField{"X-Secret-Santa-Gifter"};
+
+// Formats a given time as the date of an email message, such as "Mon, 18 Dec 2023 14:00:00 -0800".
+[[nodiscard]] std::string FormatEmailDate(const std::time_t time) {
+  std::tm local{};
+  ::localtime_r(&time, &local);
+  char text[64];
+  const std::size_t length = std::strftime(text, sizeof(text), "%a, %d %b %Y %H:%M:%S %z", &local);
+  return std::string{text, length};
+}
+
+// Composes an email message as an RFC 5322 message file: a MIME message whose header fields and
+// body are encoded as 7-bit ASCII with every line terminated by a carriage return and line feed.
+// The name of the gifter is kept in a header field of its own so that the email message can be read
+// back from the file.
+[[nodiscard]] std::string ComposeMessageFile(
+    const std::string& sender, const EmailMessage& message, const std::string& date) {
+  return MimeMessage{{{"Date", date},
+                      {"From", sender},
+                      {"To", message.Recipient()},
+                      {"Subject", message.Subject()},
+                      {GifterHeaderField, message.GifterName()}},
+                     message}
+      .Compose();
+}
+
+// Reads an email message back from the contents of an RFC 5322 message file composed by
+// ComposeMessageFile. Header field names are matched regardless of case, folded header fields are
+// unfolded, and encoded header fields and bodies are decoded. Returns no value if the file has no
+// recipient.
+[[nodiscard]] std::optional<EmailMessage> ParseMessageFile(const std::string& contents) {
+  const std::optional<MimeMessage> mime{MimeMessage::Parse(contents)};
+  if (!mime.has_value() || mime->HeaderField("To").empty()) {
+    return std::nullopt;
+  }
+  EmailMessage message{mime->HeaderField(GifterHeaderField), mime->HeaderField("To"),
+                       mime->HeaderField("Subject"), mime->Text()};
+  message.SetHtml(mime->Html());
+  for (const std::shared_ptr<const EmailAttachment>& attachment : mime->Attachments()) {
+    message.Attach(attachment);
+  }
+  return message;
+}
+
+// Name of the spool file of a given email message: its recipient email address, with every
+// character other than letters, digits, periods, hyphens, underscores, plus signs, and at signs
+// replaced by an underscore, followed by the ".eml" extension. Each gifter gets one file, so
+// spooling the same email messages again replaces their files rather than adding new ones.
+[[nodiscard]] std::string SpoolFileName(const EmailMessage& message) {
+  std::string name{message.Recipient()};
+  for (char& character : name) {
+    if (std::isalnum(static_cast<unsigned char>(character)) == 0 && character != '.'
+        && character != '-' && character != '_' && character != '+' && character != '@') {
+      character = '_';
+    }
+  }
+  if (name.empty() || name.front() == '.') {
+    name.insert(name.begin(), '_');
+  }
+  return name + ".eml";
+}
+
+// Directory of email message files laid out as a Maildir: each file is first written in the "tmp"
+// subdirectory and then renamed into the "new" subdirectory, so that a reader of "new" never sees a
+// partially written file, even if the writer is interrupted. Once an email message is sent, its
+// file is moved into the "cur" subdirectory, so that sending the spool again only sends the email
+// messages that were not yet sent.
+class Spool {
+public:
+  // Constructor. Constructs a spool in a given directory. Does not create the directory.
+  explicit Spool(std::filesystem::path directory)
+    : directory_(std::move(directory)), temporary_(directory_ / "tmp"), new_(directory_ / "new"),
+      current_(directory_ / "cur") {}
+
+  // Destructor. Destroys this spool. Leaves its files in place.
+  ~Spool() noexcept = default;
+
+  // Copy constructor. Constructs a spool by copying another one.
+  Spool(const Spool& other) = default;
+
+  // Move constructor. Constructs a spool by moving another one.
+  Spool(Spool&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this spool by copying another one.
+  Spool& operator=(const Spool& other) = default;
+
+  // Move assignment operator. Assigns this spool by moving another one.
+  Spool& operator=(Spool&& other) noexcept = default;
+
+  // Directory of this spool.
+  [[nodiscard]] const std::filesystem::path& Directory() const noexcept {
+    return directory_;
+  }
+
+  // Creates the directory of this spool and its subdirectories if they do not exist. Returns
+  // whether they exist afterwards; prints an error message if not.
+  [[nodiscard]] bool Create() const {
+    std::error_code error;
+    for (const std::filesystem::path& directory : {temporary_, new_, current_}) {
+      std::filesystem::create_directories(directory, error);
+      if (error) {
+        std::cout << "Could not create the spool directory " << directory << ": "
+                  << error.message() << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Writes a file of a given name with given contents into the "new" subdirectory. Writes it into
+  // the "tmp" subdirectory first and then renames it, which replaces any file of the same name
+  // atomically. The file is readable only by its owner, since it reveals a giftee. Returns an
+  // empty string on success or a description of the error on failure.
+  [[nodiscard]] std::string Write(const std::string& name, const std::string_view contents) const {
+    static std::atomic<uint64_t> counter{0};
+    const std::filesystem::path temporary{temporary_ / (name + "." + std::to_string(::getpid())
+                                                        + "." + std::to_string(counter++))};
+
+    const int descriptor =
+        ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (descriptor < 0) {
+      return "Could not create " + temporary.string() + ": " + std::strerror(errno);
+    }
+    std::size_t written = 0;
+    while (written < contents.size()) {
+      const ssize_t result =
+          ::write(descriptor, contents.data() + written, contents.size() - written);
+      if (result < 0 && errno == EINTR) {
+        continue;
+      }
+      if (result <= 0) {
+        const std::string error{std::strerror(errno)};
+        ::close(descriptor);
+        ::unlink(temporary.c_str());
+        return "Could not write " + temporary.string() + ": " + error;
+      }
+      written += static_cast<std::size_t>(result);
+    }
+    if (::close(descriptor) != 0) {
+      const std::string error{std::strerror(errno)};
+      ::unlink(temporary.c_str());
+      return "Could not write " + temporary.string() + ": " + error;
+    }
+
+    const std::filesystem::path destination{new_ / name};
+    if (::rename(temporary.c_str(), destination.c_str()) != 0) {
+      const std::string error{std::strerror(errno)};
+      ::unlink(temporary.c_str());
+      return "Could not rename " + temporary.string() + " to " + destination.string() + ": "
+             + error;
+    }
+    return {};
+  }
+
+  // Paths of the files in the "new" subdirectory, which are waiting to be sent, sorted by name.
+  [[nodiscard]] std::vector<std::filesystem::path> Pending() const {
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (std::filesystem::directory_iterator entry{new_, error};
+         !error && entry != std::filesystem::directory_iterator{}; entry.increment(error)) {
+      if (entry->is_regular_file(error)) {
+        files.push_back(entry->path());
+      }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+  }
+
+  // Reads the email message of a given file. Returns no value if the file cannot be read or holds
+  // no email message.
+  [[nodiscard]] static std::optional<EmailMessage> Read(const std::filesystem::path& file) {
+    std::ifstream stream{file, std::ios::binary};
+    if (!stream) {
+      return std::nullopt;
+    }
+    const std::string contents{
+        std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+    return ParseMessageFile(contents);
+  }
+
+  // Moves a given file from the "new" subdirectory into the "cur" subdirectory once its email
+  // message is sent. Returns whether the file was moved.
+  bool MarkSent(const std::filesystem::path& file) const {
+    const std::filesystem::path destination{current_ / file.filename()};
+    return ::rename(file.c_str(), destination.c_str()) == 0;
+  }
+
+private:
+  // Directory of this spool.
+  std::filesystem::path directory_;
+
+  // Subdirectory in which files are written before they are renamed into the "new" subdirectory.
+  std::filesystem::path temporary_;
+
+  // Subdirectory of the files whose email messages are waiting to be sent.
+  std::filesystem::path new_;
+
+  // Subdirectory of the files whose email messages were sent.
+  std::filesystem::path current_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SPOOL_HPP
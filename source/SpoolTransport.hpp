@@ -0,0 +1,141 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_SPOOL_TRANSPORT_HPP
+#define SECRET_SANTA_SPOOL_TRANSPORT_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BoundedQueue.hpp"
+#include "Spool.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Transport that sends nothing and instead writes each email message as an RFC 5322 file into a
+// spool directory, for review or for sending later. Several writer threads take the email messages
+// from a bounded queue, so that the latency of the file system is overlapped across files and
+// writing many email messages is bound by the throughput of the file system rather than by one
+// thread. Each file is written under a temporary name and then renamed into place.
+class SpoolTransport : public Transport {
+public:
+  // Constructor. Constructs a transport that writes email messages from a given sender address into
+  // a given spool, whose directories must exist, with a given number of writer threads.
+  SpoolTransport(Spool spool, std::string sender, const std::size_t writer_count = 4)
+    : spool_(std::move(spool)), sender_(std::move(sender)),
+      date_(FormatEmailDate(std::time(nullptr))),
+      jobs_(64 * std::max<std::size_t>(writer_count, 1)) {
+    for (std::size_t index = 0; index < std::max<std::size_t>(writer_count, 1); ++index) {
+      writers_.emplace_back([this]() { Work(); });
+    }
+  }
+
+  // Destructor. Waits for all email messages to be written and stops the writer threads.
+  ~SpoolTransport() noexcept override {
+    jobs_.Close();
+    for (std::thread& writer : writers_) {
+      writer.join();
+    }
+  }
+
+  // Deleted copy constructor.
+  SpoolTransport(const SpoolTransport& other) = delete;
+
+  // Deleted move constructor.
+  SpoolTransport(SpoolTransport&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  SpoolTransport& operator=(const SpoolTransport& other) = delete;
+
+  // Deleted move assignment operator.
+  SpoolTransport& operator=(SpoolTransport&& other) noexcept = delete;
+
+  [[nodiscard]] std::string Name() const override {
+    return "Spool (" + spool_.Directory().string() + ", " + std::to_string(writers_.size())
+           + " writers)";
+  }
+
+  void Send(EmailMessage message, Completion completion) override {
+    {
+      const std::lock_guard<std::mutex> lock{pending_mutex_};
+      ++pending_count_;
+    }
+    jobs_.Push({std::move(message), std::move(completion)});
+  }
+
+  void Flush() override {
+    std::unique_lock<std::mutex> lock{pending_mutex_};
+    pending_condition_.wait(lock, [this]() { return pending_count_ == 0; });
+  }
+
+private:
+  // Writes email messages until the queue of jobs is closed. A failure to write a file, such as a
+  // full disk, is reported as a transient failure.
+  void Work() {
+    while (std::optional<std::pair<EmailMessage, Completion>> job = jobs_.Pop()) {
+      const std::string error{
+          spool_.Write(SpoolFileName(job->first), ComposeMessageFile(sender_, job->first, date_))};
+      job->second(job->first, error.empty() ?
+                                  Delivery{DeliveryStatus::Delivered, "Spooled."} :
+                                  Delivery{DeliveryStatus::TransientFailure, error});
+
+      const std::lock_guard<std::mutex> lock{pending_mutex_};
+      if (--pending_count_ == 0) {
+        pending_condition_.notify_all();
+      }
+    }
+  }
+
+  // Spool into which email messages are written.
+  Spool spool_;
+
+  // Email address from which email messages are sent.
+  std::string sender_;
+
+  // Date of the email messages, which is the time at which this transport was constructed.
+  std::string date_;
+
+  // Email messages waiting to be written, along with their completion functions.
+  BoundedQueue<std::pair<EmailMessage, Completion>> jobs_;
+
+  // Threads that each write one email message at a time.
+  std::vector<std::thread> writers_;
+
+  // Protects the number of email messages that have not yet been written.
+  std::mutex pending_mutex_;
+
+  // Notified when all email messages have been written.
+  std::condition_variable pending_condition_;
+
+  // Number of email messages that have not yet been written.
+  std::size_t pending_count_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_SPOOL_TRANSPORT_HPP
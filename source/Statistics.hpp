@@ -0,0 +1,170 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_STATISTICS_HPP
+#define SECRET_SANTA_STATISTICS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace SecretSanta {
+
+// Regularized upper incomplete gamma function Q(a, x), which is the probability that a gamma
+// variable of shape a exceeds x. Uses the series expansion of the lower function below a + 1 and
+// a continued fraction above it, which both converge quickly in their range.
+[[nodiscard]] double RegularizedUpperGamma(const double a, const double x) {
+  if (x <= 0.0) {
+    return 1.0;
+  }
+
+  constexpr int maximum_iteration_count{100000};
+  constexpr double epsilon{1.0e-15};
+  const double log_prefactor = a * std::log(x) - x - std::lgamma(a);
+
+  if (x < a + 1.0) {
+    double term = 1.0 / a;
+    double sum = term;
+    for (int iteration = 1; iteration < maximum_iteration_count; ++iteration) {
+      term *= x / (a + iteration);
+      sum += term;
+      if (std::abs(term) < std::abs(sum) * epsilon) {
+        break;
+      }
+    }
+    return std::clamp(1.0 - sum * std::exp(log_prefactor), 0.0, 1.0);
+  }
+
+  // Modified Lentz evaluation of the continued fraction.
+  constexpr double tiny{1.0e-300};
+  double b = x + 1.0 - a;
+  double c = 1.0 / tiny;
+  double d = 1.0 / b;
+  double fraction = d;
+  for (int iteration = 1; iteration < maximum_iteration_count; ++iteration) {
+    const double an = -iteration * (iteration - a);
+    b += 2.0;
+    d = an * d + b;
+    if (std::abs(d) < tiny) {
+      d = tiny;
+    }
+    c = b + an / c;
+    if (std::abs(c) < tiny) {
+      c = tiny;
+    }
+    d = 1.0 / d;
+    const double delta = d * c;
+    fraction *= delta;
+    if (std::abs(delta - 1.0) < epsilon) {
+      break;
+    }
+  }
+  return std::clamp(std::exp(log_prefactor) * fraction, 0.0, 1.0);
+}
+
+// Probability that a chi-squared variable with a given number of degrees of freedom is at least a
+// given statistic, which is the p-value of a chi-squared test. A test without degrees of freedom
+// has a p-value of one if its statistic is zero and of zero otherwise.
+[[nodiscard]] double ChiSquaredSurvival(const double statistic, const double degrees_of_freedom) {
+  if (degrees_of_freedom <= 0.0) {
+    return statistic > 0.0 ? 0.0 : 1.0;
+  }
+  return RegularizedUpperGamma(degrees_of_freedom / 2.0, statistic / 2.0);
+}
+
+// Pearson chi-squared statistic of given observed counts against given expected counts. Cells with
+// no expected count are skipped if nothing was observed in them. Returns no value if something was
+// observed in such a cell, since the observed counts are then impossible under the expected ones.
+// This is reported explicitly rather than as an infinite statistic, since the programs are compiled
+// with -ffast-math, under which infinities cannot be relied upon.
+[[nodiscard]] std::optional<double> ChiSquaredStatistic(
+    const std::vector<uint64_t>& observed, const std::vector<double>& expected) {
+  double statistic = 0.0;
+  for (std::size_t index = 0; index < observed.size() && index < expected.size(); ++index) {
+    if (expected[index] <= 0.0) {
+      if (observed[index] > 0) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    const double difference = static_cast<double>(observed[index]) - expected[index];
+    statistic += difference * difference / expected[index];
+  }
+  return statistic;
+}
+
+// P-value of the chi-squared test of given observed counts against given expected counts with a
+// given number of degrees of freedom. The p-value is zero if something was observed in a cell with
+// no expected count.
+[[nodiscard]] double ChiSquaredPValue(const std::vector<uint64_t>& observed,
+                                      const std::vector<double>& expected,
+                                      const double degrees_of_freedom) {
+  const std::optional<double> statistic = ChiSquaredStatistic(observed, expected);
+  if (!statistic.has_value()) {
+    return 0.0;
+  }
+  return ChiSquaredSurvival(statistic.value(), degrees_of_freedom);
+}
+
+// Kolmogorov-Smirnov statistic of given samples against the uniform distribution between zero and
+// one, which is the largest distance between their empirical distribution function and the
+// identity. Sorts the samples.
+[[nodiscard]] double KolmogorovSmirnovStatistic(std::vector<double>& samples) {
+  std::sort(samples.begin(), samples.end());
+  const double count = static_cast<double>(samples.size());
+  double statistic = 0.0;
+  for (std::size_t index = 0; index < samples.size(); ++index) {
+    statistic = std::max({statistic, (static_cast<double>(index) + 1.0) / count - samples[index],
+                          samples[index] - static_cast<double>(index) / count});
+  }
+  return statistic;
+}
+
+// Probability that the Kolmogorov-Smirnov statistic of a given number of samples drawn from the
+// tested distribution is at least a given statistic, which is the p-value of a Kolmogorov-Smirnov
+// test. Uses the asymptotic Kolmogorov distribution with the usual correction for finite samples.
+[[nodiscard]] double KolmogorovSmirnovSurvival(
+    const double statistic, const std::size_t sample_count) {
+  if (sample_count == 0) {
+    return 1.0;
+  }
+  const double root = std::sqrt(static_cast<double>(sample_count));
+  const double lambda = (root + 0.12 + 0.11 / root) * statistic;
+  if (lambda < 0.2) {
+    return 1.0;
+  }
+  double sum = 0.0;
+  double sign = 1.0;
+  for (int term = 1; term <= 100; ++term) {
+    const double value = sign * std::exp(-2.0 * term * term * lambda * lambda);
+    sum += value;
+    if (std::abs(value) < 1.0e-12 * std::abs(sum)) {
+      break;
+    }
+    sign = -sign;
+  }
+  return std::clamp(2.0 * sum, 0.0, 1.0);
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_STATISTICS_HPP
@@ -0,0 +1,242 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_STRING_INDEX_HPP
+#define SECRET_SANTA_STRING_INDEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SecretSanta {
+
+// Hash index that assigns consecutive integer identifiers to distinct strings, starting at zero.
+// Uses open addressing with linear probing over a flat array of slots, each of which caches the
+// full hash of its string so that most probes never compare the strings themselves. The index keeps
+// its own copy of the characters of all strings in one contiguous buffer, in identifier order, so
+// that looking up strings in the order in which they were inserted reads memory sequentially.
+class StringIndex {
+public:
+  // Identifier returned when a string is not found in the index.
+  static constexpr uint32_t NotFound{std::numeric_limits<uint32_t>::max()};
+
+  // Default constructor. Constructs an empty index.
+  StringIndex() = default;
+
+  // Constructor. Constructs an empty index with room for a given number of strings.
+  explicit StringIndex(const std::size_t expected_count) {
+    Reserve(expected_count);
+  }
+
+  // Destructor. Destroys this index.
+  ~StringIndex() noexcept = default;
+
+  // Copy constructor. Constructs an index by copying another one.
+  StringIndex(const StringIndex& other) = default;
+
+  // Move constructor. Constructs an index by moving another one.
+  StringIndex(StringIndex&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this index by copying another one.
+  StringIndex& operator=(const StringIndex& other) = default;
+
+  // Move assignment operator. Assigns this index by moving another one.
+  StringIndex& operator=(StringIndex&& other) noexcept = default;
+
+  // Number of distinct strings in this index.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return offsets_.size() - 1;
+  }
+
+  // String with a given identifier.
+  [[nodiscard]] std::string_view Key(const uint32_t identifier) const noexcept {
+    return {characters_.data() + offsets_[identifier],
+            offsets_[identifier + 1] - offsets_[identifier]};
+  }
+
+  // Ensures that this index has room for a given number of strings without growing.
+  void Reserve(const std::size_t expected_count) {
+    std::size_t capacity = 16;
+    while (capacity < 2 * expected_count) {
+      capacity *= 2;
+    }
+    if (capacity > slots_.size()) {
+      Rehash(capacity);
+    }
+    offsets_.reserve(expected_count + 1);
+  }
+
+  // Inserts a string into this index if it is not already present. Returns its identifier.
+  uint32_t Insert(const std::string_view key) {
+    if (2 * (Size() + 1) > slots_.size()) {
+      Rehash(slots_.empty() ? 16 : 2 * slots_.size());
+    }
+
+    const std::size_t hash = std::hash<std::string_view>()(key);
+    std::size_t position = hash & (slots_.size() - 1);
+    while (slots_[position].identifier != NotFound) {
+      if (slots_[position].hash == hash && Key(slots_[position].identifier) == key) {
+        return slots_[position].identifier;
+      }
+      position = (position + 1) & (slots_.size() - 1);
+    }
+
+    const uint32_t identifier = static_cast<uint32_t>(Size());
+    slots_[position] = Slot{hash, identifier};
+    characters_.append(key);
+    offsets_.push_back(characters_.size());
+    return identifier;
+  }
+
+  // Returns the identifier of a given string, or NotFound if it is not in this index.
+  [[nodiscard]] uint32_t Find(const std::string_view key) const noexcept {
+    if (slots_.empty()) {
+      return NotFound;
+    }
+
+    return Find(key, std::hash<std::string_view>()(key));
+  }
+
+  // Looks up a sequence of strings and writes the identifier of each one, or NotFound if it is not
+  // in this index, at the same position of a sequence of identifiers of the same size. The lookups
+  // are pipelined: the slot of a string is prefetched some lookups ahead, then the offset of the
+  // string that the slot holds, and then its characters, so that the memory accesses of many
+  // lookups overlap instead of waiting on each other. This is several times faster than calling
+  // Find for each string once the index no longer fits in the processor caches.
+  void FindAll(const std::span<const std::string_view> keys,
+               const std::span<uint32_t> identifiers) const noexcept {
+    if (slots_.empty()) {
+      std::fill(identifiers.begin(), identifiers.end(), NotFound);
+      return;
+    }
+
+    // Hashes of the strings whose lookups are under way, and identifiers of the first strings of
+    // the index that have the same hashes, by position modulo a length that exceeds that of the
+    // pipeline.
+    std::array<std::size_t, 4 * PrefetchDistance> hashes{};
+    std::array<uint32_t, 4 * PrefetchDistance> candidates{};
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t index = 0; index < keys.size() + 3 * PrefetchDistance; ++index) {
+      // First stage: the slot of the string, and the next slot in case it is taken by another one.
+      if (index < keys.size()) {
+        const std::size_t hash = std::hash<std::string_view>()(keys[index]);
+        hashes[index % hashes.size()] = hash;
+        __builtin_prefetch(&slots_[hash & mask]);
+        __builtin_prefetch(&slots_[(hash + 1) & mask]);
+      }
+
+      // Second stage: the offsets of the first string of the index that has the same hash.
+      if (index >= PrefetchDistance && index - PrefetchDistance < keys.size()) {
+        const std::size_t position = (index - PrefetchDistance) % hashes.size();
+        candidates[position] = Candidate(hashes[position]);
+        if (candidates[position] != NotFound) {
+          __builtin_prefetch(&offsets_[candidates[position]]);
+          __builtin_prefetch(&offsets_[candidates[position] + 1]);
+        }
+      }
+
+      // Third stage: the characters of that string.
+      if (index >= 2 * PrefetchDistance && index - 2 * PrefetchDistance < keys.size()) {
+        const std::size_t position = index - 2 * PrefetchDistance;
+        const uint32_t candidate = candidates[position % hashes.size()];
+        if (candidate != NotFound && !keys[position].empty()) {
+          __builtin_prefetch(characters_.data() + offsets_[candidate]);
+          __builtin_prefetch(characters_.data() + offsets_[candidate] + keys[position].size() - 1);
+        }
+      }
+
+      // Last stage: the lookup itself, whose memory accesses are now mostly cached.
+      if (index >= 3 * PrefetchDistance) {
+        const std::size_t position = index - 3 * PrefetchDistance;
+        identifiers[position] = Find(keys[position], hashes[position % hashes.size()]);
+      }
+    }
+  }
+
+private:
+  // Number of lookups between the stages of the pipeline of FindAll.
+  static constexpr std::size_t PrefetchDistance{16};
+
+  // Returns the identifier of the first string of a given hash in the table of slots, or NotFound
+  // if there is none. Only reads the slots. The index must not be empty.
+  [[nodiscard]] uint32_t Candidate(const std::size_t hash) const noexcept {
+    std::size_t position = hash & (slots_.size() - 1);
+    while (slots_[position].identifier != NotFound && slots_[position].hash != hash) {
+      position = (position + 1) & (slots_.size() - 1);
+    }
+    return slots_[position].identifier;
+  }
+
+  // Returns the identifier of a given string of a given hash, or NotFound if it is not in this
+  // index. The index must not be empty.
+  [[nodiscard]] uint32_t Find(const std::string_view key, const std::size_t hash) const noexcept {
+    std::size_t position = hash & (slots_.size() - 1);
+    while (slots_[position].identifier != NotFound) {
+      if (slots_[position].hash == hash && Key(slots_[position].identifier) == key) {
+        return slots_[position].identifier;
+      }
+      position = (position + 1) & (slots_.size() - 1);
+    }
+    return NotFound;
+  }
+
+  // Slot of the open-addressing table. A slot whose identifier is NotFound is empty.
+  struct Slot {
+    std::size_t hash{0};
+    uint32_t identifier{NotFound};
+  };
+
+  // Rebuilds the table of slots with a given power-of-two capacity.
+  void Rehash(const std::size_t capacity) {
+    std::vector<Slot> slots(capacity);
+    for (const Slot& slot : slots_) {
+      if (slot.identifier == NotFound) {
+        continue;
+      }
+      std::size_t position = slot.hash & (capacity - 1);
+      while (slots[position].identifier != NotFound) {
+        position = (position + 1) & (capacity - 1);
+      }
+      slots[position] = slot;
+    }
+    slots_ = std::move(slots);
+  }
+
+  // Open-addressing table of slots. Its size is zero or a power of two.
+  std::vector<Slot> slots_;
+
+  // Characters of all strings in this index, concatenated in identifier order.
+  std::string characters_;
+
+  // Offset of the first character of each string in the buffer of characters, by identifier,
+  // followed by the total number of characters.
+  std::vector<std::size_t> offsets_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_STRING_INDEX_HPP
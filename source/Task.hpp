@@ -0,0 +1,179 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_TASK_HPP
+#define SECRET_SANTA_TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "Executor.hpp"
+
+namespace SecretSanta {
+
+// Coroutine that produces a value. A task is lazy: it starts running only once it is awaited with
+// co_await, and the awaiting coroutine resumes once the task returns its value. A task owns its
+// coroutine and destroys it when the task itself is destroyed.
+template <typename Value>
+class [[nodiscard]] Task {
+public:
+  // State of the coroutine of a task, as required by the C++ coroutine machinery.
+  class promise_type {
+  public:
+    // Creates the task that owns this coroutine.
+    Task get_return_object() noexcept {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    // Suspends the coroutine before its first statement, such that it starts only once awaited.
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    // Suspends the coroutine after it returns and resumes the coroutine that awaits it, if any.
+    auto final_suspend() noexcept {
+      struct FinalAwaiter {
+        bool await_ready() noexcept {
+          return false;
+        }
+
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<promise_type> coroutine) noexcept {
+          const std::coroutine_handle<> continuation = coroutine.promise().continuation_;
+          return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+      };
+      return FinalAwaiter{};
+    }
+
+    // Stores the value returned by the coroutine.
+    void return_value(Value value) {
+      value_.emplace(std::move(value));
+    }
+
+    // Stores an exception that escapes the coroutine, such that it is rethrown to the awaiter.
+    void unhandled_exception() noexcept {
+      exception_ = std::current_exception();
+    }
+
+  private:
+    friend class Task;
+
+    // Value returned by the coroutine, once it has returned.
+    std::optional<Value> value_;
+
+    // Exception that escaped the coroutine, if any.
+    std::exception_ptr exception_;
+
+    // Coroutine that awaits this one, if any.
+    std::coroutine_handle<> continuation_;
+  };
+
+  // Destructor. Destroys the coroutine of this task.
+  ~Task() noexcept {
+    if (coroutine_) {
+      coroutine_.destroy();
+    }
+  }
+
+  // Deleted copy constructor.
+  Task(const Task& other) = delete;
+
+  // Move constructor. Constructs a task by taking ownership of another one's coroutine.
+  Task(Task&& other) noexcept : coroutine_(std::exchange(other.coroutine_, nullptr)) {}
+
+  // Deleted copy assignment operator.
+  Task& operator=(const Task& other) = delete;
+
+  // Move assignment operator. Destroys the coroutine of this task and takes ownership of another
+  // one's coroutine.
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (coroutine_) {
+        coroutine_.destroy();
+      }
+      coroutine_ = std::exchange(other.coroutine_, nullptr);
+    }
+    return *this;
+  }
+
+  // Whether the coroutine of this task has returned.
+  [[nodiscard]] bool IsDone() const noexcept {
+    return coroutine_ && coroutine_.done();
+  }
+
+  // Starts the coroutine of this task without awaiting it. It runs until its first suspension.
+  void Start() {
+    coroutine_.resume();
+  }
+
+  // Value returned by the coroutine of this task, which must have returned. Rethrows any exception
+  // that escaped the coroutine.
+  Value Result() {
+    if (coroutine_.promise().exception_) {
+      std::rethrow_exception(coroutine_.promise().exception_);
+    }
+    return std::move(coroutine_.promise().value_.value());
+  }
+
+  // Whether the coroutine of this task can be skipped when awaited. Never, because it is lazy.
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  // Starts the coroutine of this task and resumes the awaiting coroutine once it returns.
+  std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+    coroutine_.promise().continuation_ = awaiting;
+    return coroutine_;
+  }
+
+  // Value returned by the coroutine of this task.
+  Value await_resume() {
+    return Result();
+  }
+
+private:
+  // Constructor. Constructs a task that owns a given coroutine.
+  explicit Task(const std::coroutine_handle<promise_type> coroutine) noexcept
+    : coroutine_(coroutine) {}
+
+  // Coroutine owned by this task.
+  std::coroutine_handle<promise_type> coroutine_;
+};
+
+// Runs a task to completion on the calling thread, running the work posted to a given queue
+// executor while the task is suspended, and returns its value. Intended for programs and tests
+// that are not themselves coroutines.
+template <typename Value>
+Value SyncWait(QueueExecutor& executor, Task<Value> task) {
+  task.Start();
+  while (!task.IsDone()) {
+    executor.RunOne();
+  }
+  return task.Result();
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_TASK_HPP
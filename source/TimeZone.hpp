@@ -0,0 +1,527 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_TIME_ZONE_HPP
+#define SECRET_SANTA_TIME_ZONE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SecretSanta {
+
+// Parses a time of day such as "09:00" or "9:30" into a number of minutes since midnight. Returns
+// no value if the text is not a valid time of day.
+[[nodiscard]] std::optional<int> ParseTimeOfDay(const std::string_view text) {
+  const std::string copy{text};
+  if (copy.find_first_not_of("0123456789:") != std::string::npos) {
+    return std::nullopt;
+  }
+  int hours = 0;
+  int minutes = 0;
+  int length = 0;
+  if (std::sscanf(copy.c_str(), "%2d:%2d%n", &hours, &minutes, &length) != 2
+      || static_cast<std::size_t>(length) != copy.size() || hours < 0 || hours > 23
+      || minutes < 0 || minutes > 59) {
+    return std::nullopt;
+  }
+  return hours * 60 + minutes;
+}
+
+// Formats a number of minutes since midnight as a time of day such as "09:00".
+[[nodiscard]] std::string FormatTimeOfDay(const int minutes) {
+  char text[8];
+  std::snprintf(text, sizeof(text), "%02d:%02d", (minutes / 60) % 24, minutes % 60);
+  return text;
+}
+
+// Path of the file of a given time zone of the IANA time zone database installed on this system.
+// The database is read from the directory given by the TZDIR environment variable, or from
+// /usr/share/zoneinfo by default.
+[[nodiscard]] std::filesystem::path TimeZoneFilePath(const std::string& name) {
+  const char* const directory = std::getenv("TZDIR");
+  return std::filesystem::path{directory != nullptr ? directory : "/usr/share/zoneinfo"} / name;
+}
+
+// Whether a given name is a time zone of the IANA time zone database installed on this system,
+// such as "America/Los_Angeles" or "UTC".
+[[nodiscard]] bool IsKnownTimeZone(const std::string& name) {
+  if (name.empty() || name.front() == '/' || name.find("..") != std::string::npos) {
+    return false;
+  }
+  std::error_code error;
+  return std::filesystem::is_regular_file(TimeZoneFilePath(name), error);
+}
+
+// Offsets from UTC of a time zone of the IANA time zone database, read from its file in the TZif
+// format of RFC 8536: the offsets of the past transitions, followed by a POSIX TZ rule such as
+// "CET-1CEST,M3.5.0,M10.5.0/3" for the times after the last transition. Unlike the C library,
+// which only converts times in the time zone of the TZ environment variable, any number of threads
+// convert times in any number of time zones at once.
+class TimeZoneRules {
+public:
+  // Default constructor. Constructs the rules of UTC.
+  TimeZoneRules() = default;
+
+  // Constructor. Constructs the rules of a time zone by reading a given TZif file. Constructs the
+  // rules of UTC if the file cannot be read or is malformed.
+  explicit TimeZoneRules(const std::filesystem::path& path) {
+    std::ifstream stream{path, std::ios::binary};
+    const std::string data{
+        std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+    // Version 1 files only hold 32-bit times. Later versions repeat the data with 64-bit times,
+    // followed by the rule for the times after the last transition.
+    std::size_t position = 0;
+    if (!ReadData(data, 4, position)) {
+      *this = TimeZoneRules{};
+      return;
+    }
+    if (data[4] >= '2') {
+      if (!ReadData(data, 8, position)) {
+        *this = TimeZoneRules{};
+        return;
+      }
+      if (position < data.size() && data[position] == '\n') {
+        const std::size_t end = data.find('\n', position + 1);
+        if (end != std::string::npos
+            && !ReadRule(std::string_view{data}.substr(position + 1, end - position - 1))) {
+          *this = TimeZoneRules{};
+        }
+      }
+    }
+  }
+
+  // Destructor. Destroys these rules.
+  ~TimeZoneRules() noexcept = default;
+
+  // Deleted copy constructor.
+  TimeZoneRules(const TimeZoneRules& other) = delete;
+
+  // Default move constructor.
+  TimeZoneRules(TimeZoneRules&& other) noexcept = default;
+
+  // Deleted copy assignment operator.
+  TimeZoneRules& operator=(const TimeZoneRules& other) = delete;
+
+  // Default move assignment operator.
+  TimeZoneRules& operator=(TimeZoneRules&& other) noexcept = default;
+
+  // Rules of the time zone of the IANA time zone database with a given name. Each time zone is
+  // read once, on first use, and then shared by all threads.
+  [[nodiscard]] static const TimeZoneRules& Find(const std::string& name) {
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<const TimeZoneRules>> names_to_rules;
+    const std::lock_guard<std::mutex> lock{mutex};
+    std::unique_ptr<const TimeZoneRules>& rules = names_to_rules[name];
+    if (rules == nullptr) {
+      rules = std::make_unique<const TimeZoneRules>(TimeZoneFilePath(name));
+    }
+    return *rules;
+  }
+
+  // Offset in seconds of the local time from UTC at a given time, such as 3600 in Paris in winter.
+  [[nodiscard]] int64_t OffsetSeconds(const int64_t time) const noexcept {
+    if (rule_.has_value() && (transitions_.empty() || time >= transitions_.back())) {
+      return rule_->OffsetSeconds(time);
+    }
+    if (offsets_.empty()) {
+      return 0;
+    }
+    const std::vector<int64_t>::const_iterator next =
+        std::upper_bound(transitions_.cbegin(), transitions_.cend(), time);
+    if (next == transitions_.cbegin()) {
+      return offsets_.front();
+    }
+    return offsets_[transition_offset_indices_[next - transitions_.cbegin() - 1]];
+  }
+
+private:
+  // Day of a year on which a POSIX TZ rule switches between standard and daylight saving time.
+  struct RuleDay {
+    // Either 'M' for a weekday of a month, 'J' for a day of the year from 1 to 365 that never
+    // counts February 29, or 'D' for a day of the year from 0 to 365.
+    char kind{'D'};
+
+    // Month from 1 to 12, for a weekday of a month.
+    unsigned month{1};
+
+    // Week of the month from 1 to 5, where 5 is the last week, for a weekday of a month.
+    unsigned week{1};
+
+    // Day of the week from 0 for Sunday to 6, or day of the year.
+    unsigned day{0};
+
+    // Local time of day of the switch, in seconds, which may be negative or exceed a day.
+    int64_t seconds{7200};
+
+    // Time at which the local clock, with a given offset from UTC, reaches this day of a given
+    // year and time of day.
+    [[nodiscard]] int64_t Time(const std::chrono::year year, const int64_t offset) const {
+      std::chrono::sys_days date;
+      if (kind == 'M') {
+        const std::chrono::month month_of_year{month};
+        const std::chrono::weekday weekday{day};
+        date = week == 5 ?
+                   std::chrono::sys_days{year / month_of_year / weekday[std::chrono::last]} :
+                   std::chrono::sys_days{year / month_of_year / weekday[week]};
+      } else {
+        date = std::chrono::sys_days{year / std::chrono::January / 1}
+               + std::chrono::days{kind == 'J' ? day - 1 + (year.is_leap() && day >= 60) : day};
+      }
+      return static_cast<int64_t>(date.time_since_epoch().count()) * 86400 + seconds - offset;
+    }
+  };
+
+  // POSIX TZ rule, which gives the offsets of the times after the last transition.
+  struct Rule {
+    // Offset in seconds from UTC of the standard time.
+    int64_t standard_offset{0};
+
+    // Offset in seconds from UTC of the daylight saving time, if any.
+    std::optional<int64_t> daylight_offset;
+
+    // Day on which daylight saving time starts.
+    RuleDay start;
+
+    // Day on which daylight saving time ends.
+    RuleDay end;
+
+    // Offset in seconds of the local time from UTC at a given time.
+    [[nodiscard]] int64_t OffsetSeconds(const int64_t time) const {
+      if (!daylight_offset.has_value()) {
+        return standard_offset;
+      }
+      const std::chrono::year year{
+          std::chrono::year_month_day{std::chrono::floor<std::chrono::days>(
+                                          std::chrono::sys_seconds{std::chrono::seconds{
+                                              time + standard_offset}})}
+              .year()};
+      const int64_t start_time = start.Time(year, standard_offset);
+      const int64_t end_time = end.Time(year, daylight_offset.value());
+      // In the southern hemisphere, daylight saving time spans the end of the year.
+      const bool daylight = start_time < end_time ? time >= start_time && time < end_time :
+                                                    time < end_time || time >= start_time;
+      return daylight ? daylight_offset.value() : standard_offset;
+    }
+  };
+
+  // Reads a big-endian integer of a given number of bytes at a given position of a given text.
+  [[nodiscard]] static int64_t ReadInteger(
+      const std::string& data, const std::size_t position, const std::size_t size) {
+    uint64_t value = 0;
+    for (std::size_t index = 0; index < size; ++index) {
+      value = (value << 8) | static_cast<uint8_t>(data[position + index]);
+    }
+    if (size == 4) {
+      return static_cast<int32_t>(static_cast<uint32_t>(value));
+    }
+    return static_cast<int64_t>(value);
+  }
+
+  // Reads the header and data of a TZif file, with times of a given number of bytes, at a given
+  // position of its contents, and moves the position past them. Returns whether they are valid.
+  bool ReadData(const std::string& data, const std::size_t time_size, std::size_t& position) {
+    if (data.size() < position + 44 || data.compare(position, 4, "TZif") != 0) {
+      return false;
+    }
+    const std::size_t ut_indicator_count = ReadInteger(data, position + 20, 4);
+    const std::size_t standard_indicator_count = ReadInteger(data, position + 24, 4);
+    const std::size_t leap_second_count = ReadInteger(data, position + 28, 4);
+    const std::size_t transition_count = ReadInteger(data, position + 32, 4);
+    const std::size_t type_count = ReadInteger(data, position + 36, 4);
+    const std::size_t character_count = ReadInteger(data, position + 40, 4);
+    position += 44;
+    if (type_count == 0
+        || data.size() < position + transition_count * (time_size + 1) + type_count * 6
+                             + character_count + leap_second_count * (time_size + 4)
+                             + standard_indicator_count + ut_indicator_count) {
+      return false;
+    }
+
+    transitions_.resize(transition_count);
+    transition_offset_indices_.resize(transition_count);
+    for (std::size_t index = 0; index < transition_count; ++index) {
+      transitions_[index] = ReadInteger(data, position + index * time_size, time_size);
+      transition_offset_indices_[index] =
+          static_cast<uint8_t>(data[position + transition_count * time_size + index]);
+      if (transition_offset_indices_[index] >= type_count) {
+        return false;
+      }
+    }
+    position += transition_count * (time_size + 1);
+
+    offsets_.resize(type_count);
+    for (std::size_t index = 0; index < type_count; ++index) {
+      offsets_[index] = ReadInteger(data, position + index * 6, 4);
+    }
+    position += type_count * 6 + character_count + leap_second_count * (time_size + 4)
+                + standard_indicator_count + ut_indicator_count;
+    return true;
+  }
+
+  // Reads the name of a time zone, such as "CET" or "<+03>", at a given position of a POSIX TZ
+  // rule, and moves the position past it. Returns whether the name is valid.
+  [[nodiscard]] static bool ReadName(const std::string_view text, std::size_t& position) {
+    if (position < text.size() && text[position] == '<') {
+      const std::size_t end = text.find('>', position);
+      if (end == std::string_view::npos) {
+        return false;
+      }
+      position = end + 1;
+      return true;
+    }
+    const std::size_t start = position;
+    while (position < text.size()
+           && ((text[position] >= 'A' && text[position] <= 'Z')
+               || (text[position] >= 'a' && text[position] <= 'z'))) {
+      ++position;
+    }
+    return position - start >= 3;
+  }
+
+  // Reads a number at a given position of a POSIX TZ rule, and moves the position past it.
+  [[nodiscard]] static std::optional<int64_t> ReadNumber(
+      const std::string_view text, std::size_t& position) {
+    const std::size_t start = position;
+    int64_t value = 0;
+    while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+      value = value * 10 + (text[position] - '0');
+      ++position;
+    }
+    if (position == start) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  // Reads a signed duration such as "-1", "5", or "+2:30" at a given position of a POSIX TZ rule,
+  // in seconds, and moves the position past it.
+  [[nodiscard]] static std::optional<int64_t> ReadDuration(
+      const std::string_view text, std::size_t& position) {
+    int64_t sign = 1;
+    if (position < text.size() && (text[position] == '+' || text[position] == '-')) {
+      sign = text[position] == '-' ? -1 : 1;
+      ++position;
+    }
+    int64_t seconds = 0;
+    for (int64_t unit = 3600; unit >= 1; unit /= 60) {
+      const std::optional<int64_t> number = ReadNumber(text, position);
+      if (!number.has_value()) {
+        return std::nullopt;
+      }
+      seconds += number.value() * unit;
+      if (unit == 1 || position >= text.size() || text[position] != ':') {
+        break;
+      }
+      ++position;
+    }
+    return sign * seconds;
+  }
+
+  // Reads a day such as "M3.5.0/3", "J60", or "59" at a given position of a POSIX TZ rule, and
+  // moves the position past it.
+  [[nodiscard]] static std::optional<RuleDay> ReadRuleDay(
+      const std::string_view text, std::size_t& position) {
+    RuleDay day;
+    if (position < text.size() && (text[position] == 'M' || text[position] == 'J')) {
+      day.kind = text[position];
+      ++position;
+    }
+    if (day.kind == 'M') {
+      const std::optional<int64_t> month = ReadNumber(text, position);
+      if (!month.has_value() || position >= text.size() || text[position] != '.') {
+        return std::nullopt;
+      }
+      ++position;
+      const std::optional<int64_t> week = ReadNumber(text, position);
+      if (!week.has_value() || position >= text.size() || text[position] != '.') {
+        return std::nullopt;
+      }
+      ++position;
+      const std::optional<int64_t> weekday = ReadNumber(text, position);
+      if (!weekday.has_value() || month.value() < 1 || month.value() > 12 || week.value() < 1
+          || week.value() > 5 || weekday.value() > 6) {
+        return std::nullopt;
+      }
+      day.month = static_cast<unsigned>(month.value());
+      day.week = static_cast<unsigned>(week.value());
+      day.day = static_cast<unsigned>(weekday.value());
+    } else {
+      const std::optional<int64_t> number = ReadNumber(text, position);
+      if (!number.has_value() || number.value() > 365 || (day.kind == 'J' && number.value() < 1)) {
+        return std::nullopt;
+      }
+      day.day = static_cast<unsigned>(number.value());
+    }
+    if (position < text.size() && text[position] == '/') {
+      ++position;
+      const std::optional<int64_t> seconds = ReadDuration(text, position);
+      if (!seconds.has_value()) {
+        return std::nullopt;
+      }
+      day.seconds = seconds.value();
+    }
+    return day;
+  }
+
+  // Reads a POSIX TZ rule such as "CET-1CEST,M3.5.0,M10.5.0/3". Its offsets are west of UTC, so
+  // their signs are the opposite of the offsets of this class. Returns whether the rule is valid.
+  // An empty rule, which means that the times after the last transition are unspecified, is valid.
+  bool ReadRule(const std::string_view text) {
+    if (text.empty()) {
+      return true;
+    }
+    std::size_t position = 0;
+    Rule rule;
+    if (!ReadName(text, position)) {
+      return false;
+    }
+    const std::optional<int64_t> standard = ReadDuration(text, position);
+    if (!standard.has_value()) {
+      return false;
+    }
+    rule.standard_offset = -standard.value();
+    if (position < text.size()) {
+      if (!ReadName(text, position)) {
+        return false;
+      }
+      rule.daylight_offset = rule.standard_offset + 3600;
+      if (position < text.size() && text[position] != ',') {
+        const std::optional<int64_t> daylight = ReadDuration(text, position);
+        if (!daylight.has_value()) {
+          return false;
+        }
+        rule.daylight_offset = -daylight.value();
+      }
+      if (position >= text.size() || text[position] != ',') {
+        return false;
+      }
+      ++position;
+      const std::optional<RuleDay> start = ReadRuleDay(text, position);
+      if (!start.has_value() || position >= text.size() || text[position] != ',') {
+        return false;
+      }
+      ++position;
+      const std::optional<RuleDay> end = ReadRuleDay(text, position);
+      if (!end.has_value()) {
+        return false;
+      }
+      rule.start = start.value();
+      rule.end = end.value();
+    }
+    if (position != text.size()) {
+      return false;
+    }
+    rule_ = rule;
+    return true;
+  }
+
+  // Times of the transitions between offsets, in seconds since the epoch, in increasing order.
+  std::vector<int64_t> transitions_;
+
+  // Index in the offsets of the offset that starts at each transition.
+  std::vector<uint8_t> transition_offset_indices_;
+
+  // Offsets in seconds from UTC. The first one applies before the first transition.
+  std::vector<int64_t> offsets_;
+
+  // Rule for the times after the last transition, if any.
+  std::optional<Rule> rule_;
+};
+
+// Earliest time at or after a given time at which the clock reads a given time of day in a given
+// time zone of the IANA time zone database, or in the local time zone of this system if the time
+// zone is empty. On a day when daylight saving time skips the time of day, picks the time that the
+// clock would read if it had not skipped; on a day when it repeats the time of day, picks the
+// earlier one. Named time zones are converted with their TZif file, which is read once, so that the
+// environment is never changed and threads convert times concurrently.
+[[nodiscard]] std::time_t NextLocalTime(
+    const std::string& time_zone, const int minutes, const std::time_t now) {
+  if (time_zone.empty()) {
+    std::tm local{};
+    ::localtime_r(&now, &local);
+    std::time_t result = 0;
+    for (int day = 0; day < 3; ++day) {
+      std::tm target{};
+      target.tm_year = local.tm_year;
+      target.tm_mon = local.tm_mon;
+      target.tm_mday = local.tm_mday + day;
+      target.tm_hour = minutes / 60;
+      target.tm_min = minutes % 60;
+      target.tm_isdst = -1;
+      result = std::mktime(&target);
+      if (result >= now) {
+        break;
+      }
+    }
+    return result;
+  }
+
+  const TimeZoneRules& rules = TimeZoneRules::Find(time_zone);
+  const int64_t local_now = static_cast<int64_t>(now) + rules.OffsetSeconds(now);
+  const int64_t today = std::chrono::floor<std::chrono::days>(
+                            std::chrono::sys_seconds{std::chrono::seconds{local_now}})
+                            .time_since_epoch()
+                            .count();
+  int64_t local = 0;
+  for (int64_t day = 0; day < 3; ++day) {
+    local = (today + day) * 86400 + static_cast<int64_t>(minutes) * 60;
+    // Offsets are less than a day, so the offsets a day earlier and a day later are the only
+    // candidates, and the time of day was skipped if neither of them gives it.
+    const int64_t earlier_offset = rules.OffsetSeconds(local - 86400);
+    const int64_t later_offset = rules.OffsetSeconds(local + 86400);
+    bool exists = false;
+    std::optional<int64_t> found;
+    for (const int64_t offset : {earlier_offset, later_offset}) {
+      const int64_t candidate = local - offset;
+      if (rules.OffsetSeconds(candidate) == offset) {
+        exists = true;
+        if (candidate >= now && (!found.has_value() || candidate < found.value())) {
+          found = candidate;
+        }
+      }
+    }
+    if (!exists && local - earlier_offset >= now) {
+      found = local - earlier_offset;
+    }
+    if (found.has_value()) {
+      return static_cast<std::time_t>(found.value());
+    }
+  }
+  return static_cast<std::time_t>(local - rules.OffsetSeconds(local));
+}
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_TIME_ZONE_HPP
@@ -0,0 +1,211 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_TIMER_WHEEL_HPP
+#define SECRET_SANTA_TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace SecretSanta {
+
+// Hierarchical timer wheel that holds values until given ticks, such as seconds since the epoch,
+// and releases them once the wheel advances past their ticks. Each of its four levels has 256
+// slots; a slot of the first level covers one tick, and a slot of each next level covers all the
+// slots of the previous level. A value is held in the level of the highest 8-bit group in which its
+// tick differs from the current tick, and moves down one level each time the wheel reaches the
+// range of its slot, so that scheduling and releasing a value costs constant time however far
+// ahead it is. Not thread-safe.
+template <typename Value>
+class TimerWheel {
+public:
+  // Number of levels.
+  static constexpr std::size_t LevelCount{4};
+
+  // Number of bits of the tick covered by each level.
+  static constexpr std::size_t SlotBits{8};
+
+  // Number of slots of each level.
+  static constexpr std::size_t SlotCount{std::size_t{1} << SlotBits};
+
+  // Constructor. Constructs an empty timer wheel whose current tick is a given tick.
+  explicit TimerWheel(const uint64_t current_tick = 0) : current_tick_(current_tick) {}
+
+  // Destructor. Destroys this timer wheel and the values it holds.
+  ~TimerWheel() noexcept = default;
+
+  // Copy constructor. Constructs a timer wheel by copying another one.
+  TimerWheel(const TimerWheel& other) = default;
+
+  // Move constructor. Constructs a timer wheel by moving another one.
+  TimerWheel(TimerWheel&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this timer wheel by copying another one.
+  TimerWheel& operator=(const TimerWheel& other) = default;
+
+  // Move assignment operator. Assigns this timer wheel by moving another one.
+  TimerWheel& operator=(TimerWheel&& other) noexcept = default;
+
+  // Current tick of this timer wheel: the last tick up to which it advanced.
+  [[nodiscard]] uint64_t CurrentTick() const noexcept {
+    return current_tick_;
+  }
+
+  // Number of values held by this timer wheel.
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return size_;
+  }
+
+  // Whether this timer wheel holds no values.
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // Holds a given value until a given tick. A value whose tick is not after the current tick is
+  // released by the next advance.
+  void Schedule(const uint64_t tick, Value value) {
+    ++size_;
+    Insert(Entry{tick, std::move(value)});
+  }
+
+  // Advances this timer wheel up to a given tick and returns the values released on the way, in
+  // the order of their ticks, after the values that were already due. Only releases the values
+  // that are already due if the given tick is not after the current tick.
+  [[nodiscard]] std::vector<Value> Advance(const uint64_t tick) {
+    std::vector<Value> released;
+    Release(due_, released);
+    while (current_tick_ < tick && size_ > released.size()) {
+      // Skips ahead to the next tick at which a slot may have to be released or cascaded.
+      const std::optional<uint64_t> next{NextTick()};
+      if (!next.has_value() || next.value() > tick) {
+        break;
+      }
+      current_tick_ = next.value();
+      Cascade();
+      Release(levels_[0][current_tick_ & (SlotCount - 1)], released);
+      // Values cascaded down to exactly the current tick are due now.
+      Release(due_, released);
+    }
+    current_tick_ = std::max(current_tick_, tick);
+    size_ -= released.size();
+    return released;
+  }
+
+  // Earliest tick at which an advance may release a value, or no value if this timer wheel is
+  // empty. This is exact for the values in the first level and a lower bound for the others, since
+  // their slot only tells their range of ticks, so an advance to this tick may release nothing and
+  // only move values down one level.
+  [[nodiscard]] std::optional<uint64_t> NextTick() const {
+    if (!due_.empty()) {
+      return current_tick_;
+    }
+    for (std::size_t level = 0; level < LevelCount; ++level) {
+      const std::size_t shift = level * SlotBits;
+      const uint64_t group = current_tick_ >> shift;
+      for (std::size_t slot = (group & (SlotCount - 1)) + 1; slot < SlotCount; ++slot) {
+        if (!levels_[level][slot].empty()) {
+          return (((group >> SlotBits) << SlotBits) | slot) << shift;
+        }
+      }
+    }
+    if (size_ == 0) {
+      return std::nullopt;
+    }
+    // Only values beyond the range of the last level remain, which sit in its slots at or before
+    // the current one until the wheel turns over.
+    const std::size_t shift = LevelCount * SlotBits;
+    return ((current_tick_ >> shift) + 1) << shift;
+  }
+
+private:
+  // Value held until a given tick.
+  struct Entry {
+    // Tick until which the value is held.
+    uint64_t tick{0};
+
+    // Value.
+    Value value;
+  };
+
+  // Places a given entry into the slot of the level of the highest 8-bit group in which its tick
+  // differs from the current tick, or among the due entries if its tick is not after the current
+  // tick.
+  void Insert(Entry entry) {
+    if (entry.tick <= current_tick_) {
+      due_.push_back(std::move(entry));
+      return;
+    }
+    std::size_t level = 0;
+    while (level + 1 < LevelCount
+           && (entry.tick >> ((level + 1) * SlotBits))
+                  != (current_tick_ >> ((level + 1) * SlotBits))) {
+      ++level;
+    }
+    levels_[level][(entry.tick >> (level * SlotBits)) & (SlotCount - 1)].push_back(
+        std::move(entry));
+  }
+
+  // Moves the entries of the slots of the higher levels that the current tick just reached down
+  // to lower levels, from the highest level to the lowest.
+  void Cascade() {
+    std::size_t top = 0;
+    while (top + 1 < LevelCount
+           && (current_tick_ & ((uint64_t{1} << ((top + 1) * SlotBits)) - 1)) == 0) {
+      ++top;
+    }
+    for (std::size_t level = top; level > 0; --level) {
+      std::vector<Entry>& slot = levels_[level][(current_tick_ >> (level * SlotBits))
+                                                & (SlotCount - 1)];
+      std::vector<Entry> entries;
+      entries.swap(slot);
+      for (Entry& entry : entries) {
+        Insert(std::move(entry));
+      }
+    }
+  }
+
+  // Moves the values of the entries of a given slot into given released values, and empties it.
+  static void Release(std::vector<Entry>& slot, std::vector<Value>& released) {
+    for (Entry& entry : slot) {
+      released.push_back(std::move(entry.value));
+    }
+    slot.clear();
+  }
+
+  // Slots of each level, each holding the entries whose ticks fall in its range.
+  std::array<std::array<std::vector<Entry>, SlotCount>, LevelCount> levels_;
+
+  // Entries whose ticks are not after the current tick, released by the next advance.
+  std::vector<Entry> due_;
+
+  // Current tick: the last tick up to which this timer wheel advanced.
+  uint64_t current_tick_{0};
+
+  // Number of values held.
+  std::size_t size_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_TIMER_WHEEL_HPP
@@ -0,0 +1,395 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_TLS_HPP
+#define SECRET_SANTA_TLS_HPP
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+#include <string>
+
+#include "Socket.hpp"
+
+namespace SecretSanta {
+
+// Client side of TLS connections to one mail server. Verifies the certificate of the server against
+// a given certificate authority or the system's certificate authorities. Caches the most recent
+// session ticket issued by the server and resumes that session when opening additional or
+// replacement connections, which skips the expensive key exchange and certificate verification of
+// a full handshake. Counts how many handshakes were full and how many were resumed. Shared by all
+// connections of a transport; safe to use from several threads at once.
+class TlsClientContext {
+public:
+  // Constructor. Constructs a client context that trusts the certificate authorities in a given
+  // PEM file, or the system's certificate authorities if the path is empty. Sessions are resumed
+  // only if enabled.
+  explicit TlsClientContext(
+      const std::filesystem::path& certificate_authority_file = {}, const bool resume = true)
+    : resume_(resume) {
+    // OpenSSL writes to its sockets without suppressing the signal raised when the peer has closed
+    // the connection, which would otherwise terminate the program.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    context_ = SSL_CTX_new(TLS_client_method());
+    if (context_ == nullptr) {
+      std::cout << "Cannot create a TLS client context." << std::endl;
+      return;
+    }
+    SSL_CTX_set_min_proto_version(context_, TLS1_2_VERSION);
+    SSL_CTX_set_verify(context_, SSL_VERIFY_PEER, nullptr);
+
+    const int loaded =
+        certificate_authority_file.empty() ?
+            SSL_CTX_set_default_verify_paths(context_) :
+            SSL_CTX_load_verify_locations(
+                context_, certificate_authority_file.string().c_str(), nullptr);
+    if (loaded != 1) {
+      std::cout << "Cannot load the certificate authorities from " << certificate_authority_file
+                << "; please check that it is a PEM file." << std::endl;
+      SSL_CTX_free(context_);
+      context_ = nullptr;
+      return;
+    }
+
+    if (resume_) {
+      // Keep the sessions in this context rather than in the OpenSSL cache, which would be keyed by
+      // session identifier rather than by server.
+      SSL_CTX_set_session_cache_mode(
+          context_, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+      SSL_CTX_set_app_data(context_, this);
+      SSL_CTX_sess_set_new_cb(context_, &TlsClientContext::OnNewSession);
+    } else {
+      SSL_CTX_set_session_cache_mode(context_, SSL_SESS_CACHE_OFF);
+      SSL_CTX_set_options(context_, SSL_OP_NO_TICKET);
+    }
+  }
+
+  // Destructor. Releases the cached session and the OpenSSL context.
+  ~TlsClientContext() noexcept {
+    if (session_ != nullptr) {
+      SSL_SESSION_free(session_);
+    }
+    if (context_ != nullptr) {
+      SSL_CTX_free(context_);
+    }
+  }
+
+  // Deleted copy constructor.
+  TlsClientContext(const TlsClientContext& other) = delete;
+
+  // Deleted move constructor.
+  TlsClientContext(TlsClientContext&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  TlsClientContext& operator=(const TlsClientContext& other) = delete;
+
+  // Deleted move assignment operator.
+  TlsClientContext& operator=(TlsClientContext&& other) noexcept = delete;
+
+  // Whether this context was created successfully and can establish connections.
+  [[nodiscard]] bool IsValid() const noexcept {
+    return context_ != nullptr;
+  }
+
+  // Whether sessions are resumed.
+  [[nodiscard]] bool Resumes() const noexcept {
+    return resume_;
+  }
+
+  // Number of handshakes that completed with a full key exchange.
+  [[nodiscard]] uint64_t FullHandshakeCount() const noexcept {
+    return full_handshake_count_.load();
+  }
+
+  // Number of handshakes that resumed a previous session.
+  [[nodiscard]] uint64_t ResumedHandshakeCount() const noexcept {
+    return resumed_handshake_count_.load();
+  }
+
+  // Number of handshakes that failed.
+  [[nodiscard]] uint64_t FailedHandshakeCount() const noexcept {
+    return failed_handshake_count_.load();
+  }
+
+  // Performs the client side of a TLS handshake over a connected socket with the server at a given
+  // host, verifying that the certificate of the server is valid for that host. On success, attaches
+  // the TLS connection to the socket and returns true. While no session has been cached yet, only
+  // one handshake at a time is full and the others wait for its session ticket, so that a burst of
+  // new connections performs one full handshake rather than one per connection.
+  bool Handshake(Socket& socket, const std::string& host) {
+    if (context_ == nullptr) {
+      failed_handshake_count_.fetch_add(1);
+      return false;
+    }
+
+    SSL_SESSION* session = nullptr;
+    bool primes = false;
+    if (resume_) {
+      std::unique_lock<std::mutex> lock{session_mutex_};
+      session_condition_.wait_for(lock, std::chrono::seconds{10},
+                                  [this]() { return session_ != nullptr || !priming_; });
+      if (session_ != nullptr) {
+        // OpenSSL modifies the session of a connection during its handshake, so each connection
+        // resumes its own copy of the cached session.
+        session = SSL_SESSION_dup(session_);
+      } else if (!issues_no_sessions_) {
+        priming_ = true;
+        primes = true;
+      }
+    }
+
+    SSL* const tls = SSL_new(context_);
+    SSL_set_fd(tls, socket.Descriptor());
+    in6_addr address{};
+    if (::inet_pton(AF_INET, host.c_str(), &address) == 1
+        || ::inet_pton(AF_INET6, host.c_str(), &address) == 1) {
+      X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(tls), host.c_str());
+    } else {
+      SSL_set_tlsext_host_name(tls, host.c_str());
+      SSL_set1_host(tls, host.c_str());
+    }
+    if (session != nullptr) {
+      SSL_set_session(tls, session);
+      SSL_SESSION_free(session);
+    }
+
+    const bool connected = SSL_connect(tls) == 1;
+    if (connected && primes) {
+      // With TLS 1.3, the server sends its session tickets after the handshake, so wait for the
+      // first data from the server, which follows them.
+      char character;
+      static_cast<void>(SSL_peek(tls, &character, 1));
+    }
+    if (primes) {
+      {
+        const std::lock_guard<std::mutex> lock{session_mutex_};
+        priming_ = false;
+        // A server that issues no sessions would otherwise make every handshake wait for the
+        // previous one.
+        issues_no_sessions_ = connected && session_ == nullptr;
+      }
+      session_condition_.notify_all();
+    }
+
+    if (!connected) {
+      failed_handshake_count_.fetch_add(1);
+      SSL_free(tls);
+      return false;
+    }
+
+    if (SSL_session_reused(tls) == 1) {
+      resumed_handshake_count_.fetch_add(1);
+    } else {
+      full_handshake_count_.fetch_add(1);
+    }
+    socket.AttachTls(tls);
+    return true;
+  }
+
+  // Prints a summary of the handshakes to the console.
+  void PrintStatistics() const {
+    std::cout << "Performed " << FullHandshakeCount() << " full TLS handshakes and resumed "
+              << ResumedHandshakeCount() << " TLS sessions; " << FailedHandshakeCount()
+              << " TLS handshakes failed." << std::endl;
+  }
+
+private:
+  // Called by OpenSSL whenever the server issues a session ticket. Replaces the cached session.
+  // Returns 1 to keep the reference to the session.
+  static int OnNewSession(SSL* const tls, SSL_SESSION* const session) {
+    TlsClientContext* const context =
+        static_cast<TlsClientContext*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(tls)));
+    {
+      const std::lock_guard<std::mutex> lock{context->session_mutex_};
+      if (context->session_ != nullptr) {
+        SSL_SESSION_free(context->session_);
+      }
+      context->session_ = session;
+    }
+    context->session_condition_.notify_all();
+    return 1;
+  }
+
+  // Whether sessions are resumed.
+  bool resume_;
+
+  // OpenSSL context from which connections are created, or null if it could not be created.
+  SSL_CTX* context_{nullptr};
+
+  // Protects the cached session and whether a full handshake is obtaining one.
+  std::mutex session_mutex_;
+
+  // Notified when a session is cached or a full handshake that would obtain one finishes.
+  std::condition_variable session_condition_;
+
+  // Most recent session issued by the server, or null if none has been issued yet.
+  SSL_SESSION* session_{nullptr};
+
+  // Whether a full handshake that will obtain a session is in progress.
+  bool priming_{false};
+
+  // Whether a full handshake completed without the server issuing a session.
+  bool issues_no_sessions_{false};
+
+  // Number of handshakes that completed with a full key exchange.
+  std::atomic<uint64_t> full_handshake_count_{0};
+
+  // Number of handshakes that resumed a previous session.
+  std::atomic<uint64_t> resumed_handshake_count_{0};
+
+  // Number of handshakes that failed.
+  std::atomic<uint64_t> failed_handshake_count_{0};
+};
+
+// Server side of TLS connections, used by the local stand-in for a mail server. Presents a given
+// certificate and issues session tickets so that clients can resume their sessions. Counts how many
+// handshakes were full and how many were resumed. Safe to use from several threads at once.
+class TlsServerContext {
+public:
+  // Constructor. Constructs a server context that presents the certificate chain and private key in
+  // the given PEM files.
+  TlsServerContext(const std::filesystem::path& certificate_file,
+                   const std::filesystem::path& private_key_file) {
+    // OpenSSL writes to its sockets without suppressing the signal raised when the peer has closed
+    // the connection, which would otherwise terminate the program.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    context_ = SSL_CTX_new(TLS_server_method());
+    if (context_ == nullptr) {
+      std::cout << "Cannot create a TLS server context." << std::endl;
+      return;
+    }
+    SSL_CTX_set_min_proto_version(context_, TLS1_2_VERSION);
+
+    if (SSL_CTX_use_certificate_chain_file(context_, certificate_file.string().c_str()) != 1
+        || SSL_CTX_use_PrivateKey_file(
+               context_, private_key_file.string().c_str(), SSL_FILETYPE_PEM)
+               != 1
+        || SSL_CTX_check_private_key(context_) != 1) {
+      std::cout << "Cannot load the TLS certificate from " << certificate_file
+                << " and its private key from " << private_key_file
+                << "; please check that they are matching PEM files." << std::endl;
+      SSL_CTX_free(context_);
+      context_ = nullptr;
+      return;
+    }
+
+    static const unsigned char session_identifier_context[]{"secret-santa"};
+    SSL_CTX_set_session_id_context(
+        context_, session_identifier_context, sizeof(session_identifier_context) - 1);
+  }
+
+  // Destructor. Releases the OpenSSL context.
+  ~TlsServerContext() noexcept {
+    if (context_ != nullptr) {
+      SSL_CTX_free(context_);
+    }
+  }
+
+  // Deleted copy constructor.
+  TlsServerContext(const TlsServerContext& other) = delete;
+
+  // Deleted move constructor.
+  TlsServerContext(TlsServerContext&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  TlsServerContext& operator=(const TlsServerContext& other) = delete;
+
+  // Deleted move assignment operator.
+  TlsServerContext& operator=(TlsServerContext&& other) noexcept = delete;
+
+  // Whether this context was created successfully and can accept connections.
+  [[nodiscard]] bool IsValid() const noexcept {
+    return context_ != nullptr;
+  }
+
+  // Number of handshakes that completed with a full key exchange.
+  [[nodiscard]] uint64_t FullHandshakeCount() const noexcept {
+    return full_handshake_count_.load();
+  }
+
+  // Number of handshakes that resumed a previous session.
+  [[nodiscard]] uint64_t ResumedHandshakeCount() const noexcept {
+    return resumed_handshake_count_.load();
+  }
+
+  // Number of handshakes that failed.
+  [[nodiscard]] uint64_t FailedHandshakeCount() const noexcept {
+    return failed_handshake_count_.load();
+  }
+
+  // Performs the server side of a TLS handshake over an accepted socket. On success, attaches the
+  // TLS connection to the socket and returns true.
+  bool Handshake(Socket& socket) {
+    if (context_ == nullptr) {
+      failed_handshake_count_.fetch_add(1);
+      return false;
+    }
+
+    SSL* const tls = SSL_new(context_);
+    SSL_set_fd(tls, socket.Descriptor());
+    if (SSL_accept(tls) != 1) {
+      failed_handshake_count_.fetch_add(1);
+      SSL_free(tls);
+      return false;
+    }
+
+    if (SSL_session_reused(tls) == 1) {
+      resumed_handshake_count_.fetch_add(1);
+    } else {
+      full_handshake_count_.fetch_add(1);
+    }
+    socket.AttachTls(tls);
+    return true;
+  }
+
+  // Prints a summary of the handshakes to the console.
+  void PrintStatistics() const {
+    std::cout << "Accepted " << FullHandshakeCount() << " full TLS handshakes and "
+              << ResumedHandshakeCount() << " resumed TLS sessions; " << FailedHandshakeCount()
+              << " TLS handshakes failed." << std::endl;
+  }
+
+private:
+  // OpenSSL context from which connections are created, or null if it could not be created.
+  SSL_CTX* context_{nullptr};
+
+  // Number of handshakes that completed with a full key exchange.
+  std::atomic<uint64_t> full_handshake_count_{0};
+
+  // Number of handshakes that resumed a previous session.
+  std::atomic<uint64_t> resumed_handshake_count_{0};
+
+  // Number of handshakes that failed.
+  std::atomic<uint64_t> failed_handshake_count_{0};
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_TLS_HPP
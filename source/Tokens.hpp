@@ -0,0 +1,232 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_TOKENS_HPP
+#define SECRET_SANTA_TOKENS_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <system_error>
+#include <yaml-cpp/yaml.h>
+
+#include "Participant.hpp"
+
+namespace SecretSanta {
+
+// Secret tokens with which participants look up their giftees on the Secret Santa Lookup server,
+// one per participant. Each token is 128 random bits written as 32 hexadecimal digits, so that it
+// cannot be guessed. Tokens are generated alongside the matchings and kept in a YAML file that only
+// its owner can read. A participant keeps their token when the matchings are updated, so that a
+// token that was already handed out stays valid.
+class Tokens {
+public:
+  // Number of hexadecimal digits of each token.
+  static constexpr std::size_t Length{32};
+
+  // Default constructor. Constructs an empty set of tokens.
+  Tokens() = default;
+
+  // Constructor. Constructs tokens by reading them from a given YAML file. Entries that are
+  // malformed or that repeat a participant or a token are skipped.
+  explicit Tokens(const std::filesystem::path& path) {
+    if (!std::filesystem::exists(path)) {
+      std::cout << "Cannot find the YAML tokens file at " << path
+                << "; please check the file path." << std::endl;
+      return;
+    }
+
+    YAML::Node root = YAML::LoadFile(path.string());
+    if (!root) {
+      std::cout << "Cannot parse the YAML tokens file at " << path
+                << "; please check that it is a valid YAML file." << std::endl;
+      return;
+    }
+
+    YAML::Node participants_to_tokens = root["participants_to_tokens"];
+
+    if (participants_to_tokens && participants_to_tokens.IsMap()) {
+      std::set<std::string> tokens;
+      for (YAML::const_iterator participant_and_token = participants_to_tokens.begin();
+           participant_and_token != participants_to_tokens.end(); ++participant_and_token) {
+        const std::string name = participant_and_token->first.as<std::string>();
+        if (!participant_and_token->second.IsScalar()
+            || !IsToken(participant_and_token->second.as<std::string>())) {
+          std::cout << "Skipped the malformed token of " << name
+                    << " in the YAML tokens file at: " << path << std::endl;
+          continue;
+        }
+        const std::string token = participant_and_token->second.as<std::string>();
+        if (participants_to_tokens_.count(name) > 0 || !tokens.insert(token).second) {
+          std::cout << "Skipped the duplicate token of " << name
+                    << " in the YAML tokens file at: " << path << std::endl;
+          continue;
+        }
+        participants_to_tokens_.emplace(name, token);
+      }
+    }
+
+    std::cout << "Read " << participants_to_tokens_.size()
+              << " tokens from the YAML file at: " << path << std::endl;
+  }
+
+  // Destructor. Destroys this tokens object.
+  ~Tokens() noexcept = default;
+
+  // Deleted copy constructor.
+  Tokens(const Tokens& other) = delete;
+
+  // Deleted move constructor.
+  Tokens(Tokens&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  Tokens& operator=(const Tokens& other) = delete;
+
+  // Deleted move assignment operator.
+  Tokens& operator=(Tokens&& other) noexcept = delete;
+
+  // Map of participant names to their tokens.
+  [[nodiscard]] const std::map<std::string, std::string>& ParticipantsToTokens() const noexcept {
+    return participants_to_tokens_;
+  }
+
+  // Token of a given participant, or an empty string if the participant has none.
+  [[nodiscard]] std::string Token(const std::string& name) const {
+    const std::map<std::string, std::string>::const_iterator participant_and_token =
+        participants_to_tokens_.find(name);
+    return participant_and_token != participants_to_tokens_.cend() ? participant_and_token->second :
+                                                                     std::string{};
+  }
+
+  // Gives a new random token to each of the given participants who has none, and removes the
+  // tokens of those who are no longer participants. Returns the number of new tokens.
+  std::size_t Update(const std::set<Participant>& participants) {
+    std::set<std::string> tokens;
+    for (std::map<std::string, std::string>::iterator participant_and_token =
+             participants_to_tokens_.begin();
+         participant_and_token != participants_to_tokens_.end();) {
+      if (participants.count(Participant{participant_and_token->first}) == 0) {
+        participant_and_token = participants_to_tokens_.erase(participant_and_token);
+      } else {
+        tokens.insert(participant_and_token->second);
+        ++participant_and_token;
+      }
+    }
+
+    std::random_device random_device;
+    std::size_t created_count = 0;
+    for (const Participant& participant : participants) {
+      if (participants_to_tokens_.count(participant.Name()) > 0) {
+        continue;
+      }
+      std::string token = Generate(random_device);
+      while (!tokens.insert(token).second) {
+        token = Generate(random_device);
+      }
+      participants_to_tokens_.emplace(participant.Name(), token);
+      ++created_count;
+    }
+    return created_count;
+  }
+
+  // Writes these tokens to a given YAML file that only its owner can read and write. Returns
+  // whether the file was written, or true if the path is empty.
+  bool Write(const std::filesystem::path& path) const {
+    if (path.empty()) {
+      return true;
+    }
+
+    if (!path.parent_path().empty()) {
+      std::error_code error;
+      std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream stream{path.string()};
+    if (!stream.is_open()) {
+      std::cout << "Could not open the YAML tokens file for writing at: " << path.string()
+                << std::endl;
+      return false;
+    }
+
+    // Restrict the permissions before writing, such that the tokens are never readable by others.
+    std::filesystem::permissions(
+        path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+
+    YAML::Emitter emitter;
+    emitter << YAML::BeginMap;
+    emitter << YAML::Key << "participants_to_tokens";
+    emitter << YAML::Value << participants_to_tokens_;
+    emitter << YAML::EndMap;
+
+    stream << emitter.c_str() << std::endl;
+    stream.close();
+    if (!stream) {
+      std::cout << "Could not write the YAML tokens file at: " << path.string() << std::endl;
+      return false;
+    }
+
+    std::cout << "Wrote " << participants_to_tokens_.size() << " tokens to the YAML file: " << path
+              << std::endl;
+    return true;
+  }
+
+  // Whether a given text has the form of a token.
+  [[nodiscard]] static bool IsToken(const std::string_view text) noexcept {
+    if (text.size() != Length) {
+      return false;
+    }
+    for (const char character : text) {
+      if ((character < '0' || character > '9') && (character < 'a' || character > 'f')) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  // Generates a new random token from a given source of random numbers.
+  [[nodiscard]] static std::string Generate(std::random_device& random_device) {
+    static constexpr std::array<char, 16> Digits{
+      '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    std::string token;
+    token.reserve(Length);
+    while (token.size() < Length) {
+      uint32_t bits = random_device();
+      for (std::size_t digit = 0; digit < 8 && token.size() < Length; ++digit) {
+        token.push_back(Digits[bits & 0xF]);
+        bits >>= 4;
+      }
+    }
+    return token;
+  }
+
+  // Map of participant names to their tokens.
+  std::map<std::string, std::string> participants_to_tokens_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_TOKENS_HPP
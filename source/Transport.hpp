@@ -0,0 +1,137 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_TRANSPORT_HPP
+#define SECRET_SANTA_TRANSPORT_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "EmailMessage.hpp"
+
+namespace SecretSanta {
+
+// Status of an attempt to deliver an email message.
+enum class DeliveryStatus : int8_t {
+  // The email message was accepted for delivery.
+  Delivered,
+
+  // The email message could not be delivered, but a later attempt may succeed.
+  TransientFailure,
+
+  // The email message could not be delivered, and a later attempt would fail again.
+  PermanentFailure,
+};
+
+// Outcome of an attempt to deliver an email message.
+class Delivery {
+public:
+  // Default constructor. Constructs a successful delivery outcome with no details.
+  Delivery() = default;
+
+  // Constructor. Constructs a delivery outcome from a given status and details, such as the
+  // response of a mail server.
+  Delivery(const DeliveryStatus status, std::string details)
+    : status_(status), details_(std::move(details)) {}
+
+  // Destructor. Destroys this delivery outcome.
+  ~Delivery() noexcept = default;
+
+  // Copy constructor. Constructs a delivery outcome by copying another one.
+  Delivery(const Delivery& other) = default;
+
+  // Move constructor. Constructs a delivery outcome by moving another one.
+  Delivery(Delivery&& other) noexcept = default;
+
+  // Copy assignment operator. Assigns this delivery outcome by copying another one.
+  Delivery& operator=(const Delivery& other) = default;
+
+  // Move assignment operator. Assigns this delivery outcome by moving another one.
+  Delivery& operator=(Delivery&& other) noexcept = default;
+
+  // Status of the delivery attempt.
+  [[nodiscard]] DeliveryStatus Status() const noexcept {
+    return status_;
+  }
+
+  // Whether the email message was accepted for delivery.
+  [[nodiscard]] bool Succeeded() const noexcept {
+    return status_ == DeliveryStatus::Delivered;
+  }
+
+  // Details of the delivery attempt, such as the response of a mail server or the command that
+  // failed.
+  [[nodiscard]] const std::string& Details() const noexcept {
+    return details_;
+  }
+
+private:
+  // Status of the delivery attempt.
+  DeliveryStatus status_{DeliveryStatus::Delivered};
+
+  // Details of the delivery attempt.
+  std::string details_;
+};
+
+// Means of delivering email messages, such as the S-nail utility or a connection to a mail server.
+// Delivery may be asynchronous: a transport may hold several email messages in flight at once and
+// report each outcome later, possibly from another thread.
+class Transport {
+public:
+  // Function invoked once the delivery of an email message completes, with the email message and
+  // the outcome of its delivery.
+  using Completion = std::function<void(const EmailMessage& message, const Delivery& delivery)>;
+
+  // Default constructor. Constructs a transport.
+  Transport() = default;
+
+  // Destructor. Destroys this transport.
+  virtual ~Transport() noexcept = default;
+
+  // Deleted copy constructor.
+  Transport(const Transport& other) = delete;
+
+  // Deleted move constructor.
+  Transport(Transport&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  Transport& operator=(const Transport& other) = delete;
+
+  // Deleted move assignment operator.
+  Transport& operator=(Transport&& other) noexcept = delete;
+
+  // Short human-readable name of this transport.
+  [[nodiscard]] virtual std::string Name() const = 0;
+
+  // Starts delivering an email message and invokes the given completion function once its delivery
+  // completes. The completion function may be invoked from any thread, including the calling
+  // thread before this function returns. May block while this transport is at capacity, which
+  // applies backpressure to the caller.
+  virtual void Send(EmailMessage message, Completion completion) = 0;
+
+  // Blocks until the deliveries of all email messages sent so far have completed.
+  virtual void Flush() = 0;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_TRANSPORT_HPP
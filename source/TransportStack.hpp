@@ -0,0 +1,194 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_TRANSPORT_STACK_HPP
+#define SECRET_SANTA_TRANSPORT_STACK_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "EventLoopSmtpTransport.hpp"
+#include "RetryingTransport.hpp"
+#include "RoutingTransport.hpp"
+#include "SmtpTransport.hpp"
+#include "SNailTransport.hpp"
+#include "Spool.hpp"
+#include "SpoolTransport.hpp"
+#include "Tls.hpp"
+#include "Transport.hpp"
+
+namespace SecretSanta {
+
+// Options that determine how email messages are sent: over SMTP to one or more mail servers, into
+// a spool directory, or otherwise through the S-nail utility, with retries of the deliveries that
+// fail transiently.
+struct TransportOptions {
+  // Hosts and ports of the mail servers to which the email messages are sent directly over SMTP.
+  // If several are given, the email messages are spread among them as relays. If none are given,
+  // the email messages are written into the spool directory if one is given, or otherwise sent
+  // through the S-nail utility.
+  std::vector<std::pair<std::string, uint16_t>> relays;
+
+  // Email address from which the email messages are sent over SMTP.
+  std::string from{"secret-santa@localhost"};
+
+  // Number of connections to each mail server.
+  std::size_t connections{1};
+
+  // Optional number of event loop threads that multiplex the connections to each mail server. If
+  // no value is specified, each connection is served by its own thread.
+  std::optional<std::size_t> event_loops;
+
+  // Whether every connection to a mail server is encrypted with TLS from its start.
+  bool tls{false};
+
+  // Path to a PEM file of the certificate authorities trusted to sign the certificates of the mail
+  // servers. If empty, the system's certificate authorities are trusted.
+  std::filesystem::path ca_file;
+
+  // Path to a spool directory into which the email messages are written as files instead of being
+  // sent. Only used if no mail server is given.
+  std::filesystem::path spool_directory;
+
+  // Maximum number of attempts to send each email message whose delivery fails transiently.
+  std::size_t attempts{4};
+};
+
+// Transports through which email messages are sent, built from transport options: a transport per
+// mail server, behind a routing transport if there are several, or a spool or S-nail transport,
+// all behind a retrying transport. Shared by the programs that send email messages so that they
+// all send them the same way.
+class TransportStack {
+public:
+  // Constructor. Builds the transports given by some transport options. Prints a message and
+  // leaves this stack invalid if a TLS context or the spool directory cannot be created.
+  explicit TransportStack(const TransportOptions& options) {
+    // Each mail server gets its own TLS context, since TLS sessions can only be resumed with the
+    // mail server that issued them.
+    std::vector<Relay> relays;
+    for (const std::pair<std::string, uint16_t>& relay : options.relays) {
+      TlsClientContext* tls = nullptr;
+      if (options.tls) {
+        tls_contexts_.push_back(std::make_unique<TlsClientContext>(options.ca_file));
+        if (!tls_contexts_.back()->IsValid()) {
+          return;
+        }
+        tls = tls_contexts_.back().get();
+      }
+
+      std::unique_ptr<SecretSanta::Transport> relay_transport;
+      if (options.event_loops.has_value()) {
+        relay_transport = std::make_unique<EventLoopSmtpTransport>(
+            relay.first, relay.second, options.from, options.connections,
+            options.event_loops.value());
+      } else {
+        relay_transport = std::make_unique<SmtpTransport>(
+            relay.first, relay.second, options.from, options.connections, tls);
+      }
+
+      relays.push_back(
+          Relay{relay.first + ":" + std::to_string(relay.second), std::move(relay_transport),
+                [relay, tls]() { return ProbeSmtpServer(relay.first, relay.second, tls); }});
+    }
+
+    if (relays.size() > 1) {
+      std::unique_ptr<RoutingTransport> routing_transport{
+          std::make_unique<RoutingTransport>(std::move(relays))};
+      router_ = routing_transport.get();
+      transport_ = std::move(routing_transport);
+    } else if (relays.size() == 1) {
+      transport_ = std::move(relays.front().transport);
+    } else if (!options.spool_directory.empty()) {
+      const Spool spool{options.spool_directory};
+      if (!spool.Create()) {
+        return;
+      }
+      transport_ = std::make_unique<SpoolTransport>(spool, options.from);
+    } else {
+      transport_ = std::make_unique<SNailTransport>();
+    }
+
+    RetryPolicy retry_policy;
+    retry_policy.maximum_attempts = options.attempts;
+    retrying_transport_ = std::make_unique<RetryingTransport>(*transport_, retry_policy);
+  }
+
+  // Destructor. Waits for all email messages, including those waiting to be retried, and then
+  // destroys the transports.
+  ~TransportStack() noexcept = default;
+
+  // Deleted copy constructor.
+  TransportStack(const TransportStack& other) = delete;
+
+  // Deleted move constructor.
+  TransportStack(TransportStack&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  TransportStack& operator=(const TransportStack& other) = delete;
+
+  // Deleted move assignment operator.
+  TransportStack& operator=(TransportStack&& other) noexcept = delete;
+
+  // Whether the transports were built.
+  [[nodiscard]] bool IsValid() const noexcept {
+    return retrying_transport_ != nullptr;
+  }
+
+  // Transport through which email messages are sent, which retries the deliveries that fail
+  // transiently and keeps the outcome of every email message. Only available if this stack is
+  // valid.
+  [[nodiscard]] RetryingTransport& Transport() noexcept {
+    return *retrying_transport_;
+  }
+
+  // Prints the statistics of the mail servers and of their TLS sessions to the console, if any.
+  void PrintStatistics() const {
+    if (router_ != nullptr) {
+      router_->PrintStatistics();
+    }
+
+    for (const std::unique_ptr<TlsClientContext>& tls : tls_contexts_) {
+      tls->PrintStatistics();
+    }
+  }
+
+private:
+  // TLS contexts of the mail servers, one per mail server.
+  std::vector<std::unique_ptr<TlsClientContext>> tls_contexts_;
+
+  // Transport that delivers the email messages.
+  std::unique_ptr<SecretSanta::Transport> transport_;
+
+  // Routing transport among the mail servers, if there are several, or null otherwise.
+  RoutingTransport* router_{nullptr};
+
+  // Transport that retries the deliveries of the transport that fail transiently. Null if the
+  // transports could not be built.
+  std::unique_ptr<RetryingTransport> retrying_transport_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_TRANSPORT_STACK_HPP
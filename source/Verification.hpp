@@ -0,0 +1,661 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#ifndef SECRET_SANTA_VERIFICATION_HPP
+#define SECRET_SANTA_VERIFICATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "MappedFile.hpp"
+#include "Matchings.hpp"
+#include "Participant.hpp"
+#include "StringIndex.hpp"
+
+namespace SecretSanta {
+
+// Structural verification of matchings against a set of participants. Checks that every participant
+// gifts and receives the same number of gifts, once per round of gifts, that no participant gifts
+// to themselves or twice to the same giftee, and that every name in the matchings is a known
+// participant. The participant names are first mapped to integer identifiers, and then the
+// matchings are checked in one linear pass over these identifiers. A YAML matchings file in the
+// form written by the Secret Santa Randomizer is read straight from a memory mapping of the file,
+// a few thousand entries at a time, and the giftees of these entries are looked up together so
+// that their memory accesses overlap. Any other YAML matchings file is parsed with yaml-cpp, which
+// is dozens of times slower and holds the whole file as YAML nodes in memory.
+class Verification {
+public:
+  // Default constructor. Constructs a verification of no matchings against no participants, which
+  // is valid.
+  Verification() = default;
+
+  // Constructor. Verifies in-memory matchings against a set of participants. The rounds of gifts
+  // are walked side by side in the order of their gifters, so that the giftees of each gifter are
+  // gathered without searching the rounds and without allocating memory for each gifter.
+  Verification(const std::set<Participant>& participants, const Matchings& matchings)
+    : index_(ParticipantNames(participants)) {
+    Initialize(matchings.GiftCount());
+    std::vector<std::map<std::string, std::string>::const_iterator> positions;
+    positions.reserve(matchings.GiftCount());
+    for (const std::map<std::string, std::string>& round : matchings.Rounds()) {
+      positions.push_back(round.cbegin());
+    }
+    std::vector<std::string_view> giftees(matchings.GiftCount());
+    std::size_t entry = 0;
+    for (const std::pair<const std::string, std::string>& gifter_and_giftee :
+         matchings.GiftersToGiftees()) {
+      std::size_t giftee_count = 0;
+      for (std::size_t round = 0; round < positions.size(); ++round) {
+        const std::map<std::string, std::string>& gifters_to_giftees = matchings.Rounds()[round];
+        while (positions[round] != gifters_to_giftees.cend()
+               && positions[round]->first < gifter_and_giftee.first) {
+          ++positions[round];
+        }
+        if (positions[round] != gifters_to_giftees.cend()
+            && positions[round]->first == gifter_and_giftee.first) {
+          giftees[giftee_count] = positions[round]->second;
+          ++giftee_count;
+        }
+      }
+      Check(++entry, gifter_and_giftee.first, {giftees.data(), giftee_count});
+    }
+    Finalize();
+  }
+
+  // Constructor. Verifies the matchings of a YAML matchings file against a set of participants.
+  // Unlike reading the file into matchings, this also reports malformed and duplicate entries. The
+  // number of gifts that each participant must give and receive is the largest number of giftees
+  // of any entry.
+  Verification(const std::set<Participant>& participants, const std::filesystem::path& path)
+    : Verification(ParticipantNames(participants), path) {}
+
+  // Constructor. Verifies the matchings of a YAML matchings file against the participants of a
+  // given index of participant names, whose identifiers become the identifiers of the participants.
+  Verification(StringIndex participant_names, const std::filesystem::path& path)
+    : index_(std::move(participant_names)) {
+    const MappedFile file{path};
+    if (!file.IsValid()) {
+      Initialize(1);
+      AddDiagnostic("Cannot find the YAML matchings file at " + path.string() + ".");
+      Finalize();
+      return;
+    }
+
+    // The number of gifts is taken from the first entry. In the rare case where a later entry has
+    // more giftees, the entries are checked again with the largest number of giftees.
+    Initialize(1);
+    const std::optional<std::size_t> largest_giftee_count = VerifyEntries(file.Text());
+    if (!largest_giftee_count.has_value()) {
+      VerifyYaml(path);
+      return;
+    }
+    if (largest_giftee_count.value() > gift_count_) {
+      Initialize(largest_giftee_count.value());
+      static_cast<void>(VerifyEntries(file.Text()));
+    }
+    Finalize();
+  }
+
+  // Destructor. Destroys this verification object.
+  ~Verification() noexcept = default;
+
+  // Deleted copy constructor.
+  Verification(const Verification& other) = delete;
+
+  // Deleted move constructor.
+  Verification(Verification&& other) noexcept = delete;
+
+  // Deleted copy assignment operator.
+  Verification& operator=(const Verification& other) = delete;
+
+  // Deleted move assignment operator.
+  Verification& operator=(Verification&& other) noexcept = delete;
+
+  // Whether the matchings are a valid set of matchings for the participants: every participant
+  // gifts and receives the same number of gifts, and no participant gifts to themselves or twice to
+  // the same giftee.
+  [[nodiscard]] bool IsValid() const noexcept {
+    return problem_count_ == 0;
+  }
+
+  // Total number of problems found.
+  [[nodiscard]] std::size_t ProblemCount() const noexcept {
+    return problem_count_;
+  }
+
+  // Descriptions of the problems found, in the order in which they were found. At most
+  // MaximumDiagnosticCount descriptions are kept; the total number of problems is given by
+  // ProblemCount.
+  [[nodiscard]] const std::vector<std::string>& Diagnostics() const noexcept {
+    return diagnostics_;
+  }
+
+  // Prints the outcome of this verification to a given stream, which defaults to the console.
+  void Print(std::ostream& stream = std::cout) const {
+    if (IsValid() && gift_count_ == 1) {
+      stream << "The matchings are valid: each of the " << gifter_entries_.size()
+             << " participants gifts exactly once and receives exactly once." << std::endl;
+      return;
+    }
+    if (IsValid()) {
+      stream << "The matchings are valid: each of the " << gifter_entries_.size()
+             << " participants gifts " << gift_count_ << " times and receives " << gift_count_
+             << " times, each time with a different participant." << std::endl;
+      return;
+    }
+
+    stream << "The matchings are invalid. Found " << problem_count_ << " problems:" << std::endl;
+    for (const std::string& diagnostic : diagnostics_) {
+      stream << "- " << diagnostic << std::endl;
+    }
+    if (problem_count_ > diagnostics_.size()) {
+      stream << "- ... and " << problem_count_ - diagnostics_.size() << " more problems."
+             << std::endl;
+    }
+  }
+
+  // Maximum number of problem descriptions kept.
+  static constexpr std::size_t MaximumDiagnosticCount{1000};
+
+private:
+  // Entry number indicating that a participant does not appear in any entry.
+  static constexpr uint32_t NoEntry{0};
+
+
+  // Number of entries of a YAML matchings file that are read and then checked together.
+  static constexpr std::size_t ChunkEntryCount{4096};
+
+  // Number of entries ahead of the entry being checked whose giftees are prefetched.
+  static constexpr std::size_t PrefetchEntryCount{8};
+
+  // Context of a plain scalar of a YAML matchings file, which determines what ends it.
+  enum class ScalarContext : int8_t {
+    Key,
+    Value,
+    Flow,
+  };
+
+  // Gifts that a participant receives.
+  struct Receipt {
+    // Number of gifts received.
+    uint32_t count{0};
+
+    // Last entry in which a gift is received, or NoEntry if none.
+    uint32_t entry{NoEntry};
+  };
+
+  // Maps the names of a set of participants to integer identifiers, in the order of the set.
+  [[nodiscard]] static StringIndex ParticipantNames(const std::set<Participant>& participants) {
+    StringIndex index{participants.size()};
+    for (const Participant& participant : participants) {
+      index.Insert(participant.Name());
+    }
+    return index;
+  }
+
+  // Starts over with no problems found, given the number of gifts that each participant must give
+  // and receive.
+  void Initialize(const std::size_t gift_count) {
+    gift_count_ = gift_count;
+    gifter_entries_.assign(index_.Size(), NoEntry);
+    giftee_receipts_.assign(index_.Size(), Receipt{});
+    previous_gifter_identifier_ = StringIndex::NotFound;
+    problem_count_ = 0;
+    diagnostics_.clear();
+  }
+
+  // Verifies the entries of a YAML matchings file in the form written by the Secret Santa
+  // Randomizer, which is a "gifters_to_giftees:" key followed by one line per entry of the form
+  // "  - <gifter>: <giftee>" or "  - <gifter>: [<giftee>, ...]", where every name is a plain
+  // scalar. Returns the largest number of giftees of any entry, or nothing as soon as the text
+  // departs from this form, in which case the file must be parsed with yaml-cpp instead. Entries
+  // are only checked until one of them has more giftees than the number of gifts.
+  [[nodiscard]] std::optional<std::size_t> VerifyEntries(std::string_view text) {
+    if (text.substr(0, 4) == "---\n") {
+      text.remove_prefix(4);
+    }
+    constexpr std::string_view key{"gifters_to_giftees:\n"};
+    if (text.substr(0, key.size()) != key) {
+      return std::nullopt;
+    }
+    text.remove_prefix(key.size());
+
+    // Beginning of the line of every entry, which is that of the first entry.
+    const std::size_t indentation = std::min(text.find_first_not_of(' '), text.size());
+    const std::string_view prefix = text.substr(0, indentation + 2);
+    if (!text.empty() && prefix.substr(indentation) != "- ") {
+      return std::nullopt;
+    }
+
+    std::vector<std::string_view> gifters;
+    std::vector<std::string_view> giftees;
+    std::vector<std::size_t> giftee_ends;
+    std::vector<uint32_t> giftee_identifiers;
+    gifters.reserve(ChunkEntryCount);
+    giftee_ends.reserve(ChunkEntryCount);
+
+    const char* position = text.data();
+    const char* const end = text.data() + text.size();
+    std::size_t largest_giftee_count = 0;
+    std::size_t entry = 0;
+    bool checking = true;
+    while (position != end) {
+      gifters.clear();
+      giftees.clear();
+      giftee_ends.clear();
+      while (position != end && gifters.size() < ChunkEntryCount) {
+        position = ReadEntry(position, end, prefix, gifters, giftees);
+        if (position == nullptr) {
+          return std::nullopt;
+        }
+        giftee_ends.push_back(giftees.size());
+      }
+
+      if (checking) {
+        giftee_identifiers.resize(giftees.size());
+        index_.FindAll(giftees, giftee_identifiers);
+      }
+
+      for (std::size_t index = 0; index < gifters.size(); ++index) {
+        ++entry;
+        const std::size_t giftee_start = index == 0 ? 0 : giftee_ends[index - 1];
+        const std::size_t giftee_count = giftee_ends[index] - giftee_start;
+        largest_giftee_count = std::max(largest_giftee_count, giftee_count);
+        if (entry == 1) {
+          gift_count_ = std::max(gift_count_, giftee_count);
+        }
+        checking = checking && giftee_count <= gift_count_;
+        if (!checking) {
+          continue;
+        }
+
+        if (index + PrefetchEntryCount < gifters.size()) {
+          for (std::size_t giftee = giftee_ends[index + PrefetchEntryCount - 1];
+               giftee < giftee_ends[index + PrefetchEntryCount]; ++giftee) {
+            if (giftee_identifiers[giftee] != StringIndex::NotFound) {
+              __builtin_prefetch(&giftee_receipts_[giftee_identifiers[giftee]]);
+            }
+          }
+        }
+
+        Check(entry, gifters[index], GifterIdentifier(gifters[index]),
+              {giftees.data() + giftee_start, giftee_count},
+              {giftee_identifiers.data() + giftee_start, giftee_count});
+      }
+    }
+    return largest_giftee_count;
+  }
+
+  // Reads the entry of a YAML matchings file whose line starts at a given position and appends its
+  // gifter and giftees. Returns the position of the next line, or null if the line is not of the
+  // form "<prefix><gifter>: <giftee>" or "<prefix><gifter>: [<giftee>, ...]" with plain scalars.
+  [[nodiscard]] static const char* ReadEntry(
+      const char* position, const char* const end, const std::string_view prefix,
+      std::vector<std::string_view>& gifters, std::vector<std::string_view>& giftees) {
+    if (static_cast<std::size_t>(end - position) < prefix.size()
+        || std::string_view{position, prefix.size()} != prefix) {
+      return nullptr;
+    }
+    position += prefix.size();
+
+    const char* scalar_end = ScanPlainScalar(position, end, ScalarContext::Key);
+    if (scalar_end == nullptr) {
+      return nullptr;
+    }
+    gifters.emplace_back(position, static_cast<std::size_t>(scalar_end - position));
+    position = scalar_end + 2;
+
+    if (position == end || *position != '[') {
+      scalar_end = ScanPlainScalar(position, end, ScalarContext::Value);
+      if (scalar_end == nullptr) {
+        return nullptr;
+      }
+      giftees.emplace_back(position, static_cast<std::size_t>(scalar_end - position));
+      return scalar_end + 1;
+    }
+
+    ++position;
+    while (true) {
+      scalar_end = ScanPlainScalar(position, end, ScalarContext::Flow);
+      if (scalar_end == nullptr) {
+        return nullptr;
+      }
+      giftees.emplace_back(position, static_cast<std::size_t>(scalar_end - position));
+      if (*scalar_end == ']') {
+        position = scalar_end + 1;
+        break;
+      }
+      if (end - scalar_end < 2 || scalar_end[1] != ' ') {
+        return nullptr;
+      }
+      position = scalar_end + 2;
+    }
+    if (position == end || *position != '\n') {
+      return nullptr;
+    }
+    return position + 1;
+  }
+
+  // Returns the end of the plain scalar that starts at a given position, which is followed by ": "
+  // for a key, by a line feed for a value, and by "," or "]" for an element of a flow sequence.
+  // Returns null if the text there is not a plain scalar that yaml-cpp reads as is. Rejects more
+  // than is needed, such as scalars that start with an indicator character, since such names are
+  // rare and the file is then parsed with yaml-cpp instead.
+  [[nodiscard]] static const char* ScanPlainScalar(
+      const char* const start, const char* const end, const ScalarContext context) noexcept {
+    if (start == end || IsScalarStartIndicator(*start)) {
+      return nullptr;
+    }
+
+    for (const char* position = start; position != end; ++position) {
+      if (!IsScalarSpecialCharacter(*position)) {
+        continue;
+      }
+      switch (*position) {
+        case '\n':
+          return context == ScalarContext::Value ? EndPlainScalar(start, position) : nullptr;
+        case ':':
+          if (position + 1 != end && position[1] == ' ') {
+            return context == ScalarContext::Key ? EndPlainScalar(start, position) : nullptr;
+          }
+          if (position + 1 == end || position[1] == '\n'
+              || (context == ScalarContext::Flow && (position[1] == ',' || position[1] == ']'))) {
+            return nullptr;
+          }
+          break;
+        case '#':
+          if (position[-1] == ' ') {
+            return nullptr;
+          }
+          break;
+        case ',':
+        case ']':
+          if (context == ScalarContext::Flow) {
+            return EndPlainScalar(start, position);
+          }
+          break;
+        case '[':
+        case '{':
+        case '}':
+          if (context == ScalarContext::Flow) {
+            return nullptr;
+          }
+          break;
+        default:
+          return nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns a given end of a plain scalar that starts at a given position, or null if yaml-cpp does
+  // not read this scalar as is because it ends with a space or is a null value.
+  [[nodiscard]] static const char* EndPlainScalar(
+      const char* const start, const char* const end) noexcept {
+    const std::string_view scalar{start, static_cast<std::size_t>(end - start)};
+    if (scalar.empty() || scalar.back() == ' ' || scalar == "~" || scalar == "null"
+        || scalar == "Null" || scalar == "NULL") {
+      return nullptr;
+    }
+    return end;
+  }
+
+  // Whether a plain scalar that starts with a given character is rejected.
+  [[nodiscard]] static bool IsScalarStartIndicator(const char character) noexcept {
+    return std::string_view{" -?:,[]{}#&*!|>'\"%@`"}.find(character) != std::string_view::npos;
+  }
+
+  // Whether a given character of a plain scalar must be looked at more closely, which is the case
+  // of the line feed, the indicator characters that may end a plain scalar, and the control
+  // characters that yaml-cpp treats as white space.
+  [[nodiscard]] static bool IsScalarSpecialCharacter(const char character) noexcept {
+    static constexpr std::array<bool, 256> special{[]() {
+      std::array<bool, 256> table{};
+      for (const unsigned char character : std::string_view{"\n\t\r:#,[]{}"}) {
+        table[character] = true;
+      }
+      return table;
+    }()};
+    return special[static_cast<unsigned char>(character)];
+  }
+
+  // Verifies the matchings of a YAML matchings file by parsing it with yaml-cpp, for the files
+  // that are not in the form written by the Secret Santa Randomizer.
+  void VerifyYaml(const std::filesystem::path& path) {
+    const YAML::Node root = YAML::LoadFile(path.string());
+    const YAML::Node gifters_to_giftees = root ? root["gifters_to_giftees"] : YAML::Node{};
+    if (!gifters_to_giftees || !gifters_to_giftees.IsSequence()) {
+      Initialize(1);
+      AddDiagnostic("The YAML matchings file at " + path.string()
+                    + " does not contain a \"gifters_to_giftees\" sequence.");
+      Finalize();
+      return;
+    }
+
+    // Read the giftees of every entry first, since the number of gifts is only known at the end.
+    std::vector<std::optional<std::vector<std::string_view>>> entries_giftees;
+    std::size_t gift_count = 1;
+    for (const YAML::Node& gifter_to_giftee : gifters_to_giftees) {
+      entries_giftees.push_back(ReadGiftees(gifter_to_giftee));
+      if (entries_giftees.back().has_value()) {
+        gift_count = std::max(gift_count, entries_giftees.back()->size());
+      }
+    }
+
+    Initialize(gift_count);
+    std::size_t entry = 0;
+    for (const YAML::Node& gifter_to_giftee : gifters_to_giftees) {
+      const std::optional<std::vector<std::string_view>>& giftees = entries_giftees[entry];
+      ++entry;
+      if (!giftees.has_value()) {
+        AddDiagnostic("Entry " + std::to_string(entry)
+                      + " is malformed; it must be of the form \"<gifter>: <giftee>\" or "
+                        "\"<gifter>: [<giftee>, ...]\".");
+        continue;
+      }
+      Check(entry, gifter_to_giftee.begin()->first.Scalar(), giftees.value());
+    }
+
+    Finalize();
+  }
+
+  // Reads the giftees of one entry of a YAML matchings file, which must map one gifter to either
+  // one giftee or a non-empty sequence of giftees. Returns nothing if the entry is malformed. The
+  // returned names view the scalars of the YAML nodes.
+  [[nodiscard]] static std::optional<std::vector<std::string_view>> ReadGiftees(
+      const YAML::Node& gifter_to_giftee) {
+    if (!gifter_to_giftee.IsMap() || gifter_to_giftee.size() != 1
+        || !gifter_to_giftee.begin()->first.IsScalar()) {
+      return std::nullopt;
+    }
+    const YAML::Node giftees = gifter_to_giftee.begin()->second;
+    if (giftees.IsScalar()) {
+      return std::vector<std::string_view>{giftees.Scalar()};
+    }
+    if (!giftees.IsSequence() || giftees.size() == 0) {
+      return std::nullopt;
+    }
+    std::vector<std::string_view> names;
+    for (const YAML::Node& giftee : giftees) {
+      if (!giftee.IsScalar()) {
+        return std::nullopt;
+      }
+      names.push_back(giftee.Scalar());
+    }
+    return names;
+  }
+
+
+  // Identifier of a given gifter, or NotFound if the gifter is not a participant. The gifter is
+  // first compared with the participant that follows the gifter of the previous entry, since
+  // matchings are usually written in the order of the participants, which is that of their
+  // identifiers when they come from a set of participants, and the gifter is then found without
+  // hashing it.
+  [[nodiscard]] uint32_t GifterIdentifier(const std::string_view gifter) {
+    // The participant of identifier zero follows when there is no previous gifter.
+    const uint32_t next_identifier = previous_gifter_identifier_ + 1;
+    const uint32_t identifier =
+        next_identifier < index_.Size() && index_.Key(next_identifier) == gifter ?
+            next_identifier :
+            index_.Find(gifter);
+    if (identifier != StringIndex::NotFound) {
+      previous_gifter_identifier_ = identifier;
+    }
+    return identifier;
+  }
+
+  // Checks one entry of the matchings given the names of its gifter and giftees, which are looked
+  // up one by one.
+  void Check(const std::size_t entry, const std::string_view gifter,
+             const std::span<const std::string_view> giftees) {
+    giftee_identifiers_.resize(giftees.size());
+    for (std::size_t index = 0; index < giftees.size(); ++index) {
+      giftee_identifiers_[index] = index_.Find(giftees[index]);
+    }
+    Check(entry, gifter, GifterIdentifier(gifter), giftees, giftee_identifiers_);
+  }
+
+  // Checks one entry of the matchings given the names and identifiers of its gifter and giftees,
+  // where entries are numbered starting at one. Only allocates memory when a problem is found.
+  void Check(const std::size_t entry, const std::string_view gifter,
+             const uint32_t gifter_identifier, const std::span<const std::string_view> giftees,
+             const std::span<const uint32_t> giftee_identifiers) {
+    if (gifter_identifier == StringIndex::NotFound) {
+      AddDiagnostic(EntryPrefix(entry) + "the gifter " + Quoted(gifter) + " is not a participant.");
+    } else if (gifter_entries_[gifter_identifier] != NoEntry) {
+      AddDiagnostic(EntryPrefix(entry) + Quoted(gifter) + " already gifts in entry "
+                    + std::to_string(gifter_entries_[gifter_identifier]) + ".");
+    } else {
+      gifter_entries_[gifter_identifier] = static_cast<uint32_t>(entry);
+    }
+
+    if (giftees.size() != gift_count_) {
+      AddDiagnostic(EntryPrefix(entry) + "the number of giftees of " + Quoted(gifter) + " is "
+                    + std::to_string(giftees.size()) + " instead of "
+                    + std::to_string(gift_count_) + ".");
+    }
+
+    for (std::size_t index = 0; index < giftees.size(); ++index) {
+      const std::string_view giftee = giftees[index];
+
+      if (std::find(giftees.begin(), giftees.begin() + index, giftee)
+          != giftees.begin() + index) {
+        AddDiagnostic(EntryPrefix(entry) + Quoted(gifter) + " gifts to " + Quoted(giftee)
+                      + " more than once.");
+        continue;
+      }
+
+      const uint32_t giftee_identifier = giftee_identifiers[index];
+      if (giftee_identifier == StringIndex::NotFound) {
+        AddDiagnostic(
+            EntryPrefix(entry) + "the giftee " + Quoted(giftee) + " is not a participant.");
+      } else if (giftee_receipts_[giftee_identifier].count >= gift_count_) {
+        const std::string gifts{
+            gift_count_ == 1 ? "a gift" : std::to_string(gift_count_) + " gifts, the last one"};
+        AddDiagnostic(EntryPrefix(entry) + Quoted(giftee) + " already receives " + gifts
+                      + " in entry " + std::to_string(giftee_receipts_[giftee_identifier].entry)
+                      + ".");
+      } else {
+        ++giftee_receipts_[giftee_identifier].count;
+        giftee_receipts_[giftee_identifier].entry = static_cast<uint32_t>(entry);
+      }
+
+      if (gifter == giftee) {
+        AddDiagnostic(EntryPrefix(entry) + Quoted(gifter) + " gifts to themselves.");
+      }
+    }
+  }
+
+  // Prefix of the description of a problem found in a given entry.
+  [[nodiscard]] static std::string EntryPrefix(const std::size_t entry) {
+    return "Entry " + std::to_string(entry) + ": ";
+  }
+
+  // Given name between double quotes.
+  [[nodiscard]] static std::string Quoted(const std::string_view name) {
+    std::string quoted;
+    quoted.reserve(name.size() + 2);
+    quoted.append(1, '"').append(name).append(1, '"');
+    return quoted;
+  }
+
+  // Reports the participants who never gift, never receive, or receive too few gifts.
+  void Finalize() {
+    for (uint32_t identifier = 0; identifier < gifter_entries_.size(); ++identifier) {
+      if (gifter_entries_[identifier] == NoEntry) {
+        AddDiagnostic(Quoted(index_.Key(identifier)) + " does not gift to anyone.");
+      }
+      if (giftee_receipts_[identifier].count == 0) {
+        AddDiagnostic(Quoted(index_.Key(identifier)) + " does not receive a gift from anyone.");
+      } else if (giftee_receipts_[identifier].count < gift_count_) {
+        AddDiagnostic(Quoted(index_.Key(identifier)) + " receives only "
+                      + std::to_string(giftee_receipts_[identifier].count) + " of "
+                      + std::to_string(gift_count_) + " gifts.");
+      }
+    }
+  }
+
+  // Records a problem and keeps its description if there is room for it.
+  void AddDiagnostic(const std::string& diagnostic) {
+    ++problem_count_;
+    if (diagnostics_.size() < MaximumDiagnosticCount) {
+      diagnostics_.push_back(diagnostic);
+    }
+  }
+
+  // Index of the participant names.
+  StringIndex index_;
+
+  // Entry in which each participant gifts, by participant identifier, or NoEntry if none.
+  std::vector<uint32_t> gifter_entries_;
+
+  // Number of gifts that each participant must give and receive.
+  std::size_t gift_count_{1};
+
+  // Gifts that each participant receives, by participant identifier.
+  std::vector<Receipt> giftee_receipts_;
+
+  // Identifier of the last gifter found, or NotFound if none.
+  uint32_t previous_gifter_identifier_{StringIndex::NotFound};
+
+  // Identifiers of the giftees of the entry being checked, when they are looked up one by one.
+  std::vector<uint32_t> giftee_identifiers_;
+
+  // Total number of problems found.
+  std::size_t problem_count_{0};
+
+  // Descriptions of the first problems found.
+  std::vector<std::string> diagnostics_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_VERIFICATION_HPP
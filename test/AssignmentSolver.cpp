@@ -0,0 +1,179 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/AssignmentSolver.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+namespace {
+
+// Creates a random assignment problem with a given number of rows in which each row has each
+// column as candidate with a given probability, plus the column of a random permutation so that an
+// assignment exists.
+SecretSanta::AssignmentCandidates CreateRandomCandidates(
+    const std::size_t size, const double density, std::mt19937_64& random_generator) {
+  std::vector<uint32_t> permutation(size);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::shuffle(permutation.begin(), permutation.end(), random_generator);
+  std::uniform_real_distribution<double> probability{0.0, 1.0};
+  std::uniform_int_distribution<int64_t> cost{0, 1000};
+  SecretSanta::AssignmentCandidates candidates;
+  for (std::size_t row = 0; row < size; ++row) {
+    for (std::size_t column = 0; column < size; ++column) {
+      if (column == permutation[row] || probability(random_generator) < density) {
+        candidates.Add(static_cast<uint32_t>(column), cost(random_generator));
+      }
+    }
+    candidates.EndRow();
+  }
+  return candidates;
+}
+
+// Cost of a given candidate, or no value if the row does not have the column as candidate.
+std::optional<int64_t> CostOf(
+    const SecretSanta::AssignmentCandidates& candidates, const std::size_t row,
+    const uint32_t column) {
+  for (std::size_t index = candidates.offsets[row]; index < candidates.offsets[row + 1]; ++index) {
+    if (candidates.columns[index] == column) {
+      return candidates.costs[index];
+    }
+  }
+  return std::nullopt;
+}
+
+// Finds the smallest total cost and the smallest maximum cost of an assignment by trying every
+// permutation.
+std::pair<int64_t, int64_t> BruteForce(const SecretSanta::AssignmentCandidates& candidates) {
+  std::vector<uint32_t> permutation(candidates.Size());
+  std::iota(permutation.begin(), permutation.end(), 0);
+  int64_t best_total = std::numeric_limits<int64_t>::max();
+  int64_t best_maximum = std::numeric_limits<int64_t>::max();
+  do {
+    int64_t total = 0;
+    int64_t maximum = 0;
+    bool valid = true;
+    for (std::size_t row = 0; row < permutation.size() && valid; ++row) {
+      const std::optional<int64_t> cost = CostOf(candidates, row, permutation[row]);
+      valid = cost.has_value();
+      total += cost.value_or(0);
+      maximum = std::max(maximum, cost.value_or(0));
+    }
+    if (valid) {
+      best_total = std::min(best_total, total);
+      best_maximum = std::min(best_maximum, maximum);
+    }
+  } while (std::next_permutation(permutation.begin(), permutation.end()));
+  return {best_total, best_maximum};
+}
+
+// Total cost of a given assignment, which must only use candidates.
+int64_t TotalCost(
+    const SecretSanta::AssignmentCandidates& candidates, const std::vector<uint32_t>& columns) {
+  int64_t total = 0;
+  std::vector<bool> used(columns.size(), false);
+  for (std::size_t row = 0; row < columns.size(); ++row) {
+    const std::optional<int64_t> cost = CostOf(candidates, row, columns[row]);
+    EXPECT_TRUE(cost.has_value());
+    EXPECT_FALSE(used[columns[row]]);
+    used[columns[row]] = true;
+    total += cost.value_or(0);
+  }
+  return total;
+}
+
+TEST(AssignmentSolver, FindPerfectAssignment) {
+  SecretSanta::AssignmentCandidates candidates;
+  candidates.Add(0, 5);
+  candidates.Add(1, 1);
+  candidates.EndRow();
+  candidates.Add(1, 1);
+  candidates.EndRow();
+  candidates.Add(1, 1);
+  candidates.Add(2, 9);
+  candidates.EndRow();
+
+  const std::optional<std::vector<uint32_t>> assignment =
+      SecretSanta::FindPerfectAssignment(candidates);
+  ASSERT_TRUE(assignment.has_value());
+  EXPECT_EQ(assignment.value(), (std::vector<uint32_t>{0, 1, 2}));
+  EXPECT_FALSE(SecretSanta::FindPerfectAssignment(candidates, 8).has_value());
+  EXPECT_EQ(SecretSanta::FindBottleneckCost(candidates), 9);
+}
+
+TEST(AssignmentSolver, FindPerfectAssignmentWithoutAny) {
+  SecretSanta::AssignmentCandidates candidates;
+  candidates.Add(0, 1);
+  candidates.EndRow();
+  candidates.Add(0, 1);
+  candidates.EndRow();
+  EXPECT_FALSE(SecretSanta::FindPerfectAssignment(candidates).has_value());
+  EXPECT_FALSE(SecretSanta::FindBottleneckCost(candidates).has_value());
+}
+
+TEST(AssignmentSolver, SolveAssignmentMatchesBruteForce) {
+  std::mt19937_64 random_generator{42};
+  for (int trial = 0; trial < 50; ++trial) {
+    const SecretSanta::AssignmentCandidates candidates{
+        CreateRandomCandidates(7, trial % 2 == 0 ? 0.3 : 0.8, random_generator)};
+    const std::pair<int64_t, int64_t> best = BruteForce(candidates);
+
+    EXPECT_EQ(TotalCost(candidates, SecretSanta::SolveAssignment(candidates)), best.first);
+    EXPECT_EQ(SecretSanta::FindBottleneckCost(candidates), best.second);
+  }
+}
+
+TEST(AssignmentSolver, SolveAssignmentUnderMaximumCost) {
+  SecretSanta::AssignmentCandidates candidates;
+  candidates.Add(0, 0);
+  candidates.Add(1, 60);
+  candidates.EndRow();
+  candidates.Add(0, 60);
+  candidates.Add(1, 100);
+  candidates.EndRow();
+  // The smallest total cost is 100, with a largest cost of 100, whereas the other assignment costs
+  // 120 in total but only 60 at most.
+  EXPECT_EQ(SecretSanta::SolveAssignment(candidates), (std::vector<uint32_t>{0, 1}));
+  EXPECT_EQ(SecretSanta::FindBottleneckCost(candidates), 60);
+  EXPECT_EQ(SecretSanta::SolveAssignment(candidates, 1, 60), (std::vector<uint32_t>{1, 0}));
+}
+
+TEST(AssignmentSolver, SolveLargeAssignmentInParallel) {
+  std::mt19937_64 random_generator{7};
+  const std::size_t size{6000};
+  SecretSanta::AssignmentCandidates candidates;
+  std::uniform_int_distribution<uint32_t> column{0, size - 1};
+  std::uniform_int_distribution<int64_t> cost{0, 1'000'000};
+  for (std::size_t row = 0; row < size; ++row) {
+    candidates.Add(static_cast<uint32_t>((row + 1) % size), cost(random_generator));
+    for (int index = 0; index < 6; ++index) {
+      candidates.Add(column(random_generator), cost(random_generator));
+    }
+    candidates.EndRow();
+  }
+  const std::vector<uint32_t> sequential{SecretSanta::SolveAssignment(candidates, 1)};
+  const std::vector<uint32_t> parallel{SecretSanta::SolveAssignment(candidates, 4)};
+  // Both are optimal, so they cost the same even if they differ.
+  EXPECT_EQ(TotalCost(candidates, sequential), TotalCost(candidates, parallel));
+}
+
+}  // namespace
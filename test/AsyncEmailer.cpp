@@ -0,0 +1,117 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/AsyncEmailer.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "../source/EventLoopSmtpTransport.hpp"
+#include "../source/SmtpSink.hpp"
+#include "../source/Task.hpp"
+#include "CreateSampleParticipant.hpp"
+#include "RecordingTransport.hpp"
+
+namespace {
+
+SecretSanta::Task<SecretSanta::SendResult> SendOne(
+    SecretSanta::Transport& transport, SecretSanta::Executor& executor) {
+  const SecretSanta::Participant gifter{SecretSanta::CreateSampleParticipantA()};
+  const SecretSanta::Participant giftee{SecretSanta::CreateSampleParticipantB()};
+  co_return co_await SecretSanta::SendMessage(
+      transport, executor, gifter, giftee, "My Message Subject", "My Message Body");
+}
+
+SecretSanta::Task<std::vector<SecretSanta::SendResult>> SendAll(
+    SecretSanta::Transport& transport, SecretSanta::Executor& executor,
+    const SecretSanta::Configuration& configuration, const SecretSanta::Matchings& matchings,
+    const std::optional<std::set<std::string>> gifter_names = std::nullopt) {
+  co_return co_await SecretSanta::SendMessages(
+      transport, executor, configuration, matchings, gifter_names);
+}
+
+TEST(AsyncEmailer, SendMessageCompletingImmediately) {
+  SecretSanta::RecordingTransport transport;
+  SecretSanta::QueueExecutor executor;
+
+  const SecretSanta::SendResult result{
+      SecretSanta::SyncWait(executor, SendOne(transport, executor))};
+
+  EXPECT_TRUE(result.Succeeded());
+  EXPECT_EQ(result.Message().GifterName(), "Alice Smith");
+  EXPECT_EQ(result.Message().Recipient(), "alice.smith@gmail.com");
+  EXPECT_EQ(transport.Messages().size(), 1);
+}
+
+TEST(AsyncEmailer, SendMessageCompletingLater) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{0}, 1.0, 0.0};
+  ASSERT_TRUE(sink.IsListening());
+  SecretSanta::EventLoopSmtpTransport transport{"127.0.0.1", sink.Port(), "santa@example.com"};
+  SecretSanta::QueueExecutor executor;
+
+  const SecretSanta::SendResult result{
+      SecretSanta::SyncWait(executor, SendOne(transport, executor))};
+
+  EXPECT_FALSE(result.Succeeded());
+  EXPECT_EQ(result.Outcome().Status(), SecretSanta::DeliveryStatus::PermanentFailure);
+  EXPECT_EQ(result.Message().GifterName(), "Alice Smith");
+}
+
+TEST(AsyncEmailer, SendMessages) {
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+
+  SecretSanta::SmtpSink sink;
+  ASSERT_TRUE(sink.IsListening());
+  SecretSanta::EventLoopSmtpTransport transport{
+      "127.0.0.1", sink.Port(), "santa@example.com", 3, 1};
+  SecretSanta::QueueExecutor executor;
+
+  const std::vector<SecretSanta::SendResult> results{
+      SecretSanta::SyncWait(executor, SendAll(transport, executor, configuration, matchings))};
+
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(results[0].Message().GifterName(), "Alice Smith");
+  EXPECT_EQ(results[1].Message().GifterName(), "Bob Johnson");
+  EXPECT_EQ(results[2].Message().GifterName(), "Claire Jones");
+  for (const SecretSanta::SendResult& result : results) {
+    EXPECT_TRUE(result.Succeeded());
+  }
+  EXPECT_EQ(sink.AcceptedMessageCount(), 3);
+}
+
+TEST(AsyncEmailer, SendMessagesToGivenGifters) {
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::RecordingTransport transport;
+  SecretSanta::InlineExecutor executor;
+
+  SecretSanta::Task<std::vector<SecretSanta::SendResult>> task{SendAll(
+      transport, executor, configuration, matchings, std::set<std::string>{"Bob Johnson"})};
+  task.Start();
+
+  ASSERT_TRUE(task.IsDone());
+  const std::vector<SecretSanta::SendResult> results{task.Result()};
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results.front().Message().GifterName(), "Bob Johnson");
+}
+
+}  // namespace
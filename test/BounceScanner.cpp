@@ -0,0 +1,186 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/BounceScanner.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+
+// Bounce message with a delivery status notification that reports a given recipient with a given
+// action.
+std::string CreateBounceMessage(const std::string& recipient, const std::string& action) {
+  return "From: Mail Delivery System <MAILER-DAEMON@example.com>\r\n"
+         "To: secret-santa@example.com\r\n"
+         "Subject: Undelivered Mail Returned to Sender\r\n"
+         "Status: RO\r\n"
+         "Content-Type: multipart/report; report-type=delivery-status; boundary=\"b\"\r\n"
+         "\r\n"
+         "--b\r\n"
+         "Content-Type: text/plain\r\n"
+         "\r\n"
+         "Your message could not be delivered.\r\n"
+         "--b\r\n"
+         "Content-Type: message/delivery-status\r\n"
+         "\r\n"
+         "Reporting-MTA: dns; mail.example.com\r\n"
+         "\r\n"
+         "Final-Recipient: rfc822; "
+         + recipient
+         + "\r\n"
+           "Original-Recipient: rfc822;original@example.com\r\n"
+           "Action: "
+         + action
+         + "\r\n"
+           "Status: 5.1.1\r\n"
+           "Diagnostic-Code: smtp; 550 5.1.1 <"
+         + recipient
+         + ">:\r\n"
+           "    Recipient address rejected: User unknown\r\n"
+           "\r\n"
+           "--b--\r\n";
+}
+
+TEST(BounceScanner, DelayedRecipientsAreIgnored) {
+  SecretSanta::BounceScanner scanner;
+  scanner.ScanMessage(CreateBounceMessage("alice@example.com", "delayed"));
+  EXPECT_EQ(scanner.MessageCount(), 1);
+  EXPECT_TRUE(scanner.Bounces().empty());
+}
+
+TEST(BounceScanner, DeliveryStatusNotification) {
+  SecretSanta::BounceScanner scanner;
+  scanner.ScanMessage(CreateBounceMessage("Alice@Example.com", "failed"));
+  ASSERT_EQ(scanner.Bounces().size(), 1);
+  EXPECT_EQ(scanner.Bounces()[0].recipient, "alice@example.com");
+  EXPECT_EQ(scanner.Bounces()[0].status, "5.1.1");
+  EXPECT_EQ(scanner.Bounces()[0].diagnostic,
+            "smtp; 550 5.1.1 <Alice@Example.com>: Recipient address rejected: User unknown");
+}
+
+TEST(BounceScanner, Maildir) {
+  const std::filesystem::path directory{"bounce_scanner_maildir"};
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory / "new");
+  std::filesystem::create_directories(directory / "cur");
+  std::filesystem::create_directories(directory / "tmp");
+  std::ofstream{directory / "new" / "1.eml"} << CreateBounceMessage("alice@example.com", "failed");
+  std::ofstream{directory / "cur" / "2.eml:2,S"}
+      << CreateBounceMessage("bob@example.com", "failed");
+  std::ofstream{directory / "tmp" / "3.eml"} << CreateBounceMessage("claire@example.com", "failed");
+
+  SecretSanta::BounceScanner scanner;
+  EXPECT_TRUE(scanner.ScanPath(directory));
+  EXPECT_EQ(scanner.MessageCount(), 2);
+  ASSERT_EQ(scanner.Bounces().size(), 2);
+  EXPECT_GT(scanner.ByteCount(), 0);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(BounceScanner, Mbox) {
+  const std::filesystem::path path{"bounce_scanner.mbox"};
+  std::ofstream stream{path};
+  stream << "From MAILER-DAEMON Mon Dec  1 09:00:00 2025\n"
+         << CreateBounceMessage("alice@example.com", "failed") << "\n"
+         << "From organizer@example.com Mon Dec  1 09:05:00 2025\n"
+         << "Subject: Re: Secret Santa\n"
+         << "\n"
+         << ">From the organizer: Action: failed\n"
+         << "\n"
+         << "From MAILER-DAEMON Mon Dec  1 09:10:00 2025\n"
+         << CreateBounceMessage("bob@example.com", "failed");
+  stream.close();
+
+  SecretSanta::BounceScanner scanner;
+  EXPECT_TRUE(scanner.ScanPath(path));
+  EXPECT_EQ(scanner.MessageCount(), 3);
+  ASSERT_EQ(scanner.Bounces().size(), 2);
+  EXPECT_EQ(scanner.Bounces()[0].recipient, "alice@example.com");
+  EXPECT_EQ(scanner.Bounces()[1].recipient, "bob@example.com");
+
+  std::filesystem::remove(path);
+}
+
+TEST(BounceScanner, MissingMailbox) {
+  SecretSanta::BounceScanner scanner;
+  EXPECT_FALSE(scanner.ScanPath("missing.mbox"));
+  EXPECT_EQ(scanner.MessageCount(), 0);
+}
+
+TEST(BounceScanner, NormalizeAddress) {
+  EXPECT_EQ(SecretSanta::NormalizeAddress(" <Alice.Smith@Example.COM> "),
+            "alice.smith@example.com");
+  EXPECT_EQ(SecretSanta::NormalizeAddress("bob@example.com"), "bob@example.com");
+  EXPECT_EQ(SecretSanta::NormalizeAddress(" <> "), "");
+}
+
+TEST(BounceScanner, OriginalRecipientOnly) {
+  SecretSanta::BounceScanner scanner;
+  scanner.ScanMessage("Subject: Failure\n"
+                      "\n"
+                      "Original-Recipient: rfc822; alice@example.com\n"
+                      "Action: failed\n"
+                      "Status: 5.2.2\n");
+  ASSERT_EQ(scanner.Bounces().size(), 1);
+  EXPECT_EQ(scanner.Bounces()[0].recipient, "alice@example.com");
+  EXPECT_EQ(scanner.Bounces()[0].status, "5.2.2");
+}
+
+TEST(BounceScanner, SeveralRecipients) {
+  SecretSanta::BounceScanner scanner;
+  scanner.ScanMessage("Subject: Failure\n"
+                      "\n"
+                      "Final-Recipient: rfc822; alice@example.com\n"
+                      "Action: failed\n"
+                      "Status: 5.1.1\n"
+                      "\n"
+                      "Final-Recipient: rfc822; bob@example.com\n"
+                      "Action: delivered\n"
+                      "Status: 2.0.0\n"
+                      "\n"
+                      "Final-Recipient: rfc822; claire@example.com\n"
+                      "Action: failed\n"
+                      "Status: 5.7.1\n");
+  ASSERT_EQ(scanner.Bounces().size(), 2);
+  EXPECT_EQ(scanner.Bounces()[0].recipient, "alice@example.com");
+  EXPECT_EQ(scanner.Bounces()[1].recipient, "claire@example.com");
+  EXPECT_EQ(scanner.Bounces()[1].status, "5.7.1");
+}
+
+TEST(BounceScanner, XFailedRecipients) {
+  SecretSanta::BounceScanner scanner;
+  scanner.ScanMessage("X-Failed-Recipients: alice@example.com, Bob@Example.com\n"
+                      "Subject: Mail delivery failed\n"
+                      "\n"
+                      "Final-Recipient: rfc822; bob@example.com\n"
+                      "Action: failed\n"
+                      "Status: 5.0.0\n");
+  ASSERT_EQ(scanner.Bounces().size(), 2);
+  EXPECT_EQ(scanner.Bounces()[0].recipient, "alice@example.com");
+  EXPECT_EQ(scanner.Bounces()[0].status, "");
+  EXPECT_EQ(scanner.Bounces()[1].recipient, "bob@example.com");
+  EXPECT_EQ(scanner.Bounces()[1].status, "5.0.0");
+}
+
+}  // namespace
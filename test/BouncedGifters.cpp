@@ -0,0 +1,92 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/BouncedGifters.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Participants of the tests, two of whom share an email address.
+std::set<SecretSanta::Participant> CreateParticipants() {
+  return {
+      SecretSanta::Participant{"Alice Smith", "Alice.Smith@example.com", "", ""},
+      SecretSanta::Participant{"Bob Jones", "jones@example.com", "", ""},
+      SecretSanta::Participant{"Claire Jones", "jones@example.com", "", ""},
+      SecretSanta::Participant{"David Brown", "david@example.com", "", ""},
+      SecretSanta::Participant{"Erin Green", "", "", ""},
+  };
+}
+
+TEST(BouncedGifters, DefaultConstructor) {
+  const SecretSanta::BouncedGifters bounced_gifters;
+  EXPECT_TRUE(bounced_gifters.Entries().empty());
+  EXPECT_TRUE(bounced_gifters.UnknownRecipients().empty());
+}
+
+TEST(BouncedGifters, Join) {
+  const std::vector<SecretSanta::Bounce> bounces{
+      {"jones@example.com", "", ""},
+      {"alice.smith@example.com", "5.1.1", "smtp; 550 5.1.1 User unknown"},
+      {"stranger@example.com", "5.1.1", ""},
+      {"jones@example.com", "5.2.2", "smtp; 552 Mailbox full"},
+      {"stranger@example.com", "5.1.1", ""},
+  };
+
+  const SecretSanta::BouncedGifters bounced_gifters{CreateParticipants(), bounces};
+
+  ASSERT_EQ(bounced_gifters.Entries().size(), 3);
+  EXPECT_EQ(bounced_gifters.Entries()[0].name, "Alice Smith");
+  EXPECT_EQ(bounced_gifters.Entries()[0].email, "Alice.Smith@example.com");
+  EXPECT_EQ(bounced_gifters.Entries()[0].bounces, 1);
+  EXPECT_EQ(bounced_gifters.Entries()[0].status, "5.1.1");
+  EXPECT_EQ(bounced_gifters.Entries()[1].name, "Bob Jones");
+  EXPECT_EQ(bounced_gifters.Entries()[1].bounces, 2);
+  EXPECT_EQ(bounced_gifters.Entries()[1].status, "5.2.2");
+  EXPECT_EQ(bounced_gifters.Entries()[1].diagnostic, "smtp; 552 Mailbox full");
+  EXPECT_EQ(bounced_gifters.Entries()[2].name, "Claire Jones");
+  EXPECT_EQ(bounced_gifters.Entries()[2].bounces, 2);
+  EXPECT_EQ(bounced_gifters.UnknownRecipients(),
+            (std::vector<std::string>{"stranger@example.com"}));
+}
+
+TEST(BouncedGifters, Write) {
+  const SecretSanta::BouncedGifters bounced_gifters{
+      CreateParticipants(), {{"david@example.com", "5.1.1", "smtp; 550 5.1.1 User unknown"}}};
+
+  const std::filesystem::path path{"bounces.yaml"};
+  bounced_gifters.Write(path);
+
+  const YAML::Node root = YAML::LoadFile(path.string());
+  ASSERT_EQ(root["gifters"].size(), 1);
+  EXPECT_EQ(root["gifters"][0]["name"].as<std::string>(), "David Brown");
+  EXPECT_EQ(root["gifters"][0]["email"].as<std::string>(), "david@example.com");
+  EXPECT_EQ(root["gifters"][0]["bounces"].as<std::size_t>(), 1);
+  EXPECT_EQ(root["gifters"][0]["status"].as<std::string>(), "5.1.1");
+  EXPECT_EQ(root["unknown_recipients"].size(), 0);
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace
@@ -0,0 +1,138 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/BoundedQueue.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST(BoundedQueue, Capacity) {
+  const SecretSanta::BoundedQueue<int> queue{100};
+  EXPECT_EQ(queue.Capacity(), 128);
+  EXPECT_EQ(queue.Size(), 0);
+}
+
+TEST(BoundedQueue, TryPushAndTryPop) {
+  SecretSanta::BoundedQueue<int> queue{4};
+  for (int value = 0; value < 4; ++value) {
+    EXPECT_TRUE(queue.TryPush(value));
+  }
+  int value = 4;
+  EXPECT_FALSE(queue.TryPush(value));
+  EXPECT_EQ(queue.Size(), 4);
+  EXPECT_EQ(queue.MaximumOccupancy(), 4);
+  for (int expected = 0; expected < 4; ++expected) {
+    EXPECT_EQ(queue.TryPop(), expected);
+  }
+  EXPECT_EQ(queue.TryPop(), std::nullopt);
+}
+
+TEST(BoundedQueue, Close) {
+  SecretSanta::BoundedQueue<int> queue{4};
+  queue.Push(1);
+  queue.Close();
+  EXPECT_EQ(queue.Pop(), 1);
+  EXPECT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(BoundedQueue, ParkedConsumerIsWokenByPushAndClose) {
+  SecretSanta::BoundedQueue<int> queue{4};
+  std::vector<std::optional<int>> values;
+  double processor_seconds = 0.0;
+  std::thread consumer([&queue, &values, &processor_seconds]() {
+    const std::clock_t start = std::clock();
+    values.push_back(queue.Pop());
+    values.push_back(queue.Pop());
+    processor_seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  queue.Push(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  queue.Close();
+  consumer.join();
+  ASSERT_EQ(values.size(), 2);
+  EXPECT_EQ(values[0], 1);
+  EXPECT_EQ(values[1], std::nullopt);
+  // The consumer is parked rather than polling while the queue is empty.
+  EXPECT_LT(processor_seconds, 0.1);
+}
+
+TEST(BoundedQueue, ParkedProducerIsWokenByPop) {
+  SecretSanta::BoundedQueue<int> queue{1};
+  EXPECT_EQ(queue.Capacity(), 2);
+  queue.Push(1);
+  queue.Push(2);
+  std::thread producer([&queue]() { queue.Push(3); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(queue.Pop(), 1);
+  producer.join();
+  EXPECT_EQ(queue.Pop(), 2);
+  EXPECT_EQ(queue.Pop(), 3);
+  EXPECT_GT(queue.FullWaitSeconds(), 0.0);
+}
+
+TEST(BoundedQueue, MultipleProducersAndConsumers) {
+  constexpr int producer_count{3};
+  constexpr int consumer_count{3};
+  constexpr int values_per_producer{20000};
+  SecretSanta::BoundedQueue<int> queue{8};
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < producer_count; ++producer) {
+    producers.emplace_back([&queue]() {
+      for (int value = 1; value <= values_per_producer; ++value) {
+        queue.Push(value);
+      }
+    });
+  }
+
+  std::vector<long long> sums(consumer_count, 0);
+  std::vector<std::thread> consumers;
+  for (int consumer = 0; consumer < consumer_count; ++consumer) {
+    consumers.emplace_back([&queue, &sums, consumer]() {
+      while (const std::optional<int> value = queue.Pop()) {
+        sums[consumer] += value.value();
+      }
+    });
+  }
+
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  queue.Close();
+  for (std::thread& consumer : consumers) {
+    consumer.join();
+  }
+
+  long long sum = 0;
+  for (const long long consumer_sum : sums) {
+    sum += consumer_sum;
+  }
+  EXPECT_EQ(sum, static_cast<long long>(producer_count) * values_per_producer
+                     * (values_per_producer + 1) / 2);
+  EXPECT_LE(queue.MaximumOccupancy(), 8);
+}
+
+}  // namespace
@@ -0,0 +1,126 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/CalendarEvent.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <sstream>
+#include <string>
+
+namespace {
+
+TEST(CalendarEvent, ParseCalendarTime) {
+  const std::optional<SecretSanta::CalendarTime> floating{
+      SecretSanta::ParseCalendarTime("2023-12-23 14:00")};
+  ASSERT_TRUE(floating.has_value());
+  EXPECT_EQ(floating->year, 2023);
+  EXPECT_EQ(floating->month, 12);
+  EXPECT_EQ(floating->day, 23);
+  EXPECT_EQ(floating->hour, 14);
+  EXPECT_EQ(floating->minute, 0);
+  EXPECT_EQ(floating->second, 0);
+  EXPECT_FALSE(floating->utc_offset_minutes.has_value());
+
+  const std::optional<SecretSanta::CalendarTime> offset{
+      SecretSanta::ParseCalendarTime("2023-12-23T14:00:30-08:00")};
+  ASSERT_TRUE(offset.has_value());
+  EXPECT_EQ(offset->second, 30);
+  EXPECT_EQ(offset->utc_offset_minutes, -480);
+
+  EXPECT_EQ(SecretSanta::ParseCalendarTime("2023-12-23 14:00Z")->utc_offset_minutes, 0);
+  EXPECT_EQ(SecretSanta::ParseCalendarTime("2023-12-23 14:00+0530")->utc_offset_minutes, 330);
+
+  EXPECT_FALSE(SecretSanta::ParseCalendarTime("December 23").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCalendarTime("2023-13-01 10:00").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCalendarTime("2023-02-29 10:00").has_value());
+  EXPECT_TRUE(SecretSanta::ParseCalendarTime("2024-02-29 10:00").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCalendarTime("2023-12-23 24:00").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCalendarTime("2023-12-23 14:00 PST").has_value());
+}
+
+TEST(CalendarEvent, FormatICalendarTime) {
+  EXPECT_EQ(SecretSanta::FormatICalendarTime(*SecretSanta::ParseCalendarTime("2023-12-23 14:00")),
+            "20231223T140000");
+  EXPECT_EQ(
+      SecretSanta::FormatICalendarTime(*SecretSanta::ParseCalendarTime("2023-12-31 20:00-08:00")),
+      "20240101T040000Z");
+  EXPECT_EQ(SecretSanta::FormatICalendarTime(
+                SecretSanta::AddSeconds(*SecretSanta::ParseCalendarTime("2023-12-31 23:00"), 7200)),
+            "20240101T010000");
+}
+
+TEST(CalendarEvent, EscapeICalendarText) {
+  EXPECT_EQ(SecretSanta::EscapeICalendarText("Room 1, Floor 2; a\\b\nnext"),
+            "Room 1\\, Floor 2\\; a\\\\b\\nnext");
+}
+
+TEST(CalendarEvent, ComposeICalendarInvite) {
+  const SecretSanta::CalendarEvent event{*SecretSanta::ParseCalendarTime("2023-12-23 14:00-08:00"),
+                                         *SecretSanta::ParseCalendarTime("2023-12-23 16:00-08:00"),
+                                         "123 First Ave, Townsville"};
+  const std::string invite{SecretSanta::ComposeICalendarInvite(event, "Secret Santa", 0)};
+
+  EXPECT_EQ(invite.rfind("BEGIN:VCALENDAR\r\nVERSION:2.0\r\n", 0), 0);
+  EXPECT_NE(invite.find("\r\nMETHOD:PUBLISH\r\n"), std::string::npos);
+  EXPECT_NE(invite.find("\r\nDTSTAMP:19700101T000000Z\r\n"), std::string::npos);
+  EXPECT_NE(invite.find("\r\nDTSTART:20231223T220000Z\r\n"), std::string::npos);
+  EXPECT_NE(invite.find("\r\nDTEND:20231224T000000Z\r\n"), std::string::npos);
+  EXPECT_NE(invite.find("\r\nSUMMARY:Secret Santa\r\n"), std::string::npos);
+  EXPECT_NE(invite.find("\r\nLOCATION:123 First Ave\\, Townsville\r\n"), std::string::npos);
+  EXPECT_TRUE(invite.ends_with("END:VEVENT\r\nEND:VCALENDAR\r\n"));
+
+  // The identifier depends only on the details of the event.
+  const std::string later{SecretSanta::ComposeICalendarInvite(event, "Secret Santa", 1000)};
+  const std::size_t uid = invite.find("UID:");
+  EXPECT_EQ(invite.substr(uid, invite.find('\r', uid) - uid),
+            later.substr(uid, later.find('\r', uid) - uid));
+}
+
+TEST(CalendarEvent, FoldsLongLines) {
+  std::string location;
+  for (int index = 0; index < 30; ++index) {
+    location.append("Père Noël ");
+  }
+  const SecretSanta::CalendarEvent event{*SecretSanta::ParseCalendarTime("2023-12-23 14:00"),
+                                         *SecretSanta::ParseCalendarTime("2023-12-23 16:00"),
+                                         location};
+  const std::string invite{SecretSanta::ComposeICalendarInvite(event, "Secret Santa", 0)};
+
+  std::istringstream stream{invite};
+  std::string line;
+  std::string unfolded;
+  while (std::getline(stream, line)) {
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.back(), '\r');
+    line.pop_back();
+    EXPECT_LE(line.size(), 75);
+    // Each line starts with a whole UTF-8 character.
+    EXPECT_NE(static_cast<unsigned char>(line.front()) & 0xC0U, 0x80U);
+    if (line.front() == ' ') {
+      unfolded.append(line.substr(1));
+    } else {
+      unfolded.append("\n" + line);
+    }
+  }
+  EXPECT_NE(unfolded.find("\nLOCATION:" + location + "\n"), std::string::npos);
+}
+
+}  // namespace
@@ -0,0 +1,75 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Certificates.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace {
+
+// Reads a certificate from a PEM file.
+std::unique_ptr<X509, decltype(&X509_free)> ReadCertificate(const std::filesystem::path& path) {
+  std::FILE* const file = std::fopen(path.string().c_str(), "r");
+  if (file == nullptr) {
+    return {nullptr, &X509_free};
+  }
+  std::unique_ptr<X509, decltype(&X509_free)> certificate{
+      PEM_read_X509(file, nullptr, nullptr, nullptr), &X509_free};
+  std::fclose(file);
+  return certificate;
+}
+
+TEST(Certificates, CreateCertificates) {
+  const std::filesystem::path directory{"certificates"};
+  ASSERT_TRUE(SecretSanta::CreateCertificates(directory));
+
+  const std::unique_ptr<X509, decltype(&X509_free)> authority{
+      ReadCertificate(directory / SecretSanta::CertificateFile::Authority)};
+  const std::unique_ptr<X509, decltype(&X509_free)> server{
+      ReadCertificate(directory / SecretSanta::CertificateFile::Certificate)};
+  ASSERT_NE(authority, nullptr);
+  ASSERT_NE(server, nullptr);
+
+  // The certificate authority signs itself and the certificate of the server.
+  EXPECT_EQ(X509_verify(authority.get(), X509_get0_pubkey(authority.get())), 1);
+  EXPECT_EQ(X509_verify(server.get(), X509_get0_pubkey(authority.get())), 1);
+  EXPECT_EQ(X509_check_ca(authority.get()), 1);
+  EXPECT_EQ(X509_check_ca(server.get()), 0);
+
+  // The certificate of the server is valid for the loopback interface.
+  EXPECT_EQ(X509_check_host(server.get(), "localhost", 0, 0, nullptr), 1);
+  EXPECT_EQ(X509_check_ip_asc(server.get(), "127.0.0.1", 0), 1);
+  EXPECT_NE(X509_check_host(server.get(), "mail.example.com", 0, 0, nullptr), 1);
+
+  // The private key matches the certificate of the server.
+  std::FILE* const file =
+      std::fopen((directory / SecretSanta::CertificateFile::PrivateKey).string().c_str(), "r");
+  ASSERT_NE(file, nullptr);
+  const std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key{
+      PEM_read_PrivateKey(file, nullptr, nullptr, nullptr), &EVP_PKEY_free};
+  std::fclose(file);
+  ASSERT_NE(key, nullptr);
+  EXPECT_EQ(X509_check_private_key(server.get(), key.get()), 1);
+}
+
+}  // namespace
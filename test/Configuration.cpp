@@ -29,6 +29,10 @@ TEST(Configuration, Constructor) {
   EXPECT_EQ(configuration.MessageSubject(), "Secret Santa Gift Exchange 2023");
   EXPECT_FALSE(configuration.MessageBody().empty());
   EXPECT_EQ(configuration.Participants().size(), 3);
+  ASSERT_TRUE(configuration.Event().has_value());
+  EXPECT_EQ(SecretSanta::FormatICalendarTime(configuration.Event()->Start()), "20231223T140000");
+  EXPECT_EQ(SecretSanta::FormatICalendarTime(configuration.Event()->End()), "20231223T160000");
+  EXPECT_EQ(configuration.Event()->Location(), "https://zoom.us/j/123456789");
 }
 
 TEST(Configuration, DefaultConstructor) {
@@ -38,6 +42,7 @@ TEST(Configuration, DefaultConstructor) {
             "You are receiving this message because you opted to participate in a Secret Santa "
             "gift exchange! This is an automated email message generated by: "
             "https://github.com/acodcha/secret-santa");
+  EXPECT_FALSE(configuration.Event().has_value());
 }
 
 }  // namespace
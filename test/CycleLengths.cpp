@@ -0,0 +1,136 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/CycleLengths.hpp"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+namespace {
+
+TEST(CycleLengths, Constructor) {
+  const SecretSanta::CycleLengths cycle_lengths{3, 5};
+  EXPECT_EQ(cycle_lengths.Minimum(), 3);
+  EXPECT_EQ(cycle_lengths.Maximum(), 5);
+}
+
+TEST(CycleLengths, ConstructorRaisesMinimum) {
+  const SecretSanta::CycleLengths cycle_lengths{0, 5};
+  EXPECT_EQ(cycle_lengths.Minimum(), 2);
+}
+
+TEST(CycleLengths, DefaultConstructor) {
+  const SecretSanta::CycleLengths cycle_lengths;
+  EXPECT_EQ(cycle_lengths.Minimum(), 2);
+  EXPECT_EQ(cycle_lengths.Maximum(), std::numeric_limits<std::size_t>::max());
+}
+
+TEST(CycleLengths, PartitionInfeasible) {
+  std::mt19937_64 random_generator(42);
+  EXPECT_FALSE(SecretSanta::CycleLengths(4, 5).Partition(7, random_generator).has_value());
+  EXPECT_FALSE(SecretSanta::CycleLengths(2, 2).Partition(5, random_generator).has_value());
+  EXPECT_FALSE(SecretSanta::CycleLengths(6, 5).Partition(10, random_generator).has_value());
+  EXPECT_FALSE(SecretSanta::CycleLengths().Partition(1, random_generator).has_value());
+}
+
+TEST(CycleLengths, PartitionNoParticipants) {
+  std::mt19937_64 random_generator(42);
+  const std::optional<std::vector<std::size_t>> partition =
+      SecretSanta::CycleLengths(3, 5).Partition(0, random_generator);
+  ASSERT_TRUE(partition.has_value());
+  EXPECT_TRUE(partition->empty());
+}
+
+TEST(CycleLengths, PartitionRespectsBounds) {
+  std::mt19937_64 random_generator(42);
+  for (std::size_t minimum = 2; minimum <= 6; ++minimum) {
+    for (std::size_t maximum = minimum; maximum <= 9; ++maximum) {
+      for (std::size_t count = 0; count <= 60; ++count) {
+        const SecretSanta::CycleLengths cycle_lengths{minimum, maximum};
+        const std::optional<std::vector<std::size_t>> partition =
+            cycle_lengths.Partition(count, random_generator);
+        const bool feasible = count == 0 || 1 + (count - 1) / maximum <= count / minimum;
+        ASSERT_EQ(partition.has_value(), feasible);
+        if (!partition.has_value()) {
+          continue;
+        }
+        EXPECT_EQ(std::accumulate(partition->begin(), partition->end(), std::size_t{0}), count);
+        for (const std::size_t length : partition.value()) {
+          EXPECT_GE(length, minimum);
+          EXPECT_LE(length, maximum);
+        }
+      }
+    }
+  }
+}
+
+TEST(CycleLengths, CycleCountProbabilities) {
+  EXPECT_EQ(SecretSanta::CycleLengths(2, 4).CycleCountProbabilities(10),
+            (std::vector<double>{0.0, 0.0, 0.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 3.0}));
+  EXPECT_FALSE(SecretSanta::CycleLengths(4, 5).CycleCountProbabilities(7).has_value());
+}
+
+TEST(CycleLengths, MembershipProbabilities) {
+  // Seven participants in cycles of two or three always form cycles of 2, 2, and 3.
+  const std::optional<std::vector<double>> probabilities =
+      SecretSanta::CycleLengths(2, 3).MembershipProbabilities(7);
+  ASSERT_TRUE(probabilities.has_value());
+  ASSERT_EQ(probabilities->size(), 8);
+  EXPECT_DOUBLE_EQ(probabilities.value()[2], 4.0 / 7.0);
+  EXPECT_DOUBLE_EQ(probabilities.value()[3], 3.0 / 7.0);
+  EXPECT_FALSE(SecretSanta::CycleLengths(4, 5).MembershipProbabilities(7).has_value());
+}
+
+TEST(CycleLengths, MembershipProbabilitiesMatchPartition) {
+  const SecretSanta::CycleLengths cycle_lengths{2, 5};
+  const std::size_t participant_count = 17;
+  const std::size_t draw_count = 200000;
+  const std::optional<std::vector<double>> probabilities =
+      cycle_lengths.MembershipProbabilities(participant_count);
+  ASSERT_TRUE(probabilities.has_value());
+  EXPECT_NEAR(std::accumulate(probabilities->begin(), probabilities->end(), 0.0), 1.0, 1.0e-12);
+
+  std::mt19937_64 random_generator(42);
+  std::vector<double> frequencies(participant_count + 1, 0.0);
+  for (std::size_t draw = 0; draw < draw_count; ++draw) {
+    const std::vector<std::size_t> lengths =
+        cycle_lengths.Partition(participant_count, random_generator).value();
+    for (const std::size_t length : lengths) {
+      frequencies[length] += static_cast<double>(length)
+                             / static_cast<double>(participant_count * draw_count);
+    }
+  }
+  for (std::size_t length = 0; length <= participant_count; ++length) {
+    EXPECT_NEAR(frequencies[length], probabilities.value()[length], 0.005);
+  }
+}
+
+TEST(CycleLengths, PartitionTightBounds) {
+  std::mt19937_64 random_generator(42);
+  const std::optional<std::vector<std::size_t>> partition =
+      SecretSanta::CycleLengths(1000, 1000).Partition(1000000, random_generator);
+  ASSERT_TRUE(partition.has_value());
+  EXPECT_EQ(partition->size(), 1000);
+  for (const std::size_t length : partition.value()) {
+    EXPECT_EQ(length, 1000);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,90 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/DaemonProtocol.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+
+namespace {
+
+TEST(DaemonProtocol, Request) {
+  std::string frame;
+  SecretSanta::AppendDaemonRequest(
+      frame, SecretSanta::DaemonOperation::Render, {"configuration.yaml", "", "Alice Smith"});
+  ASSERT_EQ(SecretSanta::DaemonPayloadLength(frame), frame.size() - 4);
+
+  const std::optional<SecretSanta::DaemonRequest> request =
+      SecretSanta::ParseDaemonRequest(std::string_view{frame}.substr(4));
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->operation, SecretSanta::DaemonOperation::Render);
+  ASSERT_EQ(request->field_count, 3);
+  EXPECT_EQ(request->fields[0], "configuration.yaml");
+  EXPECT_EQ(request->fields[1], "");
+  EXPECT_EQ(request->fields[2], "Alice Smith");
+}
+
+TEST(DaemonProtocol, Response) {
+  std::string frame;
+  SecretSanta::AppendDaemonResponse(frame, SecretSanta::DaemonStatus::NotFound, "No giftee.");
+  ASSERT_EQ(SecretSanta::DaemonPayloadLength(frame), 11);
+
+  const std::optional<SecretSanta::DaemonResponse> response =
+      SecretSanta::ParseDaemonResponse(std::string_view{frame}.substr(4));
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, SecretSanta::DaemonStatus::NotFound);
+  EXPECT_EQ(response->text, "No giftee.");
+}
+
+TEST(DaemonProtocol, PayloadLength) {
+  EXPECT_FALSE(SecretSanta::DaemonPayloadLength("").has_value());
+  EXPECT_FALSE(SecretSanta::DaemonPayloadLength(std::string{"\0\0\1", 3}).has_value());
+  EXPECT_EQ(SecretSanta::DaemonPayloadLength(std::string{"\0\0\1\2", 4}), 258);
+  EXPECT_EQ(SecretSanta::DaemonPayloadLength(std::string{"\x80\0\0\0", 4}), 0x80000000);
+}
+
+TEST(DaemonProtocol, MalformedRequest) {
+  // Empty payload.
+  EXPECT_FALSE(SecretSanta::ParseDaemonRequest("").has_value());
+
+  // Unknown operations.
+  EXPECT_FALSE(SecretSanta::ParseDaemonRequest(std::string{"\0", 1}).has_value());
+  EXPECT_FALSE(SecretSanta::ParseDaemonRequest("\4").has_value());
+
+  // Field that ends in the middle of its length or of its bytes.
+  EXPECT_FALSE(SecretSanta::ParseDaemonRequest(std::string{"\1\0\0", 3}).has_value());
+  EXPECT_FALSE(SecretSanta::ParseDaemonRequest(std::string{"\1\0\0\0\5abc", 8}).has_value());
+
+  // Too many fields.
+  std::string frame;
+  SecretSanta::AppendDaemonRequest(
+      frame, SecretSanta::DaemonOperation::Verify, {"a", "b", "c", "d", "e"});
+  EXPECT_FALSE(SecretSanta::ParseDaemonRequest(std::string_view{frame}.substr(4)).has_value());
+
+  // An operation without fields is well formed.
+  const std::optional<SecretSanta::DaemonRequest> request =
+      SecretSanta::ParseDaemonRequest("\2");
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->operation, SecretSanta::DaemonOperation::Verify);
+  EXPECT_EQ(request->field_count, 0);
+}
+
+}  // namespace
@@ -0,0 +1,192 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/DaemonServer.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../source/DaemonClient.hpp"
+
+namespace {
+
+// Path to the sample configuration file.
+const std::string configuration_file{"../test/configuration.yaml"};
+
+TEST(DaemonServer, Listen) {
+  const std::filesystem::path path = "daemon_server_listen.sock";
+  SecretSanta::DaemonService service;
+  {
+    const SecretSanta::DaemonServer server{service, path};
+    ASSERT_TRUE(server.IsListening());
+    EXPECT_EQ(server.Path(), path);
+
+    // Only the owner of the socket file can connect to it.
+    EXPECT_TRUE(std::filesystem::is_socket(path));
+    EXPECT_EQ(std::filesystem::status(path).permissions() & std::filesystem::perms::all,
+              std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+  }
+  EXPECT_FALSE(std::filesystem::exists(path));
+
+  // A path that is too long for a Unix domain socket cannot be listened on.
+  const SecretSanta::DaemonServer server{service, std::string(200, 'a')};
+  EXPECT_FALSE(server.IsListening());
+}
+
+TEST(DaemonServer, Call) {
+  const std::filesystem::path path = "daemon_server_call.sock";
+  SecretSanta::DaemonService service;
+  const SecretSanta::DaemonServer server{service, path};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::DaemonClient client{path};
+  ASSERT_TRUE(client.IsConnected());
+
+  const std::string matchings_file{"daemon_server_matchings.yaml"};
+  std::optional<SecretSanta::DaemonResponse> response =
+      client.Call(SecretSanta::DaemonOperation::Randomize, {configuration_file, matchings_file});
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, SecretSanta::DaemonStatus::Ok);
+
+  response =
+      client.Call(SecretSanta::DaemonOperation::Verify, {configuration_file, matchings_file});
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, SecretSanta::DaemonStatus::Ok);
+
+  response = client.Call(SecretSanta::DaemonOperation::Render,
+                         {configuration_file, matchings_file, "Alice Smith"});
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, SecretSanta::DaemonStatus::Ok);
+  EXPECT_EQ(response->text.substr(0, 18), "Hello Alice Smith,");
+
+  EXPECT_EQ(server.RequestCount(), 3);
+  EXPECT_EQ(server.ErrorCount(), 0);
+  EXPECT_EQ(server.ConnectionCount(), 1);
+}
+
+TEST(DaemonServer, Pipelining) {
+  const std::filesystem::path path = "daemon_server_pipelining.sock";
+  SecretSanta::DaemonService service;
+  const SecretSanta::DaemonServer server{service, path};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::DaemonClient client{path};
+  const std::string matchings_file{"daemon_server_pipelining.yaml"};
+  ASSERT_TRUE(client.Send(
+      SecretSanta::DaemonOperation::Randomize, {configuration_file, matchings_file, "3"}));
+  ASSERT_TRUE(client.Send(SecretSanta::DaemonOperation::Render,
+                          {configuration_file, matchings_file, "Dave Brown"}));
+  ASSERT_TRUE(client.Send(SecretSanta::DaemonOperation::Verify, {configuration_file}));
+
+  // The responses come back in the order of the requests.
+  std::optional<SecretSanta::DaemonResponse> response = client.Receive();
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, SecretSanta::DaemonStatus::Ok);
+  response = client.Receive();
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, SecretSanta::DaemonStatus::NotFound);
+  response = client.Receive();
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, SecretSanta::DaemonStatus::Error);
+  EXPECT_EQ(server.ErrorCount(), 1);
+}
+
+TEST(DaemonServer, ConcurrentClients) {
+  const std::filesystem::path path = "daemon_server_concurrent.sock";
+  SecretSanta::DaemonService service;
+  const SecretSanta::DaemonServer server{service, path, 4};
+  ASSERT_TRUE(server.IsListening());
+
+  const std::string matchings_file{"daemon_server_concurrent.yaml"};
+  {
+    SecretSanta::DaemonClient client{path};
+    ASSERT_TRUE(client.Call(
+        SecretSanta::DaemonOperation::Randomize, {configuration_file, matchings_file}));
+  }
+
+  constexpr std::size_t client_count{8};
+  constexpr std::size_t request_count{100};
+  std::vector<std::size_t> ok_counts(client_count, 0);
+  std::vector<std::thread> threads;
+  for (std::size_t index = 0; index < client_count; ++index) {
+    threads.emplace_back([&, index]() {
+      SecretSanta::DaemonClient client{path};
+      for (std::size_t request = 0; request < request_count; ++request) {
+        const std::optional<SecretSanta::DaemonResponse> response =
+            client.Call(SecretSanta::DaemonOperation::Render,
+                        {configuration_file, matchings_file, "Bob Johnson"});
+        if (response.has_value() && response->status == SecretSanta::DaemonStatus::Ok) {
+          ++ok_counts[index];
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (const std::size_t ok_count : ok_counts) {
+    EXPECT_EQ(ok_count, request_count);
+  }
+  EXPECT_EQ(server.RequestCount(), 1 + client_count * request_count);
+  EXPECT_EQ(service.FileReadCount(), 1);
+}
+
+TEST(DaemonServer, RequestTooLarge) {
+  const std::filesystem::path path = "daemon_server_too_large.sock";
+  SecretSanta::DaemonService service;
+  const SecretSanta::DaemonServer server{service, path};
+  ASSERT_TRUE(server.IsListening());
+
+  const SecretSanta::Socket socket{SecretSanta::ConnectToUnixSocket(path)};
+  ASSERT_TRUE(socket.WriteAll(std::string{"\xFF\xFF\xFF\xFF\x01", 5}));
+
+  // The request is answered with an error, after which the connection is closed.
+  std::string received;
+  char buffer[256];
+  ssize_t count = 0;
+  while ((count = ::recv(socket.Descriptor(), buffer, sizeof(buffer), 0)) > 0) {
+    received.append(buffer, static_cast<std::size_t>(count));
+  }
+  ASSERT_GT(received.size(), 5);
+  EXPECT_EQ(static_cast<SecretSanta::DaemonStatus>(received[4]), SecretSanta::DaemonStatus::Error);
+  EXPECT_EQ(received.substr(5), "The request is too large.");
+}
+
+TEST(DaemonServer, ConnectionLimit) {
+  const std::filesystem::path path = "daemon_server_limit.sock";
+  SecretSanta::DaemonService service;
+  const SecretSanta::DaemonServer server{service, path, 1, 1};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::DaemonClient first{path};
+  ASSERT_TRUE(first.Call(SecretSanta::DaemonOperation::Verify, {}).has_value());
+
+  // The second connection is closed at once, since the first one takes the only room.
+  SecretSanta::DaemonClient second{path};
+  EXPECT_FALSE(second.Call(SecretSanta::DaemonOperation::Verify, {}).has_value());
+  EXPECT_EQ(server.RefusedConnectionCount(), 1);
+}
+
+}  // namespace
@@ -0,0 +1,184 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/DaemonService.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+namespace {
+
+// Path to the sample configuration file.
+const std::string configuration_file{"../test/configuration.yaml"};
+
+// Response of the service to one request, with its own copy of the text.
+struct Reply {
+  // Status of the response.
+  SecretSanta::DaemonStatus status{SecretSanta::DaemonStatus::Ok};
+
+  // Text of the response.
+  std::string text;
+};
+
+// Sends a request with a given operation and given fields to a given service and returns its
+// response.
+Reply Call(SecretSanta::DaemonService& service, const SecretSanta::DaemonOperation operation,
+           const std::initializer_list<std::string_view> fields) {
+  std::string request;
+  SecretSanta::AppendDaemonRequest(request, operation, fields);
+  std::string output;
+  const SecretSanta::DaemonStatus status =
+      service.Respond(std::string_view{request}.substr(4), output);
+  const std::optional<SecretSanta::DaemonResponse> response =
+      SecretSanta::ParseDaemonResponse(std::string_view{output}.substr(4));
+  EXPECT_TRUE(response.has_value());
+  EXPECT_EQ(response->status, status);
+  return Reply{response->status, std::string{response->text}};
+}
+
+TEST(DaemonService, Randomize) {
+  SecretSanta::DaemonService service;
+  const std::string matchings_file{"daemon_service_matchings.yaml"};
+
+  const Reply reply = Call(service, SecretSanta::DaemonOperation::Randomize,
+                           {configuration_file, matchings_file, "42"});
+  EXPECT_EQ(reply.status, SecretSanta::DaemonStatus::Ok);
+
+  // The response and the matchings file hold the same matchings as the Secret Santa Randomizer
+  // draws with the same random seed.
+  const SecretSanta::Configuration configuration{configuration_file};
+  const SecretSanta::Matchings expected{configuration.Participants(), 42};
+  EXPECT_EQ(reply.text, expected.Yaml());
+  EXPECT_EQ(SecretSanta::Matchings{matchings_file}, expected);
+
+  // Without a random seed, the matchings are still valid, and no file is written without a path.
+  const Reply random = Call(service, SecretSanta::DaemonOperation::Randomize,
+                            {configuration_file, ""});
+  EXPECT_EQ(random.status, SecretSanta::DaemonStatus::Ok);
+  EXPECT_NE(random.text.find("gifters_to_giftees"), std::string::npos);
+}
+
+TEST(DaemonService, Verify) {
+  SecretSanta::DaemonService service;
+  const std::string matchings_file{"daemon_service_verify.yaml"};
+  ASSERT_EQ(Call(service, SecretSanta::DaemonOperation::Randomize,
+                 {configuration_file, matchings_file})
+                .status,
+            SecretSanta::DaemonStatus::Ok);
+
+  const Reply valid =
+      Call(service, SecretSanta::DaemonOperation::Verify, {configuration_file, matchings_file});
+  EXPECT_EQ(valid.status, SecretSanta::DaemonStatus::Ok);
+  EXPECT_EQ(valid.text.substr(0, 24), "The matchings are valid:");
+
+  // The matchings file is read again once it changes.
+  {
+    std::ofstream stream{matchings_file};
+    stream << "gifters_to_giftees:\n"
+           << "  - Alice Smith: Alice Smith\n"
+           << "  - Bob Johnson: Claire Jones\n"
+           << "  - Claire Jones: Bob Johnson\n";
+  }
+  const Reply invalid =
+      Call(service, SecretSanta::DaemonOperation::Verify, {configuration_file, matchings_file});
+  EXPECT_EQ(invalid.status, SecretSanta::DaemonStatus::Invalid);
+  EXPECT_EQ(invalid.text.substr(0, 26), "The matchings are invalid.");
+}
+
+TEST(DaemonService, Render) {
+  SecretSanta::DaemonService service;
+  const std::string matchings_file{"daemon_service_render.yaml"};
+  ASSERT_EQ(Call(service, SecretSanta::DaemonOperation::Randomize,
+                 {configuration_file, matchings_file, "7"})
+                .status,
+            SecretSanta::DaemonStatus::Ok);
+
+  const SecretSanta::Configuration configuration{configuration_file};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 7};
+  for (const SecretSanta::Participant& gifter : configuration.Participants()) {
+    const Reply reply = Call(service, SecretSanta::DaemonOperation::Render,
+                             {configuration_file, matchings_file, gifter.Name()});
+    EXPECT_EQ(reply.status, SecretSanta::DaemonStatus::Ok);
+    EXPECT_EQ(reply.text,
+              SecretSanta::ComposeFullMessageBody(
+                  gifter, SecretSanta::FindGiftees(configuration, matchings, gifter),
+                  configuration.MessageBody()));
+  }
+
+  EXPECT_EQ(Call(service, SecretSanta::DaemonOperation::Render,
+                 {configuration_file, matchings_file, "Dave Brown"})
+                .status,
+            SecretSanta::DaemonStatus::NotFound);
+}
+
+TEST(DaemonService, Cache) {
+  SecretSanta::DaemonService service;
+  const std::string matchings_file{"daemon_service_cache.yaml"};
+  static_cast<void>(Call(
+      service, SecretSanta::DaemonOperation::Randomize, {configuration_file, matchings_file}));
+  EXPECT_EQ(service.FileReadCount(), 1);
+
+  // The configuration file is parsed once, and the matchings just written are not read back.
+  for (int index = 0; index < 10; ++index) {
+    static_cast<void>(Call(service, SecretSanta::DaemonOperation::Render,
+                           {configuration_file, matchings_file, "Alice Smith"}));
+  }
+  EXPECT_EQ(service.FileReadCount(), 1);
+  EXPECT_EQ(service.CacheHitCount(), 20);
+}
+
+TEST(DaemonService, Errors) {
+  SecretSanta::DaemonService service;
+
+  std::string output;
+  EXPECT_EQ(service.Respond("\7", output), SecretSanta::DaemonStatus::Error);
+
+  EXPECT_EQ(Call(service, SecretSanta::DaemonOperation::Randomize, {configuration_file}).status,
+            SecretSanta::DaemonStatus::Error);
+  EXPECT_EQ(
+      Call(service, SecretSanta::DaemonOperation::Randomize, {configuration_file, "", "seed"})
+          .status,
+      SecretSanta::DaemonStatus::Error);
+  EXPECT_EQ(Call(service, SecretSanta::DaemonOperation::Randomize,
+                 {"path/to/missing/configuration.yaml", ""})
+                .status,
+            SecretSanta::DaemonStatus::Error);
+  EXPECT_EQ(Call(service, SecretSanta::DaemonOperation::Verify,
+                 {configuration_file, "path/to/missing/matchings.yaml"})
+                .status,
+            SecretSanta::DaemonStatus::Error);
+
+  // A file that is not valid YAML is answered with an error rather than stopping the service.
+  const std::string malformed_file{"daemon_service_malformed.yaml"};
+  {
+    std::ofstream stream{malformed_file};
+    stream << "participants: [Alice Smith\n";
+  }
+  const Reply reply =
+      Call(service, SecretSanta::DaemonOperation::Randomize, {malformed_file, ""});
+  EXPECT_EQ(reply.status, SecretSanta::DaemonStatus::Error);
+  EXPECT_EQ(reply.text.substr(0, 19), "The request failed:");
+}
+
+}  // namespace
@@ -0,0 +1,113 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/DeadLetters.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(DeadLetters, DefaultConstructor) {
+  const SecretSanta::DeadLetters dead_letters;
+  EXPECT_TRUE(dead_letters.Empty());
+  EXPECT_EQ(dead_letters.Size(), 0);
+}
+
+TEST(DeadLetters, MalformedFile) {
+  const std::filesystem::path path{"malformed_dead_letters.yaml"};
+  std::ofstream stream{path};
+  stream << "dead_letters:\n"
+            "  - gifter: Alice Smith\n"
+            "    recipient: alice@example.com\n"
+            "  - gifter: Bob Jones\n"
+            "    recipient: bob@example.com\n"
+            "    subject: Secret Santa\n"
+            "    body: Hello!\n";
+  stream.close();
+
+  const SecretSanta::DeadLetters dead_letters{path};
+  ASSERT_EQ(dead_letters.Size(), 1);
+  EXPECT_EQ(dead_letters.Entries()[0].message.GifterName(), "Bob Jones");
+  EXPECT_EQ(dead_letters.Entries()[0].attempts, 0);
+}
+
+TEST(DeadLetters, MissingFile) {
+  const SecretSanta::DeadLetters dead_letters{std::filesystem::path{"missing_dead_letters.yaml"}};
+  EXPECT_TRUE(dead_letters.Empty());
+}
+
+TEST(DeadLetters, WriteAndRead) {
+  SecretSanta::DeadLetters written;
+  written.Add({SecretSanta::EmailMessage{"Alice Smith", "alice@example.com", "Secret Santa: Hello!",
+                                         "Hello Alice,\n\n  Indented line: \"quoted\" #hash\n\n"
+                                         "Thank you!\n"},
+               3, "451 4.3.0 Try again later"});
+  written.Add({SecretSanta::EmailMessage{"Bob Jones", "bob@example.com", "Secret Santa", "Hi"}, 1,
+               "550 5.1.1 Mailbox unavailable"});
+  written.Add({SecretSanta::EmailMessage{"Claire Jones", "claire@example.com", "Secret Santa",
+                                         "  Indented first line\nLast lines\n\n"},
+               2, "421 4.4.2 Connection dropped"});
+
+  const std::filesystem::path path{"dead_letters.yaml"};
+  written.Write(path);
+
+  EXPECT_EQ(std::filesystem::status(path).permissions() & std::filesystem::perms::others_read,
+            std::filesystem::perms::none);
+
+  const SecretSanta::DeadLetters read{path};
+  ASSERT_EQ(read.Size(), 3);
+  for (std::size_t index = 0; index < 3; ++index) {
+    EXPECT_EQ(read.Entries()[index].message.GifterName(),
+              written.Entries()[index].message.GifterName());
+    EXPECT_EQ(read.Entries()[index].message.Recipient(),
+              written.Entries()[index].message.Recipient());
+    EXPECT_EQ(read.Entries()[index].message.Subject(), written.Entries()[index].message.Subject());
+    EXPECT_EQ(read.Entries()[index].message.Body(), written.Entries()[index].message.Body());
+    EXPECT_EQ(read.Entries()[index].attempts, written.Entries()[index].attempts);
+    EXPECT_EQ(read.Entries()[index].details, written.Entries()[index].details);
+  }
+  EXPECT_EQ(read.Messages().size(), 3);
+}
+
+TEST(DeadLetters, WriteAndReadWithHtmlAndAttachments) {
+  SecretSanta::EmailMessage message{"Alice Smith", "alice@example.com", "Secret Santa", "Hi\n"};
+  message.SetHtml("<p>Hi</p>");
+  message.Attach(SecretSanta::EncodeAttachment(
+      "invite.ics", "text/calendar", std::string{"BEGIN:VCALENDAR\r\n\0\xFF", 18}));
+  SecretSanta::DeadLetters written;
+  written.Add({message, 4, "451 4.3.0 Try again later"});
+
+  const std::filesystem::path path{"dead_letters_with_attachments.yaml"};
+  written.Write(path);
+
+  const SecretSanta::DeadLetters read{path};
+  ASSERT_EQ(read.Size(), 1);
+  const SecretSanta::EmailMessage& read_message = read.Entries()[0].message;
+  EXPECT_EQ(read_message.Html(), "<p>Hi</p>");
+  ASSERT_EQ(read_message.Attachments().size(), 1);
+  EXPECT_EQ(read_message.Attachments()[0]->file_name, "invite.ics");
+  EXPECT_EQ(read_message.Attachments()[0]->content_type, "text/calendar");
+  EXPECT_EQ(read_message.Attachments()[0]->data, message.Attachments()[0]->data);
+  EXPECT_EQ(read_message.Attachments()[0]->encoded_part, message.Attachments()[0]->encoded_part);
+}
+
+}  // namespace
@@ -0,0 +1,100 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/DeliveryOutcomes.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(DeliveryOutcomes, DefaultConstructor) {
+  const SecretSanta::DeliveryOutcomes outcomes;
+  EXPECT_EQ(outcomes.Size(), 0);
+  EXPECT_FALSE(outcomes.HostShard().has_value());
+  EXPECT_EQ(outcomes.Host(), "");
+}
+
+TEST(DeliveryOutcomes, DeliveryStatus) {
+  for (const SecretSanta::DeliveryStatus status :
+       {SecretSanta::DeliveryStatus::Delivered, SecretSanta::DeliveryStatus::TransientFailure,
+        SecretSanta::DeliveryStatus::PermanentFailure}) {
+    EXPECT_EQ(SecretSanta::ParseDeliveryStatus(SecretSanta::PrintDeliveryStatus(status)), status);
+  }
+  EXPECT_EQ(SecretSanta::PrintDeliveryStatus(SecretSanta::DeliveryStatus::Delivered), "delivered");
+  EXPECT_FALSE(SecretSanta::ParseDeliveryStatus("lost").has_value());
+}
+
+TEST(DeliveryOutcomes, MalformedFile) {
+  const std::filesystem::path path{"malformed_outcomes.yaml"};
+  std::ofstream stream{path};
+  stream << "shard: 5/3\n"
+            "outcomes:\n"
+            "  - gifter: Alice Smith\n"
+            "    recipient: alice@example.com\n"
+            "  - gifter: Bob Jones\n"
+            "    recipient: bob@example.com\n"
+            "    status: lost\n"
+            "  - gifter: Claire Jones\n"
+            "    recipient: claire@example.com\n"
+            "    status: delivered\n";
+  stream.close();
+
+  const SecretSanta::DeliveryOutcomes outcomes{path};
+  ASSERT_EQ(outcomes.Size(), 1);
+  EXPECT_EQ(outcomes.Entries()[0].gifter, "Claire Jones");
+  EXPECT_EQ(outcomes.Entries()[0].attempts, 0);
+  EXPECT_FALSE(outcomes.HostShard().has_value());
+}
+
+TEST(DeliveryOutcomes, MissingFile) {
+  const SecretSanta::DeliveryOutcomes outcomes{std::filesystem::path{"missing_outcomes.yaml"}};
+  EXPECT_EQ(outcomes.Size(), 0);
+}
+
+TEST(DeliveryOutcomes, WriteAndRead) {
+  SecretSanta::DeliveryOutcomes written;
+  written.SetOrigin(SecretSanta::Shard{2, 3}, "host-2");
+  written.Add({"Alice Smith", "alice@example.com", SecretSanta::DeliveryStatus::Delivered, 1, ""});
+  written.Add({"Bob Jones", "bob@example.com", SecretSanta::DeliveryStatus::PermanentFailure, 1,
+               "550 5.1.1 Mailbox unavailable"});
+  written.Add({"Claire Jones", "claire@example.com", SecretSanta::DeliveryStatus::TransientFailure,
+               4, "451 4.3.0 Try again later"});
+
+  const std::filesystem::path path{"outcomes.yaml"};
+  written.Write(path);
+
+  const SecretSanta::DeliveryOutcomes read{path};
+  EXPECT_EQ(read.HostShard(), SecretSanta::Shard(2, 3));
+  EXPECT_EQ(read.Host(), "host-2");
+  ASSERT_EQ(read.Size(), 3);
+  for (std::size_t index = 0; index < 3; ++index) {
+    EXPECT_EQ(read.Entries()[index].gifter, written.Entries()[index].gifter);
+    EXPECT_EQ(read.Entries()[index].recipient, written.Entries()[index].recipient);
+    EXPECT_EQ(read.Entries()[index].status, written.Entries()[index].status);
+    EXPECT_EQ(read.Entries()[index].attempts, written.Entries()[index].attempts);
+    EXPECT_EQ(read.Entries()[index].details, written.Entries()[index].details);
+  }
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace
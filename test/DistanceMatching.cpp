@@ -0,0 +1,170 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/DistanceMatching.hpp"
+
+#include <gtest/gtest.h>
+#include <set>
+
+namespace {
+
+// Checks that given giftees form a derangement: each participant has a distinct giftee other than
+// themselves.
+void ExpectDerangement(const std::vector<uint32_t>& giftees) {
+  std::set<uint32_t> distinct;
+  for (std::size_t gifter = 0; gifter < giftees.size(); ++gifter) {
+    EXPECT_NE(giftees[gifter], gifter);
+    EXPECT_LT(giftees[gifter], giftees.size());
+    distinct.insert(giftees[gifter]);
+  }
+  EXPECT_EQ(distinct.size(), giftees.size());
+}
+
+TEST(DistanceMatching, ParseDistanceObjective) {
+  EXPECT_EQ(SecretSanta::ParseDistanceObjective("total"), SecretSanta::DistanceObjective::Total);
+  EXPECT_EQ(
+      SecretSanta::ParseDistanceObjective("maximum"), SecretSanta::DistanceObjective::Maximum);
+  EXPECT_FALSE(SecretSanta::ParseDistanceObjective("minimum").has_value());
+  EXPECT_EQ(SecretSanta::DistanceObjectiveName(SecretSanta::DistanceObjective::Maximum), "maximum");
+}
+
+TEST(DistanceMatching, FewParticipants) {
+  std::mt19937_64 random_generator{42};
+  EXPECT_TRUE(SecretSanta::MatchByDistance({}, {}, random_generator).giftees.empty());
+  EXPECT_TRUE(
+      SecretSanta::MatchByDistance({SecretSanta::Coordinates{}}, {}, random_generator)
+          .giftees.empty());
+  EXPECT_EQ(SecretSanta::MatchByDistance(
+                {SecretSanta::Coordinates{}, SecretSanta::Coordinates{1.0, 1.0}}, {},
+                random_generator)
+                .giftees,
+            (std::vector<uint32_t>{1, 0}));
+}
+
+TEST(DistanceMatching, NearbyParticipantsAreMatched) {
+  // Two participants in Los Angeles and two in New York.
+  const std::vector<std::optional<SecretSanta::Coordinates>> locations{
+    SecretSanta::Coordinates{34.05, -118.24}, SecretSanta::Coordinates{40.71, -74.00},
+    SecretSanta::Coordinates{34.06, -118.25}, SecretSanta::Coordinates{40.72, -74.01},
+  };
+  for (int64_t seed = 0; seed < 10; ++seed) {
+    std::mt19937_64 random_generator{static_cast<uint64_t>(seed)};
+    const SecretSanta::DistanceMatchingResult result{
+        SecretSanta::MatchByDistance(locations, {}, random_generator)};
+    EXPECT_EQ(result.giftees, (std::vector<uint32_t>{2, 3, 0, 1}));
+    EXPECT_LT(result.total_kilometers, 10.0);
+    EXPECT_LT(result.maximum_kilometers, 2.0);
+  }
+}
+
+TEST(DistanceMatching, MaximumDistance) {
+  // Six participants along the equator, 100 km apart. Pairs of neighbors achieve the shortest
+  // possible longest distance.
+  std::vector<std::optional<SecretSanta::Coordinates>> locations;
+  for (int index = 0; index < 6; ++index) {
+    locations.push_back(SecretSanta::Coordinates{0.0, index * 0.9});
+  }
+  std::mt19937_64 random_generator{42};
+  SecretSanta::DistanceMatchingOptions options;
+  options.objective = SecretSanta::DistanceObjective::Maximum;
+  const SecretSanta::DistanceMatchingResult result{
+      SecretSanta::MatchByDistance(locations, options, random_generator)};
+  ExpectDerangement(result.giftees);
+  EXPECT_NEAR(result.maximum_kilometers, 100.1, 0.1);
+}
+
+TEST(DistanceMatching, FarParticipant) {
+  // Three participants close together and one far away to the east. The far participant gifts to
+  // and receives from the nearest of the three, which is the best matching for either objective.
+  const std::vector<std::optional<SecretSanta::Coordinates>> locations{
+    SecretSanta::Coordinates{0.0, 0.0},
+    SecretSanta::Coordinates{0.0, 0.1},
+    SecretSanta::Coordinates{0.0, 0.2},
+    SecretSanta::Coordinates{0.0, 10.0},
+  };
+  for (const SecretSanta::DistanceObjective objective :
+       {SecretSanta::DistanceObjective::Total, SecretSanta::DistanceObjective::Maximum}) {
+    std::mt19937_64 random_generator{42};
+    SecretSanta::DistanceMatchingOptions options;
+    options.objective = objective;
+    const SecretSanta::DistanceMatchingResult result{
+        SecretSanta::MatchByDistance(locations, options, random_generator)};
+    ExpectDerangement(result.giftees);
+    EXPECT_EQ(result.giftees[3], 2);
+    EXPECT_NEAR(result.maximum_kilometers, 1090.0, 5.0);
+  }
+}
+
+TEST(DistanceMatching, UnknownLocations) {
+  std::vector<std::optional<SecretSanta::Coordinates>> locations;
+  for (int index = 0; index < 20; ++index) {
+    if (index % 3 == 0) {
+      locations.emplace_back();
+    } else {
+      locations.push_back(SecretSanta::Coordinates{index * 1.0, index * 2.0});
+    }
+  }
+  std::mt19937_64 random_generator{42};
+  ExpectDerangement(SecretSanta::MatchByDistance(locations, {}, random_generator).giftees);
+}
+
+TEST(DistanceMatching, Randomness) {
+  // Points on a regular grid have many equally short matchings, among which the randomness picks.
+  std::vector<std::optional<SecretSanta::Coordinates>> locations;
+  for (int row = 0; row < 10; ++row) {
+    for (int column = 0; column < 10; ++column) {
+      locations.push_back(SecretSanta::Coordinates{row * 0.01, column * 0.01});
+    }
+  }
+  SecretSanta::DistanceMatchingOptions options;
+  options.randomness = 0.5;
+  std::set<std::vector<uint32_t>> distinct;
+  for (uint64_t seed = 0; seed < 5; ++seed) {
+    std::mt19937_64 random_generator{seed};
+    const SecretSanta::DistanceMatchingResult result{
+        SecretSanta::MatchByDistance(locations, options, random_generator)};
+    ExpectDerangement(result.giftees);
+    // Each gifter still ships to a nearby giftee.
+    EXPECT_LT(result.maximum_kilometers, 5.0);
+    distinct.insert(result.giftees);
+  }
+  EXPECT_GT(distinct.size(), 1);
+}
+
+TEST(DistanceMatching, ManyParticipants) {
+  std::mt19937_64 random_generator{42};
+  std::uniform_real_distribution<double> latitude{25.0, 49.0};
+  std::uniform_real_distribution<double> longitude{-124.0, -67.0};
+  std::vector<std::optional<SecretSanta::Coordinates>> locations;
+  for (int index = 0; index < 20'000; ++index) {
+    locations.push_back(
+        SecretSanta::Coordinates{latitude(random_generator), longitude(random_generator)});
+  }
+  SecretSanta::DistanceMatchingOptions options;
+  options.thread_count = 4;
+  const SecretSanta::DistanceMatchingResult result{
+      SecretSanta::MatchByDistance(locations, options, random_generator)};
+  ExpectDerangement(result.giftees);
+  // Random pairs across the contiguous United States are about 1800 km apart on average, whereas
+  // nearby pairs are a few dozen kilometers apart.
+  EXPECT_LT(result.total_kilometers / 20'000.0, 50.0);
+}
+
+}  // namespace
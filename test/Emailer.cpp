@@ -20,9 +20,14 @@
 
 #include "../source/Emailer.hpp"
 
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <sstream>
 
 #include "CreateSampleParticipant.hpp"
+#include "RecordingTransport.hpp"
 
 namespace {
 
@@ -44,6 +49,22 @@ TEST(Emailer, ComposeFullMessageBody) {
             "Johnson SECRET SANTA\n456 Second St, Apt 2, Villagetown, CA 92345 USA\n\nThank you!");
 }
 
+TEST(Emailer, ComposeFullMessageBodyWithSeveralGiftees) {
+  const SecretSanta::Participant gifter{SecretSanta::CreateSampleParticipantA()};
+  const SecretSanta::Participant first_giftee{SecretSanta::CreateSampleParticipantB()};
+  const SecretSanta::Participant second_giftee{SecretSanta::CreateSampleParticipantC()};
+
+  const std::string result{SecretSanta::ComposeFullMessageBody(
+      gifter, std::vector<const SecretSanta::Participant*>{&first_giftee, &second_giftee},
+      "My Message Body")};
+
+  EXPECT_EQ(result.find("Hello Alice Smith,\n\nMy Message Body\n\nYour 2 giftees are: Bob Johnson "
+                        "and Claire Jones\n\nMail to:\n\nBob Johnson SECRET SANTA\n"),
+            0);
+  EXPECT_NE(result.find("\n\nMail to:\n\nClaire Jones SECRET SANTA\n"), std::string::npos);
+  EXPECT_TRUE(result.ends_with("\n\nThank you!"));
+}
+
 TEST(Emailer, ComposeCommand) {
   const SecretSanta::Participant gifter{SecretSanta::CreateSampleParticipantA()};
   const std::string message_subject{"My Message Subject"};
@@ -51,9 +72,191 @@ TEST(Emailer, ComposeCommand) {
 
   const std::string command{SecretSanta::ComposeCommand(gifter, message_subject, message_body)};
 
-  EXPECT_EQ(
-      command,
-      "echo \"My Message Body\" | s-nail --subject \"My Message Subject\" alice.smith@gmail.com");
+  EXPECT_EQ(command,
+            "printf '%s\\n' 'My Message Body' | s-nail -S ttycharset=utf-8 -S sendcharsets=utf-8"
+            " -S mime-encoding=quoted-printable --subject 'My Message Subject'"
+            " 'alice.smith@gmail.com'");
+}
+
+TEST(Emailer, ComposeCommandQuotesArguments) {
+  EXPECT_EQ(SecretSanta::ComposeCommand("bob@example.com", "Bob's \"gift\"", "$HOME `id` \\n"),
+            "printf '%s\\n' '$HOME `id` \\n' | s-nail -S ttycharset=utf-8 -S sendcharsets=utf-8"
+            " -S mime-encoding=quoted-printable --subject 'Bob'\\''s \"gift\"'"
+            " 'bob@example.com'");
+}
+
+TEST(Emailer, ComposeCommandWithAttachments) {
+  EXPECT_EQ(SecretSanta::ComposeCommand("bob@example.com", "Subject", "Body",
+                                        {"/tmp/secret-santa-a/invite.ics", "/tmp/it's.txt"}),
+            "printf '%s\\n' 'Body' | s-nail -S ttycharset=utf-8 -S sendcharsets=utf-8"
+            " -S mime-encoding=quoted-printable --subject 'Subject'"
+            " -a '/tmp/secret-santa-a/invite.ics' -a '/tmp/it'\\''s.txt' 'bob@example.com'");
+}
+
+TEST(Emailer, SNailTransportSendsAttachments) {
+  // Stands in for S-nail with a script that records the path and contents of the attached file.
+  const std::filesystem::path directory{std::filesystem::absolute("fake_snail")};
+  std::filesystem::create_directories(directory);
+  {
+    std::ofstream script{directory / "s-nail"};
+    script << "#!/bin/sh\n"
+           << "while [ $# -gt 0 ]; do\n"
+           << "  if [ \"$1\" = -a ]; then echo \"$2\" > " << directory / "path" << "; cat \"$2\" > "
+           << directory / "contents" << "; shift; fi\n"
+           << "  shift\n"
+           << "done\n";
+  }
+  std::filesystem::permissions(directory / "s-nail", std::filesystem::perms::owner_all);
+  const std::string path_variable{std::getenv("PATH") != nullptr ? std::getenv("PATH") : ""};
+  ::setenv("PATH", (directory.string() + ":" + path_variable).c_str(), 1);
+
+  SecretSanta::EmailMessage message{"Alice Smith", "alice.smith@gmail.com", "Subject", "Body"};
+  message.Attach(std::make_shared<const SecretSanta::EmailAttachment>(
+      SecretSanta::EmailAttachment{"invite.ics", "text/calendar", "BEGIN:VCALENDAR", ""}));
+  SecretSanta::SNailTransport transport;
+  SecretSanta::DeliveryStatus status{SecretSanta::DeliveryStatus::PermanentFailure};
+  transport.Send(message, [&status](const SecretSanta::EmailMessage& /*message*/,
+                                    const SecretSanta::Delivery& delivery) {
+    status = delivery.Status();
+  });
+  ::setenv("PATH", path_variable.c_str(), 1);
+
+  EXPECT_EQ(status, SecretSanta::DeliveryStatus::Delivered);
+  std::ifstream path_stream{directory / "path"};
+  std::string attachment_path;
+  std::getline(path_stream, attachment_path);
+  EXPECT_EQ(std::filesystem::path{attachment_path}.filename(), "invite.ics");
+  EXPECT_FALSE(std::filesystem::exists(attachment_path));
+  std::ifstream contents_stream{directory / "contents"};
+  std::stringstream contents;
+  contents << contents_stream.rdbuf();
+  EXPECT_EQ(contents.str(), "BEGIN:VCALENDAR");
+  std::filesystem::remove_all(directory);
+}
+
+TEST(Emailer, ComposeEmailMessage) {
+  const SecretSanta::EmailMessage message{SecretSanta::ComposeEmailMessage(
+      SecretSanta::Participant{SecretSanta::CreateSampleParticipantA()},
+      SecretSanta::Participant{SecretSanta::CreateSampleParticipantB()}, "My Message Subject",
+      "My Message Body")};
+  EXPECT_EQ(message.GifterName(), "Alice Smith");
+  EXPECT_EQ(message.Recipient(), "alice.smith@gmail.com");
+  EXPECT_EQ(message.Subject(), "My Message Subject");
+  EXPECT_EQ(message.Body(), SecretSanta::ComposeFullMessageBody(
+                                SecretSanta::Participant{SecretSanta::CreateSampleParticipantA()},
+                                SecretSanta::Participant{SecretSanta::CreateSampleParticipantB()},
+                                "My Message Body"));
+}
+
+TEST(Emailer, ComposeAndSendEmailMessages) {
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::RecordingTransport transport;
+  SecretSanta::ComposeAndSendEmailMessages(configuration, matchings, transport);
+
+  const std::vector<SecretSanta::EmailMessage> messages{transport.Messages()};
+  ASSERT_EQ(messages.size(), 3);
+  std::set<std::string> gifter_names;
+  for (const SecretSanta::EmailMessage& message : messages) {
+    gifter_names.insert(message.GifterName());
+    EXPECT_EQ(message.Subject(), "Secret Santa Gift Exchange 2023");
+    const std::string& giftee_name = matchings.GiftersToGiftees().at(message.GifterName());
+    EXPECT_NE(message.Body().find("Your giftee is: " + giftee_name), std::string::npos);
+  }
+  EXPECT_EQ(gifter_names,
+            (std::set<std::string>{"Alice Smith", "Bob Johnson", "Claire Jones"}));
+
+  // Every email message shares the same calendar invitation, which is encoded once.
+  for (const SecretSanta::EmailMessage& message : messages) {
+    ASSERT_EQ(message.Attachments().size(), 1);
+    EXPECT_EQ(message.Attachments()[0], messages.front().Attachments()[0]);
+  }
+  EXPECT_EQ(messages.front().Attachments()[0]->file_name, "invite.ics");
+  EXPECT_EQ(messages.front().Attachments()[0]->content_type, "text/calendar");
+  EXPECT_FALSE(messages.front().Attachments()[0]->encoded_part.empty());
+  EXPECT_NE(messages.front().Attachments()[0]->data.find("DTSTART:20231223T140000\r\n"),
+            std::string::npos);
+}
+
+TEST(Emailer, WriteMatchingsAndSendEmailMessages) {
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  const std::filesystem::path path{"emailer_matchings.yaml"};
+  SecretSanta::RecordingTransport transport;
+  EXPECT_TRUE(
+      SecretSanta::WriteMatchingsAndSendEmailMessages(configuration, matchings, path, transport));
+  EXPECT_EQ(SecretSanta::Matchings{path}, matchings);
+  EXPECT_EQ(transport.Messages().size(), 3);
+  std::filesystem::remove(path);
+}
+
+TEST(Emailer, WriteMatchingsAndSendEmailMessagesWhenWritingFails) {
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  // The parent of the matchings file is a regular file, so the matchings file cannot be written.
+  const std::filesystem::path path{"../test/configuration.yaml/matchings.yaml"};
+  SecretSanta::RecordingTransport transport;
+  EXPECT_FALSE(
+      SecretSanta::WriteMatchingsAndSendEmailMessages(configuration, matchings, path, transport));
+  EXPECT_TRUE(transport.Messages().empty());
+}
+
+TEST(Emailer, ComposeAndSendEmailMessagesWithSeveralGifts) {
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42, std::nullopt, false, 2};
+  SecretSanta::RecordingTransport transport;
+  SecretSanta::ComposeAndSendEmailMessages(configuration, matchings, transport);
+
+  const std::vector<SecretSanta::EmailMessage> messages{transport.Messages()};
+  ASSERT_EQ(messages.size(), 3);
+  for (const SecretSanta::EmailMessage& message : messages) {
+    const std::vector<std::string> giftee_names{matchings.Giftees(message.GifterName())};
+    ASSERT_EQ(giftee_names.size(), 2);
+    EXPECT_NE(message.Body().find("Your 2 giftees are: " + giftee_names[0] + " and "
+                                  + giftee_names[1]),
+              std::string::npos);
+  }
+}
+
+TEST(Emailer, ComposeAndSendEmailMessagesToGivenGifters) {
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::RecordingTransport transport;
+  SecretSanta::ComposeAndSendEmailMessages(
+      configuration, matchings, transport, std::set<std::string>{"Bob Johnson"});
+
+  const std::vector<SecretSanta::EmailMessage> messages{transport.Messages()};
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages.front().GifterName(), "Bob Johnson");
+  EXPECT_EQ(messages.front().Recipient(), "bob.johnson@gmail.com");
+}
+
+TEST(Emailer, SendSpooledEmailMessages) {
+  const std::filesystem::path directory{"test_emailer_spool"};
+  std::filesystem::remove_all(directory);
+  const SecretSanta::Spool spool{directory};
+  ASSERT_TRUE(spool.Create());
+  for (const std::string name : {"alice", "bob"}) {
+    const SecretSanta::EmailMessage message{name, name + "@example.com", "Subject", "Body"};
+    ASSERT_EQ(spool.Write(SecretSanta::SpoolFileName(message),
+                          SecretSanta::ComposeMessageFile("santa@example.com", message, "date")),
+              "");
+  }
+  ASSERT_EQ(spool.Write("unreadable.eml", "Subject: No recipient\r\n\r\n"), "");
+
+  SecretSanta::RecordingTransport transport;
+  EXPECT_EQ(SecretSanta::SendSpooledEmailMessages(spool, transport), 1);
+
+  const std::vector<SecretSanta::EmailMessage> messages{transport.Messages()};
+  ASSERT_EQ(messages.size(), 2);
+  EXPECT_EQ(messages[0].Recipient(), "alice@example.com");
+  EXPECT_EQ(messages[1].Recipient(), "bob@example.com");
+
+  // Sending the spool again only finds the file that could not be read.
+  ASSERT_EQ(spool.Pending().size(), 1);
+  EXPECT_EQ(spool.Pending()[0].filename(), "unreadable.eml");
+  EXPECT_TRUE(std::filesystem::exists(directory / "cur" / "alice@example.com.eml"));
+  std::filesystem::remove_all(directory);
 }
 
 }  // namespace
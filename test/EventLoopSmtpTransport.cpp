@@ -0,0 +1,148 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/EventLoopSmtpTransport.hpp"
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <vector>
+
+#include "../source/SmtpSink.hpp"
+
+namespace {
+
+// Sends a given number of email messages through a given transport and returns the outcome of
+// each delivery.
+std::vector<SecretSanta::Delivery> SendMessages(
+    SecretSanta::Transport& transport, const std::size_t count) {
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  for (std::size_t index = 0; index < count; ++index) {
+    transport.Send(SecretSanta::EmailMessage{"Gifter " + std::to_string(index),
+                                             "gifter." + std::to_string(index) + "@example.com",
+                                             "Subject", "Hello!\n.\nBye!"},
+                   [&](const SecretSanta::EmailMessage&, const SecretSanta::Delivery& delivery) {
+                     const std::lock_guard<std::mutex> lock{mutex};
+                     deliveries.push_back(delivery);
+                   });
+  }
+  transport.Flush();
+  return deliveries;
+}
+
+TEST(EventLoopSmtpTransport, Deliver) {
+  SecretSanta::SmtpSink sink;
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::EventLoopSmtpTransport transport{
+      "127.0.0.1", sink.Port(), "santa@example.com", 3, 1};
+  const std::vector<SecretSanta::Delivery> deliveries{SendMessages(transport, 50)};
+
+  ASSERT_EQ(deliveries.size(), 50);
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    EXPECT_TRUE(delivery.Succeeded());
+  }
+  EXPECT_EQ(sink.AcceptedMessageCount(), 50);
+  EXPECT_LE(sink.ConnectionCount(), 3);
+}
+
+TEST(EventLoopSmtpTransport, ManyConnections) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{1000}};
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::EventLoopSmtpTransport transport{
+      "127.0.0.1", sink.Port(), "santa@example.com", 64, 2};
+  const std::vector<SecretSanta::Delivery> deliveries{SendMessages(transport, 256)};
+
+  ASSERT_EQ(deliveries.size(), 256);
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    EXPECT_TRUE(delivery.Succeeded());
+  }
+  EXPECT_EQ(sink.AcceptedMessageCount(), 256);
+  EXPECT_GT(sink.PeakConnectionCount(), 1);
+}
+
+TEST(EventLoopSmtpTransport, RejectedRecipients) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{0}, 1.0, 0.0};
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::EventLoopSmtpTransport transport{"127.0.0.1", sink.Port(), "santa@example.com"};
+  const std::vector<SecretSanta::Delivery> deliveries{SendMessages(transport, 3)};
+
+  ASSERT_EQ(deliveries.size(), 3);
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    EXPECT_EQ(delivery.Status(), SecretSanta::DeliveryStatus::PermanentFailure);
+    EXPECT_EQ(delivery.Details().substr(0, 3), "550");
+  }
+  EXPECT_EQ(sink.ConnectionCount(), 1);
+}
+
+TEST(EventLoopSmtpTransport, DeferredMessages) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{0}, 0.0, 1.0};
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::EventLoopSmtpTransport transport{"127.0.0.1", sink.Port(), "santa@example.com"};
+  const std::vector<SecretSanta::Delivery> deliveries{SendMessages(transport, 3)};
+
+  ASSERT_EQ(deliveries.size(), 3);
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    EXPECT_EQ(delivery.Status(), SecretSanta::DeliveryStatus::TransientFailure);
+  }
+  EXPECT_EQ(sink.DeferredMessageCount(), 3);
+}
+
+TEST(EventLoopSmtpTransport, RefusedConnections) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{0}, 0.0, 0.0, 1};
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::EventLoopSmtpTransport transport{
+      "127.0.0.1", sink.Port(), "santa@example.com", 4, 1};
+  const std::vector<SecretSanta::Delivery> deliveries{SendMessages(transport, 40)};
+
+  ASSERT_EQ(deliveries.size(), 40);
+  std::size_t delivered_count = 0;
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    if (delivery.Succeeded()) {
+      ++delivered_count;
+    } else {
+      EXPECT_EQ(delivery.Status(), SecretSanta::DeliveryStatus::TransientFailure);
+    }
+  }
+  EXPECT_GT(delivered_count, 0);
+  EXPECT_EQ(sink.AcceptedMessageCount(), delivered_count);
+}
+
+TEST(EventLoopSmtpTransport, Unreachable) {
+  uint16_t port = 0;
+  {
+    const SecretSanta::SmtpSink sink;
+    port = sink.Port();
+  }
+
+  SecretSanta::EventLoopSmtpTransport transport{"127.0.0.1", port, "santa@example.com"};
+  const std::vector<SecretSanta::Delivery> deliveries{SendMessages(transport, 2)};
+
+  ASSERT_EQ(deliveries.size(), 2);
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    EXPECT_EQ(delivery.Status(), SecretSanta::DeliveryStatus::TransientFailure);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,115 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FileCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+namespace {
+
+// Number of files read so far by the test objects.
+std::size_t read_count{0};
+
+// Test object that holds the contents of a file.
+struct Contents {
+  // Constructor. Reads the contents of a given file.
+  explicit Contents(const std::filesystem::path& path) {
+    std::ifstream stream{path};
+    std::getline(stream, text);
+    ++read_count;
+  }
+
+  // Contents of the file.
+  std::string text;
+};
+
+// Writes a given text to a given file, replacing its contents.
+void WriteFile(const std::filesystem::path& path, const std::string& text) {
+  std::ofstream stream{path};
+  stream << text;
+}
+
+TEST(FileCache, MissingFile) {
+  SecretSanta::FileCache<Contents> cache;
+  EXPECT_EQ(cache.Get("path/to/missing/file.yaml"), nullptr);
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST(FileCache, Get) {
+  const std::filesystem::path path = "file_cache.yaml";
+  WriteFile(path, "first");
+  SecretSanta::FileCache<Contents> cache;
+  read_count = 0;
+
+  const std::shared_ptr<const Contents> first = cache.Get(path);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first->text, "first");
+  EXPECT_EQ(cache.Get(path), first);
+  EXPECT_EQ(read_count, 1);
+  EXPECT_EQ(cache.HitCount(), 1);
+  EXPECT_EQ(cache.MissCount(), 1);
+
+  // A file that changes is read again, while the object already obtained stays valid.
+  WriteFile(path, "second version");
+  const std::shared_ptr<const Contents> second = cache.Get(path);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(second->text, "second version");
+  EXPECT_EQ(first->text, "first");
+  EXPECT_EQ(read_count, 2);
+  EXPECT_EQ(cache.Size(), 1);
+
+  std::filesystem::remove(path);
+  EXPECT_EQ(cache.Get(path), nullptr);
+}
+
+TEST(FileCache, Put) {
+  const std::filesystem::path path = "file_cache_put.yaml";
+  WriteFile(path, "written");
+  SecretSanta::FileCache<Contents> cache;
+  const std::shared_ptr<const Contents> written = std::make_shared<const Contents>(path);
+  read_count = 0;
+
+  cache.Put(path, written);
+  EXPECT_EQ(cache.Get(path), written);
+  EXPECT_EQ(read_count, 0);
+
+  cache.Put("path/to/missing/file.yaml", written);
+  EXPECT_EQ(cache.Size(), 1);
+}
+
+TEST(FileCache, Capacity) {
+  const std::filesystem::path first = "file_cache_first.yaml";
+  const std::filesystem::path second = "file_cache_second.yaml";
+  WriteFile(first, "first");
+  WriteFile(second, "second");
+  SecretSanta::FileCache<Contents> cache{1};
+
+  ASSERT_NE(cache.Get(first), nullptr);
+  ASSERT_NE(cache.Get(second), nullptr);
+  EXPECT_EQ(cache.Size(), 1);
+  EXPECT_EQ(cache.Get(second)->text, "second");
+  EXPECT_EQ(cache.HitCount(), 1);
+}
+
+}  // namespace
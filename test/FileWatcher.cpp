@@ -0,0 +1,92 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FileWatcher.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+
+// Writes a given text to a given file, replacing its contents.
+void WriteFile(const std::filesystem::path& path, const std::string& text) {
+  std::ofstream stream{path};
+  stream << text;
+}
+
+TEST(FileWatcher, MissingDirectory) {
+  SecretSanta::FileWatcher watcher{"path/to/missing/directory/configuration.yaml"};
+  EXPECT_FALSE(watcher.IsValid());
+  EXPECT_FALSE(watcher.Wait(std::chrono::milliseconds{10}));
+}
+
+TEST(FileWatcher, Write) {
+  const std::filesystem::path directory{"file_watcher_write"};
+  std::filesystem::create_directory(directory);
+  WriteFile(directory / "configuration.yaml", "participants:\n");
+
+  SecretSanta::FileWatcher watcher{directory / "configuration.yaml"};
+  ASSERT_TRUE(watcher.IsValid());
+  EXPECT_FALSE(watcher.Wait(std::chrono::milliseconds{10}));
+
+  WriteFile(directory / "configuration.yaml", "participants:\n  - Alice Smith:\n");
+  EXPECT_TRUE(watcher.Wait(std::chrono::milliseconds{1000}));
+  EXPECT_FALSE(watcher.Wait(std::chrono::milliseconds{10}));
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(FileWatcher, Rename) {
+  const std::filesystem::path directory{"file_watcher_rename"};
+  std::filesystem::create_directory(directory);
+  WriteFile(directory / "configuration.yaml", "participants:\n");
+
+  SecretSanta::FileWatcher watcher{directory / "configuration.yaml"};
+  ASSERT_TRUE(watcher.IsValid());
+
+  WriteFile(directory / "configuration.yaml.swp", "participants:\n  - Alice Smith:\n");
+  EXPECT_FALSE(watcher.Wait(std::chrono::milliseconds{10}));
+
+  std::filesystem::rename(directory / "configuration.yaml.swp", directory / "configuration.yaml");
+  EXPECT_TRUE(watcher.Wait(std::chrono::milliseconds{1000}));
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(FileWatcher, OtherFile) {
+  const std::filesystem::path directory{"file_watcher_other_file"};
+  std::filesystem::create_directory(directory);
+
+  SecretSanta::FileWatcher watcher{directory / "configuration.yaml"};
+  ASSERT_TRUE(watcher.IsValid());
+
+  WriteFile(directory / "matchings.yaml", "matchings:\n");
+  EXPECT_FALSE(watcher.Wait(std::chrono::milliseconds{10}));
+
+  WriteFile(directory / "configuration.yaml", "participants:\n");
+  EXPECT_TRUE(watcher.Wait(std::chrono::milliseconds{1000}));
+
+  std::filesystem::remove_all(directory);
+}
+
+}  // namespace
@@ -0,0 +1,116 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Geography.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+TEST(Geography, ParseCoordinates) {
+  const std::optional<SecretSanta::Coordinates> coordinates =
+      SecretSanta::ParseCoordinates("37.7749, -122.4194");
+  ASSERT_TRUE(coordinates.has_value());
+  EXPECT_DOUBLE_EQ(coordinates->latitude, 37.7749);
+  EXPECT_DOUBLE_EQ(coordinates->longitude, -122.4194);
+  EXPECT_TRUE(SecretSanta::ParseCoordinates("-90,180").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCoordinates("").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCoordinates("91234").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCoordinates("91.0, 0.0").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCoordinates("0.0, 181.0").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCoordinates("12 Main St, Townsville").has_value());
+  EXPECT_FALSE(SecretSanta::ParseCoordinates("1.0x, 2.0").has_value());
+}
+
+TEST(Geography, GreatCircleDistance) {
+  const SecretSanta::Coordinates los_angeles{34.0522, -118.2437};
+  const SecretSanta::Coordinates new_york{40.7128, -74.0060};
+  EXPECT_NEAR(SecretSanta::GreatCircleDistance(los_angeles, new_york), 3936.0, 5.0);
+  EXPECT_DOUBLE_EQ(SecretSanta::GreatCircleDistance(los_angeles, los_angeles), 0.0);
+  EXPECT_NEAR(SecretSanta::GreatCircleDistance(SecretSanta::Coordinates{0.0, 0.0},
+                                             SecretSanta::Coordinates{0.0, 180.0}),
+              M_PI * SecretSanta::EarthRadiusKilometers, 1.0e-6);
+}
+
+TEST(Geography, PostalCodeTable) {
+  const std::filesystem::path path{
+      std::filesystem::temp_directory_path() / "secret_santa_test_postal_codes.csv"};
+  {
+    std::ofstream stream{path};
+    stream << "postal_code,latitude,longitude\r\n"
+           << "91234,34.0522,-118.2437\r\n"
+           << "H2X 1Y4, 45.5088, -73.5617\n"
+           << "broken,north,west\n";
+  }
+  const SecretSanta::PostalCodeTable table{path};
+  EXPECT_EQ(table.Size(), 2);
+  ASSERT_TRUE(table.Find("91234").has_value());
+  EXPECT_DOUBLE_EQ(table.Find("91234")->latitude, 34.0522);
+  ASSERT_TRUE(table.Find(" H2X 1Y4 ").has_value());
+  EXPECT_DOUBLE_EQ(table.Find("H2X 1Y4")->longitude, -73.5617);
+  EXPECT_FALSE(table.Find("broken").has_value());
+  EXPECT_FALSE(table.Find("00000").has_value());
+
+  EXPECT_TRUE(SecretSanta::ResolveLocation("91234", table).has_value());
+  EXPECT_TRUE(SecretSanta::ResolveLocation("1.0, 2.0", table).has_value());
+  EXPECT_FALSE(SecretSanta::ResolveLocation("", table).has_value());
+  std::filesystem::remove(path);
+}
+
+TEST(Geography, FindNearestNeighbors) {
+  std::mt19937_64 random_generator{42};
+  std::uniform_real_distribution<double> latitude{-60.0, 60.0};
+  std::uniform_real_distribution<double> longitude{-180.0, 180.0};
+  std::vector<std::array<double, 3>> positions;
+  for (int index = 0; index < 500; ++index) {
+    positions.push_back(SecretSanta::UnitSpherePosition(
+        {latitude(random_generator), longitude(random_generator)}));
+  }
+
+  const std::size_t count{5};
+  const std::vector<uint32_t> neighbors{SecretSanta::FindNearestNeighbors(positions, count, 3)};
+  ASSERT_EQ(neighbors.size(), positions.size() * count);
+  for (std::size_t point = 0; point < positions.size(); ++point) {
+    // Compare with the nearest neighbors found by sorting all the other points by distance.
+    std::vector<std::pair<double, uint32_t>> sorted;
+    for (std::size_t other = 0; other < positions.size(); ++other) {
+      if (other != point) {
+        sorted.emplace_back(SecretSanta::GreatCircleDistance(positions[point], positions[other]),
+                            static_cast<uint32_t>(other));
+      }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t index = 0; index < count; ++index) {
+      EXPECT_EQ(neighbors[point * count + index], sorted[index].second);
+    }
+  }
+}
+
+TEST(Geography, FindNearestNeighborsOfFewPoints) {
+  const std::vector<std::array<double, 3>> positions{
+    SecretSanta::UnitSpherePosition({0.0, 0.0}), SecretSanta::UnitSpherePosition({0.0, 1.0})};
+  EXPECT_EQ(SecretSanta::FindNearestNeighbors(positions, 2, 1),
+            (std::vector<uint32_t>{1, 0, 0, 1}));
+}
+
+}  // namespace
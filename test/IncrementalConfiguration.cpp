@@ -0,0 +1,249 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/IncrementalConfiguration.hpp"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Header of the test configurations, which holds the message and the event.
+const std::string Header{
+    "message:\n"
+    "  subject: Secret Santa Gift Exchange 2023\n"
+    "  body: Welcome to the Secret Santa gift exchange!\n"
+    "event:\n"
+    "  start: 2023-12-23 14:00\n"
+    "participants:\n"};
+
+// Participant entry of Alice Smith.
+const std::string Alice{
+    "  - Alice Smith:\n"
+    "      email: alice.smith@gmail.com\n"};
+
+// Participant entry of Bob Johnson.
+const std::string Bob{
+    "  - Bob Johnson:\n"
+    "      email: bob.johnson@gmail.com\n"
+    "      address: 456 Second St, Apt 2, Metrocity, CA 92345 USA\n"};
+
+// Participant entry of Claire Jones.
+const std::string Claire{
+    "  - Claire Jones:\n"
+    "      email: claire.jones@gmail.com\n"};
+
+// Joins the header of the test configurations with given participant entries.
+std::string Join(const std::vector<std::string>& entries) {
+  std::string text{Header};
+  for (const std::string& entry : entries) {
+    text.append(entry);
+  }
+  return text;
+}
+
+TEST(IncrementalConfiguration, ConfigurationFile) {
+  std::ifstream stream{"../test/configuration.yaml"};
+  const std::string text{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+  SecretSanta::IncrementalConfiguration configuration;
+  const SecretSanta::ConfigurationChanges changes{configuration.Update(text)};
+  EXPECT_TRUE(changes.header_changed);
+  EXPECT_EQ(changes.entry_count, 3);
+  EXPECT_EQ(changes.parsed_entry_count, 3);
+  EXPECT_EQ(changes.added,
+            (std::vector<std::string>{"Alice Smith", "Bob Johnson", "Claire Jones"}));
+
+  const SecretSanta::Configuration reference{"../test/configuration.yaml"};
+  ASSERT_EQ(configuration.Participants().size(), reference.Participants().size());
+  for (const SecretSanta::Participant& participant : reference.Participants()) {
+    ASSERT_EQ(configuration.Participants().count(participant.Name()), 1);
+    EXPECT_EQ(configuration.Participants().at(participant.Name()).Print(), participant.Print());
+  }
+  EXPECT_TRUE(configuration.Problems().empty());
+  ASSERT_TRUE(configuration.Event().has_value());
+  EXPECT_EQ(configuration.Event()->Location(), "https://zoom.us/j/123456789");
+}
+
+TEST(IncrementalConfiguration, Unchanged) {
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(Header + Alice + Bob + Claire));
+
+  const SecretSanta::ConfigurationChanges changes{
+      configuration.Update(Header + Alice + Bob + Claire)};
+  EXPECT_FALSE(changes.header_changed);
+  EXPECT_EQ(changes.entry_count, 3);
+  EXPECT_EQ(changes.parsed_entry_count, 0);
+  EXPECT_TRUE(changes.added.empty());
+  EXPECT_TRUE(changes.removed.empty());
+  EXPECT_TRUE(changes.changed.empty());
+  EXPECT_EQ(configuration.Participants().size(), 3);
+}
+
+TEST(IncrementalConfiguration, AddRemoveAndChange) {
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(Header + Alice + Bob));
+
+  SecretSanta::ConfigurationChanges changes{configuration.Update(Header + Bob + Claire)};
+  EXPECT_EQ(changes.parsed_entry_count, 1);
+  EXPECT_EQ(changes.added, std::vector<std::string>{"Claire Jones"});
+  EXPECT_EQ(changes.removed, std::vector<std::string>{"Alice Smith"});
+  EXPECT_TRUE(changes.changed.empty());
+
+  changes = configuration.Update(
+      Header + Bob + "  - Claire Jones:\n      email: claire.jones@yahoo.com\n");
+  EXPECT_EQ(changes.parsed_entry_count, 1);
+  EXPECT_TRUE(changes.added.empty());
+  EXPECT_TRUE(changes.removed.empty());
+  EXPECT_EQ(changes.changed, std::vector<std::string>{"Claire Jones"});
+  EXPECT_EQ(configuration.Participants().at("Claire Jones").Email(), "claire.jones@yahoo.com");
+  EXPECT_TRUE(configuration.Problems().empty());
+}
+
+TEST(IncrementalConfiguration, ManyEntries) {
+  std::vector<std::string> entries;
+  for (std::size_t index = 0; index < 100; ++index) {
+    entries.push_back("  - Guest " + std::to_string(index) + ":\n      email: guest"
+                      + std::to_string(index) + "@example.com\n");
+  }
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(Join(entries)));
+  EXPECT_EQ(configuration.Participants().size(), 100);
+
+  entries[50] = "  - Guest 50:\n      email: guest50@example.org\n";
+  SecretSanta::ConfigurationChanges changes{configuration.Update(Join(entries))};
+  EXPECT_EQ(changes.parsed_entry_count, 1);
+  EXPECT_EQ(changes.changed, std::vector<std::string>{"Guest 50"});
+
+  entries.erase(entries.begin() + 10);
+  entries.push_back(entries[20]);
+  changes = configuration.Update(Join(entries));
+  EXPECT_EQ(changes.parsed_entry_count, 0);
+  EXPECT_EQ(changes.removed, std::vector<std::string>{"Guest 10"});
+  EXPECT_TRUE(changes.added.empty());
+  EXPECT_EQ(configuration.Participants().size(), 99);
+  ASSERT_EQ(configuration.Problems().size(), 1);
+  EXPECT_EQ(configuration.Problems()[0],
+            "Participant Guest 21 is defined 2 times; each participant must have a unique name.");
+
+  entries.pop_back();
+  changes = configuration.Update(Join(entries));
+  EXPECT_EQ(changes.parsed_entry_count, 0);
+  EXPECT_TRUE(changes.removed.empty());
+  EXPECT_TRUE(configuration.Problems().empty());
+}
+
+TEST(IncrementalConfiguration, Reorder) {
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(Header + Alice + Bob + Claire));
+
+  const SecretSanta::ConfigurationChanges changes{
+      configuration.Update(Header + Claire + "\n  # Bob moved.\n" + Alice + Bob)};
+  EXPECT_EQ(changes.parsed_entry_count, 1);
+  EXPECT_TRUE(changes.added.empty());
+  EXPECT_TRUE(changes.removed.empty());
+  EXPECT_TRUE(changes.changed.empty());
+}
+
+TEST(IncrementalConfiguration, HeaderChange) {
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(Header + Alice + Bob));
+  ASSERT_TRUE(configuration.Event().has_value());
+
+  const SecretSanta::ConfigurationChanges changes{
+      configuration.Update("message:\n  subject: Gifts\nevent:\n  start: tomorrow\nparticipants:\n"
+                           + Alice + Bob)};
+  EXPECT_TRUE(changes.header_changed);
+  EXPECT_EQ(changes.parsed_entry_count, 0);
+  EXPECT_FALSE(configuration.Event().has_value());
+  ASSERT_EQ(configuration.Problems().size(), 2);
+  EXPECT_EQ(configuration.Problems()[0],
+            "No email message body is defined; the default email message body is used.");
+  EXPECT_NE(configuration.Problems()[1].find("no valid start"), std::string::npos);
+}
+
+TEST(IncrementalConfiguration, Problems) {
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(
+      Header + Alice + "  - Bob Johnson:\n      address: 456 Second St\n"
+      + "  - Claire Jones:\n      email: [claire.jones@gmail.com\n" + Alice
+      + "  - Dave Brown:\n      email: dave.brown@gmail.com\n      timezone: Mars/Olympus\n"
+      + "  - just a string\n"));
+  EXPECT_EQ(configuration.Participants().size(), 3);
+  EXPECT_EQ(configuration.Participants().count("Claire Jones"), 0);
+  ASSERT_EQ(configuration.Problems().size(), 5);
+  EXPECT_EQ(configuration.Problems()[0],
+            "Line 9: Participant Bob Johnson has no email address and cannot be notified.");
+  EXPECT_EQ(configuration.Problems()[1].substr(0, 49),
+            "Line 13: The participant entry cannot be parsed: ");
+  EXPECT_EQ(configuration.Problems()[2],
+            "Line 15: Participant Dave Brown has an unknown time zone: Mars/Olympus.");
+  EXPECT_EQ(configuration.Problems()[3].substr(0, 38), "Line 18: The participant entry is not ");
+  EXPECT_EQ(configuration.Problems()[4],
+            "Participant Alice Smith is defined 2 times; each participant must have a unique "
+            "name.");
+}
+
+TEST(IncrementalConfiguration, RemoveDuplicate) {
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(
+      Header + Alice + Bob + "  - Alice Smith:\n      email: alice.smith@yahoo.com\n"));
+  ASSERT_EQ(configuration.Problems().size(), 1);
+
+  const SecretSanta::ConfigurationChanges changes{configuration.Update(
+      Header + Bob + "  - Alice Smith:\n      email: alice.smith@yahoo.com\n")};
+  EXPECT_TRUE(configuration.Problems().empty());
+  EXPECT_TRUE(changes.added.empty());
+  EXPECT_TRUE(changes.removed.empty());
+  EXPECT_EQ(configuration.Participants().at("Alice Smith").Email(), "alice.smith@yahoo.com");
+}
+
+TEST(IncrementalConfiguration, FlowSequence) {
+  SecretSanta::IncrementalConfiguration configuration;
+  const SecretSanta::ConfigurationChanges changes{configuration.Update(
+      "participants: [{Alice Smith: {email: alice.smith@gmail.com}},\n"
+      "               {Bob Johnson: {email: bob.johnson@gmail.com}}]\n"
+      "message:\n  subject: Gifts\n  body: Welcome!\n")};
+  EXPECT_EQ(changes.entry_count, 1);
+  EXPECT_EQ(changes.added, (std::vector<std::string>{"Alice Smith", "Bob Johnson"}));
+  EXPECT_TRUE(configuration.Problems().empty());
+}
+
+TEST(IncrementalConfiguration, UnindentedSequence) {
+  SecretSanta::IncrementalConfiguration configuration;
+  const SecretSanta::ConfigurationChanges changes{configuration.Update(
+      Header + "- Alice Smith:\n    email: alice.smith@gmail.com\n"
+      + "- Bob Johnson:\n    email: bob.johnson@gmail.com\n")};
+  EXPECT_EQ(changes.entry_count, 2);
+  EXPECT_EQ(configuration.Participants().size(), 2);
+  EXPECT_TRUE(configuration.Problems().empty());
+}
+
+TEST(IncrementalConfiguration, NoParticipants) {
+  SecretSanta::IncrementalConfiguration configuration;
+  static_cast<void>(configuration.Update(Header));
+  ASSERT_EQ(configuration.Problems().size(), 1);
+  EXPECT_EQ(configuration.Problems()[0], "No participants are defined.");
+}
+
+}  // namespace
@@ -0,0 +1,155 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/LookupIndex.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+#include "CreateSampleParticipant.hpp"
+
+namespace {
+
+// Returns the body of a given HTTP response.
+std::string_view Body(const std::string_view response) {
+  return response.substr(response.find("\r\n\r\n") + 4);
+}
+
+// Returns the request that looks up the giftees of a given token.
+std::string LookupRequest(const std::string& token) {
+  return "GET /giftee?token=" + token + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+}
+
+TEST(LookupIndex, DefaultConstructor) {
+  const SecretSanta::LookupIndex index;
+  EXPECT_EQ(index.Size(), 0);
+  EXPECT_EQ(index.Respond(LookupRequest("0123456789abcdef0123456789abcdef")).status, 403);
+}
+
+TEST(LookupIndex, Lookup) {
+  const SecretSanta::Configuration configuration{SecretSanta::CreateSampleParticipants()};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(configuration.Participants()));
+  const SecretSanta::LookupIndex index{configuration, matchings, tokens};
+  EXPECT_EQ(index.Size(), 3);
+
+  for (const SecretSanta::Participant& gifter : configuration.Participants()) {
+    const SecretSanta::LookupResponse response =
+        index.Respond(LookupRequest(tokens.Token(gifter.Name())));
+    EXPECT_EQ(response.status, 200);
+    EXPECT_FALSE(response.close);
+    EXPECT_EQ(response.text.substr(0, 17), "HTTP/1.1 200 OK\r\n");
+    const std::string_view body = Body(response.text);
+    EXPECT_NE(response.text.find("Content-Length: " + std::to_string(body.size()) + "\r\n"),
+              std::string_view::npos);
+    EXPECT_EQ(body,
+              SecretSanta::ComposeFullMessageBody(
+                  gifter, SecretSanta::FindGiftees(configuration, matchings, gifter),
+                  configuration.MessageBody()));
+  }
+}
+
+TEST(LookupIndex, LookupWithBearerToken) {
+  const SecretSanta::Configuration configuration{SecretSanta::CreateSampleParticipants()};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(configuration.Participants()));
+  const SecretSanta::LookupIndex index{configuration, matchings, tokens};
+
+  const SecretSanta::LookupResponse response = index.Respond(
+      "GET /giftee HTTP/1.1\r\nauthorization: bearer " + tokens.Token("Bob Johnson") + "\r\n\r\n");
+  EXPECT_EQ(response.status, 200);
+  EXPECT_EQ(Body(response.text).substr(0, 18), "Hello Bob Johnson,");
+}
+
+TEST(LookupIndex, HeadRequest) {
+  const SecretSanta::Configuration configuration{SecretSanta::CreateSampleParticipants()};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(configuration.Participants()));
+  const SecretSanta::LookupIndex index{configuration, matchings, tokens};
+
+  const std::string token = tokens.Token("Alice Smith");
+  const SecretSanta::LookupResponse get = index.Respond(LookupRequest(token));
+  const SecretSanta::LookupResponse head =
+      index.Respond("HEAD /giftee?token=" + token + " HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(head.status, 200);
+  EXPECT_EQ(head.text, get.text.substr(0, get.text.find("\r\n\r\n") + 4));
+}
+
+TEST(LookupIndex, UnknownToken) {
+  const SecretSanta::Configuration configuration{SecretSanta::CreateSampleParticipants()};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(configuration.Participants()));
+  const SecretSanta::LookupIndex index{configuration, matchings, tokens};
+
+  EXPECT_EQ(index.Respond(LookupRequest("0123456789abcdef0123456789abcdef")).status, 403);
+  EXPECT_EQ(index.Respond(LookupRequest("")).status, 403);
+  EXPECT_EQ(index.Respond("GET /giftee HTTP/1.1\r\n\r\n").status, 403);
+  EXPECT_FALSE(index.Respond("GET /giftee HTTP/1.1\r\n\r\n").close);
+}
+
+TEST(LookupIndex, ParticipantsWithoutToken) {
+  const SecretSanta::Configuration configuration{SecretSanta::CreateSampleParticipants()};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+  std::set<SecretSanta::Participant> participants;
+  participants.emplace(SecretSanta::CreateSampleParticipantA());
+  participants.emplace(SecretSanta::CreateSampleParticipantB());
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(participants));
+  const SecretSanta::LookupIndex index{configuration, matchings, tokens};
+  EXPECT_EQ(index.Size(), 2);
+}
+
+TEST(LookupIndex, OtherRequests) {
+  const SecretSanta::LookupIndex index;
+
+  const SecretSanta::LookupResponse form = index.Respond("GET / HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(form.status, 200);
+  EXPECT_NE(form.text.find("Content-Type: text/html"), std::string_view::npos);
+
+  EXPECT_EQ(index.Respond("GET /other HTTP/1.1\r\n\r\n").status, 404);
+
+  const SecretSanta::LookupResponse post = index.Respond("POST /giftee HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(post.status, 405);
+  EXPECT_TRUE(post.close);
+
+  const SecretSanta::LookupResponse malformed = index.Respond("GET /giftee\r\n\r\n");
+  EXPECT_EQ(malformed.status, 400);
+  EXPECT_TRUE(malformed.close);
+
+  EXPECT_EQ(index.Respond("GET / HTTP/2.0\r\n\r\n").status, 400);
+  EXPECT_EQ(index.RequestTooLarge().status, 431);
+  EXPECT_TRUE(index.RequestTooLarge().close);
+}
+
+TEST(LookupIndex, KeepAlive) {
+  const SecretSanta::LookupIndex index;
+  EXPECT_FALSE(index.Respond("GET / HTTP/1.1\r\n\r\n").close);
+  EXPECT_TRUE(index.Respond("GET / HTTP/1.1\r\nConnection: close\r\n\r\n").close);
+  EXPECT_TRUE(index.Respond("GET / HTTP/1.0\r\n\r\n").close);
+  EXPECT_FALSE(index.Respond("GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n").close);
+  EXPECT_FALSE(index.Respond("GET / HTTP/1.1\n\n").close);
+}
+
+}  // namespace
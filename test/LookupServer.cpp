@@ -0,0 +1,239 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/LookupServer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+#include <string>
+
+#include "CreateSampleParticipant.hpp"
+
+namespace {
+
+// Number of memory allocations made so far by any thread of this test program.
+std::atomic<uint64_t> allocation_count{0};
+
+}  // namespace
+
+// Counts every memory allocation, so that a test can check that the server allocates no memory
+// while it answers requests.
+[[gnu::noinline]] void* operator new(const std::size_t size) {
+  allocation_count.fetch_add(1);
+  void* const pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return pointer;
+}
+
+// Frees memory allocated by the counting allocation function.
+[[gnu::noinline]] void operator delete(void* const pointer) noexcept {
+  std::free(pointer);
+}
+
+// Frees memory allocated by the counting allocation function.
+[[gnu::noinline]] void operator delete(void* const pointer, const std::size_t /*size*/) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+// Participants, matchings, and tokens from which a lookup index is built for the tests.
+struct Event {
+  // Configuration of the sample participants.
+  SecretSanta::Configuration configuration{SecretSanta::CreateSampleParticipants()};
+
+  // Matchings of the sample participants.
+  SecretSanta::Matchings matchings{configuration.Participants(), 42};
+
+  // Tokens of the sample participants.
+  SecretSanta::Tokens tokens;
+};
+
+// Creates the tokens of an event and returns its lookup index.
+std::unique_ptr<SecretSanta::LookupIndex> CreateIndex(Event& event) {
+  static_cast<void>(event.tokens.Update(event.configuration.Participants()));
+  return std::make_unique<SecretSanta::LookupIndex>(
+      event.configuration, event.matchings, event.tokens);
+}
+
+// Reads a given number of bytes from a socket, or fewer if the connection closes first.
+std::string ReadBytes(const SecretSanta::Socket& socket, const std::size_t count) {
+  std::string data;
+  std::array<char, 4096> buffer{};
+  while (data.size() < count) {
+    const ssize_t received = ::recv(socket.Descriptor(), buffer.data(),
+                                    std::min(buffer.size(), count - data.size()), 0);
+    if (received <= 0) {
+      break;
+    }
+    data.append(buffer.data(), static_cast<std::size_t>(received));
+  }
+  return data;
+}
+
+// Whether the peer of a socket closed the connection.
+bool IsClosedByPeer(const SecretSanta::Socket& socket) {
+  char byte = 0;
+  return ::recv(socket.Descriptor(), &byte, 1, 0) == 0;
+}
+
+TEST(LookupServer, Lookup) {
+  Event event;
+  const std::unique_ptr<SecretSanta::LookupIndex> index = CreateIndex(event);
+  const SecretSanta::LookupServer server{*index};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::Socket socket{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  ASSERT_TRUE(socket.IsOpen());
+
+  for (const std::pair<const std::string, std::string>& participant_and_token :
+       event.tokens.ParticipantsToTokens()) {
+    const std::string request{
+        "GET /giftee?token=" + participant_and_token.second + " HTTP/1.1\r\n\r\n"};
+    const std::string_view expected = index->Respond(request).text;
+    ASSERT_TRUE(socket.WriteAll(request));
+    EXPECT_EQ(ReadBytes(socket, expected.size()), expected);
+    EXPECT_NE(expected.find("Hello " + participant_and_token.first), std::string_view::npos);
+  }
+
+  const std::string request{"GET /giftee?token=0123456789abcdef0123456789abcdef HTTP/1.1\r\n\r\n"};
+  const std::string_view expected = index->Respond(request).text;
+  ASSERT_TRUE(socket.WriteAll(request));
+  EXPECT_EQ(ReadBytes(socket, expected.size()), expected);
+
+  EXPECT_EQ(server.RequestCount(), 4);
+  EXPECT_EQ(server.ForbiddenCount(), 1);
+  EXPECT_EQ(server.ConnectionCount(), 1);
+}
+
+TEST(LookupServer, Pipelining) {
+  Event event;
+  const std::unique_ptr<SecretSanta::LookupIndex> index = CreateIndex(event);
+  const SecretSanta::LookupServer server{*index, 0, 2};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::Socket socket{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  ASSERT_TRUE(socket.IsOpen());
+
+  const std::string token = event.tokens.Token("Claire Jones");
+  const std::array<std::string, 3> requests{
+    "GET /giftee?token=" + token + " HTTP/1.1\r\n\r\n",
+    "HEAD /giftee?token=" + token + " HTTP/1.1\r\n\r\n",
+    "GET / HTTP/1.1\r\n\r\n",
+  };
+  std::string expected;
+  for (const std::string& request : requests) {
+    expected.append(index->Respond(request).text);
+  }
+  ASSERT_TRUE(socket.WriteAll(requests[0] + requests[1] + requests[2]));
+  EXPECT_EQ(ReadBytes(socket, expected.size()), expected);
+}
+
+TEST(LookupServer, ConnectionClose) {
+  const SecretSanta::LookupIndex index;
+  const SecretSanta::LookupServer server{index};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::Socket socket{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  const std::string request{"GET / HTTP/1.1\r\nConnection: close\r\n\r\n"};
+  const std::string_view expected = index.Respond(request).text;
+  ASSERT_TRUE(socket.WriteAll(request));
+  EXPECT_EQ(ReadBytes(socket, expected.size()), expected);
+  EXPECT_TRUE(IsClosedByPeer(socket));
+}
+
+TEST(LookupServer, RequestTooLarge) {
+  const SecretSanta::LookupIndex index;
+  const SecretSanta::LookupServer server{index};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::Socket socket{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  const std::string_view expected = index.RequestTooLarge().text;
+  ASSERT_TRUE(
+      socket.WriteAll("GET /" + std::string(SecretSanta::LookupServer::InputCapacity, 'a')));
+  EXPECT_EQ(ReadBytes(socket, expected.size()), expected);
+}
+
+TEST(LookupServer, ConnectionLimit) {
+  const SecretSanta::LookupIndex index;
+  const SecretSanta::LookupServer server{index, 0, 1, 1};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::Socket first{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  const std::string request{"GET / HTTP/1.1\r\n\r\n"};
+  const std::string_view expected = index.Respond(request).text;
+  ASSERT_TRUE(first.WriteAll(request));
+  EXPECT_EQ(ReadBytes(first, expected.size()), expected);
+
+  SecretSanta::Socket second{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  EXPECT_TRUE(IsClosedByPeer(second));
+  EXPECT_EQ(server.RefusedConnectionCount(), 1);
+
+  // Once the first connection closes, its place in the pool is free again.
+  first.Close();
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  SecretSanta::Socket third{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  ASSERT_TRUE(third.WriteAll(request));
+  EXPECT_EQ(ReadBytes(third, expected.size()), expected);
+}
+
+TEST(LookupServer, NoAllocationPerRequest) {
+  Event event;
+  const std::unique_ptr<SecretSanta::LookupIndex> index = CreateIndex(event);
+  const SecretSanta::LookupServer server{*index};
+  ASSERT_TRUE(server.IsListening());
+
+  SecretSanta::Socket socket{SecretSanta::ConnectTo("127.0.0.1", server.Port())};
+  const std::string request{
+      "GET /giftee?token=" + event.tokens.Token("Alice Smith") + " HTTP/1.1\r\n\r\n"};
+  const std::size_t expected_size = index->Respond(request).text.size();
+  std::array<char, 4096> buffer{};
+  ASSERT_LE(expected_size, buffer.size());
+
+  // Warm up the connection once before counting.
+  ASSERT_TRUE(socket.WriteAll(request));
+  ASSERT_EQ(ReadBytes(socket, expected_size).size(), expected_size);
+
+  const uint64_t before = allocation_count.load();
+  bool complete = true;
+  for (std::size_t iteration = 0; iteration < 1000 && complete; ++iteration) {
+    complete = ::send(socket.Descriptor(), request.data(), request.size(), MSG_NOSIGNAL)
+               == static_cast<ssize_t>(request.size());
+    std::size_t received = 0;
+    while (complete && received < expected_size) {
+      const ssize_t count =
+          ::recv(socket.Descriptor(), buffer.data() + received, expected_size - received, 0);
+      complete = count > 0;
+      received += complete ? static_cast<std::size_t>(count) : 0;
+    }
+  }
+  const uint64_t after = allocation_count.load();
+
+  EXPECT_TRUE(complete);
+  EXPECT_EQ(after - before, 0);
+  EXPECT_EQ(server.RequestCount(), 1001);
+}
+
+}  // namespace
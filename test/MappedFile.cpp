@@ -0,0 +1,64 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/MappedFile.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(MappedFile, Directory) {
+  const SecretSanta::MappedFile file{std::filesystem::current_path()};
+  EXPECT_FALSE(file.IsValid());
+}
+
+TEST(MappedFile, EmptyFile) {
+  const std::filesystem::path path{"mapped_file_empty.txt"};
+  std::ofstream{path}.close();
+
+  const SecretSanta::MappedFile file{path};
+  EXPECT_TRUE(file.IsValid());
+  EXPECT_EQ(file.Size(), 0);
+  EXPECT_TRUE(file.Text().empty());
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFile, File) {
+  const std::filesystem::path path{"mapped_file.txt"};
+  std::ofstream{path} << "Hello,\nworld!\n";
+
+  const SecretSanta::MappedFile file{path};
+  EXPECT_TRUE(file.IsValid());
+  EXPECT_EQ(file.Size(), 14);
+  EXPECT_EQ(file.Text(), "Hello,\nworld!\n");
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFile, MissingFile) {
+  const SecretSanta::MappedFile file{std::filesystem::path{"missing_mapped_file.txt"}};
+  EXPECT_FALSE(file.IsValid());
+  EXPECT_TRUE(file.Text().empty());
+}
+
+}  // namespace
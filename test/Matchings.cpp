@@ -20,12 +20,67 @@
 
 #include "../source/Matchings.hpp"
 
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 
 #include "CreateSampleParticipant.hpp"
 
 namespace {
 
+// Returns the lengths of the cycles formed by the given matchings, in increasing order.
+std::vector<std::size_t> CycleLengthsOf(const SecretSanta::Matchings& matchings) {
+  std::vector<std::size_t> lengths;
+  std::set<std::string> visited;
+  for (const std::pair<const std::string, std::string>& gifter_and_giftee :
+       matchings.GiftersToGiftees()) {
+    std::size_t length = 0;
+    std::string name = gifter_and_giftee.first;
+    while (visited.insert(name).second) {
+      name = matchings.GiftersToGiftees().at(name);
+      ++length;
+    }
+    if (length > 0) {
+      lengths.push_back(length);
+    }
+  }
+  std::sort(lengths.begin(), lengths.end());
+  return lengths;
+}
+
+// Checks that each round of the given matchings is a permutation of the given participants without
+// self-gifts, and that no pair of a gifter and a giftee appears in two rounds.
+void ExpectDisjointRounds(const SecretSanta::Matchings& matchings,
+                          const std::set<SecretSanta::Participant>& participants) {
+  std::set<std::pair<std::string, std::string>> pairs;
+  for (const std::map<std::string, std::string>& round : matchings.Rounds()) {
+    EXPECT_EQ(round.size(), participants.size());
+    std::set<std::string> giftees;
+    for (const std::pair<const std::string, std::string>& gifter_and_giftee : round) {
+      EXPECT_NE(gifter_and_giftee.first, gifter_and_giftee.second);
+      EXPECT_EQ(participants.count(SecretSanta::Participant{gifter_and_giftee.first}), 1);
+      giftees.insert(gifter_and_giftee.second);
+      EXPECT_TRUE(pairs.insert(gifter_and_giftee).second);
+    }
+    EXPECT_EQ(giftees.size(), participants.size());
+  }
+}
+
+// Creates a set of participants with the given number of participants in each given group.
+std::set<SecretSanta::Participant> CreateGroupedParticipants(
+    const std::map<std::string, std::size_t>& groups_to_counts) {
+  std::set<SecretSanta::Participant> participants;
+  for (const std::pair<const std::string, std::size_t>& group_and_count : groups_to_counts) {
+    for (std::size_t index = 0; index < group_and_count.second; ++index) {
+      const std::string name{group_and_count.first + " " + std::to_string(index)};
+      YAML::Node node;
+      node[name]["group"] = group_and_count.first;
+      participants.emplace(node);
+    }
+  }
+  return participants;
+}
+
 TEST(Matchings, ComparisonOperators) {
   const SecretSanta::Matchings first{std::set<SecretSanta::Participant>{
     SecretSanta::Participant{SecretSanta::CreateSampleParticipantA()}}};
@@ -46,11 +101,10 @@ TEST(Matchings, ConstructorFromNoParticipants) {
 }
 
 TEST(Matchings, ConstructorFromOneParticipant) {
+  // A lone participant would gift to themselves, so they are not matched.
   const SecretSanta::Matchings matchings{std::set<SecretSanta::Participant>{
     SecretSanta::Participant{SecretSanta::CreateSampleParticipantA()}}};
-  EXPECT_EQ(matchings.GiftersToGiftees().size(), 1);
-  EXPECT_NE(matchings.GiftersToGiftees().find("Alice Smith"), matchings.GiftersToGiftees().cend());
-  EXPECT_EQ(matchings.GiftersToGiftees().at("Alice Smith"), "Alice Smith");
+  EXPECT_TRUE(matchings.GiftersToGiftees().empty());
 }
 
 TEST(Matchings, ConstructorFromThreeParticipants) {
@@ -62,6 +116,322 @@ TEST(Matchings, ConstructorFromThreeParticipants) {
   }
 }
 
+TEST(Matchings, ConstructorWithCycleLengths) {
+  const std::set<SecretSanta::Participant> participants{
+    CreateGroupedParticipants({{"Marketing", 23}})};
+  for (int64_t seed = 0; seed < 20; ++seed) {
+    const SecretSanta::Matchings matchings{
+      participants, seed, SecretSanta::CycleLengths{4, 6}
+    };
+    EXPECT_EQ(matchings.GiftersToGiftees().size(), 23);
+    std::size_t total = 0;
+    for (const std::size_t length : CycleLengthsOf(matchings)) {
+      EXPECT_GE(length, 4);
+      EXPECT_LE(length, 6);
+      total += length;
+    }
+    EXPECT_EQ(total, 23);
+  }
+}
+
+TEST(Matchings, ConstructorWithInfeasibleCycleLengths) {
+  const SecretSanta::Matchings matchings{
+    CreateGroupedParticipants({{"Marketing", 7}}), 42, SecretSanta::CycleLengths{4, 5}
+  };
+  EXPECT_EQ(CycleLengthsOf(matchings), std::vector<std::size_t>{7});
+}
+
+TEST(Matchings, ConstructorAlignedToGroups) {
+  const std::set<SecretSanta::Participant> participants{CreateGroupedParticipants(
+      {{"Engineering", 12}, {"Marketing", 5}, {"Sales", 8}})};
+  const SecretSanta::Matchings matchings{participants, 42, SecretSanta::CycleLengths{2, 4}, true};
+  EXPECT_EQ(matchings.GiftersToGiftees().size(), 25);
+  for (const std::pair<const std::string, std::string>& gifter_and_giftee :
+       matchings.GiftersToGiftees()) {
+    EXPECT_NE(gifter_and_giftee.first, gifter_and_giftee.second);
+    EXPECT_EQ(participants.find(SecretSanta::Participant{gifter_and_giftee.first})->Group(),
+              participants.find(SecretSanta::Participant{gifter_and_giftee.second})->Group());
+  }
+  for (const std::size_t length : CycleLengthsOf(matchings)) {
+    EXPECT_GE(length, 2);
+    EXPECT_LE(length, 4);
+  }
+}
+
+TEST(Matchings, ConstructorAlignedToGroupsWithoutCycleLengths) {
+  const SecretSanta::Matchings matchings{
+    CreateGroupedParticipants({{"Engineering", 12}, {"Marketing", 5}, {"Sales", 8}}), 42,
+    std::nullopt, true
+  };
+  EXPECT_EQ(CycleLengthsOf(matchings), (std::vector<std::size_t>{5, 8, 12}));
+}
+
+TEST(Matchings, ConstructorAlignedToGroupsWithOneMemberGroup) {
+  // The only member of the Sales group would gift to themselves, so nobody is matched.
+  const std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Engineering", 4}, {"Sales", 1}})};
+  const SecretSanta::Matchings matchings{participants, 42, std::nullopt, true};
+  EXPECT_TRUE(matchings.GiftersToGiftees().empty());
+
+  // Without aligning to groups, the participants are matched as usual.
+  const SecretSanta::Matchings unaligned{participants, 42};
+  ExpectDisjointRounds(unaligned, participants);
+}
+
+TEST(Matchings, UnmatchableReason) {
+  EXPECT_FALSE(SecretSanta::UnmatchableReason({}).has_value());
+  EXPECT_TRUE(SecretSanta::UnmatchableReason(std::set<SecretSanta::Participant>{
+                                                 SecretSanta::Participant{"Alice Smith"}})
+                  .has_value());
+  EXPECT_FALSE(SecretSanta::UnmatchableReason(SecretSanta::CreateSampleParticipants()).has_value());
+
+  const std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Engineering", 4}, {"Marketing", 1}, {"Sales", 1}})};
+  EXPECT_FALSE(SecretSanta::UnmatchableReason(participants).has_value());
+  const std::optional<std::string> reason{SecretSanta::UnmatchableReason(participants, true)};
+  ASSERT_TRUE(reason.has_value());
+  EXPECT_NE(reason->find("Marketing 0 (group \"Marketing\")"), std::string::npos);
+  EXPECT_NE(reason->find("Sales 0 (group \"Sales\")"), std::string::npos);
+  EXPECT_EQ(reason->find("Engineering"), std::string::npos);
+}
+
+TEST(Matchings, ConstructorWithSeveralGifts) {
+  const std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Marketing", 50}})};
+  for (int64_t seed = 0; seed < 20; ++seed) {
+    const SecretSanta::Matchings matchings{participants, seed, std::nullopt, false, 3};
+    EXPECT_EQ(matchings.GiftCount(), 3);
+    EXPECT_EQ(matchings.Giftees("Marketing 7").size(), 3);
+    ExpectDisjointRounds(matchings, participants);
+  }
+}
+
+TEST(Matchings, ConstructorWithSeveralGiftsAndCycleLengths) {
+  const std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Marketing", 23}})};
+  const SecretSanta::Matchings matchings{
+    participants, 42, SecretSanta::CycleLengths{4, 6}, false, 4
+  };
+  ExpectDisjointRounds(matchings, participants);
+  for (const std::size_t length : CycleLengthsOf(matchings)) {
+    EXPECT_GE(length, 4);
+    EXPECT_LE(length, 6);
+  }
+}
+
+TEST(Matchings, ConstructorWithSeveralGiftsInSmallGroup) {
+  const std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Marketing", 4}})};
+  for (int64_t seed = 0; seed < 20; ++seed) {
+    const SecretSanta::Matchings matchings{participants, seed, std::nullopt, false, 3};
+    ExpectDisjointRounds(matchings, participants);
+  }
+
+  const SecretSanta::Matchings matchings{CreateGroupedParticipants({{"Marketing", 3}}), 42,
+                                         std::nullopt, false, 5};
+  EXPECT_EQ(matchings.GiftCount(), 5);
+  EXPECT_EQ(matchings.Giftees("Marketing 0").size(), 2);
+}
+
+TEST(Matchings, ConstructorMinimizingDistance) {
+  const std::vector<std::pair<std::string, std::string>> names_and_locations{
+    {"Alice Smith", "34.05, -118.24"},
+    {"Bob Johnson", "40.71, -74.00"},
+    {"Claire Jones", "90210"},
+    {"David Brown", "10001"},
+    {"Eve Davis", ""},
+  };
+  std::set<SecretSanta::Participant> participants;
+  for (const std::pair<std::string, std::string>& name_and_location : names_and_locations) {
+    YAML::Node node;
+    node[name_and_location.first]["location"] = name_and_location.second;
+    participants.emplace(node);
+  }
+
+  const std::filesystem::path path{
+      std::filesystem::temp_directory_path() / "secret_santa_test_matchings_postal_codes.csv"};
+  {
+    std::ofstream stream{path};
+    stream << "90210,34.09,-118.41\n10001,40.75,-73.99\n";
+  }
+  const SecretSanta::PostalCodeTable postal_codes{path};
+  std::filesystem::remove(path);
+
+  const SecretSanta::Matchings matchings{participants, postal_codes, {}, 42};
+  ASSERT_EQ(matchings.GiftersToGiftees().size(), 5);
+  std::set<std::string> giftees;
+  for (const std::pair<const std::string, std::string>& gifter_and_giftee :
+       matchings.GiftersToGiftees()) {
+    EXPECT_NE(gifter_and_giftee.first, gifter_and_giftee.second);
+    giftees.insert(gifter_and_giftee.second);
+  }
+  EXPECT_EQ(giftees.size(), 5);
+}
+
+TEST(Matchings, ConstructorMinimizingDistanceWithOneMemberGroup) {
+  const std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Engineering", 3}, {"Sales", 1}})};
+  const SecretSanta::PostalCodeTable postal_codes;
+
+  // The only member of the Sales group would gift to themselves, so nobody is matched.
+  const SecretSanta::Matchings matchings{participants, postal_codes, {}, 42, true};
+  EXPECT_TRUE(matchings.GiftersToGiftees().empty());
+
+  // A lone participant is not matched either.
+  const SecretSanta::Matchings lone{
+      std::set<SecretSanta::Participant>{SecretSanta::Participant{"Alice Smith"}}, postal_codes,
+      {}, 42};
+  EXPECT_TRUE(lone.GiftersToGiftees().empty());
+
+  // Without aligning to groups, nobody gifts to themselves.
+  const SecretSanta::Matchings unaligned{participants, postal_codes, {}, 42};
+  ASSERT_EQ(unaligned.GiftersToGiftees().size(), 4);
+  for (const std::pair<const std::string, std::string>& gifter_and_giftee :
+       unaligned.GiftersToGiftees()) {
+    EXPECT_NE(gifter_and_giftee.first, gifter_and_giftee.second);
+  }
+}
+
+TEST(Matchings, ChangedGifters) {
+  const SecretSanta::Matchings first{CreateGroupedParticipants({{"Marketing", 10}}), 1};
+  const SecretSanta::Matchings second{CreateGroupedParticipants({{"Marketing", 12}}), 2};
+  EXPECT_TRUE(first.ChangedGifters(first).empty());
+  const std::set<std::string> changed_gifters{second.ChangedGifters(first)};
+  EXPECT_TRUE(changed_gifters.count("Marketing 10") == 1);
+  EXPECT_TRUE(changed_gifters.count("Marketing 11") == 1);
+  for (const std::string& gifter : changed_gifters) {
+    EXPECT_TRUE(first.GiftersToGiftees().count(gifter) == 0
+                || first.GiftersToGiftees().at(gifter) != second.GiftersToGiftees().at(gifter));
+  }
+}
+
+TEST(Matchings, ShardGifters) {
+  const SecretSanta::Matchings matchings{CreateGroupedParticipants({{"Marketing", 100}}), 1};
+  std::set<std::string> covered;
+  for (std::size_t index = 1; index <= 3; ++index) {
+    const std::set<std::string> gifters{matchings.ShardGifters(SecretSanta::Shard{index, 3})};
+    EXPECT_FALSE(gifters.empty());
+    for (const std::string& gifter : gifters) {
+      EXPECT_TRUE(covered.insert(gifter).second);
+    }
+  }
+  EXPECT_EQ(covered.size(), 100);
+  EXPECT_EQ(matchings.ShardGifters(SecretSanta::Shard{}).size(), 100);
+}
+
+TEST(Matchings, UpdateWithDropouts) {
+  std::set<SecretSanta::Participant> participants{CreateGroupedParticipants({{"Marketing", 20}})};
+  const SecretSanta::Matchings original{participants, 42};
+  SecretSanta::Matchings matchings{participants, 42};
+  participants.erase(SecretSanta::Participant{"Marketing 3"});
+  participants.erase(SecretSanta::Participant{"Marketing 7"});
+  participants.erase(SecretSanta::Participant{"Marketing 8"});
+  const std::set<std::string> changed_gifters{matchings.Update(participants, 42)};
+  EXPECT_EQ(matchings.GiftersToGiftees().size(), 17);
+  EXPECT_EQ(CycleLengthsOf(matchings), std::vector<std::size_t>{17});
+  EXPECT_LE(changed_gifters.size(), 3);
+  EXPECT_EQ(changed_gifters, matchings.ChangedGifters(original));
+}
+
+TEST(Matchings, UpdateWithNewcomers) {
+  const SecretSanta::Matchings original{CreateGroupedParticipants({{"Marketing", 20}}), 42};
+  SecretSanta::Matchings matchings{CreateGroupedParticipants({{"Marketing", 20}}), 42};
+  const std::set<std::string> changed_gifters{
+      matchings.Update(CreateGroupedParticipants({{"Marketing", 20}, {"Sales", 2}}), 42)};
+  EXPECT_EQ(matchings.GiftersToGiftees().size(), 22);
+  EXPECT_EQ(CycleLengthsOf(matchings), std::vector<std::size_t>{22});
+  EXPECT_LE(changed_gifters.size(), 4);
+  EXPECT_EQ(changed_gifters, matchings.ChangedGifters(original));
+}
+
+TEST(Matchings, UpdateAlignedToGroups) {
+  const std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Marketing", 2}, {"Sales", 5}})};
+  SecretSanta::Matchings matchings{participants, 42, std::nullopt, true};
+  std::set<SecretSanta::Participant> updated_participants{
+      CreateGroupedParticipants({{"Marketing", 3}, {"Sales", 5}, {"Support", 2}})};
+  updated_participants.erase(SecretSanta::Participant{"Marketing 0"});
+  matchings.Update(updated_participants, 42, std::nullopt, true);
+  EXPECT_EQ(CycleLengthsOf(matchings), (std::vector<std::size_t>{2, 2, 5}));
+  for (const std::pair<const std::string, std::string>& gifter_and_giftee :
+       matchings.GiftersToGiftees()) {
+    EXPECT_NE(gifter_and_giftee.first, gifter_and_giftee.second);
+    EXPECT_EQ(
+        updated_participants.find(SecretSanta::Participant{gifter_and_giftee.first})->Group(),
+        updated_participants.find(SecretSanta::Participant{gifter_and_giftee.second})->Group());
+  }
+}
+
+TEST(Matchings, UpdateReinsertsLoneGifter) {
+  SecretSanta::Matchings matchings{
+    CreateGroupedParticipants({{"Marketing", 10}}), 42, SecretSanta::CycleLengths{2, 2}
+  };
+  const std::string dropout{matchings.GiftersToGiftees().begin()->first};
+  const std::string partner{matchings.GiftersToGiftees().begin()->second};
+  std::set<SecretSanta::Participant> participants{CreateGroupedParticipants({{"Marketing", 10}})};
+  participants.erase(SecretSanta::Participant{dropout});
+  const std::set<std::string> changed_gifters{matchings.Update(participants, 42)};
+  EXPECT_EQ(matchings.GiftersToGiftees().size(), 9);
+  EXPECT_EQ(CycleLengthsOf(matchings), (std::vector<std::size_t>{2, 2, 2, 3}));
+  EXPECT_EQ(changed_gifters.size(), 2);
+  EXPECT_TRUE(changed_gifters.count(partner) == 1);
+}
+
+TEST(Matchings, UpdateRespectsMaximumCycleLength) {
+  const SecretSanta::CycleLengths cycle_lengths{4, 4};
+  SecretSanta::Matchings matchings{
+    CreateGroupedParticipants({{"Marketing", 20}}), 42, cycle_lengths
+  };
+  ASSERT_EQ(CycleLengthsOf(matchings), std::vector<std::size_t>(5, 4));
+
+  // Every cycle is full, so the newcomers start a new cycle together.
+  std::set<SecretSanta::Participant> participants{
+      CreateGroupedParticipants({{"Marketing", 20}, {"Sales", 3}})};
+  const std::set<std::string> changed_gifters{matchings.Update(participants, 42, cycle_lengths)};
+  EXPECT_EQ(CycleLengthsOf(matchings), (std::vector<std::size_t>{3, 4, 4, 4, 4, 4}));
+  EXPECT_EQ(changed_gifters, (std::set<std::string>{"Sales 0", "Sales 1", "Sales 2"}));
+
+  // A dropout makes room in their cycle, which the next newcomer joins.
+  participants.erase(SecretSanta::Participant{"Marketing 5"});
+  participants.insert(SecretSanta::Participant{"Support 0"});
+  static_cast<void>(matchings.Update(participants, 42, cycle_lengths));
+  EXPECT_EQ(CycleLengthsOf(matchings), (std::vector<std::size_t>{3, 4, 4, 4, 4, 4}));
+  ExpectDisjointRounds(matchings, participants);
+}
+
+TEST(Matchings, UpdateTwice) {
+  std::set<SecretSanta::Participant> participants{CreateGroupedParticipants({{"Marketing", 20}})};
+  SecretSanta::Matchings matchings{participants, 42};
+  participants.erase(SecretSanta::Participant{"Marketing 3"});
+  static_cast<void>(matchings.Update(participants, 42));
+  participants.erase(SecretSanta::Participant{"Marketing 4"});
+  participants.erase(SecretSanta::Participant{"Marketing 5"});
+  participants.insert(SecretSanta::Participant{"Marketing 3"});
+  static_cast<void>(matchings.Update(participants, 43));
+  ExpectDisjointRounds(matchings, participants);
+  EXPECT_EQ(CycleLengthsOf(matchings), std::vector<std::size_t>{18});
+}
+
+TEST(Matchings, UpdateWithSeveralGifts) {
+  std::set<SecretSanta::Participant> participants{CreateGroupedParticipants({{"Marketing", 30}})};
+  const SecretSanta::Matchings original{participants, 42, std::nullopt, false, 3};
+  SecretSanta::Matchings matchings{participants, 42, std::nullopt, false, 3};
+  participants.erase(SecretSanta::Participant{"Marketing 3"});
+  participants.erase(SecretSanta::Participant{"Marketing 7"});
+  const std::set<SecretSanta::Participant> newcomers{CreateGroupedParticipants({{"Sales", 3}})};
+  participants.insert(newcomers.cbegin(), newcomers.cend());
+  const std::set<std::string> changed_gifters{matchings.Update(participants, 42)};
+  EXPECT_EQ(matchings.GiftCount(), 3);
+  ExpectDisjointRounds(matchings, participants);
+  EXPECT_EQ(changed_gifters, matchings.ChangedGifters(original));
+  EXPECT_LT(changed_gifters.size(), 30);
+}
+
+TEST(Matchings, UpdateUnchanged) {
+  SecretSanta::Matchings matchings{SecretSanta::CreateSampleParticipants(), 42};
+  EXPECT_TRUE(matchings.Update(SecretSanta::CreateSampleParticipants(), 42).empty());
+}
+
 TEST(Matchings, DefaultConstructor) {
   const SecretSanta::Matchings matchings;
   EXPECT_TRUE(matchings.GiftersToGiftees().empty());
@@ -75,4 +445,21 @@ TEST(Matchings, ConstructorFromYamlFile) {
   EXPECT_EQ(first, second);
 }
 
+TEST(Matchings, WriteFails) {
+  const SecretSanta::Matchings matchings{SecretSanta::CreateSampleParticipants()};
+  EXPECT_TRUE(matchings.Write(""));
+  EXPECT_FALSE(matchings.Write("../test/configuration.yaml/matchings.yaml"));
+}
+
+TEST(Matchings, ConstructorFromYamlFileWithSeveralGifts) {
+  const SecretSanta::Matchings first{
+    CreateGroupedParticipants({{"Marketing", 10}}), 42, std::nullopt, false, 3
+  };
+  const std::filesystem::path path = "several_gifts_matchings.yaml";
+  first.Write(path);
+  const SecretSanta::Matchings second{path};
+  EXPECT_EQ(second.GiftCount(), 3);
+  EXPECT_EQ(first, second);
+}
+
 }  // namespace
@@ -45,10 +45,327 @@ TEST(MessengerSettings, Constructor) {
   EXPECT_EQ(settings.MatchingsFile(), "path/to/some/directory/matchings.yaml");
 }
 
+TEST(MessengerSettings, ConstructorWithPreviousMatchings) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char matchings_key[] = "--matchings";
+  char matchings_value[] = "path/to/some/directory/matchings.yaml";
+
+  char previous_matchings_key[] = "--previous-matchings";
+  char previous_matchings_value[] = "path/to/some/directory/previous_matchings.yaml";
+
+  int argc{7};
+
+  char* argv[] = {
+    program,         configuration_key,      configuration_value,     matchings_key,
+    matchings_value, previous_matchings_key, previous_matchings_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.PreviousMatchingsFile(), "path/to/some/directory/previous_matchings.yaml");
+}
+
+TEST(MessengerSettings, ConstructorWithRelays) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char first_smtp_key[] = "--smtp";
+  char first_smtp_value[] = "relay1.example.com:25";
+
+  char second_smtp_key[] = "--smtp";
+  char second_smtp_value[] = "relay2.example.com:2525";
+
+  int argc{7};
+
+  char* argv[] = {
+    program,          configuration_key, configuration_value, first_smtp_key,
+    first_smtp_value, second_smtp_key,   second_smtp_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  ASSERT_TRUE(settings.Smtp().has_value());
+  EXPECT_EQ(settings.Smtp()->first, "relay1.example.com");
+  ASSERT_EQ(settings.Relays().size(), 2);
+  EXPECT_EQ(settings.Relays()[0], (std::pair<std::string, uint16_t>{"relay1.example.com", 25}));
+  EXPECT_EQ(settings.Relays()[1], (std::pair<std::string, uint16_t>{"relay2.example.com", 2525}));
+}
+
+TEST(MessengerSettings, ConstructorWithReplay) {
+  char program[] = "bin/secret-santa";
+
+  char replay_key[] = "--replay";
+  char replay_value[] = "path/to/some/directory/dead_letters.yaml";
+
+  char smtp_key[] = "--smtp";
+  char smtp_value[] = "localhost:2525";
+
+  int argc{5};
+
+  char* argv[] = {program, replay_key, replay_value, smtp_key, smtp_value};
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.ReplayFile(), "path/to/some/directory/dead_letters.yaml");
+  EXPECT_EQ(settings.ConfigurationFile(), "");
+  ASSERT_TRUE(settings.Smtp().has_value());
+  EXPECT_EQ(settings.Smtp()->second, 2525);
+}
+
+TEST(MessengerSettings, ConstructorWithRetries) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char attempts_key[] = "--attempts";
+  char attempts_value[] = "6";
+
+  char dead_letters_key[] = "--dead-letters";
+  char dead_letters_value[] = "path/to/some/directory/undelivered.yaml";
+
+  int argc{7};
+
+  char* argv[] = {
+    program,        configuration_key, configuration_value, attempts_key,
+    attempts_value, dead_letters_key,  dead_letters_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.Attempts(), 6);
+  EXPECT_EQ(settings.DeadLettersFile(), "path/to/some/directory/undelivered.yaml");
+  EXPECT_EQ(settings.ReplayFile(), "");
+}
+
+TEST(MessengerSettings, ConstructorWithSmtp) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char matchings_key[] = "--matchings";
+  char matchings_value[] = "path/to/some/directory/matchings.yaml";
+
+  char smtp_key[] = "--smtp";
+  char smtp_value[] = "mail.example.com:2525";
+
+  char from_key[] = "--from";
+  char from_value[] = "santa@example.com";
+
+  char connections_key[] = "--connections";
+  char connections_value[] = "8";
+
+  char event_loops_key[] = "--event-loops";
+  char event_loops_value[] = "2";
+
+  int argc{13};
+
+  char* argv[] = {
+    program,         configuration_key, configuration_value, matchings_key,
+    matchings_value, smtp_key,          smtp_value,          from_key,
+    from_value,      connections_key,   connections_value,   event_loops_key,
+    event_loops_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  ASSERT_TRUE(settings.Smtp().has_value());
+  EXPECT_EQ(settings.Smtp()->first, "mail.example.com");
+  EXPECT_EQ(settings.Smtp()->second, 2525);
+  EXPECT_EQ(settings.From(), "santa@example.com");
+  EXPECT_EQ(settings.Connections(), 8);
+  EXPECT_EQ(settings.EventLoops(), 2);
+}
+
+TEST(MessengerSettings, ConstructorWithTls) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char matchings_key[] = "--matchings";
+  char matchings_value[] = "path/to/some/directory/matchings.yaml";
+
+  char smtp_key[] = "--smtp";
+  char smtp_value[] = "mail.example.com:465";
+
+  char tls_key[] = "--tls";
+
+  char ca_file_key[] = "--ca-file";
+  char ca_file_value[] = "path/to/some/directory/ca.pem";
+
+  int argc{10};
+
+  char* argv[] = {
+    program,         configuration_key, configuration_value, matchings_key, matchings_value,
+    smtp_key,        smtp_value,        tls_key,             ca_file_key,   ca_file_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  ASSERT_TRUE(settings.Smtp().has_value());
+  EXPECT_EQ(settings.Smtp()->second, 465);
+  EXPECT_TRUE(settings.Tls());
+  EXPECT_EQ(settings.CaFile(), "path/to/some/directory/ca.pem");
+}
+
+TEST(MessengerSettings, ConstructorWithSpool) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char matchings_key[] = "--matchings";
+  char matchings_value[] = "path/to/some/directory/matchings.yaml";
+
+  char spool_key[] = "--spool";
+  char spool_value[] = "path/to/some/spool";
+
+  int argc{7};
+
+  char* argv[] = {
+    program,         configuration_key, configuration_value, matchings_key,
+    matchings_value, spool_key,         spool_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.SpoolDirectory(), "path/to/some/spool");
+  EXPECT_EQ(settings.SendSpoolDirectory(), "");
+  EXPECT_FALSE(settings.Smtp().has_value());
+}
+
+TEST(MessengerSettings, ConstructorWithSendSpool) {
+  char program[] = "bin/secret-santa";
+
+  char send_spool_key[] = "--send-spool";
+  char send_spool_value[] = "path/to/some/spool";
+
+  char smtp_key[] = "--smtp";
+  char smtp_value[] = "localhost:2525";
+
+  int argc{5};
+
+  char* argv[] = {program, send_spool_key, send_spool_value, smtp_key, smtp_value};
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.SendSpoolDirectory(), "path/to/some/spool");
+  EXPECT_EQ(settings.SpoolDirectory(), "");
+  ASSERT_TRUE(settings.Smtp().has_value());
+}
+
+TEST(MessengerSettings, ConstructorWithSendAt) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char matchings_key[] = "--matchings";
+  char matchings_value[] = "path/to/some/directory/matchings.yaml";
+
+  char send_at_key[] = "--send-at";
+  char send_at_value[] = "09:30";
+
+  char schedule_key[] = "--schedule";
+  char schedule_value[] = "path/to/some/directory/schedule.yaml";
+
+  int argc{9};
+
+  char* argv[] = {
+    program,       configuration_key, configuration_value, matchings_key,  matchings_value,
+    send_at_key,   send_at_value,     schedule_key,        schedule_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.SendAt(), 9 * 60 + 30);
+  EXPECT_EQ(settings.ScheduleFile(), "path/to/some/directory/schedule.yaml");
+}
+
+TEST(MessengerSettings, ConstructorWithShard) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char matchings_key[] = "--matchings";
+  char matchings_value[] = "path/to/some/directory/matchings.yaml";
+
+  char shard_key[] = "--shard";
+  char shard_value[] = "2/3";
+
+  int argc{7};
+
+  char* argv[] = {
+    program,         configuration_key, configuration_value, matchings_key,
+    matchings_value, shard_key,         shard_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.GifterShard(), SecretSanta::Shard(2, 3));
+  EXPECT_EQ(settings.OutcomesFile(), "outcomes.yaml");
+}
+
+TEST(MessengerSettings, ConstructorWithMerge) {
+  char program[] = "bin/secret-santa";
+
+  char first_merge_key[] = "--merge";
+  char first_merge_value[] = "path/to/some/directory/outcomes_1.yaml";
+
+  char second_merge_key[] = "--merge";
+  char second_merge_value[] = "path/to/some/directory/outcomes_2.yaml";
+
+  char report_key[] = "--report";
+  char report_value[] = "path/to/some/directory/report.yaml";
+
+  int argc{7};
+
+  char* argv[] = {
+    program,            first_merge_key, first_merge_value, second_merge_key,
+    second_merge_value, report_key,      report_value,
+  };
+
+  const SecretSanta::Messenger::Settings settings{argc, argv};
+
+  ASSERT_EQ(settings.MergeFiles().size(), 2);
+  EXPECT_EQ(settings.MergeFiles()[0], "path/to/some/directory/outcomes_1.yaml");
+  EXPECT_EQ(settings.MergeFiles()[1], "path/to/some/directory/outcomes_2.yaml");
+  EXPECT_EQ(settings.ReportFile(), "path/to/some/directory/report.yaml");
+}
+
 TEST(MessengerSettings, DefaultConstructor) {
   const SecretSanta::Messenger::Settings settings;
   EXPECT_EQ(settings.ConfigurationFile(), "");
   EXPECT_EQ(settings.MatchingsFile(), "");
+  EXPECT_EQ(settings.PreviousMatchingsFile(), "");
+  EXPECT_FALSE(settings.VerifyOnly());
+  EXPECT_FALSE(settings.Smtp().has_value());
+  EXPECT_TRUE(settings.Relays().empty());
+  EXPECT_EQ(settings.From(), "secret-santa@localhost");
+  EXPECT_EQ(settings.Connections(), 1);
+  EXPECT_FALSE(settings.EventLoops().has_value());
+  EXPECT_FALSE(settings.Tls());
+  EXPECT_EQ(settings.CaFile(), "");
+  EXPECT_EQ(settings.Attempts(), 4);
+  EXPECT_EQ(settings.DeadLettersFile(), "dead_letters.yaml");
+  EXPECT_EQ(settings.ReplayFile(), "");
+  EXPECT_EQ(settings.SpoolDirectory(), "");
+  EXPECT_EQ(settings.SendSpoolDirectory(), "");
+  EXPECT_FALSE(settings.SendAt().has_value());
+  EXPECT_EQ(settings.ScheduleFile(), "schedule.yaml");
+  EXPECT_FALSE(settings.GifterShard().has_value());
+  EXPECT_EQ(settings.OutcomesFile(), "");
+  EXPECT_TRUE(settings.MergeFiles().empty());
+  EXPECT_EQ(settings.ReportFile(), "report.yaml");
 }
 
 }  // namespace
@@ -0,0 +1,205 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/MimeEncoding.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// Generates a text of a given length of random bytes.
+std::string RandomBytes(const std::size_t length, std::mt19937_64& generator) {
+  std::uniform_int_distribution<int> distribution{0, 255};
+  std::string bytes(length, '\0');
+  for (char& byte : bytes) {
+    byte = static_cast<char>(distribution(generator));
+  }
+  return bytes;
+}
+
+TEST(MimeEncoding, Base64Encode) {
+  EXPECT_EQ(SecretSanta::Base64Encode(""), "");
+  EXPECT_EQ(SecretSanta::Base64Encode("f"), "Zg==");
+  EXPECT_EQ(SecretSanta::Base64Encode("fo"), "Zm8=");
+  EXPECT_EQ(SecretSanta::Base64Encode("foo"), "Zm9v");
+  EXPECT_EQ(SecretSanta::Base64Encode("foobar"), "Zm9vYmFy");
+  EXPECT_EQ(SecretSanta::Base64Encode("The quick brown fox jumps over the lazy dog."),
+            "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZy4=");
+  EXPECT_EQ(SecretSanta::Base64Encode("\xFB\xFF\xBF\xFB\xFF\xBF\xFB\xFF\xBF\xFB\xFF\xBF\xFB\xFF"
+                                      "\xBF\xFB"),
+            "+/+/+/+/+/+/+/+/+/+/+w==");
+}
+
+TEST(MimeEncoding, Base64EncodeVectorizedMatchesScalar) {
+  std::mt19937_64 generator{42};
+  for (std::size_t length = 0; length < 200; ++length) {
+    const std::string bytes{RandomBytes(length, generator)};
+    EXPECT_EQ(SecretSanta::Base64Encode(bytes, true), SecretSanta::Base64Encode(bytes, false));
+  }
+}
+
+TEST(MimeEncoding, Base64EncodeLines) {
+  std::mt19937_64 generator{7};
+  const std::string bytes{RandomBytes(1000, generator)};
+  const std::string encoded{SecretSanta::Base64EncodeLines(bytes)};
+
+  std::istringstream stream{encoded};
+  std::string line;
+  std::size_t line_count = 0;
+  while (std::getline(stream, line)) {
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.back(), '\r');
+    EXPECT_LE(line.size() - 1, SecretSanta::MimeLineLength);
+    ++line_count;
+  }
+  EXPECT_EQ(line_count, (1000 + 56) / 57);
+  EXPECT_EQ(SecretSanta::Base64Decode(encoded), bytes);
+  EXPECT_EQ(SecretSanta::Base64EncodeLines(""), "");
+}
+
+TEST(MimeEncoding, Base64Decode) {
+  EXPECT_EQ(SecretSanta::Base64Decode("Zm9vYmE="), "fooba");
+  EXPECT_EQ(SecretSanta::Base64Decode("Zm9v\r\nYmFy"), "foobar");
+  EXPECT_EQ(SecretSanta::Base64Decode("Zg"), "f");
+  EXPECT_FALSE(SecretSanta::Base64Decode("Zm9v*").has_value());
+
+  std::mt19937_64 generator{3};
+  for (std::size_t length = 0; length < 64; ++length) {
+    const std::string bytes{RandomBytes(length, generator)};
+    EXPECT_EQ(SecretSanta::Base64Decode(SecretSanta::Base64Encode(bytes)), bytes);
+  }
+}
+
+TEST(MimeEncoding, QuotedPrintableEncode) {
+  EXPECT_EQ(SecretSanta::QuotedPrintableEncode("Hello, World!"), "Hello, World!");
+  EXPECT_EQ(SecretSanta::QuotedPrintableEncode("a=b\nc\r\nd"), "a=3Db\r\nc\r\nd");
+  EXPECT_EQ(SecretSanta::QuotedPrintableEncode("Zoë"), "Zo=C3=AB");
+  EXPECT_EQ(SecretSanta::QuotedPrintableEncode("trailing \nspace\t"), "trailing=20\r\nspace=09");
+  EXPECT_EQ(SecretSanta::QuotedPrintableEncode("bare\rreturn"), "bare=0Dreturn");
+
+  // A line of 76 characters fits, but a line of 77 characters gets a soft line break.
+  const std::string fits(76, 'x');
+  EXPECT_EQ(SecretSanta::QuotedPrintableEncode(fits), fits);
+  EXPECT_EQ(SecretSanta::QuotedPrintableEncode(fits + "y"), std::string(75, 'x') + "=\r\nxy");
+}
+
+TEST(MimeEncoding, QuotedPrintableEncodeVectorizedMatchesScalar) {
+  std::mt19937_64 generator{11};
+  std::uniform_int_distribution<int> kind{0, 19};
+  for (std::size_t length = 0; length < 400; ++length) {
+    // Mostly printable ASCII text, with some spaces, line breaks, and non-ASCII bytes.
+    std::string text(length, '\0');
+    for (char& character : text) {
+      const int roll = kind(generator);
+      character = roll == 0 ? '\n' :
+                  roll == 1 ? ' ' :
+                  roll == 2 ? static_cast<char>(0xC3) :
+                              static_cast<char>('a' + roll);
+    }
+    const std::string vectorized{SecretSanta::QuotedPrintableEncode(text, true)};
+    EXPECT_EQ(vectorized, SecretSanta::QuotedPrintableEncode(text, false));
+    EXPECT_EQ(SecretSanta::QuotedPrintableDecode(vectorized), text);
+  }
+}
+
+TEST(MimeEncoding, QuotedPrintableLines) {
+  std::mt19937_64 generator{5};
+  const std::string text{RandomBytes(5000, generator)};
+  const std::string encoded{SecretSanta::QuotedPrintableEncode(text)};
+
+  std::istringstream stream{encoded};
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    EXPECT_LE(line.size(), SecretSanta::MimeLineLength);
+    for (const char character : line) {
+      EXPECT_LT(static_cast<unsigned char>(character), 128);
+      EXPECT_NE(character, '\r');
+    }
+    if (!line.empty()) {
+      EXPECT_NE(line.back(), ' ');
+      EXPECT_NE(line.back(), '\t');
+    }
+  }
+
+  // Random bytes include lone carriage returns, which are encoded, and carriage returns followed by
+  // line feeds, which become line feeds.
+  std::string expected;
+  for (std::size_t index = 0; index < text.size(); ++index) {
+    if (text[index] != '\r' || index + 1 >= text.size() || text[index + 1] != '\n') {
+      expected.push_back(text[index]);
+    }
+  }
+  EXPECT_EQ(SecretSanta::QuotedPrintableDecode(encoded), expected);
+}
+
+TEST(MimeEncoding, QuotedPrintableDecode) {
+  EXPECT_EQ(SecretSanta::QuotedPrintableDecode("Zo=C3=ab"), "Zoë");
+  EXPECT_EQ(SecretSanta::QuotedPrintableDecode("soft=\r\nbreak"), "softbreak");
+  EXPECT_EQ(SecretSanta::QuotedPrintableDecode("a\r\nb"), "a\nb");
+  EXPECT_EQ(SecretSanta::QuotedPrintableDecode("bad=ZZ"), "bad=ZZ");
+}
+
+TEST(MimeEncoding, EncodeHeaderValue) {
+  EXPECT_EQ(SecretSanta::EncodeHeaderValue("Secret Santa"), "Secret Santa");
+  EXPECT_EQ(SecretSanta::EncodeHeaderValue("Zoë"), "=?UTF-8?B?Wm/Dqw==?=");
+  EXPECT_EQ(SecretSanta::EncodeHeaderValue("=?x?"), "=?UTF-8?B?PT94Pw==?=");
+
+  // A long value is split into several encoded words of whole UTF-8 characters.
+  std::string long_value;
+  for (int index = 0; index < 40; ++index) {
+    long_value.append("é🎅");
+  }
+  const std::string encoded{SecretSanta::EncodeHeaderValue(long_value, 7)};
+  std::istringstream stream{encoded};
+  std::string line;
+  std::size_t line_count = 0;
+  while (std::getline(stream, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    EXPECT_LE(line.size() + (line_count == 0 ? 9 : 0), SecretSanta::MimeLineLength);
+    const std::string word{line.substr(line.find("=?"))};
+    const std::optional<std::string> bytes{SecretSanta::Base64Decode(
+        word.substr(10, word.size() - 12))};
+    ASSERT_TRUE(bytes.has_value());
+    EXPECT_NE(static_cast<unsigned char>(bytes->front()) & 0xC0U, 0x80U);
+    ++line_count;
+  }
+  EXPECT_GT(line_count, 1);
+  EXPECT_EQ(SecretSanta::DecodeHeaderValue(encoded), long_value);
+}
+
+TEST(MimeEncoding, DecodeHeaderValue) {
+  EXPECT_EQ(SecretSanta::DecodeHeaderValue("Plain text"), "Plain text");
+  EXPECT_EQ(
+      SecretSanta::DecodeHeaderValue("=?UTF-8?B?Wm/Dqw==?= and =?utf-8?q?P=C3=A8re_No=C3=ABl?="),
+      "Zoë and Père Noël");
+  EXPECT_EQ(SecretSanta::DecodeHeaderValue("=?UTF-8?B?Wm8=?=  =?UTF-8?B?w6s=?="), "Zoë");
+  EXPECT_EQ(SecretSanta::DecodeHeaderValue("broken =?UTF-8?B"), "broken =?UTF-8?B");
+}
+
+}  // namespace
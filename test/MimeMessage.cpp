@@ -0,0 +1,138 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/MimeMessage.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace {
+
+TEST(MimeMessage, ComposePlainText) {
+  const SecretSanta::MimeMessage message{
+      {{"From", "santa@example.com"}, {"Subject", "Père Noël"}}, "Bonjour Zoë!\n"};
+  EXPECT_EQ(message.Compose(),
+            "From: santa@example.com\r\n"
+            "Subject: =?UTF-8?B?UMOocmUgTm/Dq2w=?=\r\n"
+            "MIME-Version: 1.0\r\n"
+            "Content-Type: text/plain; charset=utf-8\r\n"
+            "Content-Transfer-Encoding: quoted-printable\r\n"
+            "\r\n"
+            "Bonjour Zo=C3=AB!\r\n");
+}
+
+TEST(MimeMessage, ComposeWithHtmlAndAttachment) {
+  SecretSanta::MimeMessage message{{{"To", "zoe@example.com"}}, "Hi"};
+  message.SetHtml("<b>Hi</b>");
+  message.Attach(SecretSanta::EncodeAttachment("fête.ics", "text/calendar", "abc"));
+  EXPECT_EQ(message.Compose(),
+            "To: zoe@example.com\r\n"
+            "MIME-Version: 1.0\r\n"
+            "Content-Type: multipart/mixed; boundary=\"=_SecretSanta_Mixed\"\r\n"
+            "\r\n"
+            "--=_SecretSanta_Mixed\r\n"
+            "Content-Type: multipart/alternative; boundary=\"=_SecretSanta_Alternative\"\r\n"
+            "\r\n"
+            "--=_SecretSanta_Alternative\r\n"
+            "Content-Type: text/plain; charset=utf-8\r\n"
+            "Content-Transfer-Encoding: quoted-printable\r\n"
+            "\r\n"
+            "Hi\r\n"
+            "--=_SecretSanta_Alternative\r\n"
+            "Content-Type: text/html; charset=utf-8\r\n"
+            "Content-Transfer-Encoding: quoted-printable\r\n"
+            "\r\n"
+            "<b>Hi</b>\r\n"
+            "--=_SecretSanta_Alternative--\r\n"
+            "\r\n"
+            "--=_SecretSanta_Mixed\r\n"
+            "Content-Type: text/calendar; name*=utf-8''f%C3%AAte.ics\r\n"
+            "Content-Transfer-Encoding: base64\r\n"
+            "Content-Disposition: attachment; filename*=utf-8''f%C3%AAte.ics\r\n"
+            "\r\n"
+            "YWJj\r\n"
+            "\r\n"
+            "--=_SecretSanta_Mixed--\r\n");
+}
+
+TEST(MimeMessage, EncodeAttachment) {
+  const std::shared_ptr<const SecretSanta::EmailAttachment> encoded{
+      SecretSanta::EncodeAttachment("invite.ics", "text/calendar", std::string(500, 'x'))};
+  EXPECT_EQ(encoded->encoded_part, SecretSanta::EncodeAttachmentPart(*encoded));
+
+  // An attachment encoded once composes the same way as one encoded with each email message.
+  SecretSanta::MimeMessage shared{{{"To", "a@example.com"}}, "Hi"};
+  shared.Attach(encoded);
+  SecretSanta::MimeMessage unshared{{{"To", "a@example.com"}}, "Hi"};
+  unshared.Attach(std::make_shared<const SecretSanta::EmailAttachment>(
+      SecretSanta::EmailAttachment{"invite.ics", "text/calendar", std::string(500, 'x'), ""}));
+  EXPECT_EQ(shared.Compose(), unshared.Compose());
+}
+
+TEST(MimeMessage, ComposeAndParse) {
+  SecretSanta::MimeMessage message{
+      {{"From", "santa@example.com"}, {"To", "zoe@example.com"}, {"Subject", "Père Noël 🎅"}},
+      "Bonjour Zoë,\n\n--=_SecretSanta_Mixed\n.\nÀ bientôt ! \n"};
+  message.SetHtml("<p>Bonjour Zoë</p>\n");
+  message.Attach(SecretSanta::EncodeAttachment(
+      "a \"quoted\" name.txt", "text/plain", std::string(1000, '\xE9')));
+  message.Attach(std::make_shared<const SecretSanta::EmailAttachment>(
+      SecretSanta::EmailAttachment{"empty.bin", "application/octet-stream", "", ""}));
+
+  const std::optional<SecretSanta::MimeMessage> parsed{
+      SecretSanta::MimeMessage::Parse(message.Compose())};
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_EQ(parsed->HeaderFields().size(), 3);
+  EXPECT_EQ(parsed->HeaderField("subject"), "Père Noël 🎅");
+  EXPECT_EQ(parsed->HeaderField("To"), "zoe@example.com");
+  EXPECT_EQ(parsed->Text(), message.Text());
+  EXPECT_EQ(parsed->Html(), message.Html());
+  ASSERT_EQ(parsed->Attachments().size(), 2);
+  EXPECT_EQ(parsed->Attachments()[0]->file_name, "a \"quoted\" name.txt");
+  EXPECT_EQ(parsed->Attachments()[0]->content_type, "text/plain");
+  EXPECT_EQ(parsed->Attachments()[0]->data, message.Attachments()[0]->data);
+  EXPECT_EQ(parsed->Attachments()[1]->file_name, "empty.bin");
+  EXPECT_EQ(parsed->Attachments()[1]->data, "");
+}
+
+TEST(MimeMessage, ParseUnencodedMessage) {
+  const std::optional<SecretSanta::MimeMessage> parsed{SecretSanta::MimeMessage::Parse(
+      "To: bob@example.com\r\nContent-Type: text/plain; charset=utf-8\r\n"
+      "Content-Transfer-Encoding: 8bit\r\n\r\nHéllo\r\nBob")};
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(parsed->HeaderFields().size(), 1);
+  EXPECT_EQ(parsed->Text(), "Héllo\nBob");
+  EXPECT_FALSE(SecretSanta::MimeMessage::Parse("").has_value());
+}
+
+TEST(MimeMessage, MimeHeaderParameter) {
+  EXPECT_EQ(SecretSanta::MimeHeaderParameter("multipart/mixed; BOUNDARY=\"a b\"", "boundary"),
+            "a b");
+  EXPECT_EQ(SecretSanta::MimeHeaderParameter("text/plain; charset=utf-8 ; x=y", "charset"),
+            "utf-8");
+  EXPECT_EQ(SecretSanta::MimeHeaderParameter("attachment; filename*=utf-8'fr'%C3%A9.ics",
+                                             "filename"),
+            "é.ics");
+  EXPECT_EQ(SecretSanta::MimeHeaderParameter("text/plain", "charset"), "");
+}
+
+}  // namespace
@@ -47,6 +47,19 @@ TEST(Participant, ConstructorFromName) {
   EXPECT_TRUE(participant.Instructions().empty());
 }
 
+TEST(Participant, ConstructorFromFields) {
+  const SecretSanta::Participant participant{
+      "Alice Smith", "alice.smith@gmail.com", "123 First Ave, Apt 1, Townsville, CA 91234 USA",
+      "Leave the package with the doorman in the lobby.", "Marketing"};
+  EXPECT_EQ(participant.Name(), "Alice Smith");
+  EXPECT_EQ(participant.Email(), "alice.smith@gmail.com");
+  EXPECT_EQ(participant.Address(), "123 First Ave, Apt 1, Townsville, CA 91234 USA");
+  EXPECT_EQ(participant.Instructions(), "Leave the package with the doorman in the lobby.");
+  EXPECT_EQ(participant.Group(), "Marketing");
+  EXPECT_TRUE(participant.TimeZone().empty());
+  EXPECT_TRUE(participant.Location().empty());
+}
+
 TEST(Participant, ConstructorFromYamlNode) {
   const SecretSanta::Participant participant{SecretSanta::CreateSampleParticipantA()};
   EXPECT_EQ(participant.Name(), "Alice Smith");
@@ -55,6 +68,44 @@ TEST(Participant, ConstructorFromYamlNode) {
   EXPECT_EQ(participant.Instructions(), "Leave the package with the doorman in the lobby.");
 }
 
+TEST(Participant, ConstructorFromYamlNodeWithGroup) {
+  YAML::Node node{SecretSanta::CreateSampleParticipantB()};
+  node["Bob Johnson"]["group"] = "Marketing";
+  const SecretSanta::Participant participant{node};
+  EXPECT_EQ(participant.Name(), "Bob Johnson");
+  EXPECT_EQ(participant.Group(), "Marketing");
+  EXPECT_EQ(participant.Print(),
+            "Bob Johnson (email: bob.johnson@gmail.com; address: 456 Second St, Apt 2, "
+            "Villagetown, CA 92345 USA; group: Marketing)");
+  EXPECT_EQ(participant.YAML()["Bob Johnson"]["group"].as<std::string>(), "Marketing");
+}
+
+TEST(Participant, ConstructorFromYamlNodeWithTimeZone) {
+  YAML::Node node{SecretSanta::CreateSampleParticipantB()};
+  node["Bob Johnson"]["timezone"] = "Europe/Paris";
+  const SecretSanta::Participant participant{node};
+  EXPECT_EQ(participant.TimeZone(), "Europe/Paris");
+  EXPECT_EQ(participant.Print(),
+            "Bob Johnson (email: bob.johnson@gmail.com; address: 456 Second St, Apt 2, "
+            "Villagetown, CA 92345 USA; timezone: Europe/Paris)");
+  EXPECT_EQ(participant.YAML()["Bob Johnson"]["timezone"].as<std::string>(), "Europe/Paris");
+  EXPECT_FALSE(SecretSanta::Participant{SecretSanta::CreateSampleParticipantA()}
+                   .YAML()["Alice Smith"]["timezone"]);
+}
+
+TEST(Participant, ConstructorFromYamlNodeWithLocation) {
+  YAML::Node node{SecretSanta::CreateSampleParticipantB()};
+  node["Bob Johnson"]["location"] = "34.0522, -118.2437";
+  const SecretSanta::Participant participant{node};
+  EXPECT_EQ(participant.Location(), "34.0522, -118.2437");
+  EXPECT_EQ(participant.Print(),
+            "Bob Johnson (email: bob.johnson@gmail.com; address: 456 Second St, Apt 2, "
+            "Villagetown, CA 92345 USA; location: 34.0522, -118.2437)");
+  EXPECT_EQ(participant.YAML()["Bob Johnson"]["location"].as<std::string>(), "34.0522, -118.2437");
+  EXPECT_FALSE(SecretSanta::Participant{SecretSanta::CreateSampleParticipantA()}
+                   .YAML()["Alice Smith"]["location"]);
+}
+
 TEST(Participant, CopyAssignmentOperator) {
   const SecretSanta::Participant first{SecretSanta::CreateSampleParticipantA()};
   SecretSanta::Participant second =
@@ -75,6 +126,7 @@ TEST(Participant, DefaultConstructor) {
   EXPECT_TRUE(participant.Email().empty());
   EXPECT_TRUE(participant.Address().empty());
   EXPECT_TRUE(participant.Instructions().empty());
+  EXPECT_TRUE(participant.Group().empty());
 }
 
 TEST(Participant, Hash) {
@@ -0,0 +1,109 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/ParticipantTable.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <set>
+#include <utility>
+#include <yaml-cpp/yaml.h>
+
+#include "../source/Configuration.hpp"
+
+namespace {
+
+TEST(ParticipantTable, ConfigurationFile) {
+  const SecretSanta::ParticipantTable table{
+      YAML::LoadFile("../test/configuration.yaml")["participants"]};
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  ASSERT_EQ(table.Size(), configuration.Participants().size());
+
+  std::size_t index{0};
+  for (const SecretSanta::Participant& participant : configuration.Participants()) {
+    const SecretSanta::ParticipantView view{table[index]};
+    EXPECT_EQ(view.Name(), participant.Name());
+    EXPECT_EQ(view.Email(), participant.Email());
+    EXPECT_EQ(view.Address(), participant.Address());
+    EXPECT_EQ(view.Instructions(), participant.Instructions());
+    EXPECT_EQ(view.ToParticipant().Print(), participant.Print());
+    ++index;
+  }
+  EXPECT_EQ(table.ToParticipants(), configuration.Participants());
+}
+
+TEST(ParticipantTable, DefaultConstructor) {
+  const SecretSanta::ParticipantTable table;
+  EXPECT_EQ(table.Size(), 0);
+  EXPECT_EQ(table.ByteCount(), 0);
+  EXPECT_FALSE(table.Find("Alice Smith").has_value());
+  EXPECT_TRUE(table.ToParticipants().empty());
+}
+
+TEST(ParticipantTable, AddAndFind) {
+  SecretSanta::ParticipantTable table;
+  table.Reserve(3, 128);
+  EXPECT_TRUE(table.Add({"Claire Jones", "claire.jones@gmail.com", "", "", "", "", ""}));
+  EXPECT_TRUE(table.Add({"Alice Smith", "alice.smith@gmail.com", "123 First Ave", "", "Marketing",
+                         "America/Los_Angeles", "34.0522, -118.2437"}));
+  EXPECT_FALSE(table.Add({"", "nobody@gmail.com", "", "", "", "", ""}));
+  EXPECT_TRUE(table.Add({"Alice Smith", "alice.smith@yahoo.com", "", "", "", "", ""}));
+  table.Sort();
+
+  ASSERT_EQ(table.Size(), 2);
+  EXPECT_EQ(table[0].Name(), "Alice Smith");
+  EXPECT_EQ(table[1].Name(), "Claire Jones");
+
+  const std::optional<SecretSanta::ParticipantView> alice{table.Find("Alice Smith")};
+  ASSERT_TRUE(alice.has_value());
+  EXPECT_EQ(alice->Email(), "alice.smith@gmail.com");
+  EXPECT_EQ(alice->Address(), "123 First Ave");
+  EXPECT_EQ(alice->Instructions(), "");
+  EXPECT_EQ(alice->Group(), "Marketing");
+  EXPECT_EQ(alice->TimeZone(), "America/Los_Angeles");
+  EXPECT_EQ(alice->Location(), "34.0522, -118.2437");
+
+  EXPECT_FALSE(table.Find("Bob Johnson").has_value());
+  EXPECT_FALSE(table.Find("Zoe").has_value());
+}
+
+TEST(ParticipantTable, MalformedEntries) {
+  const SecretSanta::ParticipantTable table{YAML::Load(
+      "- Alice Smith:\n    email: alice.smith@gmail.com\n    address: [1, 2]\n"
+      "- just a string\n"
+      "- {Bob Johnson: {email: bob.johnson@gmail.com}, Claire Jones: {}}\n")};
+  ASSERT_EQ(table.Size(), 1);
+  EXPECT_EQ(table[0].Name(), "Alice Smith");
+  EXPECT_EQ(table[0].Address(), "");
+}
+
+TEST(ParticipantTable, MoveConstructor) {
+  SecretSanta::ParticipantTable first;
+  EXPECT_TRUE(first.Add({"Alice Smith", "alice.smith@gmail.com", "", "", "", "", ""}));
+  first.Sort();
+  const SecretSanta::ParticipantView view{first[0]};
+
+  const SecretSanta::ParticipantTable second{std::move(first)};
+  ASSERT_EQ(second.Size(), 1);
+  EXPECT_EQ(view.Email(), "alice.smith@gmail.com");
+  EXPECT_EQ(second.Find("Alice Smith")->Email(), "alice.smith@gmail.com");
+}
+
+}  // namespace
@@ -0,0 +1,154 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/RandomRounds.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <set>
+
+#include "../source/Statistics.hpp"
+
+namespace {
+
+// Returns the lengths of the cycles of a given round of gifts, in increasing order.
+std::vector<std::size_t> CycleLengthsOf(const std::vector<std::size_t>& giftees) {
+  std::vector<std::size_t> lengths;
+  std::vector<bool> visited(giftees.size(), false);
+  for (std::size_t start = 0; start < giftees.size(); ++start) {
+    std::size_t length = 0;
+    for (std::size_t index = start; !visited[index]; index = giftees[index]) {
+      visited[index] = true;
+      ++length;
+    }
+    if (length > 0) {
+      lengths.push_back(length);
+    }
+  }
+  std::sort(lengths.begin(), lengths.end());
+  return lengths;
+}
+
+// Checks that each round of the given rounds of gifts is a permutation without self-gifts, and
+// that no pair of a gifter and a giftee appears in two rounds.
+void ExpectDisjointRounds(const SecretSanta::RandomRounds& rounds) {
+  std::set<std::pair<std::size_t, std::size_t>> pairs;
+  for (std::size_t round = 0; round < rounds.RoundCount(); ++round) {
+    const std::vector<std::size_t>& giftees = rounds.Giftees(round);
+    EXPECT_EQ(std::set<std::size_t>(giftees.cbegin(), giftees.cend()).size(),
+              rounds.ParticipantCount());
+    for (std::size_t gifter = 0; gifter < giftees.size(); ++gifter) {
+      EXPECT_NE(gifter, giftees[gifter]);
+      EXPECT_TRUE(pairs.emplace(gifter, giftees[gifter]).second);
+    }
+  }
+}
+
+TEST(RandomRounds, DrawOneCycle) {
+  SecretSanta::RandomRounds rounds{12, 1};
+  std::mt19937_64 random_generator{42};
+  for (int draw = 0; draw < 10; ++draw) {
+    rounds.Draw(random_generator);
+    EXPECT_EQ(rounds.RoundCount(), 1);
+    EXPECT_EQ(rounds.CycleCount(), 1);
+    EXPECT_TRUE(rounds.Partitioned());
+    EXPECT_EQ(CycleLengthsOf(rounds.Giftees(0)), std::vector<std::size_t>{12});
+  }
+}
+
+TEST(RandomRounds, DrawWithCycleLengths) {
+  SecretSanta::RandomRounds rounds{23, 3, SecretSanta::CycleLengths{4, 6}};
+  std::mt19937_64 random_generator{42};
+  for (int draw = 0; draw < 20; ++draw) {
+    rounds.Draw(random_generator);
+    ExpectDisjointRounds(rounds);
+    EXPECT_EQ(CycleLengthsOf(rounds.Giftees(0)).size(), rounds.CycleCount());
+    for (std::size_t round = 0; round < rounds.RoundCount(); ++round) {
+      for (const std::size_t length : CycleLengthsOf(rounds.Giftees(round))) {
+        EXPECT_GE(length, 4);
+        EXPECT_LE(length, 6);
+      }
+    }
+  }
+}
+
+TEST(RandomRounds, DrawWithInfeasibleCycleLengths) {
+  SecretSanta::RandomRounds rounds{7, 1, SecretSanta::CycleLengths{4, 5}};
+  std::mt19937_64 random_generator{42};
+  rounds.Draw(random_generator);
+  EXPECT_FALSE(rounds.Partitioned());
+  EXPECT_EQ(CycleLengthsOf(rounds.Giftees(0)), std::vector<std::size_t>{7});
+}
+
+TEST(RandomRounds, DrawInSmallGroup) {
+  SecretSanta::RandomRounds rounds{4, 3};
+  std::mt19937_64 random_generator{42};
+  for (int draw = 0; draw < 50; ++draw) {
+    rounds.Draw(random_generator);
+    EXPECT_EQ(rounds.RoundCount(), 3);
+    ExpectDisjointRounds(rounds);
+  }
+}
+
+TEST(RandomRounds, RoundCount) {
+  EXPECT_EQ(SecretSanta::RandomRounds(3, 5).RoundCount(), 2);
+  EXPECT_EQ(SecretSanta::RandomRounds(2, 5).RoundCount(), 1);
+  EXPECT_EQ(SecretSanta::RandomRounds(1, 5).RoundCount(), 1);
+  EXPECT_EQ(SecretSanta::RandomRounds(10, 0).RoundCount(), 1);
+
+  SecretSanta::RandomRounds alone{1, 1};
+  std::mt19937_64 random_generator{42};
+  alone.Draw(random_generator);
+  EXPECT_EQ(alone.Giftees(0), std::vector<std::size_t>{0});
+
+  SecretSanta::RandomRounds empty{0, 1};
+  empty.Draw(random_generator);
+  EXPECT_TRUE(empty.Giftees(0).empty());
+}
+
+TEST(RandomRounds, GifteesAreUniform) {
+  constexpr std::size_t participant_count{10};
+  constexpr std::size_t draw_count{20000};
+  SecretSanta::RandomRounds rounds{participant_count, 2, SecretSanta::CycleLengths{2, 4}};
+  std::mt19937_64 random_generator{42};
+  std::vector<std::vector<uint64_t>> counts(
+      participant_count, std::vector<uint64_t>(participant_count, 0));
+  for (std::size_t draw = 0; draw < draw_count; ++draw) {
+    rounds.Draw(random_generator);
+    for (std::size_t round = 0; round < rounds.RoundCount(); ++round) {
+      for (std::size_t gifter = 0; gifter < participant_count; ++gifter) {
+        ++counts[gifter][rounds.Giftees(round)[gifter]];
+      }
+    }
+  }
+
+  // Each gifter gives two gifts per draw to distinct giftees among the nine other participants.
+  std::vector<double> expected(participant_count, draw_count * 2.0 / (participant_count - 1));
+  for (std::size_t gifter = 0; gifter < participant_count; ++gifter) {
+    expected[gifter] = 0.0;
+    const std::optional<double> statistic =
+        SecretSanta::ChiSquaredStatistic(counts[gifter], expected);
+    ASSERT_TRUE(statistic.has_value());
+    EXPECT_GT(SecretSanta::ChiSquaredSurvival(statistic.value() * 7.0 / 8.0, 8.0), 1.0e-4);
+    expected[gifter] = draw_count * 2.0 / (participant_count - 1);
+  }
+}
+
+}  // namespace
@@ -51,11 +51,154 @@ TEST(RandomizerSettings, Constructor) {
   EXPECT_EQ(settings.RandomSeed(), 42);
 }
 
+TEST(RandomizerSettings, ConstructorWithCycleLengths) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char minimum_key[] = "--minimum-cycle-length";
+  char minimum_value[] = "3";
+
+  char maximum_key[] = "--maximum-cycle-length";
+  char maximum_value[] = "6";
+
+  char groups_key[] = "--groups";
+
+  int argc{8};
+
+  char* argv[] = {
+    program,       configuration_key, configuration_value, minimum_key,
+    minimum_value, maximum_key,       maximum_value,       groups_key,
+  };
+
+  const SecretSanta::Randomizer::Settings settings{argc, argv};
+
+  ASSERT_TRUE(settings.CycleLengthBounds().has_value());
+  EXPECT_EQ(settings.CycleLengthBounds(), SecretSanta::CycleLengths(3, 6));
+  EXPECT_TRUE(settings.AlignToGroups());
+}
+
+TEST(RandomizerSettings, ConstructorWithMinimizeDistance) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char minimize_distance_key[] = "--minimize-distance";
+  char minimize_distance_value[] = "maximum";
+
+  char randomness_key[] = "--distance-randomness";
+  char randomness_value[] = "0.25";
+
+  char postal_codes_key[] = "--postal-codes";
+  char postal_codes_value[] = "path/to/some/directory/postal_codes.csv";
+
+  int argc{9};
+
+  char* argv[] = {
+    program,          configuration_key,  configuration_value, minimize_distance_key,
+    minimize_distance_value, randomness_key, randomness_value,  postal_codes_key,
+    postal_codes_value,
+  };
+
+  const SecretSanta::Randomizer::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.MinimizeDistance(), SecretSanta::DistanceObjective::Maximum);
+  EXPECT_DOUBLE_EQ(settings.DistanceRandomness(), 0.25);
+  EXPECT_EQ(settings.PostalCodesFile(), "path/to/some/directory/postal_codes.csv");
+}
+
+TEST(RandomizerSettings, ConstructorWithGifts) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char gifts_key[] = "--gifts";
+  char gifts_value[] = "3";
+
+  int argc{5};
+
+  char* argv[] = {program, configuration_key, configuration_value, gifts_key, gifts_value};
+
+  const SecretSanta::Randomizer::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.GiftCount(), 3);
+}
+
+TEST(RandomizerSettings, ConstructorWithTokens) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char tokens_key[] = "--tokens";
+  char tokens_value[] = "path/to/some/directory/tokens.yaml";
+
+  int argc{5};
+
+  char* argv[] = {program, configuration_key, configuration_value, tokens_key, tokens_value};
+
+  const SecretSanta::Randomizer::Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.TokensFile(), "path/to/some/directory/tokens.yaml");
+}
+
+TEST(RandomizerSettings, ConstructorWithWatch) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char watch_key[] = "--watch";
+
+  int argc{4};
+
+  char* argv[] = {program, configuration_key, configuration_value, watch_key};
+
+  const SecretSanta::Randomizer::Settings settings{argc, argv};
+
+  EXPECT_TRUE(settings.Watch());
+}
+
+TEST(RandomizerSettings, ConstructorWithSend) {
+  char program[] = "bin/secret-santa";
+
+  char configuration_key[] = "--configuration";
+  char configuration_value[] = "path/to/some/directory/configuration.yaml";
+
+  char matchings_key[] = "--matchings";
+  char matchings_value[] = "path/to/some/directory/matchings.yaml";
+
+  char send_key[] = "--send";
+
+  int argc{6};
+
+  char* argv[] = {program,       configuration_key, configuration_value,
+                  matchings_key, matchings_value,   send_key};
+
+  const SecretSanta::Randomizer::Settings settings{argc, argv};
+
+  EXPECT_TRUE(settings.Send());
+  EXPECT_EQ(settings.MatchingsFile(), "path/to/some/directory/matchings.yaml");
+}
+
 TEST(RandomizerSettings, DefaultConstructor) {
   const SecretSanta::Randomizer::Settings settings;
   EXPECT_EQ(settings.ConfigurationFile(), "");
   EXPECT_EQ(settings.MatchingsFile(), "");
+  EXPECT_EQ(settings.PreviousMatchingsFile(), "");
   EXPECT_EQ(settings.RandomSeed(), std::nullopt);
+  EXPECT_EQ(settings.CycleLengthBounds(), std::nullopt);
+  EXPECT_FALSE(settings.AlignToGroups());
+  EXPECT_FALSE(settings.Send());
+  EXPECT_FALSE(settings.MinimizeDistance().has_value());
+  EXPECT_DOUBLE_EQ(settings.DistanceRandomness(), 0.0);
+  EXPECT_EQ(settings.PostalCodesFile(), "");
+  EXPECT_EQ(settings.GiftCount(), 1);
+  EXPECT_EQ(settings.TokensFile(), "");
+  EXPECT_FALSE(settings.Watch());
 }
 
 }  // namespace
@@ -0,0 +1,68 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SECRET_SANTA_RECORDING_TRANSPORT_HPP
+#define SECRET_SANTA_RECORDING_TRANSPORT_HPP
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../source/Transport.hpp"
+
+namespace SecretSanta {
+
+// Transport that delivers nothing and instead records every email message it is given. Used for
+// testing the composition and sending of email messages without sending any real email.
+class RecordingTransport : public Transport {
+public:
+  RecordingTransport() = default;
+
+  ~RecordingTransport() noexcept override = default;
+
+  [[nodiscard]] std::string Name() const override {
+    return "Recording";
+  }
+
+  void Send(EmailMessage message, Completion completion) override {
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      messages_.push_back(message);
+    }
+    completion(message, Delivery{});
+  }
+
+  void Flush() override {}
+
+  // Email messages recorded so far, in the order in which they were sent.
+  [[nodiscard]] std::vector<EmailMessage> Messages() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return messages_;
+  }
+
+private:
+  mutable std::mutex mutex_;
+
+  std::vector<EmailMessage> messages_;
+};
+
+}  // namespace SecretSanta
+
+#endif  // SECRET_SANTA_RECORDING_TRANSPORT_HPP
@@ -0,0 +1,272 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/RetryingTransport.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Transport that fails a given number of attempts for each recipient before delivering, or always
+// fails permanently for given recipients. Completes each attempt right away and records the time of
+// each attempt per recipient.
+class FlakyTransport : public SecretSanta::Transport {
+public:
+  explicit FlakyTransport(const std::size_t transient_failure_count,
+                          std::vector<std::string> permanently_failing_recipients = {})
+    : transient_failure_count_(transient_failure_count),
+      permanently_failing_recipients_(std::move(permanently_failing_recipients)) {}
+
+  [[nodiscard]] std::string Name() const override {
+    return "Flaky";
+  }
+
+  void Send(SecretSanta::EmailMessage message, Completion completion) override {
+    std::size_t attempt = 0;
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      attempts_[message.Recipient()].push_back(std::chrono::steady_clock::now());
+      attempt = attempts_[message.Recipient()].size();
+    }
+    if (std::find(permanently_failing_recipients_.cbegin(), permanently_failing_recipients_.cend(),
+                  message.Recipient())
+        != permanently_failing_recipients_.cend()) {
+      completion(message, SecretSanta::Delivery{SecretSanta::DeliveryStatus::PermanentFailure,
+                                                "550 5.1.1 Mailbox unavailable"});
+    } else if (attempt <= transient_failure_count_) {
+      completion(message, SecretSanta::Delivery{SecretSanta::DeliveryStatus::TransientFailure,
+                                                "451 4.3.0 Try again later"});
+    } else {
+      completion(message, SecretSanta::Delivery{});
+    }
+  }
+
+  void Flush() override {}
+
+  // Times of the attempts made for a given recipient.
+  [[nodiscard]] std::vector<std::chrono::steady_clock::time_point> Attempts(
+      const std::string& recipient) const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    const std::map<std::string, std::vector<std::chrono::steady_clock::time_point>>::const_iterator
+        found = attempts_.find(recipient);
+    return found != attempts_.cend() ? found->second :
+                                       std::vector<std::chrono::steady_clock::time_point>{};
+  }
+
+private:
+  std::size_t transient_failure_count_;
+
+  std::vector<std::string> permanently_failing_recipients_;
+
+  mutable std::mutex mutex_;
+
+  std::map<std::string, std::vector<std::chrono::steady_clock::time_point>> attempts_;
+};
+
+// Retry policy with short delays, suitable for tests.
+SecretSanta::RetryPolicy ShortPolicy(const std::size_t maximum_attempts) {
+  SecretSanta::RetryPolicy policy;
+  policy.maximum_attempts = maximum_attempts;
+  policy.initial_delay = std::chrono::milliseconds{2};
+  policy.maximum_delay = std::chrono::milliseconds{10};
+  return policy;
+}
+
+// Email message to a given recipient.
+SecretSanta::EmailMessage Message(const std::string& recipient) {
+  return {"Gifter", recipient, "Subject", "Body"};
+}
+
+TEST(RetryingTransport, Backoff) {
+  SecretSanta::RetryPolicy policy;
+  policy.initial_delay = std::chrono::milliseconds{100};
+  policy.maximum_delay = std::chrono::milliseconds{1000};
+  std::mt19937_64 random_generator{0};
+
+  // The bound doubles after each failed attempt until it reaches the maximum delay.
+  const std::vector<int64_t> bounds{100, 200, 400, 800, 1000, 1000};
+  for (std::size_t failed_attempts = 1; failed_attempts <= bounds.size(); ++failed_attempts) {
+    int64_t largest = 0;
+    int64_t total = 0;
+    for (int sample = 0; sample < 1000; ++sample) {
+      const int64_t delay =
+          SecretSanta::RetryingTransport::Backoff(policy, failed_attempts, random_generator)
+              .count();
+      EXPECT_GE(delay, 0);
+      EXPECT_LE(delay, bounds[failed_attempts - 1]);
+      largest = std::max(largest, delay);
+      total += delay;
+    }
+    // The delays are spread over the whole range rather than all equal to the bound.
+    EXPECT_GT(largest, bounds[failed_attempts - 1] * 9 / 10);
+    EXPECT_LT(total / 1000, bounds[failed_attempts - 1] * 6 / 10);
+    EXPECT_GT(total / 1000, bounds[failed_attempts - 1] * 4 / 10);
+  }
+}
+
+TEST(RetryingTransport, GiveUpAfterMaximumAttempts) {
+  FlakyTransport flaky{10};
+  SecretSanta::RetryingTransport transport{flaky, ShortPolicy(3)};
+
+  std::vector<SecretSanta::Delivery> deliveries;
+  transport.Send(Message("alice@example.com"),
+                 [&](const SecretSanta::EmailMessage&, const SecretSanta::Delivery& delivery) {
+                   deliveries.push_back(delivery);
+                 });
+  transport.Flush();
+
+  ASSERT_EQ(deliveries.size(), 1);
+  EXPECT_EQ(deliveries[0].Status(), SecretSanta::DeliveryStatus::TransientFailure);
+  EXPECT_EQ(flaky.Attempts("alice@example.com").size(), 3);
+  EXPECT_EQ(transport.RetryCount(), 2);
+
+  const SecretSanta::DeadLetters undelivered{transport.Undelivered()};
+  ASSERT_EQ(undelivered.Size(), 1);
+  EXPECT_EQ(undelivered.Entries()[0].message.Recipient(), "alice@example.com");
+  EXPECT_EQ(undelivered.Entries()[0].attempts, 3);
+  EXPECT_EQ(undelivered.Entries()[0].details, "451 4.3.0 Try again later");
+}
+
+TEST(RetryingTransport, Name) {
+  FlakyTransport flaky{0};
+  const SecretSanta::RetryingTransport transport{flaky, ShortPolicy(5)};
+  EXPECT_EQ(transport.Name(), "Flaky with up to 5 attempts");
+}
+
+TEST(RetryingTransport, PermanentFailuresAreNotRetried) {
+  FlakyTransport flaky{0, {"bob@example.com"}};
+  SecretSanta::RetryingTransport transport{flaky, ShortPolicy(4)};
+
+  std::vector<SecretSanta::Delivery> deliveries;
+  for (const std::string recipient : {"alice@example.com", "bob@example.com"}) {
+    transport.Send(Message(recipient),
+                   [&](const SecretSanta::EmailMessage&, const SecretSanta::Delivery& delivery) {
+                     deliveries.push_back(delivery);
+                   });
+  }
+  transport.Flush();
+
+  ASSERT_EQ(deliveries.size(), 2);
+  EXPECT_TRUE(deliveries[0].Succeeded());
+  EXPECT_EQ(deliveries[1].Status(), SecretSanta::DeliveryStatus::PermanentFailure);
+  EXPECT_EQ(flaky.Attempts("bob@example.com").size(), 1);
+  EXPECT_EQ(transport.RetryCount(), 0);
+
+  const SecretSanta::DeadLetters undelivered{transport.Undelivered()};
+  ASSERT_EQ(undelivered.Size(), 1);
+  EXPECT_EQ(undelivered.Entries()[0].message.Recipient(), "bob@example.com");
+  EXPECT_EQ(undelivered.Entries()[0].attempts, 1);
+}
+
+TEST(RetryingTransport, RecordOutcomes) {
+  FlakyTransport flaky{1, {"bob@example.com"}};
+  SecretSanta::RetryingTransport transport{flaky, ShortPolicy(4)};
+
+  for (const std::string recipient : {"alice@example.com", "bob@example.com"}) {
+    transport.Send(Message(recipient),
+                   [](const SecretSanta::EmailMessage&, const SecretSanta::Delivery&) {});
+  }
+  transport.Flush();
+
+  const SecretSanta::DeliveryOutcomes outcomes{transport.Outcomes()};
+  ASSERT_EQ(outcomes.Size(), 2);
+  // Bob's permanent failure completes at once, whereas Alice's delivery waits for a retry.
+  EXPECT_EQ(outcomes.Entries()[0].recipient, "bob@example.com");
+  EXPECT_EQ(outcomes.Entries()[0].status, SecretSanta::DeliveryStatus::PermanentFailure);
+  EXPECT_EQ(outcomes.Entries()[0].attempts, 1);
+  EXPECT_EQ(outcomes.Entries()[0].details, "550 5.1.1 Mailbox unavailable");
+  EXPECT_EQ(outcomes.Entries()[1].gifter, "Gifter");
+  EXPECT_EQ(outcomes.Entries()[1].recipient, "alice@example.com");
+  EXPECT_EQ(outcomes.Entries()[1].status, SecretSanta::DeliveryStatus::Delivered);
+  EXPECT_EQ(outcomes.Entries()[1].attempts, 2);
+}
+
+TEST(RetryingTransport, RetriesDoNotBlockFreshSends) {
+  SecretSanta::RetryPolicy policy;
+  policy.maximum_attempts = 2;
+  policy.initial_delay = std::chrono::milliseconds{400};
+  policy.maximum_delay = std::chrono::milliseconds{400};
+
+  // Find a seed whose first delay is long enough to tell the retry apart from the fresh sends.
+  uint64_t seed = 0;
+  std::chrono::milliseconds delay{0};
+  while (delay < std::chrono::milliseconds{100}) {
+    ++seed;
+    std::mt19937_64 random_generator{seed};
+    delay = SecretSanta::RetryingTransport::Backoff(policy, 1, random_generator);
+  }
+
+  FlakyTransport flaky{1};
+  SecretSanta::RetryingTransport transport{flaky, policy, seed};
+
+  std::mutex mutex;
+  std::vector<std::string> completed;
+  const SecretSanta::Transport::Completion completion =
+      [&](const SecretSanta::EmailMessage& message, const SecretSanta::Delivery& delivery) {
+        EXPECT_TRUE(delivery.Succeeded());
+        const std::lock_guard<std::mutex> lock{mutex};
+        completed.push_back(message.Recipient());
+      };
+
+  transport.Send(Message("first@example.com"), completion);
+  transport.Send(Message("second@example.com"), completion);
+  transport.Send(Message("third@example.com"), completion);
+  transport.Flush();
+
+  // The first email message is completed last, after the fresh ones, and its retry waits at least
+  // the drawn delay.
+  ASSERT_EQ(completed.size(), 3);
+  EXPECT_EQ(completed[2], "first@example.com");
+  const std::vector<std::chrono::steady_clock::time_point> attempts{
+      flaky.Attempts("first@example.com")};
+  ASSERT_EQ(attempts.size(), 2);
+  EXPECT_GE(attempts[1] - attempts[0], delay);
+}
+
+TEST(RetryingTransport, RetryTransientFailures) {
+  FlakyTransport flaky{2};
+  SecretSanta::RetryingTransport transport{flaky, ShortPolicy(4)};
+
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  for (int index = 0; index < 10; ++index) {
+    transport.Send(Message("gifter." + std::to_string(index) + "@example.com"),
+                   [&](const SecretSanta::EmailMessage&, const SecretSanta::Delivery& delivery) {
+                     const std::lock_guard<std::mutex> lock{mutex};
+                     deliveries.push_back(delivery);
+                   });
+  }
+  transport.Flush();
+
+  ASSERT_EQ(deliveries.size(), 10);
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    EXPECT_TRUE(delivery.Succeeded());
+  }
+  EXPECT_EQ(transport.RetryCount(), 20);
+  EXPECT_TRUE(transport.Undelivered().Empty());
+}
+
+}  // namespace
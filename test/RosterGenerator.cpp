@@ -0,0 +1,228 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/RosterGenerator.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../source/Configuration.hpp"
+#include "../source/Matchings.hpp"
+
+namespace {
+
+// Splits a line of a CSV file into its fields, unquoting the quoted fields.
+std::vector<std::string> SplitCsvLine(const std::string& line) {
+  std::vector<std::string> fields{std::string{}};
+  bool quoted{false};
+  for (std::size_t position = 0; position < line.size(); ++position) {
+    const char character{line[position]};
+    if (quoted) {
+      if (character == '"' && position + 1 < line.size() && line[position + 1] == '"') {
+        fields.back().push_back('"');
+        ++position;
+      } else if (character == '"') {
+        quoted = false;
+      } else {
+        fields.back().push_back(character);
+      }
+    } else if (character == '"') {
+      quoted = true;
+    } else if (character == ',') {
+      fields.emplace_back();
+    } else {
+      fields.back().push_back(character);
+    }
+  }
+  return fields;
+}
+
+TEST(RosterGenerator, Deterministic) {
+  const SecretSanta::RosterGenerator generator{100, 42};
+  const SecretSanta::RosterGenerator same{100, 42};
+  const SecretSanta::RosterGenerator other{100, 43};
+
+  std::ostringstream first;
+  std::ostringstream second;
+  std::ostringstream third;
+  generator.Write(first, SecretSanta::RosterFormat::Yaml);
+  same.Write(second, SecretSanta::RosterFormat::Yaml);
+  other.Write(third, SecretSanta::RosterFormat::Yaml);
+
+  EXPECT_EQ(first.str(), second.str());
+  EXPECT_NE(first.str(), third.str());
+}
+
+TEST(RosterGenerator, ThreadsDoNotChangeOutput) {
+  // The roster spans several chunks, the last of which is partial.
+  const SecretSanta::RosterGenerator generator{50000, 7, 4};
+
+  std::ostringstream single;
+  std::ostringstream several;
+  const std::size_t single_bytes{generator.Write(single, SecretSanta::RosterFormat::Csv, 1)};
+  const std::size_t several_bytes{generator.Write(several, SecretSanta::RosterFormat::Csv, 4)};
+
+  EXPECT_EQ(single.str(), several.str());
+  EXPECT_EQ(single_bytes, single.str().size());
+  EXPECT_EQ(several_bytes, several.str().size());
+}
+
+TEST(RosterGenerator, UniqueNamesAndEmails) {
+  // The roster has more participants than there are combinations of names.
+  const SecretSanta::RosterGenerator generator{150000, 3};
+
+  std::set<std::string> names;
+  std::set<std::string> emails;
+  for (std::size_t index = 0; index < generator.ParticipantCount(); ++index) {
+    const SecretSanta::Participant participant{generator.Generate(index)};
+    EXPECT_EQ(participant.Name(), generator.Name(index));
+    names.insert(participant.Name());
+    emails.insert(participant.Email().substr(0, participant.Email().find('@')));
+  }
+
+  EXPECT_EQ(names.size(), generator.ParticipantCount());
+  EXPECT_EQ(emails.size(), generator.ParticipantCount());
+}
+
+TEST(RosterGenerator, Households) {
+  const SecretSanta::RosterGenerator generator{10, 5, 3};
+
+  const SecretSanta::Participant first{generator.Generate(0)};
+  const SecretSanta::Participant second{generator.Generate(2)};
+  const SecretSanta::Participant third{generator.Generate(3)};
+
+  EXPECT_EQ(first.Group(), "Household 1");
+  EXPECT_EQ(second.Group(), "Household 1");
+  EXPECT_EQ(third.Group(), "Household 2");
+  EXPECT_EQ(first.Address(), second.Address());
+  EXPECT_EQ(first.TimeZone(), second.TimeZone());
+  EXPECT_EQ(first.Location(), second.Location());
+  EXPECT_NE(first.Name(), second.Name());
+
+  EXPECT_TRUE(SecretSanta::RosterGenerator(10, 5).Generate(0).Group().empty());
+}
+
+TEST(RosterGenerator, YamlConfiguration) {
+  const SecretSanta::RosterGenerator generator{1000, 11, 2};
+
+  const std::filesystem::path path{"synthetic_roster.yaml"};
+  {
+    std::ofstream stream{path};
+    generator.Write(stream, SecretSanta::RosterFormat::Yaml, 2);
+  }
+
+  const SecretSanta::Configuration configuration{path};
+  EXPECT_EQ(configuration.MessageSubject(), "Secret Santa Gift Exchange");
+  ASSERT_EQ(configuration.Participants().size(), generator.ParticipantCount());
+
+  for (std::size_t index = 0; index < generator.ParticipantCount(); index += 97) {
+    const SecretSanta::Participant expected{generator.Generate(index)};
+    const std::set<SecretSanta::Participant>::const_iterator participant{
+        configuration.Participants().find(expected)};
+    ASSERT_NE(participant, configuration.Participants().cend());
+    EXPECT_EQ(participant->Email(), expected.Email());
+    EXPECT_EQ(participant->Address(), expected.Address());
+    EXPECT_EQ(participant->Instructions(), expected.Instructions());
+    EXPECT_EQ(participant->Group(), expected.Group());
+    EXPECT_EQ(participant->TimeZone(), expected.TimeZone());
+    EXPECT_EQ(participant->Location(), expected.Location());
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(RosterGenerator, Csv) {
+  const SecretSanta::RosterGenerator generator{500, 13};
+
+  std::ostringstream stream;
+  generator.Write(stream, SecretSanta::RosterFormat::Csv);
+
+  std::istringstream lines{stream.str()};
+  std::string line;
+  ASSERT_TRUE(std::getline(lines, line));
+  EXPECT_EQ(line, "name,email,address,instructions,group,timezone,location");
+
+  std::size_t index{0};
+  while (std::getline(lines, line)) {
+    const std::vector<std::string> fields{SplitCsvLine(line)};
+    const SecretSanta::Participant expected{generator.Generate(index)};
+    ASSERT_EQ(fields.size(), 7);
+    EXPECT_EQ(fields[0], expected.Name());
+    EXPECT_EQ(fields[2], expected.Address());
+    EXPECT_EQ(fields[6], expected.Location());
+    ++index;
+  }
+  EXPECT_EQ(index, generator.ParticipantCount());
+}
+
+TEST(RosterGenerator, History) {
+  const SecretSanta::RosterGenerator generator{300, 17};
+
+  const std::vector<std::size_t> strides{generator.HistoryStrides(3)};
+  ASSERT_EQ(strides.size(), 3);
+  EXPECT_EQ(std::set<std::size_t>(strides.cbegin(), strides.cend()).size(), 3);
+
+  std::vector<std::map<std::string, std::string>> years;
+  for (const std::size_t stride : strides) {
+    EXPECT_EQ(std::gcd(stride, generator.ParticipantCount()), 1);
+    const std::filesystem::path path{"synthetic_history.yaml"};
+    {
+      std::ofstream stream{path};
+      generator.WriteHistory(stream, stride, 2);
+    }
+    const SecretSanta::Matchings matchings{path};
+    years.push_back(matchings.GiftersToGiftees());
+    std::filesystem::remove(path);
+  }
+
+  for (const std::map<std::string, std::string>& year : years) {
+    ASSERT_EQ(year.size(), generator.ParticipantCount());
+    std::set<std::string> giftees;
+    for (const std::pair<const std::string, std::string>& gifter_and_giftee : year) {
+      EXPECT_NE(gifter_and_giftee.first, gifter_and_giftee.second);
+      giftees.insert(gifter_and_giftee.second);
+    }
+    EXPECT_EQ(giftees.size(), generator.ParticipantCount());
+  }
+
+  for (const std::pair<const std::string, std::string>& gifter_and_giftee : years[0]) {
+    EXPECT_NE(years[1].at(gifter_and_giftee.first), gifter_and_giftee.second);
+    EXPECT_NE(years[2].at(gifter_and_giftee.first), gifter_and_giftee.second);
+  }
+
+  // Three participants only have one usable stride besides the other direction of the cycle.
+  EXPECT_EQ(SecretSanta::RosterGenerator(3).HistoryStrides(5).size(), 2);
+  EXPECT_TRUE(SecretSanta::RosterGenerator(1).HistoryStrides(5).empty());
+}
+
+TEST(RosterGenerator, ParseRosterFormat) {
+  EXPECT_EQ(SecretSanta::ParseRosterFormat("yaml"), SecretSanta::RosterFormat::Yaml);
+  EXPECT_EQ(SecretSanta::ParseRosterFormat("csv"), SecretSanta::RosterFormat::Csv);
+  EXPECT_FALSE(SecretSanta::ParseRosterFormat("json").has_value());
+}
+
+}  // namespace
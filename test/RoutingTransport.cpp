@@ -0,0 +1,332 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/RoutingTransport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Transport that fails a given number of deliveries transiently, or all of them permanently, and
+// delivers the others. Optionally holds the deliveries until they are released, so that they stay
+// in flight. Records the recipient of each email message it is given.
+class TestRelay : public SecretSanta::Transport {
+public:
+  explicit TestRelay(const std::size_t transient_failure_count = 0,
+                     const bool permanent_failure = false, const bool hold = false)
+    : transient_failure_count_(transient_failure_count), permanent_failure_(permanent_failure),
+      hold_(hold) {}
+
+  [[nodiscard]] std::string Name() const override {
+    return "Test";
+  }
+
+  void Send(SecretSanta::EmailMessage message, Completion completion) override {
+    SecretSanta::Delivery delivery;
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      recipients_.push_back(message.Recipient());
+      if (permanent_failure_) {
+        delivery = {SecretSanta::DeliveryStatus::PermanentFailure, "550 5.1.1 Rejected"};
+      } else if (recipients_.size() <= transient_failure_count_) {
+        delivery = {SecretSanta::DeliveryStatus::TransientFailure, "Could not connect."};
+      }
+      if (hold_) {
+        held_.emplace_back(std::move(message), std::move(completion));
+        return;
+      }
+    }
+    completion(message, delivery);
+  }
+
+  void Flush() override {}
+
+  // Delivers the email messages held so far.
+  void Release() {
+    std::vector<std::pair<SecretSanta::EmailMessage, Completion>> held;
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      held.swap(held_);
+      hold_ = false;
+    }
+    for (std::pair<SecretSanta::EmailMessage, Completion>& job : held) {
+      job.second(job.first, SecretSanta::Delivery{});
+    }
+  }
+
+  // Recipients of the email messages given so far, in order.
+  [[nodiscard]] std::vector<std::string> Recipients() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return recipients_;
+  }
+
+private:
+  std::size_t transient_failure_count_;
+
+  bool permanent_failure_;
+
+  bool hold_;
+
+  mutable std::mutex mutex_;
+
+  std::vector<std::string> recipients_;
+
+  std::vector<std::pair<SecretSanta::EmailMessage, Completion>> held_;
+};
+
+// Relays backed by test relays, along with pointers to the test relays.
+struct TestRelays {
+  std::vector<SecretSanta::Relay> relays;
+
+  std::vector<TestRelay*> transports;
+
+  void Add(std::unique_ptr<TestRelay> transport, std::function<bool()> health_check = {}) {
+    transports.push_back(transport.get());
+    relays.push_back(SecretSanta::Relay{"relay" + std::to_string(relays.size()),
+                                        std::move(transport), std::move(health_check)});
+  }
+};
+
+// Routing policy with a short health check interval, suitable for tests.
+SecretSanta::RoutingPolicy ShortPolicy(const std::size_t failure_threshold) {
+  SecretSanta::RoutingPolicy policy;
+  policy.failure_threshold = failure_threshold;
+  policy.health_check_interval = std::chrono::milliseconds{10};
+  return policy;
+}
+
+// Finds a domain for which a given relay is preferred.
+std::string DomainPreferring(const SecretSanta::RoutingTransport& transport,
+                             const std::size_t index) {
+  for (int number = 0;; ++number) {
+    const std::string domain{"domain" + std::to_string(number) + ".example.com"};
+    if (transport.PreferredRelay(domain) == index) {
+      return domain;
+    }
+  }
+}
+
+// Sends an email message to a given recipient and records the outcome of its delivery.
+void Send(SecretSanta::Transport& transport, const std::string& recipient,
+          std::vector<SecretSanta::Delivery>& deliveries, std::mutex& mutex) {
+  transport.Send({"Gifter", recipient, "Subject", "Body"},
+                 [&](const SecretSanta::EmailMessage&, const SecretSanta::Delivery& delivery) {
+                   const std::lock_guard<std::mutex> lock{mutex};
+                   deliveries.push_back(delivery);
+                 });
+}
+
+// Waits until a given relay is back in rotation, or until one second has elapsed.
+bool WaitUntilHealthy(const SecretSanta::RoutingTransport& transport, const std::size_t index) {
+  for (int iteration = 0; iteration < 1000; ++iteration) {
+    if (transport.Statistics()[index].healthy) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  return false;
+}
+
+TEST(RoutingTransport, FailOverToAnotherRelay) {
+  TestRelays test_relays;
+  test_relays.Add(std::make_unique<TestRelay>(1000), []() { return false; });
+  test_relays.Add(std::make_unique<TestRelay>());
+  SecretSanta::RoutingTransport transport{std::move(test_relays.relays), ShortPolicy(2)};
+  const std::string domain{DomainPreferring(transport, 0)};
+
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  for (int index = 0; index < 10; ++index) {
+    Send(transport, "gifter" + std::to_string(index) + "@" + domain, deliveries, mutex);
+  }
+  transport.Flush();
+
+  // The first failure is reported, since the relay is still in rotation. The second one takes the
+  // relay out of rotation and fails over, and the others go straight to the other relay.
+  ASSERT_EQ(deliveries.size(), 10);
+  std::size_t delivered_count = 0;
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    delivered_count += delivery.Succeeded() ? 1 : 0;
+  }
+  EXPECT_EQ(delivered_count, 9);
+  EXPECT_EQ(test_relays.transports[0]->Recipients().size(), 2);
+  EXPECT_EQ(test_relays.transports[1]->Recipients().size(), 9);
+
+  const std::vector<SecretSanta::RelayStatistics> statistics{transport.Statistics()};
+  EXPECT_FALSE(statistics[0].healthy);
+  EXPECT_EQ(statistics[0].transient_failure_count, 2);
+  EXPECT_EQ(statistics[0].failover_count, 1);
+  EXPECT_EQ(statistics[0].outage_count, 1);
+  EXPECT_EQ(statistics[1].delivered_count, 9);
+}
+
+TEST(RoutingTransport, Name) {
+  TestRelays test_relays;
+  test_relays.Add(std::make_unique<TestRelay>());
+  test_relays.Add(std::make_unique<TestRelay>());
+  const SecretSanta::RoutingTransport transport{std::move(test_relays.relays)};
+  EXPECT_EQ(transport.Name(), "Routing among 2 relays (relay0, relay1)");
+}
+
+TEST(RoutingTransport, PermanentFailuresDoNotFailOver) {
+  TestRelays test_relays;
+  test_relays.Add(std::make_unique<TestRelay>(0, true));
+  test_relays.Add(std::make_unique<TestRelay>());
+  SecretSanta::RoutingTransport transport{std::move(test_relays.relays), ShortPolicy(1)};
+  const std::string domain{DomainPreferring(transport, 0)};
+
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  for (int index = 0; index < 5; ++index) {
+    Send(transport, "gifter" + std::to_string(index) + "@" + domain, deliveries, mutex);
+  }
+  transport.Flush();
+
+  ASSERT_EQ(deliveries.size(), 5);
+  for (const SecretSanta::Delivery& delivery : deliveries) {
+    EXPECT_EQ(delivery.Status(), SecretSanta::DeliveryStatus::PermanentFailure);
+  }
+  EXPECT_TRUE(test_relays.transports[1]->Recipients().empty());
+  EXPECT_TRUE(transport.Statistics()[0].healthy);
+}
+
+TEST(RoutingTransport, RecipientDomain) {
+  EXPECT_EQ(SecretSanta::RecipientDomain("alice@example.com"), "example.com");
+  EXPECT_EQ(SecretSanta::RecipientDomain("Alice@Mail.Example.COM"), "mail.example.com");
+  EXPECT_EQ(SecretSanta::RecipientDomain("\"a@b\"@example.org"), "example.org");
+  EXPECT_EQ(SecretSanta::RecipientDomain("alice"), "");
+}
+
+TEST(RoutingTransport, RestoreRelayAfterHealthCheck) {
+  std::atomic<bool> reachable{false};
+  TestRelays test_relays;
+  test_relays.Add(std::make_unique<TestRelay>(1), [&reachable]() { return reachable.load(); });
+  test_relays.Add(std::make_unique<TestRelay>());
+  SecretSanta::RoutingTransport transport{std::move(test_relays.relays), ShortPolicy(1)};
+  const std::string domain{DomainPreferring(transport, 0)};
+
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  Send(transport, "first@" + domain, deliveries, mutex);
+  transport.Flush();
+  EXPECT_FALSE(transport.Statistics()[0].healthy);
+
+  reachable = true;
+  ASSERT_TRUE(WaitUntilHealthy(transport, 0));
+
+  Send(transport, "second@" + domain, deliveries, mutex);
+  transport.Flush();
+
+  ASSERT_EQ(deliveries.size(), 2);
+  EXPECT_TRUE(deliveries[0].Succeeded());
+  EXPECT_TRUE(deliveries[1].Succeeded());
+  EXPECT_EQ(test_relays.transports[0]->Recipients(),
+            (std::vector<std::string>{"first@" + domain, "second@" + domain}));
+  EXPECT_EQ(test_relays.transports[1]->Recipients(),
+            std::vector<std::string>{"first@" + domain});
+}
+
+TEST(RoutingTransport, RestoreRelayWithoutHealthCheck) {
+  TestRelays test_relays;
+  test_relays.Add(std::make_unique<TestRelay>(1));
+  test_relays.Add(std::make_unique<TestRelay>());
+  SecretSanta::RoutingTransport transport{std::move(test_relays.relays), ShortPolicy(1)};
+  const std::string domain{DomainPreferring(transport, 0)};
+
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  Send(transport, "first@" + domain, deliveries, mutex);
+  transport.Flush();
+  ASSERT_TRUE(WaitUntilHealthy(transport, 0));
+  EXPECT_EQ(transport.Statistics()[0].outage_count, 1);
+}
+
+TEST(RoutingTransport, RouteEachDomainToOneRelay) {
+  TestRelays test_relays;
+  for (int index = 0; index < 4; ++index) {
+    test_relays.Add(std::make_unique<TestRelay>());
+  }
+  SecretSanta::RoutingTransport transport{std::move(test_relays.relays)};
+
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  for (int round = 0; round < 3; ++round) {
+    for (int domain = 0; domain < 100; ++domain) {
+      Send(transport,
+           "gifter" + std::to_string(round) + "@Domain" + std::to_string(domain) + ".org",
+           deliveries, mutex);
+    }
+  }
+  transport.Flush();
+  EXPECT_EQ(deliveries.size(), 300);
+
+  // Every relay serves some domains, and no domain is served by two relays.
+  std::map<std::string, std::size_t> relay_of_domain;
+  for (std::size_t index = 0; index < test_relays.transports.size(); ++index) {
+    const std::vector<std::string> recipients{test_relays.transports[index]->Recipients()};
+    EXPECT_GT(recipients.size(), 30);
+    for (const std::string& recipient : recipients) {
+      const std::string domain{SecretSanta::RecipientDomain(recipient)};
+      EXPECT_EQ(transport.PreferredRelay(domain), index);
+      const std::pair<std::map<std::string, std::size_t>::iterator, bool> inserted{
+          relay_of_domain.emplace(domain, index)};
+      EXPECT_EQ(inserted.first->second, index);
+    }
+  }
+  EXPECT_EQ(relay_of_domain.size(), 100);
+}
+
+TEST(RoutingTransport, SpillOverFromBusyRelay) {
+  TestRelays test_relays;
+  test_relays.Add(std::make_unique<TestRelay>(0, false, true));
+  test_relays.Add(std::make_unique<TestRelay>(0, false, true));
+  SecretSanta::RoutingTransport transport{std::move(test_relays.relays)};
+
+  std::mutex mutex;
+  std::vector<SecretSanta::Delivery> deliveries;
+  for (int index = 0; index < 100; ++index) {
+    Send(transport, "gifter" + std::to_string(index) + "@example.com", deliveries, mutex);
+  }
+
+  // One large domain is spread over both relays while their deliveries are in flight, with the
+  // preferred relay holding a little more.
+  const std::size_t preferred = transport.PreferredRelay("example.com");
+  const std::size_t preferred_count = test_relays.transports[preferred]->Recipients().size();
+  const std::size_t other_count = test_relays.transports[1 - preferred]->Recipients().size();
+  EXPECT_EQ(preferred_count + other_count, 100);
+  EXPECT_GE(preferred_count, other_count);
+  EXPECT_LE(preferred_count, 63);
+
+  test_relays.transports[0]->Release();
+  test_relays.transports[1]->Release();
+  transport.Flush();
+  EXPECT_EQ(deliveries.size(), 100);
+}
+
+}  // namespace
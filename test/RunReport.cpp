@@ -0,0 +1,112 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/RunReport.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Outcomes of a given shard on a given host, in which the given gifters were delivered.
+SecretSanta::DeliveryOutcomes CreateOutcomes(
+    const std::optional<SecretSanta::Shard>& shard, const std::string& host,
+    const std::vector<std::string>& gifters) {
+  SecretSanta::DeliveryOutcomes outcomes;
+  outcomes.SetOrigin(shard, host);
+  for (const std::string& gifter : gifters) {
+    outcomes.Add({gifter, gifter + "@example.com", SecretSanta::DeliveryStatus::Delivered, 1, ""});
+  }
+  return outcomes;
+}
+
+TEST(RunReport, Complete) {
+  std::vector<SecretSanta::DeliveryOutcomes> outcomes{
+      CreateOutcomes(SecretSanta::Shard{2, 2}, "host-2", {"claire", "david"}),
+      CreateOutcomes(SecretSanta::Shard{1, 2}, "host-1", {"alice", "bob"}),
+  };
+  outcomes[1].Add({"erin", "erin@example.com", SecretSanta::DeliveryStatus::PermanentFailure, 1,
+                   "550 5.1.1 Mailbox unavailable"});
+
+  const SecretSanta::RunReport report{outcomes};
+  EXPECT_TRUE(report.IsComplete());
+  EXPECT_FALSE(report.Succeeded());
+  EXPECT_EQ(report.ShardCount(), 2);
+  EXPECT_EQ(report.Messages(), 5);
+  EXPECT_EQ(report.Delivered(), 4);
+  EXPECT_EQ(report.Gifters(), 5);
+  ASSERT_EQ(report.Failures().size(), 1);
+  EXPECT_EQ(report.Failures()[0].gifter, "erin");
+  ASSERT_EQ(report.Summaries().size(), 2);
+  EXPECT_EQ(report.Summaries()[1].host, "host-1");
+  EXPECT_EQ(report.Summaries()[1].messages, 3);
+  EXPECT_EQ(report.Summaries()[1].delivered, 2);
+
+  const std::filesystem::path path{"report.yaml"};
+  report.Write(path);
+  const YAML::Node root = YAML::LoadFile(path.string());
+  EXPECT_TRUE(root["complete"].as<bool>());
+  EXPECT_EQ(root["delivered"].as<std::size_t>(), 4);
+  EXPECT_EQ(root["failed"].as<std::size_t>(), 1);
+  EXPECT_EQ(root["hosts"].size(), 2);
+  EXPECT_EQ(root["failures"][0]["recipient"].as<std::string>(), "erin@example.com");
+  std::filesystem::remove(path);
+}
+
+TEST(RunReport, DefaultConstructor) {
+  const SecretSanta::RunReport report;
+  EXPECT_FALSE(report.IsComplete());
+  EXPECT_EQ(report.Messages(), 0);
+}
+
+TEST(RunReport, Inconsistent) {
+  const SecretSanta::RunReport report{{
+      CreateOutcomes(SecretSanta::Shard{1, 2}, "host-1", {"alice"}),
+      CreateOutcomes(SecretSanta::Shard{2, 3}, "host-2", {"bob"}),
+  }};
+  EXPECT_TRUE(report.Inconsistent());
+  EXPECT_FALSE(report.IsComplete());
+}
+
+TEST(RunReport, MissingAndRepeatedShards) {
+  const SecretSanta::RunReport report{{
+      CreateOutcomes(SecretSanta::Shard{1, 3}, "host-1", {"alice"}),
+      CreateOutcomes(SecretSanta::Shard{1, 3}, "host-2", {"alice", "bob"}),
+  }};
+  EXPECT_FALSE(report.Inconsistent());
+  EXPECT_EQ(report.MissingShards(), (std::vector<std::size_t>{2, 3}));
+  EXPECT_EQ(report.RepeatedShards(), (std::vector<std::size_t>{1}));
+  EXPECT_EQ(report.OverlappingGifters(), (std::vector<std::string>{"alice"}));
+  EXPECT_EQ(report.Gifters(), 2);
+  EXPECT_FALSE(report.IsComplete());
+}
+
+TEST(RunReport, Unsharded) {
+  const SecretSanta::RunReport report{{
+      CreateOutcomes(std::nullopt, "host", {"alice", "bob"}),
+  }};
+  EXPECT_EQ(report.ShardCount(), 1);
+  EXPECT_TRUE(report.Succeeded());
+}
+
+}  // namespace
@@ -0,0 +1,136 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/SendScheduler.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// Monday, December 18, 2023, at 12:00:00 UTC.
+constexpr std::time_t Noon{1702900800};
+
+TEST(SendScheduler, SaveAndLoad) {
+  const std::filesystem::path path{
+      std::filesystem::temp_directory_path() / "secret_santa_test_send_scheduler_save.yaml"};
+  std::filesystem::remove(path);
+
+  SecretSanta::SendSchedule schedule{path};
+  EXPECT_FALSE(schedule.Load());
+  schedule.Add("Alice Smith", Noon);
+  schedule.Add("Bob Johnson", Noon + 3600);
+  schedule.Save();
+  EXPECT_TRUE(std::filesystem::exists(path));
+
+  SecretSanta::SendSchedule loaded{path};
+  ASSERT_TRUE(loaded.Load());
+  EXPECT_EQ(loaded.Entries(), schedule.Entries());
+
+  loaded.MarkInFlight({"Alice Smith"});
+  EXPECT_EQ(loaded.Entries().size(), 1);
+  EXPECT_EQ(loaded.InFlight(), std::set<std::string>{"Alice Smith"});
+  loaded.Save();
+  SecretSanta::SendSchedule in_flight{path};
+  ASSERT_TRUE(in_flight.Load());
+  EXPECT_EQ(in_flight.Entries(), loaded.Entries());
+  EXPECT_EQ(in_flight.InFlight(), loaded.InFlight());
+
+  loaded.Remove({"Alice Smith", "Bob Johnson"});
+  EXPECT_TRUE(loaded.Empty());
+  EXPECT_TRUE(loaded.InFlight().empty());
+  loaded.Save();
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(SendScheduler, PlanSendSchedule) {
+  ::setenv("TZ", "UTC", 1);
+  ::tzset();
+  const SecretSanta::Configuration configuration{"../test/configuration.yaml"};
+  const SecretSanta::Matchings matchings{configuration.Participants(), 42};
+
+  SecretSanta::SendSchedule schedule{"unused.yaml"};
+  SecretSanta::PlanSendSchedule(configuration, matchings, 9 * 60, Noon, schedule);
+  ASSERT_EQ(schedule.Entries().size(), configuration.Participants().size());
+  for (const std::pair<const std::string, std::time_t>& entry : schedule.Entries()) {
+    EXPECT_EQ(entry.second, Noon + 21 * 3600);
+  }
+
+  SecretSanta::SendSchedule partial{"unused.yaml"};
+  SecretSanta::PlanSendSchedule(configuration, matchings, 14 * 60, Noon, partial,
+                                std::set<std::string>{"Bob Johnson"});
+  ASSERT_EQ(partial.Entries().size(), 1);
+  EXPECT_EQ(partial.Entries().at("Bob Johnson"), Noon + 2 * 3600);
+}
+
+TEST(SendScheduler, RunSendSchedule) {
+  const std::filesystem::path path{
+      std::filesystem::temp_directory_path() / "secret_santa_test_send_scheduler_run.yaml"};
+  std::filesystem::remove(path);
+
+  SecretSanta::SendSchedule schedule{path};
+  schedule.Add("Late", Noon + 100'000);
+  schedule.Add("Overdue", Noon - 60);
+  schedule.Add("Soon", Noon + 30);
+  schedule.Add("Also Soon", Noon + 30);
+  schedule.Save();
+
+  std::time_t now{Noon};
+  std::vector<std::time_t> sleeps;
+  std::vector<std::pair<std::time_t, std::set<std::string>>> releases;
+  SecretSanta::RunSendSchedule(
+      schedule,
+      [&](const std::set<std::string>& names) {
+        releases.emplace_back(now, names);
+        // The schedule file records the email messages being released as being sent before they
+        // are sent, so that a restart does not send them again, and no longer holds the ones
+        // released earlier.
+        SecretSanta::SendSchedule saved{path};
+        ASSERT_TRUE(saved.Load());
+        EXPECT_EQ(saved.InFlight(), names);
+        for (const std::pair<std::time_t, std::set<std::string>>& release : releases) {
+          for (const std::string& name : release.second) {
+            EXPECT_EQ(saved.Entries().count(name), 0);
+          }
+        }
+      },
+      [&]() { return now; },
+      [&](const std::time_t time) {
+        EXPECT_GT(time, now);
+        sleeps.push_back(time);
+        now = time;
+      });
+
+  ASSERT_EQ(releases.size(), 3);
+  EXPECT_EQ(releases[0].first, Noon);
+  EXPECT_EQ(releases[0].second, std::set<std::string>{"Overdue"});
+  EXPECT_EQ(releases[1].first, Noon + 30);
+  EXPECT_EQ(releases[1].second, (std::set<std::string>{"Also Soon", "Soon"}));
+  EXPECT_EQ(releases[2].first, Noon + 100'000);
+  EXPECT_EQ(releases[2].second, std::set<std::string>{"Late"});
+
+  // The wheel only wakes up a few times on the way to a message more than a day ahead.
+  EXPECT_LE(sleeps.size(), 8);
+  EXPECT_TRUE(schedule.Empty());
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+}  // namespace
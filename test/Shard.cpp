@@ -0,0 +1,96 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Shard.hpp"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+TEST(Shard, Contains) {
+  // Every name belongs to exactly one shard of a given number of shards.
+  std::vector<std::size_t> sizes(4, 0);
+  for (int number = 0; number < 1000; ++number) {
+    const std::string name{"Guest " + std::to_string(number)};
+    std::size_t count = 0;
+    for (std::size_t index = 1; index <= 4; ++index) {
+      if (SecretSanta::Shard{index, 4}.Contains(name)) {
+        ++count;
+        ++sizes[index - 1];
+      }
+    }
+    EXPECT_EQ(count, 1);
+  }
+
+  // The names are spread evenly among the shards.
+  for (const std::size_t size : sizes) {
+    EXPECT_GT(size, 200);
+    EXPECT_LT(size, 300);
+  }
+}
+
+TEST(Shard, DefaultConstructor) {
+  const SecretSanta::Shard shard;
+  EXPECT_EQ(shard.Index(), 1);
+  EXPECT_EQ(shard.Count(), 1);
+  EXPECT_TRUE(shard.Contains("Alice Smith"));
+  EXPECT_EQ(shard.Print(), "1/1");
+}
+
+TEST(Shard, ParseShard) {
+  EXPECT_EQ(SecretSanta::ParseShard("2/3"), SecretSanta::Shard(2, 3));
+  EXPECT_EQ(SecretSanta::ParseShard("1/1"), SecretSanta::Shard(1, 1));
+  EXPECT_EQ(SecretSanta::ParseShard("12/16")->Print(), "12/16");
+  EXPECT_FALSE(SecretSanta::ParseShard("").has_value());
+  EXPECT_FALSE(SecretSanta::ParseShard("3").has_value());
+  EXPECT_FALSE(SecretSanta::ParseShard("0/3").has_value());
+  EXPECT_FALSE(SecretSanta::ParseShard("4/3").has_value());
+  EXPECT_FALSE(SecretSanta::ParseShard("1/0").has_value());
+  EXPECT_FALSE(SecretSanta::ParseShard("-1/3").has_value());
+  EXPECT_FALSE(SecretSanta::ParseShard("1/3x").has_value());
+  EXPECT_FALSE(SecretSanta::ParseShard("1/").has_value());
+}
+
+TEST(Shard, Select) {
+  const std::set<std::string> names{"Alice Smith", "Bob Jones", "Claire Jones", "David Brown",
+                                    "Erin Green"};
+  std::set<std::string> covered;
+  for (std::size_t index = 1; index <= 2; ++index) {
+    const SecretSanta::Shard shard{index, 2};
+    for (const std::string& name : shard.Select(names)) {
+      EXPECT_TRUE(shard.Contains(name));
+      EXPECT_TRUE(covered.insert(name).second);
+    }
+  }
+  EXPECT_EQ(covered, names);
+}
+
+TEST(Shard, StableNameHash) {
+  // The hash is fixed by the FNV-1a algorithm rather than by the standard library, so that every
+  // host computes the same shards.
+  EXPECT_EQ(SecretSanta::StableNameHash(""), 14695981039346656037ULL);
+  EXPECT_EQ(SecretSanta::StableNameHash("a"), 12638187200555641996ULL);
+  EXPECT_EQ(SecretSanta::StableNameHash("foobar"), 9625390261332436968ULL);
+}
+
+}  // namespace
@@ -0,0 +1,153 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/SmtpSink.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Reads the replies to a given number of commands, returning the code of each reply.
+std::vector<std::string> ReadCodes(SecretSanta::Socket& socket, const std::size_t count) {
+  std::vector<std::string> codes;
+  while (codes.size() < count) {
+    const std::optional<std::string> line{socket.ReadLine()};
+    if (!line.has_value()) {
+      break;
+    }
+    if (line->size() < 4 || (*line)[3] != '-') {
+      codes.push_back(line->substr(0, 3));
+    }
+  }
+  return codes;
+}
+
+TEST(SmtpSink, Conversation) {
+  SecretSanta::SmtpSink sink;
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::Socket client{SecretSanta::ConnectTo("127.0.0.1", sink.Port())};
+  ASSERT_TRUE(client.IsOpen());
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"220"});
+
+  client.WriteAll("EHLO client\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"250"});
+
+  client.WriteAll("DATA\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"554"});
+
+  client.WriteAll("MAIL FROM:<santa@example.com>\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"250"});
+
+  client.WriteAll("RCPT TO:<alice@example.com>\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"250"});
+
+  client.WriteAll("DATA\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"354"});
+
+  client.WriteAll("Subject: Hello\r\n\r\n..A line that starts with a period.\r\n.\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"250"});
+
+  client.WriteAll("BOGUS\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"502"});
+
+  client.WriteAll("QUIT\r\n");
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"221"});
+
+  EXPECT_EQ(sink.AcceptedMessageCount(), 1);
+  EXPECT_EQ(sink.ConnectionCount(), 1);
+  EXPECT_EQ(sink.CommandCount(), 8);
+}
+
+TEST(SmtpSink, Pipelining) {
+  SecretSanta::SmtpSink sink;
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::Socket client{SecretSanta::ConnectTo("127.0.0.1", sink.Port())};
+  ASSERT_TRUE(client.IsOpen());
+  client.WriteAll("EHLO client\r\nMAIL FROM:<santa@example.com>\r\nRCPT TO:<alice@example.com>\r\n"
+                  "RCPT TO:<bob@example.com>\r\nDATA\r\n");
+  EXPECT_EQ(ReadCodes(client, 6), (std::vector<std::string>{"220", "250", "250", "250", "250",
+                                                            "354"}));
+
+  client.WriteAll("Hello\r\n.\r\nMAIL FROM:<santa@example.com>\r\nRCPT TO:<claire@example.com>\r\n"
+                  "DATA\r\n");
+  EXPECT_EQ(ReadCodes(client, 4), (std::vector<std::string>{"250", "250", "250", "354"}));
+}
+
+TEST(SmtpSink, InjectedErrors) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{0}, 1.0, 0.0};
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::Socket client{SecretSanta::ConnectTo("127.0.0.1", sink.Port())};
+  ASSERT_TRUE(client.IsOpen());
+  client.WriteAll("HELO client\r\nMAIL FROM:<santa@example.com>\r\nRCPT TO:<alice@example.com>\r\n"
+                  "DATA\r\n");
+  EXPECT_EQ(ReadCodes(client, 5), (std::vector<std::string>{"220", "250", "250", "550", "554"}));
+  EXPECT_EQ(sink.RejectedRecipientCount(), 1);
+
+  SecretSanta::SmtpSink deferring_sink{0, std::chrono::microseconds{0}, 0.0, 1.0};
+  ASSERT_TRUE(deferring_sink.IsListening());
+
+  SecretSanta::Socket other_client{
+      SecretSanta::ConnectTo("127.0.0.1", deferring_sink.Port())};
+  ASSERT_TRUE(other_client.IsOpen());
+  other_client.WriteAll("HELO client\r\nMAIL FROM:<santa@example.com>\r\n"
+                        "RCPT TO:<alice@example.com>\r\nDATA\r\n");
+  EXPECT_EQ(ReadCodes(other_client, 5),
+            (std::vector<std::string>{"220", "250", "250", "250", "354"}));
+  other_client.WriteAll("Hello\r\n.\r\n");
+  EXPECT_EQ(ReadCodes(other_client, 1), std::vector<std::string>{"451"});
+  EXPECT_EQ(deferring_sink.DeferredMessageCount(), 1);
+  EXPECT_EQ(deferring_sink.AcceptedMessageCount(), 0);
+}
+
+TEST(SmtpSink, ConnectionLimit) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{0}, 0.0, 0.0, 1};
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::Socket first{SecretSanta::ConnectTo("127.0.0.1", sink.Port())};
+  ASSERT_TRUE(first.IsOpen());
+  EXPECT_EQ(ReadCodes(first, 1), std::vector<std::string>{"220"});
+
+  SecretSanta::Socket second{SecretSanta::ConnectTo("127.0.0.1", sink.Port())};
+  ASSERT_TRUE(second.IsOpen());
+  EXPECT_EQ(ReadCodes(second, 1), std::vector<std::string>{"421"});
+  EXPECT_EQ(sink.RefusedConnectionCount(), 1);
+  EXPECT_EQ(sink.PeakConnectionCount(), 1);
+}
+
+TEST(SmtpSink, CommandLatency) {
+  SecretSanta::SmtpSink sink{0, std::chrono::microseconds{20000}};
+  ASSERT_TRUE(sink.IsListening());
+
+  SecretSanta::Socket client{SecretSanta::ConnectTo("127.0.0.1", sink.Port())};
+  ASSERT_TRUE(client.IsOpen());
+  EXPECT_EQ(ReadCodes(client, 1), std::vector<std::string>{"220"});
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  client.WriteAll("NOOP\r\nNOOP\r\n");
+  EXPECT_EQ(ReadCodes(client, 2), (std::vector<std::string>{"250", "250"}));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{40});
+}
+
+}  // namespace
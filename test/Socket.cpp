@@ -0,0 +1,77 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Socket.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+
+TEST(Socket, ParseHostAndPort) {
+  EXPECT_EQ(SecretSanta::ParseHostAndPort("localhost:25"),
+            (std::pair<std::string, uint16_t>{"localhost", 25}));
+  EXPECT_EQ(SecretSanta::ParseHostAndPort("127.0.0.1:65535"),
+            (std::pair<std::string, uint16_t>{"127.0.0.1", 65535}));
+  EXPECT_EQ(SecretSanta::ParseHostAndPort("localhost"), std::nullopt);
+  EXPECT_EQ(SecretSanta::ParseHostAndPort(":25"), std::nullopt);
+  EXPECT_EQ(SecretSanta::ParseHostAndPort("localhost:"), std::nullopt);
+  EXPECT_EQ(SecretSanta::ParseHostAndPort("localhost:0"), std::nullopt);
+  EXPECT_EQ(SecretSanta::ParseHostAndPort("localhost:65536"), std::nullopt);
+  EXPECT_EQ(SecretSanta::ParseHostAndPort("localhost:2x"), std::nullopt);
+}
+
+TEST(Socket, DefaultConstructor) {
+  const SecretSanta::Socket socket;
+  EXPECT_FALSE(socket.IsOpen());
+  EXPECT_EQ(socket.Descriptor(), -1);
+}
+
+TEST(Socket, ReadLines) {
+  const SecretSanta::Socket listener{SecretSanta::ListenOnLoopback(0)};
+  ASSERT_TRUE(listener.IsOpen());
+  ASSERT_NE(listener.LocalPort(), 0);
+
+  std::thread server{[&listener]() {
+    const SecretSanta::Socket connection{SecretSanta::Accept(listener)};
+    connection.WriteAll("first\r\nsecond\nthird");
+  }};
+
+  SecretSanta::Socket client{SecretSanta::ConnectTo("127.0.0.1", listener.LocalPort())};
+  ASSERT_TRUE(client.IsOpen());
+  server.join();
+
+  EXPECT_EQ(client.ReadLine(), "first");
+  EXPECT_TRUE(client.HasBufferedLine());
+  EXPECT_EQ(client.ReadLine(), "second");
+  EXPECT_FALSE(client.HasBufferedLine());
+  EXPECT_EQ(client.ReadLine(), std::nullopt);
+}
+
+TEST(Socket, MoveConstructor) {
+  SecretSanta::Socket first{SecretSanta::ListenOnLoopback(0)};
+  ASSERT_TRUE(first.IsOpen());
+  const int descriptor = first.Descriptor();
+  const SecretSanta::Socket second{std::move(first)};
+  EXPECT_EQ(second.Descriptor(), descriptor);
+  EXPECT_FALSE(first.IsOpen());  // NOLINT(bugprone-use-after-move)
+}
+
+}  // namespace
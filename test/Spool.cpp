@@ -0,0 +1,152 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Spool.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(Spool, ComposeMessageFile) {
+  EXPECT_EQ(SecretSanta::ComposeMessageFile(
+                "santa@example.com",
+                {"Alice Smith", "alice@example.com", "Secret Santa", "Hello Alice,\n.\nBye!"},
+                "Mon, 18 Dec 2023 14:00:00 +0000"),
+            "Date: Mon, 18 Dec 2023 14:00:00 +0000\r\n"
+            "From: santa@example.com\r\n"
+            "To: alice@example.com\r\n"
+            "Subject: Secret Santa\r\n"
+            "X-Secret-Santa-Gifter: Alice Smith\r\n"
+            "MIME-Version: 1.0\r\n"
+            "Content-Type: text/plain; charset=utf-8\r\n"
+            "Content-Transfer-Encoding: quoted-printable\r\n"
+            "\r\n"
+            "Hello Alice,\r\n"
+            ".\r\n"
+            "Bye!");
+}
+
+TEST(Spool, ComposeAndParseMessageFile) {
+  const SecretSanta::EmailMessage message{
+      "Alice Smith", "alice@example.com", "Secret Santa: Hello!", "Hello Alice,\n\nBye!\n"};
+  const std::optional<SecretSanta::EmailMessage> parsed{SecretSanta::ParseMessageFile(
+      SecretSanta::ComposeMessageFile("santa@example.com", message, "date"))};
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(parsed->GifterName(), message.GifterName());
+  EXPECT_EQ(parsed->Recipient(), message.Recipient());
+  EXPECT_EQ(parsed->Subject(), message.Subject());
+  EXPECT_EQ(parsed->Body(), message.Body());
+}
+
+TEST(Spool, ComposeAndParseMessageFileWithNonAsciiContent) {
+  SecretSanta::EmailMessage message{"Zoë Ångström", "zoe@example.com", "Père Noël secret 🎅",
+                                    "Bonjour Zoë,\n\nVotre destinataire est Mañana.\n"};
+  message.SetHtml("<p>Bonjour Zoë,</p>");
+  message.Attach(SecretSanta::EncodeAttachment(
+      "invitation.ics", "text/calendar", "BEGIN:VCALENDAR\r\nEND:VCALENDAR\r\n"));
+  const std::string contents{SecretSanta::ComposeMessageFile("santa@example.com", message, "date")};
+
+  // Every line is 7-bit ASCII.
+  for (const char character : contents) {
+    EXPECT_LT(static_cast<unsigned char>(character), 128);
+  }
+
+  const std::optional<SecretSanta::EmailMessage> parsed{SecretSanta::ParseMessageFile(contents)};
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(parsed->GifterName(), message.GifterName());
+  EXPECT_EQ(parsed->Subject(), message.Subject());
+  EXPECT_EQ(parsed->Body(), message.Body());
+  EXPECT_EQ(parsed->Html(), message.Html());
+  ASSERT_EQ(parsed->Attachments().size(), 1);
+  EXPECT_EQ(parsed->Attachments()[0]->file_name, "invitation.ics");
+  EXPECT_EQ(parsed->Attachments()[0]->content_type, "text/calendar");
+  EXPECT_EQ(parsed->Attachments()[0]->data, message.Attachments()[0]->data);
+}
+
+TEST(Spool, ParseMessageFile) {
+  const std::optional<SecretSanta::EmailMessage> parsed{
+      SecretSanta::ParseMessageFile("to: bob@example.com\n"
+                                    "SUBJECT: Secret\n"
+                                    "  Santa\n"
+                                    "Received: from somewhere\n"
+                                    "\n"
+                                    "Hello Bob,\n")};
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(parsed->GifterName(), "");
+  EXPECT_EQ(parsed->Recipient(), "bob@example.com");
+  EXPECT_EQ(parsed->Subject(), "Secret  Santa");
+  EXPECT_EQ(parsed->Body(), "Hello Bob,\n");
+
+  EXPECT_FALSE(SecretSanta::ParseMessageFile("Subject: No recipient\r\n\r\nBody").has_value());
+  EXPECT_FALSE(SecretSanta::ParseMessageFile("").has_value());
+}
+
+TEST(Spool, SpoolFileName) {
+  EXPECT_EQ(SecretSanta::SpoolFileName({"Alice", "alice.smith+santa@example.com", "", ""}),
+            "alice.smith+santa@example.com.eml");
+  EXPECT_EQ(SecretSanta::SpoolFileName({"Bob", "../bob/x y@example.com", "", ""}),
+            "_.._bob_x_y@example.com.eml");
+  EXPECT_EQ(SecretSanta::SpoolFileName({"Nobody", "", "", ""}), "_.eml");
+}
+
+TEST(Spool, WriteReadAndMarkSent) {
+  const std::filesystem::path directory{"test_spool"};
+  std::filesystem::remove_all(directory);
+  const SecretSanta::Spool spool{directory};
+  ASSERT_TRUE(spool.Create());
+  EXPECT_TRUE(std::filesystem::is_directory(directory / "tmp"));
+  EXPECT_TRUE(std::filesystem::is_directory(directory / "new"));
+  EXPECT_TRUE(std::filesystem::is_directory(directory / "cur"));
+  EXPECT_TRUE(spool.Pending().empty());
+
+  EXPECT_EQ(spool.Write("b.eml", "To: b@example.com\r\n\r\nOld"), "");
+  EXPECT_EQ(spool.Write("a.eml", "To: a@example.com\r\n\r\nHello"), "");
+  EXPECT_EQ(spool.Write("b.eml", "To: b@example.com\r\n\r\nNew"), "");
+
+  // Writing a file again replaces it, and no temporary file is left behind.
+  const std::vector<std::filesystem::path> pending{spool.Pending()};
+  ASSERT_EQ(pending.size(), 2);
+  EXPECT_EQ(pending[0].filename(), "a.eml");
+  EXPECT_EQ(pending[1].filename(), "b.eml");
+  EXPECT_TRUE(std::filesystem::is_empty(directory / "tmp"));
+  EXPECT_EQ(std::filesystem::status(pending[0]).permissions() & std::filesystem::perms::group_read,
+            std::filesystem::perms::none);
+
+  const std::optional<SecretSanta::EmailMessage> message{SecretSanta::Spool::Read(pending[1])};
+  ASSERT_TRUE(message.has_value());
+  EXPECT_EQ(message->Recipient(), "b@example.com");
+  EXPECT_EQ(message->Body(), "New");
+
+  EXPECT_TRUE(spool.MarkSent(pending[0]));
+  EXPECT_EQ(spool.Pending(), std::vector<std::filesystem::path>{pending[1]});
+  EXPECT_TRUE(std::filesystem::exists(directory / "cur" / "a.eml"));
+
+  EXPECT_FALSE(SecretSanta::Spool::Read(directory / "new" / "missing.eml").has_value());
+  std::filesystem::remove_all(directory);
+}
+
+TEST(Spool, WriteIntoMissingDirectory) {
+  const SecretSanta::Spool spool{"missing_spool"};
+  EXPECT_NE(spool.Write("a.eml", "To: a@example.com\r\n\r\nHello"), "");
+}
+
+}  // namespace
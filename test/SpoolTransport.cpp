@@ -0,0 +1,91 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/SpoolTransport.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace {
+
+TEST(SpoolTransport, Name) {
+  const SecretSanta::SpoolTransport transport{
+      SecretSanta::Spool{"path/to/spool"}, "santa@example.com", 3};
+  EXPECT_EQ(transport.Name(), "Spool (path/to/spool, 3 writers)");
+}
+
+TEST(SpoolTransport, ReportWriteFailures) {
+  SecretSanta::SpoolTransport transport{
+      SecretSanta::Spool{"missing_spool_transport"}, "santa@example.com"};
+
+  SecretSanta::Delivery outcome;
+  transport.Send({"Alice", "alice@example.com", "Subject", "Body"},
+                 [&](const SecretSanta::EmailMessage&, const SecretSanta::Delivery& delivery) {
+                   outcome = delivery;
+                 });
+  transport.Flush();
+  EXPECT_EQ(outcome.Status(), SecretSanta::DeliveryStatus::TransientFailure);
+}
+
+TEST(SpoolTransport, WriteOneFilePerGifter) {
+  const std::filesystem::path directory{"test_spool_transport"};
+  std::filesystem::remove_all(directory);
+  const SecretSanta::Spool spool{directory};
+  ASSERT_TRUE(spool.Create());
+
+  {
+    SecretSanta::SpoolTransport transport{spool, "santa@example.com", 4};
+    std::mutex mutex;
+    std::size_t delivered_count = 0;
+    for (int round = 0; round < 2; ++round) {
+      for (int index = 0; index < 500; ++index) {
+        transport.Send(
+            {"Gifter " + std::to_string(index), "gifter" + std::to_string(index) + "@example.com",
+             "Secret Santa", "Round " + std::to_string(round)},
+            [&](const SecretSanta::EmailMessage&, const SecretSanta::Delivery& delivery) {
+              const std::lock_guard<std::mutex> lock{mutex};
+              delivered_count += delivery.Succeeded() ? 1 : 0;
+            });
+      }
+      transport.Flush();
+    }
+    EXPECT_EQ(delivered_count, 1000);
+  }
+
+  // The second round replaced the files of the first one.
+  const std::vector<std::filesystem::path> pending{spool.Pending()};
+  ASSERT_EQ(pending.size(), 500);
+  std::set<std::string> gifter_names;
+  for (const std::filesystem::path& file : pending) {
+    const std::optional<SecretSanta::EmailMessage> message{SecretSanta::Spool::Read(file)};
+    ASSERT_TRUE(message.has_value());
+    EXPECT_EQ(file.filename().string(), SecretSanta::SpoolFileName(message.value()));
+    EXPECT_EQ(message->Body(), "Round 1");
+    gifter_names.insert(message->GifterName());
+  }
+  EXPECT_EQ(gifter_names.size(), 500);
+  EXPECT_TRUE(std::filesystem::is_empty(directory / "tmp"));
+  std::filesystem::remove_all(directory);
+}
+
+}  // namespace
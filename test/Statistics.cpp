@@ -0,0 +1,76 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Statistics.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(Statistics, RegularizedUpperGamma) {
+  EXPECT_DOUBLE_EQ(SecretSanta::RegularizedUpperGamma(1.0, 0.0), 1.0);
+  EXPECT_NEAR(SecretSanta::RegularizedUpperGamma(1.0, 1.0), std::exp(-1.0), 1.0e-12);
+  EXPECT_NEAR(SecretSanta::RegularizedUpperGamma(1.0, 5.0), std::exp(-5.0), 1.0e-12);
+  EXPECT_NEAR(SecretSanta::RegularizedUpperGamma(2.0, 3.0), 4.0 * std::exp(-3.0), 1.0e-12);
+}
+
+TEST(Statistics, ChiSquaredSurvival) {
+  EXPECT_NEAR(SecretSanta::ChiSquaredSurvival(3.841458820694124, 1.0), 0.05, 1.0e-9);
+  EXPECT_NEAR(SecretSanta::ChiSquaredSurvival(18.307038053275146, 10.0), 0.05, 1.0e-9);
+  EXPECT_NEAR(SecretSanta::ChiSquaredSurvival(2.0, 2.0), std::exp(-1.0), 1.0e-12);
+  EXPECT_NEAR(SecretSanta::ChiSquaredSurvival(2400.0, 2400.0), 0.5, 0.01);
+  EXPECT_DOUBLE_EQ(SecretSanta::ChiSquaredSurvival(0.0, 0.0), 1.0);
+  EXPECT_DOUBLE_EQ(SecretSanta::ChiSquaredSurvival(1.0, 0.0), 0.0);
+  EXPECT_LT(SecretSanta::ChiSquaredSurvival(1.0e6, 5.0), 1.0e-300);
+}
+
+TEST(Statistics, ChiSquaredStatistic) {
+  EXPECT_DOUBLE_EQ(
+      SecretSanta::ChiSquaredStatistic({10, 20}, {15.0, 15.0}).value_or(-1.0), 10.0 / 3.0);
+  EXPECT_DOUBLE_EQ(SecretSanta::ChiSquaredStatistic({10, 0}, {10.0, 0.0}).value_or(-1.0), 0.0);
+  EXPECT_FALSE(SecretSanta::ChiSquaredStatistic({10, 1}, {11.0, 0.0}).has_value());
+}
+
+TEST(Statistics, ChiSquaredPValue) {
+  EXPECT_NEAR(SecretSanta::ChiSquaredPValue({10, 20}, {15.0, 15.0}, 1.0),
+              SecretSanta::ChiSquaredSurvival(10.0 / 3.0, 1.0), 1.0e-12);
+  EXPECT_DOUBLE_EQ(SecretSanta::ChiSquaredPValue({10, 0}, {10.0, 0.0}, 0.0), 1.0);
+
+  // Something observed in a cell with no expected count is impossible.
+  EXPECT_DOUBLE_EQ(SecretSanta::ChiSquaredPValue({10, 1}, {11.0, 0.0}, 1.0), 0.0);
+}
+
+TEST(Statistics, KolmogorovSmirnovStatistic) {
+  std::vector<double> single{0.5};
+  EXPECT_DOUBLE_EQ(SecretSanta::KolmogorovSmirnovStatistic(single), 0.5);
+
+  std::vector<double> even{0.7, 0.1, 0.9, 0.3, 0.5};
+  EXPECT_NEAR(SecretSanta::KolmogorovSmirnovStatistic(even), 0.1, 1.0e-12);
+  EXPECT_DOUBLE_EQ(even.front(), 0.1);
+}
+
+TEST(Statistics, KolmogorovSmirnovSurvival) {
+  EXPECT_DOUBLE_EQ(SecretSanta::KolmogorovSmirnovSurvival(0.0, 100), 1.0);
+  EXPECT_NEAR(SecretSanta::KolmogorovSmirnovSurvival(1.358 / 100.0, 10000), 0.05, 0.002);
+  EXPECT_LT(SecretSanta::KolmogorovSmirnovSurvival(0.1, 10000), 1.0e-12);
+}
+
+}  // namespace
@@ -0,0 +1,90 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/StringIndex.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+TEST(StringIndex, DefaultConstructor) {
+  const SecretSanta::StringIndex index;
+  EXPECT_EQ(index.Size(), 0);
+  EXPECT_EQ(index.Find("Alice Smith"), SecretSanta::StringIndex::NotFound);
+}
+
+TEST(StringIndex, Insert) {
+  SecretSanta::StringIndex index;
+  EXPECT_EQ(index.Insert("Alice Smith"), 0);
+  EXPECT_EQ(index.Insert("Bob Johnson"), 1);
+  EXPECT_EQ(index.Insert("Alice Smith"), 0);
+  EXPECT_EQ(index.Size(), 2);
+  EXPECT_EQ(index.Key(1), "Bob Johnson");
+}
+
+TEST(StringIndex, Find) {
+  SecretSanta::StringIndex index;
+  index.Insert("Alice Smith");
+  index.Insert("Bob Johnson");
+  EXPECT_EQ(index.Find("Alice Smith"), 0);
+  EXPECT_EQ(index.Find("Bob Johnson"), 1);
+  EXPECT_EQ(index.Find("Claire Jones"), SecretSanta::StringIndex::NotFound);
+}
+
+TEST(StringIndex, FindAll) {
+  std::vector<std::string> keys;
+  for (int number = 0; number < 1000; ++number) {
+    keys.push_back("Participant " + std::to_string(number));
+  }
+  SecretSanta::StringIndex index;
+  for (const std::string& key : keys) {
+    index.Insert(key);
+  }
+  std::vector<std::string_view> searched_keys{"", "Claire Jones"};
+  for (std::size_t number = keys.size(); number > 0; --number) {
+    searched_keys.emplace_back(keys[number - 1]);
+  }
+  std::vector<uint32_t> identifiers(searched_keys.size());
+  index.FindAll(searched_keys, identifiers);
+  EXPECT_EQ(identifiers[0], SecretSanta::StringIndex::NotFound);
+  EXPECT_EQ(identifiers[1], SecretSanta::StringIndex::NotFound);
+  for (std::size_t position = 2; position < searched_keys.size(); ++position) {
+    EXPECT_EQ(identifiers[position], searched_keys.size() - 1 - position);
+  }
+}
+
+TEST(StringIndex, Grow) {
+  std::vector<std::string> keys;
+  for (int number = 0; number < 10000; ++number) {
+    keys.push_back("Participant " + std::to_string(number));
+  }
+  SecretSanta::StringIndex index;
+  for (const std::string& key : keys) {
+    index.Insert(key);
+  }
+  EXPECT_EQ(index.Size(), keys.size());
+  for (uint32_t identifier = 0; identifier < keys.size(); ++identifier) {
+    EXPECT_EQ(index.Find(keys[identifier]), identifier);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,111 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Task.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+SecretSanta::Task<int> Add(const int first, const int second) {
+  co_return first + second;
+}
+
+SecretSanta::Task<std::string> Describe(const int first, const int second) {
+  const int sum = co_await Add(first, second);
+  co_return std::to_string(first) + " + " + std::to_string(second) + " = " + std::to_string(sum);
+}
+
+SecretSanta::Task<int> Throw() {
+  throw std::runtime_error{"failure"};
+  co_return 0;
+}
+
+SecretSanta::Task<bool> Catch() {
+  try {
+    static_cast<void>(co_await Throw());
+  } catch (const std::runtime_error&) {
+    co_return true;
+  }
+  co_return false;
+}
+
+// Awaitable that suspends the awaiting coroutine and resumes it later on a given executor.
+class Yield {
+public:
+  explicit Yield(SecretSanta::Executor& executor) : executor_(executor) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(const std::coroutine_handle<> awaiting) {
+    executor_.Post([awaiting]() { awaiting.resume(); });
+  }
+
+  void await_resume() const noexcept {}
+
+private:
+  SecretSanta::Executor& executor_;
+};
+
+SecretSanta::Task<int> CountYields(SecretSanta::Executor& executor, const int count) {
+  int yields = 0;
+  for (int index = 0; index < count; ++index) {
+    co_await Yield{executor};
+    ++yields;
+  }
+  co_return yields;
+}
+
+TEST(Task, Lazy) {
+  SecretSanta::Task<int> task{Add(1, 2)};
+  EXPECT_FALSE(task.IsDone());
+  task.Start();
+  EXPECT_TRUE(task.IsDone());
+  EXPECT_EQ(task.Result(), 3);
+}
+
+TEST(Task, Await) {
+  SecretSanta::QueueExecutor executor;
+  EXPECT_EQ(SecretSanta::SyncWait(executor, Describe(2, 3)), "2 + 3 = 5");
+}
+
+TEST(Task, Exception) {
+  SecretSanta::QueueExecutor executor;
+  EXPECT_TRUE(SecretSanta::SyncWait(executor, Catch()));
+}
+
+TEST(Task, Suspend) {
+  SecretSanta::QueueExecutor executor;
+  EXPECT_EQ(SecretSanta::SyncWait(executor, CountYields(executor, 5)), 5);
+}
+
+TEST(Task, Move) {
+  SecretSanta::Task<int> first{Add(4, 5)};
+  SecretSanta::Task<int> second{std::move(first)};
+  second.Start();
+  EXPECT_TRUE(second.IsDone());
+  EXPECT_EQ(second.Result(), 9);
+}
+
+}  // namespace
@@ -0,0 +1,138 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/TimeZone.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Monday, December 18, 2023, at 12:00:00 UTC.
+constexpr std::time_t Noon{1702900800};
+
+TEST(TimeZone, ParseTimeOfDay) {
+  EXPECT_EQ(SecretSanta::ParseTimeOfDay("09:00"), 9 * 60);
+  EXPECT_EQ(SecretSanta::ParseTimeOfDay("9:30"), 9 * 60 + 30);
+  EXPECT_EQ(SecretSanta::ParseTimeOfDay("00:00"), 0);
+  EXPECT_EQ(SecretSanta::ParseTimeOfDay("23:59"), 23 * 60 + 59);
+  EXPECT_FALSE(SecretSanta::ParseTimeOfDay("").has_value());
+  EXPECT_FALSE(SecretSanta::ParseTimeOfDay("24:00").has_value());
+  EXPECT_FALSE(SecretSanta::ParseTimeOfDay("12:60").has_value());
+  EXPECT_FALSE(SecretSanta::ParseTimeOfDay("12").has_value());
+  EXPECT_FALSE(SecretSanta::ParseTimeOfDay("12:00pm").has_value());
+  EXPECT_FALSE(SecretSanta::ParseTimeOfDay(" 9:00").has_value());
+  EXPECT_FALSE(SecretSanta::ParseTimeOfDay("-1:00").has_value());
+}
+
+TEST(TimeZone, FormatTimeOfDay) {
+  EXPECT_EQ(SecretSanta::FormatTimeOfDay(9 * 60), "09:00");
+  EXPECT_EQ(SecretSanta::FormatTimeOfDay(23 * 60 + 5), "23:05");
+}
+
+TEST(TimeZone, IsKnownTimeZone) {
+  EXPECT_TRUE(SecretSanta::IsKnownTimeZone("UTC"));
+  EXPECT_TRUE(SecretSanta::IsKnownTimeZone("America/Los_Angeles"));
+  EXPECT_FALSE(SecretSanta::IsKnownTimeZone(""));
+  EXPECT_FALSE(SecretSanta::IsKnownTimeZone("Mars/Olympus_Mons"));
+  EXPECT_FALSE(SecretSanta::IsKnownTimeZone("../zoneinfo/UTC"));
+  EXPECT_FALSE(SecretSanta::IsKnownTimeZone("/etc/passwd"));
+}
+
+TEST(TimeZone, NextLocalTimeLaterToday) {
+  EXPECT_EQ(SecretSanta::NextLocalTime("UTC", 14 * 60, Noon), Noon + 2 * 3600);
+  // 09:00 PST is 17:00 UTC.
+  EXPECT_EQ(SecretSanta::NextLocalTime("America/Los_Angeles", 9 * 60, Noon), Noon + 5 * 3600);
+  // 09:00 JST is 00:00 UTC on the next day.
+  EXPECT_EQ(SecretSanta::NextLocalTime("Asia/Tokyo", 9 * 60, Noon), Noon + 12 * 3600);
+}
+
+TEST(TimeZone, NextLocalTimeTomorrow) {
+  EXPECT_EQ(SecretSanta::NextLocalTime("UTC", 9 * 60, Noon), Noon + 21 * 3600);
+  EXPECT_EQ(SecretSanta::NextLocalTime("UTC", 12 * 60, Noon), Noon);
+  EXPECT_EQ(SecretSanta::NextLocalTime("UTC", 12 * 60, Noon + 1), Noon + 24 * 3600);
+}
+
+TEST(TimeZone, NextLocalTimeAcrossDaylightSavingTime) {
+  // Saturday, March 9, 2024, at 12:00:00 PST. Daylight saving time starts the next night, so
+  // 09:00 PDT on Sunday is only 20 hours later.
+  const std::time_t saturday{1710014400};
+  EXPECT_EQ(SecretSanta::NextLocalTime("America/Los_Angeles", 9 * 60, saturday),
+            saturday + 20 * 3600);
+}
+
+TEST(TimeZone, NextLocalTimeOnRepeatedAndSkippedTimes) {
+  // Saturday, November 2, 2024, at 12:00:00 UTC. The clocks fall back from 02:00 PDT to 01:00 PST
+  // the next night, so 01:30 happens twice; the first one is 08:30 UTC.
+  EXPECT_EQ(SecretSanta::NextLocalTime("America/Los_Angeles", 90, 1730548800), 1730622600);
+  // Saturday, March 9, 2024, at 12:00:00 PST. The clocks spring forward from 02:00 PST to 03:00
+  // PDT the next night, so 02:30 is skipped and becomes 03:30 PDT.
+  EXPECT_EQ(SecretSanta::NextLocalTime("America/Los_Angeles", 150, 1710014400), 1710066600);
+}
+
+TEST(TimeZone, TimeZoneRulesOffsets) {
+  // Wednesday, January 15, 2040, and Sunday, July 15, 2040, at 12:00:00 UTC, which are after the
+  // last transition of the files and therefore use their POSIX TZ rules.
+  constexpr int64_t january{2210241600};
+  constexpr int64_t july{2225966400};
+  const SecretSanta::TimeZoneRules& paris = SecretSanta::TimeZoneRules::Find("Europe/Paris");
+  EXPECT_EQ(paris.OffsetSeconds(Noon), 3600);
+  EXPECT_EQ(paris.OffsetSeconds(january), 3600);
+  EXPECT_EQ(paris.OffsetSeconds(july), 7200);
+  const SecretSanta::TimeZoneRules& sydney = SecretSanta::TimeZoneRules::Find("Australia/Sydney");
+  EXPECT_EQ(sydney.OffsetSeconds(january), 11 * 3600);
+  EXPECT_EQ(sydney.OffsetSeconds(july), 10 * 3600);
+  EXPECT_EQ(SecretSanta::TimeZoneRules::Find("Asia/Tokyo").OffsetSeconds(july), 9 * 3600);
+  EXPECT_EQ(SecretSanta::TimeZoneRules::Find("UTC").OffsetSeconds(july), 0);
+  EXPECT_EQ(SecretSanta::TimeZoneRules::Find("Mars/Olympus_Mons").OffsetSeconds(july), 0);
+}
+
+TEST(TimeZone, NextLocalTimeFromSeveralThreads) {
+  std::vector<std::thread> threads;
+  std::vector<int> mismatch_counts(4, 0);
+  for (std::size_t thread = 0; thread < mismatch_counts.size(); ++thread) {
+    threads.emplace_back([&mismatch_counts, thread]() {
+      for (int iteration = 0; iteration < 1000; ++iteration) {
+        if (SecretSanta::NextLocalTime("America/Los_Angeles", 9 * 60, Noon) != Noon + 5 * 3600
+            || SecretSanta::NextLocalTime("Asia/Tokyo", 9 * 60, Noon) != Noon + 12 * 3600) {
+          ++mismatch_counts[thread];
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(mismatch_counts, std::vector<int>(4, 0));
+}
+
+TEST(TimeZone, NextLocalTimeRestoresTimeZone) {
+  ::setenv("TZ", "UTC", 1);
+  ::tzset();
+  static_cast<void>(SecretSanta::NextLocalTime("Asia/Tokyo", 9 * 60, Noon));
+  ASSERT_NE(std::getenv("TZ"), nullptr);
+  EXPECT_STREQ(std::getenv("TZ"), "UTC");
+  std::tm local{};
+  ::localtime_r(&Noon, &local);
+  EXPECT_EQ(local.tm_hour, 12);
+}
+
+}  // namespace
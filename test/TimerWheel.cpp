@@ -0,0 +1,119 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/TimerWheel.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+namespace {
+
+TEST(TimerWheel, Empty) {
+  SecretSanta::TimerWheel<int> wheel{100};
+  EXPECT_TRUE(wheel.Empty());
+  EXPECT_EQ(wheel.Size(), 0);
+  EXPECT_EQ(wheel.CurrentTick(), 100);
+  EXPECT_FALSE(wheel.NextTick().has_value());
+  EXPECT_TRUE(wheel.Advance(1000).empty());
+  EXPECT_EQ(wheel.CurrentTick(), 1000);
+}
+
+TEST(TimerWheel, ReleasesAtTick) {
+  SecretSanta::TimerWheel<std::string> wheel{1000};
+  wheel.Schedule(1005, "five");
+  wheel.Schedule(1002, "two");
+  EXPECT_EQ(wheel.Size(), 2);
+  EXPECT_EQ(wheel.NextTick(), 1002);
+  EXPECT_TRUE(wheel.Advance(1001).empty());
+  EXPECT_EQ(wheel.Advance(1002), std::vector<std::string>{"two"});
+  EXPECT_EQ(wheel.NextTick(), 1005);
+  EXPECT_TRUE(wheel.Advance(1004).empty());
+  EXPECT_EQ(wheel.Advance(2000), std::vector<std::string>{"five"});
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheel, ReleasesDueValuesAtOnce) {
+  SecretSanta::TimerWheel<int> wheel{1000};
+  wheel.Schedule(10, 1);
+  wheel.Schedule(1000, 2);
+  EXPECT_EQ(wheel.NextTick(), 1000);
+  EXPECT_EQ(wheel.Advance(1000), (std::vector<int>{1, 2}));
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheel, FarFutureTick) {
+  const uint64_t start{1'700'000'000};
+  SecretSanta::TimerWheel<int> wheel{start};
+  wheel.Schedule(start + 90'000'000, 1);
+  wheel.Schedule(start + 86'400, 2);
+  EXPECT_TRUE(wheel.Advance(start + 86'399).empty());
+  EXPECT_EQ(wheel.Advance(start + 86'400), std::vector<int>{2});
+  EXPECT_TRUE(wheel.Advance(start + 89'999'999).empty());
+  EXPECT_EQ(wheel.Advance(start + 90'000'000), std::vector<int>{1});
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheel, NextTickIsNeverLate) {
+  const uint64_t start{1'700'000'123};
+  SecretSanta::TimerWheel<int> wheel{start};
+  wheel.Schedule(start + 70'000, 1);
+  // Following the next tick reaches the value exactly at its tick, never after.
+  std::vector<int> released;
+  while (released.empty()) {
+    const std::optional<uint64_t> next{wheel.NextTick()};
+    ASSERT_TRUE(next.has_value());
+    ASSERT_LE(next.value(), start + 70'000);
+    released = wheel.Advance(next.value());
+  }
+  EXPECT_EQ(wheel.CurrentTick(), start + 70'000);
+  EXPECT_EQ(released, std::vector<int>{1});
+}
+
+TEST(TimerWheel, RandomTicksAreReleasedInOrder) {
+  const uint64_t start{1'700'000'000};
+  std::mt19937_64 random{42};
+  std::uniform_int_distribution<uint64_t> offset{0, 20'000'000};
+  SecretSanta::TimerWheel<uint64_t> wheel{start};
+  for (int index = 0; index < 10'000; ++index) {
+    const uint64_t tick{start + offset(random)};
+    wheel.Schedule(tick, tick);
+  }
+
+  uint64_t now{start};
+  std::size_t count{0};
+  uint64_t previous{0};
+  std::uniform_int_distribution<uint64_t> step{1, 5'000};
+  while (!wheel.Empty()) {
+    const uint64_t before{now};
+    now += step(random);
+    for (const uint64_t tick : wheel.Advance(now)) {
+      // Each value is released by the first advance that reaches its tick.
+      EXPECT_LE(tick, now);
+      EXPECT_GT(tick, before);
+      EXPECT_GE(tick, previous);
+      previous = tick;
+      ++count;
+    }
+  }
+  EXPECT_EQ(count, 10'000);
+}
+
+}  // namespace
@@ -0,0 +1,136 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Tls.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "../source/Certificates.hpp"
+
+namespace {
+
+// Directory of the certificates with which the tests establish TLS connections.
+const std::filesystem::path Directory{"tls_certificates"};
+
+// Opens a connection to a listening socket and performs a TLS handshake over it with a given client
+// context, while the server side of the handshake is performed with a given server context. Reads
+// the greeting sent by the server. Returns whether the client handshake succeeded.
+bool Connect(SecretSanta::TlsClientContext& client, SecretSanta::TlsServerContext& server,
+             const SecretSanta::Socket& listener, const std::string& host = "127.0.0.1") {
+  std::thread server_thread{[&]() {
+    SecretSanta::Socket socket{SecretSanta::Accept(listener)};
+    if (server.Handshake(socket)) {
+      socket.WriteAll("220 Hello\r\n");
+      static_cast<void>(socket.ReadLine());
+    }
+  }};
+
+  SecretSanta::Socket socket{SecretSanta::ConnectTo("127.0.0.1", listener.LocalPort())};
+  const bool connected = client.Handshake(socket, host);
+  if (connected) {
+    EXPECT_TRUE(socket.IsTls());
+    EXPECT_EQ(socket.ReadLine(), std::optional<std::string>{"220 Hello"});
+    socket.WriteAll("QUIT\r\n");
+  }
+  socket.Close();
+  server_thread.join();
+  return connected;
+}
+
+TEST(Tls, InvalidCertificateAuthorityFile) {
+  const SecretSanta::TlsClientContext client{"missing_certificate_authority.pem"};
+  EXPECT_FALSE(client.IsValid());
+}
+
+TEST(Tls, InvalidCertificateFile) {
+  const SecretSanta::TlsServerContext server{"missing_certificate.pem", "missing_key.pem"};
+  EXPECT_FALSE(server.IsValid());
+}
+
+TEST(Tls, ResumeSession) {
+  ASSERT_TRUE(SecretSanta::CreateCertificates(Directory));
+  SecretSanta::TlsServerContext server{Directory / SecretSanta::CertificateFile::Certificate,
+                                       Directory / SecretSanta::CertificateFile::PrivateKey};
+  SecretSanta::TlsClientContext client{Directory / SecretSanta::CertificateFile::Authority};
+  ASSERT_TRUE(server.IsValid());
+  ASSERT_TRUE(client.IsValid());
+
+  const SecretSanta::Socket listener{SecretSanta::ListenOnLoopback(0)};
+  ASSERT_TRUE(listener.IsOpen());
+
+  EXPECT_TRUE(Connect(client, server, listener));
+  EXPECT_TRUE(Connect(client, server, listener, "localhost"));
+  EXPECT_TRUE(Connect(client, server, listener));
+
+  EXPECT_EQ(client.FullHandshakeCount(), 1);
+  EXPECT_EQ(client.ResumedHandshakeCount(), 2);
+  EXPECT_EQ(client.FailedHandshakeCount(), 0);
+  EXPECT_EQ(server.FullHandshakeCount(), 1);
+  EXPECT_EQ(server.ResumedHandshakeCount(), 2);
+}
+
+TEST(Tls, ResumptionDisabled) {
+  ASSERT_TRUE(SecretSanta::CreateCertificates(Directory));
+  SecretSanta::TlsServerContext server{Directory / SecretSanta::CertificateFile::Certificate,
+                                       Directory / SecretSanta::CertificateFile::PrivateKey};
+  SecretSanta::TlsClientContext client{Directory / SecretSanta::CertificateFile::Authority, false};
+  EXPECT_FALSE(client.Resumes());
+
+  const SecretSanta::Socket listener{SecretSanta::ListenOnLoopback(0)};
+  EXPECT_TRUE(Connect(client, server, listener));
+  EXPECT_TRUE(Connect(client, server, listener));
+
+  EXPECT_EQ(client.FullHandshakeCount(), 2);
+  EXPECT_EQ(client.ResumedHandshakeCount(), 0);
+  EXPECT_EQ(server.FullHandshakeCount(), 2);
+}
+
+TEST(Tls, UntrustedCertificate) {
+  ASSERT_TRUE(SecretSanta::CreateCertificates(Directory));
+  ASSERT_TRUE(SecretSanta::CreateCertificates("tls_other_certificates"));
+  SecretSanta::TlsServerContext server{Directory / SecretSanta::CertificateFile::Certificate,
+                                       Directory / SecretSanta::CertificateFile::PrivateKey};
+  SecretSanta::TlsClientContext client{
+      std::filesystem::path{"tls_other_certificates"} / SecretSanta::CertificateFile::Authority};
+
+  const SecretSanta::Socket listener{SecretSanta::ListenOnLoopback(0)};
+  EXPECT_FALSE(Connect(client, server, listener));
+
+  EXPECT_EQ(client.FullHandshakeCount(), 0);
+  EXPECT_EQ(client.FailedHandshakeCount(), 1);
+  EXPECT_EQ(server.FailedHandshakeCount(), 1);
+}
+
+TEST(Tls, WrongHost) {
+  ASSERT_TRUE(SecretSanta::CreateCertificates(Directory));
+  SecretSanta::TlsServerContext server{Directory / SecretSanta::CertificateFile::Certificate,
+                                       Directory / SecretSanta::CertificateFile::PrivateKey};
+  SecretSanta::TlsClientContext client{Directory / SecretSanta::CertificateFile::Authority};
+
+  const SecretSanta::Socket listener{SecretSanta::ListenOnLoopback(0)};
+  EXPECT_FALSE(Connect(client, server, listener, "mail.example.com"));
+  EXPECT_EQ(client.FailedHandshakeCount(), 1);
+}
+
+}  // namespace
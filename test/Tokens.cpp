@@ -0,0 +1,131 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Tokens.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "CreateSampleParticipant.hpp"
+
+namespace {
+
+TEST(Tokens, DefaultConstructor) {
+  const SecretSanta::Tokens tokens;
+  EXPECT_TRUE(tokens.ParticipantsToTokens().empty());
+  EXPECT_EQ(tokens.Token("Alice Smith"), "");
+}
+
+TEST(Tokens, IsToken) {
+  EXPECT_TRUE(SecretSanta::Tokens::IsToken("0123456789abcdef0123456789abcdef"));
+  EXPECT_FALSE(SecretSanta::Tokens::IsToken("0123456789abcdef0123456789abcde"));
+  EXPECT_FALSE(SecretSanta::Tokens::IsToken("0123456789ABCDEF0123456789abcdef"));
+  EXPECT_FALSE(SecretSanta::Tokens::IsToken("0123456789abcdef0123456789abcdeg"));
+  EXPECT_FALSE(SecretSanta::Tokens::IsToken(""));
+}
+
+TEST(Tokens, Update) {
+  const std::set<SecretSanta::Participant> participants{SecretSanta::CreateSampleParticipants()};
+  SecretSanta::Tokens tokens;
+  EXPECT_EQ(tokens.Update(participants), 3);
+  ASSERT_EQ(tokens.ParticipantsToTokens().size(), 3);
+
+  std::set<std::string> distinct;
+  for (const std::pair<const std::string, std::string>& participant_and_token :
+       tokens.ParticipantsToTokens()) {
+    EXPECT_TRUE(SecretSanta::Tokens::IsToken(participant_and_token.second));
+    distinct.insert(participant_and_token.second);
+  }
+  EXPECT_EQ(distinct.size(), 3);
+
+  const std::map<std::string, std::string> before{tokens.ParticipantsToTokens()};
+  EXPECT_EQ(tokens.Update(participants), 0);
+  EXPECT_EQ(tokens.ParticipantsToTokens(), before);
+}
+
+TEST(Tokens, UpdateKeepsTokensOfRemainingParticipants) {
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(SecretSanta::CreateSampleParticipants()));
+  const std::string alice = tokens.Token("Alice Smith");
+  const std::string bob = tokens.Token("Bob Johnson");
+
+  std::set<SecretSanta::Participant> participants;
+  participants.emplace(SecretSanta::CreateSampleParticipantA());
+  participants.emplace(SecretSanta::CreateSampleParticipantB());
+  participants.emplace(SecretSanta::Participant{"Dave Brown"});
+  EXPECT_EQ(tokens.Update(participants), 1);
+
+  EXPECT_EQ(tokens.Token("Alice Smith"), alice);
+  EXPECT_EQ(tokens.Token("Bob Johnson"), bob);
+  EXPECT_EQ(tokens.Token("Claire Jones"), "");
+  EXPECT_TRUE(SecretSanta::Tokens::IsToken(tokens.Token("Dave Brown")));
+}
+
+TEST(Tokens, ConstructorFromYamlFile) {
+  SecretSanta::Tokens first;
+  static_cast<void>(first.Update(SecretSanta::CreateSampleParticipants()));
+  const std::filesystem::path path = "tokens.yaml";
+  EXPECT_TRUE(first.Write(path));
+
+  // Only the owner of the tokens file can read it.
+  EXPECT_EQ(std::filesystem::status(path).permissions() & std::filesystem::perms::all,
+            std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+
+  const SecretSanta::Tokens second{path};
+  EXPECT_EQ(first.ParticipantsToTokens(), second.ParticipantsToTokens());
+}
+
+TEST(Tokens, WriteFailure) {
+  SecretSanta::Tokens tokens;
+  static_cast<void>(tokens.Update(SecretSanta::CreateSampleParticipants()));
+  // The parent of the tokens file is a regular file, so the tokens file cannot be created.
+  const std::filesystem::path parent = "tokens_parent.yaml";
+  {
+    std::ofstream stream{parent};
+  }
+  EXPECT_FALSE(tokens.Write(parent / "tokens.yaml"));
+  std::filesystem::remove(parent);
+}
+
+TEST(Tokens, ConstructorFromYamlFileSkipsMalformedTokens) {
+  const std::filesystem::path path = "malformed_tokens.yaml";
+  {
+    std::ofstream stream{path};
+    stream << "participants_to_tokens:\n"
+           << "  Alice Smith: 0123456789abcdef0123456789abcdef\n"
+           << "  Bob Johnson: not a token\n"
+           << "  Claire Jones: 0123456789abcdef0123456789abcdef\n"
+           << "  Dave Brown: fedcba9876543210fedcba9876543210\n";
+  }
+  const SecretSanta::Tokens tokens{path};
+  const std::map<std::string, std::string> expected{
+    {"Alice Smith", "0123456789abcdef0123456789abcdef"},
+    {"Dave Brown",  "fedcba9876543210fedcba9876543210"},
+  };
+  EXPECT_EQ(tokens.ParticipantsToTokens(), expected);
+}
+
+TEST(Tokens, ConstructorFromMissingYamlFile) {
+  const SecretSanta::Tokens tokens{"path/to/missing/tokens.yaml"};
+  EXPECT_TRUE(tokens.ParticipantsToTokens().empty());
+}
+
+}  // namespace
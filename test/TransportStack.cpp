@@ -0,0 +1,70 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/TransportStack.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(TransportStack, DefaultOptions) {
+  SecretSanta::TransportStack transport_stack{SecretSanta::TransportOptions{}};
+  ASSERT_TRUE(transport_stack.IsValid());
+  EXPECT_EQ(transport_stack.Transport().Name(), "S-nail with up to 4 attempts");
+}
+
+TEST(TransportStack, Spool) {
+  SecretSanta::TransportOptions options;
+  options.spool_directory = "transport_stack_spool";
+  options.attempts = 2;
+  {
+    SecretSanta::TransportStack transport_stack{options};
+    ASSERT_TRUE(transport_stack.IsValid());
+    EXPECT_TRUE(transport_stack.Transport().Name().starts_with("Spool (transport_stack_spool"));
+    EXPECT_TRUE(transport_stack.Transport().Name().ends_with("with up to 2 attempts"));
+  }
+  std::filesystem::remove_all(options.spool_directory);
+}
+
+TEST(TransportStack, InvalidSpool) {
+  // The parent of the spool directory is a regular file, so the spool directory cannot be created.
+  const std::filesystem::path parent{"transport_stack_parent.txt"};
+  {
+    std::ofstream stream{parent};
+  }
+  SecretSanta::TransportOptions options;
+  options.spool_directory = parent / "spool";
+  const SecretSanta::TransportStack transport_stack{options};
+  EXPECT_FALSE(transport_stack.IsValid());
+  std::filesystem::remove(parent);
+}
+
+TEST(TransportStack, InvalidCertificateAuthorities) {
+  SecretSanta::TransportOptions options;
+  options.relays.emplace_back("127.0.0.1", 2525);
+  options.tls = true;
+  options.ca_file = "missing_certificate_authorities.pem";
+  const SecretSanta::TransportStack transport_stack{options};
+  EXPECT_FALSE(transport_stack.IsValid());
+}
+
+}  // namespace
@@ -0,0 +1,161 @@
+// Copyright © 2023-2025, Alexandre Coderre-Chabot.
+//
+// This file is part of Secret Santa, a software utility for organizing a "Secret Santa" gift
+// exchange event! Secret Santa is hosted at: https://github.com/acodcha/secret-santa
+//
+// Secret Santa is licensed under the MIT License: https://mit-license.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute,
+// sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Verification.hpp"
+
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "CreateSampleParticipant.hpp"
+
+namespace {
+
+TEST(Verification, DefaultConstructor) {
+  const SecretSanta::Verification verification;
+  EXPECT_TRUE(verification.IsValid());
+  EXPECT_EQ(verification.ProblemCount(), 0);
+}
+
+TEST(Verification, ValidMatchings) {
+  const SecretSanta::Matchings matchings{SecretSanta::CreateSampleParticipants(), 42};
+  const SecretSanta::Verification verification{SecretSanta::CreateSampleParticipants(), matchings};
+  EXPECT_TRUE(verification.IsValid());
+  EXPECT_TRUE(verification.Diagnostics().empty());
+}
+
+TEST(Verification, ValidMatchingsFile) {
+  const SecretSanta::Verification verification{
+      SecretSanta::CreateSampleParticipants(), std::filesystem::path{"../test/matchings.yaml"}};
+  EXPECT_TRUE(verification.IsValid());
+}
+
+TEST(Verification, MissingParticipant) {
+  std::set<SecretSanta::Participant> participants{SecretSanta::CreateSampleParticipants()};
+  const SecretSanta::Matchings matchings{participants, 42};
+  participants.emplace("David Lee");
+  const SecretSanta::Verification verification{participants, matchings};
+  EXPECT_FALSE(verification.IsValid());
+  EXPECT_EQ(verification.Diagnostics(),
+            (std::vector<std::string>{"\"David Lee\" does not gift to anyone.",
+                                      "\"David Lee\" does not receive a gift from anyone."}));
+}
+
+TEST(Verification, UnknownParticipant) {
+  const SecretSanta::Matchings matchings{SecretSanta::CreateSampleParticipants(), 42};
+  std::set<SecretSanta::Participant> participants{SecretSanta::CreateSampleParticipants()};
+  participants.erase(SecretSanta::Participant{"Bob Johnson"});
+  const SecretSanta::Verification verification{participants, matchings};
+  EXPECT_FALSE(verification.IsValid());
+  EXPECT_EQ(verification.ProblemCount(), 2);
+}
+
+TEST(Verification, MalformedMatchingsFile) {
+  const std::filesystem::path path{"malformed_matchings.yaml"};
+  {
+    std::ofstream stream{path};
+    stream << "gifters_to_giftees:\n"
+           << "  - Alice Smith: Claire Jones\n"
+           << "  - Bob Johnson: Bob Johnson\n"
+           << "  - Claire Jones: Alice Smith\n"
+           << "  - Bob Johnson: Alice Smith\n"
+           << "  - [Bob Johnson, Claire Jones]\n";
+  }
+  const SecretSanta::Verification verification{SecretSanta::CreateSampleParticipants(), path};
+  EXPECT_FALSE(verification.IsValid());
+  EXPECT_EQ(verification.Diagnostics(),
+            (std::vector<std::string>{
+                "Entry 2: \"Bob Johnson\" gifts to themselves.",
+                "Entry 4: \"Bob Johnson\" already gifts in entry 2.",
+                "Entry 4: \"Alice Smith\" already receives a gift in entry 3.",
+                "Entry 5 is malformed; it must be of the form \"<gifter>: <giftee>\" or "
+                "\"<gifter>: [<giftee>, ...]\".",
+            }));
+}
+
+TEST(Verification, ValidMatchingsWithSeveralGifts) {
+  std::set<SecretSanta::Participant> participants;
+  for (std::size_t index = 0; index < 20; ++index) {
+    participants.emplace("Participant " + std::to_string(index));
+  }
+  const SecretSanta::Matchings matchings{participants, 42, std::nullopt, false, 3};
+  const SecretSanta::Verification verification{participants, matchings};
+  EXPECT_TRUE(verification.IsValid());
+}
+
+TEST(Verification, MatchingsFileWithSeveralGifts) {
+  const std::filesystem::path path{"several_gifts_matchings.yaml"};
+  {
+    std::ofstream stream{path};
+    stream << "gifters_to_giftees:\n"
+           << "  - Alice Smith: [Bob Johnson, Claire Jones]\n"
+           << "  - Bob Johnson: [Alice Smith, Alice Smith]\n"
+           << "  - Claire Jones: Bob Johnson\n";
+  }
+  const SecretSanta::Verification verification{SecretSanta::CreateSampleParticipants(), path};
+  EXPECT_FALSE(verification.IsValid());
+  EXPECT_EQ(verification.Diagnostics(),
+            (std::vector<std::string>{
+                "Entry 2: \"Bob Johnson\" gifts to \"Alice Smith\" more than once.",
+                "Entry 3: the number of giftees of \"Claire Jones\" is 1 instead of 2.",
+                "\"Alice Smith\" receives only 1 of 2 gifts.",
+                "\"Claire Jones\" receives only 1 of 2 gifts.",
+            }));
+}
+
+TEST(Verification, MatchingsFileWithMoreGiftsLater) {
+  const std::filesystem::path path{"several_gifts_matchings.yaml"};
+  {
+    std::ofstream stream{path};
+    stream << "---\n"
+           << "gifters_to_giftees:\n"
+           << "- Alice Smith: Bob Johnson\n"
+           << "- Bob Johnson: [Alice Smith, Claire Jones]\n"
+           << "- Claire Jones: [Alice Smith, Bob Johnson]\n";
+  }
+  const SecretSanta::Verification verification{SecretSanta::CreateSampleParticipants(), path};
+  EXPECT_FALSE(verification.IsValid());
+  EXPECT_EQ(verification.Diagnostics(),
+            (std::vector<std::string>{
+                "Entry 1: the number of giftees of \"Alice Smith\" is 1 instead of 2.",
+                "\"Claire Jones\" receives only 1 of 2 gifts.",
+            }));
+}
+
+TEST(Verification, QuotedMatchingsFile) {
+  const std::filesystem::path path{"malformed_matchings.yaml"};
+  {
+    std::ofstream stream{path};
+    stream << "gifters_to_giftees:\n"
+           << "  - \"Alice Smith\": Bob Johnson\n"
+           << "  - Bob Johnson: 'Claire Jones'\n"
+           << "  - Claire Jones: Alice Smith  # Back to the start.\n";
+  }
+  const SecretSanta::Verification verification{SecretSanta::CreateSampleParticipants(), path};
+  EXPECT_TRUE(verification.IsValid());
+}
+
+TEST(Verification, MissingMatchingsFile) {
+  const SecretSanta::Verification verification{
+      SecretSanta::CreateSampleParticipants(), std::filesystem::path{"missing_matchings.yaml"}};
+  EXPECT_FALSE(verification.IsValid());
+  EXPECT_EQ(verification.ProblemCount(), 7);
+}
+
+}  // namespace